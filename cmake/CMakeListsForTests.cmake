@@ -201,6 +201,32 @@ FOREACH(_EXE ${_EXE_LIST_${_CURRENT_TEST_DIRECTORY}})
       set_tests_properties(${_EXE} PROPERTIES TIMEOUT ${tests_timeout})
     endif()
 
+    # -- the same executable run by mpiexec, for each number of processes
+    # in ${_EXE}_MPI_PROCS --
+    if(${_EXE}_MPI_PROCS)
+      if(MPIEXEC_EXECUTABLE)
+        set(_MPIEXEC ${MPIEXEC_EXECUTABLE})
+      else()
+        set(_MPIEXEC ${MPIEXEC})
+      endif()
+      foreach(_NP ${${_EXE}_MPI_PROCS})
+        set(_TEST_NAME ${_EXE}_np${_NP})
+        add_test(${_TEST_NAME} ${_MPIEXEC} ${MPIEXEC_NUMPROC_FLAG} ${_NP}
+          ${MPIEXEC_PREFLAGS} ${CMAKE_CURRENT_BINARY_DIR}/${_EXE}${EXE_EXT} ${MPIEXEC_POSTFLAGS})
+        set_tests_properties(${_TEST_NAME} PROPERTIES
+          FAIL_REGULAR_EXPRESSION "FAILURE;Exception;failed;ERROR;test unsucceeded"
+          PROCESSORS ${_NP})
+        if(LDLIBPATH)
+          set_tests_properties(${_TEST_NAME} PROPERTIES ENVIRONMENT "${LDLIBPATH}")
+        endif()
+        if(${_EXE}_TIMEOUT)
+          set_tests_properties(${_TEST_NAME} PROPERTIES TIMEOUT ${${_EXE}_TIMEOUT})
+        else()
+          set_tests_properties(${_TEST_NAME} PROPERTIES TIMEOUT ${tests_timeout})
+        endif()
+      endforeach()
+    endif()
+
   ENDIF()
 
 ENDFOREACH()
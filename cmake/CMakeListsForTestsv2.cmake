@@ -142,4 +142,30 @@ FOREACH(_EXE ${_EXE_LIST_${_CURRENT_TEST_DIRECTORY}})
 
   ENDFOREACH(i RANGE ${count})
 
+  # -- the same executable run by mpiexec, for each number of processes
+  # in ${_EXE}_MPI_PROCS --
+  if(${_EXE}_MPI_PROCS)
+    if(MPIEXEC_EXECUTABLE)
+      set(_MPIEXEC ${MPIEXEC_EXECUTABLE})
+    else()
+      set(_MPIEXEC ${MPIEXEC})
+    endif()
+    foreach(_NP ${${_EXE}_MPI_PROCS})
+      set(_TEST_NAME ${_EXE}_np${_NP})
+      add_test(${_TEST_NAME} ${_MPIEXEC} ${MPIEXEC_NUMPROC_FLAG} ${_NP}
+        ${MPIEXEC_PREFLAGS} ${CMAKE_CURRENT_BINARY_DIR}/${_EXE}${EXE_EXT} ${MPIEXEC_POSTFLAGS})
+      set_tests_properties(${_TEST_NAME} PROPERTIES
+        FAIL_REGULAR_EXPRESSION "FAILURE;Exception;failed;ERROR;test unsucceeded"
+        PROCESSORS ${_NP})
+      if(ENV_PPTY)
+        set_tests_properties(${_TEST_NAME} PROPERTIES ENVIRONMENT "${ENV_PPTY}")
+      endif()
+      if(${_EXE}_TIMEOUT)
+        set_tests_properties(${_TEST_NAME} PROPERTIES TIMEOUT ${${_EXE}_TIMEOUT})
+      else()
+        set_tests_properties(${_TEST_NAME} PROPERTIES TIMEOUT ${tests_timeout})
+      endif()
+    endforeach()
+  endif()
+
 ENDFOREACH(_EXE ${_EXE_LIST_${_CURRENT_TEST_DIRECTORY}})
@@ -227,8 +227,7 @@ IF(WITH_OPENMP)
   FIND_PACKAGE(OpenMP)
   IF(OPENMP_FOUND)
     SET(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${OpenMP_C_FLAGS}")
-    # Only applies to numerics code, which is in C (for now)
-    #SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}")
+    # the C++ components link to OpenMP::OpenMP_CXX
   ENDIF()
 ENDIF()
 
@@ -32,6 +32,7 @@ option(DEV_MODE_STRICT "Compilation flags setup for developers (extra strict, co
 option(WITH_BULLET "compilation with Bullet Bindings. Default = OFF" OFF)
 option(WITH_OCC "compilation with OpenCascade Bindings. Default = OFF" OFF)
 option(WITH_MUMPS "Compilation with the MUMPS solver. Default = OFF" OFF)
+option(WITH_MPI "Compilation with MPI, for the distributed solvers. Default = OFF" OFF)
 option(WITH_UMFPACK "Compilation with the UMFPACK solver. Default = OFF" OFF)
 option(WITH_SUPERLU "Compilation with the SuperLU solver. Default = OFF" OFF)
 option(WITH_SUPERLU_MT "Compilation with the SuperLU solver, multithreaded version. Default = OFF" OFF)
@@ -74,11 +74,17 @@ if(EXISTS "${CMAKE_SOURCE_DIR}/externals/optim_misc/ql0001/ql0001.f")
   set(HAVE_QL0001 TRUE)
 endif()
 
+# --- MPI ---
+if(WITH_MPI AND NOT IDONTWANTMPI)
+  compile_with(MPI REQUIRED SICONOS_COMPONENTS numerics)
+  set(HAVE_MPI TRUE)
+endif()
+
 # --- Mumps ---
 if(WITH_MUMPS)
-  if(NOT IDONTWANTMPI)
+  if(NOT IDONTWANTMPI AND NOT HAVE_MPI)
     compile_with(MPI REQUIRED SICONOS_COMPONENTS numerics)
-  endif(NOT IDONTWANTMPI)
+  endif()
   if(MPI_FOUND)
     set(HAVE_MPI TRUE)
     # Fedora allow parallel install of MPI and vanilla version of MUMPS.
@@ -152,6 +152,13 @@ REGISTER_BOOST_SERIALIZATION(__mpf_struct);
 
 
 
+template <class Archive>
+void siconos_io(Archive & ar, DenseStorage & s, unsigned int version)
+{
+  ar & boost::serialization::make_nvp("storage", static_cast<DenseStorage::base_type&>(s));
+}
+REGISTER_BOOST_SERIALIZATION(DenseStorage);
+
 template <class Archive>
 void siconos_io(Archive & ar, SiconosVector & v, unsigned int version)
 {
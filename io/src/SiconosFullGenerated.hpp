@@ -67,6 +67,21 @@ SICONOS_IO_REGISTER(InteractionProperties,
   (workBlockVectors)
   (workMatrices)
   (workVectors))
+SICONOS_IO_REGISTER(FiniteDifferenceJacobian,
+  (_colorColumns)
+  (_columnStart)
+  (_epsilon)
+  (_f0)
+  (_f1)
+  (_inputSize)
+  (_numberOfEvaluations)
+  (_outputSize)
+  (_probe)
+  (_probeScale)
+  (_probeStates)
+  (_probed)
+  (_rowIndex)
+  (_xeps))
 SICONOS_IO_REGISTER(MatrixIntegrator,
   (_DS)
   (_E)
@@ -157,6 +172,9 @@ SICONOS_IO_REGISTER(BoundaryCondition,
   (_prescribedVelocity)
   (_prescribedVelocityOld)
   (_velocityIndices))
+SICONOS_IO_REGISTER(ForcesBatch,
+  (_dynamicalSystems)
+  (_pluginForces))
 SICONOS_IO_REGISTER_WITH_BASES(NewtonImpactNSL,(NonSmoothLaw),
   (_e))
 SICONOS_IO_REGISTER_WITH_BASES(NewtonEulerFrom1DLocalFrameR,(NewtonEulerR),
@@ -284,6 +302,7 @@ SICONOS_IO_REGISTER_WITH_BASES(FirstOrderNonLinearDS,(DynamicalSystem),
   (_fold)
   (_invM)
   (_jacobianfx)
+  (_jacobianfxFD)
   (_pluginJacxf)
   (_pluginM)
   (_pluginf)
@@ -341,6 +360,11 @@ SICONOS_IO_REGISTER_WITH_BASES(LagrangianDS,(DynamicalSystem),
   (_velocity0)
   (_velocityMemory))
 SICONOS_IO_REGISTER_WITH_BASES(NewtonEulerDS,(DynamicalSystem),
+  (_FDJacobianFIntq)
+  (_FDJacobianFInttwist)
+  (_FDJacobianMGyrtwist)
+  (_FDJacobianMIntq)
+  (_FDJacobianMInttwist)
   (_I)
   (_T)
   (_Tdot)
@@ -417,6 +441,11 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeSteppingCombinedProjection,(TimeStepping),
   (_nbIndexSetsIteration)
   (_nbProjectionIteration)
   (_projectionMaxIteration))
+SICONOS_IO_REGISTER_WITH_BASES(TimeSteppingMultirate,(TimeStepping),
+  (_subStepsNSProblems))
+SICONOS_IO_REGISTER(TimeSteppingBatch,
+  (_numberOfSolves)
+  (_scenarios))
 SICONOS_IO_REGISTER_WITH_BASES(EventDriven,(Simulation),
   (_DSG0)
   (_TOL_ED)
@@ -544,6 +573,7 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeStepping,(Simulation),
   (_computeResiduY)
   (_displayNewtonConvergence)
   (_isNewtonConverge)
+  (_lastTimeStep)
   (_newtonCumulativeNbIterations)
   (_newtonMaxIteration)
   (_newtonNbIterations)
@@ -554,6 +584,7 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeStepping,(Simulation),
   (_newtonTolerance)
   (_newtonUpdateInteractionsPerIteration)
   (_resetAllLambda)
+  (_timeStepController)
   (_warnOnNonConvergence))
 SICONOS_IO_REGISTER(OneStepIntegrator,
   (_dynamicalSystemsGraph)
@@ -561,13 +592,16 @@ SICONOS_IO_REGISTER(OneStepIntegrator,
   (_extraAdditionalTerms)
   (_integratorType)
   (_isInitialized)
+  (_iterationMatrixContraction)
+  (_iterationMatrixMaxIterations)
   (_levelMaxForInput)
   (_levelMaxForOutput)
   (_levelMinForInput)
   (_levelMinForOutput)
   (_simulation)
   (_sizeMem)
-  (_steps))
+  (_steps)
+  (_subSteps))
 SICONOS_IO_REGISTER_WITH_BASES(Relay,(LinearOSNS),
   (_lb)
   (_ub))
@@ -592,6 +626,17 @@ SICONOS_IO_REGISTER(Event,
   (_tickIncrement)
   (_timeOfEvent)
   (_type))
+SICONOS_IO_REGISTER(TimeStepController,
+  (_absoluteTolerance)
+  (_growthMax)
+  (_hMax)
+  (_hMin)
+  (_maxIndexSetChanges)
+  (_newtonTargetIterations)
+  (_nonSmoothSolverTargetIterations)
+  (_relativeTolerance)
+  (_safety)
+  (_shrinkFactor))
 SICONOS_IO_REGISTER(TimeDiscretisation,
   (_h)
   (_hgmp)
@@ -612,7 +657,9 @@ SICONOS_IO_REGISTER(OneStepNSProblem,
   (_hasBeenUpdated)
   (_indexSetLevel)
   (_inputOutputLevel)
+  (_keepInteractionBlocks)
   (_maxSize)
+  (_numberOfComputedBlocks)
   (_simulation)
   (_sizeOutput))
 SICONOS_IO_REGISTER(OSNSMatrix,
@@ -639,8 +686,13 @@ SICONOS_IO_REGISTER_WITH_BASES(MoreauJeanGOSI,(OneStepIntegrator),
   (_useGamma)
   (_useGammaForRelation))
 SICONOS_IO_REGISTER_WITH_BASES(MoreauJeanOSI,(OneStepIntegrator),
+  (_batchedNewtonEulerW)
+  (_deterministicDSLoops)
   (_explicitNewtonEulerDSOperators)
+  (_forcesBatches)
+  (_forcesBatchesInitTime)
   (_gamma)
+  (_parallelDSLoops)
   (_theta)
   (_useGamma)
   (_useGammaForRelation))
@@ -1088,6 +1140,7 @@ void siconos_io_register_generated_Kernel(Archive& ar)
   ar.register_type(static_cast<GraphProperties*>(NULL));
   ar.register_type(static_cast<DynamicalSystemProperties*>(NULL));
   ar.register_type(static_cast<InteractionProperties*>(NULL));
+  ar.register_type(static_cast<FiniteDifferenceJacobian*>(NULL));
   ar.register_type(static_cast<MatrixIntegrator*>(NULL));
   ar.register_type(static_cast<DynamicalSystemsGraph*>(NULL));
   ar.register_type(static_cast<InteractionsGraph*>(NULL));
@@ -1105,6 +1158,7 @@ void siconos_io_register_generated_Kernel(Archive& ar)
   ar.register_type(static_cast<FirstOrderLinearTIR*>(NULL));
   ar.register_type(static_cast<NonSmoothDynamicalSystem*>(NULL));
   ar.register_type(static_cast<BoundaryCondition*>(NULL));
+  ar.register_type(static_cast<ForcesBatch*>(NULL));
   ar.register_type(static_cast<NewtonImpactNSL*>(NULL));
   ar.register_type(static_cast<NewtonEulerFrom1DLocalFrameR*>(NULL));
   ar.register_type(static_cast<LagrangianLinearTIR*>(NULL));
@@ -1132,6 +1186,8 @@ void siconos_io_register_generated_Kernel(Archive& ar)
   ar.register_type(static_cast<InteractionManager*>(NULL));
   ar.register_type(static_cast<TimeDiscretisationEvent*>(NULL));
   ar.register_type(static_cast<TimeSteppingCombinedProjection*>(NULL));
+  ar.register_type(static_cast<TimeSteppingMultirate*>(NULL));
+  ar.register_type(static_cast<TimeSteppingBatch*>(NULL));
   ar.register_type(static_cast<EventDriven*>(NULL));
   ar.register_type(static_cast<OSNSMultipleImpact*>(NULL));
   ar.register_type(static_cast<NonSmoothEvent*>(NULL));
@@ -1152,6 +1208,7 @@ void siconos_io_register_generated_Kernel(Archive& ar)
   ar.register_type(static_cast<MLCP*>(NULL));
   ar.register_type(static_cast<SchatzmanPaoliOSI*>(NULL));
   ar.register_type(static_cast<TimeDiscretisation*>(NULL));
+  ar.register_type(static_cast<TimeStepController*>(NULL));
   ar.register_type(static_cast<EventsManager*>(NULL));
   ar.register_type(static_cast<OSNSMatrix*>(NULL));
   ar.register_type(static_cast<OSNSMatrixProjectOnConstraints*>(NULL));
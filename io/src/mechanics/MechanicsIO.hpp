@@ -23,6 +23,10 @@
 #include <SiconosPointers.hpp>
 #include <SiconosFwd.hpp>
 
+/** Gather the state of the mechanical systems as tables, one row per
+ * object. The tables and their time index are written in the hdf5
+ * file by siconos.io.mechanics_run, not here.
+ */
 class MechanicsIO
 {
 protected:
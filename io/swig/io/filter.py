@@ -36,17 +36,17 @@ if __name__ == '__main__':
 # Heavier imports after command line parsing
 import numpy as np
 import h5py
+from siconos.io.mechanics_hdf5 import TimeIndex, indexed_tables, \
+    index_name, data, update_time_index
 
 class CopyVisitor(object):
     """The CopyVisitor is called for each group and dataset in the HDF5
        file, and is responsible for copying the structure to the new
        HDF5 file."""
     def __init__(self, time_filter = None, object_filter = None, attr_filter = None):
-        self.time_filter = None
-        if time_filter is not None:
-            self.time_filter = np.vectorize(time_filter)
+        self.time_filter = time_filter
         self.object_filter = object_filter
-        self.time_idx = None
+        self.times = None
         self.excluded_objects = None
         def copy_attrs(obj_to, obj_from):
             for a in obj_from.attrs:
@@ -79,12 +79,14 @@ class CopyVisitor(object):
             if id in self.excluded_objects:
                 return
 
-        # Get indexes of filtered times in data/dynamic
-        if (self.time_filter is not None
-              and (self.time_idx is None or self.times is None)):
-            dyn = obj.file['data/dynamic']
-            self.time_idx = self.time_filter(dyn[:,0]).nonzero()[0]
-            self.times = dyn[self.time_idx, 0]
+        # The time indexes are built again on the copy
+        if path in ['data/' + index_name(name) for name in indexed_tables]:
+            return
+
+        # Get filtered times of the steps in data/dynamic
+        if self.time_filter is not None and self.times is None:
+            dyn_index = time_index(obj.file, 'dynamic')
+            self.times = [t for t in dyn_index.times() if self.time_filter(t)]
 
         # Create parent groups
         if len(names) > 1:
@@ -109,13 +111,15 @@ class CopyVisitor(object):
 
             # Filter current indexes
             if path in ['data/cf', 'data/dynamic', 'data/velocities', 'data/static']:
-                if self.time_idx is not None:
-                    # Get indexes of corresponding times in current dataset
-                    if path == 'data/dynamic':
-                        time_idx = self.time_idx
-                    # Time-filter all but static objects
-                    elif path != 'data/static':
-                        time_idx = np.in1d(obj[:,0], self.times).nonzero()[0]
+                if self.times is not None:
+                    # Get indexes of the rows of the filtered steps
+                    # in current dataset, time-filter all but static
+                    # objects
+                    if path != 'data/static':
+                        index = time_index(obj.file, path.split('/')[-1])
+                        time_idx = np.concatenate(
+                            [np.empty(0, dtype=int)] +
+                            [index.rows(t) for t in self.times])
 
                 # Additionally remove any lines referencing excluded objects
                 if self.excluded_objects is not None:
@@ -167,6 +171,13 @@ class CopyVisitor(object):
         else:
             print('Unknown type "{0}": {1}'.format(path, str(obj.__class__)))
 
+def time_index(io, name):
+    """TimeIndex of the table data/name of an open file"""
+    index = None
+    if index_name(name) in io['data']:
+        index = io['data'][index_name(name)]
+    return TimeIndex(io['data'][name], index)
+
 if __name__ == '__main__':
     if os.path.exists(args.fn_out[0]):
         print('Output file "{0}" already exists!'.format(args.fn_out[0]))
@@ -236,3 +247,9 @@ if __name__ == '__main__':
                 object_filter = lambda name,obj: not re_exclude(name),
                 attr_filter = args.attr and AttrFilter(args.attr),
             ).visitor)
+
+            # Time indexes of the filtered tables
+            for name in indexed_tables:
+                if name in io_out['data']:
+                    update_time_index(io_out['data'][name],
+                                      data(io_out['data'], index_name(name), 3))
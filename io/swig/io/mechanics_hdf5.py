@@ -140,6 +140,119 @@ def add_line(dataset, line):
     dataset[dataset.shape[0] - 1, :] = line
 
 
+#
+# time index of the tables written at each step
+#
+# For a table 'name' of data, the dataset 'name_index' has one line
+# [time, offset, count] per output step: the rows of the step are
+# table[offset:offset+count].
+#
+# The index is written by the Python writer (mechanics_run), the C++
+# MechanicsIO only gathers the rows. A table written by another writer
+# has no index: it is built again from the time column when the file is
+# opened for writing or by upgrade_io_format, and in memory by
+# TimeIndex when the file is read only.
+#
+indexed_tables = ['dynamic', 'velocities', 'cf']
+
+
+def index_name(name):
+    return '{0}_index'.format(name)
+
+
+def build_time_index(table):
+    """
+    [time, offset, count] lines of the consecutive rows of a table
+    with the same time.
+    """
+    n = table.shape[0]
+    if n == 0:
+        return np.empty((0, 3))
+    times = table[:, 0]
+    starts = np.concatenate(([0], np.flatnonzero(np.diff(times)) + 1))
+    counts = np.diff(np.concatenate((starts, [n])))
+    return np.column_stack((times[starts], starts, counts))
+
+
+def time_index_is_valid(table, index):
+    """
+    True if the lines of the index cover all the rows of the table.
+    """
+    if index.shape[0] == 0:
+        return table.shape[0] == 0
+    return int(np.sum(index[:, 2])) == table.shape[0]
+
+
+def update_time_index(table, index):
+    """
+    Build again the index of a table if it does not cover the table
+    (file written before the index, or by another writer).
+    """
+    if not time_index_is_valid(table, index):
+        lines = build_time_index(table)
+        index.resize(lines.shape[0], 0)
+        if lines.shape[0] > 0:
+            index[:, :] = lines
+
+
+class TimeIndex(object):
+    """
+    Random access to the steps of a table: the rows of a step are read
+    with one hyperslab instead of a search in the time column. If the
+    index dataset is missing or does not cover the table, the index is
+    built in memory from the time column.
+    """
+
+    def __init__(self, table, index=None):
+        self._table = table
+        if index is not None and time_index_is_valid(table, index):
+            self._lines = index[:]
+        else:
+            self._lines = build_time_index(table)
+        self._steps = dict()
+        for k in range(self._lines.shape[0]):
+            self._steps.setdefault(self._lines[k, 0], []).append(k)
+
+    def times(self):
+        """
+        The sorted times of the steps.
+        """
+        return sorted(self._steps.keys())
+
+    def count(self, time):
+        """
+        Number of rows of the step at time.
+        """
+        return sum(int(self._lines[k, 2]) for k in self._steps.get(time, []))
+
+    def rows(self, time):
+        """
+        Indices of the rows of the step at time.
+        """
+        ks = self._steps.get(time, [])
+        if len(ks) == 0:
+            return np.empty(0, dtype=int)
+        return np.concatenate([np.arange(int(self._lines[k, 1]),
+                                         int(self._lines[k, 1] +
+                                             self._lines[k, 2]))
+                               for k in ks])
+
+    def __call__(self, time):
+        """
+        The rows of the table at time.
+        """
+        ks = self._steps.get(time, [])
+        slabs = [self._table[int(self._lines[k, 1]):
+                             int(self._lines[k, 1] + self._lines[k, 2]), :]
+                 for k in ks]
+        if len(slabs) == 0:
+            return np.empty((0, self._table.shape[1]))
+        elif len(slabs) == 1:
+            return slabs[0]
+        else:
+            return np.concatenate(slabs)
+
+
 
 #
 # misc fixes
@@ -161,6 +274,10 @@ contactor {0} attribute 'name': renamed in 'shape_name'
                     contactor.attrs['shape_name'] = contactor['name']
                     del contactor['name']
 
+        # time index of the tables, written since the index exists
+        for name in indexed_tables:
+            update_time_index(io._data[name], io._time_indices[name])
+
 
 def str_of_file(filename):
     with open(filename, 'r') as f:
@@ -463,6 +580,7 @@ class MechanicsHdf5(object):
         self._velocities_data = None
         self._dynamic_data = None
         self._cf_data = None
+        self._time_indices = dict()
         self._domain_data = None
         self._solv_data = None
         self._input = None
@@ -509,6 +627,13 @@ class MechanicsHdf5(object):
         if self._should_output_domains or 'domain' in self._data:
             self._domain_data = data(self._data, 'domain', 3,
                                      use_compression = self._use_compression)
+        for name in indexed_tables:
+            if self._mode != 'r' or index_name(name) in self._data:
+                self._time_indices[name] = data(self._data, index_name(name),
+                                                3)
+        if self._mode != 'r':
+            for name in indexed_tables:
+                update_time_index(self._data[name], self._time_indices[name])
         self._solv_data = data(self._data, 'solv', 4,
                                use_compression = self._use_compression)
         self._input = group(self._data, 'input')
@@ -517,6 +642,10 @@ class MechanicsHdf5(object):
         return self
 
     def __exit__(self, type_, value, traceback):
+        if self._mode != 'r':
+            # tables written without the index
+            for name in indexed_tables:
+                update_time_index(self._data[name], self._time_indices[name])
         self._out.close()
 
 # hdf5 structure
@@ -558,6 +687,13 @@ class MechanicsHdf5(object):
         """
         return self._cf_data
 
+    def time_index(self, name):
+        """
+        Random access to the steps of the table name ('dynamic',
+        'velocities' or 'cf').
+        """
+        return TimeIndex(self._data[name], self._time_indices.get(name))
+
     def domains_data(self):
         """
         Contact point domain information.
@@ -21,6 +21,7 @@ from contextlib import contextmanager
 
 # Siconos imports
 import siconos.io.mechanics_hdf5
+from siconos.io.mechanics_hdf5 import add_line
 import siconos.numerics as Numerics
 from siconos.kernel import \
     EqualityConditionNSL, \
@@ -215,6 +216,7 @@ def group(h, name, must_exist=True):
                 # (file is probably in read-only mode)
                 return None
 
+
 def data(h, name, nbcolumns, use_compression=False):
     try:
         return h[name]
@@ -233,19 +235,7 @@ def data(h, name, nbcolumns, use_compression=False):
 # fix ctr.'name' in old hdf5 files
 #
 def upgrade_io_format(filename):
-
-    with MechanicsHdf5(filename, mode='a') as io:
-
-        for instance_name in io.instances():
-            for contactor_instance_name in io.instances()[instance_name]:
-                contactor = io.instances()[instance_name][
-                    contactor_instance_name]
-                if 'name' in contactor.attrs:
-                    warn("""
-contactor {0} attribute 'name': renamed in 'shape_name'
-                    """)
-                    contactor.attrs['shape_name'] = contactor['name']
-                    del contactor['name']
+    siconos.io.mechanics_hdf5.upgrade_io_format(filename)
 
 
 def str_of_file(filename):
@@ -1384,14 +1374,17 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             dpos_data = self.dynamic_data()
             if dpos_data is not None and len(dpos_data) > 0:
 
-                max_time = max(dpos_data[:, 0])
-                id_last = np.where(
-                    abs(dpos_data[:, 0] - max_time) < 1e-9)[0]
+                # the last step, read once
+                dpos_index = self.time_index('dynamic')
+                max_time = dpos_index.times()[-1]
+                dpos_last = dpos_index(max_time)
+                velo_last = self.time_index('velocities')(max_time)
 
             else:
                 # should not be used
                 max_time = None
-                id_last = None
+                dpos_last = None
+                velo_last = None
 
             for (name, obj) in sorted(self._input.items(),
                                       key=lambda x: x[0]):
@@ -1422,20 +1415,16 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                             print ('imported object has id: {0}'.format(obj.attrs['id']))
 
                         id_last_inst = np.where(
-                            dpos_data[id_last, 1] ==
+                            dpos_last[:, 1] ==
                             self.instances()[name].attrs['id'])[0]
-                        xpos = dpos_data[id_last[id_last_inst[0]], :]
+                        xpos = dpos_last[id_last_inst[0], :]
                         translation = (xpos[2], xpos[3], xpos[4])
                         orientation = (xpos[5], xpos[6], xpos[7], xpos[8])
 
-                        velocities = self.velocities_data()
-                        id_vlast = np.where(
-                            abs(velocities[:, 0] - max_time) < 1e-9)[0]
-
                         id_vlast_inst = np.where(
-                            velocities[id_vlast, 1] ==
+                            velo_last[:, 1] ==
                             self.instances()[name].attrs['id'])[0]
-                        xvel = velocities[id_vlast[id_vlast_inst[0]], :]
+                        xvel = velo_last[id_vlast_inst[0], :]
                         velocity = (xvel[2], xvel[3], xvel[4],
                                     xvel[5], xvel[6], xvel[7])
 
@@ -1564,13 +1553,15 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             self._dynamic_data[current_line:, :] = np.concatenate((times,
                                                                    positions),
                                                                   axis=1)
+            add_line(self._time_indices['dynamic'],
+                     [time, current_line, positions.shape[0]])
 
     def output_velocities(self):
         """
         Output velocities of dynamic objects
         """
 
-        current_line = self._dynamic_data.shape[0]
+        current_line = self._velocities_data.shape[0]
 
         time = self.current_time()
 
@@ -1586,6 +1577,8 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             self._velocities_data[current_line:, :] = np.concatenate((times,
                                                                       velocities),
                                                                      axis=1)
+            add_line(self._time_indices['velocities'],
+                     [time, current_line, velocities.shape[0]])
 
     def output_contact_forces(self):
         """
@@ -1609,6 +1602,8 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                     np.concatenate((times,
                                     contact_points),
                                    axis=1)
+                add_line(self._time_indices['cf'],
+                         [time, current_line, contact_points.shape[0]])
 
     def output_domains(self):
         """
@@ -1824,8 +1819,7 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         # cold restart
         times=set()
         if self.dynamic_data() is not None and len(self.dynamic_data()) > 0:
-            dpos_data=self.dynamic_data()
-            times=set(dpos_data[:, 0])
+            times=set(self.time_index('dynamic').times())
             t0=float(max(times))
 
         # Time-related parameters for this simulation run
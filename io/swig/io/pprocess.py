@@ -179,16 +179,15 @@ def make_slider(minv, maxv, vstep):
 
 
 
-with IO.Hdf5('siconos-mechanisms.hdf5', 'r') as io:
+with IO.MechanicsHdf5Runner(io_filename='siconos-mechanisms.hdf5', mode='r') as io:
 
     display, start_display, add_menu, add_function_to_menu, win, app = init_display()
 
-    dpos_data = io.dynamic_data()[:]
-    nbobjs = len(filter(lambda x: io.instances()[x].attrs['id'] >= 0, io.instances()))
+    # steps of the dynamic table, read with one hyperslab per step
+    dpos_index = io.time_index('dynamic')
+    times = dpos_index.times()
 
-    nbsteps = dpos_data.shape[0] / nbobjs
-
-    assert nbsteps * nbobjs == dpos_data.shape[0]
+    nbsteps = len(times)
 
     current_color = 0
     @memoize
@@ -259,7 +258,8 @@ with IO.Hdf5('siconos-mechanisms.hdf5', 'r') as io:
 
         step = int(step_str)
 
-        positions = dpos_data[nbobjs*step:nbobjs*step+nbobjs, 2:]
+        dpos_step = dpos_index(times[step])
+        positions = dpos_step[:, 2:]
 
         builder = BRep_Builder()
         comp = TopoDS_Compound()
@@ -269,7 +269,7 @@ with IO.Hdf5('siconos-mechanisms.hdf5', 'r') as io:
 
             q0, q1, q2, q3, q4, q5, q6 = [float(x) for x in positions[_id,:]]
 
-            obj = obj_by_id[_id+1]
+            obj = obj_by_id[int(dpos_step[_id, 1])]
 
             q = Quaternion((q3, q4, q5, q6))
 
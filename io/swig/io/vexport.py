@@ -290,7 +290,7 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
         ispos_data = io.static_data()
         idpos_data = io.dynamic_data()
         ivelo_data = io.velocities_data()
-        icf_data = io.contact_forces_data()[:]
+        icf_data = io.contact_forces_data()
 
         isolv_data = io.solver_data()
 
@@ -298,6 +298,11 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
 
     spos_data, dpos_data, velo_data, cf_data, solv_data = load()
 
+    # steps of the tables, read with one hyperslab per frame
+    dpos_index = io.time_index('dynamic')
+    velo_index = io.time_index('velocities')
+    cf_index = io.time_index('cf')
+
     class DataConnector():
 
         def __init__(self, instance, data_name='velocity', data_size=6):
@@ -330,8 +335,10 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
     # contact forces provider
     class ContactInfoSource():
 
-        def __init__(self, data):
+        def __init__(self, data, index=None):
             self._data = None
+            # random access to the steps of data (TimeIndex)
+            self._index = index
 
             if data is not None:
                 if len(data) > 0:
@@ -357,20 +364,19 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
             output_a = self._contact_source_a.GetPolyDataOutput()
             output_b = self._contact_source_b.GetPolyDataOutput()
 
-            id_f = numpy.where(
-                abs(self._data[:, 0] - self._time) < 1e-15)[0]
+            if self._index is not None:
+                data_t = self._index(self._time)
+            else:
+                data_t = self._data[numpy.where(
+                    abs(self._data[:, 0] - self._time) < 1e-15)[0], :]
 
-            self.cpa_export = self._data[
-                id_f, 2:5].copy()
+            self.cpa_export = data_t[:, 2:5].copy()
 
-            self.cpb_export = self._data[
-                id_f, 5:8].copy()
+            self.cpb_export = data_t[:, 5:8].copy()
 
-            self.cn_export = self._data[
-                id_f, 8:11].copy()
+            self.cn_export = data_t[:, 8:11].copy()
 
-            self.cf_export = self._data[
-                id_f, 11:14].copy()
+            self.cf_export = data_t[:, 11:14].copy()
 
             self.cpa_ = numpy_support.numpy_to_vtk(
                 self.cpa_export)
@@ -583,18 +589,15 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
                  contactor_instance_name].attrs['translation'],
                     io.instances()[instance_name][contactor_instance_name].attrs['orientation']))
 
-    pos_data = dpos_data[:].copy()
     spos_data = spos_data[:].copy()
-    velo_data = velo_data[:].copy()
 
     set_velocityv = build_set_velocity(data_connectors_v)
     set_translationv = build_set_translation(data_connectors_t)
     set_displacementv = build_set_displacement(data_connectors_d)
 
-    times = list(set(dpos_data[:, 0]))
-    times.sort()
+    times = dpos_index.times()
 
-    contact_info_source = ContactInfoSource(cf_data)
+    contact_info_source = ContactInfoSource(cf_data, cf_index)
 
     pveloa = DataConnector(0)
     pvelob = DataConnector(0)
@@ -626,7 +629,7 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
         # fix: should be called by contact_source?
         contact_info_source.method()
 
-        id_t = numpy.where(pos_data[:, 0] == times[index])
+        pos_t = dpos_index(times[index])
 
         if numpy.shape(spos_data)[0] > 0:
             set_positionv(spos_data[:, 1], spos_data[:, 2],
@@ -636,26 +639,26 @@ with MechanicsHdf5(io_filename=io_filename, mode='r') as io:
                           spos_data[:, 7], spos_data[:, 8])
 
         set_positionv(
-            pos_data[id_t, 1], pos_data[id_t, 2], pos_data[id_t, 3],
-            pos_data[id_t, 4], pos_data[id_t, 5], pos_data[id_t, 6],
-            pos_data[id_t, 7], pos_data[id_t, 8])
+            pos_t[:, 1], pos_t[:, 2], pos_t[:, 3],
+            pos_t[:, 4], pos_t[:, 5], pos_t[:, 6],
+            pos_t[:, 7], pos_t[:, 8])
 
-        id_tv = numpy.where(velo_data[:, 0] == times[index])
+        velo_t = velo_index(times[index])
 
         set_velocityv(
-            velo_data[id_tv, 1],
-            velo_data[id_tv, 2],
-            velo_data[id_tv, 3],
-            velo_data[id_tv, 4],
-            velo_data[id_tv, 5],
-            velo_data[id_tv, 6],
-            velo_data[id_tv, 7])
+            velo_t[:, 1],
+            velo_t[:, 2],
+            velo_t[:, 3],
+            velo_t[:, 4],
+            velo_t[:, 5],
+            velo_t[:, 6],
+            velo_t[:, 7])
 
         set_translationv(
-            pos_data[id_t, 1],
-            pos_data[id_t, 2],
-            pos_data[id_t, 3],
-            pos_data[id_t, 4],
+            pos_t[:, 1],
+            pos_t[:, 2],
+            pos_t[:, 3],
+            pos_t[:, 4],
         )
 
         # set_displacementv(
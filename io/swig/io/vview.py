@@ -339,8 +339,10 @@ class Quaternion():
 # contact forces provider
 class CFprov():
 
-    def __init__(self, data, dom_data):
+    def __init__(self, data, dom_data, index=None):
         self._data = None
+        # random access to the steps of data (TimeIndex)
+        self._index = index
         self._datap = numpy.array(
             [[1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11., 12., 13., 14., 15.]])
         self._mu_coefs = []
@@ -386,8 +388,11 @@ class CFprov():
 
         if self._data is not None:
 
-            id_f = numpy.where(
-                abs(self._data[:, 0] - self._time) < 1e-15)[0]
+            if self._index is not None:
+                data_t = self._index(self._time)
+            else:
+                data_t = self._data[numpy.where(
+                    abs(self._data[:, 0] - self._time) < 1e-15)[0], :]
 
             dom_id_f = None
             if self._dom_data is not None:
@@ -398,22 +403,18 @@ class CFprov():
 
                 try:
                     imu = numpy.where(
-                        abs(self._data[id_f, 1] - mu) < 1e-15)[0]
+                        abs(data_t[:, 1] - mu) < 1e-15)[0]
 
                     dom_imu = None
                     if dom_id_f is not None:
                         dom_imu = numpy.where(
-                            self._dom_data[dom_id_f,-1] == self._data[id_f[imu],-1]
+                            self._dom_data[dom_id_f,-1] == data_t[imu,-1]
                         )[0]
 
-                    self.cpa_at_time[mu] = self._data[
-                        id_f[imu], 2:5]
-                    self.cpb_at_time[mu] = self._data[
-                        id_f[imu], 5:8]
-                    self.cn_at_time[mu] = - self._data[
-                        id_f[imu], 8:11]
-                    self.cf_at_time[mu] = self._data[
-                        id_f[imu], 11:14]
+                    self.cpa_at_time[mu] = data_t[imu, 2:5]
+                    self.cpb_at_time[mu] = data_t[imu, 5:8]
+                    self.cn_at_time[mu] = - data_t[imu, 8:11]
+                    self.cf_at_time[mu] = data_t[imu, 11:14]
 
                     self.cpa[mu] = numpy_support.numpy_to_vtk(
                         self.cpa_at_time[mu])
@@ -492,8 +493,7 @@ class InputObserver():
 
         self.vview.set_dynamic_actors_visibility(self._times[index])
 
-        id_t = numpy.where(self.vview.pos_data[:, 0] == self._times[index])
-        self.vview.set_position(*self.vview.pos_data[id_t, :])
+        self.vview.set_position(self.vview.dpos_index(self._times[index]))
 
         self._slider_repres.SetValue(self._time)
 
@@ -510,8 +510,8 @@ class InputObserver():
         index = max(0, index)
         index = min(index, len(self._times) - 1)
 
-        id_t = numpy.where(pos_data[:, 0] == self._times[index])
-        return (pos_data[id_t[0][id_], 2], pos_data[id_t[0][id_], 3], pos_data[id_t[0][id_], 4])
+        pos_t = self.vview.dpos_index(self._times[index])
+        return (pos_t[id_, 2], pos_t[id_, 3], pos_t[id_, 4])
 
     def set_opacity(self):
         for instance, actors in self.vview.dynamic_actors.items():
@@ -831,20 +831,25 @@ class VView(object):
         except ValueError:
             idom_data = None
 
-        icf_data = self.io.contact_forces_data()[:]
+        icf_data = self.io.contact_forces_data()
 
         isolv_data = self.io.solver_data()
         ivelo_data = self.io.velocities_data()
 
+        # steps of the tables, read with one hyperslab per frame
+        self.dpos_index = self.io.time_index('dynamic')
+        self.velo_index = self.io.time_index('velocities')
+        self.cf_index = self.io.time_index('cf')
+
         return ispos_data, idpos_data, idom_data, icf_data, isolv_data, ivelo_data
 
     def reload(self):
         (self.spos_data, self.dpos_data, self.dom_data,
          self.cf_data, self.solv_data, self.velo_data) = self.load()
         if not self.opts.cf_disable:
-            self.cf_prov = CFprov(self.cf_data, self.dom_data)
-        times = list(set(self.dpos_data[:, 0]))
-        times.sort()
+            self.cf_prov = CFprov(self.cf_data, self.dom_data,
+                                  self.cf_index)
+        times = self.dpos_index.times()
 
         if len(self.spos_data) > 0:
             self.instances = set(self.dpos_data[:, 1]).union(
@@ -863,10 +868,7 @@ class VView(object):
                 self.contact_pos_force[mu].Update()
                 self.contact_pos_norm[mu].Update()
 
-        self.id_t0 = numpy.where(
-            self.dpos_data[:, 0] == self.time0)
-
-        self.pos_data = self.dpos_data[:]
+        self.pos_data = self.dpos_data
         self.min_time = times[0]
         self.set_dynamic_actors_visibility(self.time0)
 
@@ -1673,14 +1675,12 @@ class VView(object):
         self.time0 = None
         try:
             # Positions at first time step
-            self.time0 = min(self.dpos_data[:, 0])
-            self.id_t0 = numpy.where(self.dpos_data[:, 0] == self.time0)
-            self.pos_t0 = self.pos_data[self.id_t0, 0:9]
+            self.time0 = min(self.dpos_index.times())
+            self.pos_t0 = self.dpos_index(self.time0)[:, 0:9]
         except ValueError:
             # this is for the case simulation hass not been ran and
             # time does not exists
             self.time0 = 0
-            self.id_t0 = None
             self.pos_t0 = numpy.array([
                 numpy.hstack(([0.,
                                self.io.instances()[k].attrs['id']]
@@ -1696,7 +1696,7 @@ class VView(object):
                 for actor,_,_ in actors:
                      actor.VisibilityOn()
 
-        self.set_position(*self.pos_t0)
+        self.set_position(self.pos_t0)
 
         self.set_dynamic_actors_visibility(self.time0)
 
@@ -1934,8 +1934,7 @@ class VView(object):
         add_compatiblity_methods(big_data_writer)
         big_data_writer.SetInputConnection(self.big_data_source.GetOutputPort())
 
-        times = list(set(self.dpos_data[:, 0]))
-        times.sort()
+        times = self.dpos_index.times()
         ntime = len(times)
         k=0
         packet= int(ntime/100)+1
@@ -1952,7 +1951,7 @@ class VView(object):
             # fix: should be called by contact_source?
             self.cf_prov.xmethod()
 
-            id_t = numpy.where(self.pos_data[:, 0] == times[index])
+            pos_t = self.dpos_index(times[index])
 
             if numpy.shape(self.spos_data)[0] > 0:
                 self.set_position_v(self.spos_data[:, 1], self.spos_data[:, 2],
@@ -1962,26 +1961,26 @@ class VView(object):
                               self.spos_data[:, 7], self.spos_data[:, 8])
 
             self.set_position_v(
-                self.pos_data[id_t, 1], self.pos_data[id_t, 2], self.pos_data[id_t, 3],
-                self.pos_data[id_t, 4], self.pos_data[id_t, 5], self.pos_data[id_t, 6],
-                self.pos_data[id_t, 7], self.pos_data[id_t, 8])
+                pos_t[:, 1], pos_t[:, 2], pos_t[:, 3],
+                pos_t[:, 4], pos_t[:, 5], pos_t[:, 6],
+                pos_t[:, 7], pos_t[:, 8])
 
-            id_tv = numpy.where(self.velo_data[:, 0] == times[index])[0]
+            velo_t = self.velo_index(times[index])
 
             self.set_velocity_v(
-                self.velo_data[id_tv, 1],
-                self.velo_data[id_tv, 2],
-                self.velo_data[id_tv, 3],
-                self.velo_data[id_tv, 4],
-                self.velo_data[id_tv, 5],
-                self.velo_data[id_tv, 6],
-                self.velo_data[id_tv, 7])
+                velo_t[:, 1],
+                velo_t[:, 2],
+                velo_t[:, 3],
+                velo_t[:, 4],
+                velo_t[:, 5],
+                velo_t[:, 6],
+                velo_t[:, 7])
 
             self.set_translation_v(
-                self.pos_data[id_t, 1],
-                self.pos_data[id_t, 2],
-                self.pos_data[id_t, 3],
-                self.pos_data[id_t, 4],
+                pos_t[:, 1],
+                pos_t[:, 2],
+                pos_t[:, 3],
+                pos_t[:, 4],
             )
 
             big_data_writer.SetFileName('{0}-{1}.{2}'.format(
@@ -2017,11 +2016,12 @@ class VView(object):
 
         self.cf_prov = None
         if not self.opts.cf_disable:
-            self.cf_prov = CFprov(self.cf_data, self.dom_data)
+            self.cf_prov = CFprov(self.cf_data, self.dom_data,
+                                  self.cf_index)
             for mu in self.cf_prov._mu_coefs:
                 self.init_contact_pos(mu)
 
-        times = self.dpos_data[:, 0]
+        times = self.dpos_index.times()
 
         if (len(times) == 0):
             print('No dynamic data found!  Empty simulation.')
@@ -2045,7 +2045,7 @@ class VView(object):
                            'stl': vtk.vtkSTLReader}
         self.unfrozen_mappers = dict()
 
-        self.pos_data = self.dpos_data[:]
+        self.pos_data = self.dpos_data
         self.spos_data = self.spos_data[:]
         self.build_set_functions()
 
@@ -2076,7 +2076,7 @@ class VView(object):
     def initialize_gui(self):
 
         self.setup_vtk_renderer()
-        times = self.dpos_data[:, 0]
+        times = self.dpos_index.times()
         self.setup_sliders(times)
         self.setup_charts()
         self.setup_axes()
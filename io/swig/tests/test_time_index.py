@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+
+import os
+import tempfile
+
+import numpy as np
+import h5py
+
+from siconos.io.mechanics_hdf5 import MechanicsHdf5, TimeIndex, \
+    add_line, build_time_index, update_time_index, upgrade_io_format, \
+    index_name
+
+# (time, number of rows) of the steps written in the tables, exact in
+# single precision
+steps = [(0., 3), (0.25, 0), (0.5, 2), (0.75, 4), (1., 1)]
+
+
+def rows(time, count):
+    table = np.empty((count, 9))
+    table[:, 0] = time
+    table[:, 1] = np.arange(count) + 1
+    table[:, 2:] = time * 4 + np.arange(count)[:, None]
+    return table
+
+
+def write_steps(dataset, index=None):
+    """as MechanicsHdf5Runner.output_dynamic_objects"""
+    for time, count in steps:
+        if count == 0:
+            continue
+        current_line = dataset.shape[0]
+        dataset.resize(current_line + count, 0)
+        dataset[current_line:, :] = rows(time, count)
+        if index is not None:
+            add_line(index, [time, current_line, count])
+
+
+def check_seek(ti):
+    assert ti.times() == [time for time, count in steps if count > 0]
+    for time, count in steps:
+        assert ti.count(time) == count
+        assert np.array_equal(ti(time), rows(time, count))
+
+
+def check_rows(ti):
+    offset = 0
+    for time in ti.times():
+        r = ti.rows(time)
+        assert np.array_equal(r, np.arange(offset, offset + len(r)))
+        offset += len(r)
+
+
+def test_write_and_seek():
+    ''' index written along the table, then random access'''
+    filename = os.path.join(tempfile.mkdtemp(), 'index.hdf5')
+    with MechanicsHdf5(filename, mode='w', verbose=False) as io:
+        write_steps(io.dynamic_data(), io._time_indices['dynamic'])
+
+    with MechanicsHdf5(filename, mode='r', verbose=False) as io:
+        index = io._time_indices['dynamic'][:]
+        assert np.array_equal(index, build_time_index(io.dynamic_data()))
+        assert index.shape[0] == len([s for s in steps if s[1] > 0])
+        check_seek(io.time_index('dynamic'))
+        check_rows(io.time_index('dynamic'))
+
+
+def test_update_time_index():
+    ''' index of a table written by another writer'''
+    filename = os.path.join(tempfile.mkdtemp(), 'update.hdf5')
+    with h5py.File(filename, 'w') as f:
+        table = f.create_dataset('dynamic', (0, 9), maxshape=(None, 9))
+        index = f.create_dataset('dynamic_index', (0, 3), maxshape=(None, 3))
+        write_steps(table, index)
+        # steps written again without their index lines
+        write_steps(table)
+        update_time_index(table, index)
+        assert np.array_equal(index[:], build_time_index(table))
+        assert int(np.sum(index[:, 2])) == table.shape[0]
+
+
+def test_upgrade_old_file():
+    ''' a file written before the index is upgraded, then read'''
+    filename = os.path.join(tempfile.mkdtemp(), 'old.hdf5')
+    with MechanicsHdf5(filename, mode='w', verbose=False) as io:
+        pass
+
+    # the tables of an old file, without their index
+    with h5py.File(filename, 'a') as f:
+        for name in ['dynamic', 'velocities', 'cf']:
+            del f['data'][index_name(name)]
+        write_steps(f['data']['dynamic'])
+
+    # read only: the index is built in memory
+    with MechanicsHdf5(filename, mode='r', verbose=False) as io:
+        assert 'dynamic' not in io._time_indices
+        check_seek(io.time_index('dynamic'))
+
+    upgrade_io_format(filename)
+
+    with h5py.File(filename, 'r') as f:
+        index = f['data'][index_name('dynamic')][:]
+        assert np.array_equal(index, build_time_index(f['data']['dynamic']))
+
+    with MechanicsHdf5(filename, mode='r', verbose=False) as io:
+        check_seek(io.time_index('dynamic'))
+        ti = TimeIndex(io.dynamic_data(), io._time_indices['dynamic'])
+        check_seek(ti)
@@ -71,9 +71,9 @@ if(WITH_${COMPONENT}_TESTING)
   BEGIN_TEST(src/simulationTools/test)
 
   IF(HAS_FORTRAN)
-    NEW_TEST(testSimulationTools OSNSPTest.cpp ZOHTest.cpp)
+    NEW_TEST(testSimulationTools OSNSPTest.cpp ZOHTest.cpp NewtonEulerWBatchTest.cpp MoreauJeanOSITest.cpp TimeStepControllerTest.cpp TimeSteppingMultirateTest.cpp TimeSteppingBatchTest.cpp InteractionsGraphSnapshotTest.cpp LinearOSNSTest.cpp)
    ELSE()
-    NEW_TEST(testSimulationTools OSNSPTest.cpp)
+    NEW_TEST(testSimulationTools OSNSPTest.cpp NewtonEulerWBatchTest.cpp MoreauJeanOSITest.cpp TimeStepControllerTest.cpp TimeSteppingMultirateTest.cpp TimeSteppingBatchTest.cpp InteractionsGraphSnapshotTest.cpp LinearOSNSTest.cpp)
   ENDIF()
   
   END_TEST()
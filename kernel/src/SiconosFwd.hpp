@@ -63,12 +63,14 @@ DEFINE_SPTR(MixedComplementarityConditionNSL)
 DEFINE_SPTR(NormalConeNSL)
 
 DEFINE_SPTR(TimeDiscretisation)
+DEFINE_SPTR(TimeStepController)
 
 // Dynamical systems
 DEFINE_SPTR(DynamicalSystem)
 DEFINE_SPTR(LagrangianLinearTIDS)
 DEFINE_SPTR(LagrangianLinearDiagonalDS)
 DEFINE_SPTR(NewtonEulerDS)
+DEFINE_SPTR(ForcesBatch)
 
 DEFINE_SPTR(Event)
 DEFINE_SPTR(NonSmoothLaw)
@@ -81,6 +83,7 @@ DEFINE_SPTR_STRUCT(ExtraAdditionalTerms)
 DEFINE_SPTR(SiconosMatrix)
 DEFINE_SPTR(SimpleMatrix)
 DEFINE_SPTR(BlockMatrix)
+DEFINE_SPTR(FiniteDifferenceJacobian)
 DEFINE_SPTR(SiconosVector)
 DEFINE_SPTR(BlockVector)
 
@@ -112,6 +115,7 @@ DEFINE_SPTR_STRUCT(InteractionProperties)
 DEFINE_SPTR_STRUCT(GraphProperties)
 DEFINE_SPTR_STRUCT(DynamicalSystemsGraph)
 DEFINE_SPTR_STRUCT(InteractionsGraph)
+DEFINE_SPTR(InteractionsGraphSnapshot)
 
 #ifndef _F2C_INCLUDE_H
 typedef int integer;
@@ -80,6 +80,13 @@ DynamicalSystem::DynamicalSystem(const DynamicalSystem & ds):
   _stepsInMemory = ds.stepsInMemory();
 }
 
+void DynamicalSystem::restoreFromMemory()
+{
+  if(_xMemory.nbVectorsInMemory() == 0)
+    RuntimeException::selfThrow("DynamicalSystem::restoreFromMemory() - no state in memory");
+  *(_x[0]) = _xMemory.getSiconosVector(0);
+}
+
 void DynamicalSystem::resetToInitialState()
 {
   if(_x0)
@@ -255,3 +262,8 @@ void DynamicalSystem::initMemory(unsigned int steps)
   DEBUG_END("void DynamicalSystem::initMemory(unsigned int steps)\n");
 }
 
+void DynamicalSystem::collectMemories(std::vector<SiconosMemory*>& memories)
+{
+  memories.push_back(&_xMemory);
+}
+
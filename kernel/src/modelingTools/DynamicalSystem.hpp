@@ -423,6 +423,17 @@ public:
    */
   virtual void swapInMemory() = 0;
 
+  /** restore the state saved by the last call to swapInMemory() (index
+   *  0 of the memories), to compute a time step again
+   */
+  virtual void restoreFromMemory();
+
+  /** append the SiconosMemory objects of the system to a list (used
+   *  to store them in a contiguous array, see Simulation::setUseMemorySlab)
+   *  \param memories the list
+   */
+  virtual void collectMemories(std::vector<SiconosMemory*>& memories);
+
   //@}
 
   /*! @name Plugins management  */
@@ -18,11 +18,14 @@
 
 #include "FirstOrderNonLinearDS.hpp"
 #include "PluginTypes.hpp"
+#include "FiniteDifferenceJacobian.hpp"
 
 // #define DEBUG_MESSAGES
 // #define DEBUG_STDOUT
 #include "debug.h"
 #include <iostream>
+#include <limits>
+#include <cmath>
 
 // ===== CONSTRUCTORS =====
 
@@ -78,6 +81,8 @@ FirstOrderNonLinearDS::FirstOrderNonLinearDS(const FirstOrderNonLinearDS & FONLD
     _f.reset(new SiconosVector(*(FONLDS.f())));
   if (FONLDS.jacobianfx())
     _jacobianfx.reset(new SimpleMatrix(*(FONLDS.jacobianfx())));
+  if (FONLDS.jacobianfxByFD())
+    _jacobianfxFD.reset(new FiniteDifferenceJacobian(*(FONLDS.jacobianfxByFD())));
   if (FONLDS.getPluginF())
     _pluginf.reset(new PluggedObject(*(FONLDS.getPluginF())));
   if (FONLDS.getPluginJacxf())
@@ -169,6 +174,19 @@ void FirstOrderNonLinearDS::swapInMemory()
   DEBUG_END("void FirstOrderNonLinearDS::swapInMemory()\n");
 }
 
+void FirstOrderNonLinearDS::restoreFromMemory()
+{
+  DynamicalSystem::restoreFromMemory();
+  if(_r && _rMemory.nbVectorsInMemory() > 0)
+    *_r = _rMemory.getSiconosVector(0);
+}
+
+void FirstOrderNonLinearDS::collectMemories(std::vector<SiconosMemory*>& memories)
+{
+  DynamicalSystem::collectMemories(memories);
+  memories.push_back(&_rMemory);
+}
+
 // ===== COMPUTE PLUGINS FUNCTIONS =====
 
 void FirstOrderNonLinearDS::setComputeMFunction(const std::string& pluginPath, const std::string& functionName)
@@ -230,10 +248,46 @@ void FirstOrderNonLinearDS::computef(double time, SP::SiconosVector state)
     ((FNLDSPtrfct)_pluginf->fPtr)(time, _n, &(*state)(0) , &(*_f)(0), _z->size(), &(*_z)(0));
 }
 
+void FirstOrderNonLinearDS::setComputeJacobianfxByFD(bool value)
+{
+  if (value)
+  {
+    if (!_jacobianfx)
+      _jacobianfx.reset(new SimpleMatrix(_n, _n));
+    if (!_jacobianfxFD)
+      _jacobianfxFD.reset(new FiniteDifferenceJacobian(_n, _n, sqrt(std::numeric_limits< double >::epsilon())));
+  }
+  else
+    _jacobianfxFD.reset();
+}
+
+/** f(x) of a FirstOrderNonLinearDS at a given time, for the finite
+ * difference Jacobian */
+class FirstOrderNonLinearDSf : public FiniteDifferenceJacobian::Function
+{
+  FirstOrderNonLinearDS& _ds;
+  double _time;
+public:
+  FirstOrderNonLinearDSf(FirstOrderNonLinearDS& ds, double time): _ds(ds), _time(time) {};
+  void compute(SP::SiconosVector x, SP::SiconosVector fx)
+  {
+    _ds.computef(_time, x);
+    *fx = *_ds.f();
+  };
+};
+
 void FirstOrderNonLinearDS::computeJacobianfx(double time, SP::SiconosVector state)
 {
   if (_jacobianfx && _pluginJacxf->fPtr)
     ((FNLDSPtrfct)_pluginJacxf->fPtr)(time, _n, state->getArray(), &(*_jacobianfx)(0, 0), _z->size(), _z->getArray());
+  else if (_jacobianfx && _jacobianfxFD && _f && _pluginf->fPtr)
+  {
+    // the evaluations of f overwrite _f
+    SiconosVector f(*_f);
+    FirstOrderNonLinearDSf function(*this, time);
+    _jacobianfxFD->compute(function, state, *_jacobianfx);
+    *_f = f;
+  }
 }
 
 void FirstOrderNonLinearDS::computeRhs(double time)
@@ -105,6 +105,10 @@ protected:
   /** Gradient of \f$ f(x,t,z) \f$ with respect to \f$ x\f$*/
   SP::SiconosMatrix _jacobianfx;
 
+  /** finite difference engine of _jacobianfx, when it is not given by
+   *  a plug-in (see setComputeJacobianfxByFD()) */
+  SP::FiniteDifferenceJacobian _jacobianfxFD;
+
   /** DynamicalSystem plug-in to compute f(x,t,z)
    *  \param current time
    *  \param size of the vector _x
@@ -297,6 +301,15 @@ public:
    */
   void swapInMemory();
 
+  /** restore x and r from their memories
+   */
+  void restoreFromMemory();
+
+  /** append the SiconosMemory objects of the system to a list
+   *  \param memories the list
+   */
+  void collectMemories(std::vector<SiconosMemory*>& memories);
+
   //@}
 
   /*! @name Plugins management  */
@@ -346,6 +359,21 @@ public:
    */
   void setComputeJacobianfxFunction(FPtr1 fct);
 
+  /** compute jacobianfx by forward finite differences of f when no
+   *  plug-in is given for it. The sparsity pattern of the Jacobian can
+   *  be declared or probed through jacobianfxByFD(), to reduce the
+   *  number of evaluations of f.
+   *  \param value true to use finite differences
+   */
+  void setComputeJacobianfxByFD(bool value);
+
+  /** \return the finite difference engine of jacobianfx, or a null
+   *  pointer if jacobianfx is not computed by finite differences */
+  inline SP::FiniteDifferenceJacobian jacobianfxByFD() const
+  {
+    return _jacobianfxFD;
+  }
+
   // --- compute plugin functions ---
 
   /** Default function to compute \f$ M: (x,t)\f$
@@ -0,0 +1,144 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "ForcesBatch.hpp"
+#include "LagrangianDS.hpp"
+#include "NewtonEulerDS.hpp"
+#include "SiconosVector.hpp"
+#include "TypeName.hpp"
+
+/** get the position, velocity and forces vectors of a system
+ * \param ds the system
+ * \param[out] q its position
+ * \param[out] v its velocity
+ * \param[out] forces its forces
+ */
+static void dsVectors(DynamicalSystem& ds, SiconosVector*& q, SiconosVector*& v, SiconosVector*& forces)
+{
+  // the residu of the linear Lagrangian systems does not use their
+  // forces vector: they cannot be grouped
+  Type::Siconos dsType = Type::value(ds);
+  if(dsType == Type::LagrangianDS)
+  {
+    LagrangianDS& d = static_cast<LagrangianDS&>(ds);
+    q = d.q().get();
+    v = d.velocity().get();
+    forces = d.forces().get();
+  }
+  else if(dsType == Type::NewtonEulerDS)
+  {
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&>(ds);
+    q = d.q().get();
+    v = d.twist().get();
+    forces = d.forces().get();
+  }
+  else
+    RuntimeException::selfThrow("ForcesBatch - not yet implemented for Dynamical system of type: " + Type::name(ds));
+}
+
+ForcesBatch::ForcesBatch()
+{
+  _pluginForces.reset(new PluggedObject());
+}
+
+ForcesBatch::ForcesBatch(const std::string& pluginPath, const std::string& functionName)
+{
+  _pluginForces.reset(new PluggedObject());
+  _pluginForces->setComputeFunction(pluginPath, functionName);
+}
+
+ForcesBatch::ForcesBatch(BatchedFPtr fct)
+{
+  _pluginForces.reset(new PluggedObject());
+  _pluginForces->setComputeFunction((void*)fct);
+}
+
+void ForcesBatch::setComputeForcesFunction(const std::string& pluginPath, const std::string& functionName)
+{
+  _pluginForces->setComputeFunction(pluginPath, functionName);
+}
+
+void ForcesBatch::setComputeForcesFunction(BatchedFPtr fct)
+{
+  _pluginForces->setComputeFunction((void*)fct);
+}
+
+void ForcesBatch::insertDynamicalSystem(SP::DynamicalSystem ds)
+{
+  SiconosVector *q, *v, *forces;
+  dsVectors(*ds, q, v, forces);
+
+  if(!_dynamicalSystems.empty())
+  {
+    DynamicalSystem& first = *_dynamicalSystems.front();
+    SiconosVector *q0, *v0, *forces0;
+    dsVectors(first, q0, v0, forces0);
+    if(Type::value(first) != Type::value(*ds) || q->size() != q0->size()
+       || v->size() != v0->size() || ds->z()->size() != first.z()->size())
+      RuntimeException::selfThrow("ForcesBatch::insertDynamicalSystem - the systems of a group must have the same type and sizes.");
+  }
+  _dynamicalSystems.push_back(ds);
+}
+
+void ForcesBatch::computeForces(double time)
+{
+  unsigned int n = _dynamicalSystems.size();
+  if(n == 0 || !_pluginForces->fPtr)
+    return;
+
+  SiconosVector *q, *v, *forces;
+  dsVectors(*_dynamicalSystems.front(), q, v, forces);
+  unsigned int sizeOfq = q->size();
+  unsigned int sizeOfv = v->size();
+  unsigned int sizeOfz = _dynamicalSystems.front()->z()->size();
+  _q.resize(sizeOfq * n);
+  _v.resize(sizeOfv * n);
+  _forces.resize(sizeOfv * n);
+  _z.resize(sizeOfz * n);
+
+  // gather the states, entry by entry
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    dsVectors(*_dynamicalSystems[i], q, v, forces);
+    const double* qi = q->getArray();
+    const double* vi = v->getArray();
+    const double* zi = _dynamicalSystems[i]->z()->getArray();
+    for(unsigned int k = 0; k < sizeOfq; ++k)
+      _q[k * n + i] = qi[k];
+    for(unsigned int k = 0; k < sizeOfv; ++k)
+      _v[k * n + i] = vi[k];
+    for(unsigned int k = 0; k < sizeOfz; ++k)
+      _z[k * n + i] = zi[k];
+  }
+
+  ((BatchedFPtr)_pluginForces->fPtr)(n, time, sizeOfq, &_q[0], sizeOfv, &_v[0], &_forces[0], sizeOfz, sizeOfz ? &_z[0] : NULL);
+
+  // scatter the forces and z
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    dsVectors(*_dynamicalSystems[i], q, v, forces);
+    if(!forces)
+      RuntimeException::selfThrow("ForcesBatch::computeForces - the forces vector of a system is not allocated: the system must be initialized by its integrator.");
+    double* fi = forces->getArray();
+    double* zi = _dynamicalSystems[i]->z()->getArray();
+    for(unsigned int k = 0; k < sizeOfv; ++k)
+      fi[k] = _forces[k * n + i];
+    for(unsigned int k = 0; k < sizeOfz; ++k)
+      zi[k] = _z[k * n + i];
+  }
+}
@@ -0,0 +1,130 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file ForcesBatch.hpp
+  \brief forces of a group of dynamical systems computed by a single plug-in call
+*/
+
+#ifndef ForcesBatch_H
+#define ForcesBatch_H
+
+#include "SiconosFwd.hpp"
+#include "SiconosPointers.hpp"
+#include "PluggedObject.hpp"
+#include "PluginTypes.hpp"
+#include <vector>
+
+/** The forces of a group of dynamical systems of the same type and
+ * size, computed by one call to a batched plug-in instead of one
+ * call to the force plug-ins of each system.
+ *
+ * The plug-in (see BatchedFPtr) receives the positions, the
+ * velocities and the z vectors of the n systems of the group, stored
+ * entry by entry (the entry k of the system i is at k*n+i), and must
+ * return in the same layout the total forces of each system: the
+ * vector forces() of a LagrangianDS (\f$ F_{ext} - F_{int} - F_{gyr} \f$)
+ * or of a NewtonEulerDS (the wrench). With this layout, a loop over
+ * the systems of the group can be vectorized by the compiler.
+ *
+ * The systems keep their own force plug-ins: they are used by the
+ * integrators that do not know the group, and to compute the
+ * Jacobians of the forces. A group is registered in an integrator
+ * (MoreauJeanOSI::insertForcesBatch()), which then calls
+ * computeForces() instead of DynamicalSystem::computeForces().
+ *
+ * LagrangianDS and NewtonEulerDS are supported. The linear Lagrangian
+ * systems (LagrangianLinearTIDS, LagrangianLinearDiagonalDS) are
+ * integrated with their operators, not with their forces vector, and
+ * are rejected.
+ */
+class ForcesBatch
+{
+protected:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(ForcesBatch);
+
+  /** the systems of the group */
+  std::vector<SP::DynamicalSystem> _dynamicalSystems;
+
+  /** plug-in computing the forces of all the systems (BatchedFPtr) */
+  SP::PluggedObject _pluginForces;
+
+  /** positions, velocities, forces and z of the systems, entry by entry */
+  std::vector<double> _q;
+  std::vector<double> _v;
+  std::vector<double> _forces;
+  std::vector<double> _z;
+
+public:
+
+  /** empty group, with no plug-in */
+  ForcesBatch();
+
+  /** empty group
+   *  \param pluginPath the complete path to the plugin
+   *  \param functionName the name of the function to use in this plugin
+   */
+  ForcesBatch(const std::string& pluginPath, const std::string& functionName);
+
+  /** empty group
+   *  \param fct a pointer to the function computing the forces
+   */
+  ForcesBatch(BatchedFPtr fct);
+
+  /** destructor */
+  virtual ~ForcesBatch() {};
+
+  /** allow to set a specified function to compute the forces
+   *  \param pluginPath the complete path to the plugin
+   *  \param functionName the name of the function to use in this plugin
+   */
+  void setComputeForcesFunction(const std::string& pluginPath, const std::string& functionName);
+
+  /** set a specified function to compute the forces
+   *  \param fct a pointer on the plugin function
+   */
+  void setComputeForcesFunction(BatchedFPtr fct);
+
+  /** add a system to the group. It must be of the same type and of
+   *  the same sizes as the systems already in the group.
+   *  \param ds the system
+   */
+  void insertDynamicalSystem(SP::DynamicalSystem ds);
+
+  /** \return the systems of the group */
+  inline const std::vector<SP::DynamicalSystem>& dynamicalSystems() const
+  {
+    return _dynamicalSystems;
+  };
+
+  /** \return the number of systems of the group */
+  inline unsigned int size() const
+  {
+    return _dynamicalSystems.size();
+  };
+
+  /** compute the forces of all the systems of the group, with their
+   *  current position and velocity, and write them in their forces
+   *  vector. The z vectors modified by the plug-in are copied back.
+   *  \param time the current time
+   */
+  void computeForces(double time);
+};
+
+#endif
@@ -766,6 +766,20 @@ void Interaction::swapInMemory()
   DEBUG_END("void Interaction::swapInMemory()\n");
 }
 
+void Interaction::restoreFromMemory()
+{
+  for (unsigned int i = _lowerLevelForOutput; i < _upperLevelForOutput + 1 ; i++)
+  {
+    if (_yMemory[i].nbVectorsInMemory() > 0)
+      *(_y[i]) = _yMemory[i].getSiconosVector(0);
+  }
+  for (unsigned int i = _lowerLevelForInput; i < _upperLevelForInput + 1  ; i++)
+  {
+    if (_lambdaMemory[i].nbVectorsInMemory() > 0)
+      *(_lambda[i]) = _lambdaMemory[i].getSiconosVector(0);
+  }
+}
+
 void Interaction::display(bool brief) const
 {
   std::cout << "======= Interaction display number " << _number <<" =======" <<std::endl;
@@ -676,6 +676,10 @@ public:
    */
   void swapInMemory();
 
+  /** restore y and lambda from their memories, to compute a time step again
+   */
+  void restoreFromMemory();
+
   /** print the data to the screen
   */
   void display(bool brief = true) const;
@@ -662,6 +662,33 @@ void LagrangianDS::swapInMemory()
   _xMemory.swap(_x[0]);
 }
 
+void LagrangianDS::restoreFromMemory()
+{
+  if(_qMemory.nbVectorsInMemory() == 0 || _velocityMemory.nbVectorsInMemory() == 0)
+    RuntimeException::selfThrow("LagrangianDS::restoreFromMemory - no state in memory");
+  *_q[0] = _qMemory.getSiconosVector(0);
+  *_q[1] = _velocityMemory.getSiconosVector(0);
+  if(_forces && _forcesMemory.nbVectorsInMemory() > 0)
+    *_forces = _forcesMemory.getSiconosVector(0);
+  for(unsigned int level = 0; level < _pMemory.size(); ++level)
+  {
+    if(_p[level] && _pMemory[level].nbVectorsInMemory() > 0)
+      *_p[level] = _pMemory[level].getSiconosVector(0);
+  }
+  if(_x[0] && _xMemory.nbVectorsInMemory() > 0)
+    *_x[0] = _xMemory.getSiconosVector(0);
+}
+
+void LagrangianDS::collectMemories(std::vector<SiconosMemory*>& memories)
+{
+  DynamicalSystem::collectMemories(memories);
+  memories.push_back(&_qMemory);
+  memories.push_back(&_velocityMemory);
+  memories.push_back(&_forcesMemory);
+  for (unsigned int level = 0; level < _pMemory.size(); ++level)
+    memories.push_back(&_pMemory[level]);
+}
+
 void LagrangianDS::resetAllNonSmoothParts()
 {
   if(_p[0])
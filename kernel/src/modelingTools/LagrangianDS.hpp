@@ -754,6 +754,15 @@ public:
    */
   void swapInMemory();
 
+  /** restore q, velocity, forces and p from their memories
+   */
+  void restoreFromMemory();
+
+  /** append the SiconosMemory objects of the system to a list
+   *  \param memories the list
+   */
+  void collectMemories(std::vector<SiconosMemory*>& memories);
+
   ///@}
 
   /*! @name Plugins management  */
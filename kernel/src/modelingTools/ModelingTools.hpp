@@ -40,6 +40,7 @@ Include files related to modeling part of Siconos.
 #include "LagrangianLinearDiagonalDS.hpp"
 #include "FirstOrderLinearTIDS.hpp"
 #include "NewtonEulerDS.hpp"
+#include "ForcesBatch.hpp"
 #include "NewtonEulerR.hpp"
 #include "NewtonEulerFrom1DLocalFrameR.hpp"
 #include "NewtonEulerFrom3DLocalFrameR.hpp"
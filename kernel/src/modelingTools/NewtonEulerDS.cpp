@@ -20,6 +20,7 @@
 #include "NewtonEulerDS.hpp"
 #include "BlockVector.hpp"
 #include "BlockMatrix.hpp"
+#include "FiniteDifferenceJacobian.hpp"
 #include <boost/math/quaternion.hpp>
 
 #include <iostream>
@@ -873,6 +874,51 @@ void NewtonEulerDS::computeJacobianFIntv(double time)
   computeJacobianFIntv(time, _q, _twist);
 }
 
+/** internal forces, internal moments or gyroscopic moments of a
+ * NewtonEulerDS as a function of q or of the twist, for the finite
+ * difference Jacobians */
+class NewtonEulerDSInternalForces : public FiniteDifferenceJacobian::Function
+{
+public:
+  enum Quantity {FINT, MINT, MGYR};
+
+private:
+  NewtonEulerDS& _ds;
+  Quantity _quantity;
+  double _time;
+  SP::SiconosVector _q;
+  SP::SiconosVector _twist;
+  /** true if the variable is the twist, false if it is q */
+  bool _ofTwist;
+  SP::SiconosVector _mGyr;
+
+public:
+  NewtonEulerDSInternalForces(NewtonEulerDS& ds, Quantity quantity, double time,
+                              SP::SiconosVector q, SP::SiconosVector twist, bool ofTwist):
+    _ds(ds), _quantity(quantity), _time(time), _q(q), _twist(twist), _ofTwist(ofTwist)
+  {
+    if(quantity == MGYR)
+      _mGyr.reset(new SiconosVector(3));
+  };
+
+  void compute(SP::SiconosVector x, SP::SiconosVector fx)
+  {
+    SP::SiconosVector q = _ofTwist ? _q : x;
+    SP::SiconosVector twist = _ofTwist ? x : _twist;
+    switch(_quantity)
+    {
+    case FINT: _ds.computeFInt(_time, q, twist, fx); break;
+    case MINT: _ds.computeMInt(_time, q, twist, fx); break;
+    case MGYR:
+      // in the rows 3 to 5 of a wrench
+      _ds.computeMGyr(twist, _mGyr);
+      fx->zero();
+      fx->setBlock(3, *_mGyr);
+      break;
+    }
+  };
+};
+
 void NewtonEulerDS::computeJacobianFIntq(double time, SP::SiconosVector q, SP::SiconosVector twist)
 {
   DEBUG_PRINT("NewtonEulerDS::computeJacobianFIntq(...) starts");
@@ -887,28 +933,11 @@ void NewtonEulerDS::computeJacobianFIntq(double time, SP::SiconosVector q, SP::S
 void NewtonEulerDS::computeJacobianFIntqByFD(double time, SP::SiconosVector q, SP::SiconosVector twist)
 {
   DEBUG_BEGIN("NewtonEulerDS::computeJacobianFIntqByFD(...)\n");
-  SP::SiconosVector fInt(new SiconosVector(3));
-  computeFInt(time, q, twist, fInt);
-
-  double fInt0 = fInt->getValue(0);
-  double fInt1 = fInt->getValue(1);
-  double fInt2 = fInt->getValue(2);
-
-  SP::SiconosVector qeps(new SiconosVector(*q));
-  _jacobianFIntq->zero();
-  (*qeps)(0) += _epsilonFD;
-  for(int j =0; j < 7; j++)
-  {
-    computeFInt(time, qeps, twist, fInt);
-    _jacobianFIntq->setValue(0,j, (fInt->getValue(0) - fInt0)/_epsilonFD);
-    _jacobianFIntq->setValue(1,j, (fInt->getValue(1) - fInt1)/_epsilonFD);
-    _jacobianFIntq->setValue(2,j, (fInt->getValue(2) - fInt2)/_epsilonFD);
-    (*qeps)(j) -= _epsilonFD;
-    if(j<6)(*qeps)(j+1) += _epsilonFD;
-  }
+  if(!_FDJacobianFIntq)
+    _FDJacobianFIntq.reset(new FiniteDifferenceJacobian(3, _qDim, _epsilonFD));
+  NewtonEulerDSInternalForces fInt(*this, NewtonEulerDSInternalForces::FINT, time, q, twist, false);
+  _FDJacobianFIntq->compute(fInt, q, *_jacobianFIntq);
   DEBUG_END("NewtonEulerDS::computeJacobianFIntqByFD(...)\n");
-
-
 }
 
 void NewtonEulerDS::computeJacobianFIntv(double time, SP::SiconosVector q, SP::SiconosVector twist)
@@ -922,59 +951,32 @@ void NewtonEulerDS::computeJacobianFIntv(double time, SP::SiconosVector q, SP::S
 void NewtonEulerDS::computeJacobianFIntvByFD(double time, SP::SiconosVector q, SP::SiconosVector twist)
 {
   DEBUG_BEGIN("NewtonEulerDS::computeJacobianFIntvByFD(...)\n");
-  SP::SiconosVector fInt(new SiconosVector(3));
-  computeFInt(time, q, twist, fInt);
-
-  double fInt0 = fInt->getValue(0);
-  double fInt1 = fInt->getValue(1);
-  double fInt2 = fInt->getValue(2);
-
-  SP::SiconosVector veps(new SiconosVector(*twist));
-  _jacobianFInttwist->zero();
-
-  (*veps)(0) += _epsilonFD;
-  for(int j =0; j < 6; j++)
-  {
-    computeFInt(time, q, veps, fInt);
-    _jacobianFInttwist->setValue(0,j, (fInt->getValue(0) - fInt0)/_epsilonFD);
-    _jacobianFInttwist->setValue(1,j, (fInt->getValue(1) - fInt1)/_epsilonFD);
-    _jacobianFInttwist->setValue(2,j, (fInt->getValue(2) - fInt2)/_epsilonFD);
-    (*veps)(j) -= _epsilonFD;
-    if(j<5)(*veps)(j+1) += _epsilonFD;
-  }
-
+  if(!_FDJacobianFInttwist)
+    _FDJacobianFInttwist.reset(new FiniteDifferenceJacobian(3, _ndof, _epsilonFD));
+  NewtonEulerDSInternalForces fInt(*this, NewtonEulerDSInternalForces::FINT, time, q, twist, true);
+  _FDJacobianFInttwist->compute(fInt, twist, *_jacobianFInttwist);
   DEBUG_END("NewtonEulerDS::computeJacobianFIntvByFD(...)\n");
-
-
 }
 void NewtonEulerDS::computeJacobianMGyrtwistByFD(double time, SP::SiconosVector q, SP::SiconosVector twist)
 {
   DEBUG_BEGIN("NewtonEulerDS::computeJacobianMGyrvByFD(...)\n");
-  SP::SiconosVector mGyr(new SiconosVector(3));
-  computeMGyr(twist, mGyr);
-
-  double mGyr0 = mGyr->getValue(0);
-  double mGyr1 = mGyr->getValue(1);
-  double mGyr2 = mGyr->getValue(2);
-
-  SP::SiconosVector veps(new SiconosVector(*twist));
-  _jacobianMGyrtwist->zero();
-
-
-  (*veps)(0) += _epsilonFD;
-  for(int j =0; j < 6; j++)
+  if(!_FDJacobianMGyrtwist)
   {
-    computeMGyr(veps, mGyr);
-    _jacobianMGyrtwist->setValue(3,j, (mGyr->getValue(0) - mGyr0)/_epsilonFD);
-    _jacobianMGyrtwist->setValue(4,j, (mGyr->getValue(1) - mGyr1)/_epsilonFD);
-    _jacobianMGyrtwist->setValue(5,j, (mGyr->getValue(2) - mGyr2)/_epsilonFD);
-    (*veps)(j) -= _epsilonFD;
-    if(j<5)(*veps)(j+1) += _epsilonFD;
+    // mGyr fills the rows 3 to 5 of the Jacobian
+    _FDJacobianMGyrtwist.reset(new FiniteDifferenceJacobian(_ndof, _ndof, _epsilonFD));
+    std::vector<unsigned int> rows, columns;
+    for(unsigned int j = 0; j < _ndof; ++j)
+      for(unsigned int i = 3; i < 6; ++i)
+      {
+        rows.push_back(i);
+        columns.push_back(j);
+      }
+    _FDJacobianMGyrtwist->setSparsityPattern(rows, columns);
   }
+  NewtonEulerDSInternalForces mGyr(*this, NewtonEulerDSInternalForces::MGYR, time, q, twist, true);
+  _FDJacobianMGyrtwist->compute(mGyr, twist, *_jacobianMGyrtwist);
   DEBUG_EXPR(_jacobianMGyrtwist->display());
   DEBUG_END("NewtonEulerDS::computeJacobianMGyrvByFD(...)\n");
-
-
 }
 void NewtonEulerDS::computeJacobianMIntq(double time)
 {
@@ -1000,25 +1002,10 @@ void NewtonEulerDS::computeJacobianMIntq(double time, SP::SiconosVector q, SP::S
 void NewtonEulerDS::computeJacobianMIntqByFD(double time, SP::SiconosVector q, SP::SiconosVector twist)
 {
   DEBUG_PRINT("NewtonEulerDS::computeJacobianMIntqByFD(...) starts\n");
-
-  SP::SiconosVector mInt(new SiconosVector(3));
-  computeMInt(time, q, twist, mInt);
-  double mInt0 = mInt->getValue(0);
-  double mInt1 = mInt->getValue(1);
-  double mInt2 = mInt->getValue(2);
-
-  SP::SiconosVector qeps(new SiconosVector(*q));
-
-  (*qeps)(0) += _epsilonFD;
-  for(int j =0; j < 7; j++)
-  {
-    computeMInt(time, qeps, twist, mInt);
-    _jacobianMIntq->setValue(0,j, (mInt->getValue(0) - mInt0)/_epsilonFD);
-    _jacobianMIntq->setValue(1,j, (mInt->getValue(1) - mInt1)/_epsilonFD);
-    _jacobianMIntq->setValue(2,j, (mInt->getValue(2) - mInt2)/_epsilonFD);
-    (*qeps)(j) -= _epsilonFD;
-    if(j<6)(*qeps)(j+1) += _epsilonFD;
-  }
+  if(!_FDJacobianMIntq)
+    _FDJacobianMIntq.reset(new FiniteDifferenceJacobian(3, _qDim, _epsilonFD));
+  NewtonEulerDSInternalForces mInt(*this, NewtonEulerDSInternalForces::MINT, time, q, twist, false);
+  _FDJacobianMIntq->compute(mInt, q, *_jacobianMIntq);
   DEBUG_PRINT("NewtonEulerDS::computeJacobianMIntqByFD(...) ends\n");
 }
 
@@ -1033,25 +1020,10 @@ void NewtonEulerDS::computeJacobianMIntv(double time, SP::SiconosVector q, SP::S
 void NewtonEulerDS::computeJacobianMIntvByFD(double time, SP::SiconosVector q, SP::SiconosVector twist)
 {
   DEBUG_PRINT("NewtonEulerDS::computeJacobianMIntvByFD(...) starts\n");
-
-  SP::SiconosVector mInt(new SiconosVector(3));
-  computeMInt(time, q, twist, mInt);
-  double mInt0 = mInt->getValue(0);
-  double mInt1 = mInt->getValue(1);
-  double mInt2 = mInt->getValue(2);
-
-  SP::SiconosVector veps(new SiconosVector(*twist));
-
-  (*veps)(0) += _epsilonFD;
-  for(int j =0; j < 6; j++)
-  {
-    computeMInt(time, q, veps, mInt);
-    _jacobianMInttwist->setValue(0,j, (mInt->getValue(0) - mInt0)/_epsilonFD);
-    _jacobianMInttwist->setValue(1,j, (mInt->getValue(1) - mInt1)/_epsilonFD);
-    _jacobianMInttwist->setValue(2,j, (mInt->getValue(2) - mInt2)/_epsilonFD);
-    (*veps)(j) -= _epsilonFD;
-    if(j<5)(*veps)(j+1) += _epsilonFD;
-  }
+  if(!_FDJacobianMInttwist)
+    _FDJacobianMInttwist.reset(new FiniteDifferenceJacobian(3, _ndof, _epsilonFD));
+  NewtonEulerDSInternalForces mInt(*this, NewtonEulerDSInternalForces::MINT, time, q, twist, true);
+  _FDJacobianMInttwist->compute(mInt, twist, *_jacobianMInttwist);
   DEBUG_PRINT("NewtonEulerDS::computeJacobianMIntvByFD(...) ends\n");
 }
 
@@ -1379,6 +1351,27 @@ void NewtonEulerDS::swapInMemory()
   _forcesMemory.swap(*_wrench);
 }
 
+void NewtonEulerDS::restoreFromMemory()
+{
+  if(_qMemory.nbVectorsInMemory() == 0 || _twistMemory.nbVectorsInMemory() == 0)
+    RuntimeException::selfThrow("NewtonEulerDS::restoreFromMemory - no state in memory");
+  *_q = _qMemory.getSiconosVector(0);
+  *_twist = _twistMemory.getSiconosVector(0);
+  if(_dotqMemory.nbVectorsInMemory() > 0)
+    *_dotq = _dotqMemory.getSiconosVector(0);
+  if(_wrench && _forcesMemory.nbVectorsInMemory() > 0)
+    *_wrench = _forcesMemory.getSiconosVector(0);
+}
+
+void NewtonEulerDS::collectMemories(std::vector<SiconosMemory*>& memories)
+{
+  DynamicalSystem::collectMemories(memories);
+  memories.push_back(&_qMemory);
+  memories.push_back(&_twistMemory);
+  memories.push_back(&_dotqMemory);
+  memories.push_back(&_forcesMemory);
+}
+
 void NewtonEulerDS::resetAllNonSmoothParts()
 {
   if(_p[1])
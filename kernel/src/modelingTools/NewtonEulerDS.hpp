@@ -283,6 +283,14 @@ protected:
   /** value of the step in finite difference */
   double _epsilonFD;
 
+  /** finite difference engines of the Jacobians above, created at
+   *  their first use and kept with their work vectors */
+  SP::FiniteDifferenceJacobian _FDJacobianFIntq;
+  SP::FiniteDifferenceJacobian _FDJacobianFInttwist;
+  SP::FiniteDifferenceJacobian _FDJacobianMIntq;
+  SP::FiniteDifferenceJacobian _FDJacobianMInttwist;
+  SP::FiniteDifferenceJacobian _FDJacobianMGyrtwist;
+
   /** Plugin to compute strength of external forces */
   SP::PluggedObject _pluginFExt;
 
@@ -732,6 +740,15 @@ public:
    */
   void swapInMemory();
 
+  /** restore q, twist, dotq and the wrench from their memories
+   */
+  void restoreFromMemory();
+
+  /** append the SiconosMemory objects of the system to a list
+   *  \param memories the list
+   */
+  void collectMemories(std::vector<SiconosMemory*>& memories);
+
   inline const SiconosMemory& forcesMemory()
   {
     return _forcesMemory;
@@ -222,6 +222,22 @@ void NonSmoothDynamicalSystem::pushInteractionsInMemory()
   }
 }
 
+void NonSmoothDynamicalSystem::restoreFromMemory()
+{
+  DynamicalSystemsGraph::VIterator vi;
+  for (vi = dynamicalSystems()->begin(); vi != dynamicalSystems()->end(); ++vi)
+  {
+    dynamicalSystems()->bundle(*vi)->restoreFromMemory();
+  }
+
+  InteractionsGraph::VIterator ui, uiend;
+  SP::InteractionsGraph indexSet0 = _topology->indexSet0();
+  for (std11::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+  {
+    indexSet0->bundle(*ui)->restoreFromMemory();
+  }
+}
+
 void NonSmoothDynamicalSystem::updateInput(double time, unsigned int level)
 {
 
@@ -479,6 +479,12 @@ public:
   */
   void pushInteractionsInMemory();
 
+  /** restore the states of the DynamicalSystems and of the
+   *  Interactions saved by the last calls to swapInMemory() and
+   *  pushInteractionsInMemory(), to compute a time step again
+   */
+  void restoreFromMemory();
+
   /** compute r thanks to lambda[level] for all Interactions
     * \param time
     * \param level lambda level
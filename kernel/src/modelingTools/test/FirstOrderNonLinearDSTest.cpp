@@ -251,4 +251,105 @@ void FirstOrderNonLinearDSTest::testSwap()
 }
 
 
+// f_i = x_{i-1} - 2 x_i^2 + x_{i+1}
+static void tridiagonalf(double time, unsigned int size, double* x, double* f, unsigned int sizez, double* z)
+{
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    f[i] = - 2. * x[i] * x[i];
+    if (i > 0) f[i] += x[i - 1];
+    if (i + 1 < size) f[i] += x[i + 1];
+  }
+}
+
+// Jacobian by finite differences
+void FirstOrderNonLinearDSTest::testJacobianfxByFD()
+{
+  std::cout << "--> Test: JacobianfxByFD." <<std::endl;
+  unsigned int n = 20;
+  SP::SiconosVector x(new SiconosVector(n));
+  for (unsigned int i = 0; i < n; ++i)
+    (*x)(i) = 1. + 0.1 * i;
+  SP::FirstOrderNonLinearDS ds(new FirstOrderNonLinearDS(x));
+  ds->setComputeFFunction(tridiagonalf);
+  ds->setComputeJacobianfxByFD(true);
+
+  std::vector<unsigned int> rows, columns;
+  for (unsigned int j = 0; j < n; ++j)
+    for (unsigned int i = (j > 0 ? j - 1 : 0); i < n && i <= j + 1; ++i)
+    {
+      rows.push_back(i);
+      columns.push_back(j);
+    }
+  ds->jacobianfxByFD()->setSparsityPattern(rows, columns);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFD1 : ", ds->jacobianfxByFD()->numberOfColors(), 3u);
+
+  ds->computef(0., ds->x());
+  SiconosVector f(*ds->f());
+  ds->computeJacobianfx(0., ds->x());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFD2 : ", ds->jacobianfxByFD()->numberOfEvaluations(), 4u);
+  // f is left unchanged
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFD3 : ", *ds->f() == f, true);
+
+  SimpleMatrix J(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    J(i, i) = -4. * (*x)(i);
+    if (i > 0) J(i, i - 1) = 1.;
+    if (i + 1 < n) J(i, i + 1) = 1.;
+  }
+  J -= *ds->jacobianfx();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFD4 : ", J.normInf() < 1e-6, true);
+  std::cout << "--> JacobianfxByFD test ended with success." <<std::endl;
+}
+
+// f = (x_0 x_1, x_1): df_0/dx_0 = x_1 vanishes at x_1 = 0
+static void bilinearf(double time, unsigned int size, double* x, double* f, unsigned int sizez, double* z)
+{
+  f[0] = x[0] * x[1];
+  f[1] = x[1];
+}
+
+// sparsity pattern probed where an entry is zero
+void FirstOrderNonLinearDSTest::testJacobianfxByFDProbe()
+{
+  std::cout << "--> Test: JacobianfxByFDProbe." <<std::endl;
+  SP::SiconosVector x(new SiconosVector(2));
+  (*x)(0) = 1.;
+  SP::FirstOrderNonLinearDS ds(new FirstOrderNonLinearDS(x));
+  ds->setComputeFFunction(bilinearf);
+  ds->setComputeJacobianfxByFD(true);
+  SP::FiniteDifferenceJacobian fd = ds->jacobianfxByFD();
+
+  // probed at x only, the entry (0, 0) is lost
+  fd->probeSparsityPattern(1);
+  ds->computeJacobianfx(0., x);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe1 : ", fd->patternSize(), 2u);
+
+  // probed around x too, it is found
+  fd->probeSparsityPattern();
+  ds->computeJacobianfx(0., x);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe2 : ", fd->patternSize(), 3u);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe3 : ", fabs(ds->jacobianfx()->getValue(0, 0)) < 1e-6, true);
+
+  (*x)(1) = 2.;
+  ds->computeJacobianfx(0., x);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe4 : ", fabs(ds->jacobianfx()->getValue(0, 0) - 2.) < 1e-6, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe5 : ", fabs(ds->jacobianfx()->getValue(0, 1) - 1.) < 1e-6, true);
+
+  // a new probe at x only keeps the entries of the previous one
+  fd->probeSparsityPattern(1);
+  (*x)(1) = 0.;
+  ds->computeJacobianfx(0., x);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe6 : ", fd->patternSize(), 3u);
+
+  // a declared pattern replaces it
+  fd->setDensePattern();
+  fd->probeSparsityPattern(1);
+  ds->computeJacobianfx(0., x);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testJacobianfxByFDProbe7 : ", fd->patternSize(), 2u);
+  std::cout << "--> JacobianfxByFDProbe test ended with success." <<std::endl;
+}
+
+
 // plugins: plugins loading is already in testBuildFirstOrderNonLinearDS2
@@ -20,6 +20,7 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include "FirstOrderNonLinearDS.hpp"
+#include "FiniteDifferenceJacobian.hpp"
 #include "RuntimeException.hpp"
 
 class FirstOrderNonLinearDSTest : public CppUnit::TestFixture
@@ -48,6 +49,8 @@ private:
   CPPUNIT_TEST(testSetJacobianfxPtr);
   CPPUNIT_TEST(testInitMemory);
   CPPUNIT_TEST(testSwap);
+  CPPUNIT_TEST(testJacobianfxByFD);
+  CPPUNIT_TEST(testJacobianfxByFDProbe);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -65,6 +68,8 @@ private:
   void testSetJacobianfxPtr();
   void testInitMemory();
   void testSwap();
+  void testJacobianfxByFD();
+  void testJacobianfxByFDProbe();
 
   // Members
 
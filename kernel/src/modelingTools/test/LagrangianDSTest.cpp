@@ -17,6 +17,7 @@
 */
 #include "LagrangianDSTest.hpp"
 #include "BlockMatrix.hpp"
+#include "ForcesBatch.hpp"
 
 #define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
             if ((alpha) == (omega)) CPPUNIT_FAIL(message);
@@ -24,6 +25,15 @@
 // test suite registration
 CPPUNIT_TEST_SUITE_REGISTRATION(LagrangianDSTest);
 
+// forces = t - q - 2 v for each system, entry by entry
+static void batchedForces(unsigned int n, double time, unsigned int sizeOfq, double* q,
+                          unsigned int sizeOfv, double* v, double* forces, unsigned int sizeZ, double* z)
+{
+  for(unsigned int k = 0; k < sizeOfv; ++k)
+    for(unsigned int i = 0; i < n; ++i)
+      forces[k * n + i] = time - q[k * n + i] - 2 * v[k * n + i];
+}
+
 
 void LagrangianDSTest::setUp()
 {
@@ -204,3 +214,36 @@ void LagrangianDSTest::testBuildLagrangianDS5()
 
   std::cout << "--> Constructor 5 test ended with success." <<std::endl;
 }
+
+// forces of a group of systems computed by a single call
+void LagrangianDSTest::testForcesBatch()
+{
+  std::cout << "--> Test: forces batch." <<std::endl;
+  SP::ForcesBatch batch(new ForcesBatch(batchedForces));
+  std::vector<SP::LagrangianDS> ds(3);
+  for(unsigned int i = 0; i < ds.size(); ++i)
+  {
+    SP::SiconosVector q(new SiconosVector(*q0));
+    *q *= (double)(i + 1);
+    ds[i].reset(new LagrangianDS(q, velocity0, mass));
+    ds[i]->computeForces(0., ds[i]->q(), ds[i]->velocity()); // allocation of the forces
+    batch->insertDynamicalSystem(ds[i]);
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testForcesBatch : ", batch->size() == 3, true);
+
+  double time = 1.;
+  batch->computeForces(time);
+  for(unsigned int i = 0; i < ds.size(); ++i)
+  {
+    SiconosVector expected(3);
+    for(unsigned int k = 0; k < 3; ++k)
+      expected(k) = time - (*ds[i]->q())(k) - 2 * (*velocity0)(k);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testForcesBatch : ", *ds[i]->forces() == expected, true);
+  }
+
+  // systems of different sizes cannot be grouped
+  SP::SiconosVector q1(new SiconosVector(2));
+  SP::LagrangianDS other(new LagrangianDS(q1, q1));
+  CPPUNIT_ASSERT_THROW(batch->insertDynamicalSystem(other), RuntimeException);
+  std::cout << "--> Forces batch test ended with success." <<std::endl;
+}
@@ -39,6 +39,7 @@ private:
   CPPUNIT_TEST(testBuildLagrangianDS1);
   CPPUNIT_TEST(testBuildLagrangianDS4);
   CPPUNIT_TEST(testBuildLagrangianDS5);
+  CPPUNIT_TEST(testForcesBatch);
   CPPUNIT_TEST_SUITE_END();
 
   // \todo exception test
@@ -46,6 +47,7 @@ private:
   void testBuildLagrangianDS1();
   void testBuildLagrangianDS4();
   void testBuildLagrangianDS5();
+  void testForcesBatch();
   //void testcomputeDS();
 
   // Members
@@ -58,4 +58,9 @@ typedef void (*OutPtr)(unsigned int, double*, double, unsigned int, double*, dou
 
 typedef void (*InPtr)(unsigned int, double*, double, unsigned int, double*, unsigned int, double*);
 
+/** Pointer to function used for plug-in for the forces of a set of dynamical systems
+ * (see ForcesBatch): number of systems, time, size of q, q, size of v, v, forces, size of z, z.
+ * The entry k of the system i is at index k*n+i of each array, n being the number of systems. */
+typedef void (*BatchedFPtr)(unsigned int, double, unsigned int, double*, unsigned int, double*, double*, unsigned int, double*);
+
 #endif
@@ -654,6 +654,7 @@ double EulerMoreauOSI::computeResidu()
     if(normResidu > maxResidu) maxResidu = normResidu;
 
   }
+  _newtonResidu = maxResidu;
   DEBUG_END("EulerMoreauOSI::computeResidu()\n");
   return maxResidu;
 }
@@ -795,14 +796,18 @@ void EulerMoreauOSI::prepareNewtonIteration(double time)
   // XXX TMP hack -- xhub
   // we have to iterate over the edges of the DSG0 -> the following won't be necessary anymore
   // Maurice will do that with subgraph :)
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  // W is kept with its factors (see setIterationMatrixReuse), or computed again
+  if(!_keepIterationMatrix(time))
   {
-    if(!checkOSI(dsi)) continue;
-    SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsi);
-    DynamicalSystemsGraph::VDescriptor dsv = _dynamicalSystemsGraph->descriptor(ds);
-    SP::SiconosMatrix W = _dynamicalSystemsGraph->properties(*dsi).W;
-    computeW(time, *ds, dsv, *W);
+    DynamicalSystemsGraph::VIterator dsi, dsend;
+    for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+    {
+      if(!checkOSI(dsi)) continue;
+      SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsi);
+      DynamicalSystemsGraph::VDescriptor dsv = _dynamicalSystemsGraph->descriptor(ds);
+      SP::SiconosMatrix W = _dynamicalSystemsGraph->properties(*dsi).W;
+      computeW(time, *ds, dsv, *W);
+    }
   }
 
   if(!_explicitJacobiansOfRelation)
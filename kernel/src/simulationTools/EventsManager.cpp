@@ -240,6 +240,36 @@ void EventsManager::update(Simulation& sim)
     _k++;
 }
 
+void EventsManager::changeTimeStep(unsigned int k, double h)
+{
+  DEBUG_BEGIN("EventsManager::changeTimeStep(unsigned int k, double h)\n");
+  _td->setCurrentTimeStep(k, h);
+
+  // the TD_EVENT of the instants after t_k are taken out of the
+  // stack and put back at their new time
+  EventsContainer moved;
+  for (EventsContainer::iterator it = _events.begin() + 1; it != _events.end();)
+  {
+    if ((*it)->getType() == TD_EVENT && (*it)->getTimeDiscretisation() == _td
+        && (*it)->getK() > k)
+    {
+      moved.push_back(*it);
+      it = _events.erase(it);
+    }
+    else
+      ++it;
+  }
+  for (unsigned int i = 0; i < moved.size(); i++)
+  {
+    double t = _td->getTk(moved[i]->getK());
+    moved[i]->setTime(t);
+    if (t <= _T + 100.0*std::numeric_limits<double>::epsilon())
+      insertEv(moved[i]);
+  }
+  DEBUG_EXPR(display(););
+  DEBUG_END("EventsManager::changeTimeStep(unsigned int k, double h)\n");
+}
+
 unsigned int EventsManager::insertEv(SP::Event e)
 {
   mpz_t *t1 = const_cast<mpz_t*>(e->getTimeOfEvent());
@@ -107,6 +107,13 @@ protected:
    */
   void update(Simulation& sim);
 
+  /** change the time step of the TimeDiscretisation from the instant
+   * t_k, and move the TD_EVENT of the next instants accordingly
+   * \param k the index of the first instant kept
+   * \param h the new time step
+   */
+  void changeTimeStep(unsigned int k, double h);
+
   /** default constructor */
   EventsManager() {};
 
@@ -285,6 +292,26 @@ public:
     return _td->currentTimeStep(_k);
   }
 
+  /** set the length of the current step, t_{k+1} = t_k + h, and of
+   * the following ones. Used to compute the current step again with
+   * another step. The TimeDiscretisation must have a constant step.
+   * \param h the new time step
+   */
+  inline void setCurrentTimeStep(double h)
+  {
+    changeTimeStep(_k, h);
+  }
+
+  /** set the length of the steps after the current one,
+   * t_{k+2} = t_{k+1} + h, ...
+   * The TimeDiscretisation must have a constant step.
+   * \param h the new time step
+   */
+  inline void setNextTimeStep(double h)
+  {
+    changeTimeStep(_k + 1, h);
+  }
+
   /** get TimeDiscretisation
    * \return the TimeDiscretisation in use for the time integration
    */
@@ -0,0 +1,173 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "InteractionsGraphSnapshot.hpp"
+#include "Interaction.hpp"
+#include "NonSmoothLaw.hpp"
+#include "SiconosMatrix.hpp"
+#include <map>
+#include <assert.h>
+
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "debug.h"
+
+void InteractionsGraphSnapshot::freeze(SP::InteractionsGraph indexSet)
+{
+  DEBUG_BEGIN("InteractionsGraphSnapshot::freeze(SP::InteractionsGraph indexSet)\n");
+  assert(indexSet);
+  InteractionsGraph& graph = *indexSet;
+  _indexSet = indexSet;
+  _stamp = graph.stamp();
+
+  unsigned int nv = graph.vertices_number();
+  unsigned int ne = graph.edges_number();
+
+  _vertices.resize(nv);
+  _interactions.resize(nv);
+  _sizes.resize(nv);
+  _positions.resize(nv);
+  _blocks.resize(nv);
+
+  /* the indices of the graph are used when they are up to date,
+   * otherwise the vertices and edges are numbered through a map */
+  bool verticesIndices = true;
+  _dimension = 0;
+  InteractionsGraph::VIterator vi, viend;
+  unsigned int i = 0;
+  for (std11::tie(vi, viend) = graph.vertices(); vi != viend; ++vi, ++i)
+  {
+    InteractionProperties& properties = graph.properties(*vi);
+    _vertices[i] = *vi;
+    _interactions[i] = graph.bundle(*vi).get();
+    _sizes[i] = _interactions[i]->nonSmoothLaw()->size();
+    _positions[i] = _dimension;
+    _blocks[i] = properties.block.get();
+    _dimension += _sizes[i];
+    verticesIndices = verticesIndices && (graph.index(*vi) == i);
+  }
+
+  std::map<VDescriptor, unsigned int> vertexIndex;
+  if (!verticesIndices)
+  {
+    for (i = 0; i < nv; ++i)
+      vertexIndex[_vertices[i]] = i;
+  }
+
+  _edges.resize(ne);
+  _sources.resize(ne);
+  _targets.resize(ne);
+  _firstEdges.resize(ne);
+  _secondEdges.resize(ne);
+  _upperBlocks.resize(ne);
+  _lowerBlocks.resize(ne);
+
+  bool edgesIndices = true;
+  InteractionsGraph::EIterator ei, eiend;
+  unsigned int k = 0;
+  for (std11::tie(ei, eiend) = graph.edges(); ei != eiend; ++ei, ++k)
+  {
+    _edges[k] = *ei;
+    VDescriptor vs = graph.source(*ei);
+    VDescriptor vt = graph.target(*ei);
+    if (verticesIndices)
+    {
+      _sources[k] = graph.index(vs);
+      _targets[k] = graph.index(vt);
+    }
+    else
+    {
+      _sources[k] = vertexIndex[vs];
+      _targets[k] = vertexIndex[vt];
+    }
+    DynamicalSystemProperties& properties = graph.properties(*ei);
+    _upperBlocks[k] = properties.upper_block.get();
+    _lowerBlocks[k] = properties.lower_block.get();
+    edgesIndices = edgesIndices && (graph.index(*ei) == k);
+  }
+
+  std::map<EDescriptor, unsigned int> edgeIndex;
+  if (!edgesIndices)
+  {
+    for (k = 0; k < ne; ++k)
+      edgeIndex[_edges[k]] = k;
+  }
+
+  for (k = 0; k < ne; ++k)
+  {
+    EDescriptor ed1, ed2;
+    std11::tie(ed1, ed2) = graph.edges(_vertices[_sources[k]], _vertices[_targets[k]]);
+    _firstEdges[k] = edgesIndices ? graph.index(ed1) : edgeIndex[ed1];
+    _secondEdges[k] = ed2;
+  }
+
+  /* incident edges: on an undirected graph, out_edges gives all of them */
+  _incidentStart.resize(nv + 1);
+  _incidentEdges.clear();
+  _incidentDescriptors.clear();
+  _incidentVertices.clear();
+  _incidentEdges.reserve(2 * ne);
+  _incidentDescriptors.reserve(2 * ne);
+  _incidentVertices.reserve(2 * ne);
+  for (i = 0; i < nv; ++i)
+  {
+    _incidentStart[i] = _incidentEdges.size();
+    InteractionsGraph::OEIterator oei, oeiend;
+    for (std11::tie(oei, oeiend) = graph.out_edges(_vertices[i]);
+         oei != oeiend; ++oei)
+    {
+      unsigned int e = edgesIndices ? graph.index(*oei) : edgeIndex[*oei];
+      _incidentEdges.push_back(e);
+      _incidentDescriptors.push_back(*oei);
+      _incidentVertices.push_back(_sources[e] == i ? _targets[e] : _sources[e]);
+    }
+  }
+  _incidentStart[nv] = _incidentEdges.size();
+
+  DEBUG_PRINTF("%i vertices, %i edges, dimension %i\n", nv, ne, _dimension);
+  DEBUG_END("InteractionsGraphSnapshot::freeze(SP::InteractionsGraph indexSet)\n");
+}
+
+bool InteractionsGraphSnapshot::isUpToDate(SP::InteractionsGraph indexSet) const
+{
+  return indexSet == _indexSet && _indexSet->stamp() == _stamp;
+}
+
+void InteractionsGraphSnapshot::refreshBlocks()
+{
+  if (!_indexSet)
+    return;
+  InteractionsGraph& graph = *_indexSet;
+  for (unsigned int i = 0; i < _vertices.size(); ++i)
+    _blocks[i] = graph.properties(_vertices[i]).block.get();
+  for (unsigned int k = 0; k < _edges.size(); ++k)
+  {
+    DynamicalSystemProperties& properties = graph.properties(_edges[k]);
+    _upperBlocks[k] = properties.upper_block.get();
+    _lowerBlocks[k] = properties.lower_block.get();
+  }
+}
+
+void InteractionsGraphSnapshot::refreshPositions()
+{
+  if (!_indexSet)
+    return;
+  InteractionsGraph& graph = *_indexSet;
+  for (unsigned int i = 0; i < _vertices.size(); ++i)
+    _positions[i] = graph.properties(_vertices[i]).absolute_position;
+}
@@ -0,0 +1,291 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file InteractionsGraphSnapshot.hpp
+  \brief flat copy of an index set, for the loops over interactions
+*/
+
+#ifndef InteractionsGraphSnapshot_H
+#define InteractionsGraphSnapshot_H
+
+#include "SimulationGraphs.hpp"
+#include <vector>
+
+/** Flat, index-based copy of an InteractionsGraph.
+ *
+ * The vertices and properties of an InteractionsGraph are linked-list
+ * nodes: each loop over an index set pays pointer chasing and a
+ * properties() lookup per vertex. A snapshot freezes the index set
+ * into contiguous arrays: for the vertex i (in the order of
+ * indexSet.vertices()) the interaction, its descriptor, the size of
+ * its nonsmooth law, its absolute position and its diagonal block;
+ * for the edge k (in the order of indexSet.edges()) its source and
+ * target vertices, its upper and lower blocks. The edges incident to
+ * a vertex are stored in compressed row form.
+ *
+ * The graph remains the source of truth: a snapshot is only valid
+ * until the topology of the index set changes (see isUpToDate()), and
+ * it has to be frozen again after. Blocks allocated after the freeze
+ * must be recorded with setBlock(), setUpperBlock(), setLowerBlock()
+ * or refreshBlocks().
+ *
+ * The absolute positions are the ones given by
+ * OSNSMatrix::updateSizeAndPositions: the sum of the sizes of the
+ * nonsmooth laws of the previous vertices. The OSNSMatrix that place
+ * the interactions differently read them back with refreshPositions().
+ */
+class InteractionsGraphSnapshot
+{
+public:
+  typedef InteractionsGraph::VDescriptor VDescriptor;
+  typedef InteractionsGraph::EDescriptor EDescriptor;
+
+private:
+  /** the frozen graph */
+  SP::InteractionsGraph _indexSet;
+
+  /** stamp of the graph at freeze time */
+  int _stamp;
+
+  /* vertices */
+  std::vector<VDescriptor> _vertices;
+  std::vector<Interaction*> _interactions;
+  std::vector<unsigned int> _sizes;
+  std::vector<unsigned int> _positions;
+  std::vector<SiconosMatrix*> _blocks;
+
+  /* edges */
+  std::vector<EDescriptor> _edges;
+  std::vector<unsigned int> _sources;
+  std::vector<unsigned int> _targets;
+  /** for each edge, the first edge between its source and its target
+   * (there are at most two edges between two vertices of the adjoint
+   * graph) */
+  std::vector<unsigned int> _firstEdges;
+  std::vector<EDescriptor> _secondEdges;
+  std::vector<SiconosMatrix*> _upperBlocks;
+  std::vector<SiconosMatrix*> _lowerBlocks;
+
+  /* incident edges of each vertex, compressed row storage, with the
+   * descriptors given by out_edges (the vertex is their source) */
+  std::vector<unsigned int> _incidentStart;
+  std::vector<unsigned int> _incidentEdges;
+  std::vector<EDescriptor> _incidentDescriptors;
+  std::vector<unsigned int> _incidentVertices;
+
+  /** sum of the sizes of the nonsmooth laws */
+  unsigned int _dimension;
+
+public:
+
+  /** empty snapshot, not up to date with any graph */
+  InteractionsGraphSnapshot(): _stamp(-1), _dimension(0) {};
+
+  /** freeze an index set
+   * \param indexSet the graph
+   */
+  void freeze(SP::InteractionsGraph indexSet);
+
+  /** \param indexSet a graph
+   * \return true if the snapshot has been frozen from indexSet and
+   * the topology of indexSet did not change since */
+  bool isUpToDate(SP::InteractionsGraph indexSet) const;
+
+  /** read again the diagonal and extra-diagonal blocks in the
+   * properties of the graph */
+  void refreshBlocks();
+
+  /** read again the absolute positions in the properties of the
+   * graph, for the matrices that do not place the interactions one
+   * after the other (see OSNSMatrixProjectOnConstraints) */
+  void refreshPositions();
+
+  /** \return the frozen graph */
+  inline SP::InteractionsGraph indexSet() const
+  {
+    return _indexSet;
+  };
+
+  /** \return the number of vertices */
+  inline unsigned int size() const
+  {
+    return _vertices.size();
+  };
+
+  /** \return the number of edges */
+  inline unsigned int edgesNumber() const
+  {
+    return _edges.size();
+  };
+
+  /** \return the sum of the sizes of the nonsmooth laws */
+  inline unsigned int dimension() const
+  {
+    return _dimension;
+  };
+
+  /** \param i a vertex index
+   * \return its descriptor in the graph */
+  inline const VDescriptor& vertex(unsigned int i) const
+  {
+    return _vertices[i];
+  };
+
+  /** \param i a vertex index
+   * \return the interaction */
+  inline Interaction& interaction(unsigned int i) const
+  {
+    return *_interactions[i];
+  };
+
+  /** \param i a vertex index
+   * \return the size of the nonsmooth law of the interaction */
+  inline unsigned int nslawSize(unsigned int i) const
+  {
+    return _sizes[i];
+  };
+
+  /** \param i a vertex index
+   * \return the absolute position of the interaction */
+  inline unsigned int absolutePosition(unsigned int i) const
+  {
+    return _positions[i];
+  };
+
+  /** \param i a vertex index
+   * \return the diagonal block, NULL if not allocated */
+  inline SiconosMatrix* block(unsigned int i) const
+  {
+    return _blocks[i];
+  };
+
+  /** record the diagonal block of a vertex
+   * \param i a vertex index
+   * \param m the block (owned by the graph properties)
+   */
+  inline void setBlock(unsigned int i, SiconosMatrix* m)
+  {
+    _blocks[i] = m;
+  };
+
+  /** \param k an edge index
+   * \return its descriptor in the graph */
+  inline const EDescriptor& edge(unsigned int k) const
+  {
+    return _edges[k];
+  };
+
+  /** \param k an edge index
+   * \return the index of its source vertex */
+  inline unsigned int source(unsigned int k) const
+  {
+    return _sources[k];
+  };
+
+  /** \param k an edge index
+   * \return the index of its target vertex */
+  inline unsigned int target(unsigned int k) const
+  {
+    return _targets[k];
+  };
+
+  /** \param k an edge index
+   * \return the index of the first edge between the source and the
+   * target of k (k itself or the edge parallel to k) */
+  inline unsigned int firstEdge(unsigned int k) const
+  {
+    return _firstEdges[k];
+  };
+
+  /** \param k an edge index
+   * \return the descriptor of the second edge between the source and
+   * the target of k, which is the first one if there is only one */
+  inline const EDescriptor& secondEdge(unsigned int k) const
+  {
+    return _secondEdges[k];
+  };
+
+  /** \param k an edge index
+   * \return the upper block, NULL if not allocated */
+  inline SiconosMatrix* upperBlock(unsigned int k) const
+  {
+    return _upperBlocks[_firstEdges[k]];
+  };
+
+  /** \param k an edge index
+   * \return the lower block, NULL if not allocated */
+  inline SiconosMatrix* lowerBlock(unsigned int k) const
+  {
+    return _lowerBlocks[_firstEdges[k]];
+  };
+
+  /** record the upper block of an edge, shared by the parallel edges
+   * \param k an edge index
+   * \param m the block (owned by the graph properties)
+   */
+  inline void setUpperBlock(unsigned int k, SiconosMatrix* m)
+  {
+    _upperBlocks[_firstEdges[k]] = m;
+  };
+
+  /** record the lower block of an edge, shared by the parallel edges
+   * \param k an edge index
+   * \param m the block (owned by the graph properties)
+   */
+  inline void setLowerBlock(unsigned int k, SiconosMatrix* m)
+  {
+    _lowerBlocks[_firstEdges[k]] = m;
+  };
+
+  /** \param i a vertex index
+   * \return the position in incidentEdges of the first edge incident to i */
+  inline unsigned int incidentBegin(unsigned int i) const
+  {
+    return _incidentStart[i];
+  };
+
+  /** \param i a vertex index
+   * \return the position in incidentEdges after the last edge incident to i */
+  inline unsigned int incidentEnd(unsigned int i) const
+  {
+    return _incidentStart[i + 1];
+  };
+
+  /** \param p a position between incidentBegin(i) and incidentEnd(i)
+   * \return the index of an edge incident to i */
+  inline unsigned int incidentEdge(unsigned int p) const
+  {
+    return _incidentEdges[p];
+  };
+
+  /** \param p a position between incidentBegin(i) and incidentEnd(i)
+   * \return the descriptor of the edge, with i as source */
+  inline const EDescriptor& incidentDescriptor(unsigned int p) const
+  {
+    return _incidentDescriptors[p];
+  };
+
+  /** \param p a position between incidentBegin(i) and incidentEnd(i)
+   * \return the index of the other end of the edge */
+  inline unsigned int incidentVertex(unsigned int p) const
+  {
+    return _incidentVertices[p];
+  };
+};
+
+#endif
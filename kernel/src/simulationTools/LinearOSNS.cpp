@@ -40,6 +40,7 @@
 #include "LagrangianLinearTIDS.hpp"
 #include "NewtonEulerDS.hpp"
 #include "OSNSMatrix.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 
 #include "Tools.hpp"
 
@@ -224,7 +225,15 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
     assert(ds == ds1 || ds == ds2);
     endl = (ds == ds2);
 
-    OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds)).osi;
+    SP::OneStepIntegrator osiPtr = DSG0.properties(DSG0.descriptor(ds)).osi;
+    if (!simulation()->oneStepIntegrators()->count(osiPtr))
+    {
+      // the integrator of ds is not run by the simulation (see
+      // TimeSteppingMultirate): the motion of ds is prescribed
+      pos = pos2;
+      continue;
+    }
+    OneStepIntegrator& osi = *osiPtr;
     OSI::TYPES osiType = osi.getType();
     unsigned int sizeDS = ds->dimension();
 
@@ -685,19 +694,17 @@ void LinearOSNS::computeq(double time)
     _q->resize(_sizeOutput);
   _q->zero();
 
-  // === Get index set from Simulation ===
-  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  // === Get the flat copy of the index set from Simulation ===
+  InteractionsGraphSnapshot& snapshot = *simulation()->indexSetSnapshot(indexSetLevel());
   // === Loop through "active" Interactions (ie present in
   // indexSets[level]) ===
 
-  unsigned int pos = 0;
-  InteractionsGraph::VIterator ui, uiend;
-  for (std11::tie(ui, uiend) = indexSet->vertices(); ui != uiend; ++ui)
+  for (unsigned int i = 0; i < snapshot.size(); ++i)
   {
     // Compute q, this depends on the type of non smooth problem, on
     // the relation type and on the non smooth law
-    pos = indexSet->properties(*ui).absolute_position;
-    computeqBlock(*ui, pos); // free output is saved in y
+    InteractionsGraph::VDescriptor vertex_inter = snapshot.vertex(i);
+    computeqBlock(vertex_inter, snapshot.absolutePosition(i)); // free output is saved in y
   }
   DEBUG_END("void LinearOSNS::computeq(double time)\n");
 }
@@ -739,13 +746,19 @@ bool LinearOSNS::preCompute(double time)
     return false;
   }
 
-  if (!_hasBeenUpdated || !isLinear)
+  // with the kept blocks, the changes of the index set only require
+  // the blocks of the activated Interactions
+  bool indexSetChanged = _indexSetChangesReported;
+  if (!_hasBeenUpdated || !isLinear || indexSetChanged)
   {
     // Computes new _interactionBlocks if required
     updateInteractionBlocks();
 
     //    _M->fill(indexSet);
-    _M->fillW(indexSet, !_hasBeenUpdated);
+    InteractionsGraphSnapshot& snapshot = *simulation()->indexSetSnapshot(indexSetLevel());
+    _M->fillW(snapshot, !_hasBeenUpdated || indexSetChanged);
+    if (_keepInteractionBlocks && isLinear)
+      _hasBeenUpdated = true;
     DEBUG_EXPR(_M->display(););
 
     //      updateOSNSMatrix();
@@ -770,13 +783,12 @@ bool LinearOSNS::preCompute(double time)
     // Note : sizeOuput can be unchanged, but positions may have changed. (??)
     if (_keepLambdaAndYState)
     {
-      InteractionsGraph::VIterator ui, uiend;
-      for (std11::tie(ui, uiend) = indexSet.vertices(); ui != uiend; ++ui)
+      for (unsigned int i = 0; i < snapshot.size(); ++i)
       {
-        Interaction& inter = *indexSet.bundle(*ui);
+        Interaction& inter = snapshot.interaction(i);
         // Get the position of inter-interactionBlock in the vector w
         // or z
-        unsigned int pos = indexSet.properties(*ui).absolute_position;
+        unsigned int pos = snapshot.absolutePosition(i);
         SiconosVector& yOutputOld = *inter.yOld(inputOutputLevel());
         SiconosVector& lambdaOld = *inter.lambdaOld(inputOutputLevel());
 
@@ -422,6 +422,19 @@ void MoreauJeanBilbaoOSI::prepareNewtonIteration(double time)
   }
 }
 
+void MoreauJeanBilbaoOSI::timeStepChanged(double time)
+{
+  OneStepIntegrator::timeStepChanged(time);
+
+  // the iteration matrix, 1 - theta and sigma* depend on the time step
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  {
+    if(!checkOSI(dsi)) continue;
+    _dynamicalSystemsGraph->properties(*dsi).W.reset();
+    _initialize_iteration_matrix(_dynamicalSystemsGraph->bundle(*dsi));
+  }
+}
 
 bool MoreauJeanBilbaoOSI::addInteractionInIndexSet(SP::Interaction inter, unsigned int i)
 {
@@ -131,6 +131,12 @@ public:
 
   void prepareNewtonIteration(double time);
 
+  /** compute again the iteration matrices and the parameters of the
+   * scheme, built once with the previous time step
+   *   \param time the end of the new time step
+   */
+  void timeStepChanged(double time);
+
   /** Apply the rule to one Interaction to know if it should be included in the IndexSet of level i
    * \param inter the Interaction to test
    * \param i level of the IndexSet
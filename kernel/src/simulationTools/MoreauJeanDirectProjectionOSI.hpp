@@ -165,6 +165,18 @@ public:
    */
   bool removeInteractionFromIndexSet(SP::Interaction inter, unsigned int i);
 
+  /** the rules are applied one Interaction after the other
+   * \param interactions the Interactions to test
+   * \param active on input 1 if in the IndexSet, on output 1 if it must be in it
+   * \param i level of the IndexSet
+   */
+  virtual void updateInteractionsActivation(const std::vector<SP::Interaction>& interactions,
+                                            std::vector<char>& active,
+                                            unsigned int i)
+  {
+    OneStepIntegrator::updateInteractionsActivation(interactions, active, i);
+  };
+
   /** Perform the integration of the dynamical systems linked to this integrator
    *  without taking into account the nonsmooth input (_r or _p)
    */
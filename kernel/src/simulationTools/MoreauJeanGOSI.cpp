@@ -842,6 +842,28 @@ void MoreauJeanGOSI::prepareNewtonIteration(double time)
 }
 
 
+void MoreauJeanGOSI::timeStepChanged(double time)
+{
+  DEBUG_BEGIN("MoreauJeanGOSI::timeStepChanged(double time)\n");
+  OneStepIntegrator::timeStepChanged(time);
+
+  // W of LagrangianLinearTIDS is built once: build it again with the
+  // new step
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  {
+    if(!checkOSI(dsi)) continue;
+    SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsi);
+    if(Type::value(*ds) == Type::LagrangianLinearTIDS)
+    {
+      _dynamicalSystemsGraph->properties(*dsi).W.reset();
+      _dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions.reset();
+      initializeIterationMatrixW(time, ds);
+    }
+  }
+  DEBUG_END("MoreauJeanGOSI::timeStepChanged(double time)\n");
+}
+
 struct MoreauJeanGOSI::_NSLEffectOnFreeOutput : public SiconosVisitor
 {
   using SiconosVisitor::visit;
@@ -255,6 +255,12 @@ public:
    */
   void prepareNewtonIteration(double time);
 
+  /** compute again the iteration matrices W of the linear time
+   * invariant systems, built once with the previous time step
+   *   \param time the end of the new time step
+   */
+  void timeStepChanged(double time);
+
 
   /** integrate the system, between tinit and tend (->iout=true), with possible stop at tout (->iout=false)
    *  \param tinit the initial time
@@ -21,6 +21,7 @@
 #include "NewtonEulerDS.hpp"
 #include "LagrangianLinearTIDS.hpp"
 #include "LagrangianLinearDiagonalDS.hpp"
+#include "ForcesBatch.hpp"
 
 #include "FirstOrderR.hpp"
 #include "NewtonEulerR.hpp"
@@ -32,6 +33,14 @@
 #include "CxxStd.hpp"
 
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <SiconosConfig.h>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 #include "TypeName.hpp"
 
@@ -57,7 +66,9 @@ template <typename T> static std11::shared_ptr<T> ptr(const T& a) {
 
 // --- constructor from a set of data ---
 MoreauJeanOSI::MoreauJeanOSI(double theta, double gamma):
-  OneStepIntegrator(OSI::MOREAUJEANOSI), _useGammaForRelation(false),_explicitNewtonEulerDSOperators(false)
+  OneStepIntegrator(OSI::MOREAUJEANOSI), _useGammaForRelation(false),_explicitNewtonEulerDSOperators(false),
+  _parallelDSLoops(false), _deterministicDSLoops(true), _dsWorkListStamp(-1), _dsWorkListGraphSize(0),
+  _batchedNewtonEulerW(true)
 {
   _levelMinForOutput= 0;
   _levelMaxForOutput =1;
@@ -115,6 +126,8 @@ void MoreauJeanOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem ds)
   DEBUG_BEGIN("MoreauJeanOSI::initializeWorkVectorsForDS(Model&, double t, SP::DynamicalSystem ds)\n");
   VectorOfVectors& ds_work_vectors = *_initializeDSWorkVectors(ds);
   ds_work_vectors.resize(MoreauJeanOSI::WORK_LENGTH);
+  // the work list is rebuilt with the new DS at the next loop
+  _dsWorkListStamp = -1;
 
   // Check dynamical system type
   Type::Siconos dsType = Type::value(*ds);
@@ -135,7 +148,8 @@ void MoreauJeanOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem ds)
     ds_work_vectors[MoreauJeanOSI::BUFFER].reset(new SiconosVector(lds->dimension()));
 
     // Update dynamical system components (for memory swap).
-    lds->computeForces(t, lds->q(), lds->velocity());
+    if(!_initializeForcesBatch(t, *ds))
+      lds->computeForces(t, lds->q(), lds->velocity());
     lds->swapInMemory();
   }
   else if(dsType == Type::NewtonEulerDS)
@@ -153,7 +167,8 @@ void MoreauJeanOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem ds)
     prod(*T, *v, *dotq, true);
 
     //Compute a first value of the forces to store it in _forcesMemory
-    neds->computeForces(t, neds->q(), v);
+    if(!_initializeForcesBatch(t, *ds))
+      neds->computeForces(t, neds->q(), v);
     neds->swapInMemory();
   }
   DEBUG_END("MoreauJeanOSI::initializeWorkVectorsForDS(Model&, double t, SP::DynamicalSystem ds)\n");
@@ -555,36 +570,312 @@ void MoreauJeanOSI::computeW(double t, DynamicalSystem& ds, SiconosMatrix& W)
   // Function PLUForwardBackward will do that if required.
 }
 
-void MoreauJeanOSI::computeInitialNewtonState()
+void MoreauJeanOSI::insertForcesBatch(SP::ForcesBatch batch)
 {
-  DEBUG_BEGIN("MoreauJeanOSI::computeInitialNewtonState()\n");
-  // Compute the position value giving the initial velocity.
-  // The goal is to save one newton iteration for nearly linear system
+  _forcesBatches.push_back(batch);
+  _forcesBatchesInitTime.push_back(std::numeric_limits<double>::quiet_NaN());
+  _dsWorkListStamp = -1;
+}
+
+bool MoreauJeanOSI::_initializeForcesBatch(double t, DynamicalSystem& ds)
+{
+  for(unsigned int b = 0; b < _forcesBatches.size(); ++b)
+  {
+    const std::vector<SP::DynamicalSystem>& group = _forcesBatches[b]->dynamicalSystems();
+    unsigned int i = 0;
+    while(i < group.size() && group[i].get() != &ds)
+      ++i;
+    if(i == group.size())
+      continue;
+
+    if(!(_forcesBatchesInitTime[b] == t))
+    {
+      // allocation of the forces of the DS not yet initialized
+      for(i = 0; i < group.size(); ++i)
+      {
+        if(Type::value(*group[i]) == Type::NewtonEulerDS)
+        {
+          NewtonEulerDS& d = static_cast<NewtonEulerDS&>(*group[i]);
+          if(!d.forces())
+            d.computeForces(t, d.q(), d.twist());
+        }
+        else
+        {
+          LagrangianDS& d = static_cast<LagrangianDS&>(*group[i]);
+          if(!d.forces())
+            d.computeForces(t, d.q(), d.velocity());
+        }
+      }
+      _forcesBatches[b]->computeForces(t);
+      _forcesBatchesInitTime[b] = t;
+    }
+    return true;
+  }
+  return false;
+}
+
+void MoreauJeanOSI::_updateDSWorkList()
+{
+  if(_dsWorkListStamp == _dynamicalSystemsGraph->stamp()
+     && _dsWorkListGraphSize == _dynamicalSystemsGraph->size())
+    return;
+
+  _dsWorkList.clear();
+  std::set<DynamicalSystem*> batchedForces;
+  for(unsigned int b = 0; b < _forcesBatches.size(); ++b)
+  {
+    const std::vector<SP::DynamicalSystem>& group = _forcesBatches[b]->dynamicalSystems();
+    for(unsigned int i = 0; i < group.size(); ++i)
+      batchedForces.insert(group[i].get());
+  }
+
   DynamicalSystemsGraph::VIterator dsi, dsend;
   for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
   {
     if(!checkOSI(dsi)) continue;
-    DynamicalSystem&  ds = *_dynamicalSystemsGraph->bundle(*dsi);
+    DSWorkItem item;
+    item.ds = _dynamicalSystemsGraph->bundle(*dsi).get();
+    item.dsv = *dsi;
+    item.type = Type::value(*item.ds);
+    item.batchedForces = batchedForces.count(item.ds) > 0;
+    _dsWorkList.push_back(item);
+  }
+
+  // DS of the same type are treated one after the other, in the order
+  // of the graph
+  std::stable_sort(_dsWorkList.begin(), _dsWorkList.end());
+  _dsBatches.clear();
+  for(unsigned int i = 0; i < _dsWorkList.size(); ++i)
+  {
+    if(i == 0 || _dsWorkList[i].type != _dsWorkList[i - 1].type)
+      _dsBatches.push_back(i);
+  }
+  _dsBatches.push_back(_dsWorkList.size());
 
-    if(_explicitNewtonEulerDSOperators)
+  // position of each DS in its batch, and room for the iteration
+  // matrices of the NewtonEulerDS
+  unsigned int numberOfNewtonEulerDS = 0;
+  for(unsigned int b = 0; b + 1 < _dsBatches.size(); ++b)
+  {
+    for(unsigned int i = _dsBatches[b]; i < _dsBatches[b + 1]; ++i)
+      _dsWorkList[i].batchIndex = i - _dsBatches[b];
+    if(_dsWorkList[_dsBatches[b]].type == Type::NewtonEulerDS)
+      numberOfNewtonEulerDS = _dsBatches[b + 1] - _dsBatches[b];
+  }
+  _newtonEulerW.resize(numberOfNewtonEulerDS);
+
+  _dsWorkListStamp = _dynamicalSystemsGraph->stamp();
+  _dsWorkListGraphSize = _dynamicalSystemsGraph->size();
+}
+
+double MoreauJeanOSI::_runDSPhaseItem(DSPhase phase, const DSWorkItem& item, double time)
+{
+  switch(phase)
+  {
+  case FREE_STATE: _computeFreeStateDS(item, time); break;
+  case UPDATE_STATE: return _updateStateDS(item);
+  case RESIDU: return _computeResiduDS(item, time);
+  case INITIAL_NEWTON_STATE: _computeInitialNewtonStateDS(item); break;
+  case PREPARE_NEWTON_ITERATION: _prepareNewtonIterationDS(item, time); break;
+  case NEWTON_EULER_W_SETUP: _setupNewtonEulerWDS(item, time); break;
+  case NEWTON_EULER_W_FINISH: _finishNewtonEulerWDS(item); break;
+  }
+  return 0.0;
+}
+
+double MoreauJeanOSI::_runDSPhaseRange(DSPhase phase, double time, int begin, int end)
+{
+  double result = 0.0;
+
+  // serial loop, also used without OpenMP
+  bool serial = true;
+#ifdef WITH_OPENMP
+  serial = !_parallelDSLoops || end - begin < 2 || omp_in_parallel();
+#endif
+  if(serial)
+  {
+    for(int i = begin; i < end; ++i)
+      result = std::max(result, _runDSPhaseItem(phase, _dsWorkList[i], time));
+    return result;
+  }
+
+#ifdef WITH_OPENMP
+  // The DS of the range are split between the threads: statically in
+  // the deterministic mode, by chunks taken on demand otherwise. An
+  // exception cannot leave the parallel region: the one of the first
+  // failing DS in the list is thrown again after the loop.
+  omp_sched_t kind;
+  int chunk;
+  omp_get_schedule(&kind, &chunk);
+  if(_deterministicDSLoops)
+    omp_set_schedule(omp_sched_static, 0);
+  else
+    omp_set_schedule(omp_sched_dynamic, 16);
+
+  int errorItem = end;
+  std::string error;
+#pragma omp parallel
+  {
+    double localResult = 0.0;
+#pragma omp for schedule(runtime) nowait
+    for(int i = begin; i < end; ++i)
     {
-      if(Type::value(ds) == Type::NewtonEulerDS)
+      try
+      {
+        localResult = std::max(localResult, _runDSPhaseItem(phase, _dsWorkList[i], time));
+      }
+      catch(SiconosException& e)
+      {
+#pragma omp critical(MoreauJeanOSI_DSLoopError)
+        if(i < errorItem)
+        {
+          errorItem = i;
+          error = e.report();
+        }
+      }
+      catch(std::exception& e)
       {
-        // The goal is to update T() one time at the beginning of the Newton Loop
-        // We want to be explicit on this function since we do not compute their Jacobians.
-        NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
-        const SiconosVector& qold = d.qMemory().getSiconosVector(0);
-        //SP::SiconosVector q = d->q();
-        computeT(ptr(qold),d.T());
+#pragma omp critical(MoreauJeanOSI_DSLoopError)
+        if(i < errorItem)
+        {
+          errorItem = i;
+          error = e.what();
+        }
       }
     }
-    // The goal is to converge in one iteration if the system is almost linear
-    // we start the Newton loop q = q0+hv0
-    updatePosition(ds);
+#pragma omp critical(MoreauJeanOSI_DSLoopResult)
+    result = std::max(result, localResult);
+  }
+
+  omp_set_schedule(kind, chunk);
+  if(errorItem < end)
+    RuntimeException::selfThrow(error);
+#endif
+  return result;
+}
+
+double MoreauJeanOSI::_runDSPhase(DSPhase phase, double time)
+{
+  _updateDSWorkList();
+
+  // the forces of the grouped DS, used by the residu of each DS
+  if(phase == RESIDU)
+  {
+    for(unsigned int b = 0; b < _forcesBatches.size(); ++b)
+      _forcesBatches[b]->computeForces(time);
   }
+
+  double result = 0.0;
+  for(unsigned int b = 0; b + 1 < _dsBatches.size(); ++b)
+  {
+    int begin = _dsBatches[b];
+    int end = _dsBatches[b + 1];
+    if(phase == FREE_STATE && _batchedNewtonEulerW
+       && _dsWorkList[begin].type == Type::NewtonEulerDS)
+      _computeFreeStateNewtonEulerBatch(time, begin, end);
+    else
+      result = std::max(result, _runDSPhaseRange(phase, time, begin, end));
+  }
+  return result;
+}
+
+void MoreauJeanOSI::_computeFreeStateNewtonEulerBatch(double t, int begin, int end)
+{
+  // W and the free residu of each body are copied in the batch, which
+  // factorizes and solves them pack by pack. A batch still factorized
+  // holds the W kept from the previous Newton iteration.
+  bool factorized = _newtonEulerW.isFactorized();
+  _runDSPhaseRange(NEWTON_EULER_W_SETUP, t, begin, end);
+
+  int packs = _newtonEulerW.numberOfPacks();
+  int singular = -1;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) if(_parallelDSLoops && !omp_in_parallel())
+#endif
+  for(int p = 0; p < packs; ++p)
+  {
+    int s = factorized ? -1 : _newtonEulerW.factorize(p);
+    if(s < 0)
+      _newtonEulerW.solve(p);
+    else
+    {
+#ifdef WITH_OPENMP
+#pragma omp critical(MoreauJeanOSI_WBatchError)
+#endif
+      if(singular < 0 || s < singular)
+        singular = s;
+    }
+  }
+  if(singular >= 0)
+  {
+    std::stringstream msg;
+    msg << "MoreauJeanOSI::computeFreeState - the iteration matrix W of the NewtonEulerDS number "
+        << _dsWorkList[begin + singular].ds->number() << " is singular.";
+    RuntimeException::selfThrow(msg.str());
+  }
+  _newtonEulerW.setFactorized(true);
+
+  _runDSPhaseRange(NEWTON_EULER_W_FINISH, t, begin, end);
+}
+
+void MoreauJeanOSI::_setupNewtonEulerWDS(const DSWorkItem& item, double t)
+{
+  NewtonEulerDS& d = static_cast<NewtonEulerDS&> (*item.ds);
+  DynamicalSystemProperties& properties = _dynamicalSystemsGraph->properties(item.dsv);
+  SimpleMatrix& W = *properties.W;
+
+  // -- Update W --, unless the batch holds the factors of the kept W
+  // Note: during computeW, mass and jacobians of forces will be computed/
+  if(!_newtonEulerW.isFactorized())
+  {
+    if(!_iterationMatrixKept)
+      computeW(t, d, W);
+    _newtonEulerW.setMatrix(item.batchIndex, W);
+  }
+  _newtonEulerW.setRhs(item.batchIndex, *(*properties.workVectors)[MoreauJeanOSI::RESIDU_FREE]);
+}
+
+void MoreauJeanOSI::_finishNewtonEulerWDS(const DSWorkItem& item)
+{
+  NewtonEulerDS& d = static_cast<NewtonEulerDS&> (*item.ds);
+  SiconosVector& vfree = *(*_dynamicalSystemsGraph->properties(item.dsv).workVectors)[MoreauJeanOSI::VFREE];
+
+  // -- vfree =  v - W^{-1} ResiduFree --
+  _newtonEulerW.solution(item.batchIndex, vfree);
+  vfree *= -1.0;
+  vfree += *d.twist();
+}
+
+void MoreauJeanOSI::computeInitialNewtonState()
+{
+  DEBUG_BEGIN("MoreauJeanOSI::computeInitialNewtonState()\n");
+  // Compute the position value giving the initial velocity.
+  // The goal is to save one newton iteration for nearly linear system
+  _runDSPhase(INITIAL_NEWTON_STATE, _simulation->nextTime());
   DEBUG_END("MoreauJeanOSI::computeInitialNewtonState()\n");
 }
 
+void MoreauJeanOSI::_computeInitialNewtonStateDS(const DSWorkItem& item)
+{
+  DynamicalSystem&  ds = *item.ds;
+
+  if(_explicitNewtonEulerDSOperators)
+  {
+    if(item.type == Type::NewtonEulerDS)
+    {
+      // The goal is to update T() one time at the beginning of the Newton Loop
+      // We want to be explicit on this function since we do not compute their Jacobians.
+      NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+      const SiconosVector& qold = d.qMemory().getSiconosVector(0);
+      //SP::SiconosVector q = d->q();
+      computeT(ptr(qold),d.T());
+    }
+  }
+  // The goal is to converge in one iteration if the system is almost linear
+  // we start the Newton loop q = q0+hv0
+  updatePosition(ds);
+}
+
 
 
 double MoreauJeanOSI::computeResidu()
@@ -599,502 +890,493 @@ double MoreauJeanOSI::computeResidu()
   //  $\mathcal R_{free}(x,r) = x - x_{k} -h\theta f( x , t_{k+1}) - h(1-\theta)f(x_k,t_k) $
 
   double t = _simulation->nextTime(); // End of the time step
-  double told = _simulation->startingTime(); // Beginning of the time step
-  double h = t - told; // time step length
 
   DEBUG_PRINTF("nextTime %f\n", t);
-  DEBUG_PRINTF("startingTime %f\n", told);
-  DEBUG_PRINTF("time step size %f\n", h);
-
+  DEBUG_PRINTF("startingTime %f\n", _simulation->startingTime());
 
   // Operators computed at told have index i, and (i+1) at t.
+  double maxResidu = _runDSPhase(RESIDU, t);
+  _newtonResidu = maxResidu;
 
-  // Iteration through the set of Dynamical Systems.
-  //
-  //SP::DynamicalSystem ds; // Current Dynamical System.
-  Type::Siconos dsType ; // Type of the current DS.
-
-  double maxResidu = 0;
-  double normResidu = maxResidu;
+  DEBUG_END("MoreauJeanOSI::computeResidu()\n");
+  return maxResidu;
+}
 
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
-  {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
-    VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
+double MoreauJeanOSI::_computeResiduDS(const DSWorkItem& item, double t)
+{
+  double told = _simulation->startingTime(); // Beginning of the time step
+  double h = t - told; // time step length
 
-    dsType = Type::value(ds); // Its type
+  DynamicalSystem& ds = *item.ds;
+  VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(item.dsv).workVectors;
+  Type::Siconos dsType = item.type; // Its type
+  double normResidu = 0.0;
 
-    // 3 - Lagrangian Non Linear Systems
-    if(dsType == Type::LagrangianDS)
-    {
-      DEBUG_PRINT("MoreauJeanOSI::computeResidu(), dsType == Type::LagrangianDS\n");
-      // residu = M(q*)(v_k,i+1 - v_i) - h*theta*forces(t_i+1,v_k,i+1, q_k,i+1) - h*(1-theta)*forces(ti,vi,qi) - p_i+1
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
+  // 3 - Lagrangian Non Linear Systems
+  if(dsType == Type::LagrangianDS)
+  {
+    DEBUG_PRINT("MoreauJeanOSI::computeResidu(), dsType == Type::LagrangianDS\n");
+    // residu = M(q*)(v_k,i+1 - v_i) - h*theta*forces(t_i+1,v_k,i+1, q_k,i+1) - h*(1-theta)*forces(ti,vi,qi) - p_i+1
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
-      // -- Convert the DS into a Lagrangian one.
-      LagrangianDS& d = static_cast<LagrangianDS&> (ds);
+    // -- Convert the DS into a Lagrangian one.
+    LagrangianDS& d = static_cast<LagrangianDS&> (ds);
 
-      // Get state i (previous time step) from Memories -> var. indexed with "Old"
-      const SiconosVector &vold = d.velocityMemory().getSiconosVector(0);
+    // Get state i (previous time step) from Memories -> var. indexed with "Old"
+    const SiconosVector &vold = d.velocityMemory().getSiconosVector(0);
 
-      const SiconosVector &v = *d.velocity(); // v = v_k,i+1
-      //residuFree.zero();
-      DEBUG_EXPR(residuFree.display());
-      DEBUG_EXPR(vold.display());
-      DEBUG_EXPR(v.display());
+    const SiconosVector &v = *d.velocity(); // v = v_k,i+1
+    //residuFree.zero();
+    DEBUG_EXPR(residuFree.display());
+    DEBUG_EXPR(vold.display());
+    DEBUG_EXPR(v.display());
 
-      residuFree = v;
-      sub(residuFree, vold, residuFree);
-      if(d.mass())
-      {
-        d.computeMass(d.q());
-        prod(*(d.mass()), residuFree, residuFree); // residuFree = M(v - vold)
-      }
+    residuFree = v;
+    sub(residuFree, vold, residuFree);
+    if(d.mass())
+    {
+      d.computeMass(d.q());
+      prod(*(d.mass()), residuFree, residuFree); // residuFree = M(v - vold)
+    }
 
-      if(d.forces())
-      {
-        // Cheaper version: get forces(ti,vi,qi) from memory
-        const SiconosVector& fold = d.forcesMemory().getSiconosVector(0);
-        double coef = -h * (1 - _theta);
-        scal(coef, fold, residuFree, false);
-
-        // Expensive computes forces(ti,vi,qi)
-        // d.computeForces(told, qold, vold);
-        // double coef = -h * (1 - _theta);
-        // // residuFree += coef * fL_i
-        // scal(coef, *d.forces(), residuFree, false);
-
-        // computes forces(ti+1, v_k,i+1, q_k,i+1) = forces(t,v,q)
+    if(d.forces())
+    {
+      // Cheaper version: get forces(ti,vi,qi) from memory
+      const SiconosVector& fold = d.forcesMemory().getSiconosVector(0);
+      double coef = -h * (1 - _theta);
+      scal(coef, fold, residuFree, false);
+
+      // Expensive computes forces(ti,vi,qi)
+      // d.computeForces(told, qold, vold);
+      // double coef = -h * (1 - _theta);
+      // // residuFree += coef * fL_i
+      // scal(coef, *d.forces(), residuFree, false);
+
+      // computes forces(ti+1, v_k,i+1, q_k,i+1) = forces(t,v,q)
+      if(!item.batchedForces)
         d.computeForces(t,d.q(),d.velocity());
-        coef = -h * _theta;
-        scal(coef, *d.forces(), residuFree, false);
+      coef = -h * _theta;
+      scal(coef, *d.forces(), residuFree, false);
 
-        // or  forces(ti+1, v_k,i+\theta, q(v_k,i+\theta))
-        //SP::SiconosVector qbasedonv(new SiconosVector(*qold));
-        //*qbasedonv +=  h * ((1 - _theta)* *vold + _theta * *v);
-        //d.computeForces(t, qbasedonv, v);
-        //coef = -h * _theta;
-        // residuFree += coef * fL_k,i+1
-        //scal(coef, *d.forces(), *residuFree, false);
+      // or  forces(ti+1, v_k,i+\theta, q(v_k,i+\theta))
+      //SP::SiconosVector qbasedonv(new SiconosVector(*qold));
+      //*qbasedonv +=  h * ((1 - _theta)* *vold + _theta * *v);
+      //d.computeForces(t, qbasedonv, v);
+      //coef = -h * _theta;
+      // residuFree += coef * fL_k,i+1
+      //scal(coef, *d.forces(), *residuFree, false);
 
 
-      }
+    }
 
-      if(d.boundaryConditions())
-      {
-        d.boundaryConditions()->computePrescribedVelocity(t);
+    if(d.boundaryConditions())
+    {
+      d.boundaryConditions()->computePrescribedVelocity(t);
 
-        unsigned int columnindex = 0;
-        SimpleMatrix & WBoundaryConditions  = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions ;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+      unsigned int columnindex = 0;
+      SimpleMatrix & WBoundaryConditions  = *_dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions ;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
-        {
-          double DeltaPrescribedVelocity =
-            d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
-            - v.getValue(*itindex);
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
+        double DeltaPrescribedVelocity =
+          d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
+          - v.getValue(*itindex);
 
-          WBoundaryConditions.getCol(columnindex, *columntmp);
-          residuFree -= *columntmp * (DeltaPrescribedVelocity);
+        WBoundaryConditions.getCol(columnindex, *columntmp);
+        residuFree -= *columntmp * (DeltaPrescribedVelocity);
 
-          residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
+        residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
 
-          columnindex ++;
-        }
+        columnindex ++;
       }
+    }
 
-      free = residuFree; // copy residuFree into Workfree
-      DEBUG_EXPR(residuFree.display());
+    free = residuFree; // copy residuFree into Workfree
+    DEBUG_EXPR(residuFree.display());
 
-      if(d.p(1))
-        free -= *d.p(1); // Compute Residu in Workfree Notation !!
+    if(d.p(1))
+      free -= *d.p(1); // Compute Residu in Workfree Notation !!
 
-      if(d.boundaryConditions())
-      {
-        unsigned int columnindex = 0;
-        SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions ;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+    if(d.boundaryConditions())
+    {
+      unsigned int columnindex = 0;
+      SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions ;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
-        {
-          double DeltaPrescribedVelocity =
-            d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
-            - v.getValue(*itindex);
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
+        double DeltaPrescribedVelocity =
+          d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
+          - v.getValue(*itindex);
 
-          WBoundaryConditions.getCol(columnindex, *columntmp);
+        WBoundaryConditions.getCol(columnindex, *columntmp);
 
-          free.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
+        free.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
 
-          columnindex ++;
-        }
+        columnindex ++;
       }
+    }
 
 
-      DEBUG_EXPR(free.display());
-      normResidu = free.norm2();
-      DEBUG_PRINTF("normResidu= %e\n", normResidu);
-    }
-    // 4 - Lagrangian Linear Systems
-    else if(dsType == Type::LagrangianLinearTIDS)
-    {
-      DEBUG_PRINT("MoreauJeanOSI::computeResidu(), dsType == Type::LagrangianLinearTIDS\n");
-      // ResiduFree = h*C*v_i + h*Kq_i +h*h*theta*Kv_i+hFext_theta     (1)
-      // This formulae is only valid for the first computation of the residual for v = v_i
-      // otherwise the complete formulae must be applied, that is
-      // ResiduFree = M(v - vold) + h*((1-theta)*(C v_i + K q_i) +theta * ( C*v + K(q_i+h(1-theta)v_i+h theta v)))
-      //                     +hFext_theta     (2)
-      // for v != vi, the formulae (1) is wrong.
-      // in the sequel, only the equation (1) is implemented
+    DEBUG_EXPR(free.display());
+    normResidu = free.norm2();
+    DEBUG_PRINTF("normResidu= %e\n", normResidu);
+  }
+  // 4 - Lagrangian Linear Systems
+  else if(dsType == Type::LagrangianLinearTIDS)
+  {
+    DEBUG_PRINT("MoreauJeanOSI::computeResidu(), dsType == Type::LagrangianLinearTIDS\n");
+    // ResiduFree = h*C*v_i + h*Kq_i +h*h*theta*Kv_i+hFext_theta     (1)
+    // This formulae is only valid for the first computation of the residual for v = v_i
+    // otherwise the complete formulae must be applied, that is
+    // ResiduFree = M(v - vold) + h*((1-theta)*(C v_i + K q_i) +theta * ( C*v + K(q_i+h(1-theta)v_i+h theta v)))
+    //                     +hFext_theta     (2)
+    // for v != vi, the formulae (1) is wrong.
+    // in the sequel, only the equation (1) is implemented
 
-      // -- Convert the DS into a Lagrangian one.
-      LagrangianLinearTIDS& d = static_cast<LagrangianLinearTIDS&> (ds);
+    // -- Convert the DS into a Lagrangian one.
+    LagrangianLinearTIDS& d = static_cast<LagrangianLinearTIDS&> (ds);
 
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
 
-      // Get state i (previous time step) from Memories -> var. indexed with "Old"
-      const SiconosVector& qold = d.qMemory().getSiconosVector(0); // qi
-      const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
+    // Get state i (previous time step) from Memories -> var. indexed with "Old"
+    const SiconosVector& qold = d.qMemory().getSiconosVector(0); // qi
+    const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
 
-      DEBUG_EXPR(qold.display(););
-      DEBUG_EXPR(vold.display(););
-      DEBUG_EXPR(d.q()->display(););
-      DEBUG_EXPR(d.velocity()->display(););
+    DEBUG_EXPR(qold.display(););
+    DEBUG_EXPR(vold.display(););
+    DEBUG_EXPR(d.q()->display(););
+    DEBUG_EXPR(d.velocity()->display(););
 
-      // --- ResiduFree computation Equation (1) ---
-      residuFree.zero();
-      double coeff;
-      // -- No need to update W --
+    // --- ResiduFree computation Equation (1) ---
+    residuFree.zero();
+    double coeff;
+    // -- No need to update W --
 
-      if(d.C())
-      {
-        prod(h, *d.C() , vold, residuFree, false); // vfree += h*C*vi
-      }
-      if(d.K())
-      {
-        coeff = h * h * _theta;
-        prod(coeff, *d.K(), vold, residuFree, false); // vfree += h^2*_theta*K*vi
-        prod(h, *d.K(), qold, residuFree, false); // vfree += h*K*qi
-      }
+    if(d.C())
+    {
+      prod(h, *d.C() , vold, residuFree, false); // vfree += h*C*vi
+    }
+    if(d.K())
+    {
+      coeff = h * h * _theta;
+      prod(coeff, *d.K(), vold, residuFree, false); // vfree += h^2*_theta*K*vi
+      prod(h, *d.K(), qold, residuFree, false); // vfree += h*K*qi
+    }
 
-      if(d.fExt())
-      {
-        // computes Fext(ti)
-        d.computeFExt(told);
-        coeff = -h * (1 - _theta);
-        scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*(1-_theta) * fext(ti)
-        // computes Fext(ti+1)
-        d.computeFExt(t);
-        coeff = -h * _theta;
-        scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*_theta * fext(ti+1)
-      }
+    if(d.fExt())
+    {
+      // computes Fext(ti)
+      d.computeFExt(told);
+      coeff = -h * (1 - _theta);
+      scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*(1-_theta) * fext(ti)
+      // computes Fext(ti+1)
+      d.computeFExt(t);
+      coeff = -h * _theta;
+      scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*_theta * fext(ti+1)
+    }
 
 
-      // Computation of the complete residual Equation (2)
-      //   ResiduFree = M(v - vold) + h*((1-theta)*(C v_i + K q_i) +theta * ( C*v + K(q_i+h(1-theta)v_i+h theta v)))
-      //                     +hFext_theta     (2)
-      //       SP::SiconosMatrix M = d.mass();
-      //       SP::SiconosVector realresiduFree (new SiconosVector(residuFree));
-      //       realresiduFree->zero();
-      //       prod(*M, (*v-*vold), *realresiduFree); // residuFree = M(v - vold)
-      //       SP::SiconosVector qkplustheta (new SiconosVector(*qold));
-      //       qkplustheta->zero();
-      //       *qkplustheta = *qold + h *((1-_theta)* *vold + _theta* *v);
-      //       if (C){
-      //         double coef = h*(1-_theta);
-      //         prod(coef, *C, *vold , *realresiduFree, false);
-      //         coef = h*(_theta);
-      //         prod(coef,*C, *v , *realresiduFree, false);
-      //       }
-      //       if (K){
-      //         double coef = h*(1-_theta);
-      //         prod(coef,*K , *qold , *realresiduFree, false);
-      //         coef = h*(_theta);
-      //         prod(coef,*K , *qkplustheta , *realresiduFree, false);
-      //       }
-
-      //       if (Fext)
-      //       {
-      //         // computes Fext(ti)
-      //         d.computeFExt(told);
-      //         coeff = -h*(1-_theta);
-      //         scal(coeff, *Fext, *realresiduFree, false); // vfree -= h*(1-_theta) * fext(ti)
-      //         // computes Fext(ti+1)
-      //         d.computeFExt(t);
-      //         coeff = -h*_theta;
-      //         scal(coeff, *Fext, *realresiduFree, false); // vfree -= h*_theta * fext(ti+1)
-      //       }
+    // Computation of the complete residual Equation (2)
+    //   ResiduFree = M(v - vold) + h*((1-theta)*(C v_i + K q_i) +theta * ( C*v + K(q_i+h(1-theta)v_i+h theta v)))
+    //                     +hFext_theta     (2)
+    //       SP::SiconosMatrix M = d.mass();
+    //       SP::SiconosVector realresiduFree (new SiconosVector(residuFree));
+    //       realresiduFree->zero();
+    //       prod(*M, (*v-*vold), *realresiduFree); // residuFree = M(v - vold)
+    //       SP::SiconosVector qkplustheta (new SiconosVector(*qold));
+    //       qkplustheta->zero();
+    //       *qkplustheta = *qold + h *((1-_theta)* *vold + _theta* *v);
+    //       if (C){
+    //         double coef = h*(1-_theta);
+    //         prod(coef, *C, *vold , *realresiduFree, false);
+    //         coef = h*(_theta);
+    //         prod(coef,*C, *v , *realresiduFree, false);
+    //       }
+    //       if (K){
+    //         double coef = h*(1-_theta);
+    //         prod(coef,*K , *qold , *realresiduFree, false);
+    //         coef = h*(_theta);
+    //         prod(coef,*K , *qkplustheta , *realresiduFree, false);
+    //       }
+
+    //       if (Fext)
+    //       {
+    //         // computes Fext(ti)
+    //         d.computeFExt(told);
+    //         coeff = -h*(1-_theta);
+    //         scal(coeff, *Fext, *realresiduFree, false); // vfree -= h*(1-_theta) * fext(ti)
+    //         // computes Fext(ti+1)
+    //         d.computeFExt(t);
+    //         coeff = -h*_theta;
+    //         scal(coeff, *Fext, *realresiduFree, false); // vfree -= h*_theta * fext(ti+1)
+    //       }
 
 
-      if(d.boundaryConditions())
-      {
-        d.boundaryConditions()->computePrescribedVelocity(t);
+    if(d.boundaryConditions())
+    {
+      d.boundaryConditions()->computePrescribedVelocity(t);
 
-        unsigned int columnindex = 0;
-        SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+      unsigned int columnindex = 0;
+      SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
-        {
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
 
-          double DeltaPrescribedVelocity =
-            d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
-            - vold.getValue(*itindex);
+        double DeltaPrescribedVelocity =
+          d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
+          - vold.getValue(*itindex);
 
-          WBoundaryConditions.getCol(columnindex, *columntmp);
-          residuFree += *columntmp * (DeltaPrescribedVelocity);
+        WBoundaryConditions.getCol(columnindex, *columntmp);
+        residuFree += *columntmp * (DeltaPrescribedVelocity);
 
-          residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
+        residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
 
-          columnindex ++;
+        columnindex ++;
 
-        }
       }
+    }
 
-      free = residuFree; // copy residuFree into free
-      if(d.p(1))
-        free-= *d.p(1); // Compute Residu in Workfree Notation !!
-      // We use free as tmp buffer
-      DEBUG_EXPR(free.display());
-      DEBUG_EXPR(residuFree.display());
+    free = residuFree; // copy residuFree into free
+    if(d.p(1))
+      free-= *d.p(1); // Compute Residu in Workfree Notation !!
+    // We use free as tmp buffer
+    DEBUG_EXPR(free.display());
+    DEBUG_EXPR(residuFree.display());
 
-      normResidu = 0.0; // we assume that v = vfree + W^(-1) p
-      //     normResidu = realresiduFree->norm2();
+    normResidu = 0.0; // we assume that v = vfree + W^(-1) p
+    //     normResidu = realresiduFree->norm2();
 
-    }
+  }
 
-    else if(dsType == Type::LagrangianLinearDiagonalDS)
+  else if(dsType == Type::LagrangianLinearDiagonalDS)
+  {
+    // ResiduFree = h*C*v_i + h*Kq_i +h*h*theta*Kv_i+hFext_theta     (1)
+    // This formulae is only valid for the first computation of the residual for v = v_i
+    // otherwise the complete formulae must be applied, that is
+    // ResiduFree = M(v - vold) + h*((1-theta)*(C v_i + K q_i) +theta * ( C*v + K(q_i+h(1-theta)v_i+h theta v)))
+    //                     +hFext_theta     (2)
+    // for v != vi, the formulae (1) is wrong.
+    // in the sequel, only the equation (1) is implemented
+
+    // -- Convert the DS into a Lagrangian one.
+    LagrangianLinearDiagonalDS& d = static_cast<LagrangianLinearDiagonalDS&> (ds);
+
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
+
+
+    // Get state i (previous time step) from Memories -> var. indexed with "Old"
+    const SiconosVector& qold = d.qMemory().getSiconosVector(0); // qi
+    const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
+    // --- ResiduFree computation Equation (1) ---
+    residuFree.zero();
+    double coeff;
+    // -- No need to update W --
+    if(d.damping())
     {
-      // ResiduFree = h*C*v_i + h*Kq_i +h*h*theta*Kv_i+hFext_theta     (1)
-      // This formulae is only valid for the first computation of the residual for v = v_i
-      // otherwise the complete formulae must be applied, that is
-      // ResiduFree = M(v - vold) + h*((1-theta)*(C v_i + K q_i) +theta * ( C*v + K(q_i+h(1-theta)v_i+h theta v)))
-      //                     +hFext_theta     (2)
-      // for v != vi, the formulae (1) is wrong.
-      // in the sequel, only the equation (1) is implemented
-
-      // -- Convert the DS into a Lagrangian one.
-      LagrangianLinearDiagonalDS& d = static_cast<LagrangianLinearDiagonalDS&> (ds);
-
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
-
-
-      // Get state i (previous time step) from Memories -> var. indexed with "Old"
-      const SiconosVector& qold = d.qMemory().getSiconosVector(0); // qi
-      const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
-      // --- ResiduFree computation Equation (1) ---
-      residuFree.zero();
-      double coeff;
-      // -- No need to update W --
-      if(d.damping())
-      {
-        SiconosVector & sigma = *d.damping();
-        for(unsigned int i=0;i<d.dimension();++i)
-          residuFree(i) += h * sigma(i) * vold(i);
-      }
-      if(d.stiffness())
-      {
-        coeff = h * h * _theta;
-        SiconosVector & omega = *d.stiffness();
-        for(unsigned int i=0;i<d.dimension();++i)
-          residuFree(i) += coeff * omega(i) * vold(i) + h * omega(i) * qold(i);
-      }
+      SiconosVector & sigma = *d.damping();
+      for(unsigned int i=0;i<d.dimension();++i)
+        residuFree(i) += h * sigma(i) * vold(i);
+    }
+    if(d.stiffness())
+    {
+      coeff = h * h * _theta;
+      SiconosVector & omega = *d.stiffness();
+      for(unsigned int i=0;i<d.dimension();++i)
+        residuFree(i) += coeff * omega(i) * vold(i) + h * omega(i) * qold(i);
+    }
 
-      if(d.fExt())
-      {
-        // computes Fext(ti)
-        d.computeFExt(told);
-        coeff = -h * (1 - _theta);
-        scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*(1-_theta) * fext(ti)
-        // computes Fext(ti+1)
-        d.computeFExt(t);
-        coeff = -h * _theta;
-        scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*_theta * fext(ti+1)
-      }
+    if(d.fExt())
+    {
+      // computes Fext(ti)
+      d.computeFExt(told);
+      coeff = -h * (1 - _theta);
+      scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*(1-_theta) * fext(ti)
+      // computes Fext(ti+1)
+      d.computeFExt(t);
+      coeff = -h * _theta;
+      scal(coeff, *(d.fExt()), residuFree, false); // vfree -= h*_theta * fext(ti+1)
+    }
 
-      if(d.boundaryConditions())
-      {
-        d.boundaryConditions()->computePrescribedVelocity(t);
+    if(d.boundaryConditions())
+    {
+      d.boundaryConditions()->computePrescribedVelocity(t);
 
-        unsigned int columnindex = 0;
-        SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+      unsigned int columnindex = 0;
+      SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
-        {
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
 
-          double DeltaPrescribedVelocity =
-            d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
-            - vold.getValue(*itindex);
+        double DeltaPrescribedVelocity =
+          d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
+          - vold.getValue(*itindex);
 
-          WBoundaryConditions.getCol(columnindex, *columntmp);
-          residuFree += *columntmp * (DeltaPrescribedVelocity);
+        WBoundaryConditions.getCol(columnindex, *columntmp);
+        residuFree += *columntmp * (DeltaPrescribedVelocity);
 
-          residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
+        residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
 
-          columnindex ++;
+        columnindex ++;
 
-        }
       }
+    }
 
-      free = residuFree; // copy residuFree into free
-      if(d.p(1))
-        free-= *d.p(1); // Compute Residu in Workfree Notation !!
+    free = residuFree; // copy residuFree into free
+    if(d.p(1))
+      free-= *d.p(1); // Compute Residu in Workfree Notation !!
 
-      normResidu = 0.0; // we assume that v = vfree + W^(-1) p
-      //     normResidu = realresiduFree->norm2();
+    normResidu = 0.0; // we assume that v = vfree + W^(-1) p
+    //     normResidu = realresiduFree->norm2();
 
-    }
+  }
 
 
-    else if(dsType == Type::NewtonEulerDS)
-    {
-      DEBUG_PRINT("MoreauJeanOSI::computeResidu(), dsType == Type::NewtonEulerDS\n");
-      // residu = M (v_k,i+1 - v_i) - h*_theta*forces(t,v_k,i+1, q_k,i+1) - h*(1-_theta)*forces(ti,vi,qi) - pi+1
+  else if(dsType == Type::NewtonEulerDS)
+  {
+    DEBUG_PRINT("MoreauJeanOSI::computeResidu(), dsType == Type::NewtonEulerDS\n");
+    // residu = M (v_k,i+1 - v_i) - h*_theta*forces(t,v_k,i+1, q_k,i+1) - h*(1-_theta)*forces(ti,vi,qi) - pi+1
 
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& free = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
 
-      // -- Convert the DS into a Lagrangian one.
-      NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+    // -- Convert the DS into a Lagrangian one.
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
 
-      // Get the state  (previous time step) from memory vector
-      // -> var. indexed with "Old"
-      const SiconosVector& vold = d.twistMemory().getSiconosVector(0);
+    // Get the state  (previous time step) from memory vector
+    // -> var. indexed with "Old"
+    const SiconosVector& vold = d.twistMemory().getSiconosVector(0);
 
-      // Get the current state vector
-      //SiconosVector& q = *d.q();
-      const SiconosVector& v = *d.twist(); // v = v_k,i+1
+    // Get the current state vector
+    //SiconosVector& q = *d.q();
+    const SiconosVector& v = *d.twist(); // v = v_k,i+1
 
-      // Get the (constant mass matrix)
-      const SiconosMatrix &massMatrix = *d.mass();
-      prod(massMatrix, (v - vold), residuFree, true); // residuFree = M(v - vold)
-      DEBUG_EXPR(residuFree.display(););
+    // Get the (constant mass matrix)
+    const SiconosMatrix &massMatrix = *d.mass();
+    prod(massMatrix, (v - vold), residuFree, true); // residuFree = M(v - vold)
+    DEBUG_EXPR(residuFree.display(););
 
-      if(d.forces())   // if fL exists
-      {
-        DEBUG_PRINTF("MoreauJeanOSI:: _theta = %e\n",_theta);
-        DEBUG_PRINTF("MoreauJeanOSI:: h = %e\n",h);
+    if(d.forces())   // if fL exists
+    {
+      DEBUG_PRINTF("MoreauJeanOSI:: _theta = %e\n",_theta);
+      DEBUG_PRINTF("MoreauJeanOSI:: h = %e\n",h);
 
-        // Cheaper version: get forces(ti,vi,qi) from memory
-        const SiconosVector& fold = d.forcesMemory().getSiconosVector(0);
-        DEBUG_PRINT("MoreauJeanOSI:: old forces :\n");
-        DEBUG_EXPR(fold.display(););
+      // Cheaper version: get forces(ti,vi,qi) from memory
+      const SiconosVector& fold = d.forcesMemory().getSiconosVector(0);
+      DEBUG_PRINT("MoreauJeanOSI:: old forces :\n");
+      DEBUG_EXPR(fold.display(););
 
-        double coef = -h * (1 - _theta);
-        scal(coef, fold, residuFree, false);
+      double coef = -h * (1 - _theta);
+      scal(coef, fold, residuFree, false);
 
-        //Expensive version to check ...
-        //SP::SiconosVector qold = d.qMemory()->getSiconosVector(0);
-        //SP::SiconosVector vold = d.twistMemory()->getSiconosVector(0);
-        // d.computeForces(told,qold,vold);
-        // DEBUG_EXPR(d.forces()->display(););
-        //double coef = -h * (1.0 - _theta);
-        //scal(coef, *d.forces(), *residuFree, false);
+      //Expensive version to check ...
+      //SP::SiconosVector qold = d.qMemory()->getSiconosVector(0);
+      //SP::SiconosVector vold = d.twistMemory()->getSiconosVector(0);
+      // d.computeForces(told,qold,vold);
+      // DEBUG_EXPR(d.forces()->display(););
+      //double coef = -h * (1.0 - _theta);
+      //scal(coef, *d.forces(), *residuFree, false);
 
-        DEBUG_EXPR(residuFree.display(););
+      DEBUG_EXPR(residuFree.display(););
 
-        // computes forces(ti,v,q)
+      // computes forces(ti,v,q)
+      if(!item.batchedForces)
         d.computeForces(t,d.q(),d.twist());
-        coef = -h * _theta;
-        scal(coef, *d.forces(), residuFree, false);
-        DEBUG_PRINT("MoreauJeanOSI:: new forces :\n");
-        DEBUG_EXPR(d.forces()->display(););
-        DEBUG_EXPR(residuFree.display(););
+      coef = -h * _theta;
+      scal(coef, *d.forces(), residuFree, false);
+      DEBUG_PRINT("MoreauJeanOSI:: new forces :\n");
+      DEBUG_EXPR(d.forces()->display(););
+      DEBUG_EXPR(residuFree.display(););
 
-      }
+    }
 
 
-      if(d.boundaryConditions())
-      {
-        d.boundaryConditions()->computePrescribedVelocity(t);
+    if(d.boundaryConditions())
+    {
+      d.boundaryConditions()->computePrescribedVelocity(t);
 
-        unsigned int columnindex = 0;
-        SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+      unsigned int columnindex = 0;
+      SimpleMatrix& WBoundaryConditions = *_dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
-        {
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
 
-          DEBUG_PRINTF("columnindex = %i\n",columnindex);
-          DEBUG_PRINTF("*itindex = %i\n",*itindex);
-          double DeltaPrescribedVelocity =
-            d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
-            - v.getValue(*itindex);
+        DEBUG_PRINTF("columnindex = %i\n",columnindex);
+        DEBUG_PRINTF("*itindex = %i\n",*itindex);
+        double DeltaPrescribedVelocity =
+          d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
+          - v.getValue(*itindex);
 
-          DEBUG_EXPR(d.boundaryConditions()->prescribedVelocity()->display());
+        DEBUG_EXPR(d.boundaryConditions()->prescribedVelocity()->display());
 
-          WBoundaryConditions.getCol(columnindex, *columntmp);
-          residuFree -= *columntmp * (DeltaPrescribedVelocity);
+        WBoundaryConditions.getCol(columnindex, *columntmp);
+        residuFree -= *columntmp * (DeltaPrescribedVelocity);
 
 
-          residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
+        residuFree.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
 
-          columnindex ++;
-        }
+        columnindex ++;
       }
+    }
 
-      free = residuFree;
+    free = residuFree;
 
-      if(d.p(1))
-        free -= *d.p(1);
+    if(d.p(1))
+      free -= *d.p(1);
 
-      if(d.boundaryConditions())
-      {
-        unsigned int columnindex = 0;
-        SimpleMatrix &  WBoundaryConditions = *_dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+    if(d.boundaryConditions())
+    {
+      unsigned int columnindex = 0;
+      SimpleMatrix &  WBoundaryConditions = *_dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
-        {
-          double DeltaPrescribedVelocity =
-            d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
-            - v.getValue(*itindex);
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
+        double DeltaPrescribedVelocity =
+          d.boundaryConditions()->prescribedVelocity()->getValue(columnindex)
+          - v.getValue(*itindex);
 
-          WBoundaryConditions.getCol(columnindex, *columntmp);
+        WBoundaryConditions.getCol(columnindex, *columntmp);
 
-          free.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
+        free.setValue(*itindex, - columntmp->getValue(*itindex)   * (DeltaPrescribedVelocity));
 
-          columnindex ++;
-        }
+        columnindex ++;
       }
-
-      DEBUG_PRINT("MoreauJeanOSI::computeResidu :\n");
-      DEBUG_EXPR(residuFree.display(););
-      DEBUG_EXPR(if(d.p(1)) d.p(1)->display(););
-      DEBUG_EXPR(free.display(););
-
-      normResidu =free.norm2();
-      DEBUG_PRINTF("normResidu= %e\n", normResidu);
     }
-    else
-      RuntimeException::selfThrow("MoreauJeanOSI::computeResidu - not yet implemented for Dynamical system of type: " + Type::name(ds));
 
-    if(normResidu > maxResidu) maxResidu = normResidu;
+    DEBUG_PRINT("MoreauJeanOSI::computeResidu :\n");
+    DEBUG_EXPR(residuFree.display(););
+    DEBUG_EXPR(if(d.p(1)) d.p(1)->display(););
+    DEBUG_EXPR(free.display(););
 
+    normResidu =free.norm2();
+    DEBUG_PRINTF("normResidu= %e\n", normResidu);
   }
-  DEBUG_END("MoreauJeanOSI::computeResidu()\n");
-  return maxResidu;
-
+  else
+    RuntimeException::selfThrow("MoreauJeanOSI::computeResidu - not yet implemented for Dynamical system of type: " + Type::name(ds));
 
+  return normResidu;
 }
 
 void MoreauJeanOSI::computeFreeState()
@@ -1110,233 +1392,254 @@ void MoreauJeanOSI::computeFreeState()
   //  Note: integration of r with a theta method has been removed
   //  SiconosVector *rold = static_cast<SiconosVector*>(d->rMemory()->getSiconosVector(0));
 
-  // Iteration through the set of Dynamical Systems.
-  //
-
+  _runDSPhase(FREE_STATE, t);
 
-  //SP::DynamicalSystem ds; // Current Dynamical System.
-  //SP::SiconosMatrix W; // W MoreauJeanOSI matrix of the current DS.
-  Type::Siconos dsType ; // Type of the current DS.
-
-  DynamicalSystemsGraph::VIterator dsi, dsend;
+  DEBUG_END("MoreauJeanOSI::computeFreeState()\n");
+}
 
-  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+void MoreauJeanOSI::_computeFreeStateDS(const DSWorkItem& item, double t)
+{
+  DynamicalSystem & ds = *item.ds;
+  Type::Siconos dsType = item.type; // Its type
+  SiconosMatrix& W = *_dynamicalSystemsGraph->properties(item.dsv).W; // Its W MoreauJeanOSI matrix of iteration.
+  VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(item.dsv).workVectors;
+  // 3 - Lagrangian Non Linear Systems
+  if(dsType == Type::LagrangianDS)
   {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem & ds = *_dynamicalSystemsGraph->bundle(*dsi);
-    dsType = Type::value(ds); // Its type
-    SiconosMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W; // Its W MoreauJeanOSI matrix of iteration.
-    VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
-    // 3 - Lagrangian Non Linear Systems
-    if(dsType == Type::LagrangianDS)
-    {
-      DEBUG_PRINT("MoreauJeanOSI::computeFreeState(), dsType == Type::LagrangianDS\n");
-      // IN to be updated at current time: W, M, q, v, fL
-      // IN at told: qi,vi, fLi
+    DEBUG_PRINT("MoreauJeanOSI::computeFreeState(), dsType == Type::LagrangianDS\n");
+    // IN to be updated at current time: W, M, q, v, fL
+    // IN at told: qi,vi, fLi
 
-      // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
-      // Index k stands for Newton iteration and thus corresponds to the last computed
-      // value, ie the one saved in the DynamicalSystem.
-      // "i" values are saved in memory vectors.
+    // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
+    // Index k stands for Newton iteration and thus corresponds to the last computed
+    // value, ie the one saved in the DynamicalSystem.
+    // "i" values are saved in memory vectors.
 
-      // vFree = v_k,i+1 - W^{-1} ResiduFree
-      // with
-      // ResiduFree = M(q_k,i+1)(v_k,i+1 - v_i) - h*theta*forces(t,v_k,i+1, q_k,i+1) - h*(1-theta)*forces(ti,vi,qi)
+    // vFree = v_k,i+1 - W^{-1} ResiduFree
+    // with
+    // ResiduFree = M(q_k,i+1)(v_k,i+1 - v_i) - h*theta*forces(t,v_k,i+1, q_k,i+1) - h*(1-theta)*forces(ti,vi,qi)
 
-      // -- Convert the DS into a Lagrangian one.
-      LagrangianDS& d = static_cast<LagrangianDS&> (ds);
+    // -- Convert the DS into a Lagrangian one.
+    LagrangianDS& d = static_cast<LagrangianDS&> (ds);
 
-      // Get state i (previous time step) from Memories -> var. indexed with "Old"
-      const SiconosVector &v = *d.velocity(); // v = v_k,i+1
-      DEBUG_EXPR(v.display());
+    // Get state i (previous time step) from Memories -> var. indexed with "Old"
+    const SiconosVector &v = *d.velocity(); // v = v_k,i+1
+    DEBUG_EXPR(v.display());
 
-      // --- ResiduFree computation ---
-      // ResFree = M(v-vold) - h*[theta*forces(t) + (1-theta)*forces(told)]
-      //
-      // vFree pointer is used to compute and save ResiduFree in this first step.
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
-
-      vfree = residuFree;
-      DEBUG_EXPR(vfree.display());
-      // -- Update W --
-      // Note: during computeW, mass and jacobians of forces will be computed/
+    // --- ResiduFree computation ---
+    // ResFree = M(v-vold) - h*[theta*forces(t) + (1-theta)*forces(told)]
+    //
+    // vFree pointer is used to compute and save ResiduFree in this first step.
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
+
+    vfree = residuFree;
+    DEBUG_EXPR(vfree.display());
+    // -- Update W --
+    // Note: during computeW, mass and jacobians of forces will be computed/
+    if(!_iterationMatrixKept)
       computeW(t, d, W);
-      DEBUG_EXPR(W.display(););
-      // -- vfree =  v - W^{-1} ResiduFree --
-      // At this point vfree = residuFree
-      // -> Solve WX = vfree and set vfree = X
-      W.PLUForwardBackwardInPlace(vfree);
-      // -> compute real vfree
-      vfree *= -1.0;
-      vfree += v;
-      DEBUG_EXPR(vfree.display());
+    DEBUG_EXPR(W.display(););
+    // -- vfree =  v - W^{-1} ResiduFree --
+    // At this point vfree = residuFree
+    // -> Solve WX = vfree and set vfree = X
+    W.PLUForwardBackwardInPlace(vfree);
+    // -> compute real vfree
+    vfree *= -1.0;
+    vfree += v;
+    DEBUG_EXPR(vfree.display());
 
-    }
-    // 4 - Lagrangian Linear Systems
-    else if(dsType == Type::LagrangianLinearTIDS)
-    {
-      DEBUG_PRINT("MoreauJeanOSI::computeFreeState(), dsType == Type::LagrangianLinearTIDS\n");
-      // IN to be updated at current time: Fext
-      // IN at told: qi,vi, fext
-      // IN constants: K,C
+  }
+  // 4 - Lagrangian Linear Systems
+  else if(dsType == Type::LagrangianLinearTIDS)
+  {
+    DEBUG_PRINT("MoreauJeanOSI::computeFreeState(), dsType == Type::LagrangianLinearTIDS\n");
+    // IN to be updated at current time: Fext
+    // IN at told: qi,vi, fext
+    // IN constants: K,C
 
-      // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
-      // "i" values are saved in memory vectors.
+    // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
+    // "i" values are saved in memory vectors.
 
-      // vFree = v_i + W^{-1} ResiduFree    // with
-      // ResiduFree = (-h*C -h^2*theta*K)*vi - h*K*qi + h*theta * Fext_i+1 + h*(1-theta)*Fext_i
+    // vFree = v_i + W^{-1} ResiduFree    // with
+    // ResiduFree = (-h*C -h^2*theta*K)*vi - h*K*qi + h*theta * Fext_i+1 + h*(1-theta)*Fext_i
 
-      // -- Convert the DS into a Lagrangian one.
-      LagrangianLinearTIDS& d = static_cast<LagrangianLinearTIDS&> (ds);
+    // -- Convert the DS into a Lagrangian one.
+    LagrangianLinearTIDS& d = static_cast<LagrangianLinearTIDS&> (ds);
 
-      // Get state i (previous time step) from Memories -> var. indexed with "Old"
-      const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
+    // Get state i (previous time step) from Memories -> var. indexed with "Old"
+    const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
 
-      // --- ResiduFree computation ---
-      // vFree pointer is used to compute and save ResiduFree in this first step.
+    // --- ResiduFree computation ---
+    // vFree pointer is used to compute and save ResiduFree in this first step.
 
-      // Velocity free and residu. vFree = RESfree (pointer equality !!).
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
+    // Velocity free and residu. vFree = RESfree (pointer equality !!).
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
-      vfree = residuFree;
-      DEBUG_EXPR(vfree.display());
-      W.PLUForwardBackwardInPlace(vfree);
-      vfree *= -1.0;
-      vfree += vold;
+    vfree = residuFree;
+    DEBUG_EXPR(vfree.display());
+    W.PLUForwardBackwardInPlace(vfree);
+    vfree *= -1.0;
+    vfree += vold;
 
-      DEBUG_EXPR(vfree.display());
+    DEBUG_EXPR(vfree.display());
 
 
-    }
-    // 4 - Lagrangian Linear Diagonal Systems
-    else if(dsType == Type::LagrangianLinearDiagonalDS)
-    {
-      // IN to be updated at current time: Fext
-      // IN at told: qi,vi, fext
-      // IN constants: K,C
+  }
+  // 4 - Lagrangian Linear Diagonal Systems
+  else if(dsType == Type::LagrangianLinearDiagonalDS)
+  {
+    // IN to be updated at current time: Fext
+    // IN at told: qi,vi, fext
+    // IN constants: K,C
 
-      // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
-      // "i" values are saved in memory vectors.
+    // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
+    // "i" values are saved in memory vectors.
 
-      // vFree = v_i + W^{-1} ResiduFree    // with
-      // ResiduFree = (-h*C -h^2*theta*K)*vi - h*K*qi + h*theta * Fext_i+1 + h*(1-theta)*Fext_i
+    // vFree = v_i + W^{-1} ResiduFree    // with
+    // ResiduFree = (-h*C -h^2*theta*K)*vi - h*K*qi + h*theta * Fext_i+1 + h*(1-theta)*Fext_i
 
-      // -- Convert the DS into a Lagrangian one.
-      LagrangianLinearDiagonalDS& d = static_cast<LagrangianLinearDiagonalDS&> (ds);
+    // -- Convert the DS into a Lagrangian one.
+    LagrangianLinearDiagonalDS& d = static_cast<LagrangianLinearDiagonalDS&> (ds);
 
-      // Get state i (previous time step) from Memories -> var. indexed with "Old"
-      const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
+    // Get state i (previous time step) from Memories -> var. indexed with "Old"
+    const SiconosVector& vold = d.velocityMemory().getSiconosVector(0); //vi
 
-      // --- ResiduFree computation ---
-      // vFree pointer is used to compute and save ResiduFree in this first step.
+    // --- ResiduFree computation ---
+    // vFree pointer is used to compute and save ResiduFree in this first step.
 
-      // Velocity free and residu. vFree = RESfree (pointer equality !!).
-      SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
-      // W is diagonal and contains the inverse of the iteration matrix!
-      for(unsigned int i=0;i<d.dimension();++i)
-        vfree(i) = -W(i, i) * vfree(i) + vold(i);
+    // Velocity free and residu. vFree = RESfree (pointer equality !!).
+    SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
+    // W is diagonal and contains the inverse of the iteration matrix!
+    for(unsigned int i=0;i<d.dimension();++i)
+      vfree(i) = -W(i, i) * vfree(i) + vold(i);
 
-    }
-    else if(dsType == Type::NewtonEulerDS)
-    {
-      // IN to be updated at current time: W, M, q, v, fL
-      // IN at told: qi,vi,
+  }
+  else if(dsType == Type::NewtonEulerDS)
+  {
+    // IN to be updated at current time: W, M, q, v, fL
+    // IN at told: qi,vi,
 
-      // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
-      // Index k stands for Newton iteration and thus corresponds to the last computed
-      // value, ie the one saved in the DynamicalSystem.
-      // "i" values are saved in memory vectors.
+    // Note: indices i/i+1 corresponds to value at the beginning/end of the time step.
+    // Index k stands for Newton iteration and thus corresponds to the last computed
+    // value, ie the one saved in the DynamicalSystem.
+    // "i" values are saved in memory vectors.
 
-      // vFree = v_k,i+1 - W^{-1} ResiduFree
-      // with
-      // ResiduFree = M(q_k,i+1)(v_k,i+1 - v_i) - h*theta*forces(t,v_k,i+1, q_k,i+1)
-      //                                        - h*(1-theta)*forces(ti,vi,qi)
+    // vFree = v_k,i+1 - W^{-1} ResiduFree
+    // with
+    // ResiduFree = M(q_k,i+1)(v_k,i+1 - v_i) - h*theta*forces(t,v_k,i+1, q_k,i+1)
+    //                                        - h*(1-theta)*forces(ti,vi,qi)
 
-      // -- Convert the DS into a NewtonEuler one.
-      NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+    // -- Convert the DS into a NewtonEuler one.
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
 
-      // --- ResiduFree computation ---
-      // ResFree = M(v-vold) - h*[theta*forces(t) + (1-theta)*forces(told)]
-      //
-      // vFree pointer is used to compute and save ResiduFree in this first step.
+    // --- ResiduFree computation ---
+    // ResFree = M(v-vold) - h*[theta*forces(t) + (1-theta)*forces(told)]
+    //
+    // vFree pointer is used to compute and save ResiduFree in this first step.
 
-      SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
-      SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
+    SiconosVector& residuFree = *ds_work_vectors[MoreauJeanOSI::RESIDU_FREE];
+    SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
 
-      vfree = residuFree;
+    vfree = residuFree;
 
-      // -- Update W --
-      // Note: during computeW, mass and jacobians of forces will be computed/
-      SimpleMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W;
+    // -- Update W --
+    // Note: during computeW, mass and jacobians of forces will be computed/
+    SimpleMatrix& W = *_dynamicalSystemsGraph->properties(item.dsv).W;
+    if(!_iterationMatrixKept)
       computeW(t, d, W);
-      const SiconosVector& v = *d.twist(); // v = v_k,i+1
-
-      // -- vfree =  v - W^{-1} ResiduFree --
-      // At this point vfree = residuFree
-      // -> Solve WX = vfree and set vfree = X
-      //    std::cout<<"MoreauJeanOSI::computeFreeState residu free"<<endl;
-      //    vfree->display();
-      DEBUG_EXPR(residuFree.display(););
-
-      W.PLUForwardBackwardInPlace(vfree);
-      //    std::cout<<"MoreauJeanOSI::computeFreeState -WRfree"<<endl;
-      //    vfree->display();
-      //    scal(h,*vfree,*vfree);
-      // -> compute real vfree
-      vfree *= -1.0;
-      DEBUG_EXPR(vfree.display(););
-      vfree += v;
-      DEBUG_EXPR(vfree.display(););
-    }
-    else
-      RuntimeException::selfThrow("MoreauJeanOSI::computeFreeState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
-
+    const SiconosVector& v = *d.twist(); // v = v_k,i+1
+
+    // -- vfree =  v - W^{-1} ResiduFree --
+    // At this point vfree = residuFree
+    // -> Solve WX = vfree and set vfree = X
+    //    std::cout<<"MoreauJeanOSI::computeFreeState residu free"<<endl;
+    //    vfree->display();
+    DEBUG_EXPR(residuFree.display(););
+
+    W.PLUForwardBackwardInPlace(vfree);
+    //    std::cout<<"MoreauJeanOSI::computeFreeState -WRfree"<<endl;
+    //    vfree->display();
+    //    scal(h,*vfree,*vfree);
+    // -> compute real vfree
+    vfree *= -1.0;
+    DEBUG_EXPR(vfree.display(););
+    vfree += v;
+    DEBUG_EXPR(vfree.display(););
   }
-  DEBUG_END("MoreauJeanOSI::computeFreeState()\n");
+  else
+    RuntimeException::selfThrow("MoreauJeanOSI::computeFreeState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
 }
 
 void MoreauJeanOSI::prepareNewtonIteration(double time)
 {
   DEBUG_BEGIN(" MoreauJeanOSI::prepareNewtonIteration(double time)\n");
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
-  {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
-    computeW(time, ds, *_dynamicalSystemsGraph->properties(*dsi).W);
-  }
+  // W is kept with its factors (see setIterationMatrixReuse), or
+  // computed again: its factors in the batch are then out of date
+  if(!_keepIterationMatrix(time))
+    _newtonEulerW.setFactorized(false);
+  _runDSPhase(PREPARE_NEWTON_ITERATION, time);
 
-  if(!_explicitNewtonEulerDSOperators)
+  if(!_explicitJacobiansOfRelation)
   {
-    DynamicalSystemsGraph::VIterator dsi, dsend;
+    _simulation->nonSmoothDynamicalSystem()->computeInteractionJacobians(time);
+  }
 
-    for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
-    {
-      if(!checkOSI(dsi)) continue;
+  DEBUG_END(" MoreauJeanOSI::prepareNewtonIteration(double time)\n");
 
-      SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsi);
+}
 
-      //  VA <2016-04-19 Tue> We compute T to be consistent with the Jacobian
-      //   at the beginning of the Newton iteration and not at the end
-      Type::Siconos dsType = Type::value(*ds);
-      if(dsType == Type::NewtonEulerDS)
-      {
-        SP::NewtonEulerDS d = std11::static_pointer_cast<NewtonEulerDS> (ds);
-        computeT(d->q(),d->T());
-      }
-    }
+void MoreauJeanOSI::timeStepChanged(double time)
+{
+  DEBUG_BEGIN("MoreauJeanOSI::timeStepChanged(double time)\n");
+  OneStepIntegrator::timeStepChanged(time);
+  _newtonEulerW.setFactorized(false);
 
-  }
-  if(!_explicitJacobiansOfRelation)
+  // W of LagrangianLinearTIDS and LagrangianLinearDiagonalDS is built
+  // (and factorized or inverted) once: build it again with the new step
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
   {
-    _simulation->nonSmoothDynamicalSystem()->computeInteractionJacobians(time);
+    if(!checkOSI(dsi)) continue;
+    SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsi);
+    Type::Siconos dsType = Type::value(*ds);
+    if(dsType == Type::LagrangianLinearTIDS || dsType == Type::LagrangianLinearDiagonalDS)
+    {
+      _dynamicalSystemsGraph->properties(*dsi).W.reset();
+      _dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions.reset();
+      initializeIterationMatrixW(time, ds);
+    }
   }
+  DEBUG_END("MoreauJeanOSI::timeStepChanged(double time)\n");
+}
 
-  DEBUG_END(" MoreauJeanOSI::prepareNewtonIteration(double time)\n");
+void MoreauJeanOSI::prescribeFreeState(SP::DynamicalSystem ds)
+{
+  SiconosVector& vfree = *(*_dynamicalSystemsGraph->properties(_dynamicalSystemsGraph->descriptor(ds)).workVectors)[MoreauJeanOSI::VFREE];
+  Type::Siconos dsType = Type::value(*ds);
+  if(dsType == Type::LagrangianLinearTIDS || dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearDiagonalDS)
+    vfree = *std11::static_pointer_cast<LagrangianDS>(ds)->velocity();
+  else if(dsType == Type::NewtonEulerDS)
+    vfree = *std11::static_pointer_cast<NewtonEulerDS>(ds)->twist();
+  else
+    RuntimeException::selfThrow("MoreauJeanOSI::prescribeFreeState - not yet implemented for Dynamical system of type: " + Type::name(*ds));
+}
+
+void MoreauJeanOSI::_prepareNewtonIterationDS(const DSWorkItem& item, double time)
+{
+  DynamicalSystem& ds = *item.ds;
+  if(!_iterationMatrixKept)
+    computeW(time, ds, *_dynamicalSystemsGraph->properties(item.dsv).W);
 
+  //  VA <2016-04-19 Tue> We compute T to be consistent with the Jacobian
+  //   at the beginning of the Newton iteration and not at the end
+  if(!_explicitNewtonEulerDSOperators && item.type == Type::NewtonEulerDS)
+  {
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+    computeT(d.q(),d.T());
+  }
 }
 
 
@@ -1726,187 +2029,192 @@ void MoreauJeanOSI::updateState(const unsigned int )
 
   double RelativeTol = _simulation->relativeConvergenceTol();
   bool useRCC = _simulation->useRelativeConvergenceCriteron();
+
+  double maxRelativeChange = _runDSPhase(UPDATE_STATE, _simulation->nextTime());
   if(useRCC)
-    _simulation->setRelativeConvergenceCriterionHeld(true);
+    _simulation->setRelativeConvergenceCriterionHeld(maxRelativeChange <= RelativeTol);
 
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std11::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
-  {
-    if(!checkOSI(dsi)) continue;
-    DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
+  DEBUG_END("MoreauJeanOSI::updateState(const unsigned int)\n");
+}
 
-    VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
+double MoreauJeanOSI::_updateStateDS(const DSWorkItem& item)
+{
+  DynamicalSystem& ds = *item.ds;
+  double relativeChange = 0.0;
 
-    SiconosMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W;
-    // Get the DS type
+  VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(item.dsv).workVectors;
 
-    Type::Siconos dsType = Type::value(ds);
+  SiconosMatrix& W = *_dynamicalSystemsGraph->properties(item.dsv).W;
+  // Get the DS type
 
-    // 3 - Lagrangian Systems
-    if(dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS || dsType == Type::LagrangianLinearDiagonalDS)
-    {
-      DEBUG_PRINT("MoreauJeanOSI::updateState(const unsigned int ), dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS \n");
-      // get dynamical system
-      LagrangianDS& d = static_cast<LagrangianDS&> (ds);
-      SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
+  Type::Siconos dsType = item.type;
 
-      //    SiconosVector *vfree = d.velocityFree();
-      SiconosVector& v = *d.velocity();
-      bool baux = dsType == Type::LagrangianDS && useRCC && _simulation->relativeConvergenceCriterionHeld();
+  // 3 - Lagrangian Systems
+  if(dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS || dsType == Type::LagrangianLinearDiagonalDS)
+  {
+    DEBUG_PRINT("MoreauJeanOSI::updateState(const unsigned int ), dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS \n");
+    // get dynamical system
+    LagrangianDS& d = static_cast<LagrangianDS&> (ds);
+    SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
-      if(d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
-      {
+    //    SiconosVector *vfree = d.velocityFree();
+    SiconosVector& v = *d.velocity();
+    bool baux = dsType == Type::LagrangianDS && _simulation->useRelativeConvergenceCriteron();
 
-        assert(((d.p(_levelMaxForInput)).get()) &&
-               " MoreauJeanOSI::updateState() *d.p(_levelMaxForInput) == NULL.");
-        v = *d.p(_levelMaxForInput); // v = p
-        if(d.boundaryConditions())
-          for(std::vector<unsigned int>::iterator
-                itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-              itindex != d.boundaryConditions()->velocityIndices()->end();
-              ++itindex)
-            v.setValue(*itindex, 0.0);
-        if(dsType == Type::LagrangianLinearDiagonalDS)
-        {
-          for(unsigned int i=0;i<d.dimension();++i)
-            v(i) = vfree(i) + W(i, i) * v(i);
-        }
-        else
-        {
-          W.PLUForwardBackwardInPlace(v);
-          v +=  vfree;
-        }
+    if(d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
+    {
+
+      assert(((d.p(_levelMaxForInput)).get()) &&
+             " MoreauJeanOSI::updateState() *d.p(_levelMaxForInput) == NULL.");
+      v = *d.p(_levelMaxForInput); // v = p
+      if(d.boundaryConditions())
+        for(std::vector<unsigned int>::iterator
+              itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+            itindex != d.boundaryConditions()->velocityIndices()->end();
+            ++itindex)
+          v.setValue(*itindex, 0.0);
+      if(dsType == Type::LagrangianLinearDiagonalDS)
+      {
+        for(unsigned int i=0;i<d.dimension();++i)
+          v(i) = vfree(i) + W(i, i) * v(i);
       }
       else
       {
-        v =  vfree;
+        W.PLUForwardBackwardInPlace(v);
+        v +=  vfree;
       }
-      DEBUG_EXPR(v.display());
+    }
+    else
+    {
+      v =  vfree;
+    }
+    DEBUG_EXPR(v.display());
 
 
 
-      if(d.boundaryConditions())
-      {
-        int bc = 0;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+    if(d.boundaryConditions())
+    {
+      int bc = 0;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
+        _dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions->getCol(bc, *columntmp);
+        /*\warning we assume that W is symmetric in the Lagrangian case*/
+        if (!_dynamicalSystemsGraph->properties(item.dsv).W->isSymmetric(1e-10))
+          std::cout <<"Warning, we apply boundary conditions assuming W symmetric" << std::endl;
+        double value = - inner_prod(*columntmp, v);
+        if( d.p(_levelMaxForInput)&& d.p(_levelMaxForInput)->size() > 0)
         {
-          _dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions->getCol(bc, *columntmp);
-          /*\warning we assume that W is symmetric in the Lagrangian case*/
-          if (!_dynamicalSystemsGraph->properties(*dsi).W->isSymmetric(1e-10))
-            std::cout <<"Warning, we apply boundary conditions assuming W symmetric" << std::endl;
-          double value = - inner_prod(*columntmp, v);
-          if( d.p(_levelMaxForInput)&& d.p(_levelMaxForInput)->size() > 0)
-          {
-            value += (d.p(_levelMaxForInput))->getValue(*itindex);
-          }
-          /* \warning the computation of reactionToBoundaryConditions take into
-             account the contact impulse but not the external and internal forces.
-             A complete computation of the residu should be better */
-          d.reactionToBoundaryConditions()->setValue(bc, value) ;
-          bc++;
+          value += (d.p(_levelMaxForInput))->getValue(*itindex);
         }
+        /* \warning the computation of reactionToBoundaryConditions take into
+           account the contact impulse but not the external and internal forces.
+           A complete computation of the residu should be better */
+        d.reactionToBoundaryConditions()->setValue(bc, value) ;
+        bc++;
       }
+    }
 
-      SiconosVector& q = *d.q();
-      SiconosVector& local_buffer = *ds_work_vectors[MoreauJeanOSI::BUFFER];
-      // Save value of q in stateTmp for future convergence computation
-      if(baux)
-        local_buffer = q;
+    SiconosVector& q = *d.q();
+    SiconosVector& local_buffer = *ds_work_vectors[MoreauJeanOSI::BUFFER];
+    // Save value of q in stateTmp for future convergence computation
+    if(baux)
+      local_buffer = q;
 
 
-      updatePosition(ds);
+    updatePosition(ds);
 
-      if(baux)
-      {
-        double ds_norm_ref = 1. + ds.x0()->norm2(); // Should we save this in the graph?
-        local_buffer -= q;
-        double aux = (local_buffer.norm2()) / ds_norm_ref;
-        if(aux > RelativeTol)
-          _simulation->setRelativeConvergenceCriterionHeld(false);
-      }
-    }
-    else if(dsType == Type::NewtonEulerDS)
+    if(baux)
     {
-      DEBUG_PRINT("MoreauJeanOSI::updateState(const unsigned int), dsType == Type::NewtonEulerDS \n");
+      double ds_norm_ref = 1. + ds.x0()->norm2(); // Should we save this in the graph?
+      local_buffer -= q;
+      relativeChange = (local_buffer.norm2()) / ds_norm_ref;
+    }
+  }
+  else if(dsType == Type::NewtonEulerDS)
+  {
+    DEBUG_PRINT("MoreauJeanOSI::updateState(const unsigned int), dsType == Type::NewtonEulerDS \n");
 
-      // get dynamical system
-      NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
-      SiconosVector& v = *d.twist();
-      // DEBUG_PRINT("MoreauJeanOSI::updateState()\n ")
-      // DEBUG_EXPR(d.display());
-      DEBUG_PRINT("MoreauJeanOSI::updateState() prev v\n")
-      DEBUG_EXPR(v.display());
+    // get dynamical system
+    NewtonEulerDS& d = static_cast<NewtonEulerDS&> (ds);
+    SiconosVector& v = *d.twist();
+    // DEBUG_PRINT("MoreauJeanOSI::updateState()\n ")
+    // DEBUG_EXPR(d.display());
+    DEBUG_PRINT("MoreauJeanOSI::updateState() prev v\n")
+    DEBUG_EXPR(v.display());
 
-      // failure on bullet sims
-      // d.p(_levelMaxForInput) is checked in next condition
-      // assert(((d.p(_levelMaxForInput)).get()) &&
-      //       " MoreauJeanOSI::updateState() *d.p(_levelMaxForInput) == NULL.");
+    // failure on bullet sims
+    // d.p(_levelMaxForInput) is checked in next condition
+    // assert(((d.p(_levelMaxForInput)).get()) &&
+    //       " MoreauJeanOSI::updateState() *d.p(_levelMaxForInput) == NULL.");
 
-      SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
+    SiconosVector& vfree = *ds_work_vectors[MoreauJeanOSI::VFREE];
 
 
-      if( d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
-      {
-        /*d.p has been fill by the Relation->computeInput, it contains
-          B \lambda _{k+1}*/
-        v = *d.p(_levelMaxForInput); // v = p
-        if(d.boundaryConditions())
-          for(std::vector<unsigned int>::iterator
-                itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-              itindex != d.boundaryConditions()->velocityIndices()->end();
-              ++itindex)
-            v.setValue(*itindex, 0.0);
-
-        _dynamicalSystemsGraph->properties(*dsi).W->PLUForwardBackwardInPlace(v);
-
-        DEBUG_EXPR(d.p(_levelMaxForInput)->display());
-        DEBUG_PRINT("MoreauJeanOSI::updatestate W CT lambda\n");
-        DEBUG_EXPR(v.display());
-        v +=  vfree;
-      }
+    if( d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
+    {
+      /*d.p has been fill by the Relation->computeInput, it contains
+        B \lambda _{k+1}*/
+      v = *d.p(_levelMaxForInput); // v = p
+      if(d.boundaryConditions())
+        for(std::vector<unsigned int>::iterator
+              itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+            itindex != d.boundaryConditions()->velocityIndices()->end();
+            ++itindex)
+          v.setValue(*itindex, 0.0);
+
+      // W has been factorized in the batch by computeFreeState
+      if(_batchedNewtonEulerW && _newtonEulerW.isFactorized())
+        _newtonEulerW.solve(item.batchIndex, v.getArray());
       else
-        v =  vfree;
+        _dynamicalSystemsGraph->properties(item.dsv).W->PLUForwardBackwardInPlace(v);
 
-      DEBUG_PRINT("MoreauJeanOSI::updatestate work free\n");
-      DEBUG_EXPR(vfree.display());
-      DEBUG_PRINT("MoreauJeanOSI::updatestate new v\n");
+      DEBUG_EXPR(d.p(_levelMaxForInput)->display());
+      DEBUG_PRINT("MoreauJeanOSI::updatestate W CT lambda\n");
       DEBUG_EXPR(v.display());
+      v +=  vfree;
+    }
+    else
+      v =  vfree;
 
-      if(d.boundaryConditions())
-      {
-        int bc = 0;
-        SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+    DEBUG_PRINT("MoreauJeanOSI::updatestate work free\n");
+    DEBUG_EXPR(vfree.display());
+    DEBUG_PRINT("MoreauJeanOSI::updatestate new v\n");
+    DEBUG_EXPR(v.display());
 
-        for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
-            itindex != d.boundaryConditions()->velocityIndices()->end();
-            ++itindex)
+    if(d.boundaryConditions())
+    {
+      int bc = 0;
+      SP::SiconosVector columntmp(new SiconosVector(ds.dimension()));
+
+      for(std::vector<unsigned int>::iterator  itindex = d.boundaryConditions()->velocityIndices()->begin() ;
+          itindex != d.boundaryConditions()->velocityIndices()->end();
+          ++itindex)
+      {
+        _dynamicalSystemsGraph->properties(item.dsv).WBoundaryConditions->getCol(bc, *columntmp);
+        /*\warning we assume that W is symmetric in the Lagrangian case*/
+        double value = - inner_prod(*columntmp, v);
+        if( d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
         {
-          _dynamicalSystemsGraph->properties(*dsi).WBoundaryConditions->getCol(bc, *columntmp);
-          /*\warning we assume that W is symmetric in the Lagrangian case*/
-          double value = - inner_prod(*columntmp, v);
-          if( d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
-          {
-            value += (d.p(_levelMaxForInput))->getValue(*itindex);
-          }
-          /* \warning the computation of reactionToBoundaryConditions take into
-             account the contact impulse but not the external and internal forces.
-             A complete computation of the residu should be better */
-          d.reactionToBoundaryConditions()->setValue(bc, value) ;
-          bc++;
+          value += (d.p(_levelMaxForInput))->getValue(*itindex);
         }
+        /* \warning the computation of reactionToBoundaryConditions take into
+           account the contact impulse but not the external and internal forces.
+           A complete computation of the residu should be better */
+        d.reactionToBoundaryConditions()->setValue(bc, value) ;
+        bc++;
       }
-
-      updatePosition(ds);
-
     }
-    else RuntimeException::selfThrow("MoreauJeanOSI::updateState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
+
+    updatePosition(ds);
 
   }
-  DEBUG_END("MoreauJeanOSI::updateState(const unsigned int)\n");
+  else RuntimeException::selfThrow("MoreauJeanOSI::updateState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
+
+  return relativeChange;
 }
 
 
@@ -1940,6 +2248,41 @@ bool MoreauJeanOSI::removeInteractionFromIndexSet(SP::Interaction inter, unsigne
   return !(addInteractionInIndexSet(inter, i));
 }
 
+void MoreauJeanOSI::updateInteractionsActivation(const std::vector<SP::Interaction>& interactions,
+                                                 std::vector<char>& active,
+                                                 unsigned int i)
+{
+  assert(i == 1);
+  assert(active.size() == interactions.size());
+  unsigned int n = interactions.size();
+  double h = _simulation->timeStep();
+  double gamma = 1.0 / 2.0;
+  if(_useGamma)
+  {
+    gamma = _gamma;
+  }
+  double gh = gamma * h;
+
+  // gather the first components of the position and the velocity
+  std::vector<double> y(n), yDot(n);
+  for(unsigned int k = 0; k < n; ++k)
+  {
+    Interaction& inter = *interactions[k];
+    y[k] = inter.y(i - 1)->getValue(0);
+    yDot[k] = inter.y(i)->getValue(0);
+  }
+
+  // the same predicate whatever the current state, without branches
+  for(unsigned int k = 0; k < n; ++k)
+  {
+    active[k] = (y[k] + gh * yDot[k] <= 0.0);
+  }
+  DEBUG_EXPR(
+    for(unsigned int k = 0; k < n; ++k)
+      DEBUG_PRINTF("MoreauJeanOSI::updateInteractionsActivation yref=%e, yDot=%e, active=%i\n", y[k], yDot[k], active[k]);
+    );
+}
+
 
 
 void MoreauJeanOSI::display()
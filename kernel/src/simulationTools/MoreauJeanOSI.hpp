@@ -22,6 +22,7 @@
 #define MoreauJeanOSI_H
 
 #include "OneStepIntegrator.hpp"
+#include "NewtonEulerWBatch.hpp"
 
 #include <limits>
 
@@ -136,6 +137,150 @@ protected:
    */
   bool _explicitNewtonEulerDSOperators;
 
+  /** if true, the loops over the dynamical systems (free state,
+   *  update of the state, residu, Newton iteration) are run in parallel
+   *  when OpenMP is available. Default: false */
+  bool _parallelDSLoops;
+
+  /** if true, the parallel loops over the dynamical systems use a
+   *  static partition of the work list and report the error of the
+   *  first failing DS, so that two runs do the same work in the same
+   *  order on each thread. Default: true */
+  bool _deterministicDSLoops;
+
+  /** an entry of the flat list of the DS integrated by this OSI */
+  struct DSWorkItem
+  {
+    DynamicalSystem* ds;
+    DynamicalSystemsGraph::VDescriptor dsv;
+    Type::Siconos type;
+    /** position of the DS among the ones of the same type */
+    unsigned int batchIndex;
+    /** true if the forces of the DS are computed by one of _forcesBatches */
+    bool batchedForces;
+    bool operator<(const DSWorkItem& other) const
+    {
+      return type < other.type;
+    };
+  };
+
+  /** the DS integrated by this OSI, grouped by type, see _updateDSWorkList() */
+  std::vector<DSWorkItem> _dsWorkList;
+
+  /** start of each batch of DS of the same type in _dsWorkList,
+   *  followed by the size of the list */
+  std::vector<unsigned int> _dsBatches;
+
+  /** stamp and number of vertices of the DS graph when _dsWorkList was built */
+  int _dsWorkListStamp;
+  size_t _dsWorkListGraphSize;
+
+  /** if true, the iteration matrices of the NewtonEulerDS are
+   *  factorized and solved together in _newtonEulerW. Default: true */
+  bool _batchedNewtonEulerW;
+
+  /** the iteration matrices of the NewtonEulerDS, in the order of their batch */
+  NewtonEulerWBatch _newtonEulerW;
+
+  /** groups of DS whose forces are computed by one plug-in call, see insertForcesBatch() */
+  std::vector<SP::ForcesBatch> _forcesBatches;
+
+  /** time of the last evaluation of each group at the initialization of its DS */
+  std::vector<double> _forcesBatchesInitTime;
+
+  /** the per-DS phases of the integrator */
+  enum DSPhase {FREE_STATE, UPDATE_STATE, RESIDU, INITIAL_NEWTON_STATE, PREPARE_NEWTON_ITERATION,
+                NEWTON_EULER_W_SETUP, NEWTON_EULER_W_FINISH};
+
+  /** rebuild _dsWorkList and _dsBatches if the DS graph has changed */
+  void _updateDSWorkList();
+
+  /** compute the forces of the group of a DS being initialized, once
+   *  for all the DS of the group, so that their first value in memory
+   *  is the one of the group
+   *  \param t the initial time
+   *  \param ds the DS
+   *  \return false if the DS is in no group
+   */
+  bool _initializeForcesBatch(double t, DynamicalSystem& ds);
+
+  /** run one phase over all the DS integrated by this OSI, batch by
+   *  batch, in parallel chunks if _parallelDSLoops is set
+   *  \param phase the phase to run
+   *  \param time the time given to the phase
+   *  \return the maximum of the values returned for each DS
+   */
+  double _runDSPhase(DSPhase phase, double time);
+
+  /** run one phase for one DS
+   *  \param phase the phase to run
+   *  \param item the DS
+   *  \param time the time given to the phase
+   *  \return the value computed by the phase for the DS, or 0
+   */
+  double _runDSPhaseItem(DSPhase phase, const DSWorkItem& item, double time);
+
+  /** run one phase for the DS [begin, end) of _dsWorkList, in
+   *  parallel chunks if _parallelDSLoops is set
+   *  \param phase the phase to run
+   *  \param time the time given to the phase
+   *  \param begin first DS
+   *  \param end last DS + 1
+   *  \return the maximum of the values returned for each DS
+   */
+  double _runDSPhaseRange(DSPhase phase, double time, int begin, int end);
+
+  /** computeFreeState() for the NewtonEulerDS [begin, end) of
+   *  _dsWorkList, with their iteration matrices factorized in _newtonEulerW
+   *  \param t end of the time step
+   *  \param begin first DS
+   *  \param end last DS + 1
+   */
+  void _computeFreeStateNewtonEulerBatch(double t, int begin, int end);
+
+  /** compute W (unless it is kept) and copy it with the free residu in
+   *  _newtonEulerW, if the batch is not factorized
+   *  \param item a NewtonEulerDS
+   *  \param t end of the time step
+   */
+  void _setupNewtonEulerWDS(const DSWorkItem& item, double t);
+
+  /** compute the free velocity from the solution in _newtonEulerW
+   *  \param item a NewtonEulerDS
+   */
+  void _finishNewtonEulerWDS(const DSWorkItem& item);
+
+  /** computeResidu() for one DS
+   *  \param item the DS
+   *  \param t end of the time step
+   *  \return the norm of the residu of the DS
+   */
+  double _computeResiduDS(const DSWorkItem& item, double t);
+
+  /** computeFreeState() for one DS
+   *  \param item the DS
+   *  \param t end of the time step
+   */
+  void _computeFreeStateDS(const DSWorkItem& item, double t);
+
+  /** updateState() for one DS
+   *  \param item the DS
+   *  \return the relative change of q if the relative convergence
+   *  criterion is used, else 0
+   */
+  double _updateStateDS(const DSWorkItem& item);
+
+  /** computeInitialNewtonState() for one DS
+   *  \param item the DS
+   */
+  void _computeInitialNewtonStateDS(const DSWorkItem& item);
+
+  /** prepareNewtonIteration() for one DS
+   *  \param item the DS
+   *  \param time the current time
+   */
+  void _prepareNewtonIterationDS(const DSWorkItem& item, double time);
+
   /** nslaw effects
    */
   struct _NSLEffectOnFreeOutput;
@@ -280,6 +425,67 @@ public:
     _explicitNewtonEulerDSOperators = newExplicitNewtonEulerDSOperators;
   };
 
+  /** run the loops over the dynamical systems in parallel (free
+   *  state, update of the state, residu and Newton iteration). The
+   *  work done for one DS must not depend on the others: user plugins
+   *  of the DS must be thread safe. Without OpenMP, the loops stay
+   *  serial.
+   *  \param parallel true to run the loops in parallel
+   *  \param deterministic true to use a static partition of the DS
+   *  between the threads, false to balance the load dynamically
+   */
+  inline void setParallelDSLoops(bool parallel, bool deterministic = true)
+  {
+    _parallelDSLoops = parallel;
+    _deterministicDSLoops = deterministic;
+  };
+
+  /** factorize and solve the 6x6 iteration matrices of all the
+   *  NewtonEulerDS together (see NewtonEulerWBatch) instead of one
+   *  SimpleMatrix at a time
+   *  \param batched true to use the batch
+   */
+  inline void setBatchedNewtonEulerW(bool batched)
+  {
+    _batchedNewtonEulerW = batched;
+  };
+
+  /** \return true if the iteration matrices of the NewtonEulerDS are
+   *  factorized and solved together */
+  inline bool batchedNewtonEulerW() const
+  {
+    return _batchedNewtonEulerW;
+  };
+
+  /** compute the forces of a group of DS integrated by this OSI with
+   *  the batched plug-in of the group (one call per residu
+   *  computation) instead of the force plug-ins of each DS. The
+   *  group must be inserted before the initialization of the
+   *  simulation for the forces in memory at the initial time to be
+   *  the ones of the group.
+   *  \param batch the group
+   */
+  void insertForcesBatch(SP::ForcesBatch batch);
+
+  /** \return the groups of DS whose forces are computed together */
+  inline const std::vector<SP::ForcesBatch>& forcesBatches() const
+  {
+    return _forcesBatches;
+  };
+
+  /** \return true if the loops over the dynamical systems are run in parallel */
+  inline bool parallelDSLoops() const
+  {
+    return _parallelDSLoops;
+  };
+
+  /** \return true if the parallel loops over the dynamical systems
+   *  use a static partition of the DS between the threads */
+  inline bool deterministicDSLoops() const
+  {
+    return _deterministicDSLoops;
+  };
+
   // --- OTHER FUNCTIONS ---
 
   /** initialization of the MoreauJeanOSI integrator; for linear time
@@ -376,12 +582,37 @@ public:
    */
   virtual bool removeInteractionFromIndexSet(SP::Interaction inter, unsigned int i);
 
+  /** Apply the rule of addInteractionInIndexSet to a set of
+   * Interactions: the estimated positions y + gamma h yDot are
+   * gathered in a flat array and tested in one pass. A derived class
+   * that redefines addInteractionInIndexSet or
+   * removeInteractionFromIndexSet must also redefine this method, with
+   * OneStepIntegrator::updateInteractionsActivation for instance.
+   * \param interactions the Interactions to test
+   * \param active on input 1 if in the IndexSet, on output 1 if it must be in it
+   * \param i level of the IndexSet
+   */
+  virtual void updateInteractionsActivation(const std::vector<SP::Interaction>& interactions,
+                                            std::vector<char>& active,
+                                            unsigned int i);
+
 
   /** method to prepare the fist Newton iteration
    *   \param time
    */
   void prepareNewtonIteration(double time);
 
+  /** compute again the iteration matrices W of the linear time
+   * invariant systems, built once with the previous time step
+   *   \param time the end of the new time step
+   */
+  void timeStepChanged(double time);
+
+  /** set the free velocity of a dynamical system to its velocity
+   *   \param ds the dynamical system, a LagrangianDS or a NewtonEulerDS
+   */
+  void prescribeFreeState(SP::DynamicalSystem ds);
+
 
   /** integrate the system, between tinit and tend (->iout=true), with possible stop at tout (->iout=false)
    *  \param tinit the initial time
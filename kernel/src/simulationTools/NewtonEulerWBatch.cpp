@@ -0,0 +1,339 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "NewtonEulerWBatch.hpp"
+#include "SiconosMatrix.hpp"
+#include "SiconosVector.hpp"
+#include "SiconosAlgebraTypeDef.hpp"
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+/* entry (r, c) of the matrices of a pack, and row r of its right-hand
+ * sides: LANES contiguous doubles */
+#define W_(pack, r, c) (&_W[(((pack) * 36) + (r) * 6 + (c)) * LANES])
+#define RHS_(pack, r) (&_rhs[(((pack) * 6) + (r)) * LANES])
+#define PIV_(pack, k) (&_pivots[(((pack) * 6) + (k)) * LANES])
+
+void NewtonEulerWBatch::resize(unsigned int size)
+{
+  _size = size;
+  unsigned int packs = numberOfPacks();
+  _W.assign(packs * 36 * LANES, 0.0);
+  _rhs.assign(packs * 6 * LANES, 0.0);
+  _pivots.assign(packs * 6 * LANES, 0);
+  _blockDiagonal.assign(packs * LANES, 1);
+  _packBlockDiagonal.assign(packs, 0);
+  _factorized = false;
+
+  // the lanes after the last body hold identity matrices
+  for (unsigned int p = 0; p < packs; ++p)
+    for (unsigned int r = 0; r < 6; ++r)
+      for (unsigned int l = 0; l < LANES; ++l)
+        W_(p, r, r)[l] = 1.0;
+}
+
+void NewtonEulerWBatch::setMatrix(unsigned int i, const SiconosMatrix& W)
+{
+  assert(i < _size);
+  assert(W.size(0) == 6 && W.size(1) == 6);
+
+  double a[6][6];
+  if (W.num() == Siconos::DENSE)
+  {
+    const double* w = W.getArray();
+    for (unsigned int c = 0; c < 6; ++c)
+      for (unsigned int r = 0; r < 6; ++r)
+        a[r][c] = w[r + 6 * c];
+  }
+  else
+  {
+    for (unsigned int r = 0; r < 6; ++r)
+      for (unsigned int c = 0; c < 6; ++c)
+        a[r][c] = W.getValue(r, c);
+  }
+
+  // structure of a mass matrix: diagonal translational block, no
+  // coupling, symmetric rotational block
+  bool blockDiagonal = true;
+  for (unsigned int r = 0; r < 6 && blockDiagonal; ++r)
+    for (unsigned int c = 0; c < 6; ++c)
+    {
+      if ((r < 3 || c < 3) && r != c && a[r][c] != 0.0)
+      {
+        blockDiagonal = false;
+        break;
+      }
+      if (r >= 3 && c >= 3 && a[r][c] != a[c][r])
+      {
+        blockDiagonal = false;
+        break;
+      }
+    }
+
+  unsigned int pack = i / LANES;
+  unsigned int lane = i % LANES;
+  for (unsigned int r = 0; r < 6; ++r)
+    for (unsigned int c = 0; c < 6; ++c)
+      W_(pack, r, c)[lane] = a[r][c];
+  _blockDiagonal[i] = blockDiagonal;
+  _factorized = false;
+}
+
+void NewtonEulerWBatch::setRhs(unsigned int i, const SiconosVector& b)
+{
+  assert(i < _size && b.size() == 6);
+  unsigned int pack = i / LANES;
+  unsigned int lane = i % LANES;
+  for (unsigned int r = 0; r < 6; ++r)
+    RHS_(pack, r)[lane] = b.getValue(r);
+}
+
+void NewtonEulerWBatch::solution(unsigned int i, SiconosVector& x) const
+{
+  assert(i < _size && x.size() == 6);
+  unsigned int pack = i / LANES;
+  unsigned int lane = i % LANES;
+  for (unsigned int r = 0; r < 6; ++r)
+    x.setValue(r, RHS_(pack, r)[lane]);
+}
+
+int NewtonEulerWBatch::factorize(unsigned int pack)
+{
+  unsigned int lanes = std::min<unsigned int>(LANES, _size - pack * LANES);
+
+  bool blockDiagonal = true;
+  for (unsigned int l = 0; l < LANES; ++l)
+    blockDiagonal = blockDiagonal && _blockDiagonal[pack * LANES + l];
+
+  if (blockDiagonal)
+  {
+    // Cholesky factorization of the rotational blocks, kept aside
+    // until all of them are known to be positive definite
+    double l10[LANES], l20[LANES], l21[LANES], d0[LANES], d1[LANES], d2[LANES];
+    bool positive = true;
+    for (unsigned int l = 0; l < LANES; ++l)
+    {
+      double a00 = W_(pack, 3, 3)[l];
+      double a10 = W_(pack, 4, 3)[l];
+      double a20 = W_(pack, 5, 3)[l];
+      double a11 = W_(pack, 4, 4)[l];
+      double a21 = W_(pack, 5, 4)[l];
+      double a22 = W_(pack, 5, 5)[l];
+      d0[l] = a00;
+      double i0 = 1.0 / sqrt(a00);
+      l10[l] = a10 * i0;
+      l20[l] = a20 * i0;
+      d1[l] = a11 - l10[l] * l10[l];
+      double i1 = 1.0 / sqrt(d1[l]);
+      l21[l] = (a21 - l20[l] * l10[l]) * i1;
+      d2[l] = a22 - l20[l] * l20[l] - l21[l] * l21[l];
+    }
+    for (unsigned int l = 0; l < LANES; ++l)
+      positive = positive && d0[l] > 0.0 && d1[l] > 0.0 && d2[l] > 0.0
+        && W_(pack, 0, 0)[l] != 0.0 && W_(pack, 1, 1)[l] != 0.0 && W_(pack, 2, 2)[l] != 0.0;
+
+    if (positive)
+    {
+      for (unsigned int r = 0; r < 3; ++r)
+      {
+        double* wrr = W_(pack, r, r);
+        for (unsigned int l = 0; l < LANES; ++l)
+          wrr[l] = 1.0 / wrr[l];
+      }
+      double* w33 = W_(pack, 3, 3);
+      double* w44 = W_(pack, 4, 4);
+      double* w55 = W_(pack, 5, 5);
+      double* w43 = W_(pack, 4, 3);
+      double* w53 = W_(pack, 5, 3);
+      double* w54 = W_(pack, 5, 4);
+      for (unsigned int l = 0; l < LANES; ++l)
+      {
+        // inverses of the diagonal of the Cholesky factor
+        w33[l] = 1.0 / sqrt(d0[l]);
+        w44[l] = 1.0 / sqrt(d1[l]);
+        w55[l] = 1.0 / sqrt(d2[l]);
+        w43[l] = l10[l];
+        w53[l] = l20[l];
+        w54[l] = l21[l];
+      }
+      _packBlockDiagonal[pack] = 1;
+      return -1;
+    }
+  }
+
+  // LU factorization with partial pivoting, as dgetrf
+  _packBlockDiagonal[pack] = 0;
+  for (unsigned int k = 0; k < 6; ++k)
+  {
+    int* piv = PIV_(pack, k);
+    for (unsigned int l = 0; l < LANES; ++l)
+    {
+      unsigned int p = k;
+      double m = fabs(W_(pack, k, k)[l]);
+      for (unsigned int r = k + 1; r < 6; ++r)
+      {
+        double v = fabs(W_(pack, r, k)[l]);
+        if (v > m)
+        {
+          m = v;
+          p = r;
+        }
+      }
+      piv[l] = p;
+      if (p != k)
+        for (unsigned int c = 0; c < 6; ++c)
+          std::swap(W_(pack, k, c)[l], W_(pack, p, c)[l]);
+    }
+
+    const double* wkk = W_(pack, k, k);
+    for (unsigned int l = 0; l < lanes; ++l)
+      if (wkk[l] == 0.0)
+        return pack * LANES + l;
+
+    double inv[LANES];
+    for (unsigned int l = 0; l < LANES; ++l)
+      inv[l] = 1.0 / wkk[l];
+
+    for (unsigned int r = k + 1; r < 6; ++r)
+    {
+      double* wrk = W_(pack, r, k);
+      for (unsigned int l = 0; l < LANES; ++l)
+        wrk[l] *= inv[l];
+      for (unsigned int c = k + 1; c < 6; ++c)
+      {
+        double* wrc = W_(pack, r, c);
+        const double* wkc = W_(pack, k, c);
+        for (unsigned int l = 0; l < LANES; ++l)
+          wrc[l] -= wrk[l] * wkc[l];
+      }
+    }
+  }
+  return -1;
+}
+
+void NewtonEulerWBatch::solve(unsigned int pack)
+{
+  if (_packBlockDiagonal[pack])
+  {
+    for (unsigned int r = 0; r < 3; ++r)
+    {
+      double* b = RHS_(pack, r);
+      const double* w = W_(pack, r, r);
+      for (unsigned int l = 0; l < LANES; ++l)
+        b[l] *= w[l];
+    }
+    double* b3 = RHS_(pack, 3);
+    double* b4 = RHS_(pack, 4);
+    double* b5 = RHS_(pack, 5);
+    const double* i0 = W_(pack, 3, 3);
+    const double* i1 = W_(pack, 4, 4);
+    const double* i2 = W_(pack, 5, 5);
+    const double* l10 = W_(pack, 4, 3);
+    const double* l20 = W_(pack, 5, 3);
+    const double* l21 = W_(pack, 5, 4);
+    for (unsigned int l = 0; l < LANES; ++l)
+    {
+      double y0 = b3[l] * i0[l];
+      double y1 = (b4[l] - l10[l] * y0) * i1[l];
+      double y2 = (b5[l] - l20[l] * y0 - l21[l] * y1) * i2[l];
+      double x2 = y2 * i2[l];
+      double x1 = (y1 - l21[l] * x2) * i1[l];
+      double x0 = (y0 - l10[l] * x1 - l20[l] * x2) * i0[l];
+      b3[l] = x0;
+      b4[l] = x1;
+      b5[l] = x2;
+    }
+    return;
+  }
+
+  for (unsigned int k = 0; k < 6; ++k)
+  {
+    const int* piv = PIV_(pack, k);
+    for (unsigned int l = 0; l < LANES; ++l)
+      if (piv[l] != (int) k)
+        std::swap(RHS_(pack, k)[l], RHS_(pack, piv[l])[l]);
+  }
+  for (unsigned int r = 1; r < 6; ++r)
+  {
+    double* br = RHS_(pack, r);
+    for (unsigned int c = 0; c < r; ++c)
+    {
+      const double* w = W_(pack, r, c);
+      const double* bc = RHS_(pack, c);
+      for (unsigned int l = 0; l < LANES; ++l)
+        br[l] -= w[l] * bc[l];
+    }
+  }
+  for (int r = 5; r >= 0; --r)
+  {
+    double* br = RHS_(pack, r);
+    for (unsigned int c = r + 1; c < 6; ++c)
+    {
+      const double* w = W_(pack, r, c);
+      const double* bc = RHS_(pack, c);
+      for (unsigned int l = 0; l < LANES; ++l)
+        br[l] -= w[l] * bc[l];
+    }
+    const double* w = W_(pack, r, r);
+    for (unsigned int l = 0; l < LANES; ++l)
+      br[l] /= w[l];
+  }
+}
+
+void NewtonEulerWBatch::solve(unsigned int i, double* b) const
+{
+  assert(i < _size && _factorized);
+  unsigned int pack = i / LANES;
+  unsigned int l = i % LANES;
+
+  if (_packBlockDiagonal[pack])
+  {
+    for (unsigned int r = 0; r < 3; ++r)
+      b[r] *= W_(pack, r, r)[l];
+    double i0 = W_(pack, 3, 3)[l];
+    double i1 = W_(pack, 4, 4)[l];
+    double i2 = W_(pack, 5, 5)[l];
+    double l10 = W_(pack, 4, 3)[l];
+    double l20 = W_(pack, 5, 3)[l];
+    double l21 = W_(pack, 5, 4)[l];
+    double y0 = b[3] * i0;
+    double y1 = (b[4] - l10 * y0) * i1;
+    double y2 = (b[5] - l20 * y0 - l21 * y1) * i2;
+    b[5] = y2 * i2;
+    b[4] = (y1 - l21 * b[5]) * i1;
+    b[3] = (y0 - l10 * b[4] - l20 * b[5]) * i0;
+    return;
+  }
+
+  for (unsigned int k = 0; k < 6; ++k)
+  {
+    int p = PIV_(pack, k)[l];
+    if (p != (int) k)
+      std::swap(b[k], b[p]);
+  }
+  for (unsigned int r = 1; r < 6; ++r)
+    for (unsigned int c = 0; c < r; ++c)
+      b[r] -= W_(pack, r, c)[l] * b[c];
+  for (int r = 5; r >= 0; --r)
+  {
+    for (unsigned int c = r + 1; c < 6; ++c)
+      b[r] -= W_(pack, r, c)[l] * b[c];
+    b[r] /= W_(pack, r, r)[l];
+  }
+}
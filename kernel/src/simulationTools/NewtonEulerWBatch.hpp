@@ -0,0 +1,157 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file NewtonEulerWBatch.hpp
+  \brief factorization and solve of the 6x6 iteration matrices of a set of rigid bodies
+*/
+
+#ifndef NewtonEulerWBatch_H
+#define NewtonEulerWBatch_H
+
+#include "SiconosFwd.hpp"
+#include <vector>
+
+/** The 6x6 iteration matrices W of a set of NewtonEulerDS, factorized
+ * and solved together.
+ *
+ * At this size, a LAPACK call on a SimpleMatrix costs more than the
+ * arithmetic. The matrices are stored by packs of LANES bodies: the
+ * entry (i,j) of the bodies of a pack is a contiguous array of LANES
+ * doubles, so that the loops of the factorization and of the solve
+ * run over the bodies of a pack and are vectorized by the compiler.
+ *
+ * A pack in which all the matrices have the structure of a mass
+ * matrix, a diagonal translational block and a symmetric rotational
+ * block with no coupling between them (no Jacobians of the forces),
+ * is factorized block by block: inversion of the diagonal and
+ * Cholesky factorization of the 3x3 inertia. The other packs are
+ * LU-factorized with partial pivoting.
+ *
+ * Usage: resize(), setMatrix() and setRhs() for each body,
+ * factorize() and solve() for each pack (the packs are independent),
+ * then solution() for each body. Once factorized, solve(i, b) solves
+ * the system of one body.
+ */
+class NewtonEulerWBatch
+{
+public:
+  /** number of bodies in a pack */
+  enum { LANES = 8 };
+
+private:
+  /** number of bodies */
+  unsigned int _size;
+
+  /** matrices or their factors, by pack, entry and body */
+  std::vector<double> _W;
+
+  /** row interchanges of the LU factorization, by pack, row and body */
+  std::vector<int> _pivots;
+
+  /** right-hand sides or solutions, by pack, row and body */
+  std::vector<double> _rhs;
+
+  /** for each body, 1 if its matrix is block diagonal */
+  std::vector<char> _blockDiagonal;
+
+  /** for each pack, 1 if it is factorized block by block */
+  std::vector<char> _packBlockDiagonal;
+
+  /** true once all the packs are factorized */
+  bool _factorized;
+
+public:
+
+  /** empty batch */
+  NewtonEulerWBatch(): _size(0), _factorized(false) {};
+
+  /** set the number of bodies. The content is lost.
+   * \param size the number of bodies
+   */
+  void resize(unsigned int size);
+
+  /** \return the number of bodies */
+  inline unsigned int size() const
+  {
+    return _size;
+  };
+
+  /** \return the number of packs */
+  inline unsigned int numberOfPacks() const
+  {
+    return (_size + LANES - 1) / LANES;
+  };
+
+  /** copy the iteration matrix of a body. The batch is no more factorized.
+   * \param i the body
+   * \param W its 6x6 iteration matrix
+   */
+  void setMatrix(unsigned int i, const SiconosMatrix& W);
+
+  /** copy the right-hand side of a body
+   * \param i the body
+   * \param b a vector of size 6
+   */
+  void setRhs(unsigned int i, const SiconosVector& b);
+
+  /** copy the solution of a body, after solve()
+   * \param i the body
+   * \param[out] x a vector of size 6
+   */
+  void solution(unsigned int i, SiconosVector& x) const;
+
+  /** factorize the matrices of a pack
+   * \param pack the pack
+   * \return -1, or the first body of the pack with a singular matrix
+   */
+  int factorize(unsigned int pack);
+
+  /** solve the systems of a pack, with the right-hand sides given by setRhs()
+   * \param pack the (factorized) pack
+   */
+  void solve(unsigned int pack);
+
+  /** solve the system of one body
+   * \param i the body
+   * \param[in,out] b the right-hand side (6 doubles), the solution on output
+   */
+  void solve(unsigned int i, double* b) const;
+
+  /** record that all the packs are factorized, or that the matrices changed
+   * \param factorized the state of the batch
+   */
+  inline void setFactorized(bool factorized)
+  {
+    _factorized = factorized;
+  };
+
+  /** \return true if all the packs are factorized */
+  inline bool isFactorized() const
+  {
+    return _factorized;
+  };
+
+  /** \param i a body
+   * \return true if the matrix of the body is factorized block by block */
+  inline bool isBlockDiagonal(unsigned int i) const
+  {
+    return _packBlockDiagonal[i / LANES];
+  };
+};
+
+#endif
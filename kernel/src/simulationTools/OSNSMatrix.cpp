@@ -21,6 +21,7 @@
 #include "Tools.hpp"
 #include "BlockCSRMatrix.hpp"
 #include "SimulationGraphs.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 #include "SimpleMatrix.hpp"
 #include "Interaction.hpp"
 #include "DynamicalSystem.hpp"
@@ -279,6 +280,72 @@ void OSNSMatrix::fillW(InteractionsGraph& indexSet, bool update)
   DEBUG_END("void OSNSMatrix::fill(SP::InteractionsGraph indexSet, bool update)\n");
 }
 
+void OSNSMatrix::fillW(InteractionsGraphSnapshot& snapshot, bool update)
+{
+  DEBUG_BEGIN("void OSNSMatrix::fillW(InteractionsGraphSnapshot& snapshot, bool update)\n");
+  InteractionsGraph& indexSet = *snapshot.indexSet();
+
+  if (update) // If index set vertices list has changed
+  {
+    // Computes _dimRow and interactionBlocksPositions according to indexSet
+    _dimColumn = updateSizeAndPositions(indexSet);
+    _dimRow = _dimColumn;
+    assert(_dimRow == snapshot.dimension());
+  }
+
+  if (_storageType == NM_DENSE)
+  {
+    // === Memory allocation, if required ===
+    if (update)
+    {
+      if (! _M1)
+        _M1.reset(new SimpleMatrix(_dimRow, _dimColumn));
+      else
+      {
+        if (_M1->size(0) != _dimRow || _M1->size(1) != _dimColumn)
+          _M1->resize(_dimRow, _dimColumn);
+        _M1->zero();
+      }
+    }
+
+    SimpleMatrix& M1 = static_cast<SimpleMatrix&>(*_M1);
+
+    // === diagonal blocks, in the order of the vertices ===
+    for (unsigned int i = 0; i < snapshot.size(); ++i)
+    {
+      unsigned int pos = snapshot.absolutePosition(i);
+      assert(snapshot.block(i));
+      M1.setBlock(pos, pos, *snapshot.block(i));
+    }
+
+    // === extra-diagonal blocks ===
+    for (unsigned int k = 0; k < snapshot.edgesNumber(); ++k)
+    {
+      unsigned int pos = snapshot.absolutePosition(snapshot.source(k));
+      unsigned int col = snapshot.absolutePosition(snapshot.target(k));
+
+      assert(pos < _dimRow);
+      assert(col < _dimColumn);
+      assert(snapshot.upperBlock(k));
+      assert(snapshot.lowerBlock(k));
+
+      M1.setBlock(std::min(pos, col), std::max(pos, col), *snapshot.upperBlock(k));
+      M1.setBlock(std::max(pos, col), std::min(pos, col), *snapshot.lowerBlock(k));
+    }
+  }
+  else if (_storageType == NM_SPARSE_BLOCK)
+  {
+    if (! _M2)
+      _M2.reset(new BlockCSRMatrix(indexSet));
+    else
+      _M2->fill(indexSet);
+  }
+
+  if (update)
+    convert();
+  DEBUG_END("void OSNSMatrix::fillW(InteractionsGraphSnapshot& snapshot, bool update)\n");
+}
+
 // convert current matrix to NumericsMatrix structure
 void OSNSMatrix::convert()
 {
@@ -227,6 +227,12 @@ public:
    */
   virtual void fillW(InteractionsGraph&indexSet, bool update = true);
 
+  /** fill the current class using the flat copy of an index set
+   * \param snapshot the frozen index set of the active constraints
+   * \param update if true update the size of the Matrix (default true)
+   */
+  virtual void fillW(InteractionsGraphSnapshot& snapshot, bool update = true);
+
   /** fill the current class using an index set
    * \param DSG the index set of the dynamicalSystems
    * \param update if true update the size of the Matrix (default true)
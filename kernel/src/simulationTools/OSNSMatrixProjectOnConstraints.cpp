@@ -25,6 +25,7 @@
 #include "OSNSMatrix.hpp"
 #include "BlockCSRMatrix.hpp"
 #include "SimulationGraphs.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 #include "SimpleMatrix.hpp"
 using namespace RELATION;
 using namespace Siconos;
@@ -225,3 +226,9 @@ unsigned int OSNSMatrixProjectOnConstraints::computeSizeForProjection(SP::Intera
   return size;
 
 }
+
+void OSNSMatrixProjectOnConstraints::fillW(InteractionsGraphSnapshot& snapshot, bool update)
+{
+  fillW(*snapshot.indexSet(), update);
+  snapshot.refreshPositions();
+}
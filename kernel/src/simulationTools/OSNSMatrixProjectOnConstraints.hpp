@@ -132,6 +132,13 @@ public:
   */
   void fillW(InteractionsGraph& indexSet, bool update = true);
 
+  /** fill the matrix from the graph of a snapshot, whose absolute
+   * positions are then read back from the graph
+   * \param snapshot the frozen index set of the active constraints
+   * \param update if true update the size of the Matrix (default true)
+   */
+  void fillW(InteractionsGraphSnapshot& snapshot, bool update = true);
+
 };
 
 DEFINE_SPTR(OSNSMatrixProjectOnConstraints)
@@ -200,10 +200,69 @@ double OneStepIntegrator::computeResiduInput(double time, SP::InteractionsGraph
 
 
 
+void OneStepIntegrator::updateInteractionsActivation(const std::vector<SP::Interaction>& interactions,
+                                                     std::vector<char>& active,
+                                                     unsigned int i)
+{
+  assert(active.size() == interactions.size());
+  for (unsigned int k = 0; k < interactions.size(); ++k)
+  {
+    if (active[k])
+      active[k] = !removeInteractionFromIndexSet(interactions[k], i);
+    else
+      active[k] = addInteractionInIndexSet(interactions[k], i);
+  }
+}
+
+bool OneStepIntegrator::_keepIterationMatrix(double time)
+{
+  double h = _simulation->timeStep();
+  bool newStep = time != _iterationMatrixTime || h != _iterationMatrixTimeStep;
+
+  _iterationMatrixKept = false;
+  if(_iterationMatrixMaxIterations > 1 && !newStep
+     && _iterationMatrixIterations < _iterationMatrixMaxIterations)
+  {
+    // contraction of the residu during the previous iteration
+    _iterationMatrixKept = _newtonResidu <= _iterationMatrixContraction * _previousNewtonResidu;
+  }
+
+  if(_iterationMatrixKept)
+  {
+    _iterationMatrixIterations++;
+    _nbIterationMatrixReuses++;
+  }
+  else
+  {
+    _iterationMatrixIterations = 1;
+    _iterationMatrixTime = time;
+    _iterationMatrixTimeStep = h;
+    _nbIterationMatrixComputations++;
+  }
+  _previousNewtonResidu = _newtonResidu;
+  return _iterationMatrixKept;
+}
+
+void OneStepIntegrator::timeStepChanged(double time)
+{
+  // the next call of _keepIterationMatrix() sees a new step
+  _iterationMatrixTimeStep = 0.0;
+}
+
+void OneStepIntegrator::prescribeFreeState(SP::DynamicalSystem ds)
+{
+  RuntimeException::selfThrow("OneStepIntegrator::prescribeFreeState not implemented for this type of integrator");
+}
+
 void OneStepIntegrator::display()
 {
   std::cout << "==== OneStepIntegrator display =====" <<std::endl;
   std::cout << "| _integratorType : " << _integratorType <<std::endl;
   std::cout << "| _sizeMem: " << _sizeMem <<std::endl;
+  if(_iterationMatrixMaxIterations > 1)
+  {
+    std::cout << "| iteration matrix computed " << _nbIterationMatrixComputations
+              << " times, reused " << _nbIterationMatrixReuses << " times" <<std::endl;
+  }
   std::cout << "====================================" <<std::endl;
 }
@@ -101,7 +101,45 @@ protected:
 
   bool _explicitJacobiansOfRelation;
 
+  /** maximum number of Newton iterations of a time step done with
+   * the same iteration matrix W (modified Newton). With 1, the
+   * default, W is computed and factorized at each iteration.
+   */
+  unsigned int _iterationMatrixMaxIterations;
+
+  /** W is computed again as soon as the ratio of the residus of two
+   * successive Newton iterations is above this value
+   */
+  double _iterationMatrixContraction;
+
+  /** true if W is kept for the current Newton iteration, see
+   * _keepIterationMatrix()
+   */
+  bool _iterationMatrixKept;
+
+  /** number of Newton iterations done with the current W */
+  unsigned int _iterationMatrixIterations;
 
+  /** end and length of the time step of the current W */
+  double _iterationMatrixTime;
+  double _iterationMatrixTimeStep;
+
+  /** residu of the DS at the last call of computeResidu(), and at
+   * the beginning of the previous Newton iteration
+   */
+  double _newtonResidu;
+  double _previousNewtonResidu;
+
+  /** number of Newton iterations with a new W, and with the W of the
+   * previous iteration
+   */
+  unsigned long _nbIterationMatrixComputations;
+  unsigned long _nbIterationMatrixReuses;
+
+  /** number of steps of the integrator in a step of the simulation,
+   *  used by TimeSteppingMultirate (default 1)
+   */
+  unsigned int _subSteps;
 
   /** A link to the simulation that owns this OSI */
   SP::Simulation _simulation;
@@ -113,7 +151,13 @@ protected:
     : _integratorType(type), _sizeMem(1), _steps(0),
       _levelMinForOutput(0), _levelMaxForOutput(0),
       _levelMinForInput(0), _levelMaxForInput(0),
-      _isInitialized(false), _explicitJacobiansOfRelation(false) {};
+      _isInitialized(false), _explicitJacobiansOfRelation(false),
+      _iterationMatrixMaxIterations(1), _iterationMatrixContraction(0.5),
+      _iterationMatrixKept(false), _iterationMatrixIterations(0),
+      _iterationMatrixTime(0.0), _iterationMatrixTimeStep(0.0),
+      _newtonResidu(0.0), _previousNewtonResidu(0.0),
+      _nbIterationMatrixComputations(0), _nbIterationMatrixReuses(0),
+      _subSteps(1) {};
 
   /** struct to add terms in the integration. Useful for Control */
   SP::ExtraAdditionalTerms _extraAdditionalTerms;
@@ -124,6 +168,17 @@ protected:
   */
   void _check_and_update_interaction_levels(Interaction& inter);
 
+  /** decide, at the beginning of a Newton iteration, if the iteration
+   *  matrix W of the previous iteration is kept (modified Newton), see
+   *  setIterationMatrixReuse(). It is computed again at the first
+   *  iteration of a time step, after _iterationMatrixMaxIterations
+   *  iterations, or if the residu did not decrease enough during the
+   *  previous iteration. Sets _iterationMatrixKept and the counters.
+   *  \param time the end of the time step
+   *  \return true if W is kept
+   */
+  bool _keepIterationMatrix(double time);
+
   /** initialization of the work vectors and matrices (properties) related to
    *  one dynamical system on the graph and needed by the osi -- common code.
    * \param ds the dynamical system
@@ -131,7 +186,13 @@ protected:
   SP::VectorOfVectors _initializeDSWorkVectors(SP::DynamicalSystem ds);
 
   /** default constructor */
-  OneStepIntegrator() {};
+  OneStepIntegrator()
+    : _iterationMatrixMaxIterations(1), _iterationMatrixContraction(0.5),
+      _iterationMatrixKept(false), _iterationMatrixIterations(0),
+      _iterationMatrixTime(0.0), _iterationMatrixTimeStep(0.0),
+      _newtonResidu(0.0), _previousNewtonResidu(0.0),
+      _nbIterationMatrixComputations(0), _nbIterationMatrixReuses(0),
+      _subSteps(1) {};
 
 private:
 
@@ -259,6 +320,67 @@ public:
     _explicitJacobiansOfRelation = newval;
   };
 
+  /** keep the factorized iteration matrix W over several Newton
+   *  iterations of a time step (modified Newton), for the integrators
+   *  that support it (MoreauJeanOSI, EulerMoreauOSI). The Jacobians of
+   *  the forces are then evaluated only when W is computed. The
+   *  residu is still computed exactly, so the Newton loop converges to
+   *  the same solution, in more but cheaper iterations.
+   *  \param maxIterations the maximum number of iterations done with
+   *  the same W, 1 to compute it at each iteration
+   *  \param contraction W is computed again when the residu of an
+   *  iteration is above contraction times the one of the previous
+   *  iteration
+   */
+  void setIterationMatrixReuse(unsigned int maxIterations, double contraction = 0.5)
+  {
+    _iterationMatrixMaxIterations = maxIterations ? maxIterations : 1;
+    _iterationMatrixContraction = contraction;
+  };
+
+  /** \return the maximum number of Newton iterations done with the same W */
+  unsigned int iterationMatrixMaxIterations() const
+  {
+    return _iterationMatrixMaxIterations;
+  };
+
+  /** \return the number of Newton iterations with a new iteration matrix W */
+  unsigned long numberOfIterationMatrixComputations() const
+  {
+    return _nbIterationMatrixComputations;
+  };
+
+  /** \return the number of Newton iterations which reused the factorized
+   *  iteration matrix W of the previous one */
+  unsigned long numberOfIterationMatrixReuses() const
+  {
+    return _nbIterationMatrixReuses;
+  };
+
+  /** set to zero the counters of the computations and reuses of W */
+  void resetIterationMatrixStatistics()
+  {
+    _nbIterationMatrixComputations = 0;
+    _nbIterationMatrixReuses = 0;
+  };
+
+  /** set the number of steps of the integrator in a step of the
+   *  simulation. Only a TimeSteppingMultirate integrates the dynamical
+   *  systems of the integrator with sub-steps, the other simulations
+   *  ignore this value.
+   *  \param subSteps a positive number of sub-steps
+   */
+  void setSubSteps(unsigned int subSteps)
+  {
+    _subSteps = subSteps ? subSteps : 1;
+  };
+
+  /** \return the number of steps of the integrator in a step of the simulation */
+  unsigned int subSteps() const
+  {
+    return _subSteps;
+  };
+
   /** initialise the integrator
    */
   virtual void initialize();
@@ -395,6 +517,24 @@ public:
 
   /** */
   virtual void prepareNewtonIteration(double time) = 0;
+
+  /** called by the Simulation when the length of the time step
+   * differs from the one of the previous step, before the Newton loop.
+   * The default forgets the iteration matrix W kept from the previous
+   * step. Integrators with matrices depending on the time step and
+   * computed once (linear time invariant systems) compute them again.
+   * \param time the end of the new time step
+   */
+  virtual void timeStepChanged(double time);
+
+  /** called by TimeSteppingMultirate for a dynamical system of the
+   * integrator linked by an Interaction to the ones of a faster
+   * integrator: its motion is prescribed in the nonsmooth problem of
+   * the faster integrator, hence its free state is set to its current
+   * state. The default throws.
+   * \param ds the dynamical system
+   */
+  virtual void prescribeFreeState(SP::DynamicalSystem ds);
   /** @} end of computation functions */
 
   /*! @name Misc
@@ -429,6 +569,18 @@ public:
     return 0;
   };
 
+  /** Apply the rules of addInteractionInIndexSet and
+   * removeInteractionFromIndexSet to a set of Interactions at once.
+   * The default calls them one Interaction after the other.
+   * \param interactions the Interactions to test
+   * \param active on input, for each Interaction, 1 if it is in the
+   * IndexSet of level i; on output, 1 if it must be in it
+   * \param i level of the IndexSet
+   */
+  virtual void updateInteractionsActivation(const std::vector<SP::Interaction>& interactions,
+                                            std::vector<char>& active,
+                                            unsigned int i);
+
   /** get the ExtraAdditionalTerms.
    * \return the ExtraAdditionalTerms
    */
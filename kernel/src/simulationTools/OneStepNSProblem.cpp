@@ -31,19 +31,25 @@
 #include "ZeroOrderHoldOSI.hpp"
 #include "NonSmoothLaw.hpp"
 #include "Simulation.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
 #include "debug.h"
 #include "numerics_verbose.h" // numerics to set verbose mode ...
+#include "SolverOptions.h"
+
+#include <algorithm>
+#include <set>
 
 
 OneStepNSProblem::OneStepNSProblem():
-  _indexSetLevel(0), _inputOutputLevel(0), _maxSize(0), _hasBeenUpdated(false)
+  _indexSetLevel(0), _inputOutputLevel(0), _maxSize(0), _hasBeenUpdated(false),
+  _keepInteractionBlocks(false), _indexSetChangesReported(false),
+  _numberOfComputedBlocks(0)
 {
   _numerics_solver_options.reset(new SolverOptions);
-  _numerics_solver_options->iWork = NULL;   _numerics_solver_options->callback = NULL;
-  _numerics_solver_options->dWork = NULL;
+  solver_options_nullify(&*_numerics_solver_options);
 }
 // --- CONSTRUCTORS/DESTRUCTOR ---
 
@@ -51,18 +57,36 @@ OneStepNSProblem::OneStepNSProblem():
 // Constructor with given simulation and a pointer on Solver (Warning, solver is an optional argument)
 OneStepNSProblem::OneStepNSProblem(int numericsSolverId):
   _numerics_solver_id(numericsSolverId), _sizeOutput(0),
-  _indexSetLevel(0), _inputOutputLevel(0), _maxSize(0), _hasBeenUpdated(false)
+  _indexSetLevel(0), _inputOutputLevel(0), _maxSize(0), _hasBeenUpdated(false),
+  _keepInteractionBlocks(false), _indexSetChangesReported(false),
+  _numberOfComputedBlocks(0)
 {
 
   _numerics_solver_options.reset(new SolverOptions);
-  _numerics_solver_options->iWork = NULL;   _numerics_solver_options->callback = NULL;
-  _numerics_solver_options->dWork = NULL;
+  solver_options_nullify(&*_numerics_solver_options);
   _numerics_solver_options->solverId = numericsSolverId;
 }
 
 bool OneStepNSProblem::hasInteractions() const
 {
-  return _simulation->nonSmoothDynamicalSystem()->topology()->indexSet(_indexSetLevel)->size() > 0 ;
+  return _simulation->indexSet(_indexSetLevel)->size() > 0 ;
+}
+
+void OneStepNSProblem::indexSetChanged(const std::vector<SP::Interaction>& activated,
+                                       const std::vector<SP::Interaction>& deactivated)
+{
+  if (!_keepInteractionBlocks)
+    return;
+  // an Interaction activated and deactivated before the update has no block
+  for (unsigned int k = 0; k < deactivated.size(); ++k)
+  {
+    std::vector<SP::Interaction>::iterator it =
+      std::find(_activatedInteractions.begin(), _activatedInteractions.end(), deactivated[k]);
+    if (it != _activatedInteractions.end())
+      _activatedInteractions.erase(it);
+  }
+  _activatedInteractions.insert(_activatedInteractions.end(), activated.begin(), activated.end());
+  _indexSetChangesReported = true;
 }
 
 void OneStepNSProblem::updateInteractionBlocks()
@@ -89,93 +113,112 @@ void OneStepNSProblem::updateInteractionBlocks()
   //  - If 1==false, 2 is not checked, and the interactionBlock is computed if 3==true.
   //
 
-  // Get index set from Simulation
+  // Get index set from Simulation, and its flat copy for the loops
   SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  InteractionsGraphSnapshot& snapshot = *simulation()->indexSetSnapshot(indexSetLevel());
 
   bool isLinear = simulation()->nonSmoothDynamicalSystem()->isLinear();
 
+  // when the blocks are kept, only the ones of the activated
+  // Interactions, and of their edges, have to be computed
+  bool computeAll = !isLinear || !_hasBeenUpdated;
+  std::vector<char> toCompute(snapshot.size(), computeAll);
+  if (!computeAll && !_activatedInteractions.empty())
+  {
+    std::set<Interaction*> activated;
+    for (unsigned int k = 0; k < _activatedInteractions.size(); ++k)
+      activated.insert(_activatedInteractions[k].get());
+    for (unsigned int i = 0; i < snapshot.size(); ++i)
+      toCompute[i] = activated.count(&snapshot.interaction(i));
+  }
+
   // we put diagonal information on vertices
   // self loops with bgl are a *nightmare* at the moment
   // (patch 65198 on standard boost install)
-  if (indexSet->properties().symmetric)
+  for (unsigned int i = 0; i < snapshot.size(); ++i)
   {
-    DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Symmetric case");
-    InteractionsGraph::VIterator vi, viend;
-    for (std11::tie(vi, viend) = indexSet->vertices();
-         vi != viend; ++vi)
+    DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Computation of diagonal block\n");
+    if (! snapshot.block(i))
     {
-      SP::Interaction inter = indexSet->bundle(*vi);
-      unsigned int nslawSize = inter->nonSmoothLaw()->size();
-      if (! indexSet->properties(*vi).block)
+      SP::SiconosMatrix& block = indexSet->properties(snapshot.vertex(i)).block;
+      if (! block)
       {
-        indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
+        unsigned int nslawSize = snapshot.nslawSize(i);
+        block.reset(new SimpleMatrix(nslawSize, nslawSize));
       }
+      snapshot.setBlock(i, block.get());
+    }
 
-      if (!isLinear || !_hasBeenUpdated)
-      {
-        computeDiagonalInteractionBlock(*vi);
-      }
+    if (toCompute[i])
+    {
+      computeDiagonalInteractionBlock(snapshot.vertex(i));
+      _numberOfComputedBlocks++;
     }
+  }
+
+  if (indexSet->properties().symmetric)
+  {
+    DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Symmetric case");
 
     /* interactionBlock must be zeroed at init */
-    std::vector<bool> initialized;
-    initialized.resize(indexSet->edges_number());
-    std::fill(initialized.begin(), initialized.end(), false);
+    std::vector<bool> initialized(snapshot.edgesNumber(), false);
 
-    InteractionsGraph::EIterator ei, eiend;
-    for (std11::tie(ei, eiend) = indexSet->edges();
-         ei != eiend; ++ei)
+    for (unsigned int k = 0; k < snapshot.edgesNumber(); ++k)
     {
-      SP::Interaction inter1 = indexSet->bundle(indexSet->source(*ei));
-      SP::Interaction inter2 = indexSet->bundle(indexSet->target(*ei));
-
       /* on adjoint graph there is at most 2 edges between source and target */
-      InteractionsGraph::EDescriptor ed1, ed2;
-      std11::tie(ed1, ed2) = indexSet->edges(indexSet->source(*ei), indexSet->target(*ei));
+      unsigned int k1 = snapshot.firstEdge(k);
+      InteractionsGraph::EDescriptor ed1 = snapshot.edge(k1);
+      InteractionsGraph::EDescriptor ed2 = snapshot.secondEdge(k);
 
-      assert(*ei == ed1 || *ei == ed2);
-
-      /* the first edge has the lower index */
-      assert(indexSet->index(ed1) <= indexSet->index(ed2));
+      assert(snapshot.edge(k) == ed1 || snapshot.edge(k) == ed2);
 
       // Memory allocation if needed
-      unsigned int nslawSize1 = inter1->nonSmoothLaw()->size();
-      unsigned int nslawSize2 = inter2->nonSmoothLaw()->size();
-      unsigned int isrc = indexSet->index(indexSet->source(*ei));
-      unsigned int itar = indexSet->index(indexSet->target(*ei));
+      unsigned int isrc = snapshot.source(k);
+      unsigned int itar = snapshot.target(k);
+      unsigned int nslawSize1 = snapshot.nslawSize(isrc);
+      unsigned int nslawSize2 = snapshot.nslawSize(itar);
 
+      DynamicalSystemProperties& properties1 = indexSet->properties(ed1);
       SP::SiconosMatrix currentInteractionBlock;
 
       if (itar > isrc) // upper block
       {
-        if (! indexSet->properties(ed1).upper_block)
+        if (! properties1.upper_block)
         {
-          indexSet->properties(ed1).upper_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
+          properties1.upper_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
           if (ed2 != ed1)
-            indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
+            indexSet->properties(ed2).upper_block = properties1.upper_block;
         }
-        currentInteractionBlock = indexSet->properties(ed1).upper_block;
+        currentInteractionBlock = properties1.upper_block;
       }
       else  // lower block
       {
-        if (! indexSet->properties(ed1).lower_block)
+        if (! properties1.lower_block)
         {
-          indexSet->properties(ed1).lower_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
+          properties1.lower_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
           if (ed2 != ed1)
-            indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
+            indexSet->properties(ed2).lower_block = properties1.lower_block;
         }
-        currentInteractionBlock = indexSet->properties(ed1).lower_block;
+        currentInteractionBlock = properties1.lower_block;
+      }
+
+      if (!toCompute[isrc] && !toCompute[itar])
+      {
+        // kept block
+        snapshot.setUpperBlock(k, properties1.upper_block.get());
+        snapshot.setLowerBlock(k, properties1.lower_block.get());
+        continue;
       }
 
-      if (!initialized[indexSet->index(ed1)])
+      if (!initialized[k1])
       {
-        initialized[indexSet->index(ed1)] = true;
+        initialized[k1] = true;
         currentInteractionBlock->zero();
       }
-      if (!isLinear || !_hasBeenUpdated)
       {
         {
-          computeInteractionBlock(*ei);
+          computeInteractionBlock(snapshot.edge(k));
+          _numberOfComputedBlocks++;
         }
 
         // allocation for transposed block
@@ -183,143 +226,117 @@ void OneStepNSProblem::updateInteractionBlocks()
 
         if (itar > isrc) // upper block has been computed
         {
-          if (!indexSet->properties(ed1).lower_block)
+          if (!properties1.lower_block)
           {
-            indexSet->properties(ed1).lower_block.
-            reset(new SimpleMatrix(indexSet->properties(ed1).upper_block->size(1),
-                                   indexSet->properties(ed1).upper_block->size(0)));
+            properties1.lower_block.
+            reset(new SimpleMatrix(properties1.upper_block->size(1),
+                                   properties1.upper_block->size(0)));
           }
-          indexSet->properties(ed1).lower_block->trans(*indexSet->properties(ed1).upper_block);
-          indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
+          properties1.lower_block->trans(*properties1.upper_block);
+          indexSet->properties(ed2).lower_block = properties1.lower_block;
         }
         else
         {
           assert(itar < isrc);    // lower block has been computed
-          if (!indexSet->properties(ed1).upper_block)
+          if (!properties1.upper_block)
           {
-            indexSet->properties(ed1).upper_block.
-            reset(new SimpleMatrix(indexSet->properties(ed1).lower_block->size(1),
-                                   indexSet->properties(ed1).lower_block->size(0)));
+            properties1.upper_block.
+            reset(new SimpleMatrix(properties1.lower_block->size(1),
+                                   properties1.lower_block->size(0)));
           }
-          indexSet->properties(ed1).upper_block->trans(*indexSet->properties(ed1).lower_block);
-          indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
+          properties1.upper_block->trans(*properties1.lower_block);
+          indexSet->properties(ed2).upper_block = properties1.upper_block;
         }
       }
+      snapshot.setUpperBlock(k, properties1.upper_block.get());
+      snapshot.setLowerBlock(k, properties1.lower_block.get());
     }
   }
   else // not symmetric => follow out_edges for each vertices
   {
     DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Non symmetric case\n");
 
-    InteractionsGraph::VIterator vi, viend;
-    for (std11::tie(vi, viend) = indexSet->vertices();
-         vi != viend; ++vi)
+    for (unsigned int i = 0; i < snapshot.size(); ++i)
     {
-      DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Computation of diaganal block\n");
-      SP::Interaction inter = indexSet->bundle(*vi);
-      unsigned int nslawSize = inter->nonSmoothLaw()->size();
-      if (! indexSet->properties(*vi).block)
-      {
-        indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
-      }
-
-      if (!isLinear || !_hasBeenUpdated)
-      {
-        computeDiagonalInteractionBlock(*vi);
-      }
-
       /* on a undirected graph, out_edges gives all incident edges */
-      InteractionsGraph::OEIterator oei, oeiend;
       /* interactionBlock must be zeroed at init */
       std::map<SP::SiconosMatrix, bool> initialized;
-      for (std11::tie(oei, oeiend) = indexSet->out_edges(*vi);
-           oei != oeiend; ++oei)
+      for (unsigned int p = snapshot.incidentBegin(i); p < snapshot.incidentEnd(i); ++p)
       {
         /* on adjoint graph there is at most 2 edges between source and target */
-        InteractionsGraph::EDescriptor ed1, ed2;
-        std11::tie(ed1, ed2) = indexSet->edges(indexSet->source(*oei), indexSet->target(*oei));
-        if (indexSet->properties(ed1).upper_block)
+        DynamicalSystemProperties& properties1 =
+          indexSet->properties(snapshot.edge(snapshot.firstEdge(snapshot.incidentEdge(p))));
+        if (properties1.upper_block)
         {
-          initialized[indexSet->properties(ed1).upper_block] = false;
+          initialized[properties1.upper_block] = false;
         }
-        // if(indexSet->properties(ed2).upper_block)
-        // {
-        //   initialized[indexSet->properties(ed2).upper_block] = false;
-        // }
 
-        if (indexSet->properties(ed1).lower_block)
+        if (properties1.lower_block)
         {
-          initialized[indexSet->properties(ed1).lower_block] = false;
+          initialized[properties1.lower_block] = false;
         }
-        // if(indexSet->properties(ed2).lower_block)
-        // {
-        //   initialized[indexSet->properties(ed2).lower_block] = false;
-        // }
-
       }
 
-      for (std11::tie(oei, oeiend) = indexSet->out_edges(*vi);
-           oei != oeiend; ++oei)
+      for (unsigned int p = snapshot.incidentBegin(i); p < snapshot.incidentEnd(i); ++p)
       {
         DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Computation of extra-diaganal block\n");
 
         /* on adjoint graph there is at most 2 edges between source and target */
-        InteractionsGraph::EDescriptor ed1, ed2;
-        std11::tie(ed1, ed2) = indexSet->edges(indexSet->source(*oei), indexSet->target(*oei));
+        unsigned int k = snapshot.incidentEdge(p);
+        InteractionsGraph::EDescriptor ed1 = snapshot.edge(snapshot.firstEdge(k));
+        InteractionsGraph::EDescriptor ed2 = snapshot.secondEdge(k);
 
-        assert(*oei == ed1 || *oei == ed2);
-
-        /* the first edge as the lower index */
-        assert(indexSet->index(ed1) <= indexSet->index(ed2));
-
-        SP::Interaction inter1 = indexSet->bundle(indexSet->source(*oei));
-        SP::Interaction inter2 = indexSet->bundle(indexSet->target(*oei));
+        // the incident edge goes from i to itar
+        unsigned int isrc = i;
+        unsigned int itar = snapshot.incidentVertex(p);
 
         // Memory allocation if needed
-        unsigned int nslawSize1 = inter1->nonSmoothLaw()->size();
-        unsigned int nslawSize2 = inter2->nonSmoothLaw()->size();
-        unsigned int isrc = indexSet->index(indexSet->source(*oei));
-        unsigned int itar = indexSet->index(indexSet->target(*oei));
+        unsigned int nslawSize1 = snapshot.nslawSize(isrc);
+        unsigned int nslawSize2 = snapshot.nslawSize(itar);
 
+        DynamicalSystemProperties& properties1 = indexSet->properties(ed1);
         SP::SiconosMatrix currentInteractionBlock;
 
         if (itar > isrc) // upper block
         {
-          if (! indexSet->properties(ed1).upper_block)
+          if (! properties1.upper_block)
           {
-            indexSet->properties(ed1).upper_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
-            initialized[indexSet->properties(ed1).upper_block] = false;
+            properties1.upper_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
+            initialized[properties1.upper_block] = false;
             if (ed2 != ed1)
-              indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
+              indexSet->properties(ed2).upper_block = properties1.upper_block;
           }
-          currentInteractionBlock = indexSet->properties(ed1).upper_block;
+          currentInteractionBlock = properties1.upper_block;
 
         }
         else  // lower block
         {
-          if (! indexSet->properties(ed1).lower_block)
+          if (! properties1.lower_block)
           {
-            indexSet->properties(ed1).lower_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
-            initialized[indexSet->properties(ed1).lower_block] = false;
+            properties1.lower_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
+            initialized[properties1.lower_block] = false;
             if (ed2 != ed1)
-              indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
+              indexSet->properties(ed2).lower_block = properties1.lower_block;
           }
-          currentInteractionBlock = indexSet->properties(ed1).lower_block;
+          currentInteractionBlock = properties1.lower_block;
         }
 
 
-        if (!initialized[currentInteractionBlock])
-        {
-          initialized[currentInteractionBlock] = true;
-          currentInteractionBlock->zero();
-        }
-
-        if (!isLinear || !_hasBeenUpdated)
+        if (toCompute[isrc] || toCompute[itar])
         {
+          if (!initialized[currentInteractionBlock])
+          {
+            initialized[currentInteractionBlock] = true;
+            currentInteractionBlock->zero();
+          }
           if (isrc != itar)
-            computeInteractionBlock(*oei);
+          {
+            computeInteractionBlock(snapshot.incidentDescriptor(p));
+            _numberOfComputedBlocks++;
+          }
         }
-
+        snapshot.setUpperBlock(k, properties1.upper_block.get());
+        snapshot.setLowerBlock(k, properties1.lower_block.get());
       }
     }
   }
@@ -327,6 +344,9 @@ void OneStepNSProblem::updateInteractionBlocks()
 
   DEBUG_EXPR(displayBlocks(indexSet););
 
+  _activatedInteractions.clear();
+  _indexSetChangesReported = false;
+
   DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks() ends\n");
 
 
@@ -106,6 +106,21 @@ protected:
   /*During Newton it, this flag allows to update the numerics matrices only once if necessary.*/
   bool _hasBeenUpdated;
 
+  /** if true, for a linear system, the interaction blocks are computed
+   * once and kept: when the index set changes, only the blocks of the
+   * activated Interactions are computed */
+  bool _keepInteractionBlocks;
+
+  /** true if the changes of the index set since the last update of
+   * the blocks have been reported with indexSetChanged() */
+  bool _indexSetChangesReported;
+
+  /** the Interactions activated since the last update of the blocks */
+  std::vector<SP::Interaction> _activatedInteractions;
+
+  /** number of blocks computed since the creation of the problem */
+  unsigned int _numberOfComputedBlocks;
+
   // --- CONSTRUCTORS/DESTRUCTOR ---
   /** default constructor
    */
@@ -261,6 +276,49 @@ public:
     _hasBeenUpdated = v;
   }
 
+  /** keep the interaction blocks of a linear system between the time
+   * steps (LinearOSNS and the derived problems). The matrix of the
+   * problem is then assembled again only when the index set changes.
+   * The blocks must not depend on the time: time-invariant
+   * dynamical systems and relations, and the iteration matrices of
+   * the integrators only change with the time step (see
+   * TimeStepping::timeStepChanged()).
+   * \param keep true to keep the blocks
+   */
+  void setKeepInteractionBlocks(bool keep)
+  {
+    _keepInteractionBlocks = keep;
+  }
+
+  /** \return true if the interaction blocks are kept */
+  bool keepInteractionBlocks() const
+  {
+    return _keepInteractionBlocks;
+  }
+
+  /** report the changes of the index set of the problem, so that
+   * only the blocks of the activated Interactions are computed when
+   * the blocks are kept
+   * \param activated the Interactions inserted in the index set
+   * \param deactivated the Interactions removed from the index set
+   */
+  void indexSetChanged(const std::vector<SP::Interaction>& activated,
+                       const std::vector<SP::Interaction>& deactivated);
+
+  /** \return true if the changes of the index set since the last
+   * update of the blocks have been reported */
+  bool indexSetChangesReported() const
+  {
+    return _indexSetChangesReported;
+  }
+
+  /** \return the number of diagonal and extra-diagonal blocks computed
+   * since the creation of the problem */
+  unsigned int numberOfComputedBlocks() const
+  {
+    return _numberOfComputedBlocks;
+  }
+
   /** initialize the problem(compute topology ...)
       \param sim the simulation, owner of this OSNSPB
     */
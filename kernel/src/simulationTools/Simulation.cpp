@@ -34,6 +34,7 @@
 #include "Relay.hpp"
 #include "NonSmoothLaw.hpp"
 #include "TypeName.hpp"
+#include "InteractionsGraphSnapshot.hpp"
 // for Debug
 //#define DEBUG_BEGIN_END_ONLY
 // #define DEBUG_NOCOLOR
@@ -49,7 +50,7 @@ Simulation::Simulation(SP::NonSmoothDynamicalSystem nsds, SP::TimeDiscretisation
   _nsds(nsds),
   _numberOfIndexSets(0),
   _tolerance(DEFAULT_TOLERANCE), _printStat(false),
-  _staticLevels(false),_isInitialized(false)
+  _staticLevels(false),_isInitialized(false), _useMemorySlab(false)
 {
   if (!td)
     RuntimeException::selfThrow("Simulation constructor - timeDiscretisation == NULL.");
@@ -77,7 +78,7 @@ Simulation::Simulation(SP::TimeDiscretisation td):
   _tolerance(DEFAULT_TOLERANCE), _printStat(false),
   _staticLevels(false), _useRelativeConvergenceCriterion(false),
   _relativeConvergenceCriterionHeld(false), _relativeConvergenceTol(10e-3),
-  _isInitialized(false)
+  _isInitialized(false), _useMemorySlab(false)
 
 {
   if (!td)
@@ -135,6 +136,8 @@ bool Simulation::hasNextEvent() const
 // clear all maps to break shared_ptr cycle
 void Simulation::clear()
 {
+  // the DS may outlive the simulation
+  unpackMemories();
   if (_allOSI)
   {
     _allOSI->clear();
@@ -165,6 +168,19 @@ SP::InteractionsGraph Simulation::indexSet(unsigned int i)
   return _nsds->topology()->indexSet(i) ;
 }
 
+SP::InteractionsGraphSnapshot Simulation::indexSetSnapshot(unsigned int i)
+{
+  if (_indexSetSnapshots.size() <= i)
+    _indexSetSnapshots.resize(i + 1);
+  if (!_indexSetSnapshots[i])
+    _indexSetSnapshots[i].reset(new InteractionsGraphSnapshot());
+
+  SP::InteractionsGraph graph = indexSet(i);
+  if (!_indexSetSnapshots[i]->isUpToDate(graph))
+    _indexSetSnapshots[i]->freeze(graph);
+  return _indexSetSnapshots[i];
+}
+
 SP::OneStepNSProblem Simulation::oneStepNSProblem(int Id)
 {
   if (!(*_allNSProblems)[Id])
@@ -188,6 +204,9 @@ void Simulation::updateIndexSets()
       updateIndexSet(i);
       _nsds->topology()->indexSet(i)->update_vertices_indices();
       _nsds->topology()->indexSet(i)->update_edges_indices();
+      // the snapshots in use are frozen at the beginning of the step
+      if (i < _indexSetSnapshots.size() && _indexSetSnapshots[i])
+        _indexSetSnapshots[i]->freeze(_nsds->topology()->indexSet(i));
     }
   }
   DEBUG_END("Simulation::updateIndexSets()\n");
@@ -253,6 +272,7 @@ void Simulation::initializeNSDSChangelog()
   NonSmoothDynamicalSystem::ChangeLog::const_iterator& itc = _nsdsChangeLogPosition.it;
 
   bool interactionInitialized = false;
+  bool dsChanged = false;
   itc++;
   while(itc != _nsds->changeLog().end())
   {
@@ -282,6 +302,7 @@ void Simulation::initializeNSDSChangelog()
       }
       OneStepIntegrator& osi = *DSG->properties(DSG->descriptor(ds)).osi;
       osi.initializeWorkVectorsForDS(getTk(),ds);
+      dsChanged = true;
     }
     else if (change.typeOfChange == NonSmoothDynamicalSystem::addInteraction)
     {
@@ -294,10 +315,23 @@ void Simulation::initializeNSDSChangelog()
       // also need to force an update in this case since indexSet1 may
       // still have Interactions that refer to DSs that are not in graph
       interactionInitialized = true;
+
+      // the removed ds must not use the slab anymore
+      if (!_memorySlab.empty())
+      {
+        std::vector<SiconosMemory*> memories;
+        change.ds->collectMemories(memories);
+        for (unsigned int i = 0; i < memories.size(); ++i)
+          memories[i]->releaseStorage();
+      }
+      dsChanged = true;
     }
   }
   _nsdsChangeLogPosition = _nsds->changeLogPosition();
 
+  if (_useMemorySlab && dsChanged)
+    packMemories();
+
   // (re)initialize OneStepNSProblem(s) if necessary
   if (interactionInitialized || !_isInitialized)
   {
@@ -400,6 +434,47 @@ void Simulation::initialize()
   DEBUG_END("Simulation::initialize()\n");
 }
 
+void Simulation::packMemories()
+{
+  DEBUG_BEGIN("Simulation::packMemories()\n");
+  std::vector<SiconosMemory*> memories;
+  DynamicalSystemsGraph& DSG = *_nsds->topology()->dSG(0);
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for (std11::tie(dsi, dsend) = DSG.vertices(); dsi != dsend; ++dsi)
+    DSG.bundle(*dsi)->collectMemories(memories);
+
+  std::vector<double>::size_type slabSize = 0;
+  for (unsigned int i = 0; i < memories.size(); ++i)
+    slabSize += memories[i]->getMemorySize() * memories[i]->vectorSize();
+
+  // values are copied from the previous slab (if any), which is
+  // released only once all the memories have moved.
+  std::vector<double> slab(slabSize);
+  double* storage = slab.empty() ? NULL : &slab[0];
+  for (unsigned int i = 0; i < memories.size(); ++i)
+  {
+    memories[i]->setStorage(storage);
+    storage += memories[i]->getMemorySize() * memories[i]->vectorSize();
+  }
+  _memorySlab.swap(slab);
+  DEBUG_PRINTF("%lu memories stored in a slab of %lu doubles\n", memories.size(), slabSize);
+  DEBUG_END("Simulation::packMemories()\n");
+}
+
+void Simulation::unpackMemories()
+{
+  if (_memorySlab.empty() || !_nsds)
+    return;
+  std::vector<SiconosMemory*> memories;
+  DynamicalSystemsGraph& DSG = *_nsds->topology()->dSG(0);
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for (std11::tie(dsi, dsend) = DSG.vertices(); dsi != dsend; ++dsi)
+    DSG.bundle(*dsi)->collectMemories(memories);
+  for (unsigned int i = 0; i < memories.size(); ++i)
+    memories[i]->releaseStorage();
+  std::vector<double>().swap(_memorySlab);
+}
+
 void Simulation::initializeInteraction(double time, SP::Interaction inter)
 {
   DEBUG_BEGIN("Simulation::initializeInteraction(double time, SP::Interaction inter)\n");
@@ -472,13 +547,15 @@ int Simulation::computeOneStepNSProblem(int Id)
   if (!(*_allNSProblems)[Id])
     RuntimeException::selfThrow("Simulation - computeOneStepNSProblem, OneStepNSProblem == NULL, Id: " + Id);
 
-  // Before compute, inform all OSNSs if topology has changed
+  // Before compute, inform all OSNSs if topology has changed, unless
+  // the changes of their index set have been reported
   if (_nsds->topology()->hasChanged())
   {
     for (OSNSIterator itOsns = _allNSProblems->begin();
          itOsns != _allNSProblems->end(); ++itOsns)
     {
-      (*itOsns)->setHasBeenUpdated(false);
+      if (!(*itOsns)->indexSetChangesReported())
+        (*itOsns)->setHasBeenUpdated(false);
     }
   }
 
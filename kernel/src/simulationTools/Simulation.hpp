@@ -126,6 +126,25 @@ protected:
   /** map of not-yet-initialized DS variables for each OSI */
   std::map< SP::OneStepIntegrator, std::list<SP::DynamicalSystem> >  _OSIDSmap;
 
+  /** if true, the SiconosMemory objects of all the DS are stored
+   * in _memorySlab. Default: false */
+  bool _useMemorySlab;
+
+  /** contiguous storage for the SiconosMemory objects of all the DS */
+  std::vector<double> _memorySlab;
+
+  /** flat copies of the index sets, built on demand by indexSetSnapshot() */
+  std::vector<SP::InteractionsGraphSnapshot> _indexSetSnapshots;
+
+  /** store the SiconosMemory objects of all the DS of the nsds in
+   * _memorySlab, one after the other. Called each time DS are added or
+   * removed, when _useMemorySlab is true. */
+  void packMemories();
+
+  /** give back their own storage to all the SiconosMemory objects
+   * stored in _memorySlab and release it. */
+  void unpackMemories();
+
   /** Call the interaction manager one if is registered, otherwise do nothing. */
   void updateInteractions();
 
@@ -161,7 +180,7 @@ public:
 
   /** default constructor, for serialization
    */
-  Simulation() {};
+  Simulation() : _useMemorySlab(false) {};
 
   /** default constructor
    *  \param nsds current nonsmooth dynamical system
@@ -208,14 +227,14 @@ public:
   }
 
   /** returns time instant k of the time discretisation  */
-  double getTk() const;
+  virtual double getTk() const;
 
   /** get time instant k+1 of the time discretisation
    * \warning: this instant may be different from nextTime(), if for example some
       non-smooth events or some sensor events are present
      \return a double. If the simulation is near the end (t_{k+1} > T), it returns NaN.
    */
-  double getTkp1() const;
+  virtual double getTkp1() const;
 
   /** get time instant k+2 of the time discretisation
    * \warning: this instant may be different from nextTime(), if for example some
@@ -238,13 +257,13 @@ public:
       time of currentEvent of eventsManager.)
       \return a double.
   */
-  double startingTime() const;
+  virtual double startingTime() const;
 
   /** get "next time" (ie ending point for current integration, time
       of nextEvent of eventsManager.)
       \return a double.
   */
-  double nextTime() const;
+  virtual double nextTime() const;
 
   /** get the current time step size ("next time"-"current time")
    *  \return a double.
@@ -287,7 +306,16 @@ public:
       \param i number of the required index set
       \return a graph of interactions
    */
-  SP::InteractionsGraph indexSet(unsigned int i);
+  virtual SP::InteractionsGraph indexSet(unsigned int i);
+
+  /** get a flat copy of indexSets[i], to be used in the loops over
+      its interactions. The copy is frozen again at each update of
+      the index sets and each time the topology of indexSets[i] has
+      changed since the last call.
+      \param i number of the required index set
+      \return the snapshot of the index set
+   */
+  SP::InteractionsGraphSnapshot indexSetSnapshot(unsigned int i);
 
   /** get allNSProblems
    *  \return a pointer to OneStepNSProblems object (container of
@@ -370,6 +398,25 @@ public:
     return _printStat;
   };
 
+  /** store the memories (SiconosMemory) of all the DS in one
+   *  contiguous array owned by the simulation, so that saving states
+   *  in memories at each step walks through a single block of memory.
+   *  Must be called before initialize().
+   *  \param use true to activate
+   */
+  inline void setUseMemorySlab(bool use)
+  {
+    _useMemorySlab = use;
+  };
+
+  /** \return true if the memories of the DS are stored in a
+   *  contiguous array, see setUseMemorySlab()
+   */
+  inline bool useMemorySlab() const
+  {
+    return _useMemorySlab;
+  };
+
   /** update all index sets of the topology, using current y and
       lambda values of Interactions.
    */
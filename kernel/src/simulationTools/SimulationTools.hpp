@@ -27,9 +27,12 @@ Note that not all files from the current location are listed below, since some o
 #include "EventFactory.hpp"
 #include "TimeDiscretisation.hpp"
 #include "TimeStepping.hpp"
+#include "TimeStepController.hpp"
 #include "TimeSteppingD1Minus.hpp"
 #include "TimeSteppingDirectProjection.hpp"
 #include "TimeSteppingCombinedProjection.hpp"
+#include "TimeSteppingMultirate.hpp"
+#include "TimeSteppingBatch.hpp"
 #include "InteractionManager.hpp"
 
 #include "Equality.hpp"
@@ -167,6 +167,17 @@ double TimeDiscretisation::getTk(const unsigned int indx)
     return _tkV.at(indx);
 }
 
+void TimeDiscretisation::setCurrentTimeStep(unsigned int k, double h)
+{
+  if (!_tkV.empty() || _h <= 0.0)
+    RuntimeException::selfThrow("TimeDiscretisation::setCurrentTimeStep must be called only when the TimeDiscretisation is with a constant h");
+  if (h <= 0.0)
+    RuntimeException::selfThrow("TimeDiscretisation::setCurrentTimeStep - the time step must be positive");
+  double tk = getTk(k);
+  _h = h;
+  _t0 = tk - _h*k;
+}
+
 // --- Other functions ---
 void TimeDiscretisation::display() const
 {
@@ -198,6 +198,13 @@ public:
    */
   void setT0(double val);
 
+  /** change the time step from the instant k: t_k is unchanged and
+   *  t_{k+j} = t_k + j h. Only for a constant time step given as a double.
+   *  \param k the index of the instant
+   *  \param h the new time step
+   */
+  void setCurrentTimeStep(unsigned int k, double h);
+
   // --- OTHER FUNCTIONS ---
   /** print the discretisation data to the screen
    */
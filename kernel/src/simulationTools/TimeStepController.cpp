@@ -0,0 +1,114 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "TimeStepController.hpp"
+#include "RuntimeException.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+// #define DEBUG_NOCOLOR
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "debug.h"
+
+TimeStepController::TimeStepController(double hMin, double hMax):
+  _growthMax(2.0), _shrinkFactor(0.5), _safety(0.9),
+  _absoluteTolerance(1e-6), _relativeTolerance(1e-3),
+  _newtonTargetIterations(5), _nonSmoothSolverTargetIterations(0),
+  _maxIndexSetChanges(0),
+  _nbAcceptedSteps(0), _nbRejectedSteps(0), _nbForcedSteps(0),
+  _error(0.0)
+{
+  setTimeStepBounds(hMin, hMax);
+}
+
+void TimeStepController::setTimeStepBounds(double hMin, double hMax)
+{
+  if (hMin <= 0.0 || hMax < hMin)
+    RuntimeException::selfThrow("TimeStepController::setTimeStepBounds - 0 < hMin <= hMax is required");
+  _hMin = hMin;
+  _hMax = hMax;
+}
+
+bool TimeStepController::control(double h, bool converged,
+                                 unsigned int newtonIterations,
+                                 unsigned int nonSmoothSolverIterations,
+                                 unsigned int indexSetChanges,
+                                 double error, double& nextH)
+{
+  DEBUG_PRINTF("TimeStepController::control h = %e, converged = %i, newton = %i, nonsmooth = %i, changes = %i, error = %e\n",
+               h, converged, newtonIterations, nonSmoothSolverIterations, indexSetChanges, error);
+  _error = error;
+  // a step slightly above hMin because of the rounding of the event
+  // times is not computed again
+  bool atMinimum = h <= _hMin * (1.0 + 1e-6);
+
+  if (!converged || error > 1.0)
+  {
+    if (!atMinimum)
+    {
+      _nbRejectedSteps++;
+      double factor = _shrinkFactor;
+      if (converged)
+        factor = std::max(_shrinkFactor * _shrinkFactor, _safety / std::sqrt(error));
+      nextH = std::max(_hMin, h * factor);
+      return false;
+    }
+    _nbForcedSteps++;
+  }
+  _nbAcceptedSteps++;
+
+  double factor = _growthMax;
+  if (converged && error > 0.0)
+    factor = std::min(factor, _safety / std::sqrt(error));
+  if (!converged || newtonIterations > _newtonTargetIterations)
+    factor = std::min(factor, _shrinkFactor);
+  else if (newtonIterations == _newtonTargetIterations)
+    factor = std::min(factor, 1.0);
+  if (_nonSmoothSolverTargetIterations > 0
+      && nonSmoothSolverIterations > _nonSmoothSolverTargetIterations)
+    factor = std::min(factor, std::max(_shrinkFactor, (double)_nonSmoothSolverTargetIterations / nonSmoothSolverIterations));
+  if (indexSetChanges > _maxIndexSetChanges)
+    factor = std::min(factor, _shrinkFactor);
+
+  nextH = std::min(_hMax, std::max(_hMin, h * factor));
+  return true;
+}
+
+void TimeStepController::resetStatistics()
+{
+  _nbAcceptedSteps = 0;
+  _nbRejectedSteps = 0;
+  _nbForcedSteps = 0;
+}
+
+void TimeStepController::display() const
+{
+  std::cout << "====== TimeStepController display ======" <<std::endl;
+  std::cout << "- time step bounds: [" << _hMin << ", " << _hMax << "]" <<std::endl;
+  std::cout << "- growth max: " << _growthMax << ", shrink factor: " << _shrinkFactor
+            << ", safety: " << _safety <<std::endl;
+  std::cout << "- tolerances: atol = " << _absoluteTolerance << ", rtol = " << _relativeTolerance <<std::endl;
+  std::cout << "- target iterations: Newton " << _newtonTargetIterations
+            << ", nonsmooth solver " << _nonSmoothSolverTargetIterations <<std::endl;
+  std::cout << "- accepted steps: " << _nbAcceptedSteps << " (" << _nbForcedSteps << " at hMin)"
+            << ", rejected steps: " << _nbRejectedSteps <<std::endl;
+  std::cout << "===========================================" <<std::endl;
+}
@@ -0,0 +1,256 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file TimeStepController.hpp
+  \brief Adaptive choice of the time step of a TimeStepping simulation.
+*/
+
+#ifndef TimeStepController_H
+#define TimeStepController_H
+
+#include "SiconosFwd.hpp"
+
+/** Adaptive choice of the time step of a TimeStepping simulation.
+
+    After each step, TimeStepping::computeOneStep() gives to control()
+    the measures of the step:
+    - the convergence and the number of iterations of the Newton loop,
+    - the number of iterations of the nonsmooth solver,
+    - the number of Interactions which entered or left the index set 1
+    since the previous step,
+    - a local error estimate, scaled by the tolerances: the difference
+    between the position given by the integrator and the one of an
+    explicit Euler step, \f$ \frac{h}{2} |v_{k+1} - v_k| \f$ by
+    component, divided by \f$ atol + rtol\, h \max(|v_k|, |v_{k+1}|) \f$.
+    It is not used for the steps where the index set changed, since the
+    velocities jump at the impacts.
+
+    The step is rejected (computed again from the state in memory, with
+    a shorter step) when the Newton loop did not converge or when the
+    error is above 1, unless the step is already hMin. Otherwise, the
+    next step grows by at most growthMax, following the error, and
+    shrinks when the Newton loop or the nonsmooth solver needs more
+    iterations than their target, or when the index set changes.
+
+    The TimeDiscretisation of the simulation must have a constant step:
+    its step is changed by the controller.
+*/
+class TimeStepController
+{
+protected:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(TimeStepController);
+
+  /** bounds of the time step */
+  double _hMin;
+  double _hMax;
+
+  /** maximal ratio of two successive steps */
+  double _growthMax;
+
+  /** ratio of two successive steps after a rejection or a change of
+   *  the index set */
+  double _shrinkFactor;
+
+  /** safety factor on the step given by the error estimate */
+  double _safety;
+
+  /** absolute and relative tolerances of the local error estimate,
+   *  not estimated if both are zero */
+  double _absoluteTolerance;
+  double _relativeTolerance;
+
+  /** number of Newton iterations above which the step shrinks */
+  unsigned int _newtonTargetIterations;
+
+  /** number of iterations of the nonsmooth solver above which the step
+   * shrinks, 0 to ignore them */
+  unsigned int _nonSmoothSolverTargetIterations;
+
+  /** number of changes of the index set above which the step shrinks */
+  unsigned int _maxIndexSetChanges;
+
+  /** statistics */
+  unsigned int _nbAcceptedSteps;
+  unsigned int _nbRejectedSteps;
+  unsigned int _nbForcedSteps;
+
+  /** error estimate of the last step */
+  double _error;
+
+  /** default constructor */
+  TimeStepController() {};
+
+public:
+
+  /** constructor
+   * \param hMin the minimal time step
+   * \param hMax the maximal time step
+   */
+  TimeStepController(double hMin, double hMax);
+
+  /** destructor */
+  virtual ~TimeStepController() {};
+
+  /** set the bounds of the time step
+   * \param hMin the minimal time step
+   * \param hMax the maximal time step
+   */
+  void setTimeStepBounds(double hMin, double hMax);
+
+  /** \return the minimal time step */
+  inline double hMin() const
+  {
+    return _hMin;
+  };
+
+  /** \return the maximal time step */
+  inline double hMax() const
+  {
+    return _hMax;
+  };
+
+  /** set the maximal ratio of two successive steps (default 2)
+   * \param growthMax a value greater than 1
+   */
+  inline void setGrowthMax(double growthMax)
+  {
+    _growthMax = growthMax;
+  };
+
+  /** set the ratio of two successive steps after a rejection or a
+   * change of the index set (default 0.5)
+   * \param shrinkFactor a value in (0, 1)
+   */
+  inline void setShrinkFactor(double shrinkFactor)
+  {
+    _shrinkFactor = shrinkFactor;
+  };
+
+  /** set the safety factor on the step given by the error estimate (default 0.9)
+   * \param safety a value in (0, 1]
+   */
+  inline void setSafety(double safety)
+  {
+    _safety = safety;
+  };
+
+  /** set the tolerances of the local error estimate (default 1e-6
+   * and 1e-3). The error is not estimated if both are zero.
+   * \param atol the absolute tolerance
+   * \param rtol the relative tolerance
+   */
+  inline void setTolerances(double atol, double rtol)
+  {
+    _absoluteTolerance = atol;
+    _relativeTolerance = rtol;
+  };
+
+  /** \return the absolute tolerance of the error estimate */
+  inline double absoluteTolerance() const
+  {
+    return _absoluteTolerance;
+  };
+
+  /** \return the relative tolerance of the error estimate */
+  inline double relativeTolerance() const
+  {
+    return _relativeTolerance;
+  };
+
+  /** set the number of Newton iterations above which the step
+   * shrinks (default 5)
+   * \param iterations the target number of iterations
+   */
+  inline void setNewtonTargetIterations(unsigned int iterations)
+  {
+    _newtonTargetIterations = iterations;
+  };
+
+  /** set the number of iterations of the nonsmooth solver above which
+   * the step shrinks (default 0, ignored)
+   * \param iterations the target number of iterations
+   */
+  inline void setNonSmoothSolverTargetIterations(unsigned int iterations)
+  {
+    _nonSmoothSolverTargetIterations = iterations;
+  };
+
+  /** set the number of Interactions entering or leaving the index set
+   * 1 above which the step shrinks (default 0: the step shrinks at each
+   * change)
+   * \param changes the number of changes
+   */
+  inline void setMaxIndexSetChanges(unsigned int changes)
+  {
+    _maxIndexSetChanges = changes;
+  };
+
+  /** decide whether a step is accepted and compute the length of the
+   * next step, or of the step computed again
+   * \param h the length of the step
+   * \param converged false if the Newton loop did not converge
+   * \param newtonIterations the number of Newton iterations of the step
+   * \param nonSmoothSolverIterations the number of iterations of the
+   * nonsmooth solver at the last Newton iteration
+   * \param indexSetChanges the number of Interactions which entered or
+   * left the index set 1 since the previous step
+   * \param error the local error estimate, scaled by the tolerances
+   * \param[out] nextH the length of the next step
+   * \return true if the step is accepted
+   */
+  virtual bool control(double h, bool converged,
+                       unsigned int newtonIterations,
+                       unsigned int nonSmoothSolverIterations,
+                       unsigned int indexSetChanges,
+                       double error, double& nextH);
+
+  /** \return the number of accepted steps */
+  inline unsigned int numberOfAcceptedSteps() const
+  {
+    return _nbAcceptedSteps;
+  };
+
+  /** \return the number of rejected steps */
+  inline unsigned int numberOfRejectedSteps() const
+  {
+    return _nbRejectedSteps;
+  };
+
+  /** \return the number of steps accepted only because the step was
+   * hMin, among the accepted ones */
+  inline unsigned int numberOfForcedSteps() const
+  {
+    return _nbForcedSteps;
+  };
+
+  /** \return the error estimate of the last step */
+  inline double error() const
+  {
+    return _error;
+  };
+
+  /** reset the statistics */
+  void resetStatistics();
+
+  /** print the data to the screen */
+  void display() const;
+};
+
+#endif // TimeStepController_H
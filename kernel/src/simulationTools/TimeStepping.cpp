@@ -35,6 +35,10 @@
 #include "CxxStd.hpp"
 #include "NewtonEulerR.hpp"
 #include "FirstOrderR.hpp"
+#include "InteractionsGraphSnapshot.hpp"
+#include "TimeStepController.hpp"
+#include "LagrangianDS.hpp"
+#include "NewtonEulerDS.hpp"
 
 #include <SiconosConfig.h>
 #if defined(SICONOS_STD_FUNCTIONAL) && !defined(SICONOS_USE_BOOST_FOR_CXX11)
@@ -45,6 +49,10 @@ using namespace std::placeholders;
 #include <boost/weak_ptr.hpp>
 #endif
 
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
 // #define DEBUG_BEGIN_END_ONLY
 // #define DEBUG_STDOUT
 // #define DEBUG_NOCOLOR
@@ -72,7 +80,7 @@ TimeStepping::TimeStepping(SP::NonSmoothDynamicalSystem nsds,
     _isNewtonConverge(false),
     _newtonUpdateInteractionsPerIteration(false),_displayNewtonConvergence(false),
     _warnOnNonConvergence(true),
-    _resetAllLambda(true)
+    _resetAllLambda(true), _lastTimeStep(0.0)
 {
 
   if (osi) insertIntegrator(osi);
@@ -89,7 +97,7 @@ TimeStepping::TimeStepping(SP::NonSmoothDynamicalSystem nsds, SP::TimeDiscretisa
     _isNewtonConverge(false),
     _newtonUpdateInteractionsPerIteration(false),_displayNewtonConvergence(false),
     _warnOnNonConvergence(true),
-    _resetAllLambda(true)
+    _resetAllLambda(true), _lastTimeStep(0.0)
 {
   (*_allNSProblems).resize(nb);
 }
@@ -125,14 +133,32 @@ TimeStepping::~TimeStepping()
 //   return (y<=0);
 // }
 
+/* remove an Interaction and the properties of its edges from an index set */
+static void removeInteractionFromGraph(InteractionsGraph& indexSet, SP::Interaction inter)
+{
+  InteractionsGraph::VDescriptor vd = indexSet.descriptor(inter);
+  indexSet.eraseProperties(vd);
+  InteractionsGraph::OEIterator oei, oeiend;
+  for (std11::tie(oei, oeiend) = indexSet.out_edges(vd);
+       oei != oeiend; ++oei)
+  {
+    InteractionsGraph::EDescriptor ed1, ed2;
+    std11::tie(ed1, ed2) = indexSet.edges(indexSet.source(*oei), indexSet.target(*oei));
+    indexSet.eraseProperties(ed1);
+    if (ed2 != ed1)
+      indexSet.eraseProperties(ed2);
+  }
+  indexSet.remove_vertex(inter);
+}
+
 void TimeStepping::updateIndexSet(unsigned int i)
 {
   // To update IndexSet i: add or remove Interactions from
   // this set, depending on y values.
-  // boost::default_color_type is used to organize update in InteractionsGraph:
-  // - white_color : undiscovered vertex (Interaction)
-  // - gray_color : discovered vertex (Interaction) but searching descendants
-  // - black_color : discovered vertex (Interaction) together with the descendants
+  // The activation rules of the integrators are applied to all the
+  // Interactions of indexSet[0] at once, on flat arrays, then
+  // indexSet[1] is updated in one pass of removals and one pass of
+  // insertions.
 
   assert(_nsds);
   assert(_nsds->topology());
@@ -153,142 +179,121 @@ void TimeStepping::updateIndexSet(unsigned int i)
   assert(indexSet1);
   DynamicalSystemsGraph& DSG0= *nonSmoothDynamicalSystem()->dynamicalSystems();
   topo->setHasChanged(false);
+  _activatedInteractions.clear();
+  _deactivatedInteractions.clear();
 
   DEBUG_PRINTF("TimeStepping::updateIndexSet(unsigned int i). update indexSets start : indexSet0 size : %ld\n", indexSet0->size());
   DEBUG_PRINTF("TimeStepping::updateIndexSet(unsigned int i). update IndexSets start : indexSet1 size : %ld\n", indexSet1->size());
 
-  // Check indexSet1
-  InteractionsGraph::VIterator ui1, ui1end, v1next;
-  std11::tie(ui1, ui1end) = indexSet1->vertices();
+  InteractionsGraphSnapshot& snapshot0 = *indexSetSnapshot(0);
+  unsigned int n0 = snapshot0.size();
 
-  //Remove interactions from the indexSet1
-  for (v1next = ui1; ui1 != ui1end; ui1 = v1next)
-  {
-    ++v1next;
-
-    SP::Interaction inter1 = indexSet1->bundle(*ui1);
-    if (indexSet0->is_vertex(inter1))
-    {
-      InteractionsGraph::VDescriptor inter1_descr0 = indexSet0->descriptor(inter1);
+  // current and required state of each Interaction of indexSet0
+  std::vector<char> inIndexSet1(n0);
+  std::vector<char> active(n0);
 
-      assert((indexSet0->color(inter1_descr0) == boost::white_color));
+  // the Interactions whose activation is decided by an integrator,
+  // grouped by integrator
+  std::vector<OneStepIntegrator*> osis;
+  std::vector<std::vector<unsigned int> > osiVertices;
 
-      indexSet0->color(inter1_descr0) = boost::gray_color;
-      if (Type::value(*(inter1->nonSmoothLaw())) != Type::EqualityConditionNSL)
-      {
-	// We assume that the integrator of the ds1 drive the update of the index set
-        //SP::OneStepIntegrator Osi = indexSet1->properties(*ui1).osi;
-	SP::DynamicalSystem ds1 = indexSet1->properties(*ui1).source;
-	OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
-
-        //if(predictorDeactivate(inter1,i))
-        if (osi.removeInteractionFromIndexSet(inter1, i))
-        {
-          // Interaction is not active
-          // ui1 becomes invalid
-          indexSet0->color(inter1_descr0) = boost::black_color;
-
-          indexSet1->eraseProperties(*ui1);
-
-          InteractionsGraph::OEIterator oei, oeiend;
-          for (std11::tie(oei, oeiend) = indexSet1->out_edges(*ui1);
-               oei != oeiend; ++oei)
-          {
-            InteractionsGraph::EDescriptor ed1, ed2;
-            std11::tie(ed1, ed2) = indexSet1->edges(indexSet1->source(*oei), indexSet1->target(*oei));
-            if (ed2 != ed1)
-            {
-              indexSet1->eraseProperties(ed1);
-              indexSet1->eraseProperties(ed2);
-            }
-            else
-            {
-              indexSet1->eraseProperties(ed1);
-            }
-          }
-          indexSet1->remove_vertex(inter1);
-          /* \warning V.A. 25/05/2012 : Multiplier lambda are only set to zero if they are removed from the IndexSet*/
-          inter1->lambda(1)->zero();
-          topo->setHasChanged(true);
-        }
-      }
-    }
-    else
+  unsigned int nIn = 0;
+  for (unsigned int k = 0; k < n0; ++k)
+  {
+    SP::Interaction inter0 = indexSet0->bundle(snapshot0.vertex(k));
+    inIndexSet1[k] = indexSet1->is_vertex(inter0);
+    nIn += inIndexSet1[k];
+    active[k] = true;
+
+    int nslawType = Type::value(*(inter0->nonSmoothLaw()));
+    if (nslawType == Type::EqualityConditionNSL
+        || (nslawType == Type::RelayNSL && !inIndexSet1[k]))
+      continue;
+
+    // We assume that the integrator of the ds1 drive the update of the index set
+    SP::DynamicalSystem ds1 = indexSet0->properties(snapshot0.vertex(k)).source;
+    OneStepIntegrator* osi = DSG0.properties(DSG0.descriptor(ds1)).osi.get();
+    unsigned int g = 0;
+    while (g < osis.size() && osis[g] != osi)
+      ++g;
+    if (g == osis.size())
     {
-      // Interaction is not in indexSet0 anymore.
-      // ui1 becomes invalid
-      indexSet1->eraseProperties(*ui1);
-      InteractionsGraph::OEIterator oei, oeiend;
-      for (std11::tie(oei, oeiend) = indexSet1->out_edges(*ui1);
-           oei != oeiend; ++oei)
-      {
-        InteractionsGraph::EDescriptor ed1, ed2;
-        std11::tie(ed1, ed2) = indexSet1->edges(indexSet1->source(*oei), indexSet1->target(*oei));
-        if (ed2 != ed1)
-        {
-          indexSet1->eraseProperties(ed1);
-          indexSet1->eraseProperties(ed2);
-        }
-        else
-        {
-          indexSet1->eraseProperties(ed1);
-        }
-      }
-
-      indexSet1->remove_vertex(inter1);
-      topo->setHasChanged(true);
+      osis.push_back(osi);
+      osiVertices.push_back(std::vector<unsigned int>());
     }
+    osiVertices[g].push_back(k);
   }
 
-  // indexSet0\indexSet1 scan
-  InteractionsGraph::VIterator ui0, ui0end;
-  //Add interaction in indexSet1
-  for (std11::tie(ui0, ui0end) = indexSet0->vertices(); ui0 != ui0end; ++ui0)
+  // batched activation rules
+  std::vector<SP::Interaction> interactions;
+  std::vector<char> osiActive;
+  for (unsigned int g = 0; g < osis.size(); ++g)
   {
-    if (indexSet0->color(*ui0) == boost::black_color)
+    const std::vector<unsigned int>& vertices = osiVertices[g];
+    interactions.resize(vertices.size());
+    osiActive.resize(vertices.size());
+    for (unsigned int p = 0; p < vertices.size(); ++p)
     {
-      // reset
-      indexSet0->color(*ui0) = boost::white_color ;
+      interactions[p] = indexSet0->bundle(snapshot0.vertex(vertices[p]));
+      osiActive[p] = inIndexSet1[vertices[p]];
     }
-    else
+    osis[g]->updateInteractionsActivation(interactions, osiActive, i);
+    for (unsigned int p = 0; p < vertices.size(); ++p)
+      active[vertices[p]] = osiActive[p];
+  }
+
+  // Interactions that are not in indexSet0 anymore
+  if (nIn != indexSet1->size())
+  {
+    std::vector<SP::Interaction> removed;
+    InteractionsGraph::VIterator ui1, ui1end;
+    for (std11::tie(ui1, ui1end) = indexSet1->vertices(); ui1 != ui1end; ++ui1)
     {
-      if (indexSet0->color(*ui0) == boost::gray_color)
-      {
-        // reset
-        indexSet0->color(*ui0) = boost::white_color;
+      SP::Interaction inter1 = indexSet1->bundle(*ui1);
+      if (!indexSet0->is_vertex(inter1))
+        removed.push_back(inter1);
+    }
+    for (unsigned int p = 0; p < removed.size(); ++p)
+      removeInteractionFromGraph(*indexSet1, removed[p]);
+    _deactivatedInteractions.insert(_deactivatedInteractions.end(), removed.begin(), removed.end());
+    topo->setHasChanged(true);
+  }
 
-        assert(indexSet1->is_vertex(indexSet0->bundle(*ui0)));
-        /*assert( { !predictorDeactivate(indexSet0->bundle(*ui0),i) ||
-          Type::value(*(indexSet0->bundle(*ui0)->nonSmoothLaw())) == Type::EqualityConditionNSL ;
-          });*/
-      }
-      else
-      {
-        assert(indexSet0->color(*ui0) == boost::white_color);
+  // Remove the deactivated Interactions from indexSet1
+  for (unsigned int k = 0; k < n0; ++k)
+  {
+    if (inIndexSet1[k] && !active[k])
+    {
+      SP::Interaction inter0 = indexSet0->bundle(snapshot0.vertex(k));
+      removeInteractionFromGraph(*indexSet1, inter0);
+      /* \warning V.A. 25/05/2012 : Multiplier lambda are only set to zero if they are removed from the IndexSet*/
+      inter0->lambda(1)->zero();
+      _deactivatedInteractions.push_back(inter0);
+    }
+  }
 
-        SP::Interaction inter0 = indexSet0->bundle(*ui0);
-        assert(!indexSet1->is_vertex(inter0));
-        bool activate = true;
-        if (Type::value(*(inter0->nonSmoothLaw())) != Type::EqualityConditionNSL
-            && Type::value(*(inter0->nonSmoothLaw())) != Type::RelayNSL)
-        {
-          //SP::OneStepIntegrator Osi = indexSet0->properties(*ui0).osi;
-	  // We assume that the integrator of the ds1 drive the update of the index set
-	  SP::DynamicalSystem ds1 = indexSet1->properties(*ui0).source;
-	  OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
+  // Add the activated Interactions in indexSet1
+  for (unsigned int k = 0; k < n0; ++k)
+  {
+    if (!inIndexSet1[k] && active[k])
+    {
+      SP::Interaction inter0 = indexSet0->bundle(snapshot0.vertex(k));
+      assert(!indexSet1->is_vertex(inter0));
 
-          activate = osi.addInteractionInIndexSet(inter0, i);
-        }
-        if (activate)
-        {
-          assert(!indexSet1->is_vertex(inter0));
+      // vertex and edges insertion in indexSet1
+      indexSet1->copy_vertex(inter0, *indexSet0);
+      assert(indexSet1->is_vertex(inter0));
+      _activatedInteractions.push_back(inter0);
+    }
+  }
 
-          // vertex and edges insertion in indexSet1
-          indexSet1->copy_vertex(inter0, *indexSet0);
-          topo->setHasChanged(true);
-          assert(indexSet1->is_vertex(inter0));
-        }
-      }
+  if (!_activatedInteractions.empty() || !_deactivatedInteractions.empty())
+  {
+    topo->setHasChanged(true);
+    for (unsigned int k = 0; k < _allNSProblems->size(); ++k)
+    {
+      if ((*_allNSProblems)[k] && (*_allNSProblems)[k]->indexSetLevel() == i)
+        (*_allNSProblems)[k]->indexSetChanged(_activatedInteractions, _deactivatedInteractions);
     }
   }
 
@@ -365,7 +370,137 @@ void TimeStepping::computeFreeState()
 // the one saved in DS/Interaction at the end of this function
 void TimeStepping::computeOneStep()
 {
-  advanceToEvent();
+  if (!_timeStepController)
+  {
+    advanceToEvent();
+    return;
+  }
+  DEBUG_BEGIN("TimeStepping::computeOneStep()\n");
+  TimeStepController& controller = *_timeStepController;
+
+  // the integrators were initialized with the current step
+  if (_lastTimeStep == 0.0)
+    _lastTimeStep = timeStep();
+  double h = timeStep();
+  if (h < controller.hMin() || h > controller.hMax())
+    _eventsManager->setCurrentTimeStep(std::min(controller.hMax(), std::max(controller.hMin(), h)));
+
+  // changes of the index set at the beginning of the step
+  unsigned int indexSetChanges = _activatedInteractions.size() + _deactivatedInteractions.size();
+
+  bool accepted = false;
+  double nextH = 0.0;
+  while (!accepted)
+  {
+    h = timeStep();
+    if (h != _lastTimeStep)
+    {
+      timeStepChanged();
+      _lastTimeStep = h;
+    }
+
+    advanceToEvent();
+
+    bool converged = _isNewtonConverge || _newtonOptions != SICONOS_TS_NONLINEAR || _nsds->isLinear();
+    // the velocities jump at the impacts: no error estimate there
+    double error = 0.0;
+    if (converged && indexSetChanges == 0)
+      error = localErrorEstimate(h);
+    accepted = controller.control(h, converged, _newtonNbIterations, nonSmoothSolverIterations(),
+                                  indexSetChanges, error, nextH);
+    DEBUG_PRINTF("step [%e, %e], accepted = %i, next step = %e\n", startingTime(), nextTime(), accepted, nextH);
+    if (!accepted)
+    {
+      // back to the beginning of the step
+      _nsds->restoreFromMemory();
+      _eventsManager->setCurrentTimeStep(nextH);
+    }
+  }
+
+  // next step, ending at T rather than just before
+  double remaining = _T - nextTime();
+  if (remaining > 100.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, fabs(_T)))
+  {
+    if (nextH >= remaining)
+      nextH = remaining;
+    else if (remaining - nextH < controller.hMin())
+      nextH = 0.5 * remaining;
+    _eventsManager->setNextTimeStep(nextH);
+  }
+  DEBUG_END("TimeStepping::computeOneStep()\n");
+}
+
+void TimeStepping::timeStepChanged()
+{
+  double tkp1 = getTkp1();
+  for (OSIIterator itosi = _allOSI->begin(); itosi != _allOSI->end(); ++itosi)
+    (*itosi)->timeStepChanged(tkp1);
+  // the matrices of the linear problems depend on W and h
+  for (unsigned int i = 0; i < _allNSProblems->size(); i++)
+  {
+    if ((*_allNSProblems)[i])
+      (*_allNSProblems)[i]->setHasBeenUpdated(false);
+  }
+}
+
+double TimeStepping::localErrorEstimate(double h)
+{
+  double atol = _timeStepController->absoluteTolerance();
+  double rtol = _timeStepController->relativeTolerance();
+  if (atol <= 0.0 && rtol <= 0.0)
+    return 0.0;
+
+  // difference between the position of the integrator and the one of
+  // an explicit Euler step, h/2 |v_{k+1} - v_k|
+  double error = 0.0;
+  DynamicalSystemsGraph& dsg = *_nsds->dynamicalSystems();
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for (std11::tie(dsi, dsend) = dsg.vertices(); dsi != dsend; ++dsi)
+  {
+    DynamicalSystem& ds = *dsg.bundle(*dsi);
+    Type::Siconos dsType = Type::value(ds);
+    const SiconosVector* v = 0;
+    const SiconosMemory* vMemory = 0;
+    if (dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS
+        || dsType == Type::LagrangianLinearDiagonalDS)
+    {
+      LagrangianDS& d = static_cast<LagrangianDS&>(ds);
+      v = d.velocity().get();
+      vMemory = &d.velocityMemory();
+    }
+    else if (dsType == Type::NewtonEulerDS)
+    {
+      NewtonEulerDS& d = static_cast<NewtonEulerDS&>(ds);
+      v = d.twist().get();
+      vMemory = &d.twistMemory();
+    }
+    if (!v || vMemory->nbVectorsInMemory() == 0)
+      continue;
+
+    const SiconosVector& vk = vMemory->getSiconosVector(0);
+    for (unsigned int i = 0; i < v->size(); i++)
+    {
+      double vkp1i = (*v)(i);
+      double vki = vk(i);
+      double scale = atol + rtol * h * std::max(fabs(vki), fabs(vkp1i));
+      if (scale > 0.0)
+        error = std::max(error, 0.5 * h * fabs(vkp1i - vki) / scale);
+    }
+  }
+  return error;
+}
+
+unsigned int TimeStepping::nonSmoothSolverIterations()
+{
+  unsigned int iterations = 0;
+  for (unsigned int i = 0; i < _allNSProblems->size(); i++)
+  {
+    SP::OneStepNSProblem osnsp = (*_allNSProblems)[i];
+    if (osnsp && osnsp->numericsSolverOptions())
+      iterations = std::max(iterations,
+                            (unsigned int) osnsp->numericsSolverOptions()->iparam[SICONOS_IPARAM_ITER_DONE]);
+  }
+  return iterations;
 }
 
 
@@ -425,7 +560,7 @@ void TimeStepping::run()
   std::cout << " ==== Start of " << Type::name(*this) << " simulation - This may take a while ... ====" <<std::endl;
   while (_eventsManager->hasNextEvent())
   {
-    advanceToEvent();
+    computeOneStep();
 
     processEvents();
     count++;
@@ -110,12 +110,43 @@ protected:
    */
   bool _resetAllLambda;
 
+  /** Interactions that entered indexSets[1] at its last update */
+  std::vector<SP::Interaction> _activatedInteractions;
+
+  /** Interactions that left indexSets[1] at its last update */
+  std::vector<SP::Interaction> _deactivatedInteractions;
+
+  /** adaptive control of the time step, none by default */
+  SP::TimeStepController _timeStepController;
+
+  /** length of the last step computed with a TimeStepController */
+  double _lastTimeStep;
+
   /** Default Constructor
    */
   TimeStepping() :
     _computeResiduY(false),
     _computeResiduR(false),
-    _isNewtonConverge(false) {};
+    _isNewtonConverge(false),
+    _lastTimeStep(0.0) {};
+
+  /** tell the integrators and the nonsmooth problems that the length
+   *  of the step changed since the last step
+   */
+  virtual void timeStepChanged();
+
+  /** local error estimate of the step which was just computed, see
+   *  TimeStepController
+   *  \param h the length of the step
+   *  \return the largest error of the components of the velocities,
+   *  scaled by the tolerances of the TimeStepController
+   */
+  double localErrorEstimate(double h);
+
+  /** \return the largest number of iterations done by the solvers of
+   *  the nonsmooth problems at their last call
+   */
+  unsigned int nonSmoothSolverIterations();
 
 
   /** newton algorithm
@@ -157,6 +188,24 @@ public:
    */
   virtual void updateIndexSet(unsigned int i);
 
+  /** get the Interactions that entered indexSets[1] at its last update.
+   *  The changes are reported to the nonsmooth problems of this level,
+   *  see OneStepNSProblem::indexSetChanged()
+   *  \return a vector of Interactions
+   */
+  inline const std::vector<SP::Interaction>& activatedInteractions() const
+  {
+    return _activatedInteractions;
+  };
+
+  /** get the Interactions that left indexSets[1] at its last update
+   *  \return a vector of Interactions
+   */
+  inline const std::vector<SP::Interaction>& deactivatedInteractions() const
+  {
+    return _deactivatedInteractions;
+  };
+
   // /** Used by the updateIndexSet function in order to deactivate SP::Interaction.
   //  */
   // virtual bool predictorDeactivate(SP::Interaction inter, unsigned int i);
@@ -179,10 +228,28 @@ public:
   */
   void advanceToEvent();
 
-  /** run one time--step of the simulation
+  /** run one time--step of the simulation. With a TimeStepController,
+   *  the step is computed again from the state in memory with a shorter
+   *  step until the controller accepts it, and the length of the next
+   *  step is set.
   */
   void computeOneStep();
 
+  /** set the adaptive control of the time step, used by computeOneStep()
+   *  and run(). The TimeDiscretisation must have a constant step.
+   *  \param controller the TimeStepController, none to keep the step
+   */
+  inline void setTimeStepController(SP::TimeStepController controller)
+  {
+    _timeStepController = controller;
+  };
+
+  /** \return the adaptive control of the time step, if any */
+  inline SP::TimeStepController timeStepController() const
+  {
+    return _timeStepController;
+  };
+
 
 
   /** To known the number of steps performed by the Newton algorithm.
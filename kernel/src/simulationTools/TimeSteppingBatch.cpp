@@ -0,0 +1,185 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "TimeSteppingBatch.hpp"
+#include "FrictionContact.hpp"
+#include "OSNSMatrix.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "Topology.hpp"
+#include "SiconosVector.hpp"
+#include "NonSmoothDrivers.h"
+
+// #define DEBUG_NOCOLOR
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "debug.h"
+
+bool TimeSteppingBatch::hasNextEvent() const
+{
+  if (_scenarios.empty())
+    return false;
+  for (unsigned int k = 0; k < _scenarios.size(); ++k)
+  {
+    if (!_scenarios[k]->hasNextEvent())
+      return false;
+  }
+  return true;
+}
+
+std::vector<int> TimeSteppingBatch::solveGroup(std::vector<SP::FrictionContact>& problems)
+{
+  unsigned int nbScenarios = problems.size();
+  std::vector<int> info(nbScenarios, 0);
+  _numberOfSolves++;
+  if (nbScenarios == 1)
+  {
+    info[0] = problems[0]->solve();
+    return info;
+  }
+
+  FrictionContactProblem* problem = problems[0]->frictionContactProblemPtr();
+  unsigned int n = problems[0]->getSizeOutput();
+  unsigned int nc = problem->numberOfContacts;
+  std::vector<double> q(nbScenarios * n), mu(nbScenarios * nc);
+  std::vector<double> reaction(nbScenarios * n), velocity(nbScenarios * n);
+  for (unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    FrictionContact& fc = *problems[k];
+    std::copy(fc.q()->getArray(), fc.q()->getArray() + n, &q[k * n]);
+    std::copy(fc.mu()->begin(), fc.mu()->end(), &mu[k * nc]);
+    std::copy(fc.z()->getArray(), fc.z()->getArray() + n, &reaction[k * n]);
+    std::copy(fc.w()->getArray(), fc.w()->getArray() + n, &velocity[k * n]);
+  }
+
+  DEBUG_PRINTF("TimeSteppingBatch::solveGroup: %i scenarios of size %i\n", nbScenarios, n);
+  fc3d_driver_batch(problem, nbScenarios, &q[0], &mu[0], &reaction[0], &velocity[0],
+                    &*problems[0]->numericsSolverOptions(), &info[0]);
+
+  for (unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    std::copy(&reaction[k * n], &reaction[k * n] + n, problems[k]->z()->getArray());
+    std::copy(&velocity[k * n], &velocity[k * n] + n, problems[k]->w()->getArray());
+  }
+  return info;
+}
+
+void TimeSteppingBatch::advanceToEvent()
+{
+  DEBUG_BEGIN("TimeSteppingBatch::advanceToEvent()\n");
+  unsigned int nbScenarios = _scenarios.size();
+  std::vector<SP::FrictionContact> problems(nbScenarios);
+  std::vector<int> info(nbScenarios, 0);
+  _numberOfSolves = 0;
+
+  // free states and formalization of the problems, as in
+  // TimeStepping::newtonSolve for a linear simulation
+  for (unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    TimeStepping& scenario = *_scenarios[k];
+    if (scenario.timeStepController())
+      RuntimeException::selfThrow("TimeSteppingBatch::advanceToEvent - the adaptive time step is not supported");
+    if (scenario.newtonOptions() == SICONOS_TS_NONLINEAR
+        && !scenario.nonSmoothDynamicalSystem()->isLinear())
+      RuntimeException::selfThrow("TimeSteppingBatch::advanceToEvent - the scenarios must be linear");
+
+    scenario.initialize();
+    scenario.resetLambdas();
+    scenario.initializeNewtonLoop();
+    scenario.prepareNewtonIteration();
+    scenario.computeFreeState();
+
+    if (scenario.numberOfOSNSProblems() == 0)
+      continue;
+    SP::FrictionContact fc = std11::dynamic_pointer_cast<FrictionContact>
+                             (scenario.oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY));
+    if (!fc || fc->getFrictionContactDim() != 3)
+      RuntimeException::selfThrow("TimeSteppingBatch::advanceToEvent - the scenarios must have a 3D FrictionContact problem");
+
+    // see Simulation::computeOneStepNSProblem
+    if (scenario.nonSmoothDynamicalSystem()->topology()->hasChanged())
+    {
+      for (OSNSIterator itOsns = scenario.oneStepNSProblems()->begin();
+           itOsns != scenario.oneStepNSProblems()->end(); ++itOsns)
+        (*itOsns)->setHasBeenUpdated(false);
+    }
+    if (fc->preCompute(scenario.nextTime()) && fc->indexSetLevel() != LEVELMAX
+        && fc->getSizeOutput() != 0)
+    {
+      fc->updateMu();
+      problems[k] = fc;
+    }
+  }
+
+  // one solve for each group of problems with the same M
+  std::vector<bool> solved(nbScenarios, false);
+  for (unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    if (!problems[k] || solved[k])
+      continue;
+    std::vector<SP::FrictionContact> group(1, problems[k]);
+    std::vector<unsigned int> scenarios(1, k);
+    NumericsMatrix* M = &*problems[k]->M()->numericsMatrix();
+    for (unsigned int j = k + 1; j < nbScenarios; ++j)
+    {
+      if (problems[j] && !solved[j]
+          && problems[j]->getSizeOutput() == problems[k]->getSizeOutput()
+          && NM_equal(M, &*problems[j]->M()->numericsMatrix()))
+      {
+        group.push_back(problems[j]);
+        scenarios.push_back(j);
+        solved[j] = true;
+      }
+    }
+    std::vector<int> groupInfo = solveGroup(group);
+    for (unsigned int i = 0; i < group.size(); ++i)
+    {
+      info[scenarios[i]] = groupInfo[i];
+      group[i]->postCompute();
+    }
+  }
+
+  // update, as in TimeStepping::newtonSolve
+  for (unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    TimeStepping& scenario = *_scenarios[k];
+    scenario.DefaultCheckSolverOutput(info[k]);
+    scenario.update();
+    if (scenario.numberOfOSNSProblems() > 0)
+      scenario.saveYandLambdaInOldVariables();
+  }
+  DEBUG_END("TimeSteppingBatch::advanceToEvent()\n");
+}
+
+void TimeSteppingBatch::computeOneStep()
+{
+  advanceToEvent();
+}
+
+void TimeSteppingBatch::nextStep()
+{
+  for (unsigned int k = 0; k < _scenarios.size(); ++k)
+    _scenarios[k]->nextStep();
+}
+
+void TimeSteppingBatch::run()
+{
+  while (hasNextEvent())
+  {
+    computeOneStep();
+    nextStep();
+  }
+}
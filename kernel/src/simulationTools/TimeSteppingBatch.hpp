@@ -0,0 +1,123 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*! \file TimeSteppingBatch.hpp
+  Several Time-Stepping simulations of the same model advanced in lockstep
+*/
+#ifndef TIMESTEPPINGBATCH_H
+#define TIMESTEPPINGBATCH_H
+
+#include "TimeStepping.hpp"
+
+/** Batch of Time-Stepping simulations advanced in lockstep.
+
+    The scenarios of a parameter sweep or of a Monte Carlo study
+    (different friction coefficients, restitution coefficients or initial
+    velocities of the same model) are simulations of their own, built by
+    the user with a 3D FrictionContact problem for
+    SICONOS_OSNSP_TS_VELOCITY and the same time discretisation.
+
+    At each step, every scenario computes its free state and formalizes
+    its friction-contact problem. The scenarios whose problems have the
+    same matrix M (same active contacts and same iteration matrices) are
+    then solved in a single call to fc3d_driver_batch, in parallel when
+    the solver allows it, with the solver options of the first of them.
+    The other ones are solved on their own. The scenarios are finally
+    updated as TimeStepping does.
+
+    Only the one-step nonsmooth problem is shared: the scenarios must be
+    linear (one Newton iteration, see TimeStepping::setNewtonOptions()),
+    and the output of the solver is checked with
+    TimeStepping::DefaultCheckSolverOutput().
+ */
+class TimeSteppingBatch
+{
+protected:
+  /** serialization hooks
+   */
+  ACCEPT_SERIALIZATION(TimeSteppingBatch);
+
+  /** the scenarios */
+  std::vector<SP::TimeStepping> _scenarios;
+
+  /** number of calls to the numerics driver during the last step */
+  unsigned int _numberOfSolves;
+
+  /** solve the friction-contact problems of a group of scenarios
+   * sharing the same matrix M
+   * \param problems the problems, the first one gives M and the options
+   * \return the output of the solver, for each problem
+   */
+  std::vector<int> solveGroup(std::vector<SP::FrictionContact>& problems);
+
+public:
+
+  /** default constructor: no scenario
+   */
+  TimeSteppingBatch(): _numberOfSolves(0) {};
+
+  /** constructor
+   * \param scenarios the simulations, initialized or not
+   */
+  TimeSteppingBatch(const std::vector<SP::TimeStepping>& scenarios):
+    _scenarios(scenarios), _numberOfSolves(0) {};
+
+  virtual ~TimeSteppingBatch() {};
+
+  /** add a scenario
+   * \param scenario the simulation
+   */
+  inline void insertScenario(SP::TimeStepping scenario)
+  {
+    _scenarios.push_back(scenario);
+  };
+
+  /** \return the scenarios */
+  inline const std::vector<SP::TimeStepping>& scenarios() const
+  {
+    return _scenarios;
+  };
+
+  /** \return the number of calls to the numerics driver during the
+   * last step, one for each group of scenarios sharing M
+   */
+  inline unsigned int numberOfSolves() const
+  {
+    return _numberOfSolves;
+  };
+
+  /** \return true if all the scenarios have a next event */
+  bool hasNextEvent() const;
+
+  /** integrate all the scenarios from their current event to the next
+   * one
+   */
+  void advanceToEvent();
+
+  /** one step of all the scenarios, see TimeStepping::computeOneStep() */
+  void computeOneStep();
+
+  /** go to the next time step of all the scenarios */
+  void nextStep();
+
+  /** run all the scenarios until the end of their time discretisation */
+  void run();
+};
+
+DEFINE_SPTR(TimeSteppingBatch)
+
+#endif // TIMESTEPPINGBATCH_H
@@ -0,0 +1,472 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "TimeSteppingMultirate.hpp"
+#include "LagrangianDS.hpp"
+#include "NewtonEulerDS.hpp"
+#include "Interaction.hpp"
+#include "OneStepIntegrator.hpp"
+#include "OneStepNSProblem.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "Topology.hpp"
+
+#include <algorithm>
+
+// #define DEBUG_NOCOLOR
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "debug.h"
+
+TimeSteppingMultirate::TimeSteppingMultirate(SP::NonSmoothDynamicalSystem nsds,
+                                             SP::TimeDiscretisation td,
+                                             SP::OneStepIntegrator osi,
+                                             SP::OneStepNSProblem osnspb)
+  : TimeStepping(nsds, td, osi, osnspb),
+    _activePartition(0), _subStepStart(0.0), _subStepEnd(0.0)
+{
+}
+
+void TimeSteppingMultirate::setSubStepsNonSmoothProblem(SP::OneStepNSProblem osnspb,
+                                                        unsigned int subSteps)
+{
+  if (subSteps < 2)
+    RuntimeException::selfThrow("TimeSteppingMultirate::setSubStepsNonSmoothProblem - the problem of the integrators without sub-steps is set with insertNonSmoothProblem()");
+  _subStepsNSProblems[subSteps] = osnspb;
+  // the problems of the partition are set again at the next step
+  std::map<unsigned int, Partition>::iterator it = _partitions.find(subSteps);
+  if (it != _partitions.end())
+    it->second.nsProblems.reset();
+}
+
+void TimeSteppingMultirate::initOSNS()
+{
+  TimeStepping::initOSNS();
+
+  std::map<unsigned int, SP::OneStepNSProblem>::iterator it;
+  for (it = _subStepsNSProblems.begin(); it != _subStepsNSProblems.end(); ++it)
+  {
+    if (!it->second)
+      continue;
+
+    // the integrators with these sub-steps set the levels of the problem
+    SP::OneStepNSProblems allNSProblems = _allNSProblems;
+    _allNSProblems.reset(new OneStepNSProblems(SICONOS_OSNSP_TS_VELOCITY + 1));
+    (*_allNSProblems)[SICONOS_OSNSP_TS_VELOCITY] = it->second;
+    try
+    {
+      for (OSIIterator itosi = _allOSI->begin(); itosi != _allOSI->end(); ++itosi)
+      {
+        if ((*itosi)->subSteps() == it->first)
+          (*itosi)->initialize_nonsmooth_problems();
+      }
+    }
+    catch (...)
+    {
+      _allNSProblems = allNSProblems;
+      throw;
+    }
+    _allNSProblems = allNSProblems;
+
+    it->second->initialize(shared_from_this());
+  }
+}
+
+double TimeSteppingMultirate::getTk() const
+{
+  return _activePartition ? _subStepStart : TimeStepping::getTk();
+}
+
+double TimeSteppingMultirate::getTkp1() const
+{
+  return _activePartition ? _subStepEnd : TimeStepping::getTkp1();
+}
+
+double TimeSteppingMultirate::startingTime() const
+{
+  return _activePartition ? _subStepStart : TimeStepping::startingTime();
+}
+
+double TimeSteppingMultirate::nextTime() const
+{
+  return _activePartition ? _subStepEnd : TimeStepping::nextTime();
+}
+
+SP::InteractionsGraph TimeSteppingMultirate::indexSet(unsigned int i)
+{
+  if (_activePartition && i < _activePartition->indexSets.size())
+    return _activePartition->indexSets[i];
+  return TimeStepping::indexSet(i);
+}
+
+void TimeSteppingMultirate::timeStepChanged()
+{
+  TimeStepping::timeStepChanged();
+  std::map<unsigned int, Partition>::iterator it;
+  for (it = _partitions.begin(); it != _partitions.end(); ++it)
+    it->second.lastTimeStep = 0.0;
+}
+
+void TimeSteppingMultirate::updatePartitions()
+{
+  std::map<unsigned int, Partition>::iterator it;
+  for (it = _partitions.begin(); it != _partitions.end(); ++it)
+  {
+    it->second.osi.reset(new OSISet());
+    it->second.dynamicalSystems.clear();
+  }
+
+  for (OSIIterator itosi = _allOSI->begin(); itosi != _allOSI->end(); ++itosi)
+  {
+    unsigned int subSteps = (*itosi)->subSteps();
+    Partition& partition = _partitions[subSteps];
+    partition.subSteps = subSteps;
+    if (!partition.osi)
+      partition.osi.reset(new OSISet());
+    partition.osi->insert(*itosi);
+  }
+
+  for (it = _partitions.begin(); it != _partitions.end();)
+  {
+    if (it->second.osi->empty())
+      _partitions.erase(it++);
+    else
+      ++it;
+  }
+
+  DynamicalSystemsGraph& DSG = *_nsds->topology()->dSG(0);
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for (std11::tie(dsi, dsend) = DSG.vertices(); dsi != dsend; ++dsi)
+  {
+    SP::OneStepIntegrator osi = DSG.properties(*dsi).osi;
+    if (osi)
+      _partitions[osi->subSteps()].dynamicalSystems.push_back(DSG.bundle(*dsi));
+  }
+
+  for (it = _partitions.begin(); it != _partitions.end(); ++it)
+  {
+    Partition& partition = it->second;
+    if (partition.subSteps == 1)
+      partition.nsProblems = _allNSProblems;
+    else if (!partition.nsProblems)
+    {
+      partition.nsProblems.reset(new OneStepNSProblems());
+      std::map<unsigned int, SP::OneStepNSProblem>::iterator itosns =
+        _subStepsNSProblems.find(partition.subSteps);
+      if (itosns != _subStepsNSProblems.end() && itosns->second)
+      {
+        partition.nsProblems->resize(SICONOS_OSNSP_TS_VELOCITY + 1);
+        (*partition.nsProblems)[SICONOS_OSNSP_TS_VELOCITY] = itosns->second;
+      }
+    }
+  }
+}
+
+void TimeSteppingMultirate::updatePartitionIndexSets(Partition& partition)
+{
+  SP::Topology topo = _nsds->topology();
+  DynamicalSystemsGraph& DSG = *topo->dSG(0);
+  unsigned int nindexsets = topo->indexSetsSize();
+  partition.indexSets.resize(nindexsets);
+  partition.topologyIndexSets.resize(nindexsets);
+  partition.topologyStamps.resize(nindexsets, -1);
+
+  bool changed = false;
+  for (unsigned int i = 0; i < nindexsets; ++i)
+  {
+    SP::InteractionsGraph topoIndexSet = topo->indexSet(i);
+    if (partition.indexSets[i]
+        && partition.topologyIndexSets[i] == topoIndexSet
+        && partition.topologyStamps[i] == topoIndexSet->stamp())
+      continue;
+
+    SP::InteractionsGraph indexSet(new InteractionsGraph());
+    indexSet->properties().symmetric = topoIndexSet->properties().symmetric;
+    if (i == 0)
+    {
+      partition.crossRateInteractions.clear();
+      partition.prescribedDS.clear();
+    }
+    InteractionsGraph::VIterator ui, uiend;
+    for (std11::tie(ui, uiend) = topoIndexSet->vertices(); ui != uiend; ++ui)
+    {
+      SP::DynamicalSystem ds1 = topoIndexSet->properties(*ui).source;
+      SP::DynamicalSystem ds2 = topoIndexSet->properties(*ui).target;
+      SP::OneStepIntegrator osi1 = DSG.properties(DSG.descriptor(ds1)).osi;
+      SP::OneStepIntegrator osi2 = DSG.properties(DSG.descriptor(ds2)).osi;
+      // an Interaction between two partitions belongs to the faster one
+      if (std::max(osi1->subSteps(), osi2->subSteps()) != partition.subSteps)
+        continue;
+      SP::Interaction inter = topoIndexSet->bundle(*ui);
+      indexSet->copy_vertex(inter, *topoIndexSet);
+      if (i == 0 && osi1->subSteps() != osi2->subSteps())
+      {
+        partition.crossRateInteractions.push_back(inter);
+        SP::DynamicalSystem ds = (osi1->subSteps() < osi2->subSteps()) ? ds1 : ds2;
+        if (std::find(partition.prescribedDS.begin(), partition.prescribedDS.end(), ds)
+            == partition.prescribedDS.end())
+          partition.prescribedDS.push_back(ds);
+      }
+    }
+
+    // the Interactions sharing only a dynamical system of a slower
+    // partition are not coupled in the nonsmooth problem
+    std::vector<InteractionsGraph::EDescriptor> uncoupled;
+    InteractionsGraph::EIterator ei, eiend;
+    for (std11::tie(ei, eiend) = indexSet->edges(); ei != eiend; ++ei)
+    {
+      SP::DynamicalSystem ds = indexSet->bundle(*ei);
+      if (!partition.osi->count(DSG.properties(DSG.descriptor(ds)).osi))
+        uncoupled.push_back(*ei);
+    }
+    for (unsigned int k = 0; k < uncoupled.size(); ++k)
+      indexSet->remove_edge(uncoupled[k]);
+    indexSet->update_vertices_indices();
+    indexSet->update_edges_indices();
+
+    // the nonsmooth problems are built again only if the Interactions changed
+    SP::InteractionsGraph previous = partition.indexSets[i];
+    if (!previous || previous->size() != indexSet->size())
+      changed = true;
+    else
+    {
+      for (std11::tie(ui, uiend) = indexSet->vertices(); ui != uiend && !changed; ++ui)
+        changed = !previous->is_vertex(indexSet->bundle(*ui));
+    }
+
+    partition.indexSets[i] = indexSet;
+    partition.topologyIndexSets[i] = topoIndexSet;
+    partition.topologyStamps[i] = topoIndexSet->stamp();
+  }
+
+  if (changed)
+  {
+    for (unsigned int i = 0; i < partition.nsProblems->size(); i++)
+    {
+      if ((*partition.nsProblems)[i])
+        (*partition.nsProblems)[i]->setHasBeenUpdated(false);
+    }
+  }
+}
+
+void TimeSteppingMultirate::integratePartition(Partition& partition, double tk, double tkp1)
+{
+  DEBUG_BEGIN("TimeSteppingMultirate::integratePartition(Partition& partition, double tk, double tkp1)\n");
+  DEBUG_PRINTF("subSteps = %i\n", partition.subSteps);
+  SP::OSISet allOSI = _allOSI;
+  SP::OneStepNSProblems allNSProblems = _allNSProblems;
+  _allOSI = partition.osi;
+  _allNSProblems = partition.nsProblems;
+  _activePartition = &partition;
+
+  try
+  {
+    DynamicalSystemsGraph& DSG = *_nsds->topology()->dSG(0);
+    unsigned int m = partition.subSteps;
+    double h = (tkp1 - tk) / m;
+    partition.crossRateImpulses.clear();
+    for (unsigned int j = 0; j < m; ++j)
+    {
+      _subStepStart = tk + j * h;
+      _subStepEnd = (j + 1 == m) ? tkp1 : tk + (j + 1) * h;
+
+      if (j > 0)
+      {
+        // end of the previous sub-step
+        for (unsigned int k = 0; k < partition.dynamicalSystems.size(); ++k)
+          partition.dynamicalSystems[k]->swapInMemory();
+        InteractionsGraph::VIterator ui, uiend;
+        SP::InteractionsGraph indexSet0 = partition.indexSets[0];
+        for (std11::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+          indexSet0->bundle(*ui)->swapInMemory();
+        // on the index sets of the topology
+        _activePartition = 0;
+        updateIndexSets();
+        _activePartition = &partition;
+      }
+      updatePartitionIndexSets(partition);
+
+      if (m > 1 && _allNSProblems->empty() && partition.indexSets[0]->size() > 0)
+        RuntimeException::selfThrow("TimeSteppingMultirate::integratePartition - no nonsmooth problem for the Interactions of the integrators with sub-steps, see setSubStepsNonSmoothProblem()");
+
+      // the iteration matrices were computed with the step of the
+      // simulation if lastTimeStep is 0
+      double previousTimeStep = (partition.lastTimeStep > 0.0) ? partition.lastTimeStep : tkp1 - tk;
+      if (h != previousTimeStep)
+      {
+        for (OSIIterator itosi = _allOSI->begin(); itosi != _allOSI->end(); ++itosi)
+          (*itosi)->timeStepChanged(_subStepEnd);
+        for (unsigned int i = 0; i < _allNSProblems->size(); i++)
+        {
+          if ((*_allNSProblems)[i])
+            (*_allNSProblems)[i]->setHasBeenUpdated(false);
+        }
+        partition.lastTimeStep = h;
+      }
+
+      // the multipliers of the Interactions with the slower partitions
+      // are summed over the sub-steps: start each sub-step from zero
+      // (at the first one, they hold the impulses of the last step)
+      for (unsigned int k = 0; k < partition.crossRateInteractions.size(); ++k)
+        partition.crossRateInteractions[k]->resetAllLambda();
+
+      interpolateIntegratedStates((double)(j + 1) / m);
+      for (unsigned int k = 0; k < partition.prescribedDS.size(); ++k)
+      {
+        SP::DynamicalSystem ds = partition.prescribedDS[k];
+        DSG.properties(DSG.descriptor(ds)).osi->prescribeFreeState(ds);
+      }
+      newtonSolve(_newtonTolerance, _newtonMaxIteration);
+
+      for (unsigned int k = 0; k < partition.crossRateInteractions.size(); ++k)
+      {
+        SP::Interaction inter = partition.crossRateInteractions[k];
+        VectorOfVectors& impulses = partition.crossRateImpulses[inter];
+        impulses.resize(inter->upperLevelForInput() + 1);
+        for (unsigned int level = inter->lowerLevelForInput();
+             level <= inter->upperLevelForInput(); ++level)
+        {
+          if (!impulses[level])
+            impulses[level].reset(new SiconosVector(*inter->lambda(level)));
+          else
+            *impulses[level] += *inter->lambda(level);
+        }
+      }
+    }
+  }
+  catch (...)
+  {
+    _allOSI = allOSI;
+    _allNSProblems = allNSProblems;
+    _activePartition = 0;
+    throw;
+  }
+
+  _allOSI = allOSI;
+  _allNSProblems = allNSProblems;
+  _activePartition = 0;
+  DEBUG_END("TimeSteppingMultirate::integratePartition(Partition& partition, double tk, double tkp1)\n");
+}
+
+void TimeSteppingMultirate::saveIntegratedStates(Partition& partition)
+{
+  for (unsigned int k = 0; k < partition.dynamicalSystems.size(); ++k)
+  {
+    SP::DynamicalSystem ds = partition.dynamicalSystems[k];
+    SP::LagrangianDS lds = std11::dynamic_pointer_cast<LagrangianDS>(ds);
+    SP::NewtonEulerDS neds = std11::dynamic_pointer_cast<NewtonEulerDS>(ds);
+    _integratedDS.push_back(ds);
+    if (lds)
+    {
+      _integratedPositions.push_back(SP::SiconosVector(new SiconosVector(*lds->q())));
+      _integratedVelocities.push_back(SP::SiconosVector(new SiconosVector(*lds->velocity())));
+    }
+    else if (neds)
+    {
+      _integratedPositions.push_back(SP::SiconosVector(new SiconosVector(*neds->q())));
+      _integratedVelocities.push_back(SP::SiconosVector(new SiconosVector(*neds->twist())));
+    }
+    else
+    {
+      _integratedPositions.push_back(SP::SiconosVector(new SiconosVector(*ds->x())));
+      _integratedVelocities.push_back(SP::SiconosVector());
+    }
+  }
+}
+
+/* x = (1 - s) x_k + s x_{k+1} */
+static void interpolate(double s, const SiconosVector& xk, const SiconosVector& xkp1,
+                        SiconosVector& x)
+{
+  if (s >= 1.0)
+    x = xkp1;
+  else
+  {
+    scal(1.0 - s, xk, x, true);
+    axpy(s, xkp1, x);
+  }
+}
+
+void TimeSteppingMultirate::interpolateIntegratedStates(double s)
+{
+  for (unsigned int k = 0; k < _integratedDS.size(); ++k)
+  {
+    SP::DynamicalSystem ds = _integratedDS[k];
+    SP::LagrangianDS lds = std11::dynamic_pointer_cast<LagrangianDS>(ds);
+    SP::NewtonEulerDS neds = std11::dynamic_pointer_cast<NewtonEulerDS>(ds);
+    if (lds)
+    {
+      interpolate(s, lds->qMemory().getSiconosVector(0), *_integratedPositions[k], *lds->q());
+      interpolate(s, lds->velocityMemory().getSiconosVector(0), *_integratedVelocities[k], *lds->velocity());
+    }
+    else if (neds)
+    {
+      interpolate(s, neds->qMemory().getSiconosVector(0), *_integratedPositions[k], *neds->q());
+      interpolate(s, neds->twistMemory().getSiconosVector(0), *_integratedVelocities[k], *neds->twist());
+      if (s < 1.0)
+        neds->normalizeq();
+    }
+    else
+      interpolate(s, ds->xMemory().getSiconosVector(0), *_integratedPositions[k], *ds->x());
+  }
+}
+
+void TimeSteppingMultirate::advanceToEvent()
+{
+  DEBUG_PRINTF("TimeSteppingMultirate::advanceToEvent(). Time =%f\n", getTkp1());
+  initialize();
+  resetLambdas();
+  updatePartitions();
+
+  if (_timeStepController && !_partitions.empty() && _partitions.rbegin()->first > 1)
+    RuntimeException::selfThrow("TimeSteppingMultirate::advanceToEvent - the adaptive time step is not supported with sub-steps");
+
+  // the dynamical systems of the slower partitions get the impulses of
+  // their Interactions with the faster ones over the last step
+  std::map<unsigned int, Partition>::iterator it;
+  for (it = _partitions.begin(); it != _partitions.end(); ++it)
+  {
+    std::map<SP::Interaction, VectorOfVectors>::iterator itimp;
+    for (itimp = it->second.crossRateImpulses.begin();
+         itimp != it->second.crossRateImpulses.end(); ++itimp)
+    {
+      VectorOfVectors& impulses = itimp->second;
+      for (unsigned int level = 0; level < impulses.size(); ++level)
+      {
+        if (impulses[level])
+          *itimp->first->lambda(level) = *impulses[level];
+      }
+    }
+  }
+
+  double tk = getTk();
+  double tkp1 = getTkp1();
+  _integratedDS.clear();
+  _integratedPositions.clear();
+  _integratedVelocities.clear();
+
+  // from the slowest partition to the fastest one
+  for (it = _partitions.begin(); it != _partitions.end(); ++it)
+  {
+    integratePartition(it->second, tk, tkp1);
+    saveIntegratedStates(it->second);
+  }
+
+  _integratedDS.clear();
+  _integratedPositions.clear();
+  _integratedVelocities.clear();
+}
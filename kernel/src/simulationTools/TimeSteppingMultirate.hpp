@@ -0,0 +1,239 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*! \file TimeSteppingMultirate.hpp
+  Time-Stepping simulation in which the integrators have their own step
+*/
+#ifndef TIMESTEPPINGMULTIRATE_H
+#define TIMESTEPPINGMULTIRATE_H
+
+#include "TimeStepping.hpp"
+#include <map>
+
+/** Multirate Time-Stepping scheme.
+
+    The dynamical systems are split by the number of sub-steps of their
+    OneStepIntegrator (see OneStepIntegrator::setSubSteps()): during a
+    step [t_k, t_{k+1}] of the simulation, the integrators with n
+    sub-steps do n steps of length (t_{k+1} - t_k) / n.
+
+    The partitions are integrated one after the other, from the
+    slowest one (fewest sub-steps) to the fastest one. Each of them runs
+    the Newton loop of TimeStepping on its own integrators and on the
+    Interactions between its dynamical systems, with its own nonsmooth
+    problem:
+    - the partition of the integrators without sub-steps uses the
+      nonsmooth problems of the simulation (insertNonSmoothProblem()),
+    - a partition with n sub-steps uses the problem given by
+      setSubStepsNonSmoothProblem(), solved at each sub-step.
+
+    The coupling between the partitions goes through the states of the
+    dynamical systems read by the other ones (plug-ins, controls):
+    while a partition is integrated, the dynamical systems of the
+    slower partitions, already at t_{k+1}, are interpolated linearly
+    between their states at t_k and t_{k+1} at the end of each sub-step,
+    and the ones of the faster partitions keep their state at t_k
+    (extrapolation of order 0). All the systems are at t_{k+1} at the
+    end of the step.
+
+    An Interaction between the dynamical systems of two partitions
+    belongs to the faster one, and its problem is solved at each
+    sub-step with the motion of the slower dynamical system prescribed:
+    its interpolated state gives the output of the Interaction, and its
+    free velocity is its interpolated velocity (see
+    OneStepIntegrator::prescribeFreeState(), implemented by
+    MoreauJeanOSI). The multipliers of the Interaction are summed over
+    the sub-steps and applied to the slower dynamical system at the next
+    step, as fixed multipliers (the reaction is delayed by one step).
+    Both integrators must be of the same type.
+
+    The index sets are updated between the sub-steps, and the states of
+    the fast dynamical systems and Interactions are saved in memory at
+    each sub-step. Hence a step with sub-steps cannot be computed again
+    from the memory: the adaptive time step of TimeStepping (see
+    setTimeStepController()) is not supported with sub-steps.
+ */
+class TimeSteppingMultirate : public TimeStepping
+{
+protected:
+  /** serialization hooks
+   */
+  ACCEPT_SERIALIZATION(TimeSteppingMultirate);
+
+  /** the integrators with the same number of sub-steps, and the
+   * Interactions of their dynamical systems
+   */
+  struct Partition
+  {
+    /** number of sub-steps */
+    unsigned int subSteps;
+
+    /** the integrators */
+    SP::OSISet osi;
+
+    /** the dynamical systems of the integrators */
+    std::vector<SP::DynamicalSystem> dynamicalSystems;
+
+    /** the Interactions between the dynamical systems of the
+     *  partition and of slower partitions */
+    std::vector<SP::Interaction> crossRateInteractions;
+
+    /** the dynamical systems of the slower partitions in these
+     *  Interactions, with a prescribed motion */
+    std::vector<SP::DynamicalSystem> prescribedDS;
+
+    /** the sum of the multipliers of these Interactions over the
+     *  sub-steps of the last step, by level */
+    std::map<SP::Interaction, VectorOfVectors> crossRateImpulses;
+
+    /** the nonsmooth problems, used in place of the ones of the
+     *  simulation while the partition is integrated */
+    SP::OneStepNSProblems nsProblems;
+
+    /** the index sets of the topology restricted to the Interactions
+     *  of the partition */
+    std::vector<SP::InteractionsGraph> indexSets;
+
+    /** the index sets of the topology and their stamps when indexSets
+     *  were built */
+    std::vector<SP::InteractionsGraph> topologyIndexSets;
+    std::vector<int> topologyStamps;
+
+    /** length of the last sub-step, 0 if the iteration matrices of
+     *  the integrators were computed with the step of the simulation */
+    double lastTimeStep;
+
+    Partition(): subSteps(1), lastTimeStep(0.0) {};
+  };
+
+  /** the partitions, by number of sub-steps */
+  std::map<unsigned int, Partition> _partitions;
+
+  /** the nonsmooth problems of the partitions with sub-steps, by
+   * number of sub-steps */
+  std::map<unsigned int, SP::OneStepNSProblem> _subStepsNSProblems;
+
+  /** the partition being integrated, none between the steps */
+  Partition* _activePartition;
+
+  /** bounds of the sub-step being computed */
+  double _subStepStart;
+  double _subStepEnd;
+
+  /** the dynamical systems of the partitions integrated in the current
+   * step, with their position and velocity (or state x) at t_{k+1} */
+  std::vector<SP::DynamicalSystem> _integratedDS;
+  std::vector<SP::SiconosVector> _integratedPositions;
+  std::vector<SP::SiconosVector> _integratedVelocities;
+
+  /** sort the integrators and their nonsmooth problems by number of
+   * sub-steps */
+  void updatePartitions();
+
+  /** restrict the index sets of the topology to the Interactions of a
+   * partition and with the slower partitions, if they changed since
+   * the last call
+   * \param partition the partition
+   */
+  void updatePartitionIndexSets(Partition& partition);
+
+  /** integrate a partition over the current step
+   * \param partition the partition
+   * \param tk the beginning of the step
+   * \param tkp1 the end of the step
+   */
+  void integratePartition(Partition& partition, double tk, double tkp1);
+
+  /** save the states at t_{k+1} of the dynamical systems of a partition
+   * \param partition the partition which was integrated
+   */
+  void saveIntegratedStates(Partition& partition);
+
+  /** set the states of the dynamical systems of the integrated
+   * partitions between t_k and t_{k+1}
+   * \param s the position in the step, 0 for t_k and 1 for t_{k+1}
+   */
+  void interpolateIntegratedStates(double s);
+
+  /** the iteration matrices of all the integrators were computed
+   * again with the step of the simulation
+   */
+  virtual void timeStepChanged();
+
+  /** default constructor
+   */
+  TimeSteppingMultirate(): _activePartition(0) {};
+
+public:
+
+  /** Standard constructor
+   * \param nsds NonSmoothDynamicalSystem to be simulated
+   * \param td pointer to a timeDiscretisation used in the integration
+   * \param osi one step integrator (default none)
+   * \param osnspb one step non smooth problem of the integrators
+   * without sub-steps (default none)
+   */
+  TimeSteppingMultirate(SP::NonSmoothDynamicalSystem nsds, SP::TimeDiscretisation td,
+                        SP::OneStepIntegrator osi = SP::OneStepIntegrator(),
+                        SP::OneStepNSProblem osnspb = SP::OneStepNSProblem());
+
+  virtual ~TimeSteppingMultirate() {};
+
+  /** set the nonsmooth problem of the Interactions between the
+   *  dynamical systems of the integrators with n sub-steps
+   *  \param osnspb the one step non smooth problem
+   *  \param subSteps the number n of sub-steps, greater than 1
+   */
+  void setSubStepsNonSmoothProblem(SP::OneStepNSProblem osnspb, unsigned int subSteps);
+
+  /** initialisation of the nonsmooth problems of the simulation and of
+   * the partitions
+   */
+  virtual void initOSNS();
+
+  /** \return the beginning of the current sub-step, or of the step */
+  virtual double getTk() const;
+
+  /** \return the end of the current sub-step, or getTkp1() of the
+   * time discretisation */
+  virtual double getTkp1() const;
+
+  /** \return the beginning of the current sub-step, or of the step */
+  virtual double startingTime() const;
+
+  /** \return the end of the current sub-step, or of the step */
+  virtual double nextTime() const;
+
+  /** get indexSets[i], restricted to the Interactions of the
+   * partition being integrated
+   * \param i number of the required index set
+   * \return a graph of interactions
+   */
+  virtual SP::InteractionsGraph indexSet(unsigned int i);
+
+  /** integrate the partitions from the current event to the next one
+   */
+  void advanceToEvent();
+
+  /** visitors hook
+   */
+  ACCEPT_STD_VISITORS();
+};
+
+DEFINE_SPTR(TimeSteppingMultirate)
+
+#endif // TIMESTEPPINGMULTIRATE_H
@@ -0,0 +1,129 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "InteractionsGraphSnapshotTest.hpp"
+#include "InteractionsGraphSnapshot.hpp"
+#include "Interaction.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(InteractionsGraphSnapshotTest);
+
+
+void InteractionsGraphSnapshotTest::setUp()
+{
+  _graph.reset(new InteractionsGraph());
+  SP::SiconosVector q0(new SiconosVector(1));
+  SP::SiconosVector v0(new SiconosVector(1));
+  SP::SiconosMatrix mass(new SimpleMatrix(1, 1));
+  (*mass)(0, 0) = 1.;
+  _ds.reset(new LagrangianLinearTIDS(q0, v0, mass));
+}
+
+void InteractionsGraphSnapshotTest::tearDown()
+{}
+
+SP::Interaction InteractionsGraphSnapshotTest::contact()
+{
+  SP::SimpleMatrix H(new SimpleMatrix(1, 1));
+  (*H)(0, 0) = 1.;
+  SP::NonSmoothLaw nslaw(new NewtonImpactNSL(0.));
+  SP::Relation relation(new LagrangianLinearTIR(H));
+  SP::Interaction inter(new Interaction(nslaw, relation));
+  return inter;
+}
+
+void InteractionsGraphSnapshotTest::testFreeze()
+{
+  std::cout << "--> Test: freeze." << std::endl;
+  SP::Interaction inter1 = contact();
+  SP::Interaction inter2 = contact();
+  _graph->add_vertex(inter1);
+  _graph->add_vertex(inter2);
+  _graph->update_vertices_indices();
+  _graph->update_edges_indices();
+
+  InteractionsGraphSnapshot snapshot;
+  CPPUNIT_ASSERT_MESSAGE("testFreeze : empty", !snapshot.isUpToDate(_graph));
+  snapshot.freeze(_graph);
+  CPPUNIT_ASSERT_MESSAGE("testFreeze : isUpToDate", snapshot.isUpToDate(_graph));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFreeze : size", 2u, snapshot.size());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFreeze : dimension", 2u, snapshot.dimension());
+  CPPUNIT_ASSERT_MESSAGE("testFreeze : interaction", &snapshot.interaction(1) == inter2.get());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testFreeze : position", 1u, snapshot.absolutePosition(1));
+  std::cout << "--> freeze test ended with success." << std::endl;
+}
+
+void InteractionsGraphSnapshotTest::testRemoveAndAddInteraction()
+{
+  std::cout << "--> Test: remove an interaction and add another one." << std::endl;
+  SP::Interaction inter1 = contact();
+  SP::Interaction inter2 = contact();
+  SP::Interaction inter3 = contact();
+  _graph->add_vertex(inter1);
+  _graph->add_vertex(inter2);
+  _graph->update_vertices_indices();
+  _graph->update_edges_indices();
+
+  InteractionsGraphSnapshot snapshot;
+  snapshot.freeze(_graph);
+
+  // same number of vertices, and the indices are not updated
+  _graph->remove_vertex(inter2);
+  _graph->add_vertex(inter3);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testRemoveAndAddInteraction : vertices",
+                               (size_t)snapshot.size(), _graph->vertices_number());
+  CPPUNIT_ASSERT_MESSAGE("testRemoveAndAddInteraction : isUpToDate", !snapshot.isUpToDate(_graph));
+
+  snapshot.freeze(_graph);
+  CPPUNIT_ASSERT_MESSAGE("testRemoveAndAddInteraction : isUpToDate after freeze", snapshot.isUpToDate(_graph));
+  CPPUNIT_ASSERT_MESSAGE("testRemoveAndAddInteraction : interaction 0", &snapshot.interaction(0) == inter1.get());
+  CPPUNIT_ASSERT_MESSAGE("testRemoveAndAddInteraction : interaction 1", &snapshot.interaction(1) == inter3.get());
+  std::cout << "--> remove and add interaction test ended with success." << std::endl;
+}
+
+void InteractionsGraphSnapshotTest::testRemoveAndAddEdge()
+{
+  std::cout << "--> Test: remove an edge and add another one." << std::endl;
+  SP::Interaction inter1 = contact();
+  SP::Interaction inter2 = contact();
+  SP::Interaction inter3 = contact();
+  InteractionsGraph::VDescriptor vd1 = _graph->add_vertex(inter1);
+  InteractionsGraph::VDescriptor vd2 = _graph->add_vertex(inter2);
+  InteractionsGraph::VDescriptor vd3 = _graph->add_vertex(inter3);
+  InteractionsGraph::EDescriptor ed = _graph->add_edge(vd1, vd2, _ds);
+  _graph->update_vertices_indices();
+  _graph->update_edges_indices();
+
+  InteractionsGraphSnapshot snapshot;
+  snapshot.freeze(_graph);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testRemoveAndAddEdge : edges", 1u, snapshot.edgesNumber());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testRemoveAndAddEdge : target", 1u, snapshot.target(0));
+
+  _graph->remove_edge(ed);
+  _graph->add_edge(vd1, vd3, _ds);
+  CPPUNIT_ASSERT_MESSAGE("testRemoveAndAddEdge : isUpToDate", !snapshot.isUpToDate(_graph));
+
+  snapshot.freeze(_graph);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testRemoveAndAddEdge : edges after freeze", 1u, snapshot.edgesNumber());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testRemoveAndAddEdge : target after freeze", 2u, snapshot.target(0));
+  std::cout << "--> remove and add edge test ended with success." << std::endl;
+}
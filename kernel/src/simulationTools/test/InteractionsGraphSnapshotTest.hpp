@@ -0,0 +1,62 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __InteractionsGraphSnapshotTest__
+#define __InteractionsGraphSnapshotTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "SimulationGraphs.hpp"
+
+class InteractionsGraphSnapshotTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(InteractionsGraphSnapshotTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(InteractionsGraphSnapshotTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testFreeze);
+  CPPUNIT_TEST(testRemoveAndAddInteraction);
+  CPPUNIT_TEST(testRemoveAndAddEdge);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testFreeze();
+  void testRemoveAndAddInteraction();
+  void testRemoveAndAddEdge();
+
+  /** \return a new contact with a scalar Newton impact law */
+  SP::Interaction contact();
+
+  // Members
+
+  SP::InteractionsGraph _graph;
+  SP::DynamicalSystem _ds;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
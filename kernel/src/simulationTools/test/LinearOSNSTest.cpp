@@ -0,0 +1,194 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "LinearOSNSTest.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "Interaction.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "LCP.hpp"
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+#include <cmath>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(LinearOSNSTest);
+
+
+void LinearOSNSTest::setUp()
+{
+  _h = 1e-3;
+  _t0 = 0.;
+  _T = 1.5;
+  _tol = 1e-12;
+}
+
+void LinearOSNSTest::tearDown()
+{}
+
+SP::TimeStepping LinearOSNSTest::balls(bool keep, std::vector<SP::LagrangianLinearTIDS>& ds)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, _T));
+  ds.clear();
+  double heights[3] = {0.2, 0.5, 1.0};
+  for(unsigned int k = 0; k < 3; ++k)
+  {
+    SP::SiconosVector q0(new SiconosVector(1, heights[k]));
+    SP::SiconosVector v0(new SiconosVector(1, 0.));
+    SP::SiconosMatrix mass(new SimpleMatrix(1, 1));
+    mass->eye();
+    SP::LagrangianLinearTIDS ball(new LagrangianLinearTIDS(q0, v0, mass));
+    ball->setFExtPtr(SP::SiconosVector(new SiconosVector(1, -9.81)));
+    nsds->insertDynamicalSystem(ball);
+    ds.push_back(ball);
+
+    SP::SimpleMatrix H(new SimpleMatrix(1, 1));
+    H->eye();
+    SP::Interaction inter(new Interaction(SP::NonSmoothLaw(new NewtonImpactNSL(0.3)),
+                                          SP::Relation(new LagrangianLinearTIR(H))));
+    nsds->link(inter, ball);
+  }
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(_t0, _h));
+  SP::LCP lcp(new LCP());
+  lcp->setKeepInteractionBlocks(keep);
+  SP::TimeStepping sim(new TimeStepping(nsds, td, SP::MoreauJeanOSI(new MoreauJeanOSI(0.5)), lcp));
+  sim->initialize();
+  return sim;
+}
+
+SP::TimeStepping LinearOSNSTest::ballAndWall(bool keep, SP::LagrangianLinearTIDS& ds)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, _T));
+  // q = (x, y), sliding on the ground y = 0 towards the wall x = 0
+  SP::SiconosVector q0(new SiconosVector(2));
+  SP::SiconosVector v0(new SiconosVector(2));
+  (*q0)(0) = 0.1;
+  (*v0)(0) = -1.;
+  SP::SiconosMatrix mass(new SimpleMatrix(2, 2));
+  mass->eye();
+  (*mass)(0, 1) = 0.2;
+  (*mass)(1, 0) = 0.2;
+  ds.reset(new LagrangianLinearTIDS(q0, v0, mass));
+  SP::SiconosVector weight(new SiconosVector(2));
+  (*weight)(1) = -9.81;
+  ds->setFExtPtr(weight);
+  nsds->insertDynamicalSystem(ds);
+
+  for(unsigned int k = 0; k < 2; ++k)
+  {
+    SP::SimpleMatrix H(new SimpleMatrix(1, 2));
+    (*H)(0, k) = 1.;
+    SP::Interaction inter(new Interaction(SP::NonSmoothLaw(new NewtonImpactNSL(0.7)),
+                                          SP::Relation(new LagrangianLinearTIR(H))));
+    nsds->link(inter, ds);
+  }
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(_t0, _h));
+  SP::LCP lcp(new LCP());
+  lcp->setKeepInteractionBlocks(keep);
+  SP::TimeStepping sim(new TimeStepping(nsds, td, SP::MoreauJeanOSI(new MoreauJeanOSI(0.5)), lcp));
+  sim->initialize();
+  return sim;
+}
+
+void LinearOSNSTest::testKeepInteractionBlocks()
+{
+  std::cout << "--> Test: keep the interaction blocks of bouncing balls." << std::endl;
+  std::vector<SP::LagrangianLinearTIDS> ds, dsRef;
+  SP::TimeStepping sim = balls(true, ds);
+  SP::TimeStepping ref = balls(false, dsRef);
+  SP::OneStepNSProblem lcp = sim->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY);
+  SP::OneStepNSProblem lcpRef = ref->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY);
+
+  unsigned int activations = 0, steps = 0;
+  while(sim->hasNextEvent())
+  {
+    unsigned int computed = lcp->numberOfComputedBlocks();
+    unsigned int computedRef = lcpRef->numberOfComputedBlocks();
+    sim->computeOneStep();
+    ref->computeOneStep();
+    steps++;
+
+    // the balls do not share any dynamical system: one block for each
+    // Interaction, computed only when it enters the index set
+    unsigned int active = sim->indexSet(1)->size();
+    if(active > 0)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testKeepInteractionBlocks : computed blocks",
+                                   (unsigned int)sim->activatedInteractions().size(),
+                                   lcp->numberOfComputedBlocks() - computed);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testKeepInteractionBlocks : computed blocks, reference",
+                                   active, lcpRef->numberOfComputedBlocks() - computedRef);
+    }
+    activations += sim->activatedInteractions().size();
+
+    for(unsigned int k = 0; k < ds.size(); ++k)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testKeepInteractionBlocks : q",
+                                           dsRef[k]->q()->getValue(0), ds[k]->q()->getValue(0), _tol);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testKeepInteractionBlocks : v",
+                                           dsRef[k]->velocity()->getValue(0), ds[k]->velocity()->getValue(0), _tol);
+    }
+    sim->nextStep();
+    ref->nextStep();
+  }
+  std::cout << steps << " steps, " << activations << " activations, "
+            << lcp->numberOfComputedBlocks() << " blocks computed instead of "
+            << lcpRef->numberOfComputedBlocks() << std::endl;
+  // the balls bounce several times
+  CPPUNIT_ASSERT_MESSAGE("testKeepInteractionBlocks : activations", activations > 6);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testKeepInteractionBlocks : total", activations,
+                               lcp->numberOfComputedBlocks());
+  std::cout << "--> keep interaction blocks test ended with success." << std::endl;
+}
+
+void LinearOSNSTest::testKeepInteractionBlocksSharedDS()
+{
+  std::cout << "--> Test: keep the interaction blocks of two contacts on the same ball." << std::endl;
+  SP::LagrangianLinearTIDS ds, dsRef;
+  SP::TimeStepping sim = ballAndWall(true, ds);
+  SP::TimeStepping ref = ballAndWall(false, dsRef);
+  SP::OneStepNSProblem lcp = sim->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY);
+  SP::OneStepNSProblem lcpRef = ref->oneStepNSProblem(SICONOS_OSNSP_TS_VELOCITY);
+
+  bool both = false;
+  while(sim->hasNextEvent())
+  {
+    sim->computeOneStep();
+    ref->computeOneStep();
+    both = both || sim->indexSet(1)->size() == 2;
+    for(unsigned int i = 0; i < 2; ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testKeepInteractionBlocksSharedDS : q",
+                                           dsRef->q()->getValue(i), ds->q()->getValue(i), _tol);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testKeepInteractionBlocksSharedDS : v",
+                                           dsRef->velocity()->getValue(i), ds->velocity()->getValue(i), _tol);
+    }
+    sim->nextStep();
+    ref->nextStep();
+  }
+  std::cout << lcp->numberOfComputedBlocks() << " blocks computed instead of "
+            << lcpRef->numberOfComputedBlocks() << std::endl;
+  // the two contacts are active together, with extra-diagonal blocks
+  CPPUNIT_ASSERT_MESSAGE("testKeepInteractionBlocksSharedDS : both contacts", both);
+  CPPUNIT_ASSERT_MESSAGE("testKeepInteractionBlocksSharedDS : computed blocks",
+                         lcp->numberOfComputedBlocks() < lcpRef->numberOfComputedBlocks() / 10);
+  std::cout << "--> keep interaction blocks with a shared dynamical system test ended with success." << std::endl;
+}
@@ -0,0 +1,76 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __LinearOSNSTest__
+#define __LinearOSNSTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "LagrangianLinearTIDS.hpp"
+#include "TimeStepping.hpp"
+
+class LinearOSNSTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(LinearOSNSTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(LinearOSNSTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testKeepInteractionBlocks);
+  CPPUNIT_TEST(testKeepInteractionBlocksSharedDS);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testKeepInteractionBlocks();
+  void testKeepInteractionBlocksSharedDS();
+
+  /** bouncing balls on the ground, dropped from different heights,
+   * until they rest on it
+   * \param keep if true, the LCP keeps its interaction blocks
+   * \param ds the balls (out)
+   * \return the simulation
+   */
+  SP::TimeStepping balls(bool keep, std::vector<SP::LagrangianLinearTIDS>& ds);
+
+  /** a ball sliding on the ground and bouncing against a wall, with two
+   * contacts on the same dynamical system
+   * \param keep if true, the LCP keeps its interaction blocks
+   * \param ds the ball (out)
+   * \return the simulation
+   */
+  SP::TimeStepping ballAndWall(bool keep, SP::LagrangianLinearTIDS& ds);
+
+  // Members
+
+  double _h;
+  double _t0;
+  double _T;
+  double _tol;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
@@ -0,0 +1,208 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "MoreauJeanOSITest.hpp"
+#include "ForcesBatch.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LCP.hpp"
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+
+#define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
+            if ((alpha) == (omega)) CPPUNIT_FAIL(message);
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(MoreauJeanOSITest);
+
+// fInt = q + 0.1 v + 0.5 q^3
+static void fInt(double time, unsigned int size, double* q, double* v, double* f,
+                 unsigned int sizeZ, double* z)
+{
+  for(unsigned int k = 0; k < size; ++k)
+    f[k] = q[k] + 0.1 * v[k] + 0.5 * q[k] * q[k] * q[k];
+}
+
+static void jacobianFIntq(double time, unsigned int size, double* q, double* v, double* jac,
+                          unsigned int sizeZ, double* z)
+{
+  for(unsigned int k = 0; k < size * size; ++k)
+    jac[k] = 0.;
+  for(unsigned int k = 0; k < size; ++k)
+    jac[k * size + k] = 1. + 1.5 * q[k] * q[k];
+}
+
+static void jacobianFIntv(double time, unsigned int size, double* q, double* v, double* jac,
+                          unsigned int sizeZ, double* z)
+{
+  for(unsigned int k = 0; k < size * size; ++k)
+    jac[k] = 0.;
+  for(unsigned int k = 0; k < size; ++k)
+    jac[k * size + k] = 0.1;
+}
+
+// forces = - fInt for each system, entry by entry
+static void batchedForces(unsigned int n, double time, unsigned int sizeOfq, double* q,
+                          unsigned int sizeOfv, double* v, double* forces, unsigned int sizeZ, double* z)
+{
+  for(unsigned int k = 0; k < sizeOfv; ++k)
+    for(unsigned int i = 0; i < n; ++i)
+    {
+      double qi = q[k * n + i];
+      forces[k * n + i] = - qi - 0.1 * v[k * n + i] - 0.5 * qi * qi * qi;
+    }
+}
+
+void MoreauJeanOSITest::setUp()
+{
+  _n = 5;
+  _h = 1e-2;
+  _t0 = 0.;
+  _T = 1.;
+  _tol = 1e-9;
+}
+
+void MoreauJeanOSITest::tearDown()
+{}
+
+SP::TimeStepping MoreauJeanOSITest::oscillators(bool batched, std::vector<SP::LagrangianDS>& ds,
+                                                unsigned int reuse)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, _T));
+  SP::SiconosMatrix mass(new SimpleMatrix(2, 2));
+  mass->eye();
+  SP::ForcesBatch batch(new ForcesBatch(batchedForces));
+  ds.resize(_n);
+  for(unsigned int i = 0; i < _n; ++i)
+  {
+    SP::SiconosVector q0(new SiconosVector(2));
+    SP::SiconosVector v0(new SiconosVector(2));
+    (*q0)(0) = 0.2 * (i + 1);
+    (*q0)(1) = - 0.1 * i;
+    (*v0)(0) = 0.5;
+    ds[i].reset(new LagrangianDS(q0, v0, mass));
+    if(batched)
+      // no force plug-in: the forces come from the group only, and
+      // the iteration matrix is the mass matrix
+      batch->insertDynamicalSystem(ds[i]);
+    else
+    {
+      ds[i]->setComputeFIntFunction(fInt);
+      ds[i]->setComputeJacobianFIntqFunction(jacobianFIntq);
+      ds[i]->setComputeJacobianFIntqDotFunction(jacobianFIntv);
+    }
+    nsds->insertDynamicalSystem(ds[i]);
+  }
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(_t0, _h));
+  SP::TimeStepping sim(new TimeStepping(nsds, td, 0));
+  _osi.reset(new MoreauJeanOSI(0.5));
+  if(batched)
+    _osi->insertForcesBatch(batch);
+  _osi->setIterationMatrixReuse(reuse);
+  sim->insertIntegrator(_osi);
+  sim->insertNonSmoothProblem(SP::LCP(new LCP()));
+  sim->setNewtonTolerance(1e-13);
+  sim->setNewtonMaxIteration(100);
+  sim->initialize();
+  return sim;
+}
+
+void MoreauJeanOSITest::testForcesBatch()
+{
+  std::cout << "--> Test: forces batch." << std::endl;
+
+  std::vector<SP::LagrangianDS> ref, ds;
+  SP::TimeStepping simRef = oscillators(false, ref);
+  SP::TimeStepping sim = oscillators(true, ds);
+
+  // the forces in memory at the initial time are the ones of the group
+  for(unsigned int i = 0; i < _n; ++i)
+  {
+    const SiconosVector& f = ds[i]->forcesMemory().getSiconosVector(0);
+    const SiconosVector& fRef = ref[i]->forcesMemory().getSiconosVector(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testForcesBatch : initial forces", (f - fRef).normInf() < _tol, true);
+  }
+
+  while(simRef->hasNextEvent())
+  {
+    simRef->advanceToEvent();
+    sim->advanceToEvent();
+    for(unsigned int i = 0; i < _n; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testForcesBatch : position",
+                                   (*ds[i]->q() - *ref[i]->q()).normInf() < _tol, true);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testForcesBatch : velocity",
+                                   (*ds[i]->velocity() - *ref[i]->velocity()).normInf() < _tol, true);
+    }
+    simRef->processEvents();
+    sim->processEvents();
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testForcesBatch : final time", sim->hasNextEvent(), false);
+
+  // the linear Lagrangian systems are integrated with their operators
+  SP::ForcesBatch batch(new ForcesBatch(batchedForces));
+  SP::SiconosMatrix mass(new SimpleMatrix(2, 2));
+  mass->eye();
+  SP::LagrangianLinearTIDS tids(new LagrangianLinearTIDS(ds[0]->q0(), ds[0]->velocity0(), mass));
+  CPPUNIT_ASSERT_THROW(batch->insertDynamicalSystem(tids), RuntimeException);
+  std::cout << "--> Forces batch test ended with success." << std::endl;
+}
+
+void MoreauJeanOSITest::testIterationMatrixReuse()
+{
+  std::cout << "--> Test: iteration matrix reuse." << std::endl;
+
+  std::vector<SP::LagrangianDS> ref, ds;
+  SP::TimeStepping simRef = oscillators(false, ref);
+  SP::MoreauJeanOSI osiRef = _osi;
+  SP::TimeStepping sim = oscillators(false, ds, 3);
+  SP::MoreauJeanOSI osi = _osi;
+
+  unsigned int steps = 0;
+  while(simRef->hasNextEvent())
+  {
+    unsigned long computations = osi->numberOfIterationMatrixComputations();
+    simRef->advanceToEvent();
+    sim->advanceToEvent();
+    steps++;
+
+    // W is computed again at the first iteration of each step
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : new step",
+                                 osi->numberOfIterationMatrixComputations() > computations, true);
+    // the modified Newton loop converges to the same state
+    for(unsigned int i = 0; i < _n; ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : position",
+                                   (*ds[i]->q() - *ref[i]->q()).normInf() < _tol, true);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : velocity",
+                                   (*ds[i]->velocity() - *ref[i]->velocity()).normInf() < _tol, true);
+    }
+    simRef->processEvents();
+    sim->processEvents();
+  }
+
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : reuses",
+                               osi->numberOfIterationMatrixReuses() > 0, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : fewer computations",
+                               osi->numberOfIterationMatrixComputations()
+                               < osiRef->numberOfIterationMatrixComputations(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : default",
+                               osiRef->numberOfIterationMatrixReuses() == 0, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testIterationMatrixReuse : one computation per step at least",
+                               osi->numberOfIterationMatrixComputations() >= steps, true);
+  std::cout << "--> Iteration matrix reuse test ended with success." << std::endl;
+}
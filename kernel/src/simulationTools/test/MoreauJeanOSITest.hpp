@@ -0,0 +1,76 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __MoreauJeanOSITest__
+#define __MoreauJeanOSITest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "LagrangianDS.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "TimeStepping.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+
+class MoreauJeanOSITest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(MoreauJeanOSITest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(MoreauJeanOSITest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testForcesBatch);
+  CPPUNIT_TEST(testIterationMatrixReuse);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testForcesBatch();
+  void testIterationMatrixReuse();
+
+  /** a simulation of _n oscillators, with a cubic stiffness
+   * \param batched if true, the forces of the oscillators are
+   * computed by a ForcesBatch, otherwise by their own plug-ins
+   * \param ds[out] the oscillators
+   * \param reuse the maximum number of Newton iterations with the
+   * same iteration matrix
+   * \return the simulation
+   */
+  SP::TimeStepping oscillators(bool batched, std::vector<SP::LagrangianDS>& ds,
+                               unsigned int reuse = 1);
+
+  // Members
+
+  unsigned int _n;
+  double _h;
+  double _t0;
+  double _T;
+  double _tol;
+  SP::MoreauJeanOSI _osi;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
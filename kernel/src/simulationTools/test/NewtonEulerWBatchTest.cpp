@@ -0,0 +1,209 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "NewtonEulerWBatchTest.hpp"
+#include <cmath>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(NewtonEulerWBatchTest);
+
+/* a general matrix, with a small diagonal so that the LU
+ * factorization has to pivot */
+static void generalMatrix(SimpleMatrix& W, unsigned int seed)
+{
+  for (unsigned int r = 0; r < 6; ++r)
+    for (unsigned int c = 0; c < 6; ++c)
+      W(r, c) = std::sin(1.0 + seed + 7.0 * r + 3.0 * c);
+  for (unsigned int r = 0; r < 6; ++r)
+    W(r, r) = 1e-3 * (seed + 1);
+}
+
+/* the structure of a mass matrix: diagonal translational block,
+ * symmetric positive definite rotational block */
+static void massMatrix(SimpleMatrix& W, unsigned int seed)
+{
+  W.zero();
+  for (unsigned int r = 0; r < 3; ++r)
+    W(r, r) = 1.0 + seed + r;
+  W(3, 3) = 4.0 + seed;
+  W(4, 4) = 3.0 + seed;
+  W(5, 5) = 5.0;
+  W(3, 4) = W(4, 3) = 1.0;
+  W(3, 5) = W(5, 3) = 0.5;
+  W(4, 5) = W(5, 4) = -0.25 * seed;
+}
+
+static void rhs(SiconosVector& b, unsigned int seed)
+{
+  for (unsigned int r = 0; r < 6; ++r)
+    b(r) = std::cos(2.0 * seed + r);
+}
+
+void NewtonEulerWBatchTest::setUp()
+{
+  _tol = 1e-12;
+  _W.clear();
+  _b.clear();
+  for (unsigned int i = 0; i < 3 * NewtonEulerWBatch::LANES; ++i)
+  {
+    _W.push_back(SP::SimpleMatrix(new SimpleMatrix(6, 6)));
+    _b.push_back(SP::SiconosVector(new SiconosVector(6)));
+    rhs(*_b[i], i);
+  }
+}
+
+void NewtonEulerWBatchTest::tearDown()
+{}
+
+void NewtonEulerWBatchTest::checkSolutions(const std::string& message, unsigned int size)
+{
+  _batch.resize(size);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    _batch.setMatrix(i, *_W[i]);
+    _batch.setRhs(i, *_b[i]);
+  }
+  for (unsigned int p = 0; p < _batch.numberOfPacks(); ++p)
+  {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(message + ": factorize", -1, _batch.factorize(p));
+    _batch.solve(p);
+  }
+  _batch.setFactorized(true);
+
+  SiconosVector x(6);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    SimpleMatrix W(*_W[i]);
+    SiconosVector ref(*_b[i]);
+    W.PLUForwardBackwardInPlace(ref);
+
+    // solve() of the pack
+    _batch.solution(i, x);
+    for (unsigned int r = 0; r < 6; ++r)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message + ": solve of a pack", ref(r), x(r),
+                                           _tol * (1.0 + std::fabs(ref(r))));
+
+    // solve() of a body
+    double b[6];
+    for (unsigned int r = 0; r < 6; ++r)
+      b[r] = (*_b[i])(r);
+    _batch.solve(i, b);
+    for (unsigned int r = 0; r < 6; ++r)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message + ": solve of a body", ref(r), b[r],
+                                           _tol * (1.0 + std::fabs(ref(r))));
+  }
+}
+
+void NewtonEulerWBatchTest::testGeneral()
+{
+  std::cout << "--> Test: general matrices." << std::endl;
+  unsigned int size = 2 * NewtonEulerWBatch::LANES;
+  for (unsigned int i = 0; i < size; ++i)
+    generalMatrix(*_W[i], i);
+  checkSolutions("general", size);
+  for (unsigned int i = 0; i < size; ++i)
+    CPPUNIT_ASSERT_MESSAGE("general: LU", !_batch.isBlockDiagonal(i));
+  std::cout << "--> general test ended with success." << std::endl;
+}
+
+void NewtonEulerWBatchTest::testBlockDiagonal()
+{
+  std::cout << "--> Test: mass matrices." << std::endl;
+  unsigned int size = 2 * NewtonEulerWBatch::LANES;
+  for (unsigned int i = 0; i < size; ++i)
+    massMatrix(*_W[i], i % 4);
+  checkSolutions("block diagonal", size);
+  for (unsigned int i = 0; i < size; ++i)
+    CPPUNIT_ASSERT_MESSAGE("block diagonal: Cholesky", _batch.isBlockDiagonal(i));
+
+  // one general matrix in the second pack: LU for this pack only
+  generalMatrix(*_W[size - 1], 0);
+  checkSolutions("mixed", size);
+  CPPUNIT_ASSERT_MESSAGE("mixed: Cholesky in the first pack", _batch.isBlockDiagonal(0));
+  CPPUNIT_ASSERT_MESSAGE("mixed: LU in the second pack", !_batch.isBlockDiagonal(size - 1));
+  std::cout << "--> block diagonal test ended with success." << std::endl;
+}
+
+void NewtonEulerWBatchTest::testNonPositive()
+{
+  std::cout << "--> Test: block diagonal matrices, not positive definite." << std::endl;
+  unsigned int size = NewtonEulerWBatch::LANES;
+  for (unsigned int i = 0; i < size; ++i)
+    massMatrix(*_W[i], i % 4);
+  // an indefinite rotational block, which has the structure of a mass
+  // matrix: the pack falls back to LU
+  (*_W[3])(5, 5) = -2.0;
+  checkSolutions("indefinite", size);
+  CPPUNIT_ASSERT_MESSAGE("indefinite: LU", !_batch.isBlockDiagonal(3));
+
+  // a negative first pivot of the rotational block
+  massMatrix(*_W[3], 0);
+  (*_W[5])(3, 3) = -1.0;
+  checkSolutions("negative pivot", size);
+  CPPUNIT_ASSERT_MESSAGE("negative pivot: LU", !_batch.isBlockDiagonal(5));
+
+  // a negative mass only needs a nonzero translational diagonal
+  massMatrix(*_W[5], 0);
+  (*_W[6])(1, 1) = -1.0;
+  checkSolutions("negative mass", size);
+  CPPUNIT_ASSERT_MESSAGE("negative mass: Cholesky", _batch.isBlockDiagonal(6));
+  std::cout << "--> non positive test ended with success." << std::endl;
+}
+
+void NewtonEulerWBatchTest::testSingular()
+{
+  std::cout << "--> Test: singular matrix." << std::endl;
+  unsigned int size = NewtonEulerWBatch::LANES + 3;
+  for (unsigned int i = 0; i < size; ++i)
+    generalMatrix(*_W[i], i);
+  // two equal rows in the matrix of the body 9
+  for (unsigned int c = 0; c < 6; ++c)
+    (*_W[9])(4, c) = (*_W[9])(2, c);
+
+  _batch.resize(size);
+  for (unsigned int i = 0; i < size; ++i)
+    _batch.setMatrix(i, *_W[i]);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("regular pack", -1, _batch.factorize(0));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("singular body", 9, _batch.factorize(1));
+
+  // a zero mass
+  for (unsigned int i = 0; i < size; ++i)
+    massMatrix(*_W[i], i % 4);
+  (*_W[2])(0, 0) = 0.0;
+  for (unsigned int i = 0; i < size; ++i)
+    _batch.setMatrix(i, *_W[i]);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("zero mass", 2, _batch.factorize(0));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("regular pack", -1, _batch.factorize(1));
+  std::cout << "--> singular test ended with success." << std::endl;
+}
+
+void NewtonEulerWBatchTest::testPartialPack()
+{
+  std::cout << "--> Test: partial last pack." << std::endl;
+  unsigned int size = 2 * NewtonEulerWBatch::LANES + 3;
+  for (unsigned int i = 0; i < size; ++i)
+    massMatrix(*_W[i], i % 4);
+  checkSolutions("partial pack, block diagonal", size);
+  CPPUNIT_ASSERT_MESSAGE("partial pack: Cholesky", _batch.isBlockDiagonal(size - 1));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("number of packs", 3u, _batch.numberOfPacks());
+
+  for (unsigned int i = 0; i < size; ++i)
+    generalMatrix(*_W[i], i);
+  checkSolutions("partial pack, LU", size);
+  CPPUNIT_ASSERT_MESSAGE("partial pack: LU", !_batch.isBlockDiagonal(size - 1));
+  std::cout << "--> partial pack test ended with success." << std::endl;
+}
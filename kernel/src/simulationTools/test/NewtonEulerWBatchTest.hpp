@@ -0,0 +1,73 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __NewtonEulerWBatchTest__
+#define __NewtonEulerWBatchTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "NewtonEulerWBatch.hpp"
+#include "SimpleMatrix.hpp"
+#include "SiconosVector.hpp"
+
+class NewtonEulerWBatchTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(NewtonEulerWBatchTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(NewtonEulerWBatchTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testGeneral);
+  CPPUNIT_TEST(testBlockDiagonal);
+  CPPUNIT_TEST(testNonPositive);
+  CPPUNIT_TEST(testSingular);
+  CPPUNIT_TEST(testPartialPack);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testGeneral();
+  void testBlockDiagonal();
+  void testNonPositive();
+  void testSingular();
+  void testPartialPack();
+
+  // Members
+
+  /** factorize and solve all the packs of the batch with the
+   * matrices and right-hand sides, and compare the solutions with
+   * the ones of SimpleMatrix::PLUForwardBackwardInPlace
+   */
+  void checkSolutions(const std::string& message, unsigned int size);
+
+  std::vector<SP::SimpleMatrix> _W;
+  std::vector<SP::SiconosVector> _b;
+  NewtonEulerWBatch _batch;
+  double _tol;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
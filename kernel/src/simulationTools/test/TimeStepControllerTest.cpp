@@ -0,0 +1,208 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "TimeStepControllerTest.hpp"
+#include "TimeStepController.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "Topology.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearDiagonalDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "MoreauJeanGOSI.hpp"
+#include "MoreauJeanBilbaoOSI.hpp"
+#include "LCP.hpp"
+#include "GlobalFrictionContact.hpp"
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+#include <cmath>
+#include <set>
+
+#define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
+            if ((alpha) == (omega)) CPPUNIT_FAIL(message);
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeStepControllerTest);
+
+
+void TimeStepControllerTest::setUp()
+{
+  _h = 0.05;
+  _t0 = 0.;
+  _T = 2.;
+  _tol = 1e-10;
+}
+
+void TimeStepControllerTest::tearDown()
+{}
+
+SP::TimeStepping TimeStepControllerTest::simulation(SP::LagrangianDS ds, SP::Interaction inter,
+                                                    SP::OneStepIntegrator osi, SP::OneStepNSProblem osnspb)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, _T));
+  nsds->insertDynamicalSystem(ds);
+  if(inter)
+    nsds->link(inter, ds);
+  SP::TimeDiscretisation td(new TimeDiscretisation(_t0, _h));
+  SP::TimeStepping sim(new TimeStepping(nsds, td, osi, osnspb));
+  // the first step, _h, is too long for the tolerances: it is rejected
+  SP::TimeStepController controller(new TimeStepController(1e-5, 0.1));
+  controller->setTolerances(1e-4, 1e-3);
+  sim->setTimeStepController(controller);
+  sim->initialize();
+  return sim;
+}
+
+void TimeStepControllerTest::testBouncingBall()
+{
+  std::cout << "--> Test: bouncing ball with an adaptive time step." << std::endl;
+  double g = 9.81;
+  double height = 1.;
+  SP::SiconosVector q0(new SiconosVector(1, height));
+  SP::SiconosVector v0(new SiconosVector(1, 0.));
+  SP::SiconosMatrix mass(new SimpleMatrix(1, 1));
+  mass->eye();
+  SP::LagrangianLinearTIDS ball(new LagrangianLinearTIDS(q0, v0, mass));
+  SP::SiconosVector weight(new SiconosVector(1, -g));
+  ball->setFExtPtr(weight);
+
+  SP::SimpleMatrix H(new SimpleMatrix(1, 1));
+  H->eye();
+  SP::Interaction inter(new Interaction(SP::NonSmoothLaw(new NewtonImpactNSL(0.9)),
+                                        SP::Relation(new LagrangianLinearTIR(H))));
+
+  SP::TimeStepping sim = simulation(ball, inter, SP::MoreauJeanOSI(new MoreauJeanOSI(0.5)),
+                                    SP::LCP(new LCP()));
+  TimeStepController& controller = *sim->timeStepController();
+
+  // time of the first impact
+  double impact = sqrt(2. * height / g);
+  double hPrevious = 0., hMin = _T, hMax = 0.;
+  bool grew = false, shrank = false;
+  while(sim->hasNextEvent())
+  {
+    sim->computeOneStep();
+    double t = sim->nextTime();
+    double h = t - sim->startingTime();
+    hMin = std::min(h, hMin);
+    hMax = std::max(h, hMax);
+    if(hPrevious > 0.)
+    {
+      grew = grew || h > 1.5 * hPrevious;
+      shrank = shrank || h < 0.75 * hPrevious;
+    }
+    hPrevious = h;
+
+    // before the impact, the midpoint rule is exact: a step computed
+    // again must start from the state saved in memory
+    if(t < impact)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testBouncingBall : free flight",
+                                           height - 0.5 * g * t * t, (*ball->q())(0), _tol);
+    // the contact is detected one step late at most
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBouncingBall : above the ground",
+                                 (*ball->q())(0) > - h * sqrt(2. * g * height), true);
+    sim->nextStep();
+  }
+
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testBouncingBall : final time", _T, sim->startingTime(), 1e-14);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBouncingBall : rejected steps", controller.numberOfRejectedSteps() > 0, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBouncingBall : growth of the step", grew, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBouncingBall : shrink of the step", shrank, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testBouncingBall : bounds of the step", hMin >= controller.hMin() && hMax <= controller.hMax(), true);
+  std::cout << "--> Bouncing ball test ended with success." << std::endl;
+}
+
+// a damped spring, without contact: with the step of each step, W is
+// M + h theta C + h^2 theta^2 K and the velocity solves the global
+// problem built with it
+void TimeStepControllerTest::testMoreauJeanGOSI()
+{
+  std::cout << "--> Test: MoreauJeanGOSI with an adaptive time step." << std::endl;
+  double k = 20.;
+  double c = 0.5;
+  double theta = 0.5;
+  SP::SiconosVector q0(new SiconosVector(1, 1.));
+  SP::SiconosVector v0(new SiconosVector(1, 0.));
+  SP::SiconosMatrix mass(new SimpleMatrix(1, 1));
+  mass->eye();
+  SP::SiconosMatrix K(new SimpleMatrix(1, 1));
+  (*K)(0, 0) = k;
+  SP::SiconosMatrix C(new SimpleMatrix(1, 1));
+  (*C)(0, 0) = c;
+  SP::LagrangianLinearTIDS ds(new LagrangianLinearTIDS(q0, v0, mass, K, C));
+  SP::TimeStepping sim = simulation(ds, SP::Interaction(), SP::MoreauJeanGOSI(new MoreauJeanGOSI(theta)),
+                                    SP::OneStepNSProblem(new GlobalFrictionContact(3)));
+  DynamicalSystemsGraph& dsg = *sim->nonSmoothDynamicalSystem()->topology()->dSG(0);
+
+  std::set<double> steps;
+  while(sim->hasNextEvent())
+  {
+    double qold = (*ds->q())(0);
+    double vold = (*ds->velocity())(0);
+    sim->computeOneStep();
+    double h = sim->nextTime() - sim->startingTime();
+    steps.insert(h);
+
+    double W = 1. + h * theta * c + h * h * theta * theta * k;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testMoreauJeanGOSI : W", W,
+                                         (*dsg.properties(dsg.descriptor(ds)).W)(0, 0), _tol);
+    // the residu of the linear time invariant systems of MoreauJeanGOSI
+    double v = vold + (h * c * vold - h * k * qold) / W;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testMoreauJeanGOSI : velocity", v, (*ds->velocity())(0), 1e-8);
+    sim->nextStep();
+  }
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testMoreauJeanGOSI : final time", _T, sim->startingTime(), 1e-14);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testMoreauJeanGOSI : rejected steps",
+                               sim->timeStepController()->numberOfRejectedSteps() > 0, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testMoreauJeanGOSI : variable step", steps.size() > 2, true);
+  std::cout << "--> MoreauJeanGOSI test ended with success." << std::endl;
+}
+
+// a damped oscillator, without contact: the scheme of
+// MoreauJeanBilbaoOSI, exact with a constant step, stays close to the
+// exact solution if its parameters follow the step
+void TimeStepControllerTest::testMoreauJeanBilbaoOSI()
+{
+  std::cout << "--> Test: MoreauJeanBilbaoOSI with an adaptive time step." << std::endl;
+  double omega2 = 30.;
+  double sigma = 0.4;
+  SP::SiconosVector q0(new SiconosVector(1, 1.));
+  SP::SiconosVector v0(new SiconosVector(1, 0.));
+  SP::SiconosVector stiffness(new SiconosVector(1, omega2));
+  SP::SiconosVector damping(new SiconosVector(1, 2. * sigma));
+  SP::LagrangianLinearDiagonalDS ds(new LagrangianLinearDiagonalDS(q0, v0, stiffness, damping));
+  SP::TimeStepping sim = simulation(ds, SP::Interaction(), SP::MoreauJeanBilbaoOSI(new MoreauJeanBilbaoOSI()),
+                                    SP::LCP(new LCP()));
+
+  double omega = sqrt(omega2 - sigma * sigma);
+  double err = 0.;
+  while(sim->hasNextEvent())
+  {
+    sim->computeOneStep();
+    double t = sim->nextTime();
+    double q = exp(-sigma * t) * (cos(omega * t) + sigma / omega * sin(omega * t));
+    err = std::max(err, fabs(q - (*ds->q())(0)));
+    sim->nextStep();
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testMoreauJeanBilbaoOSI : error", err < 5e-2, true);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testMoreauJeanBilbaoOSI : final time", _T, sim->startingTime(), 1e-14);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testMoreauJeanBilbaoOSI : rejected steps",
+                               sim->timeStepController()->numberOfRejectedSteps() > 0, true);
+  std::cout << "--> MoreauJeanBilbaoOSI test ended with success." << std::endl;
+}
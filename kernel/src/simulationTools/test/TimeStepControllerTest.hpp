@@ -0,0 +1,76 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __TimeStepControllerTest__
+#define __TimeStepControllerTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "LagrangianDS.hpp"
+#include "Interaction.hpp"
+#include "OneStepIntegrator.hpp"
+#include "OneStepNSProblem.hpp"
+#include "TimeStepping.hpp"
+
+class TimeStepControllerTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(TimeStepControllerTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(TimeStepControllerTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testBouncingBall);
+  CPPUNIT_TEST(testMoreauJeanGOSI);
+  CPPUNIT_TEST(testMoreauJeanBilbaoOSI);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testBouncingBall();
+  void testMoreauJeanGOSI();
+  void testMoreauJeanBilbaoOSI();
+
+  /** a simulation of one dynamical system on [_t0, _T], with a
+   * TimeStepController
+   * \param ds the dynamical system
+   * \param inter an Interaction of the system with the ground, or none
+   * \param osi the integrator
+   * \param osnspb the nonsmooth problem
+   * \return the simulation
+   */
+  SP::TimeStepping simulation(SP::LagrangianDS ds, SP::Interaction inter,
+                              SP::OneStepIntegrator osi, SP::OneStepNSProblem osnspb);
+
+  // Members
+
+  double _h;
+  double _t0;
+  double _T;
+  double _tol;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
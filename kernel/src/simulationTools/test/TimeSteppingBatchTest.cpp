@@ -0,0 +1,134 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "TimeSteppingBatchTest.hpp"
+#include "TimeSteppingBatch.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactFrictionNSL.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "FrictionContact.hpp"
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+#include <cmath>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeSteppingBatchTest);
+
+
+void TimeSteppingBatchTest::setUp()
+{
+  _h = 1e-2;
+  _t0 = 0.;
+  _T = 0.5;
+  _g = 9.81;
+}
+
+void TimeSteppingBatchTest::tearDown()
+{}
+
+SP::TimeStepping TimeSteppingBatchTest::slidingBlock(double mass, double mu, double v0,
+                                                     SP::LagrangianDS& ds)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, _T));
+
+  SP::SimpleMatrix M(new SimpleMatrix(3, 3));
+  M->eye();
+  *M *= mass;
+  SP::SiconosVector velocity(new SiconosVector(3));
+  (*velocity)(0) = v0;
+  SP::LagrangianLinearTIDS block(new LagrangianLinearTIDS(SP::SiconosVector(new SiconosVector(3)),
+                                                          velocity, M));
+  SP::SiconosVector weight(new SiconosVector(3));
+  (*weight)(2) = - mass * _g;
+  block->setFExtPtr(weight);
+  ds = block;
+  nsds->insertDynamicalSystem(block);
+
+  // normal (z) first, then the tangential directions
+  SP::SimpleMatrix H(new SimpleMatrix(3, 3));
+  (*H)(0, 2) = 1.;
+  (*H)(1, 0) = 1.;
+  (*H)(2, 1) = 1.;
+  SP::Interaction inter(new Interaction(SP::NonSmoothLaw(new NewtonImpactFrictionNSL(0., 0., mu, 3)),
+                                        SP::Relation(new LagrangianLinearTIR(H))));
+  nsds->link(inter, block);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(_t0, _h));
+  SP::FrictionContact osnspb(new FrictionContact(3));
+  osnspb->numericsSolverOptions()->dparam[SICONOS_DPARAM_TOL] = 1e-12;
+  SP::TimeStepping sim(new TimeStepping(nsds, td, SP::MoreauJeanOSI(new MoreauJeanOSI(0.5)), osnspb));
+  sim->initialize();
+  return sim;
+}
+
+void TimeSteppingBatchTest::testSlidingBlocks()
+{
+  std::cout << "--> Test: scenarios of a sliding block advanced in lockstep." << std::endl;
+  // the first three scenarios share the matrix of the friction-contact
+  // problem, the last one has another mass
+  const unsigned int nbScenarios = 4;
+  double mass[nbScenarios] = {1., 1., 1., 2.};
+  double mu[nbScenarios] = {0.1, 0.3, 0.2, 0.1};
+  double v0[nbScenarios] = {1., 1., 2., 1.};
+
+  SP::TimeSteppingBatch batch(new TimeSteppingBatch());
+  std::vector<SP::TimeStepping> ref(nbScenarios);
+  std::vector<SP::LagrangianDS> ds(nbScenarios), dsRef(nbScenarios);
+  for(unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    batch->insertScenario(slidingBlock(mass[k], mu[k], v0[k], ds[k]));
+    ref[k] = slidingBlock(mass[k], mu[k], v0[k], dsRef[k]);
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSlidingBlocks : ", batch->scenarios().size(), (size_t)nbScenarios);
+
+  unsigned int steps = 0;
+  double error = 0.;
+  while(batch->hasNextEvent())
+  {
+    batch->computeOneStep();
+    batch->nextStep();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testSlidingBlocks : one solve for the scenarios sharing M",
+                                 batch->numberOfSolves(), 2u);
+    for(unsigned int k = 0; k < nbScenarios; ++k)
+    {
+      ref[k]->computeOneStep();
+      ref[k]->nextStep();
+      for(unsigned int i = 0; i < 3; ++i)
+      {
+        error = std::max(error, fabs(ds[k]->q()->getValue(i) - dsRef[k]->q()->getValue(i)));
+        error = std::max(error, fabs(ds[k]->velocity()->getValue(i) - dsRef[k]->velocity()->getValue(i)));
+      }
+    }
+    steps++;
+  }
+  std::cout << "steps: " << steps << ", largest difference with the scenarios run alone: " << error << std::endl;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSlidingBlocks : ", steps, (unsigned int)((_T - _t0) / _h + 0.5));
+  CPPUNIT_ASSERT_MESSAGE("testSlidingBlocks : same states as the scenarios run alone", error < 1e-10);
+
+  // the friction decelerates the blocks by mu g
+  for(unsigned int k = 0; k < nbScenarios; ++k)
+  {
+    double expected = std::max(0., v0[k] - mu[k] * _g * (_T - _t0));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testSlidingBlocks : ", expected,
+                                         ds[k]->velocity()->getValue(0), 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testSlidingBlocks : ", 0., ds[k]->q()->getValue(2), 1e-8);
+  }
+  std::cout << "--> Sliding blocks test ended with success." << std::endl;
+}
@@ -0,0 +1,67 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __TimeSteppingBatchTest__
+#define __TimeSteppingBatchTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "LagrangianDS.hpp"
+#include "TimeStepping.hpp"
+
+class TimeSteppingBatchTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(TimeSteppingBatchTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(TimeSteppingBatchTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testSlidingBlocks);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testSlidingBlocks();
+
+  /** a block sliding on the plane z = 0 with Coulomb friction
+   * \param mass the mass of the block
+   * \param mu the friction coefficient
+   * \param v0 the initial velocity along x
+   * \param ds the block (out)
+   * \return the simulation
+   */
+  SP::TimeStepping slidingBlock(double mass, double mu, double v0, SP::LagrangianDS& ds);
+
+  // Members
+
+  double _h;
+  double _t0;
+  double _T;
+  double _g;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
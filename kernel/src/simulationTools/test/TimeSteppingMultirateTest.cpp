@@ -0,0 +1,169 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "TimeSteppingMultirateTest.hpp"
+#include "TimeSteppingMultirate.hpp"
+#include "TimeDiscretisation.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "LCP.hpp"
+#include "SiconosVector.hpp"
+#include "SimpleMatrix.hpp"
+#include <cmath>
+
+#define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
+            if ((alpha) == (omega)) CPPUNIT_FAIL(message);
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(TimeSteppingMultirateTest);
+
+
+void TimeSteppingMultirateTest::setUp()
+{
+  _h = 1e-2;
+  _t0 = 0.;
+  _T = 2.;
+  _tol = 2e-3;
+}
+
+void TimeSteppingMultirateTest::tearDown()
+{}
+
+SP::TimeStepping TimeSteppingMultirateTest::oscillators(unsigned int subSteps, double h,
+                                                        std::vector<SP::LagrangianDS>& ds,
+                                                        SP::Interaction& inter)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, _T));
+  ds.clear();
+
+  // slow: 10 q1'' + 100 q1 = 0, q1(0) = 0.1
+  SP::SiconosMatrix mass(new SimpleMatrix(1, 1));
+  SP::SiconosMatrix stiffness(new SimpleMatrix(1, 1));
+  (*mass)(0, 0) = 10.;
+  (*stiffness)(0, 0) = 100.;
+  SP::LagrangianLinearTIDS slow(new LagrangianLinearTIDS(SP::SiconosVector(new SiconosVector(1, 0.1)),
+                                                         SP::SiconosVector(new SiconosVector(1, 0.)),
+                                                         mass));
+  slow->setKPtr(stiffness);
+  ds.push_back(slow);
+
+  // fast: 0.01 q2'' + 4 (q2 + 0.05) = 0, q2(0) = q1(0)
+  mass.reset(new SimpleMatrix(1, 1));
+  stiffness.reset(new SimpleMatrix(1, 1));
+  (*mass)(0, 0) = 0.01;
+  (*stiffness)(0, 0) = 4.;
+  SP::LagrangianLinearTIDS fast(new LagrangianLinearTIDS(SP::SiconosVector(new SiconosVector(1, 0.1)),
+                                                         SP::SiconosVector(new SiconosVector(1, 0.)),
+                                                         mass));
+  fast->setKPtr(stiffness);
+  fast->setFExtPtr(SP::SiconosVector(new SiconosVector(1, -0.2)));
+  ds.push_back(fast);
+
+  for(unsigned int i = 0; i < ds.size(); ++i)
+    nsds->insertDynamicalSystem(ds[i]);
+
+  // q2 - q1 >= 0
+  SP::SimpleMatrix H(new SimpleMatrix(1, 2));
+  (*H)(0, 0) = -1.;
+  (*H)(0, 1) = 1.;
+  inter.reset(new Interaction(SP::NonSmoothLaw(new NewtonImpactNSL(0.)),
+                              SP::Relation(new LagrangianLinearTIR(H))));
+  nsds->link(inter, slow, fast);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(_t0, h));
+  SP::TimeStepping sim;
+  if(subSteps)
+  {
+    SP::TimeSteppingMultirate multirate(new TimeSteppingMultirate(nsds, td, SP::OneStepIntegrator(),
+                                                                  SP::LCP(new LCP())));
+    SP::MoreauJeanOSI osiSlow(new MoreauJeanOSI(0.5));
+    SP::MoreauJeanOSI osiFast(new MoreauJeanOSI(0.5));
+    osiFast->setSubSteps(subSteps);
+    multirate->associate(osiSlow, slow);
+    multirate->associate(osiFast, fast);
+    if(subSteps > 1)
+      multirate->setSubStepsNonSmoothProblem(SP::LCP(new LCP()), subSteps);
+    sim = multirate;
+  }
+  else
+    sim.reset(new TimeStepping(nsds, td, SP::MoreauJeanOSI(new MoreauJeanOSI(0.5)),
+                               SP::LCP(new LCP())));
+  sim->initialize();
+  return sim;
+}
+
+void TimeSteppingMultirateTest::testCrossRateInteraction()
+{
+  std::cout << "--> Test: Interaction between dynamical systems with different numbers of sub-steps." << std::endl;
+  unsigned int subSteps = 4;
+  std::vector<SP::LagrangianDS> ds, dsRef, dsSame, dsCoarse;
+  SP::Interaction inter, interRef, interSame, interCoarse;
+  SP::TimeStepping sim = oscillators(subSteps, _h, ds, inter);
+  // reference: one integrator with the step of the fast oscillator
+  SP::TimeStepping ref = oscillators(0, _h / subSteps, dsRef, interRef);
+  // the integrators of the two oscillators without sub-steps
+  SP::TimeStepping same = oscillators(1, _h / subSteps, dsSame, interSame);
+  // one integrator with the step of the slow oscillator
+  SP::TimeStepping coarse = oscillators(0, _h, dsCoarse, interCoarse);
+
+  unsigned int open = 0, closed = 0;
+  double error = 0., errorCoarse = 0.;
+  while(sim->hasNextEvent())
+  {
+    sim->computeOneStep();
+    sim->nextStep();
+    coarse->computeOneStep();
+    coarse->nextStep();
+    for(unsigned int j = 0; j < subSteps; ++j)
+    {
+      ref->computeOneStep();
+      ref->nextStep();
+      same->computeOneStep();
+      same->nextStep();
+      for(unsigned int i = 0; i < ds.size(); ++i)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testCrossRateInteraction : same step",
+                                             (*dsRef[i]->q())(0), (*dsSame[i]->q())(0), 1e-12);
+    }
+    CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("testCrossRateInteraction : time",
+                                         ref->startingTime(), sim->startingTime(), 1e-12);
+    for(unsigned int i = 0; i < ds.size(); ++i)
+    {
+      error = std::max(error, fabs((*ds[i]->q())(0) - (*dsRef[i]->q())(0)));
+      errorCoarse = std::max(errorCoarse, fabs((*dsCoarse[i]->q())(0) - (*dsRef[i]->q())(0)));
+    }
+
+    // the fast oscillator does not go through the slow one
+    double gap = (*ds[1]->q())(0) - (*ds[0]->q())(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testCrossRateInteraction : contact", gap > - 1e-3, true);
+    if(gap > 1e-3)
+      open++;
+    else
+      closed++;
+  }
+  std::cout << "error " << error << ", with the step of the slow oscillator " << errorCoarse << std::endl;
+  // the contact opens and closes
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCrossRateInteraction : open", open > 0, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCrossRateInteraction : closed", closed > 0, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCrossRateInteraction : error", error < _tol, true);
+  // the sub-steps of the fast oscillator improve the single rate
+  // simulation with the step of the slow one
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testCrossRateInteraction : coarse", error < errorCoarse, true);
+  std::cout << "--> Test: Interaction between dynamical systems with different numbers of sub-steps ended with success." << std::endl;
+}
@@ -0,0 +1,71 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef __TimeSteppingMultirateTest__
+#define __TimeSteppingMultirateTest__
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "LagrangianDS.hpp"
+#include "Interaction.hpp"
+#include "TimeStepping.hpp"
+
+class TimeSteppingMultirateTest : public CppUnit::TestFixture
+{
+
+private:
+  /** serialization hooks
+  */
+  ACCEPT_SERIALIZATION(TimeSteppingMultirateTest);
+
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(TimeSteppingMultirateTest);
+
+  // tests to be done ...
+
+  CPPUNIT_TEST(testCrossRateInteraction);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  void testCrossRateInteraction();
+
+  /** a slow and a fast oscillators, the fast one pressed against the
+   * slow one by a unilateral contact
+   * \param subSteps the number of sub-steps of the fast oscillator, or
+   * 0 for a TimeStepping with one integrator
+   * \param h the time step
+   * \param ds the slow and the fast oscillators (out)
+   * \param inter the contact (out)
+   * \return the simulation
+   */
+  SP::TimeStepping oscillators(unsigned int subSteps, double h,
+                               std::vector<SP::LagrangianDS>& ds, SP::Interaction& inter);
+
+  // Members
+
+  double _h;
+  double _t0;
+  double _T;
+  double _tol;
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
@@ -0,0 +1,247 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "FiniteDifferenceJacobian.hpp"
+#include "SiconosVector.hpp"
+#include "SiconosMatrix.hpp"
+#include "SiconosMatrixException.hpp"
+#include <algorithm>
+#include <cmath>
+
+FiniteDifferenceJacobian::FiniteDifferenceJacobian(unsigned int outputSize, unsigned int inputSize, double epsilon):
+  _outputSize(outputSize), _inputSize(inputSize), _epsilon(epsilon), _probe(false),
+  _probeStates(1), _probeScale(0.), _probed(false), _numberOfEvaluations(0)
+{
+  _xeps.reset(new SiconosVector(inputSize));
+  _f0.reset(new SiconosVector(outputSize));
+  _f1.reset(new SiconosVector(outputSize));
+  setDensePattern();
+}
+
+FiniteDifferenceJacobian::FiniteDifferenceJacobian(const FiniteDifferenceJacobian& other):
+  _outputSize(other._outputSize), _inputSize(other._inputSize), _epsilon(other._epsilon),
+  _probe(other._probe), _probeStates(other._probeStates), _probeScale(other._probeScale),
+  _probed(other._probed), _columnStart(other._columnStart), _rowIndex(other._rowIndex),
+  _colorColumns(other._colorColumns), _numberOfEvaluations(0)
+{
+  _xeps.reset(new SiconosVector(_inputSize));
+  _f0.reset(new SiconosVector(_outputSize));
+  _f1.reset(new SiconosVector(_outputSize));
+}
+
+void FiniteDifferenceJacobian::setDensePattern()
+{
+  _columnStart.resize(_inputSize + 1);
+  _rowIndex.resize(_inputSize * _outputSize);
+  for(unsigned int j = 0; j < _inputSize; ++j)
+  {
+    _columnStart[j] = j * _outputSize;
+    for(unsigned int i = 0; i < _outputSize; ++i)
+      _rowIndex[j * _outputSize + i] = i;
+  }
+  _columnStart[_inputSize] = _inputSize * _outputSize;
+  _probe = false;
+  _probed = false;
+  colorColumns();
+}
+
+void FiniteDifferenceJacobian::setSparsityPattern(const std::vector<unsigned int>& rows,
+                                                  const std::vector<unsigned int>& columns)
+{
+  if(rows.size() != columns.size())
+    SiconosMatrixException::selfThrow("FiniteDifferenceJacobian::setSparsityPattern - rows and columns must have the same size.");
+
+  // sort the entries by column, with no duplicate
+  std::vector<std::vector<unsigned int> > entries(_inputSize);
+  for(unsigned int k = 0; k < rows.size(); ++k)
+  {
+    if(rows[k] >= _outputSize || columns[k] >= _inputSize)
+      SiconosMatrixException::selfThrow("FiniteDifferenceJacobian::setSparsityPattern - entry out of the Jacobian.");
+    entries[columns[k]].push_back(rows[k]);
+  }
+  _columnStart.assign(1, 0);
+  _rowIndex.clear();
+  for(unsigned int j = 0; j < _inputSize; ++j)
+  {
+    std::sort(entries[j].begin(), entries[j].end());
+    entries[j].erase(std::unique(entries[j].begin(), entries[j].end()), entries[j].end());
+    _rowIndex.insert(_rowIndex.end(), entries[j].begin(), entries[j].end());
+    _columnStart.push_back(_rowIndex.size());
+  }
+  _probe = false;
+  _probed = false;
+  colorColumns();
+}
+
+void FiniteDifferenceJacobian::setSparsityPattern(const SiconosMatrix& pattern)
+{
+  if(pattern.size(0) != _outputSize || pattern.size(1) != _inputSize)
+    SiconosMatrixException::selfThrow("FiniteDifferenceJacobian::setSparsityPattern - inconsistent sizes of the pattern.");
+  std::vector<unsigned int> rows, columns;
+  for(unsigned int j = 0; j < _inputSize; ++j)
+    for(unsigned int i = 0; i < _outputSize; ++i)
+      if(pattern.getValue(i, j) != 0.0)
+      {
+        rows.push_back(i);
+        columns.push_back(j);
+      }
+  setSparsityPattern(rows, columns);
+}
+
+void FiniteDifferenceJacobian::colorColumns()
+{
+  // columns of each row
+  std::vector<std::vector<unsigned int> > rowColumns(_outputSize);
+  for(unsigned int j = 0; j < _inputSize; ++j)
+    for(unsigned int k = _columnStart[j]; k < _columnStart[j + 1]; ++k)
+      rowColumns[_rowIndex[k]].push_back(j);
+
+  // greedy coloring, in the order of the columns: the smallest color
+  // not used by a column sharing a row with j. forbidden[c] == j if
+  // the color c is used by such a column.
+  std::vector<int> color(_inputSize, -1);
+  std::vector<unsigned int> forbidden;
+  _colorColumns.clear();
+  for(unsigned int j = 0; j < _inputSize; ++j)
+  {
+    if(_columnStart[j] == _columnStart[j + 1])
+      continue; // no entry: the column is not computed
+    for(unsigned int k = _columnStart[j]; k < _columnStart[j + 1]; ++k)
+    {
+      const std::vector<unsigned int>& neighbours = rowColumns[_rowIndex[k]];
+      for(unsigned int l = 0; l < neighbours.size(); ++l)
+        if(color[neighbours[l]] >= 0)
+          forbidden[color[neighbours[l]]] = j;
+    }
+    unsigned int c = 0;
+    while(c < forbidden.size() && forbidden[c] == j)
+      ++c;
+    if(c == forbidden.size())
+    {
+      forbidden.push_back(_inputSize);
+      _colorColumns.push_back(std::vector<unsigned int>());
+    }
+    color[j] = c;
+    _colorColumns[c].push_back(j);
+  }
+}
+
+void FiniteDifferenceJacobian::probe(Function& f, SP::SiconosVector x, SiconosMatrix& J)
+{
+  // the entries found by a previous probe are kept
+  std::vector<std::vector<bool> > nonzero(_inputSize, std::vector<bool>(_outputSize, false));
+  if(_probed)
+    for(unsigned int j = 0; j < _inputSize; ++j)
+      for(unsigned int k = _columnStart[j]; k < _columnStart[j + 1]; ++k)
+        nonzero[j][_rowIndex[k]] = true;
+
+  // the state s = 0 is x, where J is computed, the other ones are
+  // drawn around x by a linear congruential sequence
+  SiconosVector state(*x);
+  SiconosVector fstate(*_f0);
+  unsigned int seed = 1;
+  for(unsigned int s = 0; s < _probeStates; ++s)
+  {
+    if(s > 0)
+    {
+      for(unsigned int j = 0; j < _inputSize; ++j)
+      {
+        seed = seed * 1103515245u + 12345u;
+        double r = 0.5 + 0.5 * ((seed >> 16) & 0x7fff) / 32767.;
+        if(seed & 0x8000u)
+          r = -r;
+        state(j) = (*x)(j) + _probeScale * (1. + fabs((*x)(j))) * r;
+      }
+      *_xeps = state;
+      f.compute(_xeps, _f1);
+      ++_numberOfEvaluations;
+      fstate = *_f1;
+    }
+
+    // one column at a time
+    *_xeps = state;
+    for(unsigned int j = 0; j < _inputSize; ++j)
+    {
+      (*_xeps)(j) += _epsilon;
+      f.compute(_xeps, _f1);
+      ++_numberOfEvaluations;
+      (*_xeps)(j) = state(j);
+      for(unsigned int i = 0; i < _outputSize; ++i)
+      {
+        double df = (*_f1)(i) - fstate(i);
+        if(df != 0.0)
+        {
+          nonzero[j][i] = true;
+          if(s == 0)
+            J.setValue(i, j, df / _epsilon);
+        }
+      }
+    }
+  }
+  *_xeps = *x;
+
+  _columnStart.assign(1, 0);
+  _rowIndex.clear();
+  for(unsigned int j = 0; j < _inputSize; ++j)
+  {
+    for(unsigned int i = 0; i < _outputSize; ++i)
+      if(nonzero[j][i])
+        _rowIndex.push_back(i);
+    _columnStart.push_back(_rowIndex.size());
+  }
+  _probe = false;
+  _probed = true;
+  colorColumns();
+}
+
+void FiniteDifferenceJacobian::compute(Function& f, SP::SiconosVector x, SiconosMatrix& J)
+{
+  if(J.size(0) != _outputSize || J.size(1) != _inputSize || x->size() != _inputSize)
+    SiconosMatrixException::selfThrow("FiniteDifferenceJacobian::compute - inconsistent sizes.");
+
+  *_xeps = *x;
+  f.compute(x, _f0);
+  ++_numberOfEvaluations;
+  J.zero();
+
+  if(_probe)
+  {
+    probe(f, x, J);
+    return;
+  }
+
+  // all the columns of a color at once: their rows are disjoint
+  for(unsigned int c = 0; c < _colorColumns.size(); ++c)
+  {
+    const std::vector<unsigned int>& columns = _colorColumns[c];
+    for(unsigned int l = 0; l < columns.size(); ++l)
+      (*_xeps)(columns[l]) += _epsilon;
+    f.compute(_xeps, _f1);
+    ++_numberOfEvaluations;
+    for(unsigned int l = 0; l < columns.size(); ++l)
+    {
+      unsigned int j = columns[l];
+      (*_xeps)(j) = (*x)(j);
+      for(unsigned int k = _columnStart[j]; k < _columnStart[j + 1]; ++k)
+      {
+        unsigned int i = _rowIndex[k];
+        J.setValue(i, j, ((*_f1)(i) - (*_f0)(i)) / _epsilon);
+      }
+    }
+  }
+}
@@ -0,0 +1,208 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file FiniteDifferenceJacobian.hpp
+  \brief Jacobian of a vector function by finite differences, with a sparsity pattern and column coloring
+*/
+
+#ifndef FiniteDifferenceJacobian_H
+#define FiniteDifferenceJacobian_H
+
+#include "SiconosFwd.hpp"
+#include "SiconosSerialization.hpp"
+#include <vector>
+
+/** Jacobian of a function \f$ f: R^n \to R^m \f$ by forward
+ *  finite differences, \f$ J_{ij} = (f_i(x + h e_j) - f_i(x)) / h \f$.
+ *
+ *  Two columns of J which have no nonzero entry in the same row can be
+ *  computed with one evaluation of f, by perturbing both entries of x
+ *  at once. The columns are grouped by a greedy coloring of their
+ *  intersection graph (two columns sharing a row get different
+ *  colors), and the Jacobian costs one evaluation of f per color
+ *  instead of one per column: a banded Jacobian of bandwidth b needs
+ *  about 2b+1 evaluations, whatever n.
+ *
+ *  The sparsity pattern is
+ *  - dense by default: one color per column, as a plain finite
+ *    difference scheme,
+ *  - declared with setSparsityPattern(),
+ *  - or probed (probeSparsityPattern()): the next compute() perturbs
+ *    the columns one at a time, at the current point and at a few
+ *    states around it, and keeps the entries that are not zero at one
+ *    of them. An entry which vanishes by chance at all the probed
+ *    states is still lost, so that a declared pattern is safer. The
+ *    probe may be requested again later, its entries are then added
+ *    to the probed pattern.
+ *
+ *  The pattern, the coloring and the work vectors are kept from one
+ *  call to the other, for instance between the Newton iterations of
+ *  an integrator.
+ */
+class FiniteDifferenceJacobian
+{
+public:
+
+  /** the function whose Jacobian is computed */
+  class Function
+  {
+  public:
+    virtual ~Function() {};
+
+    /** compute f(x)
+     *  \param x the point (of size inputSize)
+     *  \param[out] fx the value (of size outputSize)
+     */
+    virtual void compute(SP::SiconosVector x, SP::SiconosVector fx) = 0;
+  };
+
+private:
+  /** serialization hooks
+   */
+  ACCEPT_SERIALIZATION(FiniteDifferenceJacobian);
+
+  /** sizes of f and of x */
+  unsigned int _outputSize;
+  unsigned int _inputSize;
+
+  /** the perturbation h */
+  double _epsilon;
+
+  /** if true, the next compute() probes the sparsity pattern */
+  bool _probe;
+
+  /** number of states and relative distance of the probe */
+  unsigned int _probeStates;
+  double _probeScale;
+
+  /** true if the pattern was probed: a new probe adds its entries */
+  bool _probed;
+
+  /** the sparsity pattern, by columns (compressed column storage) */
+  std::vector<unsigned int> _columnStart;
+  std::vector<unsigned int> _rowIndex;
+
+  /** the columns of each color */
+  std::vector<std::vector<unsigned int> > _colorColumns;
+
+  /** work vectors: perturbed point, f(x) and f(x + h sum e_j) */
+  SP::SiconosVector _xeps;
+  SP::SiconosVector _f0;
+  SP::SiconosVector _f1;
+
+  /** number of evaluations of f since the creation */
+  unsigned int _numberOfEvaluations;
+
+  /** default constructor */
+  FiniteDifferenceJacobian() {};
+
+  /** color the columns of the current pattern */
+  void colorColumns();
+
+  /** probe the pattern and compute the Jacobian at x, see compute() */
+  void probe(Function& f, SP::SiconosVector x, SiconosMatrix& J);
+
+public:
+
+  /** constructor, with a dense pattern
+   *  \param outputSize the size m of f
+   *  \param inputSize the size n of x
+   *  \param epsilon the perturbation h
+   */
+  FiniteDifferenceJacobian(unsigned int outputSize, unsigned int inputSize, double epsilon);
+
+  /** copy constructor: the pattern is copied, not the work vectors
+   *  \param other the engine to copy
+   */
+  FiniteDifferenceJacobian(const FiniteDifferenceJacobian& other);
+
+  /** destructor */
+  virtual ~FiniteDifferenceJacobian() {};
+
+  /** \return the perturbation h */
+  inline double epsilon() const
+  {
+    return _epsilon;
+  };
+
+  /** set the perturbation h
+   *  \param epsilon the new value
+   */
+  inline void setEpsilon(double epsilon)
+  {
+    _epsilon = epsilon;
+  };
+
+  /** use a dense pattern: one evaluation of f per column */
+  void setDensePattern();
+
+  /** declare the sparsity pattern
+   *  \param rows the rows of the entries which may be nonzero
+   *  \param columns their columns
+   */
+  void setSparsityPattern(const std::vector<unsigned int>& rows,
+                          const std::vector<unsigned int>& columns);
+
+  /** declare the sparsity pattern from the nonzero entries of a matrix
+   *  \param pattern a matrix of size outputSize x inputSize
+   */
+  void setSparsityPattern(const SiconosMatrix& pattern);
+
+  /** probe the sparsity pattern at the next call of compute(x), at
+   *  x and at numberOfStates - 1 states around it, whose entries are
+   *  \f$ x_j + s (1 + |x_j|) r_j \f$, with \f$ s \f$ the scale and
+   *  \f$ 0.5 \leq |r_j| \leq 1 \f$ drawn from a fixed sequence. The
+   *  Jacobian is computed at x.
+   *  \param numberOfStates the number of probed states
+   *  \param scale the relative distance of the other states
+   */
+  inline void probeSparsityPattern(unsigned int numberOfStates = 3, double scale = 1e-2)
+  {
+    _probe = true;
+    _probeStates = numberOfStates > 0 ? numberOfStates : 1;
+    _probeScale = scale;
+  };
+
+  /** \return the number of entries of the pattern */
+  inline unsigned int patternSize() const
+  {
+    return _rowIndex.size();
+  };
+
+  /** \return the number of colors, that is the number of evaluations
+   *  of f (besides f(x)) needed by compute() */
+  inline unsigned int numberOfColors() const
+  {
+    return _colorColumns.size();
+  };
+
+  /** \return the number of evaluations of f since the creation */
+  inline unsigned int numberOfEvaluations() const
+  {
+    return _numberOfEvaluations;
+  };
+
+  /** compute the Jacobian of f at x. The entries out of the pattern are set to zero.
+   *  \param f the function
+   *  \param x the point, unchanged on output
+   *  \param[out] J the Jacobian, of size outputSize x inputSize
+   */
+  void compute(Function& f, SP::SiconosVector x, SiconosMatrix& J);
+};
+
+#endif
@@ -54,6 +54,8 @@
 
 #include "SiconosVisitor.hpp"
 
+#include "SiconosStorage.hpp"
+
 /** Const from old version of SiconosVector - To be reviewed */
 const char N_DOUBLE_PRECISION[] = "%1.52e "; // double mantisse precision /!\ DEPENDS ON MACHINE
 const unsigned int M_MAXSIZEFORDISPLAY = 10;
@@ -127,8 +129,12 @@ namespace ublas = boost::numeric::ublas;
 
 /* Various matrix types available in Siconos */
 
-/** DenseMat is a typedef of boost::ublas::numeric::matrix<double, column_major, std::vector<double> >  */
-typedef ublas::matrix<double, ublas::column_major, std::vector<double> > DenseMat;
+/** Storage of dense vectors and matrices : a std::vector which may
+    borrow its memory (see SiconosStorage.hpp) */
+typedef SiconosStorage<double> DenseStorage;
+
+/** DenseMat is a typedef of boost::ublas::numeric::matrix<double, column_major, DenseStorage >  */
+typedef ublas::matrix<double, ublas::column_major, DenseStorage > DenseMat;
 
 TYPEDEF_SPTR(DenseMat)
 
@@ -176,9 +182,9 @@ TYPEDEF_SPTR(complex_matrix)
 
 /** Various vector types available in Siconos **/
 
-/** DenseVect is a typedef of boost::ublas::numeric::vector<double, std::vector<double> >
+/** DenseVect is a typedef of boost::ublas::numeric::vector<double, DenseStorage >
  */
-typedef ublas::vector<double, std::vector<double> > DenseVect;
+typedef ublas::vector<double, DenseStorage > DenseVect;
 TYPEDEF_SPTR(DenseVect)
 
 /** SparseVect is a typedef of boost::ublas::numeric::mapped<double>
@@ -235,6 +235,21 @@ bool SiconosMatrix::fillTriplet(CSparseMatrix* triplet, size_t row_off, size_t c
       }
     }
   }
+  else if (_num == 4)
+  {
+    const Index& ptr = sparse()->index1_data();
+    const Index& indx = sparse()->index2_data();
+    const ublas::unbounded_array<double>& vals = sparse()->value_data();
+
+    // column-major compressed storage
+    for (size_t j = 0; j < ncol; ++j)
+    {
+      for (size_t k = ptr[j]; k < ptr[j+1]; ++k)
+      {
+        CSparseMatrix_zentry(triplet, indx[k] + row_off, j + col_off, vals[k]);
+      }
+    }
+  }
   else
   {
      SiconosMatrixException::selfThrow("SiconosMatrix::fillCSC not implemented for the given matrix type");
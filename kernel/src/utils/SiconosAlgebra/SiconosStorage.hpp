@@ -0,0 +1,296 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file SiconosStorage.hpp
+  \brief storage of dense vectors and matrices.
+
+  The allocator behaves like std::allocator, except that it may be
+  given an externally owned array at construction. The first
+  allocation which fits in this array returns it instead of heap
+  memory, the next ones always use the heap; elements living in it are
+  not initialized and the array is never released. This is what allows SiconosVector
+  and SimpleMatrix to be views on memory owned by someone else (a
+  numpy array for instance) while keeping std::vector as storage.
+  This requires C++11 allocator support (allocator_traits).
+
+  Copies of a container do not inherit the external array (see
+  select_on_container_copy_construction): only the container built on
+  it borrows the memory. If the container has to grow beyond the
+  external array, it silently moves to heap memory.
+
+  ublas assigns an expression to a vector or a matrix by computing it
+  in a temporary and swapping the storages: SiconosStorage::swap copies
+  the elements instead when one of the storages is borrowed, so that
+  the external array keeps seeing the values.
+*/
+
+#ifndef SiconosStorage_hpp
+#define SiconosStorage_hpp
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include "SiconosConfig.h"
+
+#if __cplusplus >= 201103L
+#include <type_traits>
+#include <utility>
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <boost/numeric/bindings/std/vector.hpp>
+
+template <class T>
+class SiconosAllocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+#if __cplusplus >= 201103L
+  /* copies own their memory, but moves and swaps carry the external
+   * array along with the data living in it. */
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+#endif
+
+  template <class U>
+  struct rebind
+  {
+    typedef SiconosAllocator<U> other;
+  };
+
+  /** default allocator: plain heap memory */
+  SiconosAllocator() : _external(NULL), _externalSize(0), _externalUsed(false) {};
+
+  /** allocator lending an externally owned array
+   * \param external the array (not owned)
+   * \param size its number of elements
+   */
+  SiconosAllocator(T* external, size_type size) :
+    _external(external), _externalSize(size), _externalUsed(false) {};
+
+  SiconosAllocator(const SiconosAllocator& other) :
+    _external(other._external), _externalSize(other._externalSize),
+    _externalUsed(other._externalUsed) {};
+
+  /** rebound allocators never borrow */
+  template <class U>
+  SiconosAllocator(const SiconosAllocator<U>&) :
+    _external(NULL), _externalSize(0), _externalUsed(false) {};
+
+  SiconosAllocator& operator=(const SiconosAllocator& other)
+  {
+    _external = other._external;
+    _externalSize = other._externalSize;
+    _externalUsed = other._externalUsed;
+    return *this;
+  };
+
+  /** \return an allocator without external memory, used for container copies */
+  SiconosAllocator select_on_container_copy_construction() const
+  {
+    return SiconosAllocator();
+  };
+
+  /** \param p an address
+   * \return true if p is inside the external array */
+  inline bool isBorrowed(const T* p) const
+  {
+    return _external && p >= _external && p < _external + _externalSize;
+  };
+
+  /** \return the external array, NULL if none */
+  inline T* external() const
+  {
+    return _external;
+  };
+
+  pointer allocate(size_type n, const void* = 0)
+  {
+    // the external array is lent once: a container which reallocates
+    // while its data lives in it must not get the same array back
+    if (_external && !_externalUsed && n <= _externalSize)
+    {
+      _externalUsed = true;
+      return _external;
+    }
+    return static_cast<pointer>(::operator new(n * sizeof(T)));
+  };
+
+  void deallocate(pointer p, size_type)
+  {
+    if (p != _external)
+      ::operator delete(p);
+  };
+
+#if __cplusplus >= 201103L
+  /* value-initialization is skipped in the external array, which
+   * already holds the data */
+  template <class U>
+  void construct(U* p)
+  {
+    if (!isBorrowed(p))
+      ::new(static_cast<void*>(p)) U();
+  };
+
+  template <class U, class A0, class... Args>
+  void construct(U* p, A0&& a0, Args&&... args)
+  {
+    ::new(static_cast<void*>(p)) U(std::forward<A0>(a0), std::forward<Args>(args)...);
+  };
+
+  template <class U>
+  void destroy(U* p)
+  {
+    p->~U();
+  };
+#else
+  void construct(pointer p, const T& val)
+  {
+    ::new(static_cast<void*>(p)) T(val);
+  };
+
+  void destroy(pointer p)
+  {
+    p->~T();
+  };
+#endif
+
+  pointer address(reference x) const
+  {
+    return &x;
+  };
+
+  const_pointer address(const_reference x) const
+  {
+    return &x;
+  };
+
+  size_type max_size() const
+  {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  };
+
+private:
+  T* _external;
+  size_type _externalSize;
+  bool _externalUsed;
+};
+
+template <class T, class U>
+inline bool operator==(const SiconosAllocator<T>& a, const SiconosAllocator<U>& b)
+{
+  return static_cast<const void*>(a.external()) == static_cast<const void*>(b.external());
+}
+
+template <class T, class U>
+inline bool operator!=(const SiconosAllocator<T>& a, const SiconosAllocator<U>& b)
+{
+  return !(a == b);
+}
+
+/** std::vector using SiconosAllocator, with a swap which keeps borrowed
+ * memory in place */
+template <class T>
+class SiconosStorage : public std::vector<T, SiconosAllocator<T> >
+{
+public:
+  typedef std::vector<T, SiconosAllocator<T> > base_type;
+  typedef typename base_type::size_type size_type;
+
+  SiconosStorage() {};
+
+  explicit SiconosStorage(size_type size) : base_type(size) {};
+
+  SiconosStorage(size_type size, const T& value) : base_type(size, value) {};
+
+  /* no move operations: a move would carry the external array away */
+  SiconosStorage(const SiconosStorage& other) : base_type(other) {};
+
+  SiconosStorage& operator=(const SiconosStorage& other)
+  {
+    base_type::operator=(other);
+    return *this;
+  };
+
+  /** \return true if the elements live in an external array */
+  inline bool isBorrowed() const
+  {
+    return !this->empty() && this->get_allocator().isBorrowed(&(*this)[0]);
+  };
+
+  /** exchange the content of two storages. The elements are copied if
+   * one of them is borrowed and the sizes match, the memory is
+   * exchanged otherwise.
+   * \param other the storage to swap with
+   */
+  void swap(SiconosStorage& other)
+  {
+    if (this->size() == other.size() && (isBorrowed() || other.isBorrowed()))
+      std::swap_ranges(this->begin(), this->end(), other.begin());
+    else
+      base_type::swap(other);
+  };
+};
+
+namespace boost { namespace numeric { namespace bindings { namespace detail {
+/* the storage is seen by the lapack and blas bindings as the
+ * std::vector it is made of */
+template <typename T, typename Id, typename Enable>
+struct adaptor<SiconosStorage<T>, Id, Enable> :
+    adaptor<std::vector<T, SiconosAllocator<T> >, Id, Enable> {};
+} } } }
+
+/** make a std::vector use the elements of an external array (no
+ * copy, no initialization). Previous content of the container is lost.
+ * Without C++11 allocator support, the values are copied instead.
+ * \param storage the container
+ * \param data the array (not owned)
+ * \param size its number of elements
+ */
+template <class T>
+void borrowStorage(std::vector<T, SiconosAllocator<T> >& storage, T* data, std::size_t size)
+{
+#if __cplusplus >= 201103L
+  std::vector<T, SiconosAllocator<T> > borrowed(size, SiconosAllocator<T>(data, size));
+  storage.swap(borrowed);
+#else
+  storage.assign(data, data + size);
+#endif
+}
+
+/** make a std::vector own a copy of its elements, if they live in an
+ * external array
+ * \param storage the container
+ */
+template <class T>
+void ownStorage(std::vector<T, SiconosAllocator<T> >& storage)
+{
+  std::vector<T, SiconosAllocator<T> > own(storage.begin(), storage.end());
+  storage.swap(own);
+}
+
+#endif
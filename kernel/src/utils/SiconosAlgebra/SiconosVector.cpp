@@ -158,6 +158,14 @@ SiconosVector::SiconosVector(const std::vector<double>& v, Siconos::UBLAS_TYPE t
   std::copy(v.begin(), v.end(), (vect.Dense)->begin());
 }
 
+// parameters: an external array and its size, no copy.
+SiconosVector::SiconosVector(double* data, unsigned int row)
+{
+  _dense = true;
+  vect.Dense = new DenseVect();
+  borrowStorage(vect.Dense->data(), data, row);
+}
+
 // Copy
 SiconosVector::SiconosVector(const SiconosVector &svect) : std11::enable_shared_from_this<SiconosVector>()
 {
@@ -300,6 +308,11 @@ double* SiconosVector::getArray() const
   return &(((*vect.Dense).data())[0]);
 }
 
+bool SiconosVector::isBorrowed() const
+{
+  return _dense && vect.Dense->data().isBorrowed();
+}
+
 // ===========================
 //       fill vector
 // ===========================
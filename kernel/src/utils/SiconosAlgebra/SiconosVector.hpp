@@ -89,6 +89,14 @@ public:
    */
   SiconosVector(const std::vector<double>& vec, Siconos::UBLAS_TYPE type = Siconos::DENSE);
 
+  /** constructor of a dense vector which uses an external array as
+   *  storage (no copy). The array is not owned and must outlive the
+   *  vector. Operations which resize the vector move it to its own memory.
+   *  \param data the array of values
+   *  \param row the size of the vector
+   */
+  SiconosVector(double* data, unsigned int row);
+
   /** copy constructor
    *  \param v SiconosVector
    */
@@ -176,6 +184,12 @@ public:
    */
   double* getArray() const;
 
+  /** true if the values are stored in an external array
+   *  (see SiconosVector(double*, unsigned int))
+   * \return a bool
+   */
+  bool isBorrowed() const;
+
   /** sets all the values of the vector to 0.0
    */
   void zero();
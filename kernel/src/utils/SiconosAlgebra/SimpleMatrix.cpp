@@ -117,6 +117,16 @@ SimpleMatrix::SimpleMatrix(unsigned int row, unsigned int col, double inputValue
     SiconosMatrixException::selfThrow("SiconosMatrix::constructor(UBLAS_TYPE type, unsigned int row, unsigned int col, double fillInValue): invalid type.");
 }
 
+// parameters: an external (column-major) array and the dimensions, no copy.
+SimpleMatrix::SimpleMatrix(double* data, unsigned int row, unsigned int col):
+  SiconosMatrix(1), _isPLUFactorized(false), _isQRFactorized(false), _isPLUInversed(false)
+{
+  mat.Dense = new DenseMat();
+  borrowStorage(mat.Dense->data(), data, row * col);
+  // the storage has already the right size, only the dimensions are set
+  mat.Dense->resize(row, col, false);
+}
+
 // // parameters: a vector (stl) of double and the type.
 // SimpleMatrix::SimpleMatrix(const std::vector<double>& v, unsigned int row, unsigned int col, UBLAS_TYPE typ, unsigned int lower, unsigned int upper):
 //   SiconosMatrix(1, row, col), _isPLUFactorized(false), _isQRFactorized(false), _isPLUInversed(false)
@@ -245,7 +255,8 @@ SimpleMatrix::SimpleMatrix(const SiconosMatrix &m): SiconosMatrix(m.num()), _isP
   unsigned int numM = m.num();
 
 
-  _isPLUFactorized= m.isPLUFactorized();
+  // the LU factors of a sparse matrix are not copied
+  _isPLUFactorized= m.isPLUFactorized() && numM != 4;
   _isPLUInversed= m.isPLUInversed();
 
   if (m.ipiv())
@@ -526,7 +537,7 @@ void SimpleMatrix::zero()
   unsigned int size1 = size(0);
   unsigned int size2 = size(1);
   if (_num == 1)
-    *mat.Dense = ublas::zero_matrix<double>(size1, size2);
+    noalias(*mat.Dense) = ublas::zero_matrix<double>(size1, size2);
   else if (_num == 2)
     *mat.Triang = ublas::zero_matrix<double>(size1, size2);
 
@@ -568,7 +579,7 @@ void SimpleMatrix::eye()
   unsigned int size1 = size(0);
   unsigned int size2 = size(1);
   if (_num == 1)
-    *mat.Dense = ublas::identity_matrix<double>(size1, size2);
+    noalias(*mat.Dense) = ublas::identity_matrix<double>(size1, size2);
 
   else if (_num == 2)
     *mat.Triang = ublas::identity_matrix<double>(size1, size2);
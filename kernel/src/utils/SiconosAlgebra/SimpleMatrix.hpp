@@ -61,6 +61,12 @@ private:
    */
   SP::VInt _ipiv;
 
+  /** SP::NumericsMatrix _sparseLU;
+   * copy of a sparse matrix in the compressed column format of
+   * Numerics, holding its LU factors (PLUFactorizationInPlace)
+   */
+  SP::NumericsMatrix _sparseLU;
+
   /** bool _isPLUFactorized;
    *  Boolean = true if the Matrix has been PLU Factorized in place.
    */
@@ -180,6 +186,16 @@ public:
                Siconos::UBLAS_TYPE typ = Siconos::DENSE,
                unsigned int upper = 1, unsigned int lower = 1);
 
+  /** constructor of a dense matrix which uses an external array
+   *  (column-major) as storage (no copy). The array is not owned and
+   *  must outlive the matrix. Operations which resize the matrix move
+   *  it to its own memory.
+   *  \param data the array of values
+   *  \param row number of rows.
+   *  \param col number of columns.
+   */
+  SimpleMatrix(double* data, unsigned int row, unsigned int col);
+
   /** copy constructor
    *  \param smat the matrix to copy
    */
@@ -614,6 +630,9 @@ public:
 
   /** computes an LU factorization of a general M-by-N matrix using partial pivoting with row interchanges.
    *  The result is returned in this (InPlace). Based on Blas dgetrf function.
+   *  A sparse matrix is left unchanged: it is copied in the compressed
+   *  column format of Numerics and factorized by its sparse direct solver
+   *  (NM_gesv_expert), the factors being kept for the next solves.
    */
   void PLUFactorizationInPlace();
 
@@ -96,8 +96,14 @@ void SimpleMatrix::trans()
   switch (_num)
   {
   case 1:
-    *mat.Dense = ublas::trans(*mat.Dense);
+  {
+    // through a copy written back in place, so that a matrix using an
+    // external array (see SimpleMatrix(double*, ...)) keeps it
+    DenseMat tmp = ublas::trans(*mat.Dense);
+    mat.Dense->resize(tmp.size1(), tmp.size2(), false);
+    noalias(*mat.Dense) = tmp;
     break;
+  }
   case 2:
     SiconosMatrixException::selfThrow("SimpleMatrix::trans() failed, the matrix is triangular matrix and can not be transposed in place.");
     break;
@@ -38,7 +38,8 @@ namespace lapack = boost::numeric::bindings::lapack;
 
 
 #include "SiconosVector.hpp"
-#include "cholesky.hpp"
+#include "NumericsMatrix.h"
+#include "NumericsSparseMatrix.h"
 #include "SimpleMatrix.hpp"
 #include "BlockMatrixIterators.hpp"
 #include "BlockMatrix.hpp"
@@ -47,6 +48,13 @@ namespace lapack = boost::numeric::bindings::lapack;
 
 using namespace Siconos;
 
+/** deleter of the NumericsMatrix holding the sparse LU factors */
+static void freeNumericsMatrix(NumericsMatrix* M)
+{
+  NM_free(M);
+  free(M);
+}
+
 void SimpleMatrix::PLUFactorizationInPlace()
 {
   if (_isPLUFactorized)
@@ -68,20 +76,32 @@ void SimpleMatrix::PLUFactorizationInPlace()
     }
     else _isPLUFactorized = true;
   }
-  else
+  else if (_num == 4)
   {
-    int info = cholesky_decompose(*sparse());
-    // \warning: VA 24/11/2010: work only for symmetric matrices. Should be replaced by efficient implementatation (e.g. mumps )
+    // The factorization is done by the sparse direct solver of Numerics
+    // on a copy of the matrix in csc format, and the factors are kept in
+    // _sparseLU.
+    unsigned int n = size(0);
+    if (n != size(1))
+      SiconosMatrixException::selfThrow("SimpleMatrix::PLUFactorizationInPlace failed: the sparse matrix is not square.");
+    _sparseLU.reset(NM_create(NM_SPARSE, n, n), freeNumericsMatrix);
+    NM_csc_empty_alloc(&*_sparseLU, nnz());
+    _sparseLU->matrix2->origin = NSM_CSC;
+    fillCSC(NM_csc(&*_sparseLU), 0, 0);
+
+    // factorization, with a null right-hand side
+    std::vector<double> b(n, 0.);
+    int info = NM_gesv_expert(&*_sparseLU, b.data(), NM_KEEP_FACTORS);
     if (info != 0)
     {
-      display();
+      _sparseLU.reset();
       _isPLUFactorized = false;
-      std::cout << "Problem in Cholesky Decomposition for the row number" << info   << std::endl;
-      SiconosMatrixException::selfThrow("SimpleMatrix::PLUFactorizationInPlace failed. ");
+      SiconosMatrixException::selfThrow("SimpleMatrix::PLUFactorizationInPlace failed: the sparse matrix is singular.");
     }
     else _isPLUFactorized = true;
   }
-
+  else
+    SiconosMatrixException::selfThrow("SimpleMatrix::PLUFactorizationInPlace: only implemented for dense and sparse matrices.");
 }
 
 void SimpleMatrix::PLUInverseInPlace()
@@ -139,24 +159,24 @@ void SimpleMatrix::PLUForwardBackwardInPlace(SiconosMatrix &B)
   }
   else
   {
-    if (!_isPLUFactorized) // call first PLUFactorizationInPlace
+    if (!_isPLUFactorized || !_sparseLU) // call first PLUFactorizationInPlace
     {
+      _isPLUFactorized = false;
       PLUFactorizationInPlace();
     }
-    // and then solve
+    // and then solve, column by column
     if (B.num() == 1)
     {
-      inplace_solve(*sparse(), *(B.dense()), ublas::lower_tag());
-      inplace_solve(ublas::trans(*sparse()), *(B.dense()), ublas::upper_tag());
+      info = NM_gesv_expert_multiple_rhs(&*_sparseLU, &(B.dense()->data()[0]), B.size(1), NM_KEEP_FACTORS);
     }
     else if (B.num() == 4)
     {
-      inplace_solve(*sparse(), *(B.sparse()), ublas::lower_tag());
-      inplace_solve(ublas::trans(*sparse()), *(B.sparse()), ublas::upper_tag());
+      DenseMat tmpB(*B.sparse());
+      info = NM_gesv_expert_multiple_rhs(&*_sparseLU, &(tmpB.data()[0]), B.size(1), NM_KEEP_FACTORS);
+      *B.sparse() = tmpB;
     }
     else
-      SiconosMatrixException::selfThrow(" SimpleMatrix::PLUInverseInPlace: only implemented for dense ans sparse matrices in RHS.");
-    info = 0 ;
+      SiconosMatrixException::selfThrow(" SimpleMatrix::PLUForwardBackwardInPlace: only implemented for dense ans sparse matrices in RHS.");
   }
   //  SiconosMatrixException::selfThrow(" SimpleMatrix::PLUInverseInPlace: only implemented for dense matrices.");
 
@@ -205,14 +225,13 @@ void SimpleMatrix::PLUForwardBackwardInPlace(SiconosVector &B)
   }
   else
   {
-    if (!_isPLUFactorized) // call first PLUFactorizationInPlace
+    if (!_isPLUFactorized || !_sparseLU) // call first PLUFactorizationInPlace
     {
+      _isPLUFactorized = false;
       PLUFactorizationInPlace();
     }
     // and then solve
-    inplace_solve(*sparse(), tmpB, ublas::lower_tag());
-    inplace_solve(ublas::trans(*sparse()), tmpB, ublas::upper_tag());
-    info = 0;
+    info = NM_gesv_expert(&*_sparseLU, &(tmpB.data()[0]), NM_KEEP_FACTORS);
   }
   if (info != 0)
     SiconosMatrixException::selfThrow("SimpleMatrix::PLUForwardBackwardInPlace failed.");
@@ -225,6 +244,7 @@ void SimpleMatrix::PLUForwardBackwardInPlace(SiconosVector &B)
 void SimpleMatrix::resetLU()
 {
   if (_ipiv) _ipiv->clear();
+  _sparseLU.reset();
   _isPLUFactorized = false;
   _isPLUInversed = false;
 }
@@ -227,6 +227,39 @@ void SiconosVectorTest::testConstructor7()
   std::cout << "--> Constructor 7 test ended with success." <<std::endl;
 }
 
+// from an external array, no copy
+void SiconosVectorTest::testConstructor8()
+{
+  std::cout << "--> Test: constructor 8." <<std::endl;
+  std::vector<double> data(vq);
+  SP::SiconosVector v(new SiconosVector(&data[0], size));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", v->size() == size, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", v->num() == 1, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", v->getArray() == &data[0], true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", v->isBorrowed(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", (*v)(2) == 3., true);
+  (*v)(1) = 5.;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", data[1] == 5., true);
+  *v = *ref;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", data[3] == (*ref)(3), true);
+  // copies own their memory
+  SP::SiconosVector w(new SiconosVector(*v));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", w->isBorrowed(), false);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", *w == *v, true);
+  v->zero();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", data[0] == 0., true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", *w == *ref, true);
+  // expressions are computed in a temporary, the result must still
+  // reach the external array
+  *v->dense() = 2.0 * *w->dense();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", v->getArray() == &data[0], true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", data[3] == 2.0 * (*ref)(3), true);
+  *v += *v;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", v->isBorrowed(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor8 : ", data[3] == 4.0 * (*ref)(3), true);
+  std::cout << "--> Constructor 8 test ended with success." <<std::endl;
+}
+
 // zero
 void SiconosVectorTest::testZero()
 {
@@ -51,6 +51,7 @@ private:
   CPPUNIT_TEST(testConstructor5);
   CPPUNIT_TEST(testConstructor6);
   CPPUNIT_TEST(testConstructor7);
+  CPPUNIT_TEST(testConstructor8);
   CPPUNIT_TEST(testZero);
   CPPUNIT_TEST(testFill);
   CPPUNIT_TEST(testNorm);
@@ -91,6 +92,7 @@ private:
   void testConstructor5();
   void testConstructor6();
   void testConstructor7();
+  void testConstructor8();
   void testZero();
   void testFill();
   void testNorm();
@@ -260,6 +260,40 @@ void SimpleMatrixTest::testConstructor12()
   CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor12 : ", test->normInf() == 1, true);
 }
 
+void SimpleMatrixTest::testConstructor13()
+{
+  std::cout << "--> Test: constructor 13." <<std::endl;
+  // column-major external array, no copy
+  double data[6] = {1., 2., 3., 4., 5., 6.};
+  SP::SimpleMatrix test(new SimpleMatrix(data, 2, 3));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->num() == 1, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->size(0) == 2, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->size(1) == 3, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->getArray() == data, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", (*test)(1, 2) == 6., true);
+  (*test)(0, 1) = 7.;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", data[2] == 7., true);
+  // the transposition keeps the external array
+  test->trans();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->size(0) == 3, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->getArray() == data, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", (*test)(1, 0) == 7., true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", data[1] == 7., true);
+  test->zero();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", data[5] == 0., true);
+  // expressions are computed in a temporary, the result must still
+  // reach the external array
+  SimpleMatrix other(3, 2);
+  other(2, 1) = 3.;
+  *test->dense() = 2.0 * *other.dense();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->getArray() == data, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", data[5] == 6., true);
+  *test += *test;
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", test->getArray() == data, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testConstructor13 : ", data[5] == 12., true);
+  std::cout << "--> Constructor 13 test ended with success." <<std::endl;
+}
+
 // Add tests with getDense ...
 
 void SimpleMatrixTest::testZero()
@@ -3344,7 +3378,46 @@ void SimpleMatrixTest::testGemm()
   std::cout << "-->  test gemm ended with success." <<std::endl;
 }
 
-
+void SimpleMatrixTest::testPLUSparse()
+{
+  std::cout << "--> Test: PLU of a sparse matrix." <<std::endl;
+
+  // non symmetric sparse matrix
+  SparseMat Sp(4, 4);
+  Sp(0, 0) = 4.0;
+  Sp(1, 0) = 1.0;
+  Sp(1, 1) = 4.0;
+  Sp(2, 2) = 4.0;
+  Sp(3, 2) = 2.0;
+  Sp(0, 3) = 1.0;
+  Sp(3, 3) = 4.0;
+  SP::SimpleMatrix W(new SimpleMatrix(Sp));
+  DenseMat Wd(Sp);
+
+  SiconosVector x(4);
+  for (unsigned int i = 0; i < 4; ++i)
+    x(i) = i + 1.0;
+  SiconosVector b(x);
+  W->PLUForwardBackwardInPlace(b);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testPLUSparse: ", W->isPLUFactorized(), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testPLUSparse: ", norm_inf(prod(Wd, *b.dense()) - *x.dense()) < tol, true);
+
+  // the matrix is not modified, the factors are reused
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testPLUSparse: ", norm_inf(*W->sparse() - Sp) < tol, true);
+  SimpleMatrix B(4, 2);
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    B(i, 0) = i + 1.0;
+    B(i, 1) = 4.0 - i;
+  }
+  SimpleMatrix Bx(B);
+  W->PLUForwardBackwardInPlace(Bx);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testPLUSparse: ", norm_inf(prod(Wd, *Bx.dense()) - *B.dense()) < tol, true);
+
+  W->resetLU();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testPLUSparse: ", W->isPLUFactorized(), false);
+  std::cout << "-->  test PLUSparse ended with success." <<std::endl;
+}
 
 void SimpleMatrixTest::End()
 {
@@ -50,6 +50,7 @@ private:
   CPPUNIT_TEST(testConstructor10);
   CPPUNIT_TEST(testConstructor11);
   CPPUNIT_TEST(testConstructor12);
+  CPPUNIT_TEST(testConstructor13);
   CPPUNIT_TEST(testGetSetRowCol);
   CPPUNIT_TEST(testZero);
   CPPUNIT_TEST(testEye);
@@ -92,6 +93,7 @@ private:
   CPPUNIT_TEST(testProd6);
   CPPUNIT_TEST(testGemv);
   CPPUNIT_TEST(testGemm);
+  CPPUNIT_TEST(testPLUSparse);
   CPPUNIT_TEST(End);
   CPPUNIT_TEST_SUITE_END();
 
@@ -108,6 +110,7 @@ private:
   void testConstructor10();
   void testConstructor11();
   void testConstructor12();
+  void testConstructor13();
   void testGetSetRowCol();
   void testZero();
   void testEye();
@@ -150,6 +153,7 @@ private:
   void testProd6();
   void testGemm();
   void testGemv();
+  void testPLUSparse();
   void End();
 
   unsigned int size, size2;
@@ -18,8 +18,10 @@
 #include "SiconosMemory.hpp"
 #include "BlockVector.hpp"
 #include "SiconosVector.hpp"
+#include <boost/numeric/ublas/vector.hpp>
 
 #include <iostream>
+#include <algorithm>
 
 
 // --- CONSTRUCTORS ---
@@ -149,6 +151,41 @@ void SiconosMemory::setMemorySize(const unsigned int steps,
   }
 }
 
+unsigned int SiconosMemory::vectorSize() const
+{
+  return size() ? (*this)[0].size() : 0;
+}
+
+void SiconosMemory::setStorage(double* storage)
+{
+  unsigned int n = vectorSize();
+  if (n == 0)
+    return;
+  for (unsigned int i = 0; i < size(); i++)
+  {
+    SiconosVector& v = (*this)[i];
+    if (v.num() != 1 || v.size() != n)
+      SiconosMemoryException::selfThrow(
+        "SiconosMemory::setStorage : all vectors must be dense and of the same size");
+    double* slot = storage + i * n;
+    if (v.getArray() != slot)
+    {
+      std::copy(v.getArray(), v.getArray() + n, slot);
+      borrowStorage(v.dense()->data(), slot, n);
+    }
+  }
+}
+
+void SiconosMemory::releaseStorage()
+{
+  for (unsigned int i = 0; i < size(); i++)
+  {
+    SiconosVector& v = (*this)[i];
+    if (v.isBorrowed())
+      ownStorage(v.dense()->data());
+  }
+}
+
 // --- GETTERS/SETTERS ---
 
 const SiconosVector& SiconosMemory::getSiconosVector(const unsigned int index) const
@@ -132,6 +132,25 @@ public:
   void setMemorySize(const unsigned int steps,
                      const unsigned int vectorSize);
 
+  /** gives the size of the vectors stored in the memory
+   * \return int >= 0
+   */
+  unsigned int vectorSize() const;
+
+  /** use an external array as storage for all the vectors of the
+   * memory: vector i is stored in storage[i*vectorSize(), (i+1)*vectorSize()).
+   * Current values are copied into the array, which must hold
+   * getMemorySize() * vectorSize() doubles and live as long as the
+   * memory uses it (see releaseStorage()).
+   * \param storage the array
+   */
+  void setStorage(double* storage);
+
+  /** give their own storage back to vectors which use an external
+   * array (see setStorage()). Values are kept.
+   */
+  void releaseStorage();
+
   /** gives the numbers of SiconosVectors currently stored in the memory
    * \return int >= 0
    */
@@ -163,6 +163,30 @@ void SiconosMemoryTest::testSwap()
   std::cout << "-->  swap test ended with success." <<std::endl;
 }
 
+// external storage
+
+void SiconosMemoryTest::testSetStorage()
+{
+  std::cout << "--> Test: setStorage." <<std::endl;
+  SP::SiconosMemory tmp1(new SiconosMemory(2, sizeVect));
+  tmp1->swap(((*V1)[0]));
+  std::vector<double> storage(2 * sizeVect);
+  tmp1->setStorage(&storage[0]);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSetStorage : vector OK", tmp1->getSiconosVector(0) == ((*V1)[0]), true);
+  tmp1->swap(((*V1)[1]));
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSetStorage : vector OK", tmp1->getSiconosVector(0) == ((*V1)[1]), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSetStorage : vector OK", tmp1->getSiconosVector(1) == ((*V1)[0]), true);
+  // all the values are in the storage
+  for (unsigned int i = 0; i < 2; i++)
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testSetStorage : storage OK", tmp1->getSiconosVector(i).getArray() >= &storage[0]
+                                 && tmp1->getSiconosVector(i).getArray() < &storage[0] + 2 * sizeVect, true);
+  tmp1->releaseStorage();
+  std::fill(storage.begin(), storage.end(), 0.);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSetStorage : vector OK", tmp1->getSiconosVector(0) == ((*V1)[1]), true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSetStorage : vector OK", tmp1->getSiconosVector(1) == ((*V1)[0]), true);
+  std::cout << "-->  setStorage test ended with success." <<std::endl;
+}
+
 void SiconosMemoryTest::End()
 {
   //   std::cout <<"======================================" <<std::endl;
@@ -40,6 +40,7 @@ private:
   CPPUNIT_TEST(testSetVectorMemory);
   CPPUNIT_TEST(testGetSiconosVector);
   CPPUNIT_TEST(testSwap);
+  CPPUNIT_TEST(testSetStorage);
   CPPUNIT_TEST(End);
   CPPUNIT_TEST_SUITE_END();
 
@@ -49,6 +50,7 @@ private:
   void testSetVectorMemory();
   void testGetSiconosVector();
   void testSwap();
+  void testSetStorage();
   void End();
 
   SP::MemoryContainer V1, V2, V3;
@@ -539,6 +539,7 @@ public:
       assert(bundle(descriptor(vertex_bundle)) == vertex_bundle);
 
       index(new_vertex_descriptor) = std::numeric_limits<size_t>::max() ;
+      _stamp++;
       return new_vertex_descriptor;
     }
     else
@@ -620,6 +621,7 @@ public:
     assert(vertex_descriptor.size() == (size() + 1));
 
     vertex_descriptor.erase(vertex_bundle);
+    _stamp++;
 
     /*  debug */
 #ifndef NDEBUG
@@ -656,6 +658,7 @@ public:
     index(new_edge) = std::numeric_limits<size_t>::max();
 
     bundle(new_edge) = e_bundle;
+    _stamp++;
 
     assert(is_edge(vd1, vd2, e_bundle));
 
@@ -758,6 +761,7 @@ public:
     assert(adjacent_vertex_exists(source(ed)));
 
     boost::remove_edge(ed, g);
+    _stamp++;
     /* debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -803,6 +807,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_out_edge_if(vd, pred, g);
+    _stamp++;
     /* workaround on multisetS (tested on Disks : ok)
        multiset allows for member removal without invalidating iterators
 
@@ -836,6 +841,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_in_edge_if(vd, pred, g);
+    _stamp++;
     /*  debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -856,6 +862,7 @@ public:
     BOOST_CONCEPT_ASSERT((boost::MutableGraphConcept<graph_t>));
 
     boost::remove_edge_if(pred, g);
+    _stamp++;
     /*  debug */
 #ifndef NDEBUG
     assert(state_assert());
@@ -863,6 +870,8 @@ public:
   }
 
 
+  /** \return a counter incremented each time a vertex or an edge is
+   * added or removed, and each time the indices are updated */
   int stamp() const
   {
     return _stamp;
@@ -896,6 +905,7 @@ public:
   {
     g.clear();
     vertex_descriptor.clear();
+    _stamp++;
   };
 
   VMap vertex_descriptor_map() const
@@ -23,6 +23,7 @@
   REGISTER(TimeSteppingD1Minus)                        \
   REGISTER(TimeSteppingDirectProjection)               \
   REGISTER(TimeSteppingCombinedProjection)             \
+  REGISTER(TimeSteppingMultirate)                      \
   REGISTER(EventDriven)                                \
   REGISTER(OneStepIntegrator)                          \
   REGISTER(EulerMoreauOSI)                             \
@@ -26,6 +26,7 @@
 #include "BlockVector.hpp"
 #include "ioMatrix.hpp"
 #include "ioVector.hpp"
+#include "FiniteDifferenceJacobian.hpp"
 
 #include "RuntimeException.hpp"
 #include "SiconosMatrixException.hpp"
@@ -63,6 +63,9 @@
   PY_REGISTER(TimeStepping, Kernel);                                            \
   PY_REGISTER(TimeSteppingCombinedProjection, Kernel);                          \
   PY_REGISTER(TimeSteppingDirectProjection, Kernel);                            \
+  PY_REGISTER(TimeSteppingMultirate, Kernel);                                   \
+  PY_REGISTER(TimeSteppingBatch, Kernel);                                       \
+  PY_REGISTER(TimeStepController, Kernel);                                      \
   PY_REGISTER(InteractionManager, Kernel);                                      \
   PY_REGISTER(EventDriven, Kernel);                                             \
   PY_REGISTER(EventsManager, Kernel);                                           \
@@ -70,5 +73,6 @@
   PY_REGISTER(BoundaryCondition, Kernel);                                       \
   PY_REGISTER(HarmonicBC, Kernel);                                              \
   PY_REGISTER(FixedBC, Kernel);                                                 \
+  PY_REGISTER(ForcesBatch, Kernel);                                             \
   PY_REGISTER(OSNSMatrix, Kernel);                                              \
   PY_REGISTER(BlockCSRMatrix, Kernel);
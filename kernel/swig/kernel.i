@@ -148,6 +148,7 @@ namespace std
 %feature("notabstract") TimeStepping;
 %feature("notabstract") TimeSteppingCombinedProjection;
 %feature("notabstract") TimeSteppingDirectProjection;
+%feature("notabstract") TimeSteppingMultirate;
 %feature("notabstract") EventDriven;
 
 // common declarations with Numerics
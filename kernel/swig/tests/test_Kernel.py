@@ -77,6 +77,22 @@ def test_getMatrix():
     m2 = K.SimpleMatrix(np.array([[1,2,3],[4,5,6]]))
     assert (K.getMatrix(m1) == K.getMatrix(K.SimpleMatrix(m2))).all()
 
+def test_numpy_no_copy():
+    q = np.array([1., 2., 3.])
+    ds = K.LagrangianDS([0, 0, 0], [0, 0, 0], np.eye(3))
+    ds.setQPtr(q)
+
+    # the state of the ds is stored in q
+    q[1] = 42.
+    assert ds.q()[1] == 42.
+    ds.q()[0] = 7.
+    assert q[0] == 7.
+
+    # q is still usable after the ds is gone
+    del ds
+    assert (q == np.array([7., 42., 3.])).all()
+
+
 def test_LagrangianDS_setMassPtr():
     class LDS(K.LagrangianDS):
         pass
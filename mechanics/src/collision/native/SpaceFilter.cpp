@@ -20,9 +20,11 @@
 #include <NonSmoothDynamicalSystem.hpp>
 #include <SimulationTypeDef.hpp>
 #include <NonSmoothLaw.hpp>
+#include <SiconosConfig.h>
 
 
 #include <cmath>
+#include <algorithm>
 //#define DEBUG_MESSAGES 1
 #include "debug.h"
 
@@ -62,6 +64,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
     _plans(plans),
     _moving_plans(moving_plans),
     _hash_table(new space_hash()),
+    _cells(new space_cells()),
     diskdisk_relations(new DiskDiskRDeclaredPool()),
     diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -74,6 +77,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
     _cellsize(cellsize),
     _plans(plans),
     _hash_table(new space_hash()),
+    _cells(new space_cells()),
     diskdisk_relations(new DiskDiskRDeclaredPool()),
     diskplan_relations(new DiskPlanRDeclaredPool()),
     circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -81,6 +85,7 @@ SpaceFilter::SpaceFilter(unsigned int bboxfactor,
 
 SpaceFilter::SpaceFilter() :
   _hash_table(new space_hash()),
+  _cells(new space_cells()),
   diskdisk_relations(new DiskDiskRDeclaredPool()),
   diskplan_relations(new DiskPlanRDeclaredPool()),
   circlecircle_relations(new CircleCircleRDeclaredPool())
@@ -97,105 +102,69 @@ public:
 
   using SiconosVisitor::visit;
 
-  void visit(SP::Disk pds)
+  /* record the body and the cells of its bounding box, in the plane
+   * k = 0 for 2D bodies */
+  void hash(SP::DynamicalSystem ds, int kind, double r,
+            double x, double y, double z, bool is3D)
   {
-    int i, j, imin, imax, jmin, jmax;
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
+    double cellsize = parent.cellsize();
+    double extent = parent.bboxfactor() * r;
 
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
+    int imin = (int) floor((x - extent) / cellsize);
+    int imax = (int) floor((x + extent) / cellsize);
 
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
+    int jmin = (int) floor((y - extent) / cellsize);
+    int jmax = (int) floor((y + extent) / cellsize);
 
-    for (i = imin; i <= imax; ++i)
+    int kmin = 0;
+    int kmax = 0;
+    int kc = 0;
+    if (is3D)
     {
-      for (j = jmin; j <= jmax; ++j)
-      {
-        parent.insert(pds, i, j, 0);
-      }
+      kmin = (int) floor((z - extent) / cellsize);
+      kmax = (int) floor((z + extent) / cellsize);
+      kc = (int) floor(z / cellsize);
     }
-  };
-
-  void visit(SP::Circle pds)
-  {
-    int i, j, imin, imax, jmin, jmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
 
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
+    space_cells& cells = *parent._cells;
+    unsigned int body = cells.addBody(ds, kind,
+                                      (int) floor(x / cellsize),
+                                      (int) floor(y / cellsize), kc);
 
-    for (i = imin; i <= imax; ++i)
+    for (int i = imin; i <= imax; ++i)
     {
-      for (j = jmin; j <= jmax; ++j)
+      for (int j = jmin; j <= jmax; ++j)
       {
-        parent.insert(pds, i, j, 0);
+        for (int k = kmin; k <= kmax; ++k)
+        {
+          cells.addCell(body, i, j, k);
+        }
       }
     }
   }
 
-  void visit(SP::SphereLDS pds)
+  void visit(SP::Disk pds)
   {
-    int i, j, k, imin, imax, jmin, jmax, kmin, kmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    kmin = (int) floor((pds->getQ(2) - _bboxfactor * pds->getRadius()) / _cellsize);
-    kmax = (int) floor((pds->getQ(2) + _bboxfactor * pds->getRadius()) / _cellsize);
+    hash(pds, space_cells::CIRCULAR, pds->getRadius(),
+         pds->getQ(0), pds->getQ(1), 0., false);
+  };
 
-    for (i = imin; i <= imax; ++i)
-    {
-      for (j = jmin; j <= jmax; ++j)
-      {
-        for (k = kmin; k <= kmax; ++k)
-        {
-          parent.insert(pds, i, j, k);
-        }
-      }
-    }
+  void visit(SP::Circle pds)
+  {
+    hash(pds, space_cells::CIRCULAR, pds->getRadius(),
+         pds->getQ(0), pds->getQ(1), 0., false);
+  }
 
+  void visit(SP::SphereLDS pds)
+  {
+    hash(pds, space_cells::SPHERE_LDS, pds->getRadius(),
+         pds->getQ(0), pds->getQ(1), pds->getQ(2), true);
   }
 
   void visit(SP::SphereNEDS pds)
   {
-    int i, j, k, imin, imax, jmin, jmax, kmin, kmax;
-
-    unsigned int _bboxfactor = parent.bboxfactor();
-    unsigned int _cellsize = parent.cellsize();
-
-    imin = (int) floor((pds->getQ(0) - _bboxfactor * pds->getRadius()) / _cellsize);
-    imax = (int) floor((pds->getQ(0) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    jmin = (int) floor((pds->getQ(1) - _bboxfactor * pds->getRadius()) / _cellsize);
-    jmax = (int) floor((pds->getQ(1) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    kmin = (int) floor((pds->getQ(2) - _bboxfactor * pds->getRadius()) / _cellsize);
-    kmax = (int) floor((pds->getQ(2) + _bboxfactor * pds->getRadius()) / _cellsize);
-
-    for (i = imin; i <= imax; ++i)
-    {
-      for (j = jmin; j <= jmax; ++j)
-      {
-        for (k = kmin; k <= kmax; ++k)
-        {
-          parent.insert(pds, i, j, k);
-        }
-      }
-    }
-
+    hash(pds, space_cells::SPHERE_NEDS, pds->getRadius(),
+         pds->getQ(0), pds->getQ(1), pds->getQ(2), true);
   }
 
   void visit(SP::ExternalBody d)
@@ -989,14 +958,6 @@ void SpaceFilter::insert(SP::Hashed hashed)
 
 
 
-/* dynamical systems proximity detection */
-typedef std::pair<int, int> interPair;
-bool operator ==(interPair const& a, interPair const& b);
-bool operator ==(interPair const& a, interPair const& b)
-{
-  return ((a.first == b.first) && (a.second == b.second));
-}
-
 bool operator ==(std::pair<double, double> const& a,
                  std::pair<double, double> const& b);
 bool operator ==(std::pair<double, double> const& a,
@@ -1021,9 +982,6 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
 
   using SiconosVisitor::visit;
 
-  typedef boost::unordered_multiset < interPair,
-          boost::hash<interPair> > interPairs;
-
   SP::Simulation sim;
   SP::SpaceFilter parent;
   double time;
@@ -1058,47 +1016,6 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
         parent->_MovingPlanCircularFilter(sim, i, ds1, time);
       }
     }
-
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    SP::Hashed hds1(new Hashed(std11::static_pointer_cast<DynamicalSystem>(ds1),
-                             (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
-    std11::shared_ptr<_CircularFilter>
-    circularFilter(new _CircularFilter(sim, parent, ds1));
-
-    for (j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if (ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if (declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(circularFilter);
-        }
-
-      }
-    }
   };
 
   void visit(SP::Circle circle)
@@ -1123,49 +1040,6 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
                                    (*parent->_plans)(i, 2),
                                    (*parent->_plans)(i, 3), ds1);
     }
-
-    SP::SiconosVector Q1 = ds1->q();
-
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    double z1 = Q1->getValue(2);
-    SP::Hashed hds1(new Hashed(ds1, (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize),
-                               (int) floor(z1 / parent->_cellsize)));
-
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
-
-    unsigned int j;
-    interPairs declaredInteractions;
-
-    std11::shared_ptr<_SphereLDSFilter> sphereFilter(
-      new _SphereLDSFilter(sim, parent, ds1));
-
-    for (j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
-    {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if (ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if (declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(sphereFilter);
-        }
-
-      }
-    }
   }
 
 
@@ -1180,58 +1054,57 @@ struct SpaceFilter::_FindInteractions : public SiconosVisitor
                                     (*parent->_plans)(i, 2),
                                     (*parent->_plans)(i, 3), ds1);
     }
+  }
 
-    SP::SiconosVector Q1 = ds1->q();
+  void visit(SP::ExternalBody d)
+  {
+    d->selfFindInteractions(parent);
+  }
 
-    double x1 = Q1->getValue(0);
-    double y1 = Q1->getValue(1);
-    double z1 = Q1->getValue(2);
-    SP::Hashed hds1(new Hashed(ds1, (int) floor(x1 / parent->_cellsize),
-                               (int) floor(y1 / parent->_cellsize),
-                               (int) floor(z1 / parent->_cellsize)));
 
-    // find all other systems that are in the same cells
-    std::pair<space_hash::iterator, space_hash::iterator>
-    neighbours = parent->_hash_table->equal_range(hds1);
+};
 
-    unsigned int j;
-    interPairs declaredInteractions;
 
-    std11::shared_ptr<_SphereNEDSFilter> sphereFilter(
-      new _SphereNEDSFilter(sim, parent, ds1));
+/* proximity detection between the bodies of the candidate pairs */
+void SpaceFilter::_PairsFilter(SP::Simulation sim)
+{
+  space_cells& cells = *_cells;
+  SP::SpaceFilter self = shared_from_this();
 
-    for (j = 0; neighbours.first != neighbours.second; ++neighbours.first, ++j)
+  /* the pairs are sorted: one filter for each first body */
+  unsigned int p = 0;
+  while (p < cells.pairs.size())
+  {
+    unsigned int i = cells.pairs[p].first;
+    SP::SiconosVisitor filter;
+    switch (cells.kinds[i])
     {
-      SP::DynamicalSystem ds2 = (*neighbours.first)->body;
-      int ids1 = ds1->number();
-      int ids2 = ds2->number();
-      int imax = (std::max)(ids1, ids2);
-      int imin = (std::min)(ids1, ids2);
-      if (ids1 != ids2)
-      {
-        // is interaction already treated ?
-        interPair interpair;
-        interpair = std::pair<int, int>(imin, imax);
-
-        if (declaredInteractions.find(interpair)
-            == declaredInteractions.end())
-        {
-          // no, check proximity
-          declaredInteractions.insert(interpair);
-          ds2->acceptSP(sphereFilter);
-        }
-
-      }
+    case space_cells::CIRCULAR:
+      filter.reset(new _CircularFilter(
+                     sim, self,
+                     std11::static_pointer_cast<CircularDS>(cells.bodies[i])));
+      break;
+    case space_cells::SPHERE_LDS:
+      filter.reset(new _SphereLDSFilter(
+                     sim, self,
+                     std11::static_pointer_cast<SphereLDS>(cells.bodies[i])));
+      break;
+    case space_cells::SPHERE_NEDS:
+      filter.reset(new _SphereNEDSFilter(
+                     sim, self,
+                     std11::static_pointer_cast<SphereNEDS>(cells.bodies[i])));
+      break;
+    default:
+      break;
     }
-  }
 
-  void visit(SP::ExternalBody d)
-  {
-    d->selfFindInteractions(parent);
+    for (; p < cells.pairs.size() && cells.pairs[p].first == i; ++p)
+    {
+      if (filter)
+        cells.bodies[cells.pairs[p].second]->acceptSP(filter);
+    }
   }
-
-
-};
+}
 
 
 /* general proximity detection */
@@ -1248,6 +1121,7 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
   findInteractions(new _FindInteractions(sim, shared_from_this(), time));
 
   _hash_table->clear();
+  _cells->clear();
 
   // 1: rehash DS
   DynamicalSystemsGraph::VIterator vi, viend;
@@ -1258,12 +1132,35 @@ void SpaceFilter::updateInteractions(SP::Simulation sim)
     DSG0->bundle(*vi)->acceptSP(hasher);
   }
 
-  // 2: prox detection
+  // the general hashed objects of hashed bodies are their neighbours too
+  for (space_hash::iterator it = _hash_table->begin();
+       it != _hash_table->end(); ++it)
+  {
+    if ((*it)->body)
+    {
+      unsigned int number = (*it)->body->number();
+      if (number < _cells->bodyOfNumber.size()
+          && _cells->bodyOfNumber[number] >= 0)
+      {
+        _cells->addCell(_cells->bodyOfNumber[number],
+                        (*it)->i, (*it)->j, (*it)->k);
+      }
+    }
+  }
+
+  // 2: candidate pairs
+  _cells->sort();
+  _cells->findPairs();
+
+  // 3: prox detection with plans, external bodies
   for (std11::tie(vi, viend) = DSG0->vertices();
        vi != viend; ++vi)
   {
     DSG0->bundle(*vi)->acceptSP(findInteractions);
   }
+
+  // 4: prox detection between bodies
+  _PairsFilter(sim);
   //model()->simulation()->initOSNS();
 }
 
@@ -1276,7 +1173,9 @@ bool SpaceFilter::haveNeighbours(SP::Hashed h)
 {
   std::pair<space_hash::iterator, space_hash::iterator> neighbours
     = _hash_table->equal_range(h);
-  return (neighbours.first != neighbours.second);
+  std::pair<unsigned int, unsigned int> cell
+    = _cells->range(space_cells::key(h->i, h->j, h->k));
+  return (neighbours.first != neighbours.second || cell.first != cell.second);
 }
 
 
@@ -1327,8 +1226,128 @@ double SpaceFilter::minDistance(SP::Hashed h)
 
       dmin = (std::min)(dmin, distance->result);
     }
+
+    std::pair<unsigned int, unsigned int> cell
+      = _cells->range(space_cells::key(h->i, h->j, h->k));
+    for (unsigned int o = cell.first; o < cell.second; ++o)
+    {
+      SP::Disk neighbour =
+        std11::dynamic_pointer_cast<Disk>(_cells->bodies[_cells->occupants[o]]);
+      if (neighbour && neighbour != disk)
+      {
+        neighbour->acceptSP(distance);
+        dmin = (std::min)(dmin, distance->result);
+      }
+    }
   }
 
   return dmin;
 
 }
+
+
+/* flat hash */
+void space_cells::clear()
+{
+  for (unsigned int i = 0; i < bodies.size(); ++i)
+    bodyOfNumber[bodies[i]->number()] = -1;
+  bodies.clear();
+  kinds.clear();
+  centers.clear();
+  keys.clear();
+  occupants.clear();
+  pairs.clear();
+}
+
+unsigned int space_cells::addBody(SP::DynamicalSystem ds, int kind,
+                                  int i, int j, int k)
+{
+  unsigned int body = bodies.size();
+  unsigned int number = ds->number();
+  if (number >= bodyOfNumber.size())
+    bodyOfNumber.resize(number + 1, -1);
+  bodyOfNumber[number] = body;
+  bodies.push_back(ds);
+  kinds.push_back(kind);
+  centers.push_back(key(i, j, k));
+  return body;
+}
+
+void space_cells::sort()
+{
+  unsigned int n = keys.size();
+  if (n == 0)
+    return;
+  _keys.resize(n);
+  _occupants.resize(n);
+
+  /* least significant digit first, 8 bits per pass, a pass is skipped
+   * when all the keys have the same digit */
+  for (unsigned int shift = 0; shift < 64; shift += 8)
+  {
+    unsigned int count[257] = { 0 };
+    for (unsigned int i = 0; i < n; ++i)
+      ++count[((keys[i] >> shift) & 0xff) + 1];
+    if (count[((keys[0] >> shift) & 0xff) + 1] == n)
+      continue;
+    for (unsigned int d = 0; d < 256; ++d)
+      count[d + 1] += count[d];
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      unsigned int& position = count[(keys[i] >> shift) & 0xff];
+      _keys[position] = keys[i];
+      _occupants[position] = occupants[i];
+      ++position;
+    }
+    keys.swap(_keys);
+    occupants.swap(_occupants);
+  }
+}
+
+std::pair<unsigned int, unsigned int> space_cells::range(uint64_t key) const
+{
+  std::pair<std::vector<uint64_t>::const_iterator,
+            std::vector<uint64_t>::const_iterator> r =
+    std::equal_range(keys.begin(), keys.end(), key);
+  return std::pair<unsigned int, unsigned int>(r.first - keys.begin(),
+                                               r.second - keys.begin());
+}
+
+void space_cells::findPairs()
+{
+  int n = bodies.size();
+  pairs.clear();
+
+  /* each thread gathers its pairs, merged in a critical section */
+#ifdef WITH_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<std::pair<unsigned int, unsigned int> > local;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(static) nowait
+#endif
+    for (int p = 0; p < n; ++p)
+    {
+      if (kinds[p] == OTHER)
+        continue;
+      std::pair<unsigned int, unsigned int> cell = range(centers[p]);
+      for (unsigned int o = cell.first; o < cell.second; ++o)
+      {
+        unsigned int q = occupants[o];
+        if (q != (unsigned int) p && kinds[q] == kinds[p])
+          local.push_back(std::pair<unsigned int, unsigned int>(
+                            (std::min)((unsigned int) p, q),
+                            (std::max)((unsigned int) p, q)));
+      }
+    }
+#ifdef WITH_OPENMP
+#pragma omp critical
+#endif
+    pairs.insert(pairs.end(), local.begin(), local.end());
+  }
+
+  /* a pair is found from the cells of its two centers */
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+}
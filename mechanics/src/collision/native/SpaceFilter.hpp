@@ -30,6 +30,13 @@
  *   Munich, Germany
  *   pp. 47-54
  *   November 19-21, 2003
+ *
+ *  The disks, circles and spheres are hashed into flat arrays of
+ *  (cell key, body) sorted by key with a radix sort. The candidate
+ *  pairs are the bodies whose bounding box covers the cell of the
+ *  center of another body, they are generated in parallel. Other
+ *  bodies hash themselves into the general hash table (see
+ *  ExternalBody).
  */
 
 #ifndef SpaceFilter_hpp
@@ -43,6 +50,7 @@
 
 /* local forwards (see SpaceFilter_impl.hpp) */
 DEFINE_SPTR(space_hash);
+DEFINE_SPTR(space_cells);
 DEFINE_SPTR(DiskDiskRDeclaredPool);
 DEFINE_SPTR(DiskPlanRDeclaredPool);
 DEFINE_SPTR(CircleCircleRDeclaredPool);
@@ -71,9 +79,12 @@ protected:
   /** moving plans */
   SP::FMatrix _moving_plans;
 
-  /* the hash table */
+  /* the hash table of the general hashed objects */
   SP::space_hash _hash_table;
 
+  /* the flat hash of the disks, circles and spheres */
+  SP::space_cells _cells;
+
   /* relations pool */
   SP::DiskDiskRDeclaredPool  diskdisk_relations;
   SP::DiskPlanRDeclaredPool  diskplan_relations;
@@ -110,9 +121,13 @@ protected:
   /* the body hasher */
   struct _BodyHash;
 
-  /* the proximity detection */
+  /* the proximity detection with plans and external bodies */
   struct _FindInteractions;
 
+  /** proximity detection between the bodies of the candidate pairs
+   * of the flat hash */
+  void _PairsFilter(SP::Simulation);
+
   /* to compare relation */
   struct _IsSameDiskPlanR;
   struct _IsSameDiskMovingPlanR;
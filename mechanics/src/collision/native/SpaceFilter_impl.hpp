@@ -24,6 +24,8 @@
 #define SpaceFilter_impl_hpp
 
 #include <map>
+#include <vector>
+#include <stdint.h>
 
 #include <NSLawMatrix.hpp>
 #include <SpaceFilter.hpp>
@@ -69,6 +71,81 @@ class space_hash : public boost::unordered_multiset < SP::Hashed,
   ACCEPT_SERIALIZATION(space_hash);
 };
 
+/** Flat spatial hash: the cells occupied by the bounding boxes of the
+ * bodies are stored as (key, body) arrays sorted by key, so that the
+ * occupants of a cell are contiguous.
+ */
+class space_cells
+{
+public:
+
+  /** kinds of bodies, only the bodies of the same kind are paired */
+  enum { CIRCULAR, SPHERE_LDS, SPHERE_NEDS, OTHER };
+
+  /** the bodies, in the order of their insertion */
+  std::vector<SP::DynamicalSystem> bodies;
+  std::vector<int> kinds;
+
+  /** key of the cell of the center of each body */
+  std::vector<uint64_t> centers;
+
+  /** index of a body from its number, -1 if it has not been inserted */
+  std::vector<int> bodyOfNumber;
+
+  /** cell occupations, sorted by key by sort() */
+  std::vector<uint64_t> keys;
+  std::vector<unsigned int> occupants;
+
+  /** candidate pairs (i, j), i < j, sorted, given by findPairs() */
+  std::vector<std::pair<unsigned int, unsigned int> > pairs;
+
+  /** key of a cell: 21 bits per coordinate, far cells may collide,
+   * which only gives more candidates */
+  static uint64_t key(int i, int j, int k)
+  {
+    const uint64_t mask = (1 << 21) - 1;
+    return (((uint64_t) i & mask) << 42)
+      | (((uint64_t) j & mask) << 21)
+      | ((uint64_t) k & mask);
+  };
+
+  void clear();
+
+  /** record a body
+   * \param ds the body
+   * \param kind its kind
+   * \param i, j, k the cell of its center
+   * \return its index
+   */
+  unsigned int addBody(SP::DynamicalSystem ds, int kind, int i, int j, int k);
+
+  /** record a cell occupied by a body
+   * \param body the index of the body
+   * \param i, j, k the cell
+   */
+  inline void addCell(unsigned int body, int i, int j, int k)
+  {
+    keys.push_back(key(i, j, k));
+    occupants.push_back(body);
+  };
+
+  /** radix sort of the occupations by key */
+  void sort();
+
+  /** \param key a cell key
+   * \return the range of its occupations, once sorted */
+  std::pair<unsigned int, unsigned int> range(uint64_t key) const;
+
+  /** the pairs of bodies of the same kind such that the box of one
+   * covers the cell of the center of the other */
+  void findPairs();
+
+private:
+  /* buffers of the radix sort */
+  std::vector<uint64_t> _keys;
+  std::vector<unsigned int> _occupants;
+};
+
 /* relations pool */
 typedef std::pair<double, double> CircleCircleRDeclared;
 typedef std::pair<double, double> DiskDiskRDeclared;
@@ -66,6 +66,10 @@
 #include "Circle.hpp"
 #include "DiskPlanR.hpp"
 #include "SpaceFilter.hpp"
+#include "SpaceFilter_impl.hpp"
+#include "SphereLDS.hpp"
+
+#include <set>
 
 class Disks : public SiconosBodies, public std11::enable_shared_from_this<Disks>
 {
@@ -377,8 +381,87 @@ void MultiBodyTest::t2()
 
 }
 
+/* defined in SpaceFilter.cpp, needed by boost hash */
+bool operator ==(SP::Hashed const& a, SP::Hashed const& b);
+std::size_t hash_value(SP::Hashed const& h);
+
+// the flat spatial hash gives the same candidate pairs as space_hash
 void MultiBodyTest::t3()
 {
+  const double cellsize = 2.;
+  const double bboxfactor = 3.;
+
+  space_hash hash_table;
+  space_cells cells;
+  std::vector<SP::DynamicalSystem> bodies;
+
+  srand(1);
+  for (unsigned int n = 0; n < 600; ++n)
+  {
+    bool is3D = n % 3 == 0;
+    double r = 0.1 + 0.9 * rand() / RAND_MAX;
+    double x = -40. + 80. * rand() / RAND_MAX;
+    double y = -40. + 80. * rand() / RAND_MAX;
+    double z = is3D ? -40. + 80. * rand() / RAND_MAX : 0.;
+
+    SP::SiconosVector q(new SiconosVector(is3D ? 6 : 2));
+    SP::SiconosVector v(new SiconosVector(is3D ? 6 : 2));
+    (*q)(0) = x;
+    (*q)(1) = y;
+    SP::DynamicalSystem ds;
+    if (is3D)
+    {
+      (*q)(2) = z;
+      ds.reset(new SphereLDS(r, 1., q, v));
+    }
+    else
+      ds.reset(new Disk(r, 1., q, v));
+    bodies.push_back(ds);
+
+    double extent = bboxfactor * r;
+    int kmin = is3D ? (int) floor((z - extent) / cellsize) : 0;
+    int kmax = is3D ? (int) floor((z + extent) / cellsize) : 0;
+    unsigned int body = cells.addBody(ds, is3D ? space_cells::SPHERE_LDS : space_cells::CIRCULAR,
+                                      (int) floor(x / cellsize),
+                                      (int) floor(y / cellsize),
+                                      (int) floor(z / cellsize));
+    for (int i = (int) floor((x - extent) / cellsize); i <= (int) floor((x + extent) / cellsize); ++i)
+      for (int j = (int) floor((y - extent) / cellsize); j <= (int) floor((y + extent) / cellsize); ++j)
+        for (int k = kmin; k <= kmax; ++k)
+        {
+          cells.addCell(body, i, j, k);
+          hash_table.insert(SP::Hashed(new Hashed(ds, i, j, k)));
+        }
+  }
+  cells.sort();
+  cells.findPairs();
+
+  // the former search: the bodies of the same kind found in the cell
+  // of the center of each body
+  std::set<std::pair<unsigned int, unsigned int> > expected;
+  for (unsigned int p = 0; p < bodies.size(); ++p)
+  {
+    SiconosVector& q = *std11::static_pointer_cast<LagrangianDS>(bodies[p])->q();
+    bool is3D = q.size() == 6;
+    SP::Hashed center(new Hashed((int) floor(q(0) / cellsize),
+                                 (int) floor(q(1) / cellsize),
+                                 is3D ? (int) floor(q(2) / cellsize) : 0));
+    std::pair<space_hash::iterator, space_hash::iterator>
+      neighbours = hash_table.equal_range(center);
+    for (space_hash::iterator it = neighbours.first; it != neighbours.second; ++it)
+    {
+      unsigned int o = cells.bodyOfNumber[(*it)->body->number()];
+      if (o != p && (*it)->body->n() == bodies[p]->n())
+        expected.insert(std::pair<unsigned int, unsigned int>(std::min(o, p), std::max(o, p)));
+    }
+  }
+
+  std::cout << "--> Test: t3, " << expected.size() << " candidate pairs" << std::endl;
+  CPPUNIT_ASSERT(expected.size() > 0);
+  std::set<std::pair<unsigned int, unsigned int> >
+    found(cells.pairs.begin(), cells.pairs.end());
+  CPPUNIT_ASSERT(found == expected);
+  CPPUNIT_ASSERT(cells.pairs.size() == expected.size());
 }
 
 void MultiBodyTest::t4()
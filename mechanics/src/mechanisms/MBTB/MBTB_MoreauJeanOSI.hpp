@@ -36,6 +36,18 @@ public:
    */
   bool removeInteractionFromIndexSet(SP::Interaction inter, unsigned int i);
 
+  /** the rules above are applied one Interaction after the other
+   * \param interactions the Interactions to test
+   * \param active on input 1 if in the IndexSet, on output 1 if it must be in it
+   * \param i level of the IndexSet
+   */
+  void updateInteractionsActivation(const std::vector<SP::Interaction>& interactions,
+                                    std::vector<char>& active,
+                                    unsigned int i)
+  {
+    OneStepIntegrator::updateInteractionsActivation(interactions, active, i);
+  };
+
 };
 TYPEDEF_SPTR(MBTB_MoreauJeanOSI);
 #endif
@@ -1,9 +1,18 @@
 #ifndef ContactShapeDistance_hpp
 #define ContactShapeDistance_hpp
 
+#include <limits>
+
 struct ContactShapeDistance
 {
 
+  ContactShapeDistance() :
+    value(std::numeric_limits<double>::infinity()),
+    x1(0.), y1(0.), z1(0.), x2(0.), y2(0.), z2(0.),
+    nx(0.), ny(0.), nz(0.),
+    u1(0.), v1(0.), u2(0.), v2(0.),
+    hasParameters(false) {};
+
   double value;
 
   double x1;
@@ -18,6 +27,17 @@ struct ContactShapeDistance
   double ny;
   double nz;
 
+  /** parameters of the closest points on the first shape (u1, v1)
+   * and on the second shape (u2, v2, or u2 only for an edge), kept
+   * to start the next query from them */
+  double u1;
+  double v1;
+  double u2;
+  double v2;
+
+  /** true if u1, v1, u2, v2 come from a previous query */
+  bool hasParameters;
+
 };
 
 #endif
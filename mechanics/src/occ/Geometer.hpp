@@ -97,6 +97,49 @@ void distanceFaceEdge<OccDistanceType>(const OccContactFace& csh1,
   occ_distanceFaceEdge(csh1, csh2, X1, Y1, Z1, X2, Y2, Z2, nX, nY, nZ, MinDist);
 }
 
+/* the closest points, with their parameters kept in dist from one
+ * query to the next */
+template<typename DistType>
+void distanceFaceFace(const OccContactFace& csh1,
+                      const OccContactFace& csh2,
+                      ContactShapeDistance& dist)
+{
+  distanceFaceFace<DistType>(csh1, csh2,
+                             dist.x1, dist.y1, dist.z1,
+                             dist.x2, dist.y2, dist.z2,
+                             dist.nx, dist.ny, dist.nz,
+                             dist.value);
+}
+
+template<typename DistType>
+void distanceFaceEdge(const OccContactFace& csh1,
+                      const OccContactEdge& csh2,
+                      ContactShapeDistance& dist)
+{
+  distanceFaceEdge<DistType>(csh1, csh2,
+                             dist.x1, dist.y1, dist.z1,
+                             dist.x2, dist.y2, dist.z2,
+                             dist.nx, dist.ny, dist.nz,
+                             dist.value);
+}
+
+/* OpenCascade: local search from the previous closest points */
+template<>
+void distanceFaceFace<OccDistanceType>(const OccContactFace& csh1,
+                                       const OccContactFace& csh2,
+                                       ContactShapeDistance& dist)
+{
+  occ_distanceFaceFace(csh1, csh2, dist);
+}
+
+template<>
+void distanceFaceEdge<OccDistanceType>(const OccContactFace& csh1,
+                                       const OccContactEdge& csh2,
+                                       ContactShapeDistance& dist)
+{
+  occ_distanceFaceEdge(csh1, csh2, dist);
+}
+
 template <typename DistType>
 struct FaceGeometer : public Geometer
 {
@@ -110,21 +153,13 @@ struct FaceGeometer : public Geometer
   {
     ContactShapeDistance& dist = this->answer;
     dist.value = std::numeric_limits<double>::infinity();
-    distanceFaceFace<DistType>(this->face1, face2,
-                               dist.x1, dist.y1, dist.z1,
-                               dist.x2, dist.y2, dist.z2,
-                               dist.nx, dist.ny, dist.nz,
-                               dist.value);
+    distanceFaceFace<DistType>(this->face1, face2, dist);
   }
   void visit(const OccContactEdge& edge2)
   {
     ContactShapeDistance& dist = this->answer;
     dist.value = std::numeric_limits<double>::infinity();
-    distanceFaceEdge<DistType>(this->face1, edge2,
-                               dist.x1, dist.y1, dist.z1,
-                               dist.x2, dist.y2, dist.z2,
-                               dist.nx, dist.ny, dist.nz,
-                               dist.value);
+    distanceFaceEdge<DistType>(this->face1, edge2, dist);
     dist.nx = -dist.nx;
     dist.ny = -dist.ny;
     dist.nz = -dist.nz;
@@ -145,11 +180,7 @@ struct EdgeGeometer : public Geometer
   {
     ContactShapeDistance& dist = this->answer;
     dist.value = std::numeric_limits<double>::infinity();
-    distanceFaceEdge<DistType>(face2, this->edge1,
-                               dist.x1, dist.y1, dist.z1,
-                               dist.x2, dist.y2, dist.z2,
-                               dist.nx, dist.ny, dist.nz,
-                               dist.value);
+    distanceFaceEdge<DistType>(face2, this->edge1, dist);
   }
   void visit(const OccContactEdge& edge2)
   {
@@ -19,7 +19,8 @@ OccR::OccR(const ContactPoint& contact1,
   _contact2(contact2),
   _geometer(),
   _offset1(0.),
-  _offset2(0.)
+  _offset2(0.),
+  _distanceIsUpToDate(false)
 {
   switch (Type::value(distance_calculator))
   {
@@ -36,9 +37,17 @@ OccR::OccR(const ContactPoint& contact1,
 }
 
 
-void OccR::computeh(double time, BlockVector& q0, SiconosVector& y)
+void OccR::computeDistance()
 {
   this->_contact2.contactShape().accept(*this->_geometer);
+  _distanceIsUpToDate = true;
+}
+
+void OccR::computeh(double time, BlockVector& q0, SiconosVector& y)
+{
+  if (!_distanceIsUpToDate)
+    this->_contact2.contactShape().accept(*this->_geometer);
+  _distanceIsUpToDate = false;
 
   ContactShapeDistance& dist = this->_geometer->answer;
 
@@ -58,8 +67,6 @@ void OccR::computeh(double time, BlockVector& q0, SiconosVector& y)
   _Nc->setValue(1, dist.ny);
   _Nc->setValue(2, dist.nz);
 
-  dist.value -= (_offset1+_offset2);
-
-  y.setValue(0, dist.value);
+  y.setValue(0, dist.value - (_offset1+_offset2));
 
 }
@@ -47,6 +47,14 @@ public:
    */
   void computeh(double time, BlockVector& q0, SiconosVector& y);
 
+  /** Compute the distance between the contacts with the current
+   * positions of the shapes. The next call to computeh uses it
+   * instead of computing it again, so the distances of several
+   * relations can be computed beforehand, concurrently (see
+   * OccTimeStepping::updateWorldFromDS).
+   */
+  void computeDistance();
+
   /** Set offset1, offset from first contact.
    * \param val : the new value.
    */
@@ -79,6 +87,10 @@ protected:
 
   double _offset1;
   double _offset2;
+
+  /** true if the answer of the geometer has been computed by
+   * computeDistance() and not used yet by computeh */
+  bool _distanceIsUpToDate;
 };
 
 #endif
@@ -0,0 +1,209 @@
+#include "OccSpaceFilter.hpp"
+#include "OccBody.hpp"
+#include "OccContactFace.hpp"
+#include "OccContactEdge.hpp"
+#include "ContactPoint.hpp"
+#include "OccR.hpp"
+
+#include <Simulation.hpp>
+#include <Interaction.hpp>
+#include <NonSmoothLaw.hpp>
+#include <RuntimeException.hpp>
+
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Edge.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Pnt.hxx>
+
+#include <algorithm>
+#include <limits>
+
+//#define DEBUG_MESSAGES 1
+#include <debug.h>
+
+OccSpaceFilter::OccSpaceFilter() :
+  SpaceFilter(),
+  _margin(0.),
+  _offset1(0.),
+  _offset2(0.),
+  _distanceCalculator(new OccDistanceType())
+{}
+
+void OccSpaceFilter::insert(SP::OccContactShape shape,
+                            SP::OccBody body,
+                            unsigned int group)
+{
+  Contactor contactor;
+  contactor.shape = shape;
+  contactor.body = body;
+  contactor.group = group;
+
+  /* the face or the edge, back in the frame of the shape */
+  TopLoc_Location inverse = shape->data().Location().Inverted();
+  Bnd_Box box;
+  /* contactType() is the type of the whole shape, a face or an edge
+   * of a solid is known by its class */
+  const OccContactFace* face = dynamic_cast<const OccContactFace*>(&*shape);
+  const OccContactEdge* edge = dynamic_cast<const OccContactEdge*>(&*shape);
+  if (face)
+    BRepBndLib::Add(face->contact()->Moved(inverse), box);
+  else if (edge)
+    BRepBndLib::Add(edge->contact()->Moved(inverse), box);
+  else
+    RuntimeException::selfThrow("OccSpaceFilter::insert: the contact shape is neither a face nor an edge");
+  box.Get(contactor.localBox[0], contactor.localBox[1], contactor.localBox[2],
+          contactor.localBox[3], contactor.localBox[4], contactor.localBox[5]);
+
+  _contactors.push_back(contactor);
+}
+
+void OccSpaceFilter::updateBoundingBoxes()
+{
+  for (unsigned int i = 0; i < _contactors.size(); ++i)
+  {
+    Contactor& contactor = _contactors[i];
+    const gp_Trsf& transfo = contactor.shape->data().Location().Transformation();
+    const double* b = contactor.localBox;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      contactor.box[k] = std::numeric_limits<double>::infinity();
+      contactor.box[k + 3] = -std::numeric_limits<double>::infinity();
+    }
+
+    /* box of the moved corners */
+    for (unsigned int c = 0; c < 8; ++c)
+    {
+      gp_Pnt corner(b[(c & 1) ? 3 : 0], b[(c & 2) ? 4 : 1], b[(c & 4) ? 5 : 2]);
+      corner.Transform(transfo);
+      double x[3] = { corner.X(), corner.Y(), corner.Z() };
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        contactor.box[k] = std::min(contactor.box[k], x[k]);
+        contactor.box[k + 3] = std::max(contactor.box[k + 3], x[k]);
+      }
+    }
+
+    /* the margin is shared by the two boxes of a pair */
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      contactor.box[k] -= 0.5 * _margin;
+      contactor.box[k + 3] += 0.5 * _margin;
+    }
+  }
+}
+
+/* order of the contactors along x */
+struct OccSpaceFilterLowerX
+{
+  const std::vector<double>& xmin;
+  OccSpaceFilterLowerX(const std::vector<double>& xmin) : xmin(xmin) {};
+  bool operator() (unsigned int i, unsigned int j) const
+  {
+    return xmin[i] < xmin[j];
+  }
+};
+
+void OccSpaceFilter::overlappingPairs(std::vector<std::pair<unsigned int, unsigned int> >& pairs)
+{
+  unsigned int n = _contactors.size();
+  std::vector<double> xmin(n);
+  std::vector<unsigned int> order(n);
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    xmin[i] = _contactors[i].box[0];
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), OccSpaceFilterLowerX(xmin));
+
+  /* sweep along x, the boxes met before and still open are the
+   * candidates */
+  pairs.clear();
+  for (unsigned int p = 0; p < n; ++p)
+  {
+    const Contactor& c1 = _contactors[order[p]];
+    for (unsigned int q = p + 1; q < n; ++q)
+    {
+      const Contactor& c2 = _contactors[order[q]];
+      if (c2.box[0] > c1.box[3])
+        break;
+      if (c2.box[1] > c1.box[4] || c1.box[1] > c2.box[4] ||
+          c2.box[2] > c1.box[5] || c1.box[2] > c2.box[5])
+        continue;
+      pairs.push_back(std::make_pair(std::min(order[p], order[q]),
+                                     std::max(order[p], order[q])));
+    }
+  }
+}
+
+void OccSpaceFilter::updateInteractions(SP::Simulation simulation)
+{
+  DEBUG_BEGIN("OccSpaceFilter::updateInteractions(SP::Simulation simulation)\n");
+  updateBoundingBoxes();
+
+  std::vector<std::pair<unsigned int, unsigned int> > pairs;
+  overlappingPairs(pairs);
+  std::sort(pairs.begin(), pairs.end());
+
+  /* new pairs */
+  for (unsigned int p = 0; p < pairs.size(); ++p)
+  {
+    if (_pairs.find(pairs[p]) != _pairs.end())
+      continue;
+
+    unsigned int i = pairs[p].first;
+    unsigned int j = pairs[p].second;
+
+    /* the first contactor is on a body */
+    if (!_contactors[i].body)
+      std::swap(i, j);
+    const Contactor& c1 = _contactors[i];
+    const Contactor& c2 = _contactors[j];
+
+    if (!c1.body || c1.body == c2.body)
+      continue;
+    if (dynamic_cast<OccContactEdge*>(&*c1.shape) &&
+        dynamic_cast<OccContactEdge*>(&*c2.shape))
+      continue;
+
+    SP::NonSmoothLaw nslaw = nonSmoothLaw(c1.group, c2.group);
+    if (!nslaw)
+      continue;
+
+    ContactPair contact;
+    contact.contact1.reset(new ContactPoint(*c1.shape));
+    contact.contact2.reset(new ContactPoint(*c2.shape));
+    SP::OccR relation(new OccR(*contact.contact1, *contact.contact2,
+                               *_distanceCalculator));
+    relation->setOffset1(_offset1);
+    relation->setOffset2(_offset2);
+    contact.interaction.reset(new Interaction(nslaw, relation));
+
+    if (c2.body)
+      simulation->link(contact.interaction, c1.body, c2.body);
+    else
+      simulation->link(contact.interaction, c1.body);
+
+    DEBUG_PRINTF("link contactors %i and %i\n", i, j);
+    _pairs[pairs[p]] = contact;
+  }
+
+  /* pairs whose boxes do not overlap anymore */
+  ContactPairs::iterator it = _pairs.begin();
+  while (it != _pairs.end())
+  {
+    if (std::binary_search(pairs.begin(), pairs.end(), it->first))
+    {
+      ++it;
+    }
+    else
+    {
+      DEBUG_PRINTF("unlink contactors %i and %i\n", it->first.first, it->first.second);
+      simulation->unlink(it->second.interaction);
+      _pairs.erase(it++);
+    }
+  }
+  DEBUG_END("OccSpaceFilter::updateInteractions(SP::Simulation simulation)\n");
+}
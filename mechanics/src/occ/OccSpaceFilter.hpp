@@ -1,14 +1,144 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/** \file OccSpaceFilter.hpp
+    \brief broad phase contact detection between OpenCascade contact shapes
+ */
 #ifndef OccSpaceFilter_hpp
 #define OccSpaceFilter_hpp
 
 #include "SpaceFilter.hpp"
 
+#include <vector>
+#include <map>
+
+/** Broad phase contact detection between the faces and edges of
+ *  OccBody objects.
+ *
+ *  The contactors are declared with insert(). The bounding box of
+ *  each contactor is computed once in the frame of its shape, and
+ *  moved at each step with the location given to the shape by
+ *  occ_move. Boxes enlarged by the margin are sorted along x and swept
+ *  to find the overlapping pairs: an OccR interaction is created for
+ *  a new pair and removed when the boxes do not overlap anymore.
+ *
+ *  A pair is considered only if a nonsmooth law has been inserted for
+ *  the groups of its contactors, and if one of them is a face (the
+ *  edge/edge distance is not implemented).
+ */
 class OccSpaceFilter : public SpaceFilter
 {
+protected:
+
+  /** a face or an edge, and the body it moves with */
+  struct Contactor
+  {
+    SP::OccContactShape shape;
+    SP::OccBody body;
+    unsigned int group;
+    /** bounding box in the frame of the shape (xmin, ymin, zmin,
+     * xmax, ymax, zmax) */
+    double localBox[6];
+    /** current bounding box, with the margin */
+    double box[6];
+  };
+
+  /** an interaction between two contactors */
+  struct ContactPair
+  {
+    SP::ContactPoint contact1;
+    SP::ContactPoint contact2;
+    SP::Interaction interaction;
+  };
+
+  typedef std::map<std::pair<unsigned int, unsigned int>, ContactPair> ContactPairs;
+
+  std::vector<Contactor> _contactors;
+
+  ContactPairs _pairs;
+
+  /** distance under which an interaction is created */
+  double _margin;
+
+  /** offsets given to the OccR relations */
+  double _offset1;
+  double _offset2;
+
+  /** distance calculator given to the OccR relations */
+  SP::DistanceCalculatorType _distanceCalculator;
+
+  /** compute the current bounding boxes of the contactors */
+  void updateBoundingBoxes();
+
+  /** the pairs of contactors whose bounding boxes overlap
+   * \param pairs the pairs (i, j), i < j
+   */
+  void overlappingPairs(std::vector<std::pair<unsigned int, unsigned int> >& pairs);
+
 public:
-  OccSpaceFilter() : SpaceFilter() {};
 
-  virtual void updateInteractions(SP::Simulation) {};
+  /** default constructor: no margin, OccDistanceType distance */
+  OccSpaceFilter();
+
+  /** declare a contactor
+   * \param shape a face or an edge (OccContactFace, OccContactEdge)
+   * \param body the body the shape moves with, or a null pointer for
+   * a static shape, already in place
+   * \param group contact group of the shape, for the choice of the
+   * nonsmooth law
+   */
+  void insert(SP::OccContactShape shape,
+              SP::OccBody body = SP::OccBody(),
+              unsigned int group = 0);
+
+  /** set the distance under which an interaction is created
+   * \param margin the distance
+   */
+  void setMargin(double margin) { _margin = margin; };
+
+  /** \return the distance under which an interaction is created */
+  double margin() const { return _margin; };
+
+  /** set the offsets of the OccR relations
+   * \param offset1 offset of the first contact
+   * \param offset2 offset of the second contact
+   */
+  void setOffsets(double offset1, double offset2)
+  {
+    _offset1 = offset1;
+    _offset2 = offset2;
+  };
+
+  /** set the distance calculator of the OccR relations
+   * \param distanceCalculator an OccDistanceType or a CadmbtbDistanceType
+   */
+  void setDistanceCalculator(SP::DistanceCalculatorType distanceCalculator)
+  {
+    _distanceCalculator = distanceCalculator;
+  };
+
+  /** \return the number of interactions created by the filter */
+  unsigned int numberOfContactPairs() const { return _pairs.size(); };
+
+  /** Broadphase contact detection: link the interactions of the close
+   *  contactors, unlink the ones of the contactors that moved away.
+   *  \param simulation the current simulation setup
+   */
+  virtual void updateInteractions(SP::Simulation simulation);
 
 };
 
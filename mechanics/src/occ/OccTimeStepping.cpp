@@ -12,7 +12,13 @@ class OccBody;
 #include "OccTimeStepping.hpp"
 #include "OccBody.hpp"
 
+#include "OccR.hpp"
+
 #include <NonSmoothDynamicalSystem.hpp>
+#include <Topology.hpp>
+#include <Interaction.hpp>
+#include <SiconosConfig.h>
+#include <vector>
 
 #include <SiconosVisitor.hpp>
 
@@ -51,4 +57,25 @@ void OccTimeStepping::updateWorldFromDS()
     dsg.bundle(*dsi)->accept(up);
   }
 
+  // the distances of the contacts are independent: they are computed
+  // here, once the shapes are in place, and used by OccR::computeh
+  InteractionsGraph& indexSet0 = *_nsds->topology()->indexSet0();
+  std::vector<OccR*> relations;
+  relations.reserve(indexSet0.size());
+  InteractionsGraph::VIterator ui, uiend;
+  for (std11::tie(ui, uiend) = indexSet0.vertices(); ui != uiend; ++ui)
+  {
+    OccR* relation = dynamic_cast<OccR*>(indexSet0.bundle(*ui)->relation().get());
+    if (relation)
+      relations.push_back(relation);
+  }
+
+  int nrelations = relations.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < nrelations; ++i)
+  {
+    relations[i]->computeDistance();
+  }
 }
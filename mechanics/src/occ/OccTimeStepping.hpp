@@ -12,6 +12,8 @@ public:
 
   OccTimeStepping(SP::NonSmoothDynamicalSystem nsds, SP::TimeDiscretisation td) : TimeStepping(nsds,td) {};
 
+  /** move the shapes of the bodies, then compute the distances of
+   * the OccR contacts, concurrently when built with OpenMP */
   virtual void updateWorldFromDS();
 
 };
@@ -1,14 +1,23 @@
 #include "OccUtils.hpp"
 #include "OccContactFace.hpp"
 #include "OccContactEdge.hpp"
+#include "ContactShapeDistance.hpp"
 #include "SiconosVector.hpp"
 #include <TopoDS.hxx>
 #include <gp_Dir.hxx>
+#include <gp_Pnt2d.hxx>
 #include <gp_Quaternion.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <BRepClass_FaceClassifier.hxx>
+#include <cmath>
+#include <algorithm>
 
 #include <cadmbtb.hpp>
 
+//#define DEBUG_MESSAGES 1
+#include <debug.h>
 
 void occ_move(TopoDS_Shape& shape, const SiconosVector& q)
 {
@@ -23,25 +32,17 @@ void occ_move(TopoDS_Shape& shape, const SiconosVector& q)
   shape.Location(TopLoc_Location(transfo));
 }
 
-void occ_distanceFaceFace(const OccContactFace& csh1,
-                          const OccContactFace& csh2,
-                          Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
-                          Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
-                          Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                          Standard_Real& MinDist)
+/* global search, with the parameters of the closest points */
+static void occ_globalDistanceFaceFace(const TopoDS_Face& face1,
+                                       const TopoDS_Face& face2,
+                                       ContactShapeDistance& dist)
 {
-  // need the 2 sp pointers to keep memory
-  SPC::TopoDS_Face pface1 = csh1.contact();
-  SPC::TopoDS_Face pface2 = csh2.contact();
-
-  const TopoDS_Face& face1 = *pface1;
-  const TopoDS_Face& face2 = *pface2;
-
   BRepExtrema_DistShapeShape measure;
   measure.LoadS1(face1);
   measure.LoadS2(face2);
   measure.Perform();
 
+  dist.hasParameters = false;
   if (measure.IsDone())
   {
     /* we look for the first solution on a face */
@@ -53,23 +54,26 @@ void occ_distanceFaceFace(const OccContactFace& csh1,
          const gp_Pnt& p1 = measure.PointOnShape1(i);
          const gp_Pnt& p2 = measure.PointOnShape2(i);
 
-         Standard_Real u, v;
-
-         measure.ParOnFaceS2(i, u, v);
-         gp_Dir normal = cadmbtb_FaceNormal(face2, u, v);
-         normal.Coord(nX,nY,nZ);
-         X1 = p1.X();
-         X2 = p2.X();
-         Y1 = p1.Y();
-         Y2 = p2.Y();
-         Z1 = p1.Z();
-         Z2 = p2.Z();
-         if(((X1-X2)*nX+(Y1-Y2)*nY+(Z1-Z2)*nZ)<0)
+         measure.ParOnFaceS2(i, dist.u2, dist.v2);
+         gp_Dir normal = cadmbtb_FaceNormal(face2, dist.u2, dist.v2);
+         normal.Coord(dist.nx, dist.ny, dist.nz);
+         dist.x1 = p1.X();
+         dist.x2 = p2.X();
+         dist.y1 = p1.Y();
+         dist.y2 = p2.Y();
+         dist.z1 = p1.Z();
+         dist.z2 = p2.Z();
+         if(((dist.x1-dist.x2)*dist.nx+(dist.y1-dist.y2)*dist.ny+(dist.z1-dist.z2)*dist.nz)<0)
          {
            normal.Reverse();
          }
-         normal.Coord(nX,nY,nZ);
-         MinDist = measure.Value();
+         normal.Coord(dist.nx, dist.ny, dist.nz);
+         dist.value = measure.Value();
+         if (measure.SupportTypeShape1(i) == BRepExtrema_IsInFace)
+         {
+           measure.ParOnFaceS1(i, dist.u1, dist.v1);
+           dist.hasParameters = true;
+         }
          break;
       }
     }
@@ -77,25 +81,18 @@ void occ_distanceFaceFace(const OccContactFace& csh1,
   else
     RuntimeException::selfThrow("occ distance: BRepExtrema_DistShapeShape failed");
 }
-void occ_distanceFaceEdge(const OccContactFace& csh1,
-                          const OccContactEdge& csh2,
-                          Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
-                          Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
-                          Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
-                          Standard_Real& MinDist)
-{
-  // need the 2 sp pointers to keep memory
-  SPC::TopoDS_Face pface1 = csh1.contact();
-  SPC::TopoDS_Edge pedge2 = csh2.contact();
-
-  const TopoDS_Face& face1 = *pface1;
-  const TopoDS_Edge& edge2 = *pedge2;
 
+/* global search, with the parameters of the closest points */
+static void occ_globalDistanceFaceEdge(const TopoDS_Face& face1,
+                                       const TopoDS_Edge& edge2,
+                                       ContactShapeDistance& dist)
+{
   BRepExtrema_DistShapeShape measure;
   measure.LoadS1(face1);
   measure.LoadS2(edge2);
   measure.Perform();
 
+  dist.hasParameters = false;
   if (measure.IsDone())
   {
     int nb_solutions = measure.NbSolution();
@@ -107,21 +104,25 @@ void occ_distanceFaceEdge(const OccContactFace& csh1,
         const gp_Pnt& p1 = measure.PointOnShape1(i);
         const gp_Pnt& p2 = measure.PointOnShape2(i);
 
-        Standard_Real u, v;
-
-        measure.ParOnFaceS1(1, u, v);
-        gp_Dir normal = cadmbtb_FaceNormal(face1, u, v);
-        normal.Coord(nX,nY,nZ);
-        X1 = p1.X();
-        X2 = p2.X();
-        Y1 = p1.Y();
-        Y2 = p2.Y();
-        Z1 = p1.Z();
-        Z2 = p2.Z();
-        if(((X1-X2)*nX+(Y1-Y2)*nY+(Z1-Z2)*nZ)>0)
+        measure.ParOnFaceS1(i, dist.u1, dist.v1);
+        gp_Dir normal = cadmbtb_FaceNormal(face1, dist.u1, dist.v1);
+        normal.Coord(dist.nx, dist.ny, dist.nz);
+        dist.x1 = p1.X();
+        dist.x2 = p2.X();
+        dist.y1 = p1.Y();
+        dist.y2 = p2.Y();
+        dist.z1 = p1.Z();
+        dist.z2 = p2.Z();
+        if(((dist.x1-dist.x2)*dist.nx+(dist.y1-dist.y2)*dist.ny+(dist.z1-dist.z2)*dist.nz)>0)
           normal.Reverse();
-        normal.Coord(nX,nY,nZ);
-        MinDist = measure.Value();
+        normal.Coord(dist.nx, dist.ny, dist.nz);
+        dist.value = measure.Value();
+        if (measure.SupportTypeShape2(i) == BRepExtrema_IsOnEdge)
+        {
+          measure.ParOnEdgeS2(i, dist.u2);
+          dist.v2 = 0.;
+          dist.hasParameters = true;
+        }
         break;
       }
     }
@@ -130,3 +131,288 @@ void occ_distanceFaceEdge(const OccContactFace& csh1,
   else
     RuntimeException::selfThrow("occ distance: BRepExtrema_DistShapeShape failed");
 }
+
+/* P1(x) - P2(x) and its derivatives, x = (u1, v1, u2, v2) */
+struct FaceFaceGap
+{
+  BRepAdaptor_Surface s1;
+  BRepAdaptor_Surface s2;
+  enum { size = 4 };
+
+  FaceFaceGap(const TopoDS_Face& face1, const TopoDS_Face& face2) :
+    s1(face1), s2(face2) {};
+
+  void operator() (const double* x, gp_Pnt& p1, gp_Pnt& p2, gp_Vec* J) const
+  {
+    gp_Vec d2u, d2v;
+    s1.D1(x[0], x[1], p1, J[0], J[1]);
+    s2.D1(x[2], x[3], p2, d2u, d2v);
+    J[2] = -d2u;
+    J[3] = -d2v;
+  }
+};
+
+/* P1(x) - P2(x) and its derivatives, x = (u1, v1, u2) */
+struct FaceEdgeGap
+{
+  BRepAdaptor_Surface s1;
+  BRepAdaptor_Curve c2;
+  enum { size = 3 };
+
+  FaceEdgeGap(const TopoDS_Face& face1, const TopoDS_Edge& edge2) :
+    s1(face1), c2(edge2) {};
+
+  void operator() (const double* x, gp_Pnt& p1, gp_Pnt& p2, gp_Vec* J) const
+  {
+    gp_Vec d2u;
+    s1.D1(x[0], x[1], p1, J[0], J[1]);
+    c2.D1(x[2], p2, d2u);
+    J[2] = -d2u;
+  }
+};
+
+/* Levenberg-Marquardt minimization of |P1(x) - P2(x)|^2 from x,
+ * within the bounds [binf, bsup]. Returns false if the iterations do
+ * not converge or leave the bounds. */
+template<typename Gap>
+static bool occ_localClosestPoints(const Gap& gap, double* x,
+                                   const double* binf, const double* bsup,
+                                   gp_Pnt& p1, gp_Pnt& p2)
+{
+  const int n = Gap::size;
+  const int maxIter = 30;
+  const double tol = 1e-10;
+  gp_Vec J[n], Jt[n];
+  gp_Pnt q1, q2;
+  double xt[n], dx[n], A[n*n], L[n*n], g[n];
+  double lambda = 1e-3;
+
+  gap(x, p1, p2, J);
+  gp_Vec r(p2, p1);
+  double f = r.SquareMagnitude();
+
+  for (int iter = 0; iter < maxIter; ++iter)
+  {
+    /* normal equations */
+    double gnorm = 0., jnorm = 0.;
+    for (int k = 0; k < n; ++k)
+    {
+      g[k] = J[k].Dot(r);
+      for (int l = 0; l <= k; ++l)
+        A[k*n+l] = A[l*n+k] = J[k].Dot(J[l]);
+      gnorm = std::max(gnorm, fabs(g[k]));
+      jnorm = std::max(jnorm, A[k*n+k]);
+    }
+    /* stationary point: the gap is orthogonal to the tangents */
+    if (gnorm <= tol * (sqrt(jnorm * f) + 1.))
+      return true;
+
+    /* damped system, solved by Cholesky */
+    bool spd = true;
+    for (int k = 0; k < n && spd; ++k)
+    {
+      for (int l = 0; l <= k; ++l)
+      {
+        double s = A[k*n+l] + ((k == l) ? lambda * (A[k*n+k] + tol) : 0.);
+        for (int m = 0; m < l; ++m)
+          s -= L[k*n+m] * L[l*n+m];
+        if (k == l)
+        {
+          if (s <= 0.) { spd = false; break; }
+          L[k*n+k] = sqrt(s);
+        }
+        else
+          L[k*n+l] = s / L[l*n+l];
+      }
+    }
+    if (!spd)
+    {
+      lambda *= 10.;
+      continue;
+    }
+    for (int k = 0; k < n; ++k)
+    {
+      double s = -g[k];
+      for (int m = 0; m < k; ++m)
+        s -= L[k*n+m] * dx[m];
+      dx[k] = s / L[k*n+k];
+    }
+    for (int k = n - 1; k >= 0; --k)
+    {
+      double s = dx[k];
+      for (int m = k + 1; m < n; ++m)
+        s -= L[m*n+k] * dx[m];
+      dx[k] = s / L[k*n+k];
+    }
+
+    /* the closest points must stay within the bounds */
+    double step = 0.;
+    for (int k = 0; k < n; ++k)
+    {
+      xt[k] = x[k] + dx[k];
+      double range = bsup[k] - binf[k];
+      if (xt[k] < binf[k] - tol * range || xt[k] > bsup[k] + tol * range)
+        return false;
+      step = std::max(step, fabs(dx[k]) / (range + tol));
+    }
+
+    gap(xt, q1, q2, Jt);
+    gp_Vec rt(q2, q1);
+    double ft = rt.SquareMagnitude();
+    if (ft <= f)
+    {
+      for (int k = 0; k < n; ++k)
+      {
+        x[k] = xt[k];
+        J[k] = Jt[k];
+      }
+      p1 = q1;
+      p2 = q2;
+      r = rt;
+      f = ft;
+      lambda = std::max(lambda * 0.1, 1e-12);
+      if (step <= tol)
+        return true;
+    }
+    else
+      lambda *= 10.;
+  }
+  return false;
+}
+
+/* a point of the parametric space is on the face, not only in the UV box */
+static bool occ_isOnFace(const TopoDS_Face& face, double u, double v)
+{
+  BRepClass_FaceClassifier classifier(face, gp_Pnt2d(u, v), 1e-7);
+  TopAbs_State state = classifier.State();
+  return state == TopAbs_IN || state == TopAbs_ON;
+}
+
+void occ_distanceFaceFace(const OccContactFace& csh1,
+                          const OccContactFace& csh2,
+                          Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
+                          Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
+                          Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
+                          Standard_Real& MinDist)
+{
+  // need the 2 sp pointers to keep memory
+  SPC::TopoDS_Face pface1 = csh1.contact();
+  SPC::TopoDS_Face pface2 = csh2.contact();
+
+  ContactShapeDistance dist;
+  dist.x1 = X1; dist.y1 = Y1; dist.z1 = Z1;
+  dist.x2 = X2; dist.y2 = Y2; dist.z2 = Z2;
+  dist.nx = nX; dist.ny = nY; dist.nz = nZ;
+  dist.value = MinDist;
+  occ_globalDistanceFaceFace(*pface1, *pface2, dist);
+
+  X1 = dist.x1; Y1 = dist.y1; Z1 = dist.z1;
+  X2 = dist.x2; Y2 = dist.y2; Z2 = dist.z2;
+  nX = dist.nx; nY = dist.ny; nZ = dist.nz;
+  MinDist = dist.value;
+}
+
+void occ_distanceFaceEdge(const OccContactFace& csh1,
+                          const OccContactEdge& csh2,
+                          Standard_Real& X1, Standard_Real& Y1, Standard_Real& Z1,
+                          Standard_Real& X2, Standard_Real& Y2, Standard_Real& Z2,
+                          Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
+                          Standard_Real& MinDist)
+{
+  // need the 2 sp pointers to keep memory
+  SPC::TopoDS_Face pface1 = csh1.contact();
+  SPC::TopoDS_Edge pedge2 = csh2.contact();
+
+  ContactShapeDistance dist;
+  dist.x1 = X1; dist.y1 = Y1; dist.z1 = Z1;
+  dist.x2 = X2; dist.y2 = Y2; dist.z2 = Z2;
+  dist.nx = nX; dist.ny = nY; dist.nz = nZ;
+  dist.value = MinDist;
+  occ_globalDistanceFaceEdge(*pface1, *pedge2, dist);
+
+  X1 = dist.x1; Y1 = dist.y1; Z1 = dist.z1;
+  X2 = dist.x2; Y2 = dist.y2; Z2 = dist.z2;
+  nX = dist.nx; nY = dist.ny; nZ = dist.nz;
+  MinDist = dist.value;
+}
+
+void occ_distanceFaceFace(const OccContactFace& csh1,
+                          const OccContactFace& csh2,
+                          ContactShapeDistance& dist)
+{
+  // need the 2 sp pointers to keep memory
+  SPC::TopoDS_Face pface1 = csh1.contact();
+  SPC::TopoDS_Face pface2 = csh2.contact();
+
+  const TopoDS_Face& face1 = *pface1;
+  const TopoDS_Face& face2 = *pface2;
+
+  if (dist.hasParameters)
+  {
+    double x[4] = { dist.u1, dist.v1, dist.u2, dist.v2 };
+    double binf[4] = { csh1.binf1[0], csh1.binf1[1], csh2.binf1[0], csh2.binf1[1] };
+    double bsup[4] = { csh1.bsup1[0], csh1.bsup1[1], csh2.bsup1[0], csh2.bsup1[1] };
+    gp_Pnt p1, p2;
+    if (occ_localClosestPoints(FaceFaceGap(face1, face2), x, binf, bsup, p1, p2)
+        && occ_isOnFace(face1, x[0], x[1]) && occ_isOnFace(face2, x[2], x[3]))
+    {
+      dist.u1 = x[0];
+      dist.v1 = x[1];
+      dist.u2 = x[2];
+      dist.v2 = x[3];
+      p1.Coord(dist.x1, dist.y1, dist.z1);
+      p2.Coord(dist.x2, dist.y2, dist.z2);
+      gp_Dir normal = cadmbtb_FaceNormal(face2, dist.u2, dist.v2);
+      normal.Coord(dist.nx, dist.ny, dist.nz);
+      if(((dist.x1-dist.x2)*dist.nx+(dist.y1-dist.y2)*dist.ny+(dist.z1-dist.z2)*dist.nz)<0)
+      {
+        normal.Reverse();
+      }
+      normal.Coord(dist.nx, dist.ny, dist.nz);
+      dist.value = p1.Distance(p2);
+      DEBUG_PRINTF("occ_distanceFaceFace: local search, distance %g\n", dist.value);
+      return;
+    }
+    DEBUG_PRINT("occ_distanceFaceFace: local search failed, global search\n");
+  }
+  occ_globalDistanceFaceFace(face1, face2, dist);
+}
+
+void occ_distanceFaceEdge(const OccContactFace& csh1,
+                          const OccContactEdge& csh2,
+                          ContactShapeDistance& dist)
+{
+  // need the 2 sp pointers to keep memory
+  SPC::TopoDS_Face pface1 = csh1.contact();
+  SPC::TopoDS_Edge pedge2 = csh2.contact();
+
+  const TopoDS_Face& face1 = *pface1;
+  const TopoDS_Edge& edge2 = *pedge2;
+
+  if (dist.hasParameters)
+  {
+    double x[3] = { dist.u1, dist.v1, dist.u2 };
+    double binf[3] = { csh1.binf1[0], csh1.binf1[1], csh2.binf1[0] };
+    double bsup[3] = { csh1.bsup1[0], csh1.bsup1[1], csh2.bsup1[0] };
+    gp_Pnt p1, p2;
+    if (occ_localClosestPoints(FaceEdgeGap(face1, edge2), x, binf, bsup, p1, p2)
+        && occ_isOnFace(face1, x[0], x[1]))
+    {
+      dist.u1 = x[0];
+      dist.v1 = x[1];
+      dist.u2 = x[2];
+      p1.Coord(dist.x1, dist.y1, dist.z1);
+      p2.Coord(dist.x2, dist.y2, dist.z2);
+      gp_Dir normal = cadmbtb_FaceNormal(face1, dist.u1, dist.v1);
+      normal.Coord(dist.nx, dist.ny, dist.nz);
+      if(((dist.x1-dist.x2)*dist.nx+(dist.y1-dist.y2)*dist.ny+(dist.z1-dist.z2)*dist.nz)>0)
+        normal.Reverse();
+      normal.Coord(dist.nx, dist.ny, dist.nz);
+      dist.value = p1.Distance(p2);
+      DEBUG_PRINTF("occ_distanceFaceEdge: local search, distance %g\n", dist.value);
+      return;
+    }
+    DEBUG_PRINT("occ_distanceFaceEdge: local search failed, global search\n");
+  }
+  occ_globalDistanceFaceEdge(face1, edge2, dist);
+}
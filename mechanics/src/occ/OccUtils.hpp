@@ -7,6 +7,7 @@
 
 class OccContactFace;
 class OccContactEdge;
+struct ContactShapeDistance;
 
 void occ_move(TopoDS_Shape& shape, const SiconosVector& pos);
 
@@ -24,4 +25,27 @@ void occ_distanceFaceEdge(const OccContactFace& csh1,
                           Standard_Real& nX, Standard_Real& nY, Standard_Real& nZ,
                           Standard_Real& MinDist);
 
+/** Closest points of two faces, searched locally from the parameters
+ * of the previous closest points stored in dist. The global search of
+ * occ_distanceFaceFace is used when there are no previous parameters,
+ * or when the local search fails or leaves the UV bounds of a face.
+ * \param csh1 the first face
+ * \param csh2 the second face, which gives the normal
+ * \param dist the previous closest points on input, the new ones on output
+ */
+void occ_distanceFaceFace(const OccContactFace& csh1,
+                          const OccContactFace& csh2,
+                          ContactShapeDistance& dist);
+
+/** Closest points of a face and an edge, searched locally from the
+ * parameters of the previous closest points stored in dist, with the
+ * global search of occ_distanceFaceEdge as a fallback.
+ * \param csh1 the face, which gives the normal
+ * \param csh2 the edge
+ * \param dist the previous closest points on input, the new ones on output
+ */
+void occ_distanceFaceEdge(const OccContactFace& csh1,
+                          const OccContactEdge& csh2,
+                          ContactShapeDistance& dist);
+
 #endif
@@ -8,6 +8,12 @@
 #include "ContactPoint.hpp"
 #include "WhichGeometer.hpp"
 #include "WhichGeometer.hpp"
+#include "OccSpaceFilter.hpp"
+
+#include <NonSmoothDynamicalSystem.hpp>
+#include <TimeDiscretisation.hpp>
+#include <TimeStepping.hpp>
+#include <NewtonImpactFrictionNSL.hpp>
 
 #include <TopoDS_Shape.hxx>
 #include <BRepPrimAPI_MakeSphere.hxx>
@@ -133,6 +139,77 @@ void OccTest::move()
   CPPUNIT_ASSERT(std::abs(rotat.W() - 0.35634832254989918) < 1e-9);
 
 }
+
+void OccTest::spaceFilter()
+{
+  /* two unit spheres, each with its own shape */
+  BRepPrimAPI_MakeSphere mksphere1(1.0);
+  BRepPrimAPI_MakeSphere mksphere2(1.0);
+
+  OccContactShape sphere1(mksphere1.Shape());
+  OccContactShape sphere2(mksphere2.Shape());
+  OccContactFace sphere1_contact(sphere1, 0);
+  OccContactFace sphere2_contact(sphere2, 0);
+
+  SP::SiconosVector position1(new SiconosVector(7));
+  SP::SiconosVector position2(new SiconosVector(7));
+  SP::SiconosVector velocity1(new SiconosVector(6));
+  SP::SiconosVector velocity2(new SiconosVector(6));
+  SP::SimpleMatrix inertia(new SimpleMatrix(3,3));
+  position1->zero();
+  position2->zero();
+  (*position1)(3) = 1.;
+  (*position2)(3) = 1.;
+  /* the boxes overlap, the spheres do not */
+  (*position2)(0) = 1.8;
+  (*position2)(1) = 1.8;
+  velocity1->zero();
+  velocity2->zero();
+  inertia->eye();
+
+  SP::OccBody body1(new OccBody(position1, velocity1, 1, inertia));
+  SP::OccBody body2(new OccBody(position2, velocity2, 1, inertia));
+
+  SP::OccContactShape shape1 = createSPtrOccContactShape(sphere1_contact);
+  SP::OccContactShape shape2 = createSPtrOccContactShape(sphere2_contact);
+  body1->addContactShape(shape1);
+  body2->addContactShape(shape2);
+
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0., 1.));
+  nsds->insertDynamicalSystem(body1);
+  nsds->insertDynamicalSystem(body2);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0., 1e-3));
+  SP::TimeStepping simulation(new TimeStepping(nsds, td));
+
+  SP::OccSpaceFilter filter(new OccSpaceFilter());
+  filter->insertNonSmoothLaw(SP::NonSmoothLaw(new NewtonImpactFrictionNSL(0., 0., 0.3, 3)), 0, 0);
+  filter->insert(shape1, body1);
+  filter->insert(shape2, body2);
+
+  filter->updateInteractions(simulation);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("overlapping boxes", 1u, filter->numberOfContactPairs());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("interaction linked", 1u, nsds->getNumberOfInteractions());
+
+  /* a second update keeps the same interaction */
+  filter->updateInteractions(simulation);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("same pair", 1u, filter->numberOfContactPairs());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("no new interaction", 1u, nsds->getNumberOfInteractions());
+
+  /* the second body moves away */
+  (*body2->q())(0) = 5.;
+  body2->updateContactShapes();
+
+  filter->updateInteractions(simulation);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("separated boxes", 0u, filter->numberOfContactPairs());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("interaction unlinked", 0u, nsds->getNumberOfInteractions());
+
+  /* the margin brings the pair back */
+  filter->setMargin(3.);
+  filter->updateInteractions(simulation);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("boxes with margin", 1u, filter->numberOfContactPairs());
+}
+
 #ifdef HAS_FORTRAN
 void OccTest::distance()
 {
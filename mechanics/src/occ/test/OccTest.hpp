@@ -34,6 +34,8 @@ private:
   CPPUNIT_TEST(computeUVBounds);
 
   CPPUNIT_TEST(move);
+
+  CPPUNIT_TEST(spaceFilter);
 #ifdef HAS_FORTRAN
   CPPUNIT_TEST(distance);
 #endif
@@ -46,6 +48,8 @@ private:
 
   void move();
 
+  void spaceFilter();
+
 #ifdef HAS_FORTRAN
   void distance();
 #endif
@@ -20,6 +20,9 @@ if(WITH_${COMPONENT}_TESTING)
     NEW_TEST(test_dgels test_dgels.c)
   endif()
   NEW_TEST(test_dpotrf test_dpotrf.c)
+  NEW_TEST(test_complementarity_enum test_complementarity_enum.c)
+  NEW_TEST(test_reentrant_drivers test_reentrant_drivers.c)
+  NEW_TEST(test_solver_workspace test_solver_workspace.c)
 
   NEW_TEST(NumericsArrays_test NumericsArrays.c)
   
@@ -221,6 +224,7 @@ if(WITH_${COMPONENT}_TESTING)
     NEW_TEST(MLCPtest main_mlcp.cpp)
   ENDIF(HAVE_SYSTIMES_H AND WITH_CXX)
   NEW_TEST(ReadWrite_MLCPtest MixedLinearComplementarity_ReadWrite_test.c)
+  NEW_TEST(MLCP_direct_cache_test MLCP_direct_cache_test.c)
   END_TEST()
 
   BEGIN_TEST(src/MCP/test)
@@ -268,6 +272,7 @@ if(WITH_${COMPONENT}_TESTING)
   SET(NSGS_NB_IT 10000)
   NEW_TEST(FC3D_DefaultSolverOptionstest fc3d_DefaultSolverOptions_test.c)
   NEW_TEST(FC3D_sparse_test fc3d_sparse_test.c)
+  NEW_TEST(FC3D_batch_test fc3d_batch_test.c)
 
   STRING(CONCAT FC3D_SIMPLE_SET "FC3D_Example1.dat;FC3D_Example1_SBM.dat;FrictionContact3D_1c.dat;FrictionContact3D_RR_1c.dat;")
   
@@ -309,6 +314,8 @@ if(WITH_${COMPONENT}_TESTING)
       SICONOS_FRICTION_3D_ONECONTACT_NSN_GP 0 0
       INTERNAL_IPARAM SICONOS_FRICTION_3D_NSN_HYBRID_STRATEGY SICONOS_FRICTION_3D_NSN_HYBRID_STRATEGY_PLI_NSN_LOOP)
 
+    NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSGS_DDM 1e-5 10000)
+
 
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_ADMM 1e-5 10000
       0 0 0
@@ -329,6 +336,18 @@ if(WITH_${COMPONENT}_TESTING)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_AC_TEST 1e-3 1000)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_FB 1e-3 1000)
     NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_NM 1e-3 1000)
+
+    # --- Matrix-free Newton-Krylov on FC3D_DATA_SET ---
+    NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_AC 1e-5 1000
+      0 0 0
+      IPARAM 1 1
+      IPARAM SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER SICONOS_FRICTION_3D_NSN_USE_KRYLOV)
+    NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_FB 1e-3 1000
+      0 0 0
+      IPARAM SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER SICONOS_FRICTION_3D_NSN_USE_KRYLOV)
+    NEW_FC_3D_TEST(${_DAT} SICONOS_FRICTION_3D_NSN_NM 1e-3 1000
+      0 0 0
+      IPARAM SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER SICONOS_FRICTION_3D_NSN_USE_KRYLOV)
   endforeach()
 
   
@@ -518,6 +537,15 @@ if(WITH_${COMPONENT}_TESTING)
     SICONOS_FRICTION_3D_NSGS 1e-5 1000
     SICONOS_FRICTION_3D_ONECONTACT_NSN 1e-16 10)
 
+  NEW_FC_3D_TEST(Confeti-ex13-Fc3D-SBM.dat
+    SICONOS_FRICTION_3D_NSGS_DDM 1e-5 1000
+    0 0 0
+    IPARAM SICONOS_FRICTION_3D_NSGS_DDM_REPARTITION_FREQUENCY 10)
+  # the same test on two and four subdomains
+  IF(HAVE_MPI)
+    SET(${TEST_NAME}_MPI_PROCS 2 4)
+  ENDIF()
+
   NEW_FC_3D_TEST(Confeti-ex13-Fc3D-SBM.dat
     SICONOS_FRICTION_3D_NSGS 1e-12 10000
     SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration 1e-06  100)
@@ -945,8 +973,22 @@ if(WITH_${COMPONENT}_TESTING)
       0 0 0
       WILL_FAIL) # pass with mumps only
   ENDIF()
+  IF(WITH_MUMPS)
+    NEW_GFC_3D_TEST(GFC3D_TwoRods1.dat SICONOS_GLOBAL_FRICTION_3D_NSN_AC 0 0
+      0 0 0
+      IPARAM SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER SICONOS_FRICTION_3D_NSN_USE_MUMPS)
+    NEW_GFC_3D_TEST(GFC3D_Example1.dat SICONOS_GLOBAL_FRICTION_3D_NSN_AC 0 0
+      0 0 0
+      IPARAM SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER SICONOS_FRICTION_3D_NSN_USE_MUMPS_DISTRIBUTED)
+    # the same test on two processes
+    IF(HAVE_MPI)
+      SET(${TEST_NAME}_MPI_PROCS 2)
+    ENDIF()
+  ENDIF()
   # Alart Curnier functions
   NEW_TEST(AlartCurnierFunctions_test fc3d_AlartCurnierFunctions_test.c)
+  # Fischer Burmeister functions
+  NEW_TEST(FischerBurmeisterFunctions_test fc3d_FischerBurmeisterFunctions_test.c)
 
   #
   if(WITH_FCLIB)
@@ -61,6 +61,8 @@ enum FRICTION_SOLVER
   SICONOS_FRICTION_3D_PFP = 522,
   /** ADMM local formulation */
   SICONOS_FRICTION_3D_ADMM = 523,
+  /** Non-smooth Gauss Seidel, domain decomposition over the MPI processes, local formulation */
+  SICONOS_FRICTION_3D_NSGS_DDM = 524,
 
   /* 3D Frictional Contact solvers for one contact (used mainly inside NSGS solvers) */
 
@@ -155,6 +157,7 @@ extern const char* const   SICONOS_FRICTION_3D_GAMS_LCP_PATHVI_STR;
 extern const char* const   SICONOS_FRICTION_3D_SOCLCP_STR;
 extern const char* const   SICONOS_FRICTION_3D_ACLMFP_STR;
 extern const char* const   SICONOS_FRICTION_3D_ADMM_STR;
+extern const char* const   SICONOS_FRICTION_3D_NSGS_DDM_STR;
 extern const char* const   SICONOS_GLOBAL_FRICTION_3D_NSGS_WR_STR ;
 extern const char* const   SICONOS_GLOBAL_FRICTION_3D_NSGSV_WR_STR ;
 extern const char* const   SICONOS_GLOBAL_FRICTION_3D_PROX_WR_STR ;
@@ -209,11 +212,25 @@ enum SICONOS_FRICTION_3D_NSGS_IPARAM
   /** index in iparam to store the  */
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION =14,
 };
+enum SICONOS_FRICTION_3D_NSGS_DDM_IPARAM
+{
+  /** index in iparam to store the number of sweeps over a subdomain between two exchanges */
+  SICONOS_FRICTION_3D_NSGS_DDM_LOCAL_SWEEPS = 9,
+  /** index in iparam to store the number of iterations between two partitions of the contacts (0: one partition per call) */
+  SICONOS_FRICTION_3D_NSGS_DDM_REPARTITION_FREQUENCY = 10,
+  /** index in iparam to store the MPI communicator (fortran handle, -1 for MPI_COMM_WORLD) */
+  SICONOS_FRICTION_3D_NSGS_DDM_MPI_COM = 11,
+};
 enum SICONOS_FRICTION_3D_NSGS_DPARAM
 {
   /** index in dparam to store the relaxation strategy */
   SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE=8,
 };
+enum SICONOS_FRICTION_3D_NSGS_DDM_DPARAM
+{
+  /** index in dparam to store the relaxation of the interface contacts */
+  SICONOS_FRICTION_3D_NSGS_DDM_INTERFACE_RELAXATION = 9,
+};
 
 
 enum SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_IPARAM
@@ -263,6 +280,8 @@ enum SICONOS_FRICTION_3D_NSN_IPARAM
   SICONOS_FRICTION_3D_NSN_LINESEARCH = 11,
   /** index in iparam to store the maximum number of iterations */
   SICONOS_FRICTION_3D_NSN_LINESEARCH_MAXITER = 12,
+  /** index in iparam to store the linear solver used at each Newton iteration */
+  SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER = 13,
   /** index in iparam to store the strategy for the hybrid solver */
   SICONOS_FRICTION_3D_NSN_HYBRID_STRATEGY = 14,
   /** index in iparam to store the maximum number of loop for the hybrid solver */
@@ -272,7 +291,11 @@ enum SICONOS_FRICTION_3D_NSN_IPARAM
   /** index in iparam to store the boolean to know if allocation of dwork is needed */
   SICONOS_FRICTION_3D_NSN_MEMORY_ALLOCATION= 17,
   /** index in iparam to store the boolean to know if allocation of dwork is needed */
-  SICONOS_FRICTION_3D_NSN_MPI_COM= 18
+  SICONOS_FRICTION_3D_NSN_MPI_COM= 18,
+  /** index in iparam to store the maximum number of iterations of the Krylov solver */
+  SICONOS_FRICTION_3D_NSN_KRYLOV_MAXITER = 19,
+  /** index in iparam to store the restart length of GMRES */
+  SICONOS_FRICTION_3D_NSN_KRYLOV_RESTART = 20
 
 };
 
@@ -280,6 +303,23 @@ enum SICONOS_FRICTION_3D_NSN_DPARAM
 {
   /** index in dparam to store the rho value for projection formulation */
   SICONOS_FRICTION_3D_NSN_RHO = 3,
+  /** index in dparam to store the upper bound of the forcing term of the Krylov solver */
+  SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_MAX = 4,
+  /** index in dparam to store the gamma coefficient of the Eisenstat-Walker forcing term */
+  SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_GAMMA = 5,
+};
+
+enum SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER_ENUM
+{
+  /** sparse LU factorization of AW+B with CSparse */
+  SICONOS_FRICTION_3D_NSN_USE_CSLUSOL = 0,
+  /** sparse LU factorization of AW+B with MUMPS */
+  SICONOS_FRICTION_3D_NSN_USE_MUMPS = 1,
+  /** matrix-free GMRES, AW+B is never assembled */
+  SICONOS_FRICTION_3D_NSN_USE_KRYLOV = 2,
+  /** global problems: the contacts and the rows of M are shared among
+   * the MPI processes, which solve with a distributed MUMPS instance */
+  SICONOS_FRICTION_3D_NSN_USE_MUMPS_DISTRIBUTED = 3
 };
 
 enum SICONOS_FRICTION_3D_NSN_RHO_STRATEGY_ENUM
@@ -23,6 +23,7 @@
 #include "fc2d_Solvers.h"
 #include "NonSmoothDrivers.h"
 #include "numerics_verbose.h"
+#include "tlsdef.h"
 
 
 const char* const   SICONOS_FRICTION_2D_NSGS_STR  = "F2D_NSGS";
@@ -33,11 +34,11 @@ const char* const   SICONOS_FRICTION_2D_LEMKE_STR  = "F2D_LEMKE";
 const char* const   SICONOS_FRICTION_2D_ENUM_STR  = "F2D_ENUM";
 //#define DUMP_PROBLEM
 #ifdef DUMP_PROBLEM
-static int fccounter = 0;
+static tlsvar int fccounter = 0;
 #endif
 //#define DUMP_PROBLEM_IF_INFO
 #ifdef DUMP_PROBLEM_IF_INFO
-static int fccounter = 0;
+static tlsvar int fccounter = 0;
 #endif
 
 
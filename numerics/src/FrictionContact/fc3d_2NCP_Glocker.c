@@ -33,47 +33,10 @@
 #include "SiconosBlas.h"
 #include "numerics_verbose.h"
 
-/*Static variables */
-
-/* The global problem of size n= 3*nc, nc being the number of contacts, is locally saved in MGlobal and qGlobal */
-/* mu corresponds to the vector of friction coefficients */
-
-
-/* /\* Global problem *\/ */
-/* static int n=0; */
-/* static const NumericsMatrix* MGlobal = NULL; */
-/* static const double* qGlobal = NULL; */
-/* static const double* mu = NULL; */
-
-/* /\* Local FC3D problem *\/ */
-/* static double* MLocal; */
-/* static int isMAllocatedIn = 0; /\* True if a malloc is done for MLocal, else false *\/ */
-/* static double qLocal[3]; */
-
-static FrictionContactProblem* localFC3D = NULL;
-static FrictionContactProblem* globalFC3D = NULL;
-
-
-
-
-/* Local "Glocker" variables */
+/* Gsize is the size of the local problem in the Glocker formulation,
+   the work data of a local problem are kept in a NCPGlockerData
+   stored in the solverData of the local solver options. */
 static const int Gsize = 5;
-static double reactionGlocker[5];
-static double MGlocker[25];
-/* static double qGlocker[5]; */
-/* static double gGlocker[5]; */
-
-/* Output */
-static double jacobianFGlocker[25];
-static double FGlocker[5];
-
-static double mu_i = 0.0;
-
-/* static double e1[2],e2[2] ; */
-static double e3[2];
-static double IpInv[4];
-static double IpInvTranspose[4];
-static double Igloc[4];
 # define PI 3.14159265358979323846 /* pi */
 
 void computeE(unsigned int i, double* e)
@@ -84,10 +47,10 @@ void computeE(unsigned int i, double* e)
 }
 
 /* Compute and save MGlocker */
-void computeMGlocker()
+void computeMGlocker(NCPGlockerData* d)
 {
 
-  double * MLocal = localFC3D->M->matrix0;
+  double * MLocal = d->localFC3D->M->matrix0;
 
 
   /* Local function used in update */
@@ -98,39 +61,39 @@ void computeMGlocker()
   /* MGlocker is used to save MGlocker */
 
   /* row 0 */
-  MGlocker[0]      =   MLocal[0] + 2 * mu_i * MLocal[6];
-  MGlocker[Gsize]   =  -MLocal[6] - sqrt(3.) / 3 * MLocal[3] ;
-  MGlocker[2 * Gsize] = sqrt(3.) / 3 * MLocal[3] - MLocal[6];
-  MGlocker[3 * Gsize] = 0.0;
-  MGlocker[4 * Gsize] = 0.0;
+  d->MGlocker[0]      =   MLocal[0] + 2 * d->mu_i * MLocal[6];
+  d->MGlocker[Gsize]   =  -MLocal[6] - sqrt(3.) / 3 * MLocal[3] ;
+  d->MGlocker[2 * Gsize] = sqrt(3.) / 3 * MLocal[3] - MLocal[6];
+  d->MGlocker[3 * Gsize] = 0.0;
+  d->MGlocker[4 * Gsize] = 0.0;
 
   /* row 1 */
-  MGlocker[1]        = - MLocal[2] - sqrt(3.) / 3 * MLocal[1] - 2 * mu_i * MLocal[8]  - 2 * sqrt(3.) / 3 * mu_i * MLocal[7];
-  MGlocker[Gsize + 1]   =   MLocal[8] + 1. / 3 * MLocal[4] + sqrt(3.) / 3 * (MLocal[5] + MLocal[7]) ;
-  MGlocker[2 * Gsize + 1] =   MLocal[8] - 1. / 3 * MLocal[4] - sqrt(3.) / 3 * (MLocal[5] - MLocal[7]) ;
-  MGlocker[3 * Gsize + 1] = 1.0;
-  MGlocker[4 * Gsize + 1] = 0.0;
+  d->MGlocker[1]        = - MLocal[2] - sqrt(3.) / 3 * MLocal[1] - 2 * d->mu_i * MLocal[8]  - 2 * sqrt(3.) / 3 * d->mu_i * MLocal[7];
+  d->MGlocker[Gsize + 1]   =   MLocal[8] + 1. / 3 * MLocal[4] + sqrt(3.) / 3 * (MLocal[5] + MLocal[7]) ;
+  d->MGlocker[2 * Gsize + 1] =   MLocal[8] - 1. / 3 * MLocal[4] - sqrt(3.) / 3 * (MLocal[5] - MLocal[7]) ;
+  d->MGlocker[3 * Gsize + 1] = 1.0;
+  d->MGlocker[4 * Gsize + 1] = 0.0;
 
   /* row 2 */
-  MGlocker[2]        =  - MLocal[2] + sqrt(3.) / 3 * MLocal[1] - 2 * mu_i * MLocal[8] + 2 * sqrt(3.) / 3 * mu_i * MLocal[7];
-  MGlocker[Gsize + 2]   =    MLocal[8] - 1. / 3 * MLocal[4] + sqrt(3.) / 3 * (MLocal[5] - MLocal[7]) ;
-  MGlocker[2 * Gsize + 2] =    MLocal[8] + 1. / 3 * MLocal[4] - sqrt(3.) / 3 * (MLocal[5] + MLocal[7]) ;;
-  MGlocker[3 * Gsize + 2] = 1.0;
-  MGlocker[4 * Gsize + 2] = 0.0;
+  d->MGlocker[2]        =  - MLocal[2] + sqrt(3.) / 3 * MLocal[1] - 2 * d->mu_i * MLocal[8] + 2 * sqrt(3.) / 3 * d->mu_i * MLocal[7];
+  d->MGlocker[Gsize + 2]   =    MLocal[8] - 1. / 3 * MLocal[4] + sqrt(3.) / 3 * (MLocal[5] - MLocal[7]) ;
+  d->MGlocker[2 * Gsize + 2] =    MLocal[8] + 1. / 3 * MLocal[4] - sqrt(3.) / 3 * (MLocal[5] + MLocal[7]) ;;
+  d->MGlocker[3 * Gsize + 2] = 1.0;
+  d->MGlocker[4 * Gsize + 2] = 0.0;
 
   /* row 3 */
-  MGlocker[3]        = 3 * mu_i;
-  MGlocker[Gsize + 3]   = -1.0;
-  MGlocker[2 * Gsize + 3] = -1.0;
-  MGlocker[3 * Gsize + 3] = 0.0;
-  MGlocker[4 * Gsize + 3] = 0.0;
+  d->MGlocker[3]        = 3 * d->mu_i;
+  d->MGlocker[Gsize + 3]   = -1.0;
+  d->MGlocker[2 * Gsize + 3] = -1.0;
+  d->MGlocker[3 * Gsize + 3] = 0.0;
+  d->MGlocker[4 * Gsize + 3] = 0.0;
 
   /* row 4 */
   for (i = 0; i < Gsize; ++i)
-    MGlocker[i * Gsize + 4] = 0.0;
+    d->MGlocker[i * Gsize + 4] = 0.0;
 }
 
-void computeGGlocker()
+void computeGGlocker(NCPGlockerData* d)
 {
   /* Local function used in update */
 
@@ -140,12 +103,12 @@ void computeGGlocker()
 
   // gGlocker[0] = 0.0;
 
-  FGlocker[1] += 4. / 3 * reactionGlocker[4] * (2 * reactionGlocker[1] + reactionGlocker[2] - 3 * mu_i * reactionGlocker[0]);
-  FGlocker[2] += 4. / 3 * reactionGlocker[4] * (reactionGlocker[1] + 2 * reactionGlocker[2] - 3 * mu_i * reactionGlocker[0]);
+  d->FGlocker[1] += 4. / 3 * d->reactionGlocker[4] * (2 * d->reactionGlocker[1] + d->reactionGlocker[2] - 3 * d->mu_i * d->reactionGlocker[0]);
+  d->FGlocker[2] += 4. / 3 * d->reactionGlocker[4] * (d->reactionGlocker[1] + 2 * d->reactionGlocker[2] - 3 * d->mu_i * d->reactionGlocker[0]);
   // gGlocker[3] = 0.0;
   /* norm_I of row1*/
-  double tmp = 4. / 3 * (reactionGlocker[1] * reactionGlocker[1] + reactionGlocker[1] * reactionGlocker[2] + reactionGlocker[2] * reactionGlocker[2]);
-  FGlocker[4] += 4 * mu_i * reactionGlocker[0] * reactionGlocker[1] - 3 * mu_i * mu_i * reactionGlocker[0] * reactionGlocker[0] + 4 * mu_i * reactionGlocker[0] * reactionGlocker[2] - tmp;
+  double tmp = 4. / 3 * (d->reactionGlocker[1] * d->reactionGlocker[1] + d->reactionGlocker[1] * d->reactionGlocker[2] + d->reactionGlocker[2] * d->reactionGlocker[2]);
+  d->FGlocker[4] += 4 * d->mu_i * d->reactionGlocker[0] * d->reactionGlocker[1] - 3 * d->mu_i * d->mu_i * d->reactionGlocker[0] * d->reactionGlocker[0] + 4 * d->mu_i * d->reactionGlocker[0] * d->reactionGlocker[2] - tmp;
 
 }
 
@@ -189,7 +152,7 @@ void NCPGlocker_fillMLocal(FrictionContactProblem * problem, FrictionContactProb
 
 }
 
-void NCPGlocker_initialize(FrictionContactProblem* problem, FrictionContactProblem* localproblem)
+void NCPGlocker_initialize(FrictionContactProblem* problem, FrictionContactProblem* localproblem, SolverOptions* options)
 {
   /*
     INPUT: the global problem operators: n0 (size), M0, q0 and mu0, vector of friction coefficients.
@@ -200,38 +163,42 @@ void NCPGlocker_initialize(FrictionContactProblem* problem, FrictionContactProbl
     Fill vectors/matrices of parameters: Ip, Ipinv ...
   */
 
-  localFC3D = localproblem;
-  globalFC3D = problem;
+  NCPGlockerData* d = (NCPGlockerData*)malloc(sizeof(NCPGlockerData));
+  options->solverData = d;
+  d->localFC3D = localproblem;
+  d->globalFC3D = problem;
+  d->mu_i = 0.0;
 
   /* ei = [cos((4i-3)Pi/6), sin-((4i-3)Pi/6)]
      Ip = [e1 e2]
   */
   //computeE(1,e1);  computeE(2,e2);
-  computeE(3, e3);
+  computeE(3, d->e3);
 
   /* compute I and inverse of Ip */
   //  computeI(e1,e2,e3, IpInv, I)
-  IpInv[0] =  sqrt(3.) / 3 ;
-  IpInv[2] =  1.;
-  IpInv[1] =  -sqrt(3.) / 3 ;
-  IpInv[3] =  1.;
+  d->IpInv[0] =  sqrt(3.) / 3 ;
+  d->IpInv[2] =  1.;
+  d->IpInv[1] =  -sqrt(3.) / 3 ;
+  d->IpInv[3] =  1.;
 
   /* transpose of IpInv */
-  IpInvTranspose[0] =  sqrt(3.) / 3;
-  IpInvTranspose[2] = -sqrt(3.) / 3;
-  IpInvTranspose[1] = 1.;
-  IpInvTranspose[3] =  1.;
+  d->IpInvTranspose[0] =  sqrt(3.) / 3;
+  d->IpInvTranspose[2] = -sqrt(3.) / 3;
+  d->IpInvTranspose[1] = 1.;
+  d->IpInvTranspose[3] =  1.;
 
   /* I = IpInv * IpInvTranspose */
-  Igloc[0] = 4.0 / 3;
-  Igloc[1] = 2.0 / 3;
-  Igloc[2] = 2.0 / 3;
-  Igloc[3] = 4.0 / 3;
+  d->Igloc[0] = 4.0 / 3;
+  d->Igloc[1] = 2.0 / 3;
+  d->Igloc[2] = 2.0 / 3;
+  d->Igloc[3] = 4.0 / 3;
 
 }
 
 void NCPGlocker_update(int contact, FrictionContactProblem* problem, FrictionContactProblem* localproblem, double * reaction, SolverOptions* options)
 {
+  NCPGlockerData* d = (NCPGlockerData*)options->solverData;
   /* Build a local problem for a specific contact
      reaction corresponds to the global vector (size n) of the global problem.
   */
@@ -245,7 +212,7 @@ void NCPGlocker_update(int contact, FrictionContactProblem* problem, FrictionCon
   NCPGlocker_fillMLocal(problem, localproblem, contact);
 
   // === computation of MGlocker = function(MLocal, mu_i, I, IpInvTranspose, IpInv, e3) ===/
-  computeMGlocker();
+  computeMGlocker(d);
   // === computation of qGlocker = function(qLocal, IpInv)
   // saved in FGlocker which is also initialized here ===
   //  - step 1: computes qLocal = qGlobal[in] + sum over a row of blocks in MGlobal of the products MLocal.reaction,
@@ -256,22 +223,22 @@ void NCPGlocker_update(int contact, FrictionContactProblem* problem, FrictionCon
   double * qLocal = localproblem->q;
 
   /* qGlocker (saved in FGlocker) */
-  FGlocker[0] = qLocal[0];
-  FGlocker[1] = -sqrt(3.) / 3 * qLocal[1] - qLocal[2];
-  FGlocker[2] =  sqrt(3.) / 3 * qLocal[1] - qLocal[2];
-  FGlocker[3] = 0.0;
-  FGlocker[4] = 0.0;
+  d->FGlocker[0] = qLocal[0];
+  d->FGlocker[1] = -sqrt(3.) / 3 * qLocal[1] - qLocal[2];
+  d->FGlocker[2] =  sqrt(3.) / 3 * qLocal[1] - qLocal[2];
+  d->FGlocker[3] = 0.0;
+  d->FGlocker[4] = 0.0;
 
   // === initialize reactionGlocker with reaction[currentContact] ===
   // reactionGlocker = function(reaction, mu_i)
-  reactionGlocker[0] = reaction[in]; /* Pn */
-  reactionGlocker[1] = mu_i * reaction[in] - sqrt(3.) * reaction[it] / 2. - reaction[is] / 2.; /* SigmaP_1 */
-  reactionGlocker[2] = mu_i * reaction[in] + sqrt(3.) * reaction[it] / 2. - reaction[is] / 2.; /* SigmaP_2 */
-  reactionGlocker[3] = 0.; /* k3 */
-  reactionGlocker[4] = 0.; /* kD */
+  d->reactionGlocker[0] = reaction[in]; /* Pn */
+  d->reactionGlocker[1] = d->mu_i * reaction[in] - sqrt(3.) * reaction[it] / 2. - reaction[is] / 2.; /* SigmaP_1 */
+  d->reactionGlocker[2] = d->mu_i * reaction[in] + sqrt(3.) * reaction[it] / 2. - reaction[is] / 2.; /* SigmaP_2 */
+  d->reactionGlocker[3] = 0.; /* k3 */
+  d->reactionGlocker[4] = 0.; /* kD */
 
   // === Computation of gGlocker = function(reactionGlocker, I, mu_i) (added to FGlocker) ===/
-  computeGGlocker();
+  computeGGlocker(d);
 
   // End of this function:
   // - reactionGlocker is up to date
@@ -288,7 +255,7 @@ void NCPGlocker_update(int contact, FrictionContactProblem* problem, FrictionCon
 
 }
 
-void computeJacobianGGlocker()
+void computeJacobianGGlocker(NCPGlockerData* d)
 {
   /* At this point, jacobianFGlocker = M */
   /* We compute jacobianFGlocker += jacobian of g */
@@ -296,29 +263,29 @@ void computeJacobianGGlocker()
   /* row 1 */
 
   // === jacobianFGlocker = MGlocker + jacobian_r g(r) ===
-  cblas_dcopy(Gsize * Gsize, MGlocker, 1, jacobianFGlocker, 1);
+  cblas_dcopy(Gsize * Gsize, d->MGlocker, 1, d->jacobianFGlocker, 1);
 
-  double muR0 = 4.*mu_i * reactionGlocker[0];
-  jacobianFGlocker[1]  -= 4.*mu_i * reactionGlocker[4];
-  jacobianFGlocker[6]  += 8. / 3 * reactionGlocker[4];
-  jacobianFGlocker[11] += 4. / 3 * reactionGlocker[4];
-  jacobianFGlocker[21] += 8. / 3 * reactionGlocker[1] + 4. / 3 * reactionGlocker[2] - muR0;
+  double muR0 = 4.*d->mu_i * d->reactionGlocker[0];
+  d->jacobianFGlocker[1]  -= 4.*d->mu_i * d->reactionGlocker[4];
+  d->jacobianFGlocker[6]  += 8. / 3 * d->reactionGlocker[4];
+  d->jacobianFGlocker[11] += 4. / 3 * d->reactionGlocker[4];
+  d->jacobianFGlocker[21] += 8. / 3 * d->reactionGlocker[1] + 4. / 3 * d->reactionGlocker[2] - muR0;
 
   /* row 2 */
-  jacobianFGlocker[2]  -= 4.*mu_i * reactionGlocker[4];
-  jacobianFGlocker[7]  += 4. / 3 * reactionGlocker[4];
-  jacobianFGlocker[12] += 8. / 3 * reactionGlocker[4];
-  jacobianFGlocker[22] += 4. / 3 * reactionGlocker[1] + 8. / 3 * reactionGlocker[2] - muR0;
+  d->jacobianFGlocker[2]  -= 4.*d->mu_i * d->reactionGlocker[4];
+  d->jacobianFGlocker[7]  += 4. / 3 * d->reactionGlocker[4];
+  d->jacobianFGlocker[12] += 8. / 3 * d->reactionGlocker[4];
+  d->jacobianFGlocker[22] += 4. / 3 * d->reactionGlocker[1] + 8. / 3 * d->reactionGlocker[2] - muR0;
 
   /* row 3  = 0 */
   /* row 4 */
-  jacobianFGlocker[4]  += 2.*mu_i * (2.*reactionGlocker[1] + 2.*reactionGlocker[2] - 3.*mu_i * reactionGlocker[0]);
-  jacobianFGlocker[9]  += muR0 - 4. / 3 * reactionGlocker[2] - 8. / 3 * reactionGlocker[1];
-  jacobianFGlocker[14] += muR0 - 8. / 3 * reactionGlocker[2] - 4. / 3 * reactionGlocker[1];
+  d->jacobianFGlocker[4]  += 2.*d->mu_i * (2.*d->reactionGlocker[1] + 2.*d->reactionGlocker[2] - 3.*d->mu_i * d->reactionGlocker[0]);
+  d->jacobianFGlocker[9]  += muR0 - 4. / 3 * d->reactionGlocker[2] - 8. / 3 * d->reactionGlocker[1];
+  d->jacobianFGlocker[14] += muR0 - 8. / 3 * d->reactionGlocker[2] - 4. / 3 * d->reactionGlocker[1];
 
 }
 
-void  NCPGlocker_post(int contact, double * reaction0)
+void NCPGlocker_post(NCPGlockerData* d, int contact, double * reaction0)
 {
 
   /* Retrieve original vector reaction from reactionGlocker formulation
@@ -330,92 +297,93 @@ void  NCPGlocker_post(int contact, double * reaction0)
   */
 
   int in = 3 * contact, it = in + 1, is = in + 2;
-  reaction0[in] = reactionGlocker[0];
-  double tmp1 = mu_i * reactionGlocker[0] - reactionGlocker[1];
-  double tmp2 = mu_i * reactionGlocker[0] - reactionGlocker[2];
-  reaction0[it] = IpInvTranspose[0] * tmp1 + IpInvTranspose[2] * tmp2;
-  reaction0[is] = IpInvTranspose[1] * tmp1 + IpInvTranspose[3] * tmp2;
+  reaction0[in] = d->reactionGlocker[0];
+  double tmp1 = d->mu_i * d->reactionGlocker[0] - d->reactionGlocker[1];
+  double tmp2 = d->mu_i * d->reactionGlocker[0] - d->reactionGlocker[2];
+  reaction0[it] = d->IpInvTranspose[0] * tmp1 + d->IpInvTranspose[2] * tmp2;
+  reaction0[is] = d->IpInvTranspose[1] * tmp1 + d->IpInvTranspose[3] * tmp2;
 }
 
-void computeFGlocker(double** FOut, int up2Date)
+void computeFGlocker(NCPGlockerData* d, double** FOut, int up2Date)
 {
   /* updateNCPGlocker must have been called before !!! */
   /* At this point, FGlocker = gGlocker + qGlocker */
   /* and jacobianFGlocker contains MGlocker */
   /* F = M.reaction + g(reaction) + q */
-  cblas_dgemv(CblasColMajor,CblasNoTrans, Gsize, Gsize, 1.0, MGlocker, Gsize, reactionGlocker, 1, 1.0, FGlocker, 1);
-  *FOut = FGlocker; /* pointer link */
+  cblas_dgemv(CblasColMajor,CblasNoTrans, Gsize, Gsize, 1.0, d->MGlocker, Gsize, d->reactionGlocker, 1, 1.0, d->FGlocker, 1);
+  *FOut = d->FGlocker; /* pointer link */
 }
 
-void computeJacobianFGlocker(double** jacobianFOut, int up2Date)
+void computeJacobianFGlocker(NCPGlockerData* d, double** jacobianFOut, int up2Date)
 {
   /* Computation of M (if required) and of the jacobian of g */
   if (up2Date == 0)
   {
-    computeMGlocker();
+    computeMGlocker(d);
     /* MGlocker is saved in jacobianF */
   }
-  computeJacobianGGlocker(); /* add jacobianG to previously computed M in jacobianF */
-  *jacobianFOut = jacobianFGlocker; /* pointer link */
+  computeJacobianGGlocker(d); /* add jacobianG to previously computed M in jacobianF */
+  *jacobianFOut = d->jacobianFGlocker; /* pointer link */
 }
 
 /* Compute error for the NCP formulation*/
 
 /*  error = sum_i [(zi*F(zi)_+ + (zi)_- + (F(zi))_-] */
 
-double Compute_NCP_error1(int i, double error)
+double Compute_NCP_error1(NCPGlockerData* d, int i, double error)
 {
   printf("--------------contact =  %i\n", i);
 
   double Fz;
-  printf(" z[%i] = %14.7e\n", i, reactionGlocker[i]);
-  printf(" F[%i] = %14.7e\n", i, FGlocker[i]);
+  printf(" z[%i] = %14.7e\n", i, d->reactionGlocker[i]);
+  printf(" F[%i] = %14.7e\n", i, d->FGlocker[i]);
 
-  Fz = FGlocker[i] * reactionGlocker[i];
+  Fz = d->FGlocker[i] * d->reactionGlocker[i];
   if (Fz > 0)
     error += Fz;
-  if (reactionGlocker[i] < 0)
-    error += reactionGlocker[i];
-  if (FGlocker[i] < 0)
-    error += FGlocker[i];
+  if (d->reactionGlocker[i] < 0)
+    error += d->reactionGlocker[i];
+  if (d->FGlocker[i] < 0)
+    error += d->FGlocker[i];
   return error;
 }
 
 /*  error = sum_i sqrt[((zi*F(zi)_+)^2 + (sqrt(zi^2 + (F(zi))^2) - zi - F(zi))^2 ] */
 
-double Compute_NCP_error2(int i, double error)
+double Compute_NCP_error2(NCPGlockerData* d, int i, double error)
 {
   double Fz;
   //      printf(" z[%i] = %14.7e\n", i, reactionGlocker[i]);
   //      printf(" F[%i] = %14.7e\n", i, FGlocker[i]);
 
-  Fz = FGlocker[i] * reactionGlocker[i];
+  Fz = d->FGlocker[i] * d->reactionGlocker[i];
   if (Fz > 0)
     error += Fz * Fz;
-  error += (sqrt(FGlocker[i] * FGlocker[i] + reactionGlocker[i] * reactionGlocker[i]) - FGlocker[i] - reactionGlocker[i]) * (sqrt(FGlocker[i] * FGlocker[i] + reactionGlocker[i] * reactionGlocker[i]) - FGlocker[i] - reactionGlocker[i]);
+  error += (sqrt(d->FGlocker[i] * d->FGlocker[i] + d->reactionGlocker[i] * d->reactionGlocker[i]) - d->FGlocker[i] - d->reactionGlocker[i]) * (sqrt(d->FGlocker[i] * d->FGlocker[i] + d->reactionGlocker[i] * d->reactionGlocker[i]) - d->FGlocker[i] - d->reactionGlocker[i]);
   error = sqrt(error);
   return error;
 }
 
-void compute_Z_GlockerFixedP(int i, double *reactionstep)
+void compute_Z_GlockerFixedP(NCPGlockerData* d, int i, double *reactionstep)
 {
 
   double rho = 1.;
-  if (reactionGlocker[i] - rho * FGlocker[i] > 0.)
+  if (d->reactionGlocker[i] - rho * d->FGlocker[i] > 0.)
   {
-    reactionstep[i] = rho * FGlocker[i] - reactionGlocker[i];
-    reactionGlocker[i] = rho * FGlocker[i];
+    reactionstep[i] = rho * d->FGlocker[i] - d->reactionGlocker[i];
+    d->reactionGlocker[i] = rho * d->FGlocker[i];
   }
   else
   {
-    reactionGlocker[i] = reactionGlocker[i];
+    d->reactionGlocker[i] = d->reactionGlocker[i];
     reactionstep[i] = 0.;
   }
 }
 
 
-void NCPGlocker_free()
+void NCPGlocker_free(SolverOptions* options)
 {
-
+  free(options->solverData);
+  options->solverData = NULL;
 }
 
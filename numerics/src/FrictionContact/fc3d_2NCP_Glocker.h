@@ -49,6 +49,24 @@
 */
 #include "NumericsMatrix.h"
 
+/** Work data of the Glocker formulation for the local problems of a
+    solver, created by NCPGlocker_initialize in the solverData of the
+    local solver options */
+typedef struct
+{
+  FrictionContactProblem* localFC3D;  /**< the local problem */
+  FrictionContactProblem* globalFC3D; /**< the global problem */
+  double reactionGlocker[5];          /**< the unknown of the Glocker formulation */
+  double MGlocker[25];                /**< its matrix */
+  double jacobianFGlocker[25];        /**< jacobian of F */
+  double FGlocker[5];                 /**< F */
+  double mu_i;                        /**< friction coefficient of the current contact */
+  double e3[2];
+  double IpInv[4];
+  double IpInvTranspose[4];
+  double Igloc[4];
+} NCPGlockerData;
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 extern "C"
 {
@@ -61,8 +79,9 @@ extern "C"
      the global vector mu of the friction coefficients (size = n/3)
      \param problem the global problem
      \param localproblem the local problem
+     \param options the local solver options, their solverData keeps the work data
   */
-  void NCPGlocker_initialize(FrictionContactProblem* problem, FrictionContactProblem* localproblem);
+  void NCPGlocker_initialize(FrictionContactProblem* problem, FrictionContactProblem* localproblem, SolverOptions* options);
 
   /** Pick the required sub-blocks in q, M ... according to the considered contact and write the
      operators required for the Glocker formulation
@@ -74,49 +93,57 @@ extern "C"
   void NCPGlocker_update(int, FrictionContactProblem* problem, FrictionContactProblem* localproblem,  double* pos, SolverOptions* options);
 
   /** Retrieve global reaction values after solving, from computed "reactionGlocker".
+     \param data the work data
      \param contactnumber the number of the considered contact
      \param[in,out] reaction he global reaction (in-out parameter)
   */
-  void NCPGlocker_post(int contactnumber, double * reaction);
+  void NCPGlocker_post(NCPGlockerData* data, int contactnumber, double * reaction);
 
   /** To compute F
+     \param data the work data
      \param[in,out] FOut the resulting FOut (warning: must be null on input)
      \param up2Date  boolean variable to avoid recomputation of some parameters: true if F or jacobianF has been computed and if
      the considered local problem has not changed, else false.
   */
-  void computeFGlocker(double ** FOut, int up2Date);
+  void computeFGlocker(NCPGlockerData* data, double ** FOut, int up2Date);
 
   /** To compute jacobianF
+     \param data the work data
      \param[in,out] jacobianFOut the resulting (warning: must be null on input)
      \param up2Date Boolean variable to avoid recomputation of some parameters: true if F or jacobianF has been computed and if
      the considered local problem has not changed, else false.
   */
-  void computeJacobianFGlocker(double ** jacobianFOut, int up2Date);
+  void computeJacobianFGlocker(NCPGlockerData* data, double ** jacobianFOut, int up2Date);
 
   /** compute NCP error for Fischer-Burmeister formulation
+   * \param data the work data
    * \param contact
    * \param error
    * \return error ?
    */
 
-  double Compute_NCP_error1(int contact, double error);
+  double Compute_NCP_error1(NCPGlockerData* data, int contact, double error);
 
   /** compute NCP error for Fischer-Burmeister formulation
+   * \param data the work data
    * \param contact
    * \param error
    * \return error ?
    */
-  double Compute_NCP_error2(int contact, double error);
+  double Compute_NCP_error2(NCPGlockerData* data, int contact, double error);
 
   /** compute Fixed Point Solution for the NCP formulation
+   * \param data the work data
    * \param contact
    * \param reactionstep
    */
 
-  void compute_Z_GlockerFixedP(int contact, double *reactionstep);
+  void compute_Z_GlockerFixedP(NCPGlockerData* data, int contact, double *reactionstep);
 
-  /** free memory for friction contact to NCP-Glocker */
-  void NCPGlocker_free(void);
+  /** free memory for friction contact to NCP-Glocker
+   * \param options the local solver options given to NCPGlocker_initialize
+   */
+  void NCPGlocker_free(SolverOptions* options);
 
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
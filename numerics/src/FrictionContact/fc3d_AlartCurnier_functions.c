@@ -941,6 +941,156 @@ void computeAlartCurnierJeanMoreau(double R[3], double velocity[3], double mu, d
 }
 
 
+/* Alart-Curnier function of fc3d_AlartCurnierFABGenerated on
+ * FC3D_AC_BATCH_SIZE contacts at once. The inputs and the outputs
+ * are stored by lanes (structure of arrays) and the disk / out of disk
+ * cases are blended, so that each loop over the lanes is
+ * vectorizable. */
+static void fc3d_AlartCurnierFABGeneratedLanes(
+  const double rn[FC3D_AC_BATCH_SIZE],
+  const double rt1[FC3D_AC_BATCH_SIZE],
+  const double rt2[FC3D_AC_BATCH_SIZE],
+  const double un[FC3D_AC_BATCH_SIZE],
+  const double ut1[FC3D_AC_BATCH_SIZE],
+  const double ut2[FC3D_AC_BATCH_SIZE],
+  const double mu[FC3D_AC_BATCH_SIZE],
+  const double rhon[FC3D_AC_BATCH_SIZE],
+  const double rhot1[FC3D_AC_BATCH_SIZE],
+  const double rhot2[FC3D_AC_BATCH_SIZE],
+  double result[21][FC3D_AC_BATCH_SIZE])
+{
+  const double eps = 0x1.0000000000000p-52;
+  int l;
+  for (l = 0; l < FC3D_AC_BATCH_SIZE; ++l)
+  {
+    double x2 = rn[l] - rhon[l] * un[l];
+    double x3 = x2 > 0. ? x2 : 0.;
+    double x4 = x2 > 0. ? 1. : 0.;
+    double x5 = rhot1[l] * ut1[l];
+    double x6 = x5 - rt1[l];
+    double x8 = rhot2[l] * ut2[l];
+    double x9 = x8 - rt2[l];
+    double x11 = x6 * x6 + x9 * x9;
+    double x12 = sqrt(x11);
+    double x13 = mu[l] * x3;
+    double x14 = x13 > eps ? x13 : eps;
+    double x20 = x13 > eps ? 1. : 0.;
+
+    /* out of the disk: x12 > x14 > 0, the denominator of the
+     * masked lanes is replaced by 1 */
+    int out = x12 > x14;
+    double x12m = out ? x12 : 1.;
+    double x17 = 1. / x12m;
+    double x16 = rt1[l] - x5;
+    double x28 = rt2[l] - x8;
+    double x18 = x14 * x17;
+    double x22 = 1. / (x12m * x12m * x12m);
+    double x21 = mu[l] * rhon[l] * x17 * x20 * x4;
+    double x23 = x14 * x16 * x22;
+    double x24 = x23 * x6;
+    double x25 = x23 * x9;
+    double x26 = mu[l] * x17 * x20 * x4;
+    double x27 = 1. - x18;
+    double x29 = x14 * x22 * x28;
+    double x30 = x29 * x6;
+    double x31 = x29 * x9;
+
+    result[0][l] = rn[l] - x3;
+    result[1][l] = out ? rt1[l] - x16 * x18 : x5;
+    result[2][l] = out ? rt2[l] - x18 * x28 : x8;
+    result[3][l] = rhon[l] * x4;
+    result[4][l] = out ? x16 * x21 : 0.;
+    result[5][l] = out ? x21 * x28 : 0.;
+    result[6][l] = 0.;
+    result[7][l] = out ? rhot1[l] * x18 + rhot1[l] * x24 : rhot1[l];
+    result[8][l] = out ? rhot1[l] * x30 : 0.;
+    result[9][l] = 0.;
+    result[10][l] = out ? rhot2[l] * x25 : 0.;
+    result[11][l] = out ? rhot2[l] * x18 + rhot2[l] * x31 : rhot2[l];
+    result[12][l] = 1. - x4;
+    result[13][l] = out ? -x16 * x26 : 0.;
+    result[14][l] = out ? -x26 * x28 : 0.;
+    result[15][l] = 0.;
+    result[16][l] = out ? x27 - x24 : 0.;
+    result[17][l] = out ? -x30 : 0.;
+    result[18][l] = 0.;
+    result[19][l] = out ? -x25 : 0.;
+    result[20][l] = out ? x27 - x31 : 0.;
+  }
+}
+
+void fc3d_AlartCurnierFunctionGeneratedBatch(
+  unsigned int nc,
+  double *reaction,
+  double *velocity,
+  double *mu,
+  double *rho,
+  double *F,
+  double *A,
+  double *B)
+{
+  double in[10][FC3D_AC_BATCH_SIZE];
+  double result[21][FC3D_AC_BATCH_SIZE];
+  unsigned int c, l, k;
+
+  assert(reaction);
+  assert(velocity);
+  assert(mu);
+  assert(rho);
+  assert(F);
+
+  for (c = 0; c + FC3D_AC_BATCH_SIZE <= nc; c += FC3D_AC_BATCH_SIZE)
+  {
+    /* gather */
+    for (l = 0; l < FC3D_AC_BATCH_SIZE; ++l)
+    {
+      unsigned int i3 = 3 * (c + l);
+      in[0][l] = reaction[i3];
+      in[1][l] = reaction[i3 + 1];
+      in[2][l] = reaction[i3 + 2];
+      in[3][l] = velocity[i3];
+      in[4][l] = velocity[i3 + 1];
+      in[5][l] = velocity[i3 + 2];
+      in[6][l] = mu[c + l];
+      in[7][l] = rho[i3];
+      in[8][l] = rho[i3 + 1];
+      in[9][l] = rho[i3 + 2];
+    }
+
+    fc3d_AlartCurnierFABGeneratedLanes(in[0], in[1], in[2], in[3], in[4],
+                                       in[5], in[6], in[7], in[8], in[9],
+                                       result);
+
+    /* scatter */
+    for (l = 0; l < FC3D_AC_BATCH_SIZE; ++l)
+    {
+      for (k = 0; k < 3; ++k)
+        F[3 * (c + l) + k] = result[k][l];
+    }
+    if (A && B)
+    {
+      for (l = 0; l < FC3D_AC_BATCH_SIZE; ++l)
+      {
+        for (k = 0; k < 9; ++k)
+        {
+          A[9 * (c + l) + k] = result[3 + k][l];
+          B[9 * (c + l) + k] = result[12 + k][l];
+        }
+      }
+    }
+  }
+
+  /* remaining contacts */
+  for (; c < nc; ++c)
+  {
+    fc3d_AlartCurnierFunctionGenerated(reaction + 3 * c, velocity + 3 * c,
+                                       mu[c], rho + 3 * c, F + 3 * c,
+                                       (A && B) ? A + 9 * c : NULL,
+                                       (A && B) ? B + 9 * c : NULL);
+  }
+}
+
+
 void compute_rho_split_spectral_norm_cond(FrictionContactProblem* localproblem, double * rho)
 {
   double * MLocal = localproblem->M->matrix0;
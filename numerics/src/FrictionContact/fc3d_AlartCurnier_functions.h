@@ -53,6 +53,17 @@
 #include "FrictionContactProblem.h"
 #include "SparseBlockMatrix.h"
 
+/** number of contacts evaluated together by
+ * fc3d_AlartCurnierFunctionGeneratedBatch: the number of doubles in a
+ * SIMD register */
+#ifndef FC3D_AC_BATCH_SIZE
+#if defined(__AVX512F__)
+#define FC3D_AC_BATCH_SIZE 8
+#else
+#define FC3D_AC_BATCH_SIZE 4
+#endif
+#endif
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 extern "C"
 {
@@ -72,6 +83,28 @@ extern "C"
                                double mu, double rho[3],
                                double result[3], double A[9], double B[9]);
 
+  /** fc3d_AlartCurnierFunctionGenerated on nc contacts, evaluated by
+      groups of FC3D_AC_BATCH_SIZE contacts in structure of arrays
+      layout, the disk and out of disk cases being blended instead of
+      branched. The remaining contacts are computed one by one.
+      \param nc the number of contacts
+      \param reaction the reactions (size 3 nc)
+      \param velocity the velocities (size 3 nc)
+      \param mu the friction coefficients (size nc)
+      \param rho the rho parameters (size 3 nc)
+      \param[out] F the Alart & Curnier function (size 3 nc)
+      \param[out] A the A part of the gradient (size 9 nc), or NULL
+      \param[out] B the B part of the gradient (size 9 nc), or NULL
+  */
+  void fc3d_AlartCurnierFunctionGeneratedBatch(unsigned int nc,
+                                               double *reaction,
+                                               double *velocity,
+                                               double *mu,
+                                               double *rho,
+                                               double *F,
+                                               double *A,
+                                               double *B);
+
   /* /\** Computes F function used in Newton process for Alart-Curnier formulation */
   /*     \param size of the local problem */
   /*     \param localreaction */
@@ -38,6 +38,11 @@ int fc3d_setDefaultSolverOptions(SolverOptions* options, int solverId)
     info =    fc3d_nsgs_setDefaultSolverOptions(options);
     break;
   }
+  case SICONOS_FRICTION_3D_NSGS_DDM:
+  {
+    info =    fc3d_nsgs_ddm_setDefaultSolverOptions(options);
+    break;
+  }
   case SICONOS_FRICTION_3D_NSGSV:
   {
     info =    fc3d_nsgs_velocity_setDefaultSolverOptions(options);
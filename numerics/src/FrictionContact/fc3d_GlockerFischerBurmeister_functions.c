@@ -31,12 +31,12 @@
 
 /** writes \f$ F(z) \f$ using Glocker formulation and the Fischer-Burmeister function.
  */
-void F_GlockerFischerBurmeister(int sizeF, double* reaction, double* FVector, int up2Date)
+void F_GlockerFischerBurmeister(void* data, int sizeF, double* reaction, double* FVector, int up2Date)
 {
   /* Glocker formulation */
   double* FGlocker = NULL;
-  computeFGlocker(&FGlocker, up2Date);
-  /* Note that FGlocker is a static var. in fc3d2NCP_Glocker and thus there is no memory allocation in
+  computeFGlocker((NCPGlockerData*)data, &FGlocker, up2Date);
+  /* Note that FGlocker is kept in the NCPGlockerData and thus there is no memory allocation in
    the present file.
   */
 
@@ -47,13 +47,13 @@ void F_GlockerFischerBurmeister(int sizeF, double* reaction, double* FVector, in
 
 /** writes \f$ \nabla_z F(z) \f$  using Glocker formulation and the Fischer-Burmeister function.
  */
-void jacobianF_GlockerFischerBurmeister(int sizeF, double* reaction, double* jacobianFMatrix, int up2Date)
+void jacobianF_GlockerFischerBurmeister(void* data, int sizeF, double* reaction, double* jacobianFMatrix, int up2Date)
 {
   /* Glocker formulation */
   double* FGlocker = NULL, *jacobianFGlocker = NULL;
-  computeFGlocker(&FGlocker, up2Date);
-  computeJacobianFGlocker(&jacobianFGlocker, up2Date);
-  /* Note that FGlocker and jacobianFGlocker are static var. in fc3d2NCP_Glocker and thus there is no memory allocation in
+  computeFGlocker((NCPGlockerData*)data, &FGlocker, up2Date);
+  computeJacobianFGlocker((NCPGlockerData*)data, &jacobianFGlocker, up2Date);
+  /* Note that FGlocker and jacobianFGlocker are kept in the NCPGlockerData and thus there is no memory allocation in
    the present file.
   */
 
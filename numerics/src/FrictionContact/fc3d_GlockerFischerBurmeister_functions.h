@@ -32,10 +32,10 @@ extern "C"
 typedef void (*UpdateSolverPtr)(int, double*);
 
 
-  void F_GlockerFischerBurmeister(int sizeF, double* reaction, double* FVector, int up2Date);
+  void F_GlockerFischerBurmeister(void* data, int sizeF, double* reaction, double* FVector, int up2Date);
 
 
-  void jacobianF_GlockerFischerBurmeister(int sizeF, double* reaction, double* jacobianFMatrix, int up2Date);
+  void jacobianF_GlockerFischerBurmeister(void* data, int sizeF, double* reaction, double* jacobianFMatrix, int up2Date);
 
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
@@ -14,7 +14,8 @@
 #include "fclib_interface.h"
 #include "numerics_verbose.h"
 #include "SiconosCompat.h"
-static int fccounter = -1;
+#include "tlsdef.h"
+static tlsvar int fccounter = -1;
 
 /* #define DEBUG_NOCOLOR */
 /* #define DEBUG_MESSAGES */
@@ -24,24 +24,18 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "numerics_verbose.h"
-/* Pointer to function used to update the solver, to formalize the local problem for example. */
-typedef void (*UpdateSolverPtr)(int, double*);
-
-static UpdateSolverPtr updateSolver = NULL;
-static PostSolverPtr postSolver = NULL;
-static FreeSolverPtr freeSolver = NULL;
 
 /* size of a block */
-static int Fsize;
+#define Fsize 5
 
 /** writes \f$ F(z) \f$ using Glocker formulation
  */
-void F_GlockerFixedP(int sizeF, double* reaction, double* FVector, int up2Date)
+void F_GlockerFixedP(void* data, int sizeF, double* reaction, double* FVector, int up2Date)
 {
   /* Glocker formulation */
   double* FGlocker = NULL;
-  computeFGlocker(&FGlocker, up2Date);
-  /* Note that FGlocker is a static var. in fc3d2NCP_Glocker and thus there is no memory allocation in
+  computeFGlocker((NCPGlockerData*)data, &FGlocker, up2Date);
+  /* Note that FGlocker belongs to the NCPGlockerData of the solver and thus there is no memory allocation in
      the present file.
   */
 
@@ -64,11 +58,7 @@ void fc3d_FixedP_initialize(FrictionContactProblem* problem, FrictionContactProb
   /* Glocker formulation */
   if (localsolver_options->solverId == SICONOS_FRICTION_3D_NCPGlockerFBFixedPoint)
   {
-    Fsize = 5;
-    NCPGlocker_initialize(problem, localproblem);
-    /*     updateSolver = &NCPGlocker_update; */
-    postSolver = &NCPGlocker_post;
-    freeSolver = &NCPGlocker_free;
+    NCPGlocker_initialize(problem, localproblem, localsolver_options);
   }
   else
   {
@@ -84,7 +74,7 @@ int fc3d_FixedP_solve(FrictionContactProblem * localproblem , double* reaction,
 
   double * reactionBlock = reaction;
 
-  int info = Fixe(Fsize, reactionBlock, iparam, dparam);
+  int info = Fixe(Fsize, reactionBlock, iparam, dparam, options->solverData);
 
   if (info > 0)
   {
@@ -92,15 +82,11 @@ int fc3d_FixedP_solve(FrictionContactProblem * localproblem , double* reaction,
     exit(EXIT_FAILURE);
   }
   return info;
-
-  /*   (*postSolver)(contact,reaction); */
 }
 
 void fc3d_FixedP_free(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions * localsolver_option)
 {
-  updateSolver = NULL;
-  postSolver = NULL;
-  (*freeSolver)();
+  NCPGlocker_free(localsolver_option);
 }
 
 /*
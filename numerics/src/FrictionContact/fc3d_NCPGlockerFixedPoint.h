@@ -36,7 +36,7 @@ extern "C"
 {
 #endif
 
-  void F_GlockerFixedP(int sizeF, double* reaction, double* FVector, int up2Date);
+  void F_GlockerFixedP(void* data, int sizeF, double* reaction, double* FVector, int up2Date);
 
 
   /** Initialize friction-contact 3D Fixed Point solver
@@ -44,8 +44,8 @@ void F_GlockerPath(void* env, int sizeF, double* reaction, double* FVector)
   /* Glocker formulation */
   int up2Date = 0;
   double* FGlocker = NULL;
-  computeFGlocker(&FGlocker, up2Date);
-  /* Note that FGlocker is a static var. in fc3d2NCP_Glocker and thus there is no memory allocation in
+  computeFGlocker((NCPGlockerData*)env, &FGlocker, up2Date);
+  /* Note that FGlocker is kept in the NCPGlockerData and thus there is no memory allocation in
      the present file.
   */
 
@@ -61,9 +61,9 @@ void jacobianF_GlockerPath(void* env, int sizeF, double* reaction, NumericsMatri
   int up2Date = 0;
   /* Glocker formulation */
   double* FGlocker = NULL, *jacobianFGlocker = NULL;
-  computeFGlocker(&FGlocker, up2Date);
-  computeJacobianFGlocker(&jacobianFGlocker, up2Date);
-  /* Note that FGlocker and jacobianFGlocker are static var. in fc3d2NCP_Glocker and thus there is no memory allocation in
+  computeFGlocker((NCPGlockerData*)env, &FGlocker, up2Date);
+  computeJacobianFGlocker((NCPGlockerData*)env, &jacobianFGlocker, up2Date);
+  /* Note that FGlocker and jacobianFGlocker are kept in the NCPGlockerData and thus there is no memory allocation in
    the present file.
   */
 
@@ -82,7 +82,7 @@ void fc3d_Path_initialize(FrictionContactProblem* problem, FrictionContactProble
   /* Glocker formulation */
   if (localsolver_options->solverId == SICONOS_FRICTION_3D_NCPGlockerFBPATH)
   {
-    NCPGlocker_initialize(problem, localproblem);
+    NCPGlocker_initialize(problem, localproblem, localsolver_options);
   }
   else
   {
@@ -99,7 +99,7 @@ int fc3d_Path_solve(FrictionContactProblem * localproblem , double* reaction, So
     &F_GlockerPath,
     &jacobianF_GlockerPath,
     NULL,
-    NULL
+    options->solverData
   };
 
   double Fvec[5];
@@ -114,9 +114,9 @@ int fc3d_Path_solve(FrictionContactProblem * localproblem , double* reaction, So
   /*   (*postSolver)(contact,reaction); */
 }
 
-void fc3d_Path_free()
+void fc3d_Path_free(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions * localsolver_options)
 {
-  NCPGlocker_free();
+  NCPGlocker_free(localsolver_options);
 }
 
 void fc3d_Path_computeError(int n, double* velocity, double* reaction, double * error)
@@ -50,8 +50,12 @@ extern "C"
    */
   int fc3d_Path_solve(FrictionContactProblem * localproblem , double* reaction, SolverOptions* options);
 
-  /** free memory for friction contact 3D Path solver */
-  void fc3d_Path_free(void);
+  /** free memory for friction contact 3D Path solver
+   * \param problem the global problem to solve
+   * \param localproblem for freeing matrix0
+   * \param localsolver_options the options of the local solver
+   */
+  void fc3d_Path_free(FrictionContactProblem* problem, FrictionContactProblem* localproblem, SolverOptions* localsolver_options);
 
   /**  compute error for  friction-contact 3D problem with Path
    * \param dimension of the global problem
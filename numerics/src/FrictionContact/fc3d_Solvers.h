@@ -123,6 +123,54 @@ extern "C"
   */
   int fc3d_nsgs_setDefaultSolverOptions(SolverOptions* options);
 
+  /** Non-Smooth Gauss Seidel solver with a domain decomposition for
+      friction-contact 3D problem.
+
+      The contacts are split into one subdomain per MPI process: a
+      breadth first ordering of the graph of the contacts coupled by M
+      is cut into parts of equal weights. Each process runs NSGS sweeps
+      over its contacts, the reactions of the other subdomains being
+      frozen, then the reactions of the interface contacts are
+      exchanged. The problem data and the reaction and velocity
+      vectors are known by all the processes, and the whole solution
+      is gathered on all of them at the end. Without MPI, or if MPI is
+      not initialized, the problem is solved on a single subdomain,
+      like with fc3d_nsgs.
+
+      \param problem the friction-contact 3D problem to solve
+      \param velocity global vector (n), in-out parameter
+      \param reaction global vector (n), in-out parameters
+      \param info return 0 if the solution is found
+      \param options the solver options :
+
+      [in] iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION(7)] : light error, light error with
+          a full final check, or full error computed over the subdomains
+
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION(4)], iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION(14)]
+          and dparam[SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE(8)] : as in fc3d_nsgs
+
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_DDM_LOCAL_SWEEPS(9)] : number of sweeps over a subdomain between two exchanges
+
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_DDM_REPARTITION_FREQUENCY(10)] : number of iterations between two partitions,
+          balanced with the iterations of the local solver measured on each contact (0: one partition per call)
+
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_DDM_MPI_COM(11)] : MPI communicator (fortran handle), -1 for MPI_COMM_WORLD (MPI is initialized if needed)
+
+      [in] dparam[SICONOS_FRICTION_3D_NSGS_DDM_INTERFACE_RELAXATION(9)] : relaxation of the reactions of the interface
+          contacts, which are updated at the same time as their neighbours of the other subdomains (default 0.8)
+
+      [out] iparam[SICONOS_IPARAM_ITER_DONE(1)] = iter number of performed iterations
+      [out] dparam[SICONOS_DPARAM_RESIDU(1)]  reached error
+
+      The internal (local) solver must set by the SolverOptions options[1]
+  */
+  void fc3d_nsgs_ddm(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options);
+
+  /** set the default solver parameters and perform memory allocation for NSGS_DDM
+      \param options the pointer to the array of options to set
+  */
+  int fc3d_nsgs_ddm_setDefaultSolverOptions(SolverOptions* options);
+
   void fc3d_admm(FrictionContactProblem*  problem, double*  reaction,
                  double*  velocity,
                  int*  info, SolverOptions*  options);
@@ -392,6 +440,13 @@ extern "C"
   */
   int fc3d_checkTrivialCase(FrictionContactProblem* problem , double* velocity, double* reaction, SolverOptions* options);
 
+  /** Tell if a solver may run concurrently on problems sharing the
+      same matrix M (see fc3d_driver_batch)
+      \param options the solver options
+      \return 1 if the solver keeps no global state and does not modify M, else 0
+  */
+  int fc3d_batch_is_reentrant(SolverOptions* options);
+
 
   void fc3d_nonsmooth_Newton_AlartCurnier2(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options);
 
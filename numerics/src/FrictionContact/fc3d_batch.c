@@ -0,0 +1,180 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "SiconosConfig.h"
+#include "fc3d_Solvers.h"
+#include "NonSmoothDrivers.h"
+#include "numerics_verbose.h"
+#include "NumericsMatrix.h"
+#include "NumericsSparseMatrix.h"
+
+/* #define DEBUG_MESSAGES */
+/* #define DEBUG_STDOUT */
+#include "debug.h"
+
+int fc3d_batch_is_reentrant(SolverOptions* options)
+{
+  switch (options->solverId)
+  {
+  case SICONOS_FRICTION_3D_NSGS:
+  {
+    assert(options->numberOfInternalSolvers > 0);
+    switch (options->internalSolvers->solverId)
+    {
+    case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithDiagonalization:
+    case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnCone:
+    case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration:
+    case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithRegularization:
+    case SICONOS_FRICTION_3D_ONECONTACT_NSN:
+    case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP:
+    case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID:
+    case SICONOS_FRICTION_3D_NCPGlockerFBNewton:
+      return 1;
+    default:
+      return 0;
+    }
+  }
+  default:
+    return 0;
+  }
+}
+
+/* A scenario copy of the options must not free what belongs to the
+ * original one. */
+static void fc3d_batch_options_unshare(SolverOptions* options)
+{
+  options->callback = NULL;
+  options->solverData = NULL;
+  options->solverParameters = NULL;
+  for (int i = 0; i < options->numberOfInternalSolvers; i++)
+    fc3d_batch_options_unshare(&options->internalSolvers[i]);
+}
+
+/* The storages of a sparse M derived from its origin (csc, transposed
+ * csc, indices of the diagonal) are built on first use: build them all
+ * before M is shared between the scenarios, so that the threads only
+ * read it. */
+static void fc3d_batch_build_matrix_caches(NumericsMatrix* M)
+{
+  if (M->storageType != NM_SPARSE)
+    return;
+
+  NM_csc(M);
+  if (M->matrix2->origin != NSM_CSR)
+  {
+    /* may replace the csc storage by one with all the diagonal terms */
+    NSM_diag_indices(M);
+    NM_csc_trans(M);
+  }
+}
+
+static int fc3d_batch_solve_scenario(FrictionContactProblem* problem,
+                                     int k, double* q, double* mu,
+                                     double* reaction, double* velocity,
+                                     SolverOptions* options)
+{
+  int n = problem->dimension * problem->numberOfContacts;
+
+  /* the scenario shares M with the batch, only q and mu are its own */
+  FrictionContactProblem scenario = *problem;
+  scenario.q = q + k * n;
+  scenario.mu = mu + k * problem->numberOfContacts;
+
+  DEBUG_PRINTF("fc3d_driver_batch: solve scenario %i\n", k);
+  return fc3d_driver(&scenario, reaction + k * n, velocity + k * n, options);
+}
+
+int fc3d_driver_batch(FrictionContactProblem* problem, int nbScenarios,
+                      double* q, double* mu,
+                      double* reaction, double* velocity,
+                      SolverOptions* options, int* info)
+{
+  if (options == NULL)
+    numerics_error("fc3d_driver_batch", "null input for solver options");
+  if (nbScenarios < 0)
+    numerics_error("fc3d_driver_batch", "negative number of scenarios");
+
+  int* scenarioInfo = info ? info : (int*)malloc(nbScenarios * sizeof(int));
+  int* iterations = (int*)calloc(nbScenarios, sizeof(int));
+  double* residus = (double*)calloc(nbScenarios, sizeof(double));
+
+  if (fc3d_batch_is_reentrant(options))
+  {
+    fc3d_batch_build_matrix_caches(problem->M);
+
+    /* each scenario works on its own copy of the options */
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < nbScenarios; k++)
+    {
+      SolverOptions scenarioOptions;
+      memset(&scenarioOptions, 0, sizeof(SolverOptions));
+      solver_options_copy(options, &scenarioOptions);
+      fc3d_batch_options_unshare(&scenarioOptions);
+
+      scenarioInfo[k] = fc3d_batch_solve_scenario(problem, k, q, mu,
+                                                  reaction, velocity,
+                                                  &scenarioOptions);
+      iterations[k] = scenarioOptions.iparam[SICONOS_IPARAM_ITER_DONE];
+      residus[k] = scenarioOptions.dparam[SICONOS_DPARAM_RESIDU];
+      solver_options_delete(&scenarioOptions);
+    }
+  }
+  else
+  {
+    numerics_printf_verbose(1, "fc3d_driver_batch: solver %s is not reentrant, scenarios are solved sequentially.",
+                            solver_options_id_to_name(options->solverId));
+    for (int k = 0; k < nbScenarios; k++)
+    {
+      scenarioInfo[k] = fc3d_batch_solve_scenario(problem, k, q, mu,
+                                                  reaction, velocity,
+                                                  options);
+      iterations[k] = options->iparam[SICONOS_IPARAM_ITER_DONE];
+      residus[k] = options->dparam[SICONOS_DPARAM_RESIDU];
+    }
+  }
+
+  /* report the worst scenario */
+  int failures = 0;
+  int maxIterations = 0;
+  double maxResidu = 0.0;
+  for (int k = 0; k < nbScenarios; k++)
+  {
+    if (scenarioInfo[k])
+      failures++;
+    if (iterations[k] > maxIterations)
+      maxIterations = iterations[k];
+    if (residus[k] > maxResidu)
+      maxResidu = residus[k];
+  }
+  options->iparam[SICONOS_IPARAM_ITER_DONE] = maxIterations;
+  options->dparam[SICONOS_DPARAM_RESIDU] = maxResidu;
+
+  numerics_printf_verbose(1, "fc3d_driver_batch: %i/%i scenarios failed, max iterations %i, max residu %e",
+                          failures, nbScenarios, maxIterations, maxResidu);
+
+  free(iterations);
+  free(residus);
+  if (!info)
+    free(scenarioInfo);
+
+  return failures;
+}
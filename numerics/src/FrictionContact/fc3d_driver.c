@@ -108,6 +108,13 @@ int fc3d_driver(FrictionContactProblem* problem,
     fc3d_nsgs(problem, reaction , velocity , &info , options);
     break;
   }
+  /* NSGS with a domain decomposition over the MPI processes */
+  case SICONOS_FRICTION_3D_NSGS_DDM:
+  {
+    numerics_printf(" ========================== Call NSGS_DDM solver for Friction-Contact 3D problem ==========================\n");
+    fc3d_nsgs_ddm(problem, reaction , velocity , &info , options);
+    break;
+  }
   case SICONOS_FRICTION_3D_NSGSV:
   {
     numerics_printf(" ========================== Call NSGSV solver for Friction-Contact 3D problem ==========================\n");
@@ -18,6 +18,8 @@
 #include "FrictionContactProblem.h"
 #include "fc3d_local_problem_tools.h"
 #include "NumericsMatrix.h"
+#include "NumericsMatrix_internal.h"
+#include "SolverOptions.h"
 
 
 void fc3d_local_problem_compute_q(FrictionContactProblem * problem, FrictionContactProblem * localproblem, double *reaction, int contact)
@@ -66,6 +68,31 @@ FrictionContactProblem* fc3d_local_problem_allocate(FrictionContactProblem* prob
   return localproblem;
 }
 
+FrictionContactProblem* fc3d_local_problem_workspace_allocate(FrictionContactProblem* problem,
+                                                              SolverOptions* options)
+{
+  FrictionContactProblem* localproblem =
+    (FrictionContactProblem*)solver_options_workspace_alloc(options, sizeof(FrictionContactProblem));
+  localproblem->numberOfContacts = 1;
+  localproblem->dimension = 3;
+  localproblem->q = (double*)solver_options_workspace_alloc(options, 3 * sizeof(double));
+  localproblem->mu = (double*)solver_options_workspace_alloc(options, sizeof(double));
+  localproblem->M = (NumericsMatrix*)solver_options_workspace_alloc(options, sizeof(NumericsMatrix));
+
+  /* with a sparse block matrix, fc3d_local_problem_fill_M makes matrix0
+   * point to a diagonal block of problem->M, but some local solvers
+   * copy the block: the storage is always there */
+  NM_fill(localproblem->M, NM_DENSE, 3, 3,
+          solver_options_workspace_alloc(options, 9 * sizeof(double)));
+  return localproblem;
+}
+
+void fc3d_local_problem_workspace_free(FrictionContactProblem* localproblem)
+{
+  /* only the internal data of the matrix is on the heap */
+  NM_internalData_free(localproblem->M);
+}
+
 void fc3d_local_problem_free(FrictionContactProblem* localproblem,
                       FrictionContactProblem* problem)
 {
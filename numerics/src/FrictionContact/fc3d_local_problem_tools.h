@@ -22,6 +22,7 @@
 
  */
 #include "FrictionContactProblem.h"
+#include "SolverOptions.h"
 
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 extern "C"
@@ -30,6 +31,22 @@ extern "C"
   FrictionContactProblem* fc3d_local_problem_allocate(FrictionContactProblem* problem);
   void fc3d_local_problem_free(FrictionContactProblem* localproblem,
                                FrictionContactProblem* problem);
+
+  /** allocate a local problem in the workspace of the options (see
+   * solver_options_workspace_alloc), no heap allocation is needed
+   * once the workspace is large enough.
+   * \param problem the global problem
+   * \param options the options owning the workspace
+   * \return the local problem, valid until the next reset of the workspace
+   */
+  FrictionContactProblem* fc3d_local_problem_workspace_allocate(FrictionContactProblem* problem,
+                                                                SolverOptions* options);
+
+  /** release what a local problem allocated in a workspace may hold on
+   * the heap
+   * \param localproblem the local problem
+   */
+  void fc3d_local_problem_workspace_free(FrictionContactProblem* localproblem);
   void fc3d_local_problem_compute_q(FrictionContactProblem * problem, FrictionContactProblem * localproblem, double *reaction, int contact);
   void fc3d_local_problem_fill_M(FrictionContactProblem * problem, FrictionContactProblem * localproblem, int contact);
   
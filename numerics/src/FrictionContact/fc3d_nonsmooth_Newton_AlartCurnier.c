@@ -59,6 +59,14 @@ void fc3d_AlartCurnierFunction(
   //assert(problemSize / 3 > 0);
   assert(problemSize % 3 == 0);
 
+  /* the generated function has a batched version */
+  if (computeACFun3x3 == &fc3d_AlartCurnierFunctionGenerated && result)
+  {
+    fc3d_AlartCurnierFunctionGeneratedBatch(problemSize / 3, reaction, velocity,
+                                            mu, rho, result, A, B);
+    return;
+  }
+
   unsigned int i;
   for (i = 0; i < problemSize; i += 3)
   {
@@ -207,8 +215,8 @@ int fc3d_nonsmooth_Newton_AlartCurnier_setDefaultSolverOptions(
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 20;
-  options->dSize = 20;
+  options->iSize = 21;
+  options->dSize = 21;
   options->iparam = (int *)calloc(options->iSize, sizeof(int));
   options->dparam = (double *)calloc(options->dSize, sizeof(double));
   options->dWork = NULL;
@@ -231,8 +239,12 @@ int fc3d_nonsmooth_Newton_AlartCurnier_setDefaultSolverOptions(
 #ifdef WITH_MUMPS
   options->iparam[13] = 1;
 #else
-  options->iparam[13] = 0;     /* Linear solver used at each Newton iteration. 0: cs_lusol, 1 mumps */
+  options->iparam[13] = 0;     /* Linear solver used at each Newton iteration. 0: cs_lusol, 1 mumps, 2 matrix-free GMRES */
 #endif
+  options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_MAXITER] = 200;
+  options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_RESTART] = 30;
+  options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_MAX] = 0.9;
+  options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_GAMMA] = 0.9;
 
   options->internalSolvers = NULL;
 
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
+#include <float.h>
 #include <assert.h>
 #include "Friction_cst.h"
 #include "SiconosLapack.h"
@@ -55,6 +56,15 @@ void fc3d_FischerBurmeisterFunction(
   assert(problemSize / 3 > 0);
   assert(problemSize % 3 == 0);
 
+  /* the generated function has a batched version, for the Newton
+   * assembly */
+  if (computeACFun3x3 == &fc3d_FischerBurmeisterFunctionGenerated && result && A && B)
+  {
+    fc3d_FischerBurmeisterFunctionGeneratedBatch(problemSize / 3, reaction, velocity,
+                                                 mu, rho, result, A, B);
+    return;
+  }
+
   unsigned int i;
   for (i = 0; i < problemSize; i += 3)
   {
@@ -80,6 +90,236 @@ void fc3d_FischerBurmeisterFunction(
 }
 
 
+/* threshold of the degenerate cases in FischerBurmeisterGenerated.c */
+#define FC3D_FB_ZERO (DBL_EPSILON * 500)
+
+/* fc3d_FischerBurmeisterFABGenerated on FC3D_FB_BATCH_SIZE contacts at
+ * once, in structure of arrays layout. The statements are the ones of
+ * the regular case of the generated code, where its square roots (x3,
+ * x21, x24) are above its threshold. The lanes outside of this case
+ * are flagged to 0 in regular and their results are meaningless. */
+static void fc3d_FischerBurmeisterFABGeneratedLanes(
+  const double rn_[FC3D_FB_BATCH_SIZE],
+  const double rt1_[FC3D_FB_BATCH_SIZE],
+  const double rt2_[FC3D_FB_BATCH_SIZE],
+  const double un_[FC3D_FB_BATCH_SIZE],
+  const double ut1_[FC3D_FB_BATCH_SIZE],
+  const double ut2_[FC3D_FB_BATCH_SIZE],
+  const double mu_[FC3D_FB_BATCH_SIZE],
+  double result[21][FC3D_FB_BATCH_SIZE],
+  int regular[FC3D_FB_BATCH_SIZE])
+{
+  int l;
+  for (l = 0; l < FC3D_FB_BATCH_SIZE; ++l)
+  {
+    double rn = rn_[l];
+    double rt1 = rt1_[l];
+    double rt2 = rt2_[l];
+    double un = un_[l];
+    double ut1 = ut1_[l];
+    double ut2 = ut2_[l];
+    double mu = mu_[l];
+      double x1 = ut1*ut1;
+      double x2 = ut2*ut2;
+      double x3 = sqrt(x1 + x2);
+      double x4 = x3*mu + un;
+      double x5 = mu*rn;
+      double x6 = rt1*rt1;
+      double x7 = rt2*rt2;
+      double x8 = mu*mu;
+      double x9 = rn*rn;
+      double x10 = x8*x9;
+      double x11 = x1*x8;
+      double x12 = x2*x8;
+      double x13 = x4*x4 + x6 + x7 + x10 + x11 + x12;
+      double x14 = mu*ut1;
+      double x15 = x5*rt1 + x14*x4;
+      double x16 = x15*x15;
+      double x17 = mu*ut2;
+      double x18 = x5*rt2 + x17*x4;
+      double x19 = x18*x18;
+      double x20 = x16 + x19;
+      double x21 = sqrt(x20);
+      double x22 = 2*x21;
+      double x23 = x13 - x22;
+      double x38 = fabs(x23);
+      double x24 = sqrt(x23);
+      double x26 = sqrt(x13 + x22);
+      double x50 = 0.5/x26;
+      double x51 = x14*x15;
+      double x52 = x17*x18;
+      double x53 = 1.0/x21;
+      double x54 = x53*(x51 + x52);
+      double x55 = x50*(x4 + x54);
+      double x56 = 0.5/x24;
+      double x57 = x56*(x4 - x54);
+      double x25 = 0.5*x24;
+      double x27 = 0.5*x26;
+      result[0][l] = -x25 - x27 + x4 + x5;
+      double x111 = rt1 + x14;
+      double x112 = x15*x53;
+      result[1][l] = x111 + x112*x25 - x112*x27;
+      double x187 = rt2 + x17;
+      double x188 = x18*x53;
+      result[2][l] = x187 + x188*x25 - x188*x27;
+      result[3][l] = 1 - x55 - x57;
+      double x121 = -x51 - x52;
+      double x122 = pow(x20, -3.0/2.0);
+      double x123 = x122*x15;
+      double x124 = x121*x123 + x14*x53;
+      result[4][l] = -x112*x55 + x112*x57 + x124*x25 - x124*x27;
+      double x190 = x122*x18;
+      double x191 = x121*x190 + x17*x53;
+      result[5][l] = -x188*x55 + x188*x57 + x191*x25 - x191*x27;
+      double x70 = 1.0/x3;
+      double x71 = x14*x70;
+      double x72 = x8*ut1 + x4*x71;
+      double x73 = x70*x8*ut1*ut2;
+      double x74 = x18*x73;
+      double x75 = x4*mu;
+      double x76 = 2*x75;
+      double x77 = x11*x70;
+      double x78 = (1.0/2.0)*x15*(x76 + 2*x77);
+      double x79 = x53*(x74 + x78);
+      double x80 = x50*(x72 + x79);
+      double x81 = x56*(x72 - x79);
+      result[6][l] = x71 - x80 - x81;
+      double x165 = -x74 - x78;
+      double x166 = x53*(x75 + x77) + x123*x165;
+      result[7][l] = mu - x112*x80 + x112*x81 + x166*x25 - x166*x27;
+      double x171 = x53*x73;
+      double x198 = x165*x190 + x171;
+      result[8][l] = -x188*x80 + x188*x81 + x198*x25 - x198*x27;
+      double x82 = x17*x70;
+      double x83 = x8*ut2 + x4*x82;
+      double x84 = x15*x73;
+      double x85 = x12*x70;
+      double x86 = (1.0/2.0)*x18*(x76 + 2*x85);
+      double x87 = x53*(x84 + x86);
+      double x88 = x50*(x83 + x87);
+      double x89 = x56*(x83 - x87);
+      result[9][l] = x82 - x88 - x89;
+      double x172 = -x84 - x86;
+      double x173 = x123*x172 + x171;
+      result[10][l] = -x112*x88 + x112*x89 + x173*x25 - x173*x27;
+      double x200 = x53*(x75 + x85) + x172*x190;
+      result[11][l] = mu - x188*x88 + x188*x89 + x200*x25 - x200*x27;
+      double x92 = x8*rn;
+      double x93 = mu*rt1;
+      double x94 = x15*x93;
+      double x95 = mu*rt2;
+      double x96 = x18*x95;
+      double x97 = x53*(x94 + x96);
+      double x98 = x50*(x92 + x97);
+      double x99 = x56*(x92 - x97);
+      result[12][l] = mu - x98 - x99;
+      double x175 = -x94 - x96;
+      double x176 = x123*x175 + x53*x93;
+      result[13][l] = -x112*x98 + x112*x99 + x176*x25 - x176*x27;
+      double x201 = x175*x190 + x53*x95;
+      result[14][l] = -x188*x98 + x188*x99 + x201*x25 - x201*x27;
+      double x104 = x5*x53;
+      double x105 = x104*x15;
+      double x106 = x50*(rt1 + x105);
+      double x107 = x56*(rt1 - x105);
+      result[15][l] = -x106 - x107;
+      double x182 = x122*mu*rn;
+      double x183 = x104 - x16*x182;
+      result[16][l] = 1 - x106*x112 + x107*x112 + x183*x25 - x183*x27;
+      double x185 = x122*x15*x18*mu*rn;
+      double x186 = -x185*x25 + x185*x27;
+      result[17][l] = -x106*x188 + x107*x188 + x186;
+      double x108 = x104*x18;
+      double x109 = x50*(rt2 + x108);
+      double x110 = x56*(rt2 - x108);
+      result[18][l] = -x109 - x110;
+      result[19][l] = -x109*x112 + x110*x112 + x186;
+      double x202 = x104 - x182*x19;
+      result[20][l] = 1 - x109*x188 + x110*x188 + x202*x25 - x202*x27;
+
+    /* the square roots of the generated code are 0 below the
+     * threshold */
+    regular[l] = x1 + x2 > FC3D_FB_ZERO * FC3D_FB_ZERO && x3 > FC3D_FB_ZERO &&
+      x20 > FC3D_FB_ZERO * FC3D_FB_ZERO && x21 > FC3D_FB_ZERO &&
+      x23 > 0. && x38 > FC3D_FB_ZERO;
+  }
+}
+
+void fc3d_FischerBurmeisterFunctionGeneratedBatch(
+  unsigned int nc,
+  double *reaction,
+  double *velocity,
+  double *mu,
+  double *rho,
+  double *F,
+  double *A,
+  double *B)
+{
+  double in[7][FC3D_FB_BATCH_SIZE];
+  double result[21][FC3D_FB_BATCH_SIZE];
+  int regular[FC3D_FB_BATCH_SIZE];
+  unsigned int c, l, k;
+
+  assert(reaction);
+  assert(velocity);
+  assert(mu);
+  assert(rho);
+  assert(F);
+  assert(A);
+  assert(B);
+
+  for (c = 0; c + FC3D_FB_BATCH_SIZE <= nc; c += FC3D_FB_BATCH_SIZE)
+  {
+    /* gather */
+    for (l = 0; l < FC3D_FB_BATCH_SIZE; ++l)
+    {
+      unsigned int i3 = 3 * (c + l);
+      in[0][l] = reaction[i3];
+      in[1][l] = reaction[i3 + 1];
+      in[2][l] = reaction[i3 + 2];
+      in[3][l] = velocity[i3];
+      in[4][l] = velocity[i3 + 1];
+      in[5][l] = velocity[i3 + 2];
+      in[6][l] = mu[c + l];
+    }
+
+    fc3d_FischerBurmeisterFABGeneratedLanes(in[0], in[1], in[2], in[3], in[4],
+                                            in[5], in[6], result, regular);
+
+    /* scatter the regular lanes, the other ones go through the
+     * generated function */
+    for (l = 0; l < FC3D_FB_BATCH_SIZE; ++l)
+    {
+      unsigned int i = c + l;
+      if (regular[l])
+      {
+        for (k = 0; k < 3; ++k)
+          F[3 * i + k] = result[k][l];
+        for (k = 0; k < 9; ++k)
+        {
+          A[9 * i + k] = result[3 + k][l];
+          B[9 * i + k] = result[12 + k][l];
+        }
+      }
+      else
+      {
+        fc3d_FischerBurmeisterFunctionGenerated(reaction + 3 * i, velocity + 3 * i,
+                                                mu[i], rho + 3 * i, F + 3 * i,
+                                                A + 9 * i, B + 9 * i);
+      }
+    }
+  }
+
+  /* remaining contacts */
+  for (; c < nc; ++c)
+  {
+    fc3d_FischerBurmeisterFunctionGenerated(reaction + 3 * c, velocity + 3 * c,
+                                            mu[c], rho + 3 * c, F + 3 * c,
+                                            A + 9 * c, B + 9 * c);
+  }
+}
+
+
 int fc3d_nonsmooth_Newton_FischerBurmeister_compute_error(
     FrictionContactProblem* problem,
     double *z , double *w, double tolerance,
@@ -150,8 +390,8 @@ int fc3d_nonsmooth_Newton_FischerBurmeister_setDefaultSolverOptions(
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 14;
-  options->dSize = 14;
+  options->iSize = 21;
+  options->dSize = 21;
   options->iparam = (int *)calloc(options->iSize, sizeof(int));
   options->dparam = (double *)calloc(options->dSize, sizeof(double));
   options->dWork = NULL;
@@ -172,8 +412,12 @@ int fc3d_nonsmooth_Newton_FischerBurmeister_setDefaultSolverOptions(
 #ifdef WITH_MUMPS
   options->iparam[13] = 1;
 #else
-  options->iparam[13] = 0;     /* Linear solver used at each Newton iteration. 0: cs_lusol, 1 mumps */
+  options->iparam[13] = 0;     /* Linear solver used at each Newton iteration. 0: cs_lusol, 1 mumps, 2 matrix-free GMRES */
 #endif
+  options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_MAXITER] = 200;
+  options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_RESTART] = 30;
+  options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_MAX] = 0.9;
+  options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_GAMMA] = 0.9;
 
   options->internalSolvers = NULL;
 
@@ -39,6 +39,17 @@
 #include "SiconosConfig.h"
 #include "FrictionContactProblem.h"
 
+/** number of contacts evaluated together by
+ * fc3d_FischerBurmeisterFunctionGeneratedBatch: the number of doubles in
+ * a SIMD register */
+#ifndef FC3D_FB_BATCH_SIZE
+#if defined(__AVX512F__)
+#define FC3D_FB_BATCH_SIZE 8
+#else
+#define FC3D_FB_BATCH_SIZE 4
+#endif
+#endif
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 extern "C"
 {
@@ -93,6 +104,30 @@ extern "C"
     double *output_blocklist3x3_1,
     double *output_blocklist3x3_2);
 
+  /** fc3d_FischerBurmeisterFunctionGenerated on nc contacts, with F, A
+      and B, evaluated by groups of FC3D_FB_BATCH_SIZE contacts in
+      structure of arrays layout. The regular case of the generated code
+      is computed on all the contacts of a group and kept on the contacts
+      where it applies (masked blend), the other contacts of the group
+      and the remaining ones are computed one by one.
+      \param nc the number of contacts
+      \param reaction the reactions (size 3 nc)
+      \param velocity the velocities (size 3 nc)
+      \param mu the friction coefficients (size nc)
+      \param rho the rho parameters (size 3 nc)
+      \param[out] F the Fischer & Burmeister function (size 3 nc)
+      \param[out] A the A part of the gradient (size 9 nc)
+      \param[out] B the B part of the gradient (size 9 nc)
+  */
+  void fc3d_FischerBurmeisterFunctionGeneratedBatch(unsigned int nc,
+                                                    double *reaction,
+                                                    double *velocity,
+                                                    double *mu,
+                                                    double *rho,
+                                                    double *F,
+                                                    double *A,
+                                                    double *B);
+
   /* Set the default solver options for the NSN_FB Solver
    * Some default values:
    * options.iparam[0] = 200 is the maximum number of iterations.
@@ -150,8 +150,8 @@ int fc3d_nonsmooth_Newton_NaturalMap_setDefaultSolverOptions(
   options->numberOfInternalSolvers = 0;
   options->isSet = 1;
   options->filterOn = 1;
-  options->iSize = 14;
-  options->dSize = 14;
+  options->iSize = 21;
+  options->dSize = 21;
   options->iparam = (int *)calloc(options->iSize, sizeof(int));
   options->dparam = (double *)calloc(options->dSize, sizeof(double));
   options->dWork = NULL;
@@ -172,8 +172,12 @@ int fc3d_nonsmooth_Newton_NaturalMap_setDefaultSolverOptions(
 #ifdef WITH_MUMPS
   options->iparam[13] = 1;
 #else
-  options->iparam[13] = 0;     /* Linear solver used at each Newton iteration. 0: cs_lusol, 1 mumps */
+  options->iparam[13] = 0;     /* Linear solver used at each Newton iteration. 0: cs_lusol, 1 mumps, 2 matrix-free GMRES */
 #endif
+  options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_MAXITER] = 200;
+  options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_RESTART] = 30;
+  options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_MAX] = 0.9;
+  options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_GAMMA] = 0.9;
 
   options->internalSolvers = NULL;
 
@@ -33,6 +33,7 @@
 #include "AlartCurnierGenerated.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <assert.h>
 #include "Friction_cst.h"
@@ -216,6 +217,226 @@ void computeAWpB(
   }
 }
 
+/* Matrix-free Newton-Krylov: AW+B is only known through products with
+ * a vector, the W product is the one of the problem matrix and A, B
+ * are the 3x3 blocks of each contact. */
+
+/* y <- (AW+B) x, x and y must not overlap */
+static void fc3d_AWpB_gemv(
+  double *A,
+  NumericsMatrix *W,
+  double *B,
+  double *x,
+  double *y)
+{
+  unsigned int problemSize = W->size0;
+  double Wx[3];
+
+  NM_gemv(1., W, x, 0., y);
+
+  for (unsigned int ip3 = 0, ip9 = 0; ip3 < problemSize; ip3 += 3, ip9 += 9)
+  {
+    cpy3(&y[ip3], Wx);
+    mv3x3(&A[ip9], Wx, &y[ip3]);
+    mvp3x3(&B[ip9], &x[ip3], &y[ip3]);
+  }
+}
+
+typedef struct
+{
+  unsigned int restart;
+  unsigned int maxiter;
+  double *V;       /* Krylov basis, (restart+1) vectors */
+  double *H;       /* Hessenberg matrix, (restart+1) x restart */
+  double *cs;      /* Givens rotations */
+  double *sn;
+  double *g;       /* rotated right hand side */
+  double *z;
+  double *w;
+  double *Pinv;    /* inverses of the diagonal blocks of AW+B */
+} fc3d_nsn_krylov;
+
+static void fc3d_nsn_krylov_allocate(fc3d_nsn_krylov *krylov,
+                                     unsigned int problemSize,
+                                     SolverOptions *options)
+{
+  unsigned int m = krylov->restart;
+  krylov->V = (double *) solver_options_workspace_alloc(options, (m + 1) * problemSize * sizeof(double));
+  krylov->H = (double *) solver_options_workspace_alloc(options, (m + 1) * m * sizeof(double));
+  krylov->cs = (double *) solver_options_workspace_alloc(options, 4 * (m + 1) * sizeof(double));
+  krylov->sn = krylov->cs + m + 1;
+  krylov->g = krylov->sn + m + 1;
+  krylov->z = (double *) solver_options_workspace_alloc(options, 2 * problemSize * sizeof(double));
+  krylov->w = krylov->z + problemSize;
+  krylov->Pinv = (double *) solver_options_workspace_alloc(options, 3 * problemSize * sizeof(double));
+}
+
+/* block Jacobi preconditioner: the inverses of A_i W_ii + B_i. A
+ * singular block is replaced by the identity. */
+static void fc3d_nsn_krylov_preconditioner(fc3d_nsn_krylov *krylov,
+                                           double *A,
+                                           NumericsMatrix *W,
+                                           double *B)
+{
+  unsigned int problemSize = W->size0;
+  double Wii[9], Pi[9], e[3];
+
+  for (unsigned int ip3 = 0, ip9 = 0; ip3 < problemSize; ip3 += 3, ip9 += 9)
+  {
+    double *Wiip = Wii;
+    NM_extract_diag_block3(W, ip3 / 3, &Wiip);
+    mm3x3(&A[ip9], Wiip, Pi);
+    add3x3(&B[ip9], Pi);
+
+    double *Pinvi = &krylov->Pinv[ip9];
+    int singular = 0;
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      e[0] = 0.; e[1] = 0.; e[2] = 0.;
+      e[j] = 1.;
+      singular |= solv3x3(Pi, &Pinvi[3 * j], e);
+    }
+    if (singular)
+    {
+      for (unsigned int k = 0; k < 9; ++k)
+        Pinvi[k] = (k % 4) ? 0. : 1.;
+    }
+  }
+}
+
+/* y <- P^{-1} x */
+static void fc3d_nsn_krylov_precondition(fc3d_nsn_krylov *krylov,
+                                         unsigned int problemSize,
+                                         double *x,
+                                         double *y)
+{
+  for (unsigned int ip3 = 0, ip9 = 0; ip3 < problemSize; ip3 += 3, ip9 += 9)
+    mv3x3(&krylov->Pinv[ip9], &x[ip3], &y[ip3]);
+}
+
+/* Solve (AW+B) x = b with right preconditioned GMRES(m), starting
+ * from x = 0, until ||b - (AW+B) x|| <= eta ||b||.
+ * \return 0 if the tolerance is reached, 1 otherwise */
+static int fc3d_nsn_krylov_solve(fc3d_nsn_krylov *krylov,
+                                 double *A,
+                                 NumericsMatrix *W,
+                                 double *B,
+                                 double *b,
+                                 double *x,
+                                 double eta,
+                                 double *residual,
+                                 unsigned int *iterations)
+{
+  unsigned int n = W->size0;
+  unsigned int m = krylov->restart;
+  double *V = krylov->V;
+  double *H = krylov->H;
+  double *cs = krylov->cs;
+  double *sn = krylov->sn;
+  double *g = krylov->g;
+  double *z = krylov->z;
+  double *w = krylov->w;
+
+  unsigned int iter = 0;
+  double normb = cblas_dnrm2(n, b, 1);
+  double target = eta * normb;
+
+  memset(x, 0, n * sizeof(double));
+  cblas_dcopy(n, b, 1, V, 1);
+  double beta = normb;
+  *residual = beta;
+
+  while (beta > target && iter < krylov->maxiter)
+  {
+    cblas_dscal(n, 1. / beta, V, 1);
+    memset(g, 0, (m + 1) * sizeof(double));
+    g[0] = beta;
+
+    unsigned int j = 0;
+    while (j < m && iter < krylov->maxiter)
+    {
+      double *vj = &V[j * n];
+      double *vj1 = &V[(j + 1) * n];
+      double *hj = &H[j * (m + 1)];
+
+      /* v_{j+1} <- (AW+B) P^{-1} v_j, orthogonalized (modified Gram-Schmidt) */
+      fc3d_nsn_krylov_precondition(krylov, n, vj, z);
+      fc3d_AWpB_gemv(A, W, B, z, vj1);
+      for (unsigned int i = 0; i <= j; ++i)
+      {
+        hj[i] = cblas_ddot(n, vj1, 1, &V[i * n], 1);
+        cblas_daxpy(n, -hj[i], &V[i * n], 1, vj1, 1);
+      }
+      hj[j + 1] = cblas_dnrm2(n, vj1, 1);
+      if (hj[j + 1] > 0.)
+        cblas_dscal(n, 1. / hj[j + 1], vj1, 1);
+
+      /* QR factorization of H with Givens rotations */
+      for (unsigned int i = 0; i < j; ++i)
+      {
+        double t = cs[i] * hj[i] + sn[i] * hj[i + 1];
+        hj[i + 1] = -sn[i] * hj[i] + cs[i] * hj[i + 1];
+        hj[i] = t;
+      }
+      double r = hypot(hj[j], hj[j + 1]);
+      cs[j] = (r > 0.) ? hj[j] / r : 1.;
+      sn[j] = (r > 0.) ? hj[j + 1] / r : 0.;
+      hj[j] = r;
+      hj[j + 1] = 0.;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+
+      ++iter;
+      ++j;
+      *residual = fabs(g[j]);
+      if (*residual <= target || r == 0.)
+        break;
+    }
+
+    /* y <- H^{-1} g (stored in g), x <- x + P^{-1} V y */
+    for (int i = (int) j - 1; i >= 0; --i)
+    {
+      double s = g[i];
+      for (unsigned int k = i + 1; k < j; ++k)
+        s -= H[k * (m + 1) + i] * g[k];
+      g[i] = (H[i * (m + 1) + i] != 0.) ? s / H[i * (m + 1) + i] : 0.;
+    }
+    memset(w, 0, n * sizeof(double));
+    for (unsigned int i = 0; i < j; ++i)
+      cblas_daxpy(n, g[i], &V[i * n], 1, w, 1);
+    fc3d_nsn_krylov_precondition(krylov, n, w, z);
+    cblas_daxpy(n, 1., z, 1, x, 1);
+
+    /* restart with the true residual */
+    fc3d_AWpB_gemv(A, W, B, x, w);
+    cblas_dcopy(n, b, 1, V, 1);
+    cblas_daxpy(n, -1., w, 1, V, 1);
+    beta = cblas_dnrm2(n, V, 1);
+    *residual = beta;
+    if (j == 0)
+      break;
+  }
+
+  *iterations = iter;
+  return (*residual > target);
+}
+
+/* Eisenstat-Walker forcing term (choice 2, alpha = 2) */
+static double fc3d_nsn_krylov_forcing(double normF, double normF_previous,
+                                      double eta_previous,
+                                      double gamma, double eta_max)
+{
+  if (normF_previous <= 0.)
+    return eta_max;
+
+  double ratio = normF / normF_previous;
+  double eta = gamma * ratio * ratio;
+  double safeguard = gamma * eta_previous * eta_previous;
+  if (safeguard > 0.1 && safeguard > eta)
+    eta = safeguard;
+  return (eta < eta_max) ? eta : eta_max;
+}
+
 int globalLineSearchGP(
   fc3d_nonsmooth_Newton_solvers* equation,
   double *reaction,
@@ -271,7 +492,10 @@ int globalLineSearchGP(
   }
 
   //  tmp <- AWpB * direction
-  NM_gemv(1., AWpB, direction, 0., tmp);
+  if (AWpB)
+    NM_gemv(1., AWpB, direction, 0., tmp);
+  else
+    fc3d_AWpB_gemv(A, W, B, direction, tmp);
 
   double dqdt0 = cblas_ddot(problemSize, F, 1, tmp, 1);
 
@@ -580,14 +804,16 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
 
   void *buffer;
 
+  solver_options_workspace_reset(options);
   if (!options->dWork)
   {
-    buffer = calloc((11 * problemSize) , sizeof(double)); // F(1),
+    buffer = solver_options_workspace_alloc(options, (11 * problemSize) * sizeof(double)); // F(1),
                                                           // tmp1(1),
                                                           // tmp2(1),
                                                           // tmp3(1),
                                                           // A(3),
                                                           // B(3), rho
+    memset(buffer, 0, (11 * problemSize) * sizeof(double));
   }
   else
   {
@@ -601,58 +827,77 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
   double *Bx = Ax + _3problemSize;
   double *rho = Bx + _3problemSize;
 
-  NumericsMatrix *AWpB;
-  if (!options->dWork)
+  int krylov = (options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER] == SICONOS_FRICTION_3D_NSN_USE_KRYLOV);
+
+  NumericsMatrix *AWpB = NULL;
+  fc3d_nsn_krylov krylovSolver;
+  if (krylov)
   {
-    AWpB = NM_create(problem->M->storageType,
-        problem->M->size0, problem->M->size1);
+    /* AW+B is never assembled */
+    krylovSolver.maxiter = (options->iSize > SICONOS_FRICTION_3D_NSN_KRYLOV_MAXITER) ?
+      options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_MAXITER] : 200;
+    krylovSolver.restart = (options->iSize > SICONOS_FRICTION_3D_NSN_KRYLOV_RESTART) ?
+      options->iparam[SICONOS_FRICTION_3D_NSN_KRYLOV_RESTART] : 30;
+    if (krylovSolver.restart == 0)
+      krylovSolver.restart = 30;
+    if (krylovSolver.restart > problemSize)
+      krylovSolver.restart = problemSize;
+    fc3d_nsn_krylov_allocate(&krylovSolver, problemSize, options);
   }
   else
   {
-    AWpB = (NumericsMatrix*) (rho + problemSize);
-  }
+    if (!options->dWork)
+    {
+      AWpB = NM_create(problem->M->storageType,
+          problem->M->size0, problem->M->size1);
+    }
+    else
+    {
+      AWpB = (NumericsMatrix*) (rho + problemSize);
+    }
 
-  /* just for allocations */
-  NM_copy(problem->M, AWpB);
+    /* just for allocations */
+    NM_copy(problem->M, AWpB);
 
-  if (problem->M->storageType != NM_DENSE)
-  {
-    switch(options->iparam[13])
+    if (problem->M->storageType != NM_DENSE)
     {
-      case 0:
-        {
-          NSM_linearSolverParams(AWpB)->solver = NSM_CS_LUSOL;
-          break;
-        }
-      case 1:
-        {
-          NSM_linearSolverParams(AWpB)->solver = NSM_MUMPS;
+      switch(options->iparam[13])
+      {
+        case 0:
+          {
+            NSM_linearSolverParams(AWpB)->solver = NSM_CS_LUSOL;
+            break;
+          }
+        case 1:
+          {
+            NSM_linearSolverParams(AWpB)->solver = NSM_MUMPS;
 
 #ifdef HAVE_MPI
 
-          assert (options->solverData);
+            assert (options->solverData);
 
-          if ((MPI_Comm) options->solverData == MPI_COMM_NULL)
-          {
-            options->solverData = NM_MPI_com(MPI_COMM_NULL);
+            if ((MPI_Comm) options->solverData == MPI_COMM_NULL)
+            {
+              options->solverData = NM_MPI_com(MPI_COMM_NULL);
+            }
+            else
+            {
+              NM_MPI_com((MPI_Comm) options->solverData);
+            }
+
+#endif
+            break;
           }
-          else
+        default:
           {
-            NM_MPI_com((MPI_Comm) options->solverData);
+            numerics_error("fc3d_nonsmooth_Newton_solvers_solve", "Unknown linear solver.\n");
           }
-
-#endif
-          break;
-        }
-      default:
-        {
-          numerics_error("fc3d_nonsmooth_Newton_solvers_solve", "Unknown linear solver.\n");
-        }
+      }
     }
   }
 
   // compute rho here
-  FrictionContactProblem * localproblem =fc3d_local_problem_allocate(problem);
+  FrictionContactProblem * localproblem = fc3d_local_problem_workspace_allocate(problem, options);
   assert(options->dparam[SICONOS_FRICTION_3D_NSN_RHO]>0.0);
   for (int contact = 0; contact < problem->numberOfContacts; ++contact)
   {
@@ -694,6 +939,15 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
 
   double linear_solver_residual=0.0;
 
+  double eta_max = (options->dSize > SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_MAX) ?
+    options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_MAX] : 0.9;
+  double eta_gamma = (options->dSize > SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_GAMMA) ?
+    options->dparam[SICONOS_FRICTION_3D_NSN_KRYLOV_FORCING_GAMMA] : 0.9;
+  if (!(eta_max > 0.)) eta_max = 0.9;
+  if (!(eta_gamma > 0.)) eta_gamma = 0.9;
+  double eta = eta_max;
+  double normF_previous = 0.;
+
   while (iter++ < itermax)
   {
 
@@ -702,18 +956,34 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
                        reaction, velocity, equation->problem->mu,
                        rho,
                        F, Ax, Bx);
-    // AW + B
-    computeAWpB(Ax, problem->M, Bx, AWpB);
-
-    cblas_dcopy_msan(problemSize, F, 1, tmp1, 1);
-    cblas_dscal(problemSize, -1., tmp1, 1);
+    int lsi;
+    if (krylov)
+    {
+      /* Solve: AWpB X = -F, inexactly */
+      double normF = cblas_dnrm2(problemSize, F, 1);
+      eta = fc3d_nsn_krylov_forcing(normF, normF_previous, eta, eta_gamma, eta_max);
+      normF_previous = normF;
+
+      cblas_dcopy_msan(problemSize, F, 1, tmp2, 1);
+      cblas_dscal(problemSize, -1., tmp2, 1);
+      fc3d_nsn_krylov_preconditioner(&krylovSolver, Ax, problem->M, Bx);
+      unsigned int krylov_iter = 0;
+      lsi = fc3d_nsn_krylov_solve(&krylovSolver, Ax, problem->M, Bx, tmp2, tmp1,
+                                  eta, &linear_solver_residual, &krylov_iter);
+      numerics_printf_verbose(2, "fc3d_nonsmooth_Newton_solvers_solve: GMRES, %u iterations, forcing term = %g, residual = %g",
+                              krylov_iter, eta, linear_solver_residual);
+    }
+    else
+    {
+      // AW + B
+      computeAWpB(Ax, problem->M, Bx, AWpB);
 
-    /* Solve: AWpB X = -F */
-//    NM_copy(AWpB, AWpB_backup);
-    int lsi = NM_gesv(AWpB, tmp1, true);
+      cblas_dcopy_msan(problemSize, F, 1, tmp1, 1);
+      cblas_dscal(problemSize, -1., tmp1, 1);
 
-    /* NM_copy needed here */
-//    NM_copy(AWpB_backup, AWpB);
+      /* Solve: AWpB X = -F */
+      lsi = NM_gesv(AWpB, tmp1, true);
+    }
 
     if (lsi)
     {
@@ -724,7 +994,7 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
       }
     }
 
-    if (verbose > 0)
+    if (verbose > 0 && !krylov)
     {
       cblas_dcopy_msan(problemSize, F, 1, tmp3, 1);
       NM_gemv(1., AWpB, tmp1, 1., tmp3);
@@ -838,25 +1108,10 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
   }
 
   options->iparam[SICONOS_IPARAM_ITER_DONE] = iter;
-  if (problem->M->storageType == NM_SPARSE_BLOCK)
-  {
-    /* we release the pointer to avoid deallocation of the diagonal blocks of the original matrix of the problem*/
-    localproblem->M->matrix0 = NULL;
-  }
-  frictionContactProblem_free(localproblem);
-  
-  if (!options->dWork)
-  {
-    assert(buffer);
-    free(buffer);
-    options->dWork = NULL;
-  }
-  else
-  {
-    assert(buffer == options->dWork);
-  }
+  fc3d_local_problem_workspace_free(localproblem);
+  assert(buffer);
 
-  if (!options->dWork)
+  if (!options->dWork && AWpB)
   {
     NM_free(AWpB);
 
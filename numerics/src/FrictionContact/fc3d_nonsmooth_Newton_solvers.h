@@ -72,7 +72,10 @@ typedef struct
 /** Solve the equation. The only implemented method is a nonsmooth
     Newton method with a Goldstein Price or a FBLSA line search.
     Linear solver choice and line search are specified in
-    SolverOptions parameter.
+    SolverOptions parameter. With the SICONOS_FRICTION_3D_NSN_USE_KRYLOV
+    linear solver, AW+B is not assembled: the Newton direction is
+    computed by GMRES with a block Jacobi preconditioner, with an
+    Eisenstat-Walker forcing term.
     \param equation the nonsmooth equation.
     \param reaction the reaction guess as input and the solution as output.
     \param velocity the velocity guess as input and the solution as output.
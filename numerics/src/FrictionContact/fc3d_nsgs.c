@@ -17,6 +17,7 @@
 */
 #include "fc3d_onecontact_nonsmooth_Newton_solvers.h"
 #include "fc3d_Path.h"
+#include "fc3d_2NCP_Glocker.h"
 #include "fc3d_NCPGlockerFixedPoint.h"
 #include "fc3d_projection.h"
 #include "fc3d_unitary_enumerative.h"
@@ -35,12 +36,13 @@
 /* #define DEBUG_MESSAGES */
 #include "debug.h"
 #include "numerics_verbose.h"
+#include "tlsdef.h"
 
 
 //#define FCLIB_OUTPUT
 
 #ifdef FCLIB_OUTPUT
-static int fccounter = -1;
+static tlsvar int fccounter = -1;
 #include "fclib_interface.h"
 #endif
 
@@ -57,7 +59,7 @@ void fake_compute_error_nsgs(FrictionContactProblem* problem, double *reaction,
   double err = INFINITY;
   for (i = 0 ; i < m ; ++i)
   {
-    *error += Compute_NCP_error1(i, err);
+    *error += Compute_NCP_error1((NCPGlockerData*)options->internalSolvers->solverData, i, err);
   }
 }
 void fc3d_nsgs_update(int contact, FrictionContactProblem* problem, FrictionContactProblem* localproblem, double * reaction, SolverOptions* options)
@@ -289,7 +291,7 @@ unsigned int* allocShuffledContacts(FrictionContactProblem *problem,
     }
     else
       srand(1);
-    scontacts = (unsigned int *) malloc(nc * sizeof(unsigned int));
+    scontacts = (unsigned int *) solver_options_workspace_alloc(options, nc * sizeof(unsigned int));
     for (unsigned int i = 0; i < nc ; ++i)
     {
       scontacts[i] = i;
@@ -614,7 +616,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   assert(options->internalSolvers);
 
   /*****  Initialize various solver options *****/
-  localproblem = fc3d_local_problem_allocate(problem);
+  solver_options_workspace_reset(options);
+  localproblem = fc3d_local_problem_workspace_allocate(problem, options);
 
   fc3d_nsgs_initialize_local_solver(&local_solver, &update_localproblem,
                              (FreeSolverNSGSPtr *)&freeSolver, &computeError,
@@ -790,8 +793,7 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
 
   /** Free memory **/
   (*freeSolver)(problem,localproblem,localsolver_options);
-  fc3d_local_problem_free(localproblem, problem);
-  if (scontacts) free(scontacts);
+  fc3d_local_problem_workspace_free(localproblem);
 }
 
 int fc3d_nsgs_setDefaultSolverOptions(SolverOptions* options)
@@ -0,0 +1,629 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <assert.h>
+#include "SiconosConfig.h"
+#include "CSparseMatrix_internal.h"
+#include "fc3d_Solvers.h"
+#include "fc3d_local_problem_tools.h"
+#include "fc3d_compute_error.h"
+#include "NumericsMatrix.h"
+#include "NumericsMatrix_internal.h"
+#include "NumericsSparseMatrix.h"
+#include "SparseBlockMatrix.h"
+#include "SiconosBlas.h"
+#include "numerics_verbose.h"
+
+/* #define DEBUG_STDOUT */
+/* #define DEBUG_MESSAGES */
+#include "debug.h"
+
+const char* const   SICONOS_FRICTION_3D_NSGS_DDM_STR = "FC3D_NSGS_DDM";
+
+/* The contacts are split into one subdomain per process. The
+ * partition is computed in the same way by all the processes, from
+ * the problem data, which are known by all of them. */
+typedef struct
+{
+  unsigned int nc;
+  int nsub;
+  /* the contacts j != i such that the block (i, j) of M is not zero:
+   * adj[adjStart[i]] ... adj[adjStart[i+1]-1] */
+  unsigned int* adjStart;
+  unsigned int* adj;
+  /* estimated cost of the update of each contact */
+  double* weight;
+  /* the contacts of the subdomain s are order[start[s]] ...
+   * order[start[s+1]-1] */
+  unsigned int* order;
+  unsigned int* start;
+  int* subdomain;
+  /* the contacts of the subdomain s read by the other subdomains are
+   * interfaceContacts[interfaceStart[s]] ...
+   * interfaceContacts[interfaceStart[s+1]-1] */
+  unsigned int* interfaceContacts;
+  unsigned int* interfaceStart;
+  /* 1 for the contacts read by another subdomain */
+  char* shared;
+} fc3d_nsgs_ddm_partition;
+
+/* count the pair (i, j) in the first pass, store it in the second one */
+static void fc3d_nsgs_ddm_add_pair(fc3d_nsgs_ddm_partition* part, unsigned int* next,
+                                   unsigned int i, unsigned int j)
+{
+  if (next)
+    part->adj[next[i]++] = j;
+  else
+    part->adjStart[i + 1]++;
+}
+
+/* the contact graph, from the non zero blocks of M */
+static void fc3d_nsgs_ddm_graph(NumericsMatrix* M, fc3d_nsgs_ddm_partition* part,
+                                SolverOptions* options)
+{
+  unsigned int nc = part->nc;
+  unsigned int n = 3 * nc;
+  unsigned int* next = NULL;
+  unsigned int* mark = (unsigned int*) solver_options_workspace_alloc(options, nc * sizeof(unsigned int));
+  memset(part->adjStart, 0, (nc + 1) * sizeof(unsigned int));
+
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    switch (M->storageType)
+    {
+    case NM_SPARSE_BLOCK:
+    {
+      SparseBlockStructuredMatrix* B = M->matrix1;
+      for (unsigned int i = 0; i + 1 < B->filled1 && i < nc; ++i)
+      {
+        for (size_t p = B->index1_data[i]; p < B->index1_data[i + 1]; ++p)
+        {
+          if (B->index2_data[p] != i)
+            fc3d_nsgs_ddm_add_pair(part, next, i, (unsigned int) B->index2_data[p]);
+        }
+      }
+      break;
+    }
+    case NM_DENSE:
+    {
+      /* the block (i, j) is read column by column */
+      double* Mx = M->matrix0;
+      for (unsigned int j = 0; j < nc; ++j)
+      {
+        for (unsigned int i = 0; i < nc; ++i)
+        {
+          if (i == j)
+            continue;
+          int nonzero = 0;
+          for (unsigned int c = 3 * j; c < 3 * j + 3 && !nonzero; ++c)
+          {
+            double* col = &Mx[(size_t) c * n + 3 * i];
+            nonzero = col[0] != 0. || col[1] != 0. || col[2] != 0.;
+          }
+          if (nonzero)
+            fc3d_nsgs_ddm_add_pair(part, next, i, j);
+        }
+      }
+      break;
+    }
+    case NM_SPARSE:
+    {
+      CSparseMatrix* csc = NM_csc(M);
+      for (unsigned int i = 0; i < nc; ++i)
+        mark[i] = nc;
+      for (unsigned int j = 0; j < nc; ++j)
+      {
+        for (unsigned int c = 3 * j; c < 3 * j + 3; ++c)
+        {
+          for (CS_INT p = csc->p[c]; p < csc->p[c + 1]; ++p)
+          {
+            unsigned int i = (unsigned int) csc->i[p] / 3;
+            if (i != j && mark[i] != j)
+            {
+              mark[i] = j;
+              fc3d_nsgs_ddm_add_pair(part, next, i, j);
+            }
+          }
+        }
+      }
+      break;
+    }
+    default:
+      numerics_error("fc3d_nsgs_ddm", "unknown storage type for the matrix M");
+    }
+
+    if (pass == 0)
+    {
+      for (unsigned int i = 0; i < nc; ++i)
+        part->adjStart[i + 1] += part->adjStart[i];
+      part->adj = (unsigned int*) solver_options_workspace_alloc(options, (part->adjStart[nc] + 1) * sizeof(unsigned int));
+      /* the insertion points */
+      next = (unsigned int*) solver_options_workspace_alloc(options, nc * sizeof(unsigned int));
+      memcpy(next, part->adjStart, nc * sizeof(unsigned int));
+    }
+  }
+}
+
+static int fc3d_nsgs_ddm_compare(const void* a, const void* b)
+{
+  unsigned int i = *(const unsigned int*) a;
+  unsigned int j = *(const unsigned int*) b;
+  return (i > j) - (i < j);
+}
+
+/* Split the contacts into subdomains of equal weights. The contacts
+ * are ordered by a breadth first search of the contact graph, so that
+ * a subdomain is a set of neighbours and the interfaces are small. */
+static void fc3d_nsgs_ddm_split(fc3d_nsgs_ddm_partition* part)
+{
+  unsigned int nc = part->nc;
+  int nsub = part->nsub;
+  int* visited = part->subdomain;
+
+  for (unsigned int i = 0; i < nc; ++i)
+    visited[i] = -1;
+
+  unsigned int tail = 0;
+  for (unsigned int root = 0; root < nc; ++root)
+  {
+    if (visited[root] >= 0)
+      continue;
+    unsigned int head = tail;
+    part->order[tail++] = root;
+    visited[root] = 0;
+    while (head < tail)
+    {
+      unsigned int i = part->order[head++];
+      for (unsigned int p = part->adjStart[i]; p < part->adjStart[i + 1]; ++p)
+      {
+        unsigned int j = part->adj[p];
+        if (visited[j] < 0)
+        {
+          visited[j] = 0;
+          part->order[tail++] = j;
+        }
+      }
+    }
+  }
+  assert(tail == nc);
+
+  /* the contact goes to the subdomain of the middle of its weight */
+  double total = 0.;
+  for (unsigned int i = 0; i < nc; ++i)
+    total += part->weight[i];
+
+  double sum = 0.;
+  int s = 0;
+  part->start[0] = 0;
+  for (unsigned int k = 0; k < nc; ++k)
+  {
+    unsigned int i = part->order[k];
+    int si = total > 0. ? (int)((sum + 0.5 * part->weight[i]) * nsub / total) : 0;
+    if (si >= nsub)
+      si = nsub - 1;
+    while (s < si)
+      part->start[++s] = k;
+    part->subdomain[i] = s;
+    sum += part->weight[i];
+  }
+  while (s < nsub)
+    part->start[++s] = nc;
+
+  /* the contacts of a subdomain are swept in the order of the problem,
+   * a single subdomain is solved as by fc3d_nsgs */
+  for (s = 0; s < nsub; ++s)
+    qsort(&part->order[part->start[s]], part->start[s + 1] - part->start[s],
+          sizeof(unsigned int), fc3d_nsgs_ddm_compare);
+
+  /* the interface contacts, in the order of the subdomains: j is read
+   * by i when the block (i, j) of M is not zero */
+  for (unsigned int i = 0; i < nc; ++i)
+    part->shared[i] = 0;
+  for (unsigned int i = 0; i < nc; ++i)
+  {
+    for (unsigned int p = part->adjStart[i]; p < part->adjStart[i + 1]; ++p)
+    {
+      unsigned int j = part->adj[p];
+      if (part->subdomain[j] != part->subdomain[i])
+        part->shared[j] = 1;
+    }
+  }
+  unsigned int ni = 0;
+  for (s = 0; s < nsub; ++s)
+  {
+    part->interfaceStart[s] = ni;
+    for (unsigned int k = part->start[s]; k < part->start[s + 1]; ++k)
+    {
+      if (part->shared[part->order[k]])
+        part->interfaceContacts[ni++] = part->order[k];
+    }
+  }
+  part->interfaceStart[nsub] = ni;
+}
+
+#ifdef HAVE_MPI
+/* every process gets the reactions of the contacts list[listStart[s]]
+ * ... list[listStart[s+1]-1] from the process s */
+static void fc3d_nsgs_ddm_exchange(fc3d_nsgs_ddm_partition* part, MPI_Comm comm, int rank,
+                                   unsigned int* list, unsigned int* listStart,
+                                   double* values, double* buffer, int* counts, int* displs)
+{
+  for (int s = 0; s < part->nsub; ++s)
+  {
+    counts[s] = 3 * (int)(listStart[s + 1] - listStart[s]);
+    displs[s] = 3 * (int)listStart[s];
+  }
+  for (unsigned int k = listStart[rank]; k < listStart[rank + 1]; ++k)
+    memcpy(&buffer[3 * k], &values[3 * list[k]], 3 * sizeof(double));
+
+  MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DOUBLE, buffer, counts, displs, MPI_DOUBLE, comm);
+
+  for (int s = 0; s < part->nsub; ++s)
+  {
+    if (s == rank)
+      continue;
+    for (unsigned int k = listStart[s]; k < listStart[s + 1]; ++k)
+      memcpy(&values[3 * list[k]], &buffer[3 * k], 3 * sizeof(double));
+  }
+}
+#endif
+
+/* the velocity and the error of the contacts of a subdomain */
+static double fc3d_nsgs_ddm_local_error(FrictionContactProblem* problem, fc3d_nsgs_ddm_partition* part,
+                                        int rank, double* reaction, double* velocity)
+{
+  unsigned int n = 3 * part->nc;
+  double error = 0.;
+  double block[9];
+  double* b = block;
+  double worktmp[3];
+  for (unsigned int k = part->start[rank]; k < part->start[rank + 1]; ++k)
+  {
+    unsigned int i = part->order[k];
+    double* v = &velocity[3 * i];
+    double* r = &reaction[3 * i];
+    v[0] = problem->q[3 * i];
+    v[1] = problem->q[3 * i + 1];
+    v[2] = problem->q[3 * i + 2];
+    NM_row_prod_no_diag3(n, i, 3 * i, problem->M, reaction, v, false);
+    NM_copy_diag_block3(problem->M, i, &b);
+    v[0] += b[0] * r[0] + b[3] * r[1] + b[6] * r[2];
+    v[1] += b[1] * r[0] + b[4] * r[1] + b[7] * r[2];
+    v[2] += b[2] * r[0] + b[5] * r[1] + b[8] * r[2];
+    fc3d_unitary_compute_and_add_error(r, v, problem->mu[i], &error, worktmp);
+  }
+  return error;
+}
+
+void fc3d_nsgs_ddm(FrictionContactProblem* problem, double *reaction,
+                   double *velocity, int* info, SolverOptions* options)
+{
+  int* iparam = options->iparam;
+  double* dparam = options->dparam;
+
+  unsigned int nc = problem->numberOfContacts;
+  int itermax = iparam[SICONOS_IPARAM_MAX_ITER];
+  double tolerance = dparam[SICONOS_DPARAM_TOL];
+  double norm_q = cblas_dnrm2(nc*3 , problem->q , 1);
+  double omega = dparam[SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE];
+  double theta = dparam[SICONOS_FRICTION_3D_NSGS_DDM_INTERFACE_RELAXATION];
+  int sweeps = iparam[SICONOS_FRICTION_3D_NSGS_DDM_LOCAL_SWEEPS] > 0 ?
+    iparam[SICONOS_FRICTION_3D_NSGS_DDM_LOCAL_SWEEPS] : 1;
+  int repartition = iparam[SICONOS_FRICTION_3D_NSGS_DDM_REPARTITION_FREQUENCY];
+  int error_evaluation = iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION];
+
+  if (*info == 0)
+    return;
+
+  if (options->numberOfInternalSolvers < 1)
+  {
+    numerics_error("fc3d_nsgs_ddm",
+                   "The NSGS_DDM method needs options for the internal solvers, "
+                   "options[0].numberOfInternalSolvers should be >= 1");
+  }
+  assert(options->internalSolvers);
+
+  if (!(error_evaluation == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL
+        || error_evaluation == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT
+        || error_evaluation == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL))
+  {
+    numerics_error("fc3d_nsgs_ddm",
+                   "iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] must be equal to "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL (0), "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT (1) or "
+                   "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL (2)");
+  }
+
+  /* the processes: one subdomain each, a single subdomain without MPI */
+  int rank = 0;
+  int size = 1;
+#ifdef HAVE_MPI
+  MPI_Comm comm = MPI_COMM_NULL;
+  if (iparam[SICONOS_FRICTION_3D_NSGS_DDM_MPI_COM] != -1)
+  {
+    comm = MPI_Comm_f2c(iparam[SICONOS_FRICTION_3D_NSGS_DDM_MPI_COM]);
+  }
+  else
+  {
+    /* MPI_COMM_WORLD, MPI is initialized if needed */
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    comm = initialized ? MPI_COMM_WORLD : NM_MPI_com(MPI_COMM_NULL);
+  }
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+#else
+  if (iparam[SICONOS_FRICTION_3D_NSGS_DDM_MPI_COM] != -1)
+    numerics_warning("fc3d_nsgs_ddm", "MPI is not available, the problem is solved on a single subdomain");
+#endif
+
+  solver_options_workspace_reset(options);
+
+  fc3d_nsgs_ddm_partition part;
+  part.nc = nc;
+  part.nsub = size;
+  part.adjStart = (unsigned int*) solver_options_workspace_alloc(options, (nc + 1) * sizeof(unsigned int));
+  part.weight = (double*) solver_options_workspace_alloc(options, nc * sizeof(double));
+  part.order = (unsigned int*) solver_options_workspace_alloc(options, nc * sizeof(unsigned int));
+  part.start = (unsigned int*) solver_options_workspace_alloc(options, (size + 1) * sizeof(unsigned int));
+  part.subdomain = (int*) solver_options_workspace_alloc(options, nc * sizeof(int));
+  part.interfaceContacts = (unsigned int*) solver_options_workspace_alloc(options, nc * sizeof(unsigned int));
+  part.interfaceStart = (unsigned int*) solver_options_workspace_alloc(options, (size + 1) * sizeof(unsigned int));
+  part.shared = (char*) solver_options_workspace_alloc(options, nc * sizeof(char));
+  fc3d_nsgs_ddm_graph(problem->M, &part, options);
+
+  /* the first partition balances the number of blocks */
+  for (unsigned int i = 0; i < nc; ++i)
+    part.weight[i] = 1. + part.adjStart[i + 1] - part.adjStart[i];
+  fc3d_nsgs_ddm_split(&part);
+
+  /* the local solver iterations of the contacts, for the next partitions */
+  double* cost = (double*) solver_options_workspace_alloc(options, nc * sizeof(double));
+  memset(cost, 0, nc * sizeof(double));
+
+#ifdef HAVE_MPI
+  double* buffer = NULL;
+  int* counts = NULL;
+  int* displs = NULL;
+  if (size > 1)
+  {
+    buffer = (double*) solver_options_workspace_alloc(options, 3 * nc * sizeof(double));
+    counts = (int*) solver_options_workspace_alloc(options, size * sizeof(int));
+    displs = (int*) solver_options_workspace_alloc(options, size * sizeof(int));
+  }
+#endif
+
+  numerics_printf_verbose(1, "---- FC3D - NSGS_DDM - %i contacts on %i subdomains, %i on this one, %i on its interface",
+                          nc, size, part.start[rank + 1] - part.start[rank],
+                          part.interfaceStart[rank + 1] - part.interfaceStart[rank]);
+
+  SolverOptions * localsolver_options = options->internalSolvers;
+  SolverPtr local_solver = NULL;
+  UpdatePtr update_localproblem = NULL;
+  FreeSolverNSGSPtr freeSolver = NULL;
+  ComputeErrorPtr computeError = NULL;
+
+  FrictionContactProblem* localproblem = fc3d_local_problem_workspace_allocate(problem, options);
+  fc3d_nsgs_initialize_local_solver(&local_solver, &update_localproblem,
+                                    (FreeSolverNSGSPtr *)&freeSolver, &computeError,
+                                    problem, localproblem, options);
+
+  int iter = 0;
+  int sinceRepartition = 0;
+  double error = 1.;
+  int hasNotConverged = 1;
+  double localreaction[3];
+
+  while ((iter < itermax) && (hasNotConverged > 0))
+  {
+    ++iter;
+    ++sinceRepartition;
+    fc3d_set_internalsolver_tolerance(problem, options, &localsolver_options[0], error);
+
+    /* Gauss-Seidel sweeps over the subdomain, the reactions of the
+     * other subdomains are the ones of the last exchange */
+    double sums[2] = {0., 0.};
+    for (int sweep = 0; sweep < sweeps; ++sweep)
+    {
+      for (unsigned int k = part.start[rank]; k < part.start[rank + 1]; ++k)
+      {
+        unsigned int contact = part.order[k];
+        double* r = &reaction[3 * contact];
+
+        (*update_localproblem)(contact, problem, localproblem, reaction, localsolver_options);
+        localsolver_options->iparam[SICONOS_FRICTION_3D_NSGS_LOCALSOLVER_CONTACTNUMBER] = contact;
+        localreaction[0] = r[0];
+        localreaction[1] = r[1];
+        localreaction[2] = r[2];
+        (*local_solver)(localproblem, localreaction, localsolver_options);
+        cost[contact] += localsolver_options->iparam[SICONOS_IPARAM_ITER_DONE];
+
+        if (iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] == SICONOS_FRICTION_3D_NSGS_RELAXATION_TRUE)
+        {
+          localreaction[0] = omega * localreaction[0] + (1.0 - omega) * r[0];
+          localreaction[1] = omega * localreaction[1] + (1.0 - omega) * r[1];
+          localreaction[2] = omega * localreaction[2] + (1.0 - omega) * r[2];
+        }
+
+        /* the neighbours of the other subdomains are updated at the
+         * same time: the interface contacts are under-relaxed */
+        if (part.shared[contact])
+        {
+          localreaction[0] = theta * localreaction[0] + (1.0 - theta) * r[0];
+          localreaction[1] = theta * localreaction[1] + (1.0 - theta) * r[1];
+          localreaction[2] = theta * localreaction[2] + (1.0 - theta) * r[2];
+        }
+
+        sums[0] += (r[0] - localreaction[0]) * (r[0] - localreaction[0])
+          + (r[1] - localreaction[1]) * (r[1] - localreaction[1])
+          + (r[2] - localreaction[2]) * (r[2] - localreaction[2]);
+
+        if (iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] == SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE
+            && (isnan(localsolver_options->dparam[SICONOS_DPARAM_RESIDU])
+                || isinf(localsolver_options->dparam[SICONOS_DPARAM_RESIDU])
+                || localsolver_options->dparam[SICONOS_DPARAM_RESIDU] > 1.0))
+        {
+          numerics_printf_verbose(1, "Discard local reaction for contact %i at iteration %i "
+                                  "with local_error = %e", contact, iter,
+                                  localsolver_options->dparam[SICONOS_DPARAM_RESIDU]);
+        }
+        else
+          memcpy(r, localreaction, 3 * sizeof(double));
+      }
+    }
+
+    for (unsigned int k = part.start[rank]; k < part.start[rank + 1]; ++k)
+    {
+      double* r = &reaction[3 * part.order[k]];
+      sums[1] += r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+    }
+
+#ifdef HAVE_MPI
+    if (size > 1)
+    {
+      /* the interface reactions, for the next sweeps */
+      fc3d_nsgs_ddm_exchange(&part, comm, rank, part.interfaceContacts, part.interfaceStart,
+                             reaction, buffer, counts, displs);
+      MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, comm);
+    }
+#endif
+
+    if (error_evaluation == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL)
+    {
+      error = fc3d_nsgs_ddm_local_error(problem, &part, rank, reaction, velocity);
+#ifdef HAVE_MPI
+      if (size > 1)
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_DOUBLE, MPI_SUM, comm);
+#endif
+      error = sqrt(error);
+      if (fabs(norm_q) > DBL_EPSILON)
+        error /= norm_q;
+      hasNotConverged = error > tolerance;
+    }
+    else
+    {
+      error = sqrt(sums[0]);
+      if (fabs(sqrt(sums[1])) > DBL_EPSILON)
+        error /= sqrt(sums[1]);
+      hasNotConverged = error > tolerance;
+
+      if (!hasNotConverged
+          && error_evaluation == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
+      {
+        double absolute_error = fc3d_nsgs_ddm_local_error(problem, &part, rank, reaction, velocity);
+#ifdef HAVE_MPI
+        if (size > 1)
+          MPI_Allreduce(MPI_IN_PLACE, &absolute_error, 1, MPI_DOUBLE, MPI_SUM, comm);
+#endif
+        absolute_error = sqrt(absolute_error);
+        if (fabs(norm_q) > DBL_EPSILON)
+          absolute_error /= norm_q;
+        if (absolute_error > dparam[SICONOS_DPARAM_TOL])
+        {
+          /* the incremental tolerance is too large for the required
+           * accuracy */
+          tolerance = error / absolute_error * dparam[SICONOS_DPARAM_TOL];
+          numerics_printf_verbose(1, "---- FC3D - NSGS_DDM - We modify the required incremental precision to reach accuracy to %e", tolerance);
+          hasNotConverged = 1;
+        }
+        else
+          error = absolute_error;
+      }
+    }
+    numerics_printf_verbose(1, "---- FC3D - NSGS_DDM - Iteration %i Residual = %14.7e", iter, error);
+
+    if (options->callback)
+    {
+      options->callback->collectStatsIteration(options->callback->env, nc * 3,
+                                               reaction, velocity, error, NULL);
+    }
+
+    /* new subdomains, balanced with the work measured since the last
+     * partition */
+    if (size > 1 && hasNotConverged && repartition > 0 && iter % repartition == 0)
+    {
+#ifdef HAVE_MPI
+      fc3d_nsgs_ddm_exchange(&part, comm, rank, part.order, part.start,
+                             reaction, buffer, counts, displs);
+      MPI_Allreduce(MPI_IN_PLACE, cost, nc, MPI_DOUBLE, MPI_SUM, comm);
+#endif
+      for (unsigned int i = 0; i < nc; ++i)
+      {
+        part.weight[i] = 1. + part.adjStart[i + 1] - part.adjStart[i] + cost[i] / sinceRepartition;
+        cost[i] = 0.;
+      }
+      sinceRepartition = 0;
+      fc3d_nsgs_ddm_split(&part);
+      numerics_printf_verbose(1, "---- FC3D - NSGS_DDM - Iteration %i, %i contacts on this subdomain",
+                              iter, part.start[rank + 1] - part.start[rank]);
+    }
+  }
+
+  /* the velocities of the subdomain, then the whole solution on all
+   * the processes */
+  if (error_evaluation != SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL)
+  {
+    double absolute_error = fc3d_nsgs_ddm_local_error(problem, &part, rank, reaction, velocity);
+    if (error_evaluation == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
+    {
+#ifdef HAVE_MPI
+      if (size > 1)
+        MPI_Allreduce(MPI_IN_PLACE, &absolute_error, 1, MPI_DOUBLE, MPI_SUM, comm);
+#endif
+      error = sqrt(absolute_error);
+      if (fabs(norm_q) > DBL_EPSILON)
+        error /= norm_q;
+      hasNotConverged = error > dparam[SICONOS_DPARAM_TOL];
+    }
+  }
+#ifdef HAVE_MPI
+  if (size > 1)
+  {
+    fc3d_nsgs_ddm_exchange(&part, comm, rank, part.order, part.start,
+                           reaction, buffer, counts, displs);
+    fc3d_nsgs_ddm_exchange(&part, comm, rank, part.order, part.start,
+                           velocity, buffer, counts, displs);
+  }
+#endif
+
+  *info = hasNotConverged;
+  dparam[SICONOS_DPARAM_RESIDU] = error;
+  iparam[SICONOS_IPARAM_ITER_DONE] = iter;
+
+  (*freeSolver)(problem, localproblem, localsolver_options);
+  fc3d_local_problem_workspace_free(localproblem);
+}
+
+int fc3d_nsgs_ddm_setDefaultSolverOptions(SolverOptions* options)
+{
+  numerics_printf_verbose(1,"fc3d_nsgs_ddm_setDefaultSolverOptions\n");
+
+  fc3d_nsgs_setDefaultSolverOptions(options);
+  options->solverId = SICONOS_FRICTION_3D_NSGS_DDM;
+
+  options->iparam[SICONOS_FRICTION_3D_NSGS_DDM_LOCAL_SWEEPS] = 1;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_DDM_REPARTITION_FREQUENCY] = 0;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_DDM_MPI_COM] = -1;
+  options->dparam[SICONOS_FRICTION_3D_NSGS_DDM_INTERFACE_RELAXATION] = 0.8;
+
+  return 0;
+}
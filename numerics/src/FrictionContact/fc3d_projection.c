@@ -250,14 +250,9 @@ int fc3d_projectionWithDiagonalization_solve(FrictionContactProblem* localproble
 void fc3d_projectionOnConeWithLocalIteration_initialize(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions* localsolver_options )
 {
   int nc = problem->numberOfContacts;
-  /* printf("fc3d_projectionOnConeWithLocalIteration_initialize. Allocation of dwork\n"); */
-  if (!localsolver_options->dWork
-      || localsolver_options->dWorkSize < nc)
-  {
-    localsolver_options->dWork = (double *)realloc(localsolver_options->dWork,
-                                                   nc * sizeof(double));
-    localsolver_options->dWorkSize = nc ;
-  }
+  /* the rho of each contact is kept in the workspace from one call to the next */
+  solver_options_workspace_reset(localsolver_options);
+  solver_options_workspace_set_dWork(localsolver_options, nc);
   for (int i = 0; i < nc; i++)
   {
     localsolver_options->dWork[i]=1.0;
@@ -266,8 +261,9 @@ void fc3d_projectionOnConeWithLocalIteration_initialize(FrictionContactProblem *
 
 void fc3d_projectionOnConeWithLocalIteration_free(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions* localsolver_options )
 {
-  free(localsolver_options->dWork);
-  localsolver_options->dWork=NULL;
+  /* dWork is in the workspace */
+  localsolver_options->dWork = NULL;
+  localsolver_options->dWorkSize = 0;
 }
 
 int fc3d_projectionOnConeWithLocalIteration_solve(FrictionContactProblem* localproblem, double* reaction, SolverOptions* options)
@@ -523,8 +519,7 @@ void fc3d_projection_free(FrictionContactProblem * problem, FrictionContactProbl
 
 void fc3d_projection_with_regularization_free(FrictionContactProblem * problem, FrictionContactProblem * localproblem, SolverOptions* localsolver_options )
 {
-  free(localproblem->M->matrix0);
-  localproblem->M->matrix0 = NULL;
+  /* matrix0 belongs to the local problem, see fc3d_local_problem_workspace_allocate */
 }
 
 
@@ -626,11 +621,7 @@ void fc3d_projectionOnCylinderWithLocalIteration_initialize(
 {
   int nc = problem->numberOfContacts;
   /* printf("fc3d_projectionOnConeWithLocalIteration_initialize. Allocation of dwork\n"); */
-  if(localproblem->mu)
-  {
-    free(localproblem->mu);
-  }
-
+  /* the local problem uses the dWork of the NSGS options as mu */
   localproblem->mu = options->dWork;
 
   if (!localsolver_options->dWork)
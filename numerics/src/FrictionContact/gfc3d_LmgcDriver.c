@@ -20,9 +20,10 @@
 /* #define DEBUG_MESSAGES */
 /* #define DEBUG_STDOUT */
 #include "debug.h"
+#include "tlsdef.h"
 
 #ifdef WITH_FCLIB
-static int gfccounter =-1;
+static tlsvar int gfccounter =-1;
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -23,6 +23,7 @@
 #include "SiconosLapack.h"
 #include "SparseBlockMatrix.h"
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include <math.h>
 #include "sanitizer.h"
@@ -48,48 +49,39 @@ typedef struct {
 
 
 
+static double * gfc3d_ADMM_zeros(SolverOptions* options, int size)
+{
+  double * v = (double*)solver_options_workspace_alloc(options, size * sizeof(double));
+  memset(v, 0, size * sizeof(double));
+  return v;
+}
+
+/* the work vectors are taken from the workspace of the options, which
+ * is kept from one call to the next */
 void gfc3d_ADMM_init(GlobalFrictionContactProblem* problem, SolverOptions* options)
 {
   int nc = problem->numberOfContacts;
   int n = problem->M->size0;
   int m = 3 * nc;
-  if (!options->dWork || options->dWorkSize != m+n)
-  {
-    options->dWork = (double*)calloc(m+n,sizeof(double));
-    options->dWorkSize = m+n;
-  }
-  if  (options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_ACCELERATION] == SICONOS_FRICTION_3D_ADMM_ACCELERATION ||
-       options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_ACCELERATION] == SICONOS_FRICTION_3D_ADMM_ACCELERATION_AND_RESTART )
-  {
-    options->solverData=(Gfc3d_ADDM_data *)malloc(sizeof(Gfc3d_ADDM_data));
-    Gfc3d_ADDM_data * data = (Gfc3d_ADDM_data *)options->solverData;
-    data->reaction_hat =  (double*)calloc(m,sizeof(double));
-    data->reaction_k =  (double*)calloc(m,sizeof(double));
-    data->u_hat =  (double*)calloc(m,sizeof(double));
-    data->u_k =  (double*)calloc(m,sizeof(double));
-    data->u =  (double*)calloc(m,sizeof(double));
-    data->b =  (double*)calloc(m,sizeof(double));
-  }
+  solver_options_workspace_reset(options);
+  memset(solver_options_workspace_set_dWork(options, m+n), 0, (m+n) * sizeof(double));
+
+  Gfc3d_ADDM_data * data =
+    (Gfc3d_ADDM_data *)solver_options_workspace_alloc(options, sizeof(Gfc3d_ADDM_data));
+  data->reaction_hat = gfc3d_ADMM_zeros(options, m);
+  data->reaction_k = gfc3d_ADMM_zeros(options, m);
+  data->u_hat = gfc3d_ADMM_zeros(options, m);
+  data->u_k = gfc3d_ADMM_zeros(options, m);
+  data->u = gfc3d_ADMM_zeros(options, m);
+  data->b = gfc3d_ADMM_zeros(options, m);
+  options->solverData = data;
 }
 void gfc3d_ADMM_free(GlobalFrictionContactProblem* problem, SolverOptions* options)
 {
-  if (options->dWork)
-  {
-    free(options->dWork);
-    options->dWork=NULL;
-    options->dWorkSize = 0;
-  }
-  if (options->solverData)
-  {
-    Gfc3d_ADDM_data * data = (Gfc3d_ADDM_data *)options->solverData;
-    free(data->reaction_hat);
-    free(data->u_hat);
-    free(data->reaction_k);
-    free(data->u_k);
-    free(data->b);
-    free(data);
-  }
-
+  /* everything is in the workspace */
+  options->dWork = NULL;
+  options->dWorkSize = 0;
+  options->solverData = NULL;
 }
 static double gfc3d_admm_select_rho(NumericsMatrix* M, NumericsMatrix* H, int * is_rho_variable, SolverOptions* restrict options)
 {
@@ -200,7 +192,7 @@ void gfc3d_ADMM(GlobalFrictionContactProblem* restrict problem, double* restrict
 
 
   int internal_allocation=0;
-  if (!options->dWork || options->dWorkSize != 2*m+n)
+  if (!options->solverData)
   {
     gfc3d_ADMM_init(problem, options);
     internal_allocation = 1;
@@ -65,11 +65,8 @@ int gfc3d_compute_error(GlobalFrictionContactProblem* problem,
   NumericsMatrix *H = problem->H;
   NumericsMatrix *M = problem->M;
 
-  if (!options->dWork)
-  {
-    options->dWork = (double *)calloc(n,sizeof(double));
-  }
-  double* tmp = options->dWork;
+  size_t mark = solver_options_workspace_mark(options);
+  double* tmp = (double *)solver_options_workspace_alloc(options, n * sizeof(double));
 
   
 
@@ -83,6 +80,7 @@ int gfc3d_compute_error(GlobalFrictionContactProblem* problem,
   NM_gemv(-1.0, M, globalVelocity, 1.0, tmp);
   *error = cblas_dnrm2(n,tmp,1);
   *error = *error * *error;
+  solver_options_workspace_release(options, mark);
   DEBUG_PRINTF("square norm of -M v + H R + q = %e\n", *error);
   
   /* CHECK_RETURN(!NM_gesv_expert(problem->M, globalVelocity, NM_KEEP_FACTORS)); */
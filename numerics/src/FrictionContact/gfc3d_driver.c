@@ -36,9 +36,6 @@
 #include "NumericsVector.h"
 #include "NumericsMatrix.h"
 #endif
-int * Global_ipiv = NULL;
-int  Global_MisInverse = 0;
-int  Global_MisLU = 0;
 
 const char* const SICONOS_GLOBAL_FRICTION_3D_NSGS_WR_STR = "GFC3D_NSGS_WR";
 const char* const SICONOS_GLOBAL_FRICTION_3D_NSN_AC_WR_STR = "GFC3D_NSN_AC_WR";
@@ -81,9 +78,6 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call NSGS_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_nsgs_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
 
@@ -92,9 +86,6 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call NSGSV_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_nsgs_velocity_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
   }
@@ -102,9 +93,6 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call NSN_AC_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_nonsmooth_Newton_AlartCurnier_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
 
@@ -113,9 +101,6 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call PROX_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_proximal_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
 
@@ -124,9 +109,6 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call DSFP_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_DeSaxceFixedPoint_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
 
@@ -135,18 +117,12 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call TFP_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_TrescaFixedPoint_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
 
   }
   case SICONOS_GLOBAL_FRICTION_3D_NSGS:
   {
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_nsgs(problem, reaction , velocity, globalVelocity,
                &info , options);
     break;
@@ -203,9 +179,6 @@ int gfc3d_driver(GlobalFrictionContactProblem* problem, double *reaction , doubl
   {
 
     numerics_printf_verbose(1," ========================== Call NSGS_WR solver with reformulation into Friction-Contact 3D problem ==========================\n");
-    Global_ipiv = NULL;
-    Global_MisInverse = 0;
-    Global_MisLU = 0;
     gfc3d_admm_wr(problem, reaction , velocity, globalVelocity, &info, options);
     break;
 
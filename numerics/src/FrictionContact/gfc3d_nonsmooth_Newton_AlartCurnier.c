@@ -46,6 +46,7 @@
 #include "SiconosBlas.h"
 #include "NumericsMatrix.h"
 #include "NumericsSparseMatrix.h"
+#include "NumericsMatrix_internal.h"
 #include "NumericsVector.h"
 #include "cond.h"
 
@@ -260,10 +261,312 @@ void init3x3DiagBlocks(int nc, double* P, CSparseMatrix* R)
   }
 }
 
+/* data kept from one call to the next when MUMPS is the linear
+ * solver: the jacobian, owner of the MUMPS instance (its analysis is
+ * reused as long as the sparsity pattern does not change), and the
+ * share of the problem assembled by this process. Without the
+ * distributed mode, the process holds everything. */
+typedef struct
+{
+  NumericsMatrix* J;
+  int distributed;
+  int rank;
+  int size;
+  /* contacts c0 to c1 - 1, rows r0 to r1 - 1 of M */
+  unsigned int c0;
+  unsigned int c1;
+  unsigned int r0;
+  unsigned int r1;
+  /* rows r0 to r1 - 1 of -M and H, rows of H^T of the contacts, in
+   * compressed columns with the global sizes */
+  CSparseMatrix* Mr;
+  CSparseMatrix* Hr;
+  CSparseMatrix* Htr;
+} GlobalAlartCurnierData;
+
+void gfc3d_nonsmooth_Newton_AlartCurnier_free(SolverOptions* options)
+{
+  GlobalAlartCurnierData* data = (GlobalAlartCurnierData*) options->solverData;
+  if(data)
+  {
+    /* with MUMPS, the end of the instance is collective */
+    NM_free(data->J);
+    free(data->J);
+    cs_spfree(data->Mr);
+    cs_spfree(data->Hr);
+    cs_spfree(data->Htr);
+    free(data);
+    options->solverData = NULL;
+  }
+}
+
+#ifdef WITH_MUMPS
+/* entries of alpha T, or alpha T^T if transpose, on the rows i0 to
+ * i1 - 1 */
+static CSparseMatrix* triplet_rows(CSparseMatrix* T, int transpose, double alpha,
+                                   CS_INT i0, CS_INT i1)
+{
+  CSparseMatrix* R = cs_spalloc(transpose ? T->n : T->m,
+                                transpose ? T->m : T->n,
+                                T->nz + 1, 1, 1);
+  for(CS_INT e = 0; e < T->nz; ++e)
+  {
+    CS_INT i = transpose ? T->p[e] : T->i[e];
+    CS_INT j = transpose ? T->i[e] : T->p[e];
+    if(i >= i0 && i < i1)
+      CHECK_RETURN(cs_entry(R, i, j, alpha * T->x[e]));
+  }
+  CSparseMatrix* C = cs_compress(R);
+  cs_spfree(R);
+  return C;
+}
+
+/* get or create the data, share the problem among the processes */
+static GlobalAlartCurnierData* gfc3d_AC_data(
+  GlobalFrictionContactProblem* problem,
+  SolverOptions* options,
+  unsigned int problem_size)
+{
+  GlobalAlartCurnierData* data = (GlobalAlartCurnierData*) options->solverData;
+  int distributed = options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER]
+    == SICONOS_FRICTION_3D_NSN_USE_MUMPS_DISTRIBUTED;
+
+  if(data && (data->J->size0 != (int)problem_size || data->distributed != distributed))
+  {
+    gfc3d_nonsmooth_Newton_AlartCurnier_free(options);
+    data = NULL;
+  }
+
+  if(!data)
+  {
+    data = (GlobalAlartCurnierData*) calloc(1, sizeof(GlobalAlartCurnierData));
+    data->distributed = distributed;
+    data->rank = 0;
+    data->size = 1;
+
+    NumericsSparseMatrix* SM = NSM_new();
+    SM->triplet = cs_spalloc(problem_size, problem_size, 1, 1, 1);
+    data->J = NM_create_from_data(NM_SPARSE, (int)problem_size, (int)problem_size, SM);
+    NSM_linearSolverParams(data->J)->solver = NSM_MUMPS;
+
+#ifdef HAVE_MPI
+    if(options->iparam[SICONOS_FRICTION_3D_NSN_MPI_COM] != -1)
+    {
+      NM_MPI_com(MPI_Comm_f2c(options->iparam[SICONOS_FRICTION_3D_NSN_MPI_COM]));
+    }
+    if(distributed)
+    {
+      MPI_Comm comm = NM_MPI_com(MPI_COMM_NULL);
+      CHECK_MPI(MPI_Comm_rank(comm, &data->rank));
+      CHECK_MPI(MPI_Comm_size(comm, &data->size));
+    }
+#else
+    if(distributed)
+    {
+      numerics_error("gfc3d_nonsmooth_Newton_AlartCurnier",
+                     "the distributed linear solver needs MPI.\n");
+    }
+#endif
+    options->solverData = data;
+  }
+
+  /* contiguous shares of the contacts and of the rows of M */
+  unsigned int nc = (unsigned int) problem->numberOfContacts;
+  unsigned int n = (unsigned int) problem->M->size0;
+  data->c0 = (unsigned int)(((size_t) data->rank * nc) / data->size);
+  data->c1 = (unsigned int)(((size_t)(data->rank + 1) * nc) / data->size);
+  data->r0 = (unsigned int)(((size_t) data->rank * n) / data->size);
+  data->r1 = (unsigned int)(((size_t)(data->rank + 1) * n) / data->size);
+
+  cs_spfree(data->Mr);
+  cs_spfree(data->Hr);
+  cs_spfree(data->Htr);
+  data->Mr = NULL;
+  data->Hr = NULL;
+  data->Htr = NULL;
+  if(distributed)
+  {
+    data->Mr = triplet_rows(NM_triplet(problem->M), 0, -1., data->r0, data->r1);
+    data->Hr = triplet_rows(NM_triplet(problem->H), 0, 1., data->r0, data->r1);
+    data->Htr = triplet_rows(NM_triplet(problem->H), 1, 1., 3 * data->c0, 3 * data->c1);
+  }
+
+  return data;
+}
+#endif
+
+/* psi on the rows of this process, summed over the processes */
+static void ACPsiPart(
+  GlobalFrictionContactProblem* problem,
+  GlobalAlartCurnierData* data,
+  AlartCurnierFun3x3Ptr computeACFun3x3,
+  double *globalVelocity,
+  double *reaction,
+  double *velocity,
+  double *rho,
+  double *psi)
+{
+  unsigned int m = problem->H->size1;
+  unsigned int n = problem->M->size0;
+  unsigned int problem_size = n + 2 * m;
+  unsigned int r0 = data->r0, r1 = data->r1;
+  unsigned int k0 = 3 * data->c0, k1 = 3 * data->c1;
+
+  cblas_dscal(problem_size, 0., psi, 1);
+
+  /* -M * globalVelocity + H * reaction + q */
+  cblas_dcopy(r1 - r0, problem->q + r0, 1, psi + r0, 1);
+  cs_gaxpy(data->Hr, reaction, psi);
+  cs_gaxpy(data->Mr, globalVelocity, psi);
+
+  /* -velocity + trans(H) * globalVelocity + b */
+  cblas_daxpy(k1 - k0, -1., velocity + k0, 1, psi + n + k0, 1);
+  cblas_daxpy(k1 - k0, 1., problem->b + k0, 1, psi + n + k0, 1);
+  cs_gaxpy(data->Htr, globalVelocity, psi + n);
+
+  /* AC function */
+  fc3d_AlartCurnierFunction(k1 - k0,
+                            computeACFun3x3,
+                            reaction + k0,
+                            velocity + k0, problem->mu + data->c0, rho + k0,
+                            psi + n + m + k0,
+                            NULL, NULL);
+
+#if defined(WITH_MUMPS) && defined(HAVE_MPI)
+  CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, psi, problem_size, MPI_DOUBLE, MPI_SUM,
+                          NM_MPI_com(MPI_COMM_NULL)));
+#endif
+}
+
+static void gfc3d_AC_psi(
+  GlobalFrictionContactProblem* problem,
+  GlobalAlartCurnierData* data,
+  AlartCurnierFun3x3Ptr computeACFun3x3,
+  double *globalVelocity,
+  double *reaction,
+  double *velocity,
+  double *rho,
+  double *psi)
+{
+  if(data && data->distributed)
+    ACPsiPart(problem, data, computeACFun3x3, globalVelocity, reaction, velocity, rho, psi);
+  else
+    ACPsi(problem, computeACFun3x3, globalVelocity, reaction, velocity, rho, psi);
+}
+
+/* y = J x, J holding the rows of this process */
+static void gfc3d_AC_jacobian_gemv(
+  GlobalAlartCurnierData* data,
+  CSparseMatrix* J,
+  unsigned int size,
+  double* x,
+  double* y)
+{
+  cblas_dscal(size, 0., y, 1);
+  cs_gaxpy(J, x, y);
+#if defined(WITH_MUMPS) && defined(HAVE_MPI)
+  if(data && data->distributed)
+  {
+    CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, y, size, MPI_DOUBLE, MPI_SUM,
+                            NM_MPI_com(MPI_COMM_NULL)));
+  }
+#endif
+}
+
+/* init the rows r0 to r1 - 1 (rows of M) and the rows of the contact
+ * components k0 to k1 - 1 of the jacobian, but A and B */
+CS_INT initACPsiJacobianPart(
+  CSparseMatrix* M,
+  CSparseMatrix* H,
+  CSparseMatrix *J,
+  double rescaling,
+  CS_INT r0, CS_INT r1,
+  CS_INT k0, CS_INT k1)
+{
+  CS_INT m = H->n;
+
+  J->nz = 0;
+
+  /* - M */
+  for(CS_INT e = 0; e < M->nz; ++e)
+  {
+    if(M->i[e] >= r0 && M->i[e] < r1)
+      CHECK_RETURN(CSparseMatrix_zentry(J, M->i[e], M->p[e], - M->x[e]));
+  }
+
+  /* H */
+  for(CS_INT e = 0; e < H->nz; ++e)
+  {
+    if(H->i[e] >= r0 && H->i[e] < r1)
+      CHECK_RETURN(CSparseMatrix_zentry(J, H->i[e], H->p[e] + M->n + m, rescaling*H->x[e]));
+  }
+
+  /* Ht */
+  for(CS_INT e = 0; e < H->nz; ++e)
+  {
+    if(H->p[e] >= k0 && H->p[e] < k1)
+      CHECK_RETURN(CSparseMatrix_zentry(J, H->p[e] + M->m, H->i[e], H->x[e]));
+  }
+
+  /* -I */
+  for(CS_INT e = k0; e < k1; ++e)
+  {
+    CHECK_RETURN(CSparseMatrix_zentry(J, e + M->m, e + M->n, -1.));
+  }
+
+  return J->nz;
+}
+
+/* update the rows of the contact components k0 to k1 - 1 of J with
+ * new A and B. The null entries are kept: the sparsity pattern does
+ * not change from an iteration to the other. */
+void updateACPsiJacobianPart(
+  CSparseMatrix* M,
+  CSparseMatrix* H,
+  CSparseMatrix *A,
+  CSparseMatrix *B,
+  CSparseMatrix *J,
+  CS_INT Astart,
+  CS_INT k0, CS_INT k1)
+{
+  if(((Astart + A->nz + B->nz) > J->nzmax))
+  {
+    CHECK_RETURN(cs_sprealloc(J, Astart + A->nz + B->nz));
+  }
+
+  J->nz = Astart;
+
+  /* A */
+  for(CS_INT e = 0; e < A->nz; ++e)
+  {
+    if(A->i[e] >= k0 && A->i[e] < k1)
+    {
+      J->i[J->nz] = A->i[e] + M->m + H->n;
+      J->p[J->nz] = A->p[e] + M->n;
+      J->x[J->nz] = A->x[e];
+      J->nz++;
+    }
+  }
+
+  /* B */
+  for(CS_INT e = 0; e < B->nz; ++e)
+  {
+    if(B->i[e] >= k0 && B->i[e] < k1)
+    {
+      J->i[J->nz] = B->i[e] + M->m + H->n;
+      J->p[J->nz] = B->p[e] + M->n + A->n;
+      J->x[J->nz] = B->x[e];
+      J->nz++;
+    }
+  }
+  assert(J->nz <= J->nzmax);
+}
+
 /*
 */
 int _globalLineSearchSparseGP(
   GlobalFrictionContactProblem *problem,
+  GlobalAlartCurnierData* data,
   AlartCurnierFun3x3Ptr computeACFun3x3,
   double *solution,
   double *direction,
@@ -293,8 +596,7 @@ int _globalLineSearchSparseGP(
   double q0 = 0.5 * cblas_ddot(problem_size, psi, 1, psi, 1);
 
   //  tmp <- J * direction
-  cblas_dscal(problem_size, 0., tmp, 1);
-  cs_gaxpy(J, direction, tmp);
+  gfc3d_AC_jacobian_gemv(data, J, problem_size, direction, tmp);
 
   double dqdt0 = cblas_ddot(problem_size, psi, 1, tmp, 1);
   DEBUG_PRINTF("dqdt0=%e\n",dqdt0);
@@ -307,8 +609,9 @@ int _globalLineSearchSparseGP(
     cblas_dcopy(problem_size, solution, 1, tmp, 1);
     cblas_daxpy(problem_size, alpha[0], direction, 1, tmp, 1);
 
-    ACPsi(
+    gfc3d_AC_psi(
       problem,
+      data,
       computeACFun3x3,
       tmp,  /* v */
       tmp+problem->M->size0+problem->H->size1, /* P */
@@ -550,10 +853,36 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
   init3x3DiagBlocks(problem->numberOfContacts, A, &A_);
   init3x3DiagBlocks(problem->numberOfContacts, B, &B_);
 
-  J = cs_spalloc(NM_triplet(problem->M)->n + A_.m + B_.m,
-                 NM_triplet(problem->M)->n + A_.m + B_.m,
-                 NM_triplet(problem->M)->nzmax + 2*NM_triplet(problem->H)->nzmax +
-                 2*A_.n + A_.nzmax + B_.nzmax, 1, 1);
+  /* with MUMPS, the jacobian and the MUMPS instance are kept from one
+   * call to the other; in the distributed mode, each process assembles
+   * the rows of its share of the contacts and of M */
+  GlobalAlartCurnierData* data = NULL;
+  if(options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER] == SICONOS_FRICTION_3D_NSN_USE_MUMPS ||
+     options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER] == SICONOS_FRICTION_3D_NSN_USE_MUMPS_DISTRIBUTED)
+  {
+#ifdef WITH_MUMPS
+    data = gfc3d_AC_data(problem, options, problem_size);
+#else
+    numerics_error("gfc3d_nonsmooth_Newton_AlartCurnier",
+                   "MUMPS is not available.\n");
+#endif
+  }
+
+  /* contact components of this process */
+  CS_INT k0 = data ? 3 * data->c0 : 0;
+  CS_INT k1 = data ? 3 * data->c1 : m;
+
+  if(data)
+  {
+    J = NM_triplet(data->J);
+  }
+  else
+  {
+    J = cs_spalloc(NM_triplet(problem->M)->n + A_.m + B_.m,
+                   NM_triplet(problem->M)->n + A_.m + B_.m,
+                   NM_triplet(problem->M)->nzmax + 2*NM_triplet(problem->H)->nzmax +
+                   2*A_.n + A_.nzmax + B_.nzmax, 1, 1);
+  }
 
 
   DEBUG_PRINTF("NM_triplet(problem->M)->n= %li\t,NM_triplet(problem->M)->nzmax = %li\n",NM_triplet(problem->M)->n,NM_triplet(problem->M)->nzmax);
@@ -577,11 +906,24 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
   double rescaling=1e+00;
 
 
-  CS_INT Astart = initACPsiJacobian(NM_triplet(problem->M),
-                                    NM_triplet(problem->H),
-                                    &A_, &B_, J, rescaling);
-    
-  assert(Astart > 0);
+  CS_INT Astart;
+  if(data)
+  {
+    Astart = initACPsiJacobianPart(NM_triplet(problem->M),
+                                   NM_triplet(problem->H),
+                                   J, rescaling,
+                                   data->r0, data->r1, k0, k1);
+    updateACPsiJacobianPart(NM_triplet(problem->M),
+                            NM_triplet(problem->H),
+                            &A_, &B_, J, Astart, k0, k1);
+  }
+  else
+  {
+    Astart = initACPsiJacobian(NM_triplet(problem->M),
+                               NM_triplet(problem->H),
+                               &A_, &B_, J, rescaling);
+    assert(Astart > 0);
+  }
 
   assert(A_.m == A_.n);
   assert(B_.m == B_.n);
@@ -602,9 +944,23 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
   // need to use the functions from NumericsMatrix --xhub
 
 
-  NumericsSparseMatrix* SM = NSM_new();
-  SM->triplet = J;
-  NumericsMatrix *AA = NM_create_from_data(NM_SPARSE,  (int)J->m, (int)J->n, SM);
+  NumericsMatrix *AA;
+  if(data)
+  {
+    AA = data->J;
+  }
+  else
+  {
+    NumericsSparseMatrix* SM = NSM_new();
+    SM->triplet = J;
+    AA = NM_create_from_data(NM_SPARSE,  (int)J->m, (int)J->n, SM);
+  }
+#ifdef WITH_MUMPS
+  if(data && data->distributed)
+  {
+    NM_MUMPS_set_distributed(AA);
+  }
+#endif
 
   info[0] = 1;
 
@@ -661,22 +1017,38 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
     /* } */
 
     /* compute psi */
-    ACPsi(problem, computeACFun3x3, globalVelocity_k, reaction_k, velocity_k, rho, psi);
+    gfc3d_AC_psi(problem, data, computeACFun3x3, globalVelocity_k, reaction_k, velocity_k, rho, psi);
 
 
     //cblas_dscal(problem_size, rescaling, psi, 1);
 
 
-    /* compute A & B */
-    fc3d_AlartCurnierFunction(m,
-                              computeACFun3x3,
-                              reaction_k, velocity_k,
-                              problem->mu, rho,
-                              F, A, B);
-    /* update J */
-    updateACPsiJacobian(NM_triplet(problem->M),
-                        NM_triplet(problem->H),
-                        &A_, &B_, J, Astart);
+    if(data)
+    {
+      /* compute A & B of the contacts of this process */
+      fc3d_AlartCurnierFunction(k1 - k0,
+                                computeACFun3x3,
+                                reaction_k + k0, velocity_k + k0,
+                                problem->mu + k0 / 3, rho + k0,
+                                F + k0, A + 3 * k0, B + 3 * k0);
+      /* update J, with a constant sparsity pattern */
+      updateACPsiJacobianPart(NM_triplet(problem->M),
+                              NM_triplet(problem->H),
+                              &A_, &B_, J, Astart, k0, k1);
+    }
+    else
+    {
+      /* compute A & B */
+      fc3d_AlartCurnierFunction(m,
+                                computeACFun3x3,
+                                reaction_k, velocity_k,
+                                problem->mu, rho,
+                                F, A, B);
+      /* update J */
+      updateACPsiJacobian(NM_triplet(problem->M),
+                          NM_triplet(problem->H),
+                          &A_, &B_, J, Astart);
+    }
 
     /* rhs = -psi */
     cblas_dcopy(problem_size, psi, 1, rhs, 1);
@@ -692,7 +1064,8 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
 
     DEBUG_PRINTF("norm of AA = %e\n", NM_norm_1(AA));
     /* Solve: AWpB X = -F */
-    int info_solver = NM_gesv(AA, rhs, true);
+    /* with MUMPS, the analysis is reused */
+    int info_solver = data ? NM_gesv_expert(AA, rhs, NM_KEEP_ANALYSIS) : NM_gesv(AA, rhs, true);
 
     DEBUG_PRINTF("norm of rhs (direction) = %e\n", cblas_dnrm2(problem_size,rhs,1));
     if (info_solver > 0)
@@ -706,8 +1079,16 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
     /* Check the quality of the solution */
     if (verbose > 0)
     {
-      cblas_dcopy_msan(problem_size, psi, 1, tmp3, 1);
-      NM_gemv(1., AA, rhs, 1., tmp3);
+      if(data)
+      {
+        gfc3d_AC_jacobian_gemv(data, Jcsc, problem_size, rhs, tmp3);
+        cblas_daxpy(problem_size, 1., psi, 1, tmp3, 1);
+      }
+      else
+      {
+        cblas_dcopy_msan(problem_size, psi, 1, tmp3, 1);
+        NM_gemv(1., AA, rhs, 1., tmp3);
+      }
       linear_solver_residual = cblas_dnrm2(problem_size, tmp3, 1);
       numerics_printf_verbose(1, "---- GFC3D - NSN_AC iteration %d, linear_solver_residual = %g ", iter, linear_solver_residual);
       /* for the component wise scaled residual: cf mumps &
@@ -732,6 +1113,7 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
     case SICONOS_FRICTION_3D_NSN_LINESEARCH_GOLDSTEINPRICE:
       /* Goldstein Price */
       info_ls = _globalLineSearchSparseGP(problem,
+                                          data,
                                           computeACFun3x3,
                                           solution,
                                           rhs,
@@ -831,8 +1213,11 @@ void gfc3d_nonsmooth_Newton_AlartCurnier(
   }
 #endif
 
-  NM_free(AA);
-  free(AA);
+  if(!data)
+  {
+    NM_free(AA);
+    free(AA);
+  }
 }
 
 int gfc3d_nonsmooth_Newton_AlartCurnier_setDefaultSolverOptions(
@@ -863,6 +1248,10 @@ int gfc3d_nonsmooth_Newton_AlartCurnier_setDefaultSolverOptions(
 
   options->iparam[SICONOS_FRICTION_3D_NSN_MPI_COM] = -1;     /* mpi com fortran */
 
+  /* CSparse, or MUMPS (persistent analysis), or MUMPS distributed over
+   * the MPI processes */
+  options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER] = SICONOS_FRICTION_3D_NSN_USE_CSLUSOL;
+
   options->iparam[SICONOS_FRICTION_3D_NSN_MEMORY_ALLOCATION] = 0;      /* > 0 memory is allocated */
 
   options->iparam[SICONOS_FRICTION_3D_NSN_FORMULATION] = SICONOS_FRICTION_3D_NSN_FORMULATION_ALARTCURNIER_STD;     /* 0 STD AlartCurnier, 1 JeanMoreau, 2 STD generated, 3 JeanMoreau generated */
@@ -29,4 +29,11 @@ int gfc3d_nonsmooth_Newton_AlartCurnier_setDefaultSolverOptions(
 void gfc3d_sparseGlobalAlartCurnierInit(
   SolverOptions *SO);
 
+/** Free the data kept in options->solverData by the MUMPS linear
+ * solvers (the jacobian and its MUMPS instance). Collective in the
+ * distributed mode.
+ * \param options the solver options
+ */
+void gfc3d_nonsmooth_Newton_AlartCurnier_free(SolverOptions* options);
+
 #endif
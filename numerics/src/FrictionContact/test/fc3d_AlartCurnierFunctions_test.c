@@ -157,6 +157,34 @@ int main()
 
   }
 
+  /* the batched version against the generated function, contact by
+   * contact */
+  {
+    double* Fb = (double *) malloc(3 * dim * sizeof(double));
+    double* Ab = (double *) malloc(9 * dim * sizeof(double));
+    double* Bb = (double *) malloc(9 * dim * sizeof(double));
+
+    fc3d_AlartCurnierFunctionGeneratedBatch(dim, reactions, velocities, mus, rhos, Fb, Ab, Bb);
+
+    for (unsigned int k = 0; k < dim; ++k)
+    {
+      fc3d_AlartCurnierFunctionGenerated(&reactions[k * 3], &velocities[k * 3], mus[k], &rhos[k * 3], F2, A2, B2);
+
+      for (unsigned int i = 0; i < 3; ++i)
+        info |= !(fabs(Fb[3 * k + i] - F2[i]) < EPS * (1. + fabs(F2[i])));
+      for (unsigned int i = 0; i < 9; ++i)
+      {
+        info |= !(fabs(Ab[9 * k + i] - A2[i]) < EPS * (1. + fabs(A2[i])));
+        info |= !(fabs(Bb[9 * k + i] - B2[i]) < EPS * (1. + fabs(B2[i])));
+      }
+      assert(!info);
+    }
+
+    free(Fb);
+    free(Ab);
+    free(Bb);
+  }
+
   free(reactions);
   free(velocities);
   free(mus);
@@ -0,0 +1,126 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* The batched Fischer-Burmeister function against the generated one,
+ * contact by contact, on the contacts of ACinputs.dat. */
+
+#undef NDEBUG
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fc3d_nonsmooth_Newton_FischerBurmeister.h"
+#include "FischerBurmeisterGenerated.h"
+
+#define EPS 1e-12
+
+int main()
+{
+  int info = 0;
+  int r = -1;
+
+  FILE* file = fopen("./data/ACinputs.dat", "r");
+  unsigned int dim = 0;
+
+  r = fscanf(file, "%d\n", &dim);
+  assert(r > 0);
+  if (r <= 0) return(r);
+
+  double* reactions = (double *) malloc(3 * dim * sizeof(double));
+  double* velocities = (double *) malloc(3 * dim * sizeof(double));
+  double* mus = (double *) malloc(dim * sizeof(double));
+  double* rhos = (double *) malloc(3 * dim * sizeof(double));
+
+  for (unsigned int i = 0; i < dim * 3 ; ++i)
+  {
+    r = fscanf(file, "%lf\n", &reactions[i]);
+    assert(r > 0);
+  };
+
+  for (unsigned int i = 0; i < dim * 3 ; ++i)
+  {
+    r = fscanf(file, "%lf\n", &velocities[i]);
+    assert(r > 0);
+  };
+
+  for (unsigned int k = 0; k < dim ; ++k)
+  {
+    r = fscanf(file, "%lf\n", &mus[k]);
+    assert(r > 0);
+  };
+
+  for (unsigned int i = 0; i < dim * 3 ; ++i)
+  {
+    r = fscanf(file, "%lf\n", &rhos[i]);
+    assert(r > 0);
+  };
+
+  double* Fb = (double *) malloc(3 * dim * sizeof(double));
+  double* Ab = (double *) malloc(9 * dim * sizeof(double));
+  double* Bb = (double *) malloc(9 * dim * sizeof(double));
+  double F[3], A[9], B[9];
+
+  /* all the contacts, then a number of contacts which is not a
+   * multiple of the batch size */
+  unsigned int sizes[2] = { dim, dim - 1 };
+  for (unsigned int s = 0; s < 2; ++s)
+  {
+    unsigned int nc = sizes[s];
+
+    fc3d_FischerBurmeisterFunctionGeneratedBatch(nc, reactions, velocities, mus, rhos, Fb, Ab, Bb);
+
+    for (unsigned int k = 0; k < nc; ++k)
+    {
+      fc3d_FischerBurmeisterFunctionGenerated(&reactions[k * 3], &velocities[k * 3], mus[k], &rhos[k * 3], F, A, B);
+
+      for (unsigned int i = 0; i < 3; ++i)
+        info |= !(fabs(Fb[3 * k + i] - F[i]) < EPS * (1. + fabs(F[i])));
+      for (unsigned int i = 0; i < 9; ++i)
+      {
+        info |= !(fabs(Ab[9 * k + i] - A[i]) < EPS * (1. + fabs(A[i])));
+        info |= !(fabs(Bb[9 * k + i] - B[i]) < EPS * (1. + fabs(B[i])));
+      }
+      if (info)
+        printf("contact %u: the batched and the generated functions differ\n", k);
+      assert(!info);
+    }
+  }
+
+  /* the Newton assembly goes through the batched version */
+  fc3d_FischerBurmeisterFunction(3 * dim, &fc3d_FischerBurmeisterFunctionGenerated,
+                                 reactions, velocities, mus, rhos, Fb, Ab, Bb);
+  for (unsigned int k = 0; k < dim; ++k)
+  {
+    fc3d_FischerBurmeisterFunctionGenerated(&reactions[k * 3], &velocities[k * 3], mus[k], &rhos[k * 3], F, A, B);
+    for (unsigned int i = 0; i < 3; ++i)
+      info |= !(fabs(Fb[3 * k + i] - F[i]) < EPS * (1. + fabs(F[i])));
+  }
+  assert(!info);
+
+  free(Fb);
+  free(Ab);
+  free(Bb);
+  free(reactions);
+  free(velocities);
+  free(mus);
+  free(rhos);
+
+  fclose(file);
+  return (info);
+}
@@ -0,0 +1,155 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "NonSmoothDrivers.h"
+#include "SolverOptions.h"
+#include "FrictionContactProblem.h"
+#include "Friction_cst.h"
+#include "fc3d_Solvers.h"
+#include "fc3d_projection.h"
+
+#define NB_SCENARIOS 6
+
+/* solve the scenarios with fc3d_driver_batch and one by one with
+ * fc3d_driver, results must be the same */
+static int test_batch(FrictionContactProblem* problem, SolverOptions* options)
+{
+  int nc = problem->numberOfContacts;
+  int n = problem->dimension * nc;
+
+  double* q = (double*)malloc(NB_SCENARIOS * n * sizeof(double));
+  double* mu = (double*)malloc(NB_SCENARIOS * nc * sizeof(double));
+  double* reaction = (double*)calloc(NB_SCENARIOS * n, sizeof(double));
+  double* velocity = (double*)calloc(NB_SCENARIOS * n, sizeof(double));
+  double* r = (double*)calloc(n, sizeof(double));
+  double* u = (double*)calloc(n, sizeof(double));
+  int info[NB_SCENARIOS];
+
+  for (int k = 0; k < NB_SCENARIOS; k++)
+  {
+    for (int i = 0; i < n; i++)
+      q[k * n + i] = (1.0 + 0.1 * k) * problem->q[i];
+    for (int i = 0; i < nc; i++)
+      mu[k * nc + i] = (0.5 + 0.1 * k) * problem->mu[i];
+  }
+
+  int failures = fc3d_driver_batch(problem, NB_SCENARIOS, q, mu,
+                                   reaction, velocity, options, info);
+  printf("batch of %i scenarios with solver %s: %i failures, max residu %e\n",
+         NB_SCENARIOS, solver_options_id_to_name(options->solverId),
+         failures, options->dparam[SICONOS_DPARAM_RESIDU]);
+
+  int result = failures;
+  double* q0 = problem->q;
+  double* mu0 = problem->mu;
+  for (int k = 0; k < NB_SCENARIOS; k++)
+  {
+    problem->q = q + k * n;
+    problem->mu = mu + k * nc;
+    for (int i = 0; i < n; i++)
+    {
+      r[i] = 0.;
+      u[i] = 0.;
+    }
+    int infok = fc3d_driver(problem, r, u, options);
+    if (infok != info[k])
+    {
+      printf("scenario %i: info %i in batch, %i alone\n", k, info[k], infok);
+      result = 1;
+    }
+    for (int i = 0; i < n; i++)
+    {
+      if (fabs(r[i] - reaction[k * n + i]) > 1e-12 ||
+          fabs(u[i] - velocity[k * n + i]) > 1e-12)
+      {
+        printf("scenario %i: solution differs at %i\n", k, i);
+        result = 1;
+        break;
+      }
+    }
+  }
+  problem->q = q0;
+  problem->mu = mu0;
+
+  free(q);
+  free(mu);
+  free(reaction);
+  free(velocity);
+  free(r);
+  free(u);
+  return result;
+}
+
+int main(void)
+{
+  int info = 0;
+  FILE * finput = fopen("./data/Capsules-i122-1617.dat", "r");
+  if (!finput)
+  {
+    fprintf(stderr, "unable to open data file\n");
+    return 1;
+  }
+  FrictionContactProblem* problem = frictionContactProblem_new();
+  frictionContact_newFromFile(problem, finput);
+  fclose(finput);
+
+  /* NSGS with a projection local solver: scenarios solved concurrently */
+  SolverOptions options;
+  fc3d_nsgs_setDefaultSolverOptions(&options);
+  options.dparam[SICONOS_DPARAM_TOL] = 1e-6;
+  solver_options_delete(options.internalSolvers);
+  fc3d_projectionOnConeWithLocalIteration_setDefaultSolverOptions(options.internalSolvers);
+  if (!fc3d_batch_is_reentrant(&options))
+  {
+    printf("NSGS with projection local solver should be reentrant\n");
+    info = 1;
+  }
+  info += test_batch(problem, &options);
+  solver_options_delete(&options);
+
+  /* default NSGS (Newton local solver) */
+  fc3d_setDefaultSolverOptions(&options, SICONOS_FRICTION_3D_NSGS);
+  options.dparam[SICONOS_DPARAM_TOL] = 1e-6;
+  info += test_batch(problem, &options);
+  solver_options_delete(&options);
+
+  /* fixed point projection, not known to be reentrant: sequential fallback */
+  fc3d_setDefaultSolverOptions(&options, SICONOS_FRICTION_3D_FPP);
+  options.dparam[SICONOS_DPARAM_TOL] = 1e-6;
+  info += test_batch(problem, &options);
+  solver_options_delete(&options);
+
+  /* sparse M: its derived storages are built before the scenarios
+   * share it */
+  int n = problem->numberOfContacts * problem->dimension;
+  NumericsMatrix* W = NM_create(NM_SPARSE, n, n);
+  NM_copy_to_sparse(problem->M, W);
+  NM_free(problem->M);
+  free(problem->M);
+  problem->M = W;
+  fc3d_nsgs_setDefaultSolverOptions(&options);
+  options.dparam[SICONOS_DPARAM_TOL] = 1e-6;
+  info += test_batch(problem, &options);
+  solver_options_delete(&options);
+
+  frictionContactProblem_free(problem);
+  return info;
+}
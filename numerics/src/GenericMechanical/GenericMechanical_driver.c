@@ -53,6 +53,7 @@
 #include "debug.h"
 #include "LinearComplementarityProblem.h"
 #include "lcp_cst.h"
+#include "tlsdef.h"
 
 int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction , double *velocity, double tol, SolverOptions* options, double * err)
 {
@@ -65,7 +66,9 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction , double
   int curSize = 0;
   *err = 0.0;
   double localError = 0;
-  double * bufForLocalProblemDense = (storageType == 0) ? (double*) malloc(pGMP->maxLocalSize * pGMP->maxLocalSize * sizeof(double)) : 0;
+  /* called at each iteration of the solver: the buffer goes back to the workspace on return */
+  size_t mark = solver_options_workspace_mark(options);
+  double * bufForLocalProblemDense = (storageType == 0) ? (double*) solver_options_workspace_alloc(options, pGMP->maxLocalSize * pGMP->maxLocalSize * sizeof(double)) : 0;
 
 #ifdef GENERICMECHANICAL_DEBUG_COMPUTE_ERROR
   printf("GenericMechanical compute_error BEGIN:\n");
@@ -129,6 +132,7 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction , double
       if (isnan(Vl[ii]) || isnan(Rl[ii]))
       {
         *err = 10;
+        solver_options_workspace_release(options, mark);
         return 1;
       }
     switch (curProblem->type)
@@ -205,8 +209,7 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction , double
   else
     printf("GenericMechanical_driver compute_error END:, err<tol: error : %e\n", *err);
 #endif
-  if (storageType == 0)
-    free(bufForLocalProblemDense);
+  solver_options_workspace_release(options, mark);
 
   if (*err > tol)
     return 1;
@@ -214,8 +217,8 @@ int gmp_compute_error(GenericMechanicalProblem* pGMP, double *reaction , double
     return 0;
 }
 #ifdef GENERICMECHANICAL_DEBUG_CMP
-static int SScmp = 0;
-static int SScmpTotal = 0;
+static tlsvar int SScmp = 0;
+static tlsvar int SScmpTotal = 0;
 #endif
 //#define GMP_WRITE_PRB
 //static double sCoefLS=1.0;
@@ -253,7 +256,8 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
   double * pBuffVelocity = NULL;
   int withLS = options->iparam[1];
   double * pCoefLS = &(options->dparam[1]);
-  double * bufForLocalProblemDense = (storageType == 0) ? (double*) malloc(pGMP->maxLocalSize * pGMP->maxLocalSize * sizeof(double)) : 0;
+  solver_options_workspace_reset(options);
+  double * bufForLocalProblemDense = (storageType == 0) ? (double*) solver_options_workspace_alloc(options, pGMP->maxLocalSize * pGMP->maxLocalSize * sizeof(double)) : 0;
 
   if (options->dWork)
   {
@@ -261,7 +265,7 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
   }
   else
   {
-    pPrevReaction = (double *) malloc(gmp_get_nb_dwork(pGMP, options) * sizeof(double));
+    pPrevReaction = (double *) solver_options_workspace_alloc(options, gmp_get_nb_dwork(pGMP, options) * sizeof(double));
   }
   pBuffVelocity = pPrevReaction + pGMP->size;
   while (it < iterMax && tolViolate)
@@ -477,11 +481,7 @@ void gmp_gauss_seidel(GenericMechanicalProblem* pGMP, double * reaction, double
   }
 
   //printf("---GenericalMechanical_drivers,  IT=%d, err=%e.\n",it,*err);
-  if (! options->dWork)
-    free(pPrevReaction);
   *info = tolViolate;
-  if (storageType == 0)
-    free(bufForLocalProblemDense);
 }
 
 /*
@@ -31,74 +31,21 @@
 #include "SiconosLapack.h"
 #include "lcp_enum.h"
 #include "numerics_verbose.h"
+#include "complementarity_enum.h"
 
-static unsigned long  int sCurrentEnum = 0;
-static unsigned long  int sCmpEnum = 0;
-static unsigned long  int sNbCase = 0;
-static double sProgress = 0;
-static int* sWZ = 0;
-static double * sM = 0;
-static double * sMref = 0;
-static double * sQ = 0;
-static double * sQref = 0;
-static double * sColNul = 0;
-static int sSize = 0;
-static int LWORK = 0;
-
-
-static void affectWZ();
-static void lcp_buildM(int * zw, double * M, double * Mref, int size);
-static void lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q);
-static void lcp_initEnum();
-static int lcp_nextEnum();
-static void lcp_buildQ();
-
-/*case defined with sCurrentEnum
- *if sWZ[i]==0
+/*case defined with the configuration
+ *if bit i is 0
  *  w[i] null
  *else
  *  z[i] null
  */
-void affectWZ()
-{
-  unsigned long  int aux = sCurrentEnum;
-  for (int i = 0; i < sSize; i++)
-  {
-    sWZ[i] = aux & 1;
-    aux = aux >> 1;
-  }
-}
-void lcp_buildM(int * zw, double * M, double * Mref, int size)
-{
-  int col;
-  double * Aux;
-  double * AuxRef;
-  Aux = M;
-  AuxRef = Mref;
-  for (col = 0; col < size; col++)
-  {
-    if (zw[col] == 0)
-    {
-      memcpy(Aux, AuxRef, size * sizeof(double));
-    }
-    else
-    {
-      /*for(i=0;i<size;i++) Aux[i]=0;*/
-      memcpy(Aux, sColNul, sSize * sizeof(double));
-      Aux[col] = -1;
-      /*M[(n+col)*npm+col+n]=-1;*/
-    }
-    Aux = Aux + size;
-    AuxRef = AuxRef + size;
-  }
-}
-void   lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q)
+static void lcp_fillSolution(double*  z, double * w, int size, unsigned long long configuration, double * Q)
 {
   int lin;
 
   for (lin = 0; lin < size; lin++)
   {
-    if (zw[lin] == 0)
+    if (((configuration >> lin) & 1) == 0)
     {
       w[lin] = 0;
       z[lin] = Q[lin];
@@ -110,41 +57,7 @@ void   lcp_fillSolution(double*  z, double * w, int size, int* zw, double * Q)
     }
   }
 }
-void lcp_initEnum()
-{
-  int cmp;
-  sCmpEnum = 0;
-  sNbCase = 1;
-  for (cmp = 0; cmp < sSize; cmp++)
-    sNbCase = sNbCase << 1;
-  sProgress = 0;
-}
-int lcp_nextEnum()
-{
-  if (sCmpEnum == sNbCase)
-    return 0;
-  if (sCurrentEnum >= sNbCase)
-  {
-    sCurrentEnum = 0;
-  }
-  if (verbose)
-    printf("try enum :%d\n", (int)sCurrentEnum);
-  affectWZ();
-  sCurrentEnum++;
-  sCmpEnum++;
-  if (verbose && sCmpEnum > (unsigned long int)sProgress * sNbCase)
-  {
-    sProgress += 0.001;
-    printf("lcp_enum progress %f %d \n", sProgress, (int) sCurrentEnum);
-  }
-
-  return 1;
-}
 
-void lcp_buildQ()
-{
-  memcpy(sQ, sQref, (sSize)*sizeof(double));
-}
 int lcp_enum_getNbIWork(LinearComplementarityProblem* problem, SolverOptions* options)
 {
   return 2 * (problem->size);
@@ -152,15 +65,6 @@ int lcp_enum_getNbIWork(LinearComplementarityProblem* problem, SolverOptions* op
 int lcp_enum_getNbDWork(LinearComplementarityProblem* problem, SolverOptions* options)
 {
   int aux = 3 * (problem->size) + (problem->size) * (problem->size);
-  if (options->iparam[4])
-  {
-    LWORK = -1;
-    //int info = 0;
-    double dgelsSize = 0;
-    //DGELS(problem->M->size0, problem->size , 1, 0, problem->M->size0, 0, problem->M->size0, &dgelsSize, LWORK, &info);
-    aux += (int) dgelsSize;
-    LWORK = (int) dgelsSize;
-  }
   return aux;
 }
 void lcp_enum_init(LinearComplementarityProblem* problem, SolverOptions* options, int withMemAlloc)
@@ -179,139 +83,120 @@ void lcp_enum_reset(LinearComplementarityProblem* problem, SolverOptions* option
     free(options->iWork);
   }
   options->dWork = NULL;
+  solver_options_workspace_free(options);
   solver_options_nullify(options);
 }
 
 
+/* one configuration after the other, each solved by DGELS */
+static unsigned long long lcp_enum_dgels(ComplementarityEnum * pb, unsigned long long first,
+                                          unsigned long long count, double * A)
+{
+  int size = pb->size;
+  lapack_int LAinfo = 0;
+  unsigned long long mask = pb->nbPairs < 64 ? (1ULL << pb->nbPairs) - 1 : ~0ULL;
+  for (unsigned long long pos = 0; pos < count; pos++)
+  {
+    unsigned long long configuration = (first + pos) & mask;
+    complementarity_enum_build_matrix(pb, configuration, A);
+    memcpy(pb->x, pb->b, size * sizeof(double));
+    DGELS(LA_NOTRANS, size, size, 1, A, size, pb->x, size, &LAinfo);
+    if (verbose)
+    {
+      printf("Solution of dgels (info=%i)\n", LAinfo);
+      NM_dense_display(pb->x, size, 1, 0);
+    }
+    if (LAinfo)
+      continue;
+    int lin, check = 1;
+    for (lin = 0; lin < size; lin++)
+    {
+      if (isnan(pb->x[lin]) || isinf(pb->x[lin]))
+      {
+        printf("DGELS FAILED\n");
+        check = 0;
+        break;
+      }
+      if (pb->x[lin] < - pb->tol)
+      {
+        check = 0;
+        break;/*out of the cone!*/
+      }
+    }
+    if (check)
+    {
+      pb->configuration = configuration;
+      return pos;
+    }
+  }
+  return count;
+}
+
 void lcp_enum(LinearComplementarityProblem* problem, double *z, double *w, int *info , SolverOptions* options)
 {
   *info = 1;
-  double tol ;
   if (options->dWork == NULL)
   {
     lcp_enum_init(problem, options, 1);
   }
-  double * workingFloat = options->dWork;
-  int * workingInt = options->iWork;
-  int lin;
-  sSize = (problem->size);
-  int NRHS = 1;
-  lapack_int * ipiv;
-  int check;
-  lapack_int LAinfo = 0;
+  int size = (problem->size);
   int useDGELS = options->iparam[4];
-
-  /*OUTPUT param*/
-  sCurrentEnum = options->iparam[3];
-  tol = options->dparam[0];
   int multipleSolutions = options->iparam[0];
   int numberofSolutions = 0;
 
-
-
-
-  sMref = problem->M->matrix0;
-  if (!sMref)
+  if (!problem->M->matrix0)
   {
     printf("lcp_enum failed, problem->M->matrix0 is null");
-
   }
 
+  /* the system M x = -q, of which all the unknowns are complementarity pairs */
+  ComplementarityEnum pb;
+  pb.size = size;
+  pb.offset = 0;
+  pb.nbPairs = size;
+  pb.M = problem->M->matrix0;
+  pb.b = options->dWork;
+  pb.x = pb.b + size;
+  pb.tol = options->dparam[0];
+  for (int lin = 0; lin < size; lin++)
+    pb.b[lin] =  - problem->q[lin];
+
   if (verbose)
-    printf("lcp_enum begin, size %d tol %e\n", sSize, tol);
+    printf("lcp_enum begin, size %d tol %e\n", size, pb.tol);
 
-  sM = workingFloat;
-  sQ = sM + sSize * sSize;
-  sColNul = sQ + sSize;
-  sQref = sColNul + sSize;
-  for (lin = 0; lin < sSize; lin++)
+  if (size >= 64)
   {
-    sQref[lin] =  - problem->q[lin];
-    sColNul[lin] = 0;
+    printf("lcp_enum failed, too many configurations\n");
+    return;
   }
-  sWZ = workingInt;
-  ipiv = sWZ + sSize;
+  unsigned long long nbCase = 1ULL << size;
+  /* iparam[3] is the first configuration */
+  unsigned long long first = (unsigned long long)(unsigned int)options->iparam[3] & (nbCase - 1);
+  if (!useDGELS)
+    first = complementarity_enum_rank(first);
+  unsigned long long count = nbCase;
+
   *info = 0;
-  lcp_initEnum();
-  while (lcp_nextEnum())
+  while (count)
   {
-    lcp_buildM(sWZ, sM, sMref, sSize);
-    lcp_buildQ();
-    /*     if (verbose) */
-    /*       printCurrentSystem(); */
-    if (useDGELS)
-    {
-      /* if (verbose) */
-      /*   { */
-      /*     printf("call dgels on ||AX-B||\n"); */
-      /*     printf("A\n"); */
-      /*     NM_dense_display(sM,sSize,sSize,0); */
-      /*     printf("B\n"); */
-      /*     NM_dense_display(sQ,sSize,1,0); */
-      /*   } */
+    unsigned long long pos = useDGELS ?
+      lcp_enum_dgels(&pb, first, count, pb.x + size) :
+      complementarity_enum_solve(&pb, first, count, options);
+    if (pos == count)
+      break;
 
-      DGELS(LA_NOTRANS,sSize, sSize, NRHS, sM, sSize, sQ, sSize,&LAinfo);
-      if (verbose)
-      {
-        printf("Solution of dgels (info=%i)\n", LAinfo);
-        NM_dense_display(sQ, sSize, 1, 0);
-      }
-    }
-    else
+    numberofSolutions++;
+    if (verbose || multipleSolutions)
     {
-      DGESV(sSize, NRHS, sM, sSize, ipiv, sQ, sSize, &LAinfo);
+      printf("lcp_enum find %i solution with configuration = %llu!\n", numberofSolutions, pb.configuration);
     }
-    if (!LAinfo)
-    {
-      if (useDGELS)
-      {
-        int cc = 0;
-        int ii;
-        printf("DGELS LAInfo=%i\n", LAinfo);
-        for (ii = 0; ii < sSize; ii++)
-        {
-          if (isnan(sQ[ii]) || isinf(sQ[ii]))
-          {
-            printf("DGELS FAILED\n");
-            cc = 1;
-            break;
-          }
-        }
-        if (cc)
-          continue;
-      }
-
-      if (verbose)
-      {
-        printf("lcp_enum LU factorization succeeded:\n");
-      }
+    lcp_fillSolution(z, w, size, pb.configuration, pb.x);
+    options->iparam[1] = (int) pb.configuration;
+    options->iparam[2] = numberofSolutions;
+    if (!multipleSolutions)  return;
 
-      check = 1;
-      for (lin = 0 ; lin < sSize; lin++)
-      {
-        if (sQ[lin] < - tol)
-        {
-          check = 0;
-          break;/*out of the cone!*/
-        }
-      }
-      if (!check)
-        continue;
-      else
-      {
-        numberofSolutions++;
-        if (verbose || multipleSolutions)
-        {
-          printf("lcp_enum find %i solution with sCurrentEnum = %ld!\n", numberofSolutions, sCurrentEnum - 1);
-        }
-
-
-        lcp_fillSolution(z, w, sSize, sWZ, sQ);
-        options->iparam[1] = (int) sCurrentEnum - 1;
-        options->iparam[2] = numberofSolutions;
-        if (!multipleSolutions)  return;
-      }
-    }
+    first += pos + 1;
+    count -= pos + 1;
   }
   *info = 1;
   if (verbose)
@@ -91,14 +91,15 @@ void lcp_lexicolemke(LinearComplementarityProblem* problem, double *zlem , doubl
 
   options->iparam[1] = 0;
 
-  /* Allocation */
+  /* Allocation, in the workspace kept from one call to the next */
 
-  unsigned* candidate_pivots_indx = (unsigned*)malloc(dim * sizeof(unsigned));
-  basis = (int *)malloc(dim * sizeof(int));
-  A = (double **)malloc(dim * sizeof(double*));
+  solver_options_workspace_reset(options);
+  unsigned* candidate_pivots_indx = (unsigned*)solver_options_workspace_alloc(options, dim * sizeof(unsigned));
+  basis = (int *)solver_options_workspace_alloc(options, dim * sizeof(int));
+  A = (double **)solver_options_workspace_alloc(options, dim * sizeof(double*));
 
   for (ic = 0 ; ic < dim; ++ic)
-    A[ic] = (double *)malloc(dim2 * sizeof(double));
+    A[ic] = (double *)solver_options_workspace_alloc(options, dim2 * sizeof(double));
 
   /* construction of A matrix such that
    * A = [ q | Id | -d | -M ] with d = (1,...1)
@@ -448,12 +449,6 @@ void lcp_lexicolemke(LinearComplementarityProblem* problem, double *zlem , doubl
 
   if (Ifound) *info = 0;
   else *info = 1;
-
-  free(basis);
-
-  for (i = 0 ; i < dim ; ++i) free(A[i]);
-  free(A);
-  free(candidate_pivots_indx);
 }
 
 
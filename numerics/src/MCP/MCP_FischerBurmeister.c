@@ -29,16 +29,15 @@
 
 #pragma GCC diagnostic ignored "-Wmissing-prototypes"
 
-/* Static object which contains the MCP problem description.
-Ugly but required to deal with function pointer connection
-in  FischerFunc_MCP and its jacobian.
+/* The local copy of the MCP problem description is stored in
+options->solverData and given to FischerFunc_MCP and its jacobian
+by the Newton solver.
 */
-static MixedComplementarityProblem * localProblem = NULL;
-
 
 void mcp_FischerBurmeister_init(MixedComplementarityProblem * problem, SolverOptions* options)
 {
-  localProblem = (MixedComplementarityProblem *)malloc(sizeof(MixedComplementarityProblem));
+  MixedComplementarityProblem * localProblem = (MixedComplementarityProblem *)malloc(sizeof(MixedComplementarityProblem));
+  options->solverData = localProblem;
   /* Connect local static problem with the "real" MCP */
   localProblem->sizeEqualities = problem->sizeEqualities ;
   localProblem->sizeInequalities = problem->sizeInequalities ;
@@ -55,13 +54,14 @@ void mcp_FischerBurmeister_init(MixedComplementarityProblem * problem, SolverOpt
 
 void mcp_FischerBurmeister_reset(MixedComplementarityProblem * problem, SolverOptions* options)
 {
-  freeMixedComplementarityProblem(localProblem);
-  localProblem = NULL;
+  freeMixedComplementarityProblem((MixedComplementarityProblem *)options->solverData);
+  options->solverData = NULL;
 }
 
 // Must corresponds to a NewtonFunctionPtr
-void FischerFunc_MCP(int size, double* z, double* phi, int dummy)
+void FischerFunc_MCP(void* data, int size, double* z, double* phi, int dummy)
 {
+  MixedComplementarityProblem * localProblem = (MixedComplementarityProblem *)data;
   // This function uses a user-defined function, set in the problem, to compute
   // the Fisher function
 
@@ -74,8 +74,9 @@ void FischerFunc_MCP(int size, double* z, double* phi, int dummy)
 }
 
 // Must corresponds to a NewtonFunctionPtr
-void nablaFischerFunc_MCP(int size, double* z, double* nablaPhi, int dummy)
+void nablaFischerFunc_MCP(void* data, int size, double* z, double* nablaPhi, int dummy)
 {
+  MixedComplementarityProblem * localProblem = (MixedComplementarityProblem *)data;
   int sizeEq = localProblem->sizeEqualities;
   int sizeIneq = localProblem->sizeInequalities;
   /* First call user-defined function to compute Fmcp function, */
@@ -94,7 +95,7 @@ void mcp_FischerBurmeister(MixedComplementarityProblem* problem, double *z, doub
   NewtonFunctionPtr nablaPhi = &nablaFischerFunc_MCP ;
 
   // Call semi-smooth Newton solver
-  *info = nonSmoothNewton(fullSize, z, &phi, &nablaPhi, options->iparam, options->dparam);
+  *info = nonSmoothNewton(fullSize, z, &phi, &nablaPhi, options->solverData, options->iparam, options->dparam);
 
   // todo : compute error function
 
@@ -39,6 +39,7 @@ extern "C"
 #include "mlcp_direct_simplex.h"
 #include "mlcp_direct_path.h"
 #include "mlcp_direct_FB.h"
+#include "mlcp_direct.h"
 #include "mlcp_FB.h"
 
 #include "mlcp_cst.h"
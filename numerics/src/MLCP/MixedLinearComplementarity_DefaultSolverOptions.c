@@ -47,6 +47,8 @@ void  mixedLinearComplementarity_default_setDefaultSolverOptions(MixedLinearComp
   pOptions->iparam[0] = 1000;
   /*enum case : do not use dgels*/
   pOptions->iparam[4] = 0;
+  /*enum case : first configuration*/
+  pOptions->iparam[3] = 0;
   pOptions->iparam[5] = 3; /*Number of registered configurations*/
   pOptions->iparam[8] = 0; /*Prb nedd a update*/
   pOptions->dparam[5] = 1e-12; /*tol used by direct solver to check complementarity*/
@@ -78,6 +80,7 @@ void  mixedLinearComplementarity_deleteDefaultSolverOptions(MixedLinearComplemen
   // Todo : fix this ...
   //if (pOptions->callback)
   //  free(pOptions->callback);
+  solver_options_workspace_free(pOptions);
   solver_options_nullify(pOptions);
 
 }
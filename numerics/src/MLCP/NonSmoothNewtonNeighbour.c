@@ -27,173 +27,39 @@
 #include "numerics_verbose.h"
 
 
-
-static  int sN ;
-static  int sN2 ;
-
-static  double * sphi_z ;
-static  double * sdir_descent ;
-static  double * sphi_zaux ;
-static  double *sjacobianPhi_z ;
-static  double *sjacobianPhi_zaux ;
-static  double *sgrad_psi_z ;
-static  double *sgrad_psi_zaux ;
-static  double *sPrevDirDescent;
-static  double *szaux ;
-static  double *szzaux ;
-static  double *sz2 ;
-static  lapack_int* sipiv ;
-static  int* sW2V;
-
-static int scmp = 0;
-
-static int sPlotMerit = 1;
-static char fileName[64];
-/* static char fileId[16]; */
-
-static double* sZsol = 0;
-
-static NewtonFunctionPtr* sFphi;
-static NewtonFunctionPtr* sFjacobianPhi;
-
-
-static void plotMerit(double *z, double psi_k, double descentCondition);
-//static void plotMeritToZsol(double *z);
-static int linesearch2_Armijo(int n, double *z, double psi_k, double descentCondition);
+/* The work vectors of the solver, set in dWork and iWork, and the
+   functions of the problem. */
+typedef struct
+{
+  int n;
+  double * phi_z;
+  double * dir_descent;
+  double * phi_zaux;
+  double * jacobianPhi_z;
+  double * jacobianPhi_zaux;
+  double * grad_psi_z;
+  double * grad_psi_zaux;
+  double * prevDirDescent;
+  double * zaux;
+  double * zzaux;
+  double * z2;
+  lapack_int * ipiv;
+  int * W2V;
+  NewtonFunctionPtr* phi;
+  NewtonFunctionPtr* jacobianPhi;
+  void* data;
+} NSNNWorkspace;
+
+static double * NSNN_setWorkspace(NSNNWorkspace * w, int n, double * dWork, int * iWork);
+static int linesearch2_Armijo(NSNNWorkspace * w, int n, double *z, double psi_k, double descentCondition);
 //static int lineSearch_Wolfe(double *z, double qp_0);
 //static int NonMonotomnelineSearch(double *z, double Rk);
 
 
-/************************************************************************/
-/*useful for debug*/
-void NSNN_thisIsTheSolution(int n, double * z)
-{
-  sZsol = (double *)malloc(n * sizeof(double));
-  memcpy(sZsol, z, n * sizeof(double));
-}
-void  NSNN_reset()
-{
-  if (sZsol)
-    free(sZsol);
-  sZsol = 0;
-}
-void plotMerit(double *z, double psi_k, double descentCondition)
-{
-  int incx = 1, incy = 1;
-  double q_0, q_tk, qp_tk, merit_k;
-  /* double tmin = 1e-12; */
-  double tk = 1, aux;
-  double m1 = 1e-4;
-  double Nstep = 0;
-  int i = 0;
-
-  FILE *fp;
-
-  (*sFphi)(sN, z, sphi_z, 0);
-  aux = cblas_dnrm2(sN, sphi_z, 1);
-  /* Computes merit function */
-  aux = 0.5 * aux * aux;
-  printf("plot psi_z %e\n", aux);
-
-
-  if (!sPlotMerit)
-    return;
-
-  if (sPlotMerit)
-  {
-    /*    sPlotMerit=0;*/
-    strcpy(fileName, "outputLS");
-
-
-    (*sFphi)(sN, z, sphi_z, 0);
-    q_0 =  cblas_dnrm2(sN, sphi_z , incx);
-    q_0 = 0.5 * q_0 * q_0;
-
-    fp = fopen(fileName, "w");
-
-    /*    sPlotMerit=0;*/
-    tk = 5e-7;
-    aux = -tk;
-    Nstep = 1e4;
-    for (i = 0; i < 2 * Nstep; i++)
-    {
-      cblas_dcopy(sN, z, incx, sz2, incx);
-      cblas_daxpy(sN , aux , sdir_descent , incx , sz2 , incy);
-      (*sFphi)(sN, sz2, sphi_z, 0);
-      q_tk =  cblas_dnrm2(sN, sphi_z , incx);
-      q_tk = 0.5 * q_tk * q_tk;
-
-
-      (*sFjacobianPhi)(sN, sz2, sjacobianPhi_z, 1);
-      /* Computes the jacobian of the merit function, jacobian_psi = transpose(jacobianPhiMatrix).phiVector */
-      cblas_dgemv(CblasColMajor,CblasTrans, sN, sN, 1.0, sjacobianPhi_z, sN, sphi_z, incx, 0.0, sgrad_psi_z, incx);
-      qp_tk = cblas_ddot(sN, sgrad_psi_z, 1, sdir_descent, 1);
-
-      merit_k = psi_k + m1 * aux * descentCondition;
-
-
-      fprintf(fp, "%e %.16e %.16e %e\n", aux, q_tk, merit_k, qp_tk);
-      if (i == Nstep - 1)
-        aux = 0;
-      else
-        aux += tk / Nstep;
-    }
-
-    fclose(fp);
-  }
-}
-/* void plotMeritToZsol(double *z) */
-/* { */
-/*   int incx = 1, incy = 1; */
-/*   double q_0, q_tk; */
-/*   /\*   double merit_k;  *\/ */
-/*   /\*  double tmin = 1e-12; *\/ */
-/*   double tk = 1; */
-/*   /\*   double m1=0.5; *\/ */
-/*   double aux; */
-/*   int i = 0; */
-/*   int ii; */
-/*   if (!sPlotMerit || !sZsol) */
-/*     return; */
-/*   FILE *fp; */
-
-/*   for (ii = 0; ii < sN; ii++) */
-/*     szzaux[ii] = sZsol[ii] - z[ii]; */
-
-
-
-/*   if (sPlotMerit) */
-/*   { */
-/*     /\*    sPlotMerit=0;*\/ */
-/*     strcpy(fileName, "outputLSZsol"); */
-/*     (*sFphi)(sN, z, sphi_z, 0); */
-/*     q_0 =  cblas_dnrm2(sN, sphi_z , incx); */
-/*     q_0 = 0.5 * q_0 * q_0; */
-
-/*     fp = fopen(fileName, "w"); */
-
-/*     /\*    sPlotMerit=0;*\/ */
-/*     tk = 1; */
-/*     aux = -tk; */
-/*     for (i = 0; i < 2e3; i++) */
-/*     { */
-/*       cblas_dcopy(sN, z, incx, sz2, incx); */
-/*       cblas_daxpy(sN , aux , szzaux , incx , sz2 , incy); */
-/*       (*sFphi)(sN, sz2, sphi_z, 0); */
-/*       q_tk =  cblas_dnrm2(sN, sphi_z , incx); */
-/*       q_tk = 0.5 * q_tk * q_tk; */
-/*       fprintf(fp, "%e %e\n", aux, q_tk); */
-/*       aux += tk / 1e3; */
-/*     } */
-
-/*     fclose(fp); */
-/*   } */
-/* }*/
-
 /************************************************************************/
 
 /* Linesearch */
-int linesearch2_Armijo(int n, double *z, double psi_k, double descentCondition)
+int linesearch2_Armijo(NSNNWorkspace * w, int n, double *z, double psi_k, double descentCondition)
 {
 
   /* IN :
@@ -224,12 +90,12 @@ int linesearch2_Armijo(int n, double *z, double psi_k, double descentCondition)
   {
 
     /* Computes merit function = 1/2*norm(phi(z_{k+1}))^2 */
-    cblas_dcopy(sN, z, incx, sz2, incx);
-    cblas_daxpy(n , tk , sdir_descent , incx , sz2 , incy);
+    cblas_dcopy(w->n, z, incx, w->z2, incx);
+    cblas_daxpy(n , tk , w->dir_descent , incx , w->z2 , incy);
 
 
-    (*sFphi)(n, sz2, sphi_z, 0);
-    merit =  cblas_dnrm2(n, sphi_z , incx);
+    (*w->phi)(w->data, n, w->z2, w->phi_z, 0);
+    merit =  cblas_dnrm2(n, w->phi_z , incx);
     merit = 0.5 * merit * merit;
     merit_k = psi_k + m1 * tk * descentCondition;
     if (merit < merit_k)
@@ -238,24 +104,24 @@ int linesearch2_Armijo(int n, double *z, double psi_k, double descentCondition)
       tkr = tk;
 
       /*calcul merit'(tk)*/
-      (*sFjacobianPhi)(sN, sz2, sjacobianPhi_z, 1);
+      (*w->jacobianPhi)(w->data, w->n, w->z2, w->jacobianPhi_z, 1);
       /* Computes the jacobian of the merit function, jacobian_psi = transpose(jacobianPhiMatrix).phiVector */
-      cblas_dgemv(CblasColMajor,CblasTrans, sN, sN, 1.0, sjacobianPhi_z, sN, sphi_z, incx, 0.0, sgrad_psi_zaux, incx);
-      qp_tk = cblas_ddot(sN, sgrad_psi_zaux, 1, sdir_descent, 1);
+      cblas_dgemv(CblasColMajor,CblasTrans, w->n, w->n, 1.0, w->jacobianPhi_z, w->n, w->phi_z, incx, 0.0, w->grad_psi_zaux, incx);
+      qp_tk = cblas_ddot(w->n, w->grad_psi_zaux, 1, w->dir_descent, 1);
 
       if (qp_tk > 0)
       {
         while (fabs(tkl - tkr) > tmin)
         {
           tkaux = 0.5 * (tkl + tkr);
-          cblas_dcopy(sN, z, incx, sz2, incx);
-          cblas_daxpy(n , tkaux , sdir_descent , incx , sz2 , incy);
+          cblas_dcopy(w->n, z, incx, w->z2, incx);
+          cblas_daxpy(n , tkaux , w->dir_descent , incx , w->z2 , incy);
           /*calcul merit'(tk)*/
-          (*sFphi)(n, sz2, sphi_z, 0);
-          (*sFjacobianPhi)(sN, sz2, sjacobianPhi_z, 1);
+          (*w->phi)(w->data, n, w->z2, w->phi_z, 0);
+          (*w->jacobianPhi)(w->data, w->n, w->z2, w->jacobianPhi_z, 1);
           /* Computes the jacobian of the merit function, jacobian_psi = transpose(jacobianPhiMatrix).phiVector */
-          cblas_dgemv(CblasColMajor,CblasTrans, sN, sN, 1.0, sjacobianPhi_z, sN, sphi_z, incx, 0.0, sgrad_psi_zaux, incx);
-          qp_tk = cblas_ddot(sN, sgrad_psi_zaux, 1, sdir_descent, 1);
+          cblas_dgemv(CblasColMajor,CblasTrans, w->n, w->n, 1.0, w->jacobianPhi_z, w->n, w->phi_z, incx, 0.0, w->grad_psi_zaux, incx);
+          qp_tk = cblas_ddot(w->n, w->grad_psi_zaux, 1, w->dir_descent, 1);
           if (qp_tk > 0)
           {
             tkr = tkaux;
@@ -268,14 +134,14 @@ int linesearch2_Armijo(int n, double *z, double psi_k, double descentCondition)
       }
 
       /* printf("merit = %e, merit_k=%e,tk= %e,tkaux=%e \n",merit,merit_k,tk,tkaux);*/
-      cblas_dcopy(sN, sz2, incx, z, incx);
+      cblas_dcopy(w->n, w->z2, incx, z, incx);
       break;
     }
     tk = tk * 0.5;
   }
   if (tk <= tmin)
   {
-    cblas_dcopy(sN, sz2, incx, z, incx);
+    cblas_dcopy(w->n, w->z2, incx, z, incx);
     printf("NonSmoothNewton::linesearch2_Armijo warning, resulting tk=%e < tmin, linesearch stopped.\n", tk);
     return 0;
 
@@ -406,39 +272,45 @@ int nonSmoothNewtonNeigh_getNbDWork(int n, int m)
   return (11 + 2 * (n + m)) * (n + m) + 1;
 }
 
-double * nonSmoothNewtonNeighInitMemory(int n, double * dWork, int * iWork)
+double * NSNN_setWorkspace(NSNNWorkspace * w, int n, double * dWork, int * iWork)
 {
+  int n2 = n * n;
+  w->n = n;
+  w->phi_z = dWork;
+  w->dir_descent = w->phi_z + n;
+  w->phi_zaux = w->dir_descent + n;
+  w->jacobianPhi_z = w->phi_zaux + n;
+  w->jacobianPhi_zaux = w->jacobianPhi_z + n2;
+  w->grad_psi_z = w->jacobianPhi_zaux + n2;
+  w->grad_psi_zaux = w->grad_psi_z + n;
+  w->prevDirDescent = w->grad_psi_zaux + n;
+  w->zaux = w->prevDirDescent + n;
+  w->zzaux = w->zaux + n;
+  w->z2 = w->zzaux + n;
+
+  w->ipiv = iWork;
+  w->W2V = w->ipiv + n;
+
+  return w->z2 + n;
+}
 
+double * nonSmoothNewtonNeighInitMemory(int n, double * dWork, int * iWork)
+{
+  NSNNWorkspace w;
   if (dWork == NULL || iWork == NULL)
   {
     fprintf(stderr, "nonSmoothNewtonNeighInitMemory, memory allocation failed.\n");
     exit(EXIT_FAILURE);
   }
-  sN = n;
-  sN2 = n * n;
-  sphi_z = dWork;//(double*)malloc(n*sizeof(*phi_z));
-  sdir_descent = sphi_z + sN;//(double*)malloc(n*sizeof(double));
-  sphi_zaux = sdir_descent + sN ; //(double*)malloc(n*sizeof(double));
-  sjacobianPhi_z = sphi_zaux + sN; //(double*)malloc(n2*sizeof(*jacobianPhi_z));
-  sjacobianPhi_zaux = sjacobianPhi_z + sN2;//(double*)malloc(n2*sizeof(double));
-  sgrad_psi_z = sjacobianPhi_zaux + sN2;//(double*)malloc(n*sizeof(*jacobian_psi_z));
-  sgrad_psi_zaux = sgrad_psi_z + sN;//(double*)malloc(n*sizeof(double));
-  sPrevDirDescent = sgrad_psi_zaux + sN;//(double*)malloc((n)*sizeof(double));
-  szaux = sPrevDirDescent + sN;//(double*)malloc(n*sizeof(double));
-  szzaux = szaux + sN; //(double*)malloc(n*sizeof(double));
-  sz2 = szzaux + sN;// size n
-
-
-  sipiv = iWork;//(int *)malloc(n*sizeof(*ipiv));
-  sW2V = sipiv + sN;
-
-  return sz2 + sN;
-
+  return NSNN_setWorkspace(&w, n, dWork, iWork);
 }
 
 
-int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, int* iparam, double* dparam)
+int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, void* data,
+                         int* iparam, double* dparam, double * dWork, int * iWork)
 {
+  NSNNWorkspace workspace;
+  NSNNWorkspace * w = &workspace;
 
 
   int itermax = iparam[0]; // maximum number of iterations allowed
@@ -446,8 +318,10 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
   int niter = 0; // current iteration number
   double tolerance = dparam[0];
   /*   double coef; */
-  sFphi = phi;
-  sFjacobianPhi = jacobianPhi;
+  NSNN_setWorkspace(w, n, dWork, iWork);
+  w->phi = phi;
+  w->jacobianPhi = jacobianPhi;
+  w->data = data;
   //  verbose=1;
   if (verbose > 0)
   {
@@ -488,24 +362,17 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
   /** Iterations ... */
   while ((niter < itermax) && (terminationCriterion > tolerance))
   {
-    scmp++;
     ++niter;
     /** Computes phi and its jacobian */
-    if (sZsol)
-    {
-      for (ii = 0; ii < sN; ii++)
-        szzaux[ii] = sZsol[ii] - z[ii];
-      printf("dist zzsol %.32e.\n", cblas_dnrm2(n, szzaux, 1));
-    }
 
-    (*sFphi)(n, z, sphi_z, 0);
-    (*sFjacobianPhi)(n, z, sjacobianPhi_z, 1);
+    (*w->phi)(w->data, n, z, w->phi_z, 0);
+    (*w->jacobianPhi)(w->data, n, z, w->jacobianPhi_z, 1);
     /* Computes the jacobian of the merit function, jacobian_psi = transpose(jacobianPhiMatrix).phiVector */
-    cblas_dgemv(CblasColMajor,CblasTrans, n, n, 1.0, sjacobianPhi_z, n, sphi_z, incx, 0.0, sgrad_psi_z, incx);
-    norm_jacobian_psi_z = cblas_dnrm2(n, sgrad_psi_z, 1);
+    cblas_dgemv(CblasColMajor,CblasTrans, n, n, 1.0, w->jacobianPhi_z, n, w->phi_z, incx, 0.0, w->grad_psi_z, incx);
+    norm_jacobian_psi_z = cblas_dnrm2(n, w->grad_psi_z, 1);
 
     /* Computes norm2(phi) */
-    normPhi_z = cblas_dnrm2(n, sphi_z, 1);
+    normPhi_z = cblas_dnrm2(n, w->phi_z, 1);
     /* Computes merit function */
     psi_z = 0.5 * normPhi_z * normPhi_z;
 
@@ -532,37 +399,13 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
         resls = 1;
         /*   if (NbLookingForANewZ % 10 ==1 && 0){
           printf("Try NonMonotomnelineSearch\n");
-          cblas_dcopy(n,sgrad_psi_z,1,sdir_descent,1);
-          cblas_dscal( n , -1.0 ,sdir_descent,incx);
+          cblas_dcopy(n,w->grad_psi_z,1,w->dir_descent,1);
+          cblas_dscal( n , -1.0 ,w->dir_descent,incx);
           NonMonotomnelineSearch( z,  phi, 10);
           continue;
         }
         */
 
-        /* FOR DEBUG ONLY*/
-        if (sZsol)
-        {
-          printf("begin plot prev dir\n");
-          plotMerit(z, 0, 0);
-          printf("end\n");
-          /*     gets(&c);*/
-          (*sFphi)(n, sZsol, szaux, 0);
-          printf("value psi(zsol)=%e\n", cblas_dnrm2(n, szaux, 1));
-          cblas_dcopy(n, sZsol, incx, szaux, incx);
-          cblas_daxpy(n , -1 , z , 1 , szaux , 1);
-          printf("dist to sol %e \n", cblas_dnrm2(n, szaux, 1));
-          for (ii = 0; ii < n; ii++)
-            sdir_descent[ii] = sZsol[ii] - z[ii];
-
-          aux = norm;
-          norm = 1;
-          printf("begin plot zzsol dir\n");
-          plotMerit(z, 0, 0);
-          printf("end\n");
-          /*     gets(&c);*/
-          norm = aux;
-        }
-
         printf("looking for a new Z...\n");
         /*may be a local minimal*/
         /*find a gradiant going out of this cul-de-sac.*/
@@ -573,47 +416,24 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
 
           for (i = 0; i < n; i++)
           {
-            if (sZsol)
-            {
-              /* FOR DEBUG ONLY*/
-              (*sFphi)(n, sZsol, sphi_zaux, 0);
-              norm = cblas_dnrm2(n, sphi_zaux, 1);
-              printf("Norm of the sol %e.\n", norm);
-
-              for (ii = 0; ii < n; ii++)
-                sdir_descent[ii] = sZsol[ii] - z[ii];
-              norm = 1;
-            }
-            else
+            for (ii = 0; ii < n; ii++)
             {
-              for (ii = 0; ii < n; ii++)
-              {
-                sdir_descent[ii] = 1.0 * rand();
-              }
-              cblas_dscal(n, 1 / cblas_dnrm2(n, sdir_descent, 1), sdir_descent, incx);
-              cblas_dscal(n, norm, sdir_descent, incx);
+              w->dir_descent[ii] = 1.0 * rand();
             }
-            cblas_dcopy(n, z, incx, szaux, incx);
+            cblas_dscal(n, 1 / cblas_dnrm2(n, w->dir_descent, 1), w->dir_descent, incx);
+            cblas_dscal(n, norm, w->dir_descent, incx);
+            cblas_dcopy(n, z, incx, w->zaux, incx);
             // cblas_dscal(n,0.0,zaux,incx);
             /* zaux = z + dir */
-            cblas_daxpy(n , norm , sdir_descent , 1 , szaux , 1);
+            cblas_daxpy(n , norm , w->dir_descent , 1 , w->zaux , 1);
             /* Computes the jacobian of the merit function, jacobian_psi_zaux = transpose(jacobianPhi_zaux).phi_zaux */
-            (*sFphi)(n, szaux, sphi_zaux, 0);
-            (*sFjacobianPhi)(n, szaux, sjacobianPhi_zaux, 1);
-
-            /* FOR DEBUG ONLY*/
-            if (sZsol)
-            {
-              aux = cblas_dnrm2(n, sphi_zaux, 1);
-              printf("Norm of the sol is now %e.\n", aux);
-              for (ii = 0; ii < n; ii++)
-                printf("zsol %e zaux %e \n", sZsol[ii], szaux[ii]);
-            }
+            (*w->phi)(w->data, n, w->zaux, w->phi_zaux, 0);
+            (*w->jacobianPhi)(w->data, n, w->zaux, w->jacobianPhi_zaux, 1);
 
 
-            cblas_dgemv(CblasColMajor, CblasTrans, n, n, 1.0, sjacobianPhi_zaux, n, sphi_zaux, incx, 0.0, sgrad_psi_zaux, incx);
-            cblas_dcopy(n, szaux, 1, szzaux, 1);
-            cblas_daxpy(n , -1 , z , incx , szzaux , incx);
+            cblas_dgemv(CblasColMajor, CblasTrans, n, n, 1.0, w->jacobianPhi_zaux, n, w->phi_zaux, incx, 0.0, w->grad_psi_zaux, incx);
+            cblas_dcopy(n, w->zaux, 1, w->zzaux, 1);
+            cblas_daxpy(n , -1 , z , incx , w->zzaux , incx);
             /*zzaux must be a descente direction.*/
             /*ie jacobian_psi_zaux.zzaux <0
             printf("jacobian_psi_zaux : \n");*/
@@ -621,16 +441,16 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
             plotMerit(z, phi);*/
 
 
-            aux = cblas_ddot(n, sgrad_psi_zaux, 1, szzaux, 1);
+            aux = cblas_ddot(n, w->grad_psi_zaux, 1, w->zzaux, 1);
             /*       aux1 = cblas_dnrm2(n,szzaux,1);
-            aux1 = cblas_dnrm2(n,sgrad_psi_zaux,1);*/
-            aux = aux / (cblas_dnrm2(n, szzaux, 1) * cblas_dnrm2(n, sgrad_psi_zaux, 1));
+            aux1 = cblas_dnrm2(n,w->grad_psi_zaux,1);*/
+            aux = aux / (cblas_dnrm2(n, w->zzaux, 1) * cblas_dnrm2(n, w->grad_psi_zaux, 1));
             /*       printf("aux: %e\n",aux);*/
             if (aux < 0.1 * (j + 1))
             {
               //zaux is the new point.
               findNewZ = 1;
-              cblas_dcopy(n, szaux, incx, z, incx);
+              cblas_dcopy(n, w->zaux, incx, z, incx);
               break;
             }
           }
@@ -667,14 +487,14 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
     Find a solution dk of jacobianPhiMatrix.d = -phiVector.
     dk is saved in phiVector.
     */
-    cblas_dscal(n , -1.0 , sphi_z, incx);
-    DGESV(n, 1, sjacobianPhi_z, n, sipiv, sphi_z, n, &infoDGESV);
+    cblas_dscal(n , -1.0 , w->phi_z, incx);
+    DGESV(n, 1, w->jacobianPhi_z, n, w->ipiv, w->phi_z, n, &infoDGESV);
     if (infoDGESV)
     {
       printf("DGEV error %d.\n", infoDGESV);
     }
-    cblas_dcopy(n, sphi_z, 1, sdir_descent, 1);
-    criterion = cblas_dnrm2(n, sdir_descent, 1);
+    cblas_dcopy(n, w->phi_z, 1, w->dir_descent, 1);
+    criterion = cblas_dnrm2(n, w->dir_descent, 1);
     /*      printf("norm dir descent %e\n",criterion);*/
 
     /*printf("begin plot descent dir\n");
@@ -689,18 +509,18 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
 
 
     /*
-    norm = cblas_dnrm2(n,sdir_descent,1);
+    norm = cblas_dnrm2(n,w->dir_descent,1);
     printf("norm desc %e \n",norm);
-    cblas_dscal( n , 1/norm , sdir_descent, 1);
+    cblas_dscal( n , 1/norm , w->dir_descent, 1);
     */
     /* descentCondition = jacobian_psi.dk */
-    descentCondition = cblas_ddot(n, sgrad_psi_z,  1,  sdir_descent, 1);
+    descentCondition = cblas_ddot(n, w->grad_psi_z,  1,  w->dir_descent, 1);
 
     /* Criterion to be satisfied: error < -rho*norm(dk)^p */
     criterion = -rho * pow(criterion, p);
     /*      printf("ddddddd %d\n",scmp);
     if (scmp>100){
-    NM_dense_display(sjacobianPhi_z,n,n,n);
+    NM_dense_display(w->jacobianPhi_z,n,n,n);
     exit(1);
     }*/
 
@@ -718,8 +538,8 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
 //    }
     /*      coef=fabs(norm_jacobian_psi_z*norm_jacobian_psi_z/descentCondition);
     if (coef <1){
-    cblas_dscal(n,coef,sdir_descent,incx);
-    printf("coef %e norm dir descent is now %e\n",coef,cblas_dnrm2(n,sdir_descent,1));
+    cblas_dscal(n,coef,w->dir_descent,incx);
+    printf("coef %e norm dir descent is now %e\n",coef,cblas_dnrm2(n,w->dir_descent,1));
     }*/
 
 
@@ -733,7 +553,7 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
     }*/
     /*      memcpy(oldz,z,n*sizeof(double));*/
 
-    resls = linesearch2_Armijo(n, z, psi_z, descentCondition);
+    resls = linesearch2_Armijo(w, n, z, psi_z, descentCondition);
     if (!resls && niter > 1)
     {
 
@@ -747,9 +567,9 @@ int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctio
 
     /*      lineSearch_Wolfe(z, descentCondition, phi,jacobianPhi);*/
     /*      if (niter>3){
-    printf("angle between prev dir %e.\n",acos(cblas_ddot(n, sdir_descent,  1,  sPrevDirDescent, 1)/(cblas_dnrm2(n,sdir_descent,1)*cblas_dnrm2(n,sPrevDirDescent,1))));
+    printf("angle between prev dir %e.\n",acos(cblas_ddot(n, w->dir_descent,  1,  w->prevDirDescent, 1)/(cblas_dnrm2(n,w->dir_descent,1)*cblas_dnrm2(n,w->prevDirDescent,1))));
     }*/
-    cblas_dcopy(n, sdir_descent, 1, sPrevDirDescent, 1);
+    cblas_dcopy(n, w->dir_descent, 1, w->prevDirDescent, 1);
 
     /*      for (j=20;j<32;j++){
     if (z[j]<0)
@@ -38,16 +38,31 @@ extern "C"
 {
 #endif
 
+  /** check the work memory of the solver
+   * \param n size of the problem
+   * \param dWork double work memory of nonSmoothNewtonNeigh_getNbDWork() doubles
+   * \param iWork integer work memory of nonSmoothNewtonNeigh_getNbIWork() integers
+   * \return the end of the part of dWork used by the solver
+   */
   double* nonSmoothNewtonNeighInitMemory(int n, double * dWork, int * iWork);
 
-  int nonSmoothNewtonNeigh(int, double*, NewtonFunctionPtr*, NewtonFunctionPtr*, int*, double*);
+  /** solve \f$ \phi(z) = 0 \f$
+   * \param n size of the problem
+   * \param z the unknown, initial guess on input
+   * \param phi the function \f$ \phi \f$
+   * \param jacobianPhi its jacobian
+   * \param data the context given to phi and jacobianPhi
+   * \param iparam integer parameters (maximum number of iterations, number of iterations)
+   * \param dparam double parameters (tolerance, error)
+   * \param dWork double work memory, see nonSmoothNewtonNeighInitMemory()
+   * \param iWork integer work memory, see nonSmoothNewtonNeighInitMemory()
+   * \return 0 if successful
+   */
+  int nonSmoothNewtonNeigh(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, void* data,
+                           int* iparam, double* dparam, double * dWork, int * iWork);
 
   int nonSmoothNewtonNeigh_getNbIWork(int n, int m);
   int nonSmoothNewtonNeigh_getNbDWork(int n, int m);
-
-  /*only for debug*/
-  void NSNN_thisIsTheSolution(int n, double * z);
-  void  NSNN_reset(void);
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
 #endif
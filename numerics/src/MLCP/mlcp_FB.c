@@ -28,15 +28,17 @@
 #include "FischerBurmeister.h"
 #include "numerics_verbose.h"
 
-static int sN = 0;
-static int sM = 0;
-static MixedLinearComplementarityProblem* sProblem;
-static double* sFz = 0;
-static double sMaxError = 0;
+/* The problem and F(z) = Mz + q, given to the Fischer-Burmeister
+   functions by the Newton solver. */
+typedef struct
+{
+  MixedLinearComplementarityProblem* problem;
+  double* Fz;
+} MLCPFBData;
 
-static void computeFz(double* z);
-static void F_MCPFischerBurmeister(int size, double* z, double* FBz, int a);
-static void jacobianF_MCPFischerBurmeister(int size, double* z, double* jacobianFMatrix, int a);
+static void computeFz(MLCPFBData* d, double* z);
+static void F_MCPFischerBurmeister(void* data, int size, double* z, double* FBz, int a);
+static void jacobianF_MCPFischerBurmeister(void* data, int size, double* z, double* jacobianFMatrix, int a);
 
 
 int mixedLinearComplementarity_fb_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
@@ -60,29 +62,29 @@ int mlcp_FB_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions
 }
 
 
-void computeFz(double* z)
+void computeFz(MLCPFBData* d, double* z)
 {
   int incx = 1, incy = 1;
-  int size = sN + sM;
+  int size = d->problem->n + d->problem->m;
   //F(z)=Mz+q
-  cblas_dcopy(size , sProblem->q , incx , sFz , incy);
-  NM_gemv(1.0, sProblem->M, z, 1.0, sFz);
+  cblas_dcopy(size , d->problem->q , incx , d->Fz , incy);
+  NM_gemv(1.0, d->problem->M, z, 1.0, d->Fz);
 }
 
-void F_MCPFischerBurmeister(int size, double* z, double* FBz, int a)
+void F_MCPFischerBurmeister(void* data, int size, double* z, double* FBz, int a)
 {
-
-  computeFz(z);
-  phi_Mixed_FB(sN, sM, z, sFz, FBz);
+  MLCPFBData* d = (MLCPFBData*)data;
+  computeFz(d, z);
+  phi_Mixed_FB(d->problem->n, d->problem->m, z, d->Fz, FBz);
 }
 
 /** writes \f$ \nabla_z F(z) \f$  using MLCP formulation and the Fischer-Burmeister function.
  */
-void jacobianF_MCPFischerBurmeister(int size, double* z, double* jacobianFMatrix, int a)
+void jacobianF_MCPFischerBurmeister(void* data, int size, double* z, double* jacobianFMatrix, int a)
 {
-
-  computeFz(z);
-  jacobianPhi_Mixed_FB(sN, sM, z, sFz, sProblem->M->matrix0, jacobianFMatrix);
+  MLCPFBData* d = (MLCPFBData*)data;
+  computeFz(d, z);
+  jacobianPhi_Mixed_FB(d->problem->n, d->problem->m, z, d->Fz, d->problem->M->matrix0, jacobianFMatrix);
 }
 
 
@@ -91,13 +93,11 @@ void mlcp_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* opt
 {
 
   /*
-     Initialize solver (Connect F and its jacobian, set local size ...) according to the chosen formulation.
+     Check the work memory: F(z) is stored at the beginning of dWork,
+     followed by the memory of the Newton solver.
   */
-  sProblem = problem;
-  sN = problem->n;
-  sM = problem->m;
-  sFz = options->dWork;
-  double * last = nonSmoothNewtonNeighInitMemory(sN + sM, options->dWork + sN + sM, options->iWork);
+  int size = problem->n + problem->m;
+  double * last = nonSmoothNewtonNeighInitMemory(size, options->dWork + size, options->iWork);
   double * tlast = options->dWork + mlcp_FB_getNbDWork(problem, options);
   if (last > tlast)
   {
@@ -109,14 +109,17 @@ void mlcp_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* opt
 
 void mlcp_FB_reset()
 {
-  NSNN_reset();
-  /*free(sFz) ;*/
 }
 
 
 void mlcp_FB(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
   *info = 1;
+  int n = problem->n;
+  int m = problem->m;
+  MLCPFBData data;
+  data.problem = problem;
+  data.Fz = options->dWork;
 
   NewtonFunctionPtr F = &F_MCPFischerBurmeister;
   NewtonFunctionPtr jacobianF = &jacobianF_MCPFischerBurmeister;
@@ -124,33 +127,32 @@ void mlcp_FB(MixedLinearComplementarityProblem* problem, double *z, double *w, i
   double tol = options->dparam[0];
   int i;
   /*only for debug
-  double * zz = (double *)malloc((sN+sM)*sizeof(double));
-  memcpy(zz,z,(sN+sM)*sizeof(double));*/
+  double * zz = (double *)malloc((n+m)*sizeof(double));
+  memcpy(zz,z,(n+m)*sizeof(double));*/
 
 
-  *info = nonSmoothNewtonNeigh(sN + sM, z, &F, &jacobianF, options->iparam, options->dparam);
+  *info = nonSmoothNewtonNeigh(n + m, z, &F, &jacobianF, &data, options->iparam, options->dparam,
+                               options->dWork + n + m, options->iWork);
   if (*info > 0)
   {
     fprintf(stderr, "Numerics, mlcp_FB failed, reached max. number of iterations without convergence. Residual = %f\n", options->dparam[1]);
     /*ONLY FOR DEBUG
       mixedLinearComplementarity_display(problem);
     printf("with z init;\n");
-    for (i=0;i<sN+sM;i++)
+    for (i=0;i<n+m;i++)
     printf("%.32e \n",zz[i]);
     exit(1);*/
   }
   /*  free(zz);*/
   mlcp_compute_error(problem, z, w, tol, &err);
-  for (i = 0; i < sM; i++)
+  for (i = 0; i < m; i++)
   {
-    if (z[sN + i] > w[sN + i])
-      w[sN + i] = 0;
+    if (z[n + i] > w[n + i])
+      w[n + i] = 0;
   }
 
-  if (err > sMaxError)
-    sMaxError = err;
   if (verbose || 1)
-    printf("FB : MLCP Solved, error %10.10f   and max error  %10.10f \n", err, sMaxError);
+    printf("FB : MLCP Solved, error %10.10f \n", err);
 
   return;
 }
@@ -46,262 +46,336 @@ dim(v)=nn
 #include "numerics_verbose.h"
 
 #define DIRECT_SOLVER_USE_DGETRI
-double * sVBuf;
 
-struct dataComplementarityConf
+/* A complementarity configuration and the factors of its linear system. */
+typedef struct
 {
   int * zw; /*zw[i] == 0 means w null and z >=0*/
-  double * M;
-  struct dataComplementarityConf * next;
-  struct dataComplementarityConf * prev;
-  int Usable;
-  int used;
+  double * M; /* inverse (or LU factors) of the matrix of the configuration */
   lapack_int* IPV;
-};
+  unsigned int hash; /* hash of zw */
+  int Usable;
+  int stamp; /* last call of mlcp_direct that tried the configuration */
+  int prev; /* more recently used configuration, or -1 */
+  int next; /* less recently used configuration, or -1 */
+  int nextInBucket; /* next configuration in the same bucket, or -1 */
+} dataComplementarityConf;
+
+/* The cache of the configurations, stored in options->solverData. The
+ * configurations are found from their zw pattern with a hash table and
+ * kept in a list from the most recently used to the least recently
+ * used one, which is replaced when the cache is full. */
+typedef struct
+{
+  int n;
+  int m;
+  int npm;
+  int maxNumberOfCC; /* bound on the number of configurations */
+  int numberOfCC;
+  double tolneg;
+  double tolpos;
+  int problemChanged;
+  dataComplementarityConf * CC;
+  int * buckets; /* first configuration of each bucket, or -1 */
+  unsigned int nbBuckets; /* a power of 2 */
+  int first; /* most recently used configuration, or -1 */
+  int last; /* least recently used configuration, or -1 */
+  int stamp;
+  double * Q;
+  double * VBuf;
+  int * zwBuf;
+  unsigned long hits;
+  unsigned long misses;
+} dataMLCPDirect;
+
+static unsigned int hashConfig(int * zw, int m)
+{
+  /* FNV-1a on the pattern */
+  unsigned int h = 2166136261u;
+  int i;
+  for (i = 0; i < m; i++)
+  {
+    h ^= (unsigned int)(zw[i] != 0);
+    h *= 16777619u;
+  }
+  return h;
+}
 
-static double * spCurDouble = 0;
-static int * spCurInt = 0;
-static double * sQ = 0;
-static int sNumberOfCC = 0;
-static int sMaxNumberOfCC = 0;
-static struct dataComplementarityConf * spFirstCC = 0;
-static struct dataComplementarityConf * spCurCC = 0;
-static double sTolneg = 0;
-static double sTolpos = 0;
-static int sN;
-static int sM;
-static int sNbLines;
-static int sNpM;
-static int* spIntBuf;
-static int sProblemChanged = 0;
+static int sameConfig(int * zw1, int * zw2, int m)
+{
+  int i;
+  for (i = 0; i < m; i++)
+    if ((zw1[i] != 0) != (zw2[i] != 0))
+      return 0;
+  return 1;
+}
+
+static int findConfig(dataMLCPDirect * data, int * zw, unsigned int hash)
+{
+  int i = data->buckets[hash & (data->nbBuckets - 1)];
+  while (i >= 0)
+  {
+    dataComplementarityConf * cc = &data->CC[i];
+    if (cc->hash == hash && sameConfig(cc->zw, zw, data->m))
+      return i;
+    i = cc->nextInBucket;
+  }
+  return -1;
+}
 
-static double * mydMalloc(int n);
-static int * myiMalloc(int n);
-static int internalPrecompute(MixedLinearComplementarityProblem* problem);
-static int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int init);
-static int solveWithCurConfig(MixedLinearComplementarityProblem* problem);
-//static int nbConfig(struct dataComplementarityConf * pC);
+static void bucketInsert(dataMLCPDirect * data, int i)
+{
+  int * bucket = &data->buckets[data->CC[i].hash & (data->nbBuckets - 1)];
+  data->CC[i].nextInBucket = *bucket;
+  *bucket = i;
+}
 
-double * mydMalloc(int n)
+static void bucketRemove(dataMLCPDirect * data, int i)
 {
-  double * aux = spCurDouble;
-  spCurDouble = spCurDouble + n;
-  return aux;
+  int * pos = &data->buckets[data->CC[i].hash & (data->nbBuckets - 1)];
+  while (*pos != i)
+    pos = &data->CC[*pos].nextInBucket;
+  *pos = data->CC[i].nextInBucket;
 }
-int * myiMalloc(int n)
+
+static void unlinkConfig(dataMLCPDirect * data, int i)
 {
-  int * aux = spCurInt;
-  spCurInt = spCurInt + n;
-  return aux;
+  dataComplementarityConf * cc = &data->CC[i];
+  if (cc->prev >= 0)
+    data->CC[cc->prev].next = cc->next;
+  else
+    data->first = cc->next;
+  if (cc->next >= 0)
+    data->CC[cc->next].prev = cc->prev;
+  else
+    data->last = cc->prev;
+  cc->prev = cc->next = -1;
 }
-// XXX this is going to fail
-static lapack_int * myiMalloc2(int n)
+
+static void pushFrontConfig(dataMLCPDirect * data, int i)
 {
-  lapack_int * aux = (lapack_int*)spCurInt;
-  spCurInt = (int*)&aux[n];
-  return aux;
+  dataComplementarityConf * cc = &data->CC[i];
+  cc->prev = -1;
+  cc->next = data->first;
+  if (data->first >= 0)
+    data->CC[data->first].prev = i;
+  else
+    data->last = i;
+  data->first = i;
 }
 
 int mlcp_direct_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  return (problem->n + problem->m) * (options->iparam[5] + 1) + options->iparam[5] * problem->m;
+  return 0;
 }
 int mlcp_direct_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  return  problem->n + problem->m + (options->iparam[5]) * ((problem->n + problem->m) * (problem->n + problem->m)) + (problem->n + problem->m);
+  return 0;
 }
 
 /*
- *options->iparam[5] : n0 number of possible configuration
+ *options->iparam[5] : n0 maximum number of configurations in the cache
  *options->dparam[5] : tol
  *options->iparam[7] : number of failed
  *options->iparam[8] : mlcp problem hab been changed since the previous execution.
- *options->iWork : double work memory of size (n + m)*(n0+1) + nO*m
- *options->dWork : double work memory of size n + m + n0*(n+m)*(n+m)
+ *options->solverData : the cache, allocated here and freed by mlcp_direct_reset
  *
  *
  */
 
 void mlcp_direct_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  spCurDouble = options->dWork;
-  spCurInt = options->iWork;
-  sMaxNumberOfCC = options->iparam[5];
-  sTolneg = options->dparam[5];
-  sTolpos = options->dparam[6];
-  options->iparam[7] = 0;
-  sProblemChanged = options->iparam[8];
-  sN = problem->n;
-  sM = problem->m;
-  sNbLines = problem->n + problem->m;
-  if (problem->M->size0 != sNbLines)
+  dataMLCPDirect * data;
+  int i;
+  if (options->solverData)
+    mlcp_direct_reset(options);
+
+  if (problem->M->size0 != problem->n + problem->m)
   {
     printf("mlcp_direct_init : M rectangular, not yet managed\n");
     exit(1);
   }
 
+  data = (dataMLCPDirect *) malloc(sizeof(dataMLCPDirect));
+  data->n = problem->n;
+  data->m = problem->m;
+  data->npm = problem->n + problem->m;
+  data->maxNumberOfCC = options->iparam[5] > 0 ? options->iparam[5] : 0;
+  data->numberOfCC = 0;
+  data->tolneg = options->dparam[5];
+  data->tolpos = options->dparam[6];
+  data->problemChanged = options->iparam[8];
+  options->iparam[7] = 0;
+
   if (verbose)
-    printf("n= %d  m= %d /n sTolneg= %lf sTolpos= %lf \n", sN, sM, sTolneg, sTolpos);
+    printf("n= %d  m= %d /n sTolneg= %lf sTolpos= %lf \n", data->n, data->m, data->tolneg, data->tolpos);
 
-  sNpM = sN + sM;
-  spCurCC = 0;
-  spFirstCC = 0;
-  sNumberOfCC = 0;
-  sQ = mydMalloc(sNpM);
-  sVBuf = mydMalloc(sNpM);
-  spIntBuf = myiMalloc(sNpM);
+  data->CC = data->maxNumberOfCC ?
+    (dataComplementarityConf *) malloc(data->maxNumberOfCC * sizeof(dataComplementarityConf)) : NULL;
+  data->nbBuckets = 1;
+  while (data->nbBuckets < 2 * (unsigned int)data->maxNumberOfCC)
+    data->nbBuckets <<= 1;
+  data->buckets = (int *) malloc(data->nbBuckets * sizeof(int));
+  for (i = 0; i < (int)data->nbBuckets; i++)
+    data->buckets[i] = -1;
+  data->first = -1;
+  data->last = -1;
+  data->stamp = 0;
+  data->Q = (double *) malloc(2 * data->npm * sizeof(double));
+  data->VBuf = data->Q + data->npm;
+  data->zwBuf = (int *) malloc((data->m > 0 ? data->m : 1) * sizeof(int));
+  data->hits = 0;
+  data->misses = 0;
+  options->solverData = data;
 }
-void mlcp_direct_reset()
+void mlcp_direct_reset(SolverOptions* options)
 {
-  struct dataComplementarityConf * aux;
-  while (spFirstCC)
+  dataMLCPDirect * data = (dataMLCPDirect *) options->solverData;
+  int i;
+  if (!data)
+    return;
+  for (i = 0; i < data->numberOfCC; i++)
   {
-    aux = spFirstCC;
-    spFirstCC = spFirstCC->next;
-    free(aux);
+    free(data->CC[i].zw);
+    free(data->CC[i].M);
+    free(data->CC[i].IPV);
   }
+  free(data->CC);
+  free(data->buckets);
+  free(data->Q);
+  free(data->zwBuf);
+  free(data);
+  options->solverData = NULL;
 }
-int internalPrecompute(MixedLinearComplementarityProblem* problem)
+void mlcp_direct_statistics(SolverOptions* options, int * numberOfConfigurations,
+                            unsigned long * hits, unsigned long * misses)
+{
+  dataMLCPDirect * data = (dataMLCPDirect *) options->solverData;
+  *numberOfConfigurations = data ? data->numberOfCC : 0;
+  *hits = data ? data->hits : 0;
+  *misses = data ? data->misses : 0;
+}
+static int internalPrecompute(MixedLinearComplementarityProblem* problem, dataMLCPDirect * data,
+                              dataComplementarityConf * cc)
 {
   lapack_int INFO = 0;
-  mlcp_buildM(spFirstCC->zw, spFirstCC->M, problem->M->matrix0, sN, sM, sNbLines);
+  int npm = data->npm;
+  mlcp_buildM(cc->zw, cc->M, problem->M->matrix0, data->n, data->m, npm);
   if (verbose)
   {
     printf("mlcp_direct, precomputed M :\n");
-    NM_dense_display(spFirstCC->M, sNpM, sNpM, 0);
+    NM_dense_display(cc->M, npm, npm, 0);
   }
-  if (!(spFirstCC->Usable))
-    return 0;
-  DGETRF(sNpM, sNpM, spFirstCC->M, sNpM, spFirstCC->IPV, &INFO);
+  cc->Usable = 1;
+  DGETRF(npm, npm, cc->M, npm, cc->IPV, &INFO);
   if (INFO)
   {
-    spFirstCC->Usable = 0;
+    cc->Usable = 0;
     printf("mlcp_direct, internalPrecompute  error, LU impossible\n");
     return 0;
   }
 #ifdef DIRECT_SOLVER_USE_DGETRI
-  DGETRI(sNpM, spFirstCC->M, sNpM, spFirstCC->IPV, &INFO);
+  DGETRI(npm, cc->M, npm, cc->IPV, &INFO);
   if (INFO)
   {
-    spFirstCC->Usable = 1;
+    cc->Usable = 0;
     printf("mlcp_direct error, internalPrecompute  DGETRI impossible\n");
     return 0;
   }
 #endif
   return 1;
 }
-/*memory management about floatWorkingMem and intWorkingMem*/
-int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int init)
+/*memory management about dataComplementarityConf*/
+void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw, SolverOptions* options)
 {
+  dataMLCPDirect * data = (dataMLCPDirect *) options->solverData;
+  dataComplementarityConf * cc;
+  unsigned int hash;
   int i;
+  if (!data || !data->maxNumberOfCC)
+    return;
   if (verbose)
   {
     printf("mlcp_direct internalAddConfig\n");
     printf("---------\n");
-    for (i = 0; i < problem->m; i++)
+    for (i = 0; i < data->m; i++)
       printf("zw[%d]=%d\t", i, zw[i]);
     printf("\n");
   }
-  if (init)
-  {
-    spFirstCC->zw = myiMalloc(sM);
-    spFirstCC->IPV = myiMalloc2(sNpM);
-    spFirstCC->M = mydMalloc(sNpM * sNpM);
-  }
-  for (i = 0; i < sM; i++)
+  hash = hashConfig(zw, data->m);
+  i = findConfig(data, zw, hash);
+  if (i >= 0) /*Already known, factorized again*/
   {
-    spFirstCC->zw[i] = zw[i];
+    unlinkConfig(data, i);
+    cc = &data->CC[i];
   }
-  return internalPrecompute(problem);
-}
-/*memory management about dataComplementarityConf*/
-void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw)
-{
-  if (sNumberOfCC < sMaxNumberOfCC) /*Add a configuration*/
+  else
   {
-    sNumberOfCC++;
-    if (spFirstCC == 0) /*first add*/
-    {
-      spFirstCC = (struct dataComplementarityConf *) malloc(sizeof(struct dataComplementarityConf));
-      spFirstCC->Usable = 1;
-      spCurCC = spFirstCC;
-      spFirstCC->prev = 0;
-      spFirstCC->next = 0;
-    }
-    else
+    if (data->numberOfCC < data->maxNumberOfCC) /*Add a configuration*/
     {
-      spFirstCC->prev = (struct dataComplementarityConf *) malloc(sizeof(struct dataComplementarityConf));
-      spFirstCC->prev->Usable = 1;
-      spFirstCC->prev->next = spFirstCC;
-      spFirstCC = spFirstCC->prev;
-      spFirstCC->prev = 0;
+      i = data->numberOfCC++;
+      cc = &data->CC[i];
+      cc->zw = (int *) malloc((data->m > 0 ? data->m : 1) * sizeof(int));
+      cc->M = (double *) malloc(data->npm * data->npm * sizeof(double));
+      cc->IPV = (lapack_int *) malloc(data->npm * sizeof(lapack_int));
+      cc->prev = cc->next = -1;
     }
-    internalAddConfig(problem, zw, 1);
-  }
-  else /*Replace an old one*/
-  {
-    struct dataComplementarityConf * aux = spFirstCC;
-    while (aux->next) aux = aux->next;
-    if (aux->prev)
+    else /*Replace the least recently used one*/
     {
-      aux->prev->next = 0;
-      spFirstCC->prev = aux;
-      aux->prev = 0;
-      aux->next = spFirstCC;
-      spFirstCC = aux;
-      spFirstCC->Usable = 1;
+      i = data->last;
+      bucketRemove(data, i);
+      unlinkConfig(data, i);
+      cc = &data->CC[i];
     }
-    internalAddConfig(problem, zw, 0);
+    memcpy(cc->zw, zw, data->m * sizeof(int));
+    cc->hash = hash;
+    cc->stamp = data->stamp;
+    bucketInsert(data, i);
   }
+  pushFrontConfig(data, i);
+  internalPrecompute(problem, data, cc);
 }
-void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol)
+void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol, SolverOptions* options)
 {
+  dataMLCPDirect * data = (dataMLCPDirect *) options->solverData;
   int i;
-
-  for (i = 0; i < sM; i++)
+  if (!data)
+    return;
+  for (i = 0; i < data->m; i++)
   {
-    if (wSol[i] > sTolpos)
-      spIntBuf[i] = 1;
+    if (wSol[i] > data->tolpos)
+      data->zwBuf[i] = 1;
     else
-      spIntBuf[i] = 0;
+      data->zwBuf[i] = 0;
   }
-  mlcp_direct_addConfig(problem, spIntBuf);
+  mlcp_direct_addConfig(problem, data->zwBuf, options);
 }
 
 
 
-int solveWithCurConfig(MixedLinearComplementarityProblem* problem)
+static int solveWithConfig(MixedLinearComplementarityProblem* problem, dataMLCPDirect * data,
+                           dataComplementarityConf * cc)
 {
   int lin;
   lapack_int INFO = 0;
-  double ALPHA = 1;
-  double BETA = 0;
-  int INCX = 1;
-  int INCY = 1;
+  int npm = data->npm;
   double * solTest = 0;
-  /*  printf("cur config ");
-  for (int i=0;i<sM;i++)
-    if (spCurCC->zw[i])
-      printf("1");
-    else
-      printf("0");
-      printf("\n");*/
-  if (sProblemChanged)
-    internalPrecompute(problem);
-  if (!spCurCC->Usable)
+  if (data->problemChanged)
+    internalPrecompute(problem, data, cc);
+  if (!cc->Usable)
   {
     if (verbose)
       printf("solveWithCurConfig not usable\n");
     return 0;
   }
 #ifdef DIRECT_SOLVER_USE_DGETRI
-  cblas_dgemv(CblasColMajor,CblasNoTrans, sNpM, sNpM, ALPHA, spCurCC->M, sNpM, sQ, INCX, BETA, sVBuf, INCY);
-  solTest = sVBuf;
+  cblas_dgemv(CblasColMajor,CblasNoTrans, npm, npm, 1.0, cc->M, npm, data->Q, 1, 0.0, data->VBuf, 1);
+  solTest = data->VBuf;
 #else
-  for (lin = 0; lin < sNpM; lin++)
-    sQ[lin] =  - problem->q[lin];
-  DGETRS(LA_NOTRANS, sNpM, one, spCurCC->M, sNpM, spCurCC->IPV, sQ, sNpM, &INFO);
-  solTest = sQ;
+  for (lin = 0; lin < npm; lin++)
+    data->VBuf[lin] =  - problem->q[lin];
+  DGETRS(LA_NOTRANS, npm, 1, cc->M, npm, cc->IPV, data->VBuf, npm, &INFO);
+  solTest = data->VBuf;
 #endif
   if (INFO)
   {
@@ -311,103 +385,111 @@ int solveWithCurConfig(MixedLinearComplementarityProblem* problem)
   }
   else
   {
-    for (lin = 0 ; lin < sM; lin++)
+    for (lin = 0 ; lin < data->m; lin++)
     {
-      if (solTest[sN + lin] < - sTolneg)
+      if (solTest[data->n + lin] < - data->tolneg)
       {
         if (verbose)
-          printf("solveWithCurConfig Sol not in the positive cone because %lf\n", solTest[sN + lin]);
+          printf("solveWithCurConfig Sol not in the positive cone because %lf\n", solTest[data->n + lin]);
         return 0;
       }
     }
   }
-  /*  if (verbose)
-      printf("solveWithCurConfig Success\n");*/
   return 1;
 }
+
+/* After a failure of the configuration cc, the configuration in which
+ * the components of the wrong sign switch from z to w or from w to z,
+ * if it is in the cache and was not tried yet by this call. */
+static int guessConfig(dataMLCPDirect * data, dataComplementarityConf * cc)
+{
+  int lin, i;
+  if (!cc->Usable)
+    return -1;
+  for (lin = 0; lin < data->m; lin++)
+  {
+    data->zwBuf[lin] = cc->zw[lin];
+    if (data->VBuf[data->n + lin] < - data->tolneg)
+      data->zwBuf[lin] = !cc->zw[lin];
+  }
+  i = findConfig(data, data->zwBuf, hashConfig(data->zwBuf, data->m));
+  if (i >= 0 && data->CC[i].stamp == data->stamp)
+    return -1;
+  return i;
+}
 /*
- * The are no memory allocation in mlcp_direct, all necessary memory must be allocated by the user.
+ * The are no memory allocation in mlcp_direct, the configurations are
+ * stored by mlcp_direct_addConfig in the cache allocated by mlcp_direct_init.
  *
  *options:
- * iparam[5] : (in)  n0 number of possible configuration.
+ * iparam[5] : (in)  n0 maximum number of configurations.
  * dparam[5] : (in) a positive value, tolerane about the sign.
- * dWork : working float zone size : n + m + n0*(n+m)*(n+m)  . MUST BE ALLOCATED BY THE USER.
- * iWork : working int zone size : (n + m)*(n0+1) + nO*m. MUST BE ALLOCATED BY THE USER.
  * double *z : size n+m
  * double *w : size n+m
  * info : output. info == 0 if success
+ *
+ * The most recently used configuration is tried first. When it fails,
+ * the configuration with the components of the wrong sign switched is
+ * looked for in the cache, then the others are tried from the most
+ * recently used one.
  */
-/*int nbConfig(struct dataComplementarityConf * pC)
-{
-  struct dataComplementarityConf * paux = pC;
-  int nb = 0;
-  while (paux)
-  {
-    nb++;
-    paux = paux->next;
-  }
-  printf("number of conf :%d\n", nb);
-  return nb;
-
-}
-*/
-
 void mlcp_direct(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
+  dataMLCPDirect * data = (dataMLCPDirect *) options->solverData;
   int find = 0;
   int lin = 0;
-  if (!spFirstCC)
+  int cur, scan;
+  if (!data)
   {
     (*info) = 1;
+    return;
   }
-  else
+  if (data->first >= 0)
   {
-    spCurCC = spFirstCC;
 #ifdef DIRECT_SOLVER_USE_DGETRI
-    for (lin = 0; lin < sNpM; lin++)
-      sQ[lin] =  - problem->q[lin];
+    for (lin = 0; lin < data->npm; lin++)
+      data->Q[lin] =  - problem->q[lin];
 #endif
-    do
+    data->stamp++;
+    scan = data->first;
+    cur = scan;
+    while (cur >= 0)
     {
-      find = solveWithCurConfig(problem);
+      dataComplementarityConf * cc = &data->CC[cur];
+      cc->stamp = data->stamp;
+      find = solveWithConfig(problem, data, cc);
       if (find)
+        break;
+      cur = guessConfig(data, cc);
+      if (cur < 0)
       {
-#ifdef DIRECT_SOLVER_USE_DGETRI
-        mlcp_fillSolution(z, z + sN, w, w + sN, sN, sM, sNbLines, spCurCC->zw, sVBuf);
-#else
-        mlcp_fillSolution(z, z + sN, w, w + sN, sN, sM, sNbLines, spCurCC->zw, sQ);
-#endif
-        /*Current becomes first for the next step.*/
-        if (spCurCC != spFirstCC)
-        {
-          /*    nbConfig(spFirstCC);
-          nbConfig(spCurCC);
-          printf("bidouille pour devenir 1\n");*/
-          spCurCC->prev->next = spCurCC->next;
-          if (spCurCC->next)
-            spCurCC->next->prev = spCurCC->prev;
-          spFirstCC->prev = spCurCC;
-          spCurCC->next = spFirstCC;
-          spFirstCC = spCurCC;
-          spFirstCC->prev = 0;
-          /*    nbConfig(spFirstCC);*/
-        }
-      }
-      else
-      {
-        spCurCC = spCurCC->next;
+        while (scan >= 0 && data->CC[scan].stamp == data->stamp)
+          scan = data->CC[scan].next;
+        cur = scan;
       }
     }
-    while (spCurCC && !find);
-
     if (find)
     {
-      *info = 0;
-    }
-    else
-    {
-      options->iparam[7]++;
-      *info = 1;
+      mlcp_fillSolution(z, z + data->n, w, w + data->n, data->n, data->m, data->npm,
+                        data->CC[cur].zw, data->VBuf);
+      /*Current becomes first for the next step.*/
+      if (cur != data->first)
+      {
+        unlinkConfig(data, cur);
+        pushFrontConfig(data, cur);
+      }
     }
   }
+
+  if (find)
+  {
+    data->hits++;
+    *info = 0;
+  }
+  else
+  {
+    data->misses++;
+    options->iparam[7]++;
+    *info = 1;
+  }
 }
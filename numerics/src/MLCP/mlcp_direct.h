@@ -8,15 +8,30 @@
  * add configuration with mlcp_direct_addConfigFromWSolution to add configuration.
  * mlcp_direct_reset
  *
+ * The configurations are kept in a cache owned by the SolverOptions
+ * (options->solverData), so that several problems can be solved at
+ * the same time with different options. The cache holds at most
+ * options->iparam[5] configurations, each of them with a
+ * (n+m)x(n+m) matrix; the least recently used one is replaced when
+ * it is full.
  */
 
 
-void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw);
-void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol);
+void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw, SolverOptions* options);
+void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol, SolverOptions* options);
 void mlcp_direct_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_direct_reset(void);
+void mlcp_direct_reset(SolverOptions* options);
 
 int mlcp_direct_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 int mlcp_direct_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-  
+
+/** statistics of the cache of the configurations since mlcp_direct_init
+ * \param options the options owning the cache
+ * \param[out] numberOfConfigurations the number of configurations in the cache
+ * \param[out] hits the number of calls of mlcp_direct solved with a configuration of the cache
+ * \param[out] misses the number of calls of mlcp_direct without solution from the cache
+ */
+void mlcp_direct_statistics(SolverOptions* options, int * numberOfConfigurations,
+                            unsigned long * hits, unsigned long * misses);
+
 #endif //MLCP_DIRECT_H
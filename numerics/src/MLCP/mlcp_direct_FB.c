@@ -36,14 +36,6 @@ dim(v)=nn
 #include "mlcp_direct.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-static int * siWorkFB = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkFB = 0;
-static double * sdWorkDirect = 0;
-
 int mixedLinearComplementarity_directFB_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -75,28 +67,13 @@ int mlcp_direct_FB_getNbDWork(MixedLinearComplementarityProblem* problem, Solver
 
 void mlcp_direct_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkFB = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkFB = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
-
   mlcp_direct_init(problem, options);
-  options->dWork = sdWorkFB;
-  options->iWork = siWorkFB;
-
   mlcp_FB_init(problem, options);
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
-
 
 }
-void mlcp_direct_FB_reset()
+void mlcp_direct_FB_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(options);
   mlcp_FB_reset();
 }
 
@@ -108,8 +85,7 @@ void mlcp_direct_FB_reset()
  * dparam[0] : (in) a positive value, tolerane about the sign used by the path algo.
  * iparam[5] : (in)  n0 number of possible configuration.
  * dparam[5] : (in) a positive value, tolerane about the sign.
- * dWork : working float zone size : n + m + n0*(n+m)*(n+m)  . MUST BE ALLOCATED BY THE USER.
- * iWork : working int zone size : (n + m)*(n0+1) + nO*m. MUST BE ALLOCATED BY THE USER.
+ * solverData : the configurations of the direct solver, see mlcp_direct.h.
  * double *z : size n+m
  * double *w : size n+m
  * info : output. info == 0 if success
@@ -127,7 +103,7 @@ void mlcp_direct_FB(MixedLinearComplementarityProblem* problem, double *z, doubl
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, w + problem->n, options);
     }
   }
 }
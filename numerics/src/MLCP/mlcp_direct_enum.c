@@ -37,14 +37,6 @@ dim(v)=nn
 #include "mlcp_enum.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-static int * siWorkEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkDirect = 0;
-
 int mixedLinearComplementarity_directEnum_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -65,32 +57,20 @@ int mlcp_direct_enum_getNbDWork(MixedLinearComplementarityProblem* problem, Solv
 /*
  *options->iparam[5] : n0 number of possible configuration.
  * dparam[5] : (in) a positive value, tolerane about the sign.
- *options->iWork : double work memory of  mlcp_direct_enum_getNbIWork() integers  (2(nn+mm))+((n + m)*(n0+1) + nO*m)
- *options->dWork : double work memory of mlcp_direct_enum_getNbDWork() doubles  ((nn+mm)*(nn+mm) + 3*(nn+mm))+(n + m + n0*(n+m)*(n+m))
+ *options->iWork : double work memory of  mlcp_direct_enum_getNbIWork() integers  2(nn+mm)
+ *options->dWork : double work memory of mlcp_direct_enum_getNbDWork() doubles  (nn+mm)*(nn+mm) + 3*(nn+mm)
  *
  *
  */
 
 void mlcp_direct_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkEnum = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkEnum = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
   mlcp_direct_init(problem, options);
 
 }
-void mlcp_direct_enum_reset()
+void mlcp_direct_enum_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
-  siWorkEnum = 0;
-  siWorkDirect = 0;
-  sdWorkEnum = 0;
-  sdWorkDirect = 0;
+  mlcp_direct_reset(options);
 }
 
 /*
@@ -101,33 +81,28 @@ void mlcp_direct_enum_reset()
  * dparam[0] : (in) a positive value, tolerane about the sign used by the enum algo.
  * iparam[5] : (in)  n0 number of possible configuration.
  * dparam[5] : (in) a positive value, tolerane about the sign.
- * dWork : working float zone size : n + m + n0*(n+m)*(n+m)  . MUST BE ALLOCATED BY THE USER.
- * iWork : working int zone size : (n + m)*(n0+1) + nO*m. MUST BE ALLOCATED BY THE USER.
+ * solverData : the configurations of the direct solver, see mlcp_direct.h.
  * double *z : size n+m
  * double *w : size n+m
  * info : output. info == 0 if success
  */
 void mlcp_direct_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  if (!siWorkEnum)
+  if (!options->solverData)
   {
     *info = 1;
     printf("MLCP_DIRECT_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
     return;
   }
   /*First, try direct solver*/
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
   mlcp_direct(problem, z, w, info, options);
   if (*info)
   {
-    options->dWork = sdWorkEnum;
-    options->iWork = siWorkEnum;
     /*solver direct failed, so run the enum solver.*/
     mlcp_enum(problem, z, w, info, options);
     if (!(*info))
     {
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, w + problem->n, options);
     }
   }
 }
@@ -26,9 +26,6 @@
 #include "mlcp_direct.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
 int mixedLinearComplementarity_directPath_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -58,15 +55,13 @@ int mlcp_direct_path_getNbDWork(MixedLinearComplementarityProblem* problem, Solv
 
 void mlcp_direct_path_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
   mlcp_direct_init(problem, options);
   //mlcp_path_init(problem, options);
 
 }
-void mlcp_direct_path_reset()
+void mlcp_direct_path_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(options);
   //mlcp_path_reset();
 }
 
@@ -78,8 +73,7 @@ void mlcp_direct_path_reset()
  * dparam[0] : (in) a positive value, tolerane about the sign used by the path algo.
  * iparam[5] : (in)  n0 number of possible configuration.
  * dparam[5] : (in) a positive value, tolerane about the sign.
- * dWork : working float zone size : n + m + n0*(n+m)*(n+m)  . MUST BE ALLOCATED BY THE USER.
- * iWork : working int zone size : (n + m)*(n0+1) + nO*m. MUST BE ALLOCATED BY THE USER.
+ * solverData : the configurations of the direct solver, see mlcp_direct.h.
  * double *z : size n+m
  * double *w : size n+m
  * info : output. info == 0 if success
@@ -97,7 +91,7 @@ void mlcp_direct_path(MixedLinearComplementarityProblem* problem, double *z, dou
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, w + problem->n, options);
     }
   }
 }
@@ -27,10 +27,6 @@
 #include "mlcp_simplex.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-
 int mixedLinearComplementarity_directSimplex_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -60,15 +56,13 @@ int mlcp_direct_simplex_getNbDWork(MixedLinearComplementarityProblem* problem, S
 
 void mlcp_direct_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
   mlcp_direct_init(problem, options);
   mlcp_simplex_init(problem, options);
 
 }
-void mlcp_direct_simplex_reset()
+void mlcp_direct_simplex_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(options);
   mlcp_simplex_reset();
 }
 
@@ -80,8 +74,7 @@ void mlcp_direct_simplex_reset()
  * dparam[0] : (in) a positive value, tolerane about the sign used by the simplex algo.
  * iparam[5] : (in)  n0 number of possible configuration.
  * dparam[5] : (in) a positive value, tolerane about the sign.
- * dWork : working float zone size : n + m + n0*(n+m)*(n+m)  . MUST BE ALLOCATED BY THE USER.
- * iWork : working int zone size : (n + m)*(n0+1) + nO*m. MUST BE ALLOCATED BY THE USER.
+ * solverData : the configurations of the direct solver, see mlcp_direct.h.
  * double *z : size n+m
  * double *w : size n+m
  * info : output. info == 0 if success
@@ -99,7 +92,7 @@ void mlcp_direct_simplex(MixedLinearComplementarityProblem* problem, double *z,
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, w + problem->n, options);
     }
   }
 }
@@ -38,43 +38,14 @@ dim(v)=nn
 #include "mlcp_enum_tool.h"
 #include "SiconosLapack.h"
 #include "numerics_verbose.h"
+#include "complementarity_enum.h"
 
 //#ifdef HAVE_DGELS
 //#define ENUM_USE_DGELS
 //#endif
 
-#ifdef MLCP_DEBUG
-static int *sLastIWork;
-static double *sLastDWork;
-#endif
-
-static double * sQ = 0;
-static double * sColNul = 0;
-static double * sM = 0;
-static double * sMref = 0;
-static double * sQref = 0;
-/* double working memory for dgels*/
-static double * sDgelsWork = 0;
-static int LWORK = 0;
-
-static int sNn = 0;
-static int sMm = 0;
-static int sMl = 0;
-static int* sW2V = 0;
-
-/*OUTPUT */
-/*sW2 is a pointer on the output w*/
-static double* sW2;
-/*sW1 is a pointer on the output w*/
-static double* sW1;
-/*sV is a pointer on the output v*/
-static double* sV;
-/*sU is a pointer on the output u*/
-static double* sU;
-
-static void buildQ(void);
-static void printCurrentSystem(void);
-static void printRefSystem(void);
+static void printCurrentSystem(int n, int m, int ml, double * M, double * Q);
+static void printRefSystem(int n, int m, int ml, double * Mref, double * Qref);
 
 /*case defined with sCurrentEnum
  *if sW2V[i]==0
@@ -126,25 +97,21 @@ int mixedLinearComplementarity_enum_setDefaultSolverOptions(MixedLinearComplemen
 }
 
 
-void buildQ()
+void printCurrentSystem(int n, int m, int ml, double * M, double * Q)
 {
-  memcpy(sQ, sQref, sMl * sizeof(double));
-}
-void printCurrentSystem()
-{
-  int npm = sNn + sMm;
+  int npm = n + m;
   printf("printCurrentSystemM:\n");
-  NM_dense_display(sM, sMl, npm, 0);
+  NM_dense_display(M, ml, npm, 0);
   printf("printCurrentSystemQ (ie -Q from mlcp because of linear system MZ=Q):\n");
-  NM_dense_display(sQ, sMl, 1, 0);
+  NM_dense_display(Q, ml, 1, 0);
 }
-void printRefSystem()
+void printRefSystem(int n, int m, int ml, double * Mref, double * Qref)
 {
-  int npm = sNn + sMm;
-  printf("ref M NbLines %d n %d  m %d :\n", sMl, sNn, sMm);
-  NM_dense_display(sMref, sMl, npm, 0);
+  int npm = n + m;
+  printf("ref M NbLines %d n %d  m %d :\n", ml, n, m);
+  NM_dense_display(Mref, ml, npm, 0);
   printf("ref Q (ie -Q from mlcp because of linear system MZ=Q):\n");
-  NM_dense_display(sQref, sMl, 1, 0);
+  NM_dense_display(Qref, ml, 1, 0);
 }
 int mlcp_enum_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
@@ -157,7 +124,7 @@ int mlcp_enum_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptio
   if (!problem)
     return 0;
   assert(problem->M);
-  LWORK = 0;
+  int LWORK = 0;
   if (options->iparam[4])
   {
     LWORK = -1;
@@ -180,6 +147,75 @@ int mlcp_enum_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptio
  * double *w : size n+m
  */
 void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options);
+
+/*
+ * Square system solved by LU: the configurations are enumerated by
+ * complementarity_enum_solve, without any static state.
+ *
+ * iparam[3] : (in) first configuration, (out) configuration found, to
+ * start from it at the next call.
+ */
+static void mlcp_enum_square(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
+{
+  int n = problem->n;
+  int m = problem->m;
+  int npm = n + m;
+  double tol = options->dparam[0];
+  int itermax = options->iparam[0];
+
+  ComplementarityEnum pb;
+  pb.size = npm;
+  pb.offset = n;
+  pb.nbPairs = m;
+  pb.M = problem->M->matrix0;
+  pb.b = options->dWork;
+  pb.x = pb.b + npm;
+  pb.tol = tol;
+  for (int lin = 0; lin < npm; lin++)
+    pb.b[lin] =  - problem->q[lin];
+
+  if (verbose)
+    printf("mlcp_enum begin, n %d m %d tol %lf\n", n, m, tol);
+
+  unsigned long long nbCase = 1ULL << m;
+  unsigned long long first = complementarity_enum_rank((unsigned long long)(unsigned int)options->iparam[3] & (nbCase - 1));
+  unsigned long long count = itermax > 0 && (unsigned long long)itermax < nbCase ? (unsigned long long)itermax : nbCase;
+  int zw[64];
+
+  *info = 1;
+  while (count)
+  {
+    unsigned long long pos = complementarity_enum_solve(&pb, first, count, options);
+    if (pos == count)
+      break;
+    first += pos + 1;
+    count -= pos + 1;
+
+    double err;
+    for (int i = 0; i < m; i++)
+      zw[i] = (pb.configuration >> i) & 1;
+    mlcp_fillSolution(z, z + n, w, w + n, n, m, npm, zw, pb.x);
+    mlcp_compute_error(problem, z, w, tol, &err);
+    /*because it happens the LU leads to an wrong solution witout raise any error.*/
+    if (err > 10 * tol)
+    {
+      if (verbose)
+        printf("LU no-error, but mlcp_compute_error out of tol: %e!\n", err);
+      continue;
+    }
+    if (verbose)
+    {
+      printf("mlcp_enum find a solution, err=%e !\n", err);
+      mlcp_DisplaySolution(z, z + n, w, w + n, n, m, npm);
+    }
+    options->iparam[3] = (int) pb.configuration;
+    *info = 0;
+    return;
+  }
+  if (verbose)
+    printf("mlcp_enum failed!\n");
+}
+
 void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
   int nbSol = 0;
@@ -188,6 +224,11 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
     mlcp_enum_Block(problem, z, w, info, options);
     return;
   }
+  if (!options->iparam[4] && problem->M->size0 == problem->n + problem->m && problem->m < 64)
+  {
+    mlcp_enum_square(problem, z, w, info, options);
+    return;
+  }
   double tol ;
   double * workingFloat = options->dWork;
   int * workingInt = options->iWork;
@@ -198,68 +239,67 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
   int check;
   lapack_int LAinfo = 0;
   *info = 0;
-  sMl = problem->M->size0;
-  sNn = problem->n;
-  sMm = problem->m;
+  int ml = problem->M->size0;
+  int n = problem->n;
+  int m = problem->m;
+  EnumerationState enumeration;
   int useDGELS = options->iparam[4];
   /*OUTPUT param*/
-  sW1 = w;
-  sW2 = w + (sMl - problem->m); /*sW2 size :m */
-  sU = z;
-  sV = z + problem->n;
+  double * w1 = w;
+  double * w2 = w + (ml - problem->m); /*w2 size :m */
+  double * u = z;
+  double * v = z + problem->n;
   tol = options->dparam[0];
   int itermax = options->iparam[0];
 
-  sMref = problem->M->matrix0;
+  double * Mref = problem->M->matrix0;
   /*  LWORK = 2*npm; LWORK >= max( 1, MN + max( MN, NRHS ) ) where MN = min(M,N)*/
   //  verbose=1;
   if (verbose)
-    printf("mlcp_enum begin, n %d m %d tol %lf\n", sNn, sMm, tol);
+    printf("mlcp_enum begin, n %d m %d tol %lf\n", n, m, tol);
 
-  sM = workingFloat;
+  double * M = workingFloat;
   /*  sQ = sM + npm*npm;*/
-  sQ = sM + (sNn + sMm) * sMl;
+  double * Q = M + (n + m) * ml;
   /*  sColNul = sQ + sMm +sNn;*/
-  sColNul = sQ + sMl;
+  double * colNul = Q + ml;
   /*  sQref = sColNul + sMm +sNn;*/
-  sQref = sColNul + sMl;
+  double * Qref = colNul + ml;
 
-  sDgelsWork = sQref + sMl;
-
-  for (lin = 0; lin < sMl; lin++)
-    sQref[lin] =  - problem->q[lin];
-  for (lin = 0; lin < sMl; lin++)
-    sColNul[lin] = 0;
+  for (lin = 0; lin < ml; lin++)
+    Qref[lin] =  - problem->q[lin];
+  for (lin = 0; lin < ml; lin++)
+    colNul[lin] = 0;
   /*  printf("sColNul\n");
-      NM_dense_display(sColNul,npm,1);*/
+      NM_dense_display(colNul,npm,1);*/
   if (verbose)
-    printRefSystem();
-  sW2V = workingInt;
-  ipiv = sW2V + sMm;
+    printRefSystem(n, m, ml, Mref, Qref);
+  int * W2V = workingInt;
+  ipiv = W2V + m;
 
-  initEnum(problem->m);
-  while (nextEnum(sW2V) && itermax-- > 0)
+  initEnum(&enumeration, problem->m, (unsigned int)options->iparam[3]);
+  while (nextEnum(&enumeration, W2V) && itermax-- > 0)
   {
-    mlcp_buildM(sW2V, sM, sMref, sNn, sMm, sMl);
-    buildQ();
+    mlcp_buildM(W2V, M, Mref, n, m, ml);
+    memcpy(Q, Qref, ml * sizeof(double));
     if (verbose)
-      printCurrentSystem();
+      printCurrentSystem(n, m, ml, M, Q);
     if (useDGELS)
     {
-      DGELS(LA_NOTRANS,sMl, npm, NRHS, sM, sMl, sQ, sMl, &LAinfo);
+      DGELS(LA_NOTRANS,ml, npm, NRHS, M, ml, Q, ml, &LAinfo);
       if (verbose)
       {
         printf("Solution of dgels\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        NM_dense_display(Q, ml, 1, 0);
       }
     }
     else
     {
-      DGESV(npm, NRHS, sM, npm, ipiv, sQ, npm, &LAinfo);
+      DGESV(npm, NRHS, M, npm, ipiv, Q, npm, &LAinfo);
       if (verbose)
       {
         printf("Solution of dgesv\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        NM_dense_display(Q, ml, 1, 0);
       }
     }
     if (!LAinfo)
@@ -271,7 +311,7 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
         double rest = 0;
         for (ii = 0; ii < npm; ii++)
         {
-          if (isnan(sQ[ii]) || isinf(sQ[ii]))
+          if (isnan(Q[ii]) || isinf(Q[ii]))
           {
             printf("DGELS FAILED\n");
             cc = 1;
@@ -281,9 +321,9 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
         if (cc)
           continue;
 
-        if (sMl > npm)
+        if (ml > npm)
         {
-          rest = cblas_dnrm2(sMl - npm, sQ + npm, 1);
+          rest = cblas_dnrm2(ml - npm, Q + npm, 1);
 
           if (rest > tol || isnan(rest) || isinf(rest))
           {
@@ -299,13 +339,13 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
       if (verbose)
       {
         printf("Solving linear system success, solution in cone?\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        NM_dense_display(Q, ml, 1, 0);
       }
 
       check = 1;
-      for (lin = 0 ; lin < sMm; lin++)
+      for (lin = 0 ; lin < m; lin++)
       {
-        if (sQ[sNn + lin] < - tol)
+        if (Q[n + lin] < - tol)
         {
           check = 0;
           break;/*out of the cone!*/
@@ -316,7 +356,7 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
       else
       {
         double err;
-        mlcp_fillSolution(sU, sV, sW1, sW2, sNn, sMm, sMl, sW2V, sQ);
+        mlcp_fillSolution(u, v, w1, w2, n, m, ml, W2V, Q);
         mlcp_compute_error(problem, z, w, tol, &err);
         /*because it happens the LU leads to an wrong solution witout raise any error.*/
         if (err > 10 * tol)
@@ -329,9 +369,9 @@ void mlcp_enum(MixedLinearComplementarityProblem* problem, double *z, double *w,
         if (verbose)
         {
           printf("mlcp_enum find a solution, err=%e !\n", err);
-          mlcp_DisplaySolution(sU, sV, sW1, sW2, sNn, sMm, sMl);
+          mlcp_DisplaySolution(u, v, w1, w2, n, m, ml);
         }
-        // options->iparam[1]=sCurrentEnum-1;
+        options->iparam[3] = (int)(enumeration.current - 1);
         return;
       }
     }
@@ -370,72 +410,71 @@ void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, doub
 
 
 
-  sMl = problem->M->size0;
-  sNn = problem->n;
-  sMm = problem->m;
+  int ml = problem->M->size0;
+  int n = problem->n;
+  int m = problem->m;
+  EnumerationState enumeration;
 
   /*OUTPUT param*/
-  sW1 = w;
+  double * w1 = w;
   /*sW2=w+(sMl-problem->m); sW2 size :m */
-  sU = z;
+  double * u = z;
   tol = options->dparam[0];
   int itermax = options->iparam[0];
 
-  sMref = problem->M->matrix0;
+  double * Mref = problem->M->matrix0;
   /*  LWORK = 2*npm; LWORK >= max( 1, MN + max( MN, NRHS ) ) where MN = min(M,N)*/
   //  verbose=1;
   if (verbose)
-    printf("mlcp_enum begin, n %d m %d tol %lf\n", sNn, sMm, tol);
+    printf("mlcp_enum begin, n %d m %d tol %lf\n", n, m, tol);
 
-  sM = workingFloat;
+  double * M = workingFloat;
   /*  sQ = sM + npm*npm;*/
-  sQ = sM + (sNn + sMm) * sMl;
+  double * Q = M + (n + m) * ml;
   /*  sColNul = sQ + sMm +sNn;*/
-  sColNul = sQ + sMl;
+  double * colNul = Q + ml;
   /*  sQref = sColNul + sMm +sNn;*/
-  sQref = sColNul + sMl;
-
-  sDgelsWork = sQref + sMl;
+  double * Qref = colNul + ml;
 
-  for (lin = 0; lin < sMl; lin++)
-    sQref[lin] =  - problem->q[lin];
-  for (lin = 0; lin < sMl; lin++)
-    sColNul[lin] = 0;
+  for (lin = 0; lin < ml; lin++)
+    Qref[lin] =  - problem->q[lin];
+  for (lin = 0; lin < ml; lin++)
+    colNul[lin] = 0;
 
   /*  printf("sColNul\n");
-      NM_dense_display(sColNul,npm,1);*/
+      NM_dense_display(colNul,npm,1);*/
   if (verbose)
-    printRefSystem();
-  sW2V = workingInt;
-  ipiv = sW2V + sMm;
-  indexInBlock = ipiv + sMm + sNn;
-  if (sMm == 0)
+    printRefSystem(n, m, ml, Mref, Qref);
+  int * W2V = workingInt;
+  ipiv = W2V + m;
+  indexInBlock = ipiv + m + n;
+  if (m == 0)
     indexInBlock = 0;
   *info = 0;
   mlcp_buildIndexInBlock(problem, indexInBlock);
-  initEnum(problem->m);
-  while (nextEnum(sW2V) && itermax-- > 0)
+  initEnum(&enumeration, problem->m, (unsigned int)options->iparam[3]);
+  while (nextEnum(&enumeration, W2V) && itermax-- > 0)
   {
-    mlcp_buildM_Block(sW2V, sM, sMref, sNn, sMm, sMl, indexInBlock);
-    buildQ();
+    mlcp_buildM_Block(W2V, M, Mref, n, m, ml, indexInBlock);
+    memcpy(Q, Qref, ml * sizeof(double));
     if (verbose)
-      printCurrentSystem();
+      printCurrentSystem(n, m, ml, M, Q);
     if (useDGELS)
     {
-      DGELS(LA_NOTRANS,sMl, npm, NRHS, sM, sMl, sQ, sMl,&LAinfo);
+      DGELS(LA_NOTRANS,ml, npm, NRHS, M, ml, Q, ml,&LAinfo);
       if (verbose)
       {
         printf("Solution of dgels\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        NM_dense_display(Q, ml, 1, 0);
       }
     }
     else
     {
-      DGESV(npm, NRHS, sM, npm, ipiv, sQ, npm, &LAinfo);
+      DGESV(npm, NRHS, M, npm, ipiv, Q, npm, &LAinfo);
       if (verbose)
       {
         printf("Solution of dgesv\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        NM_dense_display(Q, ml, 1, 0);
       }
     }
     if (!LAinfo)
@@ -447,7 +486,7 @@ void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, doub
         double rest = 0;
         for (ii = 0; ii < npm; ii++)
         {
-          if (isnan(sQ[ii]) || isinf(sQ[ii]))
+          if (isnan(Q[ii]) || isinf(Q[ii]))
           {
             printf("DGELS FAILED\n");
             cc = 1;
@@ -457,9 +496,9 @@ void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, doub
         if (cc)
           continue;
 
-        if (sMl > npm)
+        if (ml > npm)
         {
-          rest = cblas_dnrm2(sMl - npm, sQ + npm, 1);
+          rest = cblas_dnrm2(ml - npm, Q + npm, 1);
 
           if (rest > tol || isnan(rest) || isinf(rest))
           {
@@ -475,13 +514,13 @@ void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, doub
       if (verbose)
       {
         printf("Solving linear system success, solution in cone?\n");
-        NM_dense_display(sQ, sMl, 1, 0);
+        NM_dense_display(Q, ml, 1, 0);
       }
 
       check = 1;
-      for (lin = 0 ; lin < sMm; lin++)
+      for (lin = 0 ; lin < m; lin++)
       {
-        if (sQ[indexInBlock[lin]] < - tol)
+        if (Q[indexInBlock[lin]] < - tol)
         {
           check = 0;
           break;/*out of the cone!*/
@@ -492,7 +531,7 @@ void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, doub
       else
       {
         double err;
-        mlcp_fillSolution_Block(sU, sW1, sNn, sMm, sMl, sW2V, sQ, indexInBlock);
+        mlcp_fillSolution_Block(u, w1, n, m, ml, W2V, Q, indexInBlock);
         mlcp_compute_error(problem, z, w, tol, &err);
         /*because it happens the LU leads to an wrong solution witout raise any error.*/
         if (err > 10 * tol)
@@ -504,9 +543,9 @@ void mlcp_enum_Block(MixedLinearComplementarityProblem* problem, double *z, doub
         if (verbose)
         {
           printf("mlcp_enum find a solution err = %e!\n", err);
-          mlcp_DisplaySolution_Block(sU, sW1, sNn, sMm, sMl, indexInBlock);
+          mlcp_DisplaySolution_Block(u, w1, n, m, ml, indexInBlock);
         }
-        // options->iparam[1]=sCurrentEnum-1;
+        options->iparam[3] = (int)(enumeration.current - 1);
         return;
       }
     }
@@ -20,62 +20,58 @@
 #include <stdio.h>
 #include "numerics_verbose.h"
 
-static unsigned long long int sCurrentEnum = 0;
-static unsigned long long int sCmpEnum = 0;
-static unsigned long long int sNbCase = 0;
-static double sProgress = 0;
-static int sMm = 0;
+static void affectW2V(EnumerationState* e, int * W2V);
 
-static void affectW2V(int * W2V);
-
-void initEnum(int M)
+/* The enumeration starts from the configuration first and visits the
+   2^M configurations. */
+void initEnum(EnumerationState* e, int M, unsigned long long int first)
 {
   int cmp;
-  /*  sCurrentEnum = 0;*/
 
-  sCmpEnum = 0;
-  sNbCase = 1;
-  sMm = M;
+  e->cmp = 0;
+  e->nbCase = 1;
+  e->m = M;
 
-  for (cmp = 0; cmp < sMm; cmp++)
-    sNbCase = sNbCase << 1;
-  sProgress = 0;
+  for (cmp = 0; cmp < e->m; cmp++)
+    e->nbCase = e->nbCase << 1;
+  e->current = first < e->nbCase ? first : 0;
+  e->progress = 0;
 }
 
-void affectW2V(int * W2V)
+void affectW2V(EnumerationState* e, int * W2V)
 {
-  unsigned long  int aux = sCurrentEnum;
-  for (int i = 0; i < sMm; i++)
+  unsigned long  int aux = e->current;
+  for (int i = 0; i < e->m; i++)
   {
     W2V[i] = aux & 1;
     aux = aux >> 1;
   }
   if (verbose)
   {
-    for (int i = 0; i < sMm; i++)
+    for (int i = 0; i < e->m; i++)
       printf("wv[%d]=%d \t", i, W2V[i]);
     printf("\n");
   }
 
 }
 
-int nextEnum(int * W2V)
+int nextEnum(EnumerationState* e, int * W2V)
 {
-  if (sCmpEnum == sNbCase)
+  if (e->cmp == e->nbCase)
     return 0;
-  if (sCurrentEnum >= sNbCase)
+  if (e->current >= e->nbCase)
   {
-    sCurrentEnum = 0;
+    e->current = 0;
   }
   if (verbose)
-    printf("try enum :%d\n", (int)sCurrentEnum);
-  affectW2V(W2V);
-  sCurrentEnum++;
-  sCmpEnum++;
-  if (verbose && sCmpEnum > (unsigned long int)sProgress * sNbCase)
+    printf("try enum :%d\n", (int)e->current);
+  affectW2V(e, W2V);
+  e->current++;
+  e->cmp++;
+  if (verbose && e->cmp > (unsigned long int)e->progress * e->nbCase)
   {
-    sProgress += 0.001;
-    printf(" progress %f %d \n", sProgress, (int) sCurrentEnum);
+    e->progress += 0.001;
+    printf(" progress %f %d \n", e->progress, (int) e->current);
   }
 
   return 1;
@@ -1,9 +1,17 @@
-
 #ifndef MLCP_ENUM_TOOL_H
 #define MLCP_ENUM_TOOL_H
 
+/* State of the enumeration of the 2^m configurations */
+typedef struct
+{
+  unsigned long long int current;
+  unsigned long long int cmp;
+  unsigned long long int nbCase;
+  double progress;
+  int m;
+} EnumerationState;
 
-void initEnum(int M);
-int nextEnum(int * W2V);
+void initEnum(EnumerationState* e, int M, unsigned long long int first);
+int nextEnum(EnumerationState* e, int * W2V);
 
 #endif //MLCP_ENUM_H
@@ -36,14 +36,6 @@ dim(v)=nn
 #include "mlcp_enum.h"
 #include "mlcp_tool.h"
 
-static int sN;
-static int sM;
-
-static int * siWorkEnum = 0;
-static int * siWorkPath = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkPath = 0;
-
 int mixedLinearComplementarity_pathEnum_setDefaultSolverOptions(MixedLinearComplementarityProblem* problem, SolverOptions* pSolver)
 {
   mixedLinearComplementarity_default_setDefaultSolverOptions(problem, pSolver);
@@ -71,26 +63,14 @@ int mlcp_path_enum_getNbDWork(MixedLinearComplementarityProblem* problem, Solver
  *
  */
 
+/* path and enum share the work memory of the options */
 void mlcp_path_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = 0;/* mlcp_path_getNbIWork(problem,options);*/
-  int dOffset = 0;/*mlcp_path_getNbDWork(problem,options);*/
-  siWorkEnum = options->iWork + iOffset;
-  siWorkPath = options->iWork;
-  sdWorkEnum = options->dWork + dOffset;
-  sdWorkPath = options->dWork;
   /*  mlcp_path_init(problem, options);*/
-
 }
 void mlcp_path_enum_reset()
 {
   /*mlcp_path_reset();*/
-  siWorkEnum = 0;
-  siWorkPath = 0;
-  sdWorkEnum = 0;
-  sdWorkPath = 0;
 }
 
 /*
@@ -109,7 +89,7 @@ void mlcp_path_enum_reset()
  */
 void mlcp_path_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  if (!siWorkEnum)
+  if (!options->iWork || !options->dWork)
   {
     *info = 1;
     printf("MLCP_PATH_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
@@ -126,8 +106,6 @@ void mlcp_path_enum(MixedLinearComplementarityProblem* problem, double *z, doubl
   if (*info)
   {
     printf("MLCP_PATH_ENUM: path failed, call enum\n");
-    options->dWork = sdWorkEnum;
-    options->iWork = siWorkEnum;
     /*solver direct failed, so run the enum solver.*/
     mlcp_enum(problem, z, w, info, options);
   }
@@ -0,0 +1,118 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* The configurations of the direct solver are kept in a cache owned by
+ * the solver options: two problems solved alternately with their own
+ * options find their previous configurations again. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MLCP_Solvers.h"
+#include "NonSmoothDrivers.h"
+#include "NumericsMatrix.h"
+#include "SolverOptions.h"
+
+static MixedLinearComplementarityProblem * newProblem(double scale)
+{
+  MixedLinearComplementarityProblem * problem =
+    (MixedLinearComplementarityProblem *)calloc(1, sizeof(MixedLinearComplementarityProblem));
+  /* one equality and two complementarity constraints */
+  double M[9] = {2., 0., 0.,
+                 0., 2., 1.,
+                 0., 1., 2.
+                };
+  problem->isStorageType1 = 1;
+  problem->n = 1;
+  problem->m = 2;
+  problem->M = NM_create(NM_DENSE, 3, 3);
+  for (int i = 0; i < 9; i++)
+    problem->M->matrix0[i] = scale * M[i];
+  problem->q = (double *)malloc(3 * sizeof(double));
+  return problem;
+}
+
+static void freeProblem(MixedLinearComplementarityProblem * problem)
+{
+  NM_free(problem->M);
+  free(problem->M);
+  free(problem->q);
+  free(problem);
+}
+
+static int solve(MixedLinearComplementarityProblem * problem, SolverOptions * options, int k)
+{
+  /* the four complementarity configurations in turn */
+  double q[4][3] = {{-1., -1., -1.}, {-1., 1., 1.}, {-1., -1., 1.}, {-1., 1., -1.}};
+  double z[3] = {0., 0., 0.};
+  double w[3] = {0., 0., 0.};
+  double error = 0.;
+  memcpy(problem->q, q[k], 3 * sizeof(double));
+  int info = mlcp_driver(problem, z, w, options);
+  if (info || mlcp_compute_error(problem, z, w, 1e-12, &error) || error > 1e-12)
+  {
+    printf("configuration %d not solved, info = %d, error = %e\n", k, info, error);
+    return 1;
+  }
+  return 0;
+}
+
+int main(void)
+{
+  int info = 0;
+  MixedLinearComplementarityProblem * problem[2] = {newProblem(1.), newProblem(3.)};
+  SolverOptions options[2];
+  for (int p = 0; p < 2; p++)
+  {
+    options[p].solverId = SICONOS_MLCP_DIRECT_ENUM;
+    mixedLinearComplementarity_setDefaultSolverOptions(problem[p], &options[p]);
+    /* room for the four configurations in the first cache, two in the second */
+    options[p].iparam[5] = 4 - 2 * p;
+    /* tolerance of the enumeration */
+    options[p].dparam[0] = 1e-12;
+    mlcp_driver_init(problem[p], &options[p]);
+  }
+
+  for (int pass = 0; pass < 3; pass++)
+    for (int k = 0; k < 4; k++)
+      for (int p = 0; p < 2; p++)
+        info += solve(problem[p], &options[p], k);
+
+  int numberOfConfigurations;
+  unsigned long hits, misses;
+  mlcp_direct_statistics(&options[0], &numberOfConfigurations, &hits, &misses);
+  printf("first cache: %d configurations, %lu hits, %lu misses\n", numberOfConfigurations, hits, misses);
+  if (numberOfConfigurations != 4 || hits != 8 || misses != 4)
+    info += 1;
+  mlcp_direct_statistics(&options[1], &numberOfConfigurations, &hits, &misses);
+  printf("second cache: %d configurations, %lu hits, %lu misses\n", numberOfConfigurations, hits, misses);
+  /* the least recently used configuration is always the next one */
+  if (numberOfConfigurations != 2 || misses != 12)
+    info += 1;
+
+  for (int p = 0; p < 2; p++)
+  {
+    mlcp_driver_reset(problem[p], &options[p]);
+    if (options[p].solverData)
+      info += 1;
+    mixedLinearComplementarity_deleteDefaultSolverOptions(problem[p], &options[p]);
+    freeProblem(problem[p]);
+  }
+  printf("End of test on the cache of mlcp_direct: info = %d\n", info);
+  return info;
+}
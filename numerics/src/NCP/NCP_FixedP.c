@@ -28,7 +28,7 @@
 
 /*============================ Fixed point Solver ==================================*/
 
-int Fixe(int n, double* z, int* iparam, double* dparam)
+int Fixe(int n, double* z, int* iparam, double* dparam, void* data)
 {
 
   int itermax = iparam[0]; // maximum number of iterations allowed
@@ -57,7 +57,7 @@ int Fixe(int n, double* z, int* iparam, double* dparam)
 
     //printf(" ============= Fixed Point Iteration ============= %i\n",niter);
     for (i = 0; i < n ; ++i)
-      compute_Z_GlockerFixedP(i, www);
+      compute_Z_GlockerFixedP((NCPGlockerData*)data, i, www);
 
     terminationCriterion = cblas_dnrm2(n, www, 1);
     //printf(" error = %14.7e\n", terminationCriterion);
@@ -31,7 +31,15 @@ extern "C"
 {
 #endif
 
-  int Fixe(int n, double* z, int* iparam, double* dparam);
+  /** fixed point iterations on the Glocker formulation
+   * \param n size of the problem
+   * \param z the unknown
+   * \param iparam integer parameters (maximum number of iterations, number of iterations)
+   * \param dparam double parameters (tolerance, error)
+   * \param data the NCPGlockerData of the local problem
+   * \return 0 if successful
+   */
+  int Fixe(int n, double* z, int* iparam, double* dparam, void* data);
 
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
@@ -103,6 +103,30 @@ extern "C"
    */
   int fc3d_driver(FrictionContactProblem* problem, double *reaction , double *velocity, SolverOptions* options);
 
+  /** Interface to solvers for a batch of friction-contact 3D problems
+   *  sharing the same matrix M and differing by q and mu, for instance
+   *  the scenarios of a parameter sweep. Scenarios are solved in
+   *  parallel when Siconos is built with OpenMP and the solver is
+   *  reentrant (see fc3d_batch_is_reentrant), each with its own copy
+   *  of the options; otherwise they are solved one after the other.
+   *  Scenario k uses the k-th block of each array.
+   *  \param[in] problem gives M, dimension and numberOfContacts (its q and mu are not used)
+   *  \param[in] nbScenarios number of scenarios
+   *  \param[in] q right-hand sides (nbScenarios*n)
+   *  \param[in] mu friction coefficients (nbScenarios*numberOfContacts)
+   *  \param[in,out] reaction global vectors (nbScenarios*n)
+   *  \param[in,out] velocity global vectors (nbScenarios*n)
+   *  \param[in,out] options structure used to define the solver(s) and their parameters.
+   *  On return, iparam[SICONOS_IPARAM_ITER_DONE] and dparam[SICONOS_DPARAM_RESIDU]
+   *  hold the largest values reached over the scenarios.
+   *  \param[out] info result of each scenario (nbScenarios), may be NULL
+   *  \return the number of scenarios which failed.
+   */
+  int fc3d_driver_batch(FrictionContactProblem* problem, int nbScenarios,
+                        double* q, double* mu,
+                        double* reaction, double* velocity,
+                        SolverOptions* options, int* info);
+
   /** General interface to solvers for global friction-contact 3D problem
     \param[in] problem the structure which handles the Friction-Contact problem
     \param[in,out] reaction global vector (n)
@@ -23,7 +23,7 @@
 #include "stdlib.h"
 
 void linesearch_Armijo(int n, double *z, double* dir, double psi_k,
-                       double descentCondition, NewtonFunctionPtr* phi)
+                       double descentCondition, NewtonFunctionPtr* phi, void* data)
 {
   double * phiVector = (double*)malloc(n * sizeof(*phiVector));
   if (phiVector == NULL)
@@ -52,7 +52,7 @@ void linesearch_Armijo(int n, double *z, double* dir, double psi_k,
   while (tk > tmin)
   {
     /* Computes merit function = 1/2*norm(phi(z_{k+1}))^2 */
-    (*phi)(n, z, phiVector, 0);
+    (*phi)(data, n, z, phiVector, 0);
     merit =  cblas_dnrm2(n, phiVector , incx);
     merit = 0.5 * merit * merit;
     merit_k = psi_k + sigma * tk * descentCondition;
@@ -69,7 +69,7 @@ void linesearch_Armijo(int n, double *z, double* dir, double psi_k,
 
 }
 
-int nonSmoothNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, int* iparam, double* dparam)
+int nonSmoothNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, void* data, int* iparam, double* dparam)
 {
   if (phi == NULL || jacobianPhi == NULL)
   {
@@ -124,8 +124,8 @@ int nonSmoothNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr*
   {
     ++niter;
     /** Computes phi and its jacobian */
-    (*phi)(n, z, phiVector, 0);
-    (*jacobianPhi)(n, z, jacobianPhiMatrix, 1);
+    (*phi)(data, n, z, phiVector, 0);
+    (*jacobianPhi)(data, n, z, jacobianPhiMatrix, 1);
     /* Computes the jacobian of the merit function, jacobian_psi = transpose(jacobianPhiMatrix).phiVector */
     cblas_dgemv(CblasColMajor,CblasTrans, n, n, 1.0, jacobianPhiMatrix, n, phiVector, incx, 0.0, jacobian_psi, incx);
     norm_jacobian_psi = cblas_dnrm2(n, jacobian_psi, 1);
@@ -162,7 +162,7 @@ int nonSmoothNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr*
     }
 
     /* Step-3 Line search: computes z_k+1 */
-    linesearch_Armijo(n, z, phiVector, psi, descentCondition, phi);
+    linesearch_Armijo(n, z, phiVector, psi, descentCondition, phi, data);
 
     if (verbose > 0)
     {
@@ -197,7 +197,7 @@ int nonSmoothNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr*
   else return 0;
 }
 
-int nonSmoothDirectNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, int* iparam, double* dparam)
+int nonSmoothDirectNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFunctionPtr* jacobianPhi, void* data, int* iparam, double* dparam)
 {
   if (phi == NULL || jacobianPhi == NULL)
   {
@@ -249,8 +249,8 @@ int nonSmoothDirectNewton(int n, double* z, NewtonFunctionPtr* phi, NewtonFuncti
   {
     ++niter;
     /** Computes phi and its jacobian */
-    (*phi)(n, z, phiVector, 0);
-    (*jacobianPhi)(n, z, jacobianPhiMatrix, 1);
+    (*phi)(data, n, z, phiVector, 0);
+    (*jacobianPhi)(data, n, z, jacobianPhiMatrix, 1);
     /* Computes the jacobian of the merit function, jacobian_psi = transpose(jacobianPhiMatrix).phiVector */
     cblas_dgemv(CblasColMajor,CblasTrans, n, n, 1.0, jacobianPhiMatrix, n, phiVector, incx, 0.0, jacobian_psi, incx);
     norm_jacobian_psi = cblas_dnrm2(n, jacobian_psi, 1);
@@ -28,8 +28,9 @@
 
  */
 
-/* Pointer to function that corresponds to the function \f$ \phi \f$ */
-typedef void (*NewtonFunctionPtr)(int, double*, double*, int);
+/* Pointer to function that corresponds to the function \f$ \phi \f$,
+   its first argument is the data given to the solver */
+typedef void (*NewtonFunctionPtr)(void*, int, double*, double*, int);
 
 #include "SiconosConfig.h"
 
@@ -44,9 +45,10 @@ extern "C"
    *  \param psi_k initial value of the merit function
    *  \param descentCondition descent condition
    *  \param phi pointer to function used to compute phi(z)
+   *  \param data data given to phi
    */
   void linesearch_Armijo(int n, double *z, double* dir, double psi_k,
-                         double descentCondition, NewtonFunctionPtr* phi);
+                         double descentCondition, NewtonFunctionPtr* phi, void* data);
 
 
   /** Newton solver with line Search
@@ -54,6 +56,7 @@ extern "C"
   \param z unknown vector, in-out argument
   \param phi pointer to \f$ \phi \f$ function
   \param jacobianPhi pointer to \f$ \nabla_z \phi(z) \f$ function
+  \param data data given to phi and jacobianPhi
   \param iparam vector of int parameters:
    - [0] : max. number of iterations
    - [1] : number of iterations processed
@@ -63,7 +66,7 @@ extern "C"
   \return int 0 if ok
   */
   int nonSmoothNewton(int n, double* z, NewtonFunctionPtr* phi,
-                      NewtonFunctionPtr* jacobianPhi,
+                      NewtonFunctionPtr* jacobianPhi, void* data,
                       int* iparam, double* dparam);
 
   /** Newton solver without line Search
@@ -71,6 +74,7 @@ extern "C"
   \param z unknown vector, in-out argument
   \param phi pointer to \f$ \phi \f$ function
   \param jacobianPhi pointer to \f$ \nabla_z \phi(z) \f$ function
+  \param data data given to phi and jacobianPhi
   \param iparam vector of int parameters:
    - [0] : max. number of iterations
    - [1] : number of iterations processed
@@ -80,7 +84,7 @@ extern "C"
   \return int 0 if ok
   */
   int nonSmoothDirectNewton(int n, double* z, NewtonFunctionPtr* phi,
-                            NewtonFunctionPtr* jacobianPhi,
+                            NewtonFunctionPtr* jacobianPhi, void* data,
                             int* iparam, double* dparam);
 
 
@@ -105,6 +105,7 @@ int relay_enum_setDefaultSolverOptions(RelayProblem* problem, SolverOptions* opt
   options->dparam = (double *)malloc(options->dSize * sizeof(double));
   options->dWork = NULL ;/* (double*) malloc((3*problem->size +problem->size*problem->size)*sizeof(double)); */
   options->iWork = NULL ; /* (int*) malloc(2*problem->size*sizeof(int)); */
+  solver_options_nullify(options);
   for (i = 0; i < 5; i++)
   {
     options->iparam[i] = 0;
@@ -96,6 +96,7 @@ SICONOS_SOLVER_MACRO(SICONOS_FRICTION_2D_ENUM);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_2D_LEMKE);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_NSGS);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_NSGSV);\
+SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_NSGS_DDM);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_PROX);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_TFP);\
 SICONOS_SOLVER_MACRO(SICONOS_FRICTION_3D_PFP);\
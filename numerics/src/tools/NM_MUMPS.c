@@ -24,8 +24,8 @@
 #include "debug.h"
 #include "numerics_verbose.h"
 
-#ifdef WITH_MUMPS
-
+/* the MPI communicator is used by the MUMPS solver and by the
+ * distributed solvers without MUMPS */
 #ifdef HAVE_MPI
 
 /* thread_local madness for the MPI communicator */
@@ -88,7 +88,9 @@ MPI_Comm NM_MPI_com(MPI_Comm m)
 
 }
 
-#endif /* WITH_MPI */
+#endif /* HAVE_MPI */
+
+#ifdef WITH_MUMPS
 
 MUMPS_INT* NM_MUMPS_irn(NumericsMatrix* A)
 {
@@ -276,6 +278,74 @@ DMUMPS_STRUC_C* NM_MUMPS_id(NumericsMatrix* A)
 }
 
 
+int NM_MUMPS_set_matrix(NumericsMatrix* A, DMUMPS_STRUC_C* mumps_id)
+{
+  CSparseMatrix* triplet = NM_triplet(A);
+  int distributed = mumps_id->ICNTL(18) == 3;
+
+  MUMPS_INT nz = (MUMPS_INT) triplet->nz;
+  MUMPS_INT* irn = distributed ? mumps_id->irn_loc : mumps_id->irn;
+  MUMPS_INT* jcn = distributed ? mumps_id->jcn_loc : mumps_id->jcn;
+  MUMPS_INT nz_old = distributed ? mumps_id->nz_loc : mumps_id->nz;
+
+  /* the pattern given before is still in the integer work vector */
+  int changed = !irn || !jcn || nz != nz_old;
+  for (CS_INT k = 0; !changed && k < triplet->nz; ++k)
+  {
+    changed = irn[k] != (MUMPS_INT) triplet->i[k] + 1
+      || jcn[k] != (MUMPS_INT) triplet->p[k] + 1;
+  }
+
+  if (changed)
+  {
+    irn = NM_MUMPS_irn(A);
+    jcn = NM_MUMPS_jcn(A);
+  }
+
+  if (distributed)
+  {
+    mumps_id->nz_loc = nz;
+    mumps_id->irn_loc = irn;
+    mumps_id->jcn_loc = jcn;
+    mumps_id->a_loc = triplet->x;
+  }
+  else
+  {
+    mumps_id->nz = nz;
+    mumps_id->irn = irn;
+    mumps_id->jcn = jcn;
+    mumps_id->a = triplet->x;
+  }
+
+#ifdef HAVE_MPI
+  /* the analysis is collective */
+  if (distributed)
+  {
+    CHECK_MPI(MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR,
+                            NM_MPI_com(MPI_COMM_NULL)));
+  }
+#endif
+
+  return changed;
+}
+
+void NM_MUMPS_set_distributed(NumericsMatrix* A)
+{
+  DMUMPS_STRUC_C* mumps_id = NM_MUMPS_id(A);
+
+  if (mumps_id->ICNTL(18) != 3)
+  {
+    /* distributed assembled matrix, centralized right-hand side and
+     * solution on the host */
+    mumps_id->ICNTL(18) = 3;
+    mumps_id->nz = 0;
+    mumps_id->irn = NULL;
+    mumps_id->jcn = NULL;
+    mumps_id->a = NULL;
+    NM_MUMPS_set_matrix(A, mumps_id);
+  }
+}
+
 void NM_MUMPS_free(void* p)
 {
   NSM_linear_solver_params* params = (NSM_linear_solver_params*) p;
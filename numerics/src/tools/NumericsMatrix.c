@@ -2520,7 +2520,7 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
     else
     {
       double* mat;
-      if (keep == NM_PRESERVE)
+      if (keep == NM_PRESERVE || keep == NM_KEEP_ANALYSIS)
       {
         mat = NM_dWork(A, A->size0*A->size1);
         cblas_dcopy_msan(A->size0*A->size1, A->matrix0, 1, mat, 1);
@@ -2582,7 +2582,14 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
 
       mumps_id->rhs = b;
 
-      if (keep != NM_KEEP_FACTORS|| mumps_id->job == -1)
+      if (keep == NM_KEEP_ANALYSIS)
+      {
+        /* factorization and solve, the analysis is done again only if
+         * the sparsity pattern has changed */
+        int changed = NM_MUMPS_set_matrix(A, mumps_id);
+        mumps_id->job = (changed || mumps_id->job == JOB_INIT) ? 6 : 5;
+      }
+      else if (keep != NM_KEEP_FACTORS || mumps_id->job == JOB_INIT)
       {
         mumps_id->job = 6;
       }
@@ -2595,7 +2602,8 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
       /* compute the solution */
       dmumps_c(mumps_id);
 
-      info = mumps_id->info[0];
+      /* with a distributed matrix, the processes share the global info */
+      info = mumps_id->ICNTL(18) == 3 ? mumps_id->infog[0] : mumps_id->info[0];
 
       /* MUMPS can return info codes with negative value */
       if (info)
@@ -2605,7 +2613,23 @@ int NM_gesv_expert(NumericsMatrix* A, double *b, unsigned keep)
           printf("NM_gesv: MUMPS fails : info(1)=%d, info(2)=%d\n", info, mumps_id->info[1]);
         }
       }
-      if (keep != NM_KEEP_FACTORS)
+#ifdef HAVE_MPI
+      else if (mumps_id->ICNTL(18) == 3)
+      {
+        /* the solution is on the host */
+        CHECK_MPI(MPI_Bcast(b, mumps_id->n, MPI_DOUBLE, 0, NM_MPI_com(MPI_COMM_NULL)));
+      }
+#endif
+
+      if (keep == NM_KEEP_ANALYSIS)
+      {
+        /* after a failure, the next call starts from the analysis */
+        if (info)
+          mumps_id->job = JOB_INIT;
+        if (!p->solver_free_hook)
+          p->solver_free_hook = &NM_MUMPS_free;
+      }
+      else if (keep != NM_KEEP_FACTORS)
       {
         NM_MUMPS_free(p);
       }
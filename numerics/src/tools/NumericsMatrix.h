@@ -77,7 +77,10 @@ typedef enum NumericsMatrix_types {
 typedef enum {
   NM_NONE,          /**< keep nothing */
   NM_KEEP_FACTORS,  /**< keep all the factorization data (useful to reuse the factorization) */
-  NM_PRESERVE       /**< keep the matrix as-is (useful for the dense case) */
+  NM_PRESERVE,      /**< keep the matrix as-is (useful for the dense case) */
+  NM_KEEP_ANALYSIS  /**< keep the symbolic analysis for the next solves, the
+                       sparsity pattern of the matrix being unchanged
+                       (MUMPS only, the matrix is preserved otherwise) */
 } NM_gesv_opts;
 
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
@@ -564,7 +567,10 @@ extern "C"
    * \param keep if set to NM_KEEP_FACTORS, keep all the info related to the factorization to
    * allow for future solves. If A is already factorized, just solve the linear
    * system. If set to NM_PRESERVE, preserve the original matrix (just used in
-   * the dense case). if NM_NONE, discard everything.
+   * the dense case). If set to NM_KEEP_ANALYSIS, the values of A may change
+   * between the calls: MUMPS factorizes A again but reuses the analysis
+   * as long as the sparsity pattern does not change. if NM_NONE, discard
+   * everything.
    * \return 0 if successful, else the error is specific to the backend solver
    * used
    */
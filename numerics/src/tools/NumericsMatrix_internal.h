@@ -26,6 +26,10 @@
 #include "SiconosConfig.h"
 #include "NumericsMatrix.h"
 
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif /* HAVE_MPI */
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 extern "C"
 {
@@ -36,11 +40,15 @@ extern "C"
   void NM_internalData_free(NumericsMatrix* m);
 
 
-#ifdef WITH_MUMPS
-
 #ifdef HAVE_MPI
-#include <mpi.h>
-#endif /* HAVE_MPI */
+  /** Get the MPI communicator. Call MPI_Init if needed.
+   * \param[in] m an MPI communicator
+   * \return the MPI communicator.
+   */
+  MPI_Comm NM_MPI_com(MPI_Comm m);
+#endif /*  HAVE_MPI */
+
+#ifdef WITH_MUMPS
 
 #include <dmumps_c.h>
 
@@ -55,14 +63,6 @@ extern "C"
 #define CNTL(I) cntl[(I)-1]
 #define RINFOG(I) rinfog[(I)-1]
 
-#ifdef HAVE_MPI
-  /** Get the MPI communicator. Call MPI_Init if needed.
-   * \param[in] m an MPI communicator
-   * \return the MPI communicator.
-   */
-  MPI_Comm NM_MPI_com(MPI_Comm m);
-#endif /*  HAVE_MPI */
-
   MUMPS_INT* NM_MUMPS_irn(NumericsMatrix* A);
   MUMPS_INT* NM_MUMPS_jcn(NumericsMatrix* A);
 
@@ -71,6 +71,26 @@ extern "C"
    */
   DMUMPS_STRUC_C* NM_MUMPS_id(NumericsMatrix* A);
 
+  /** Give the current triplet of A to the MUMPS instance: the values
+   * and, if it has changed, the sparsity pattern. With a distributed
+   * matrix, the local entries are given and the processes agree on the
+   * result.
+   * \param A the matrix to be factorized
+   * \param mumps_id the working data of A
+   * \return 1 if the sparsity pattern differs from the one given before,
+   * the analysis has to be done again, else 0
+   */
+  int NM_MUMPS_set_matrix(NumericsMatrix* A, DMUMPS_STRUC_C* mumps_id);
+
+  /** Switch the MUMPS instance of A to a distributed assembled matrix:
+   * each process of the communicator gives the entries it holds in the
+   * triplet of A, which has the global size. The right-hand side is
+   * read on the host and the solution is sent back to all the processes.
+   * Collective on the communicator of NM_MPI_com().
+   * \param A the matrix to be factorized
+   */
+  void NM_MUMPS_set_distributed(NumericsMatrix* A);
+
   /** Free the working data for MUMPS
    * \param p a NSM_linear_solver_params object holding the data
    */
@@ -35,6 +35,8 @@
 #include "Newton_methods.h"
 #include "PathSearch.h"
 #include "VariationalInequality_Solvers.h"
+#include "MLCP_Solvers.h"
+#include "gfc3d_nonsmooth_Newton_AlartCurnier.h"
 
 #include "GAMSlink.h"
 
@@ -57,6 +59,7 @@ const char* const SICONOS_NUMERICS_PROBLEM_AVI_STR = "AVI";
 const char* const SICONOS_NUMERICS_PROBLEM_RELAY_STR = "RELAY";
 
 static void recursive_solver_options_print(SolverOptions* options, int level);
+static int workspace_owns(SolverWorkspace * ws, void * p);
 
 const char * ns_problem_id_to_name(int id)
 {
@@ -210,6 +213,21 @@ void solver_options_free_solver_specific_data(SolverOptions* options)
      vi_box_AVI_free_solverData(options);
      break;
     }
+    case SICONOS_MLCP_DIRECT_ENUM:
+    case SICONOS_MLCP_DIRECT_PATH_ENUM:
+    case SICONOS_MLCP_DIRECT_SIMPLEX:
+    case SICONOS_MLCP_DIRECT_PATH:
+    case SICONOS_MLCP_DIRECT_FB:
+    {
+      /* configurations of the direct solver */
+      mlcp_direct_reset(options);
+      break;
+    }
+    case SICONOS_GLOBAL_FRICTION_3D_NSN_AC:
+    {
+      gfc3d_nonsmooth_Newton_AlartCurnier_free(options);
+      break;
+    }
     default:
       {
        if (options->solverParameters)
@@ -247,7 +265,7 @@ void solver_options_delete(SolverOptions* op)
     if (op->iWork)
       free(op->iWork);
     op->iWork = NULL;
-    if (op->dWork)
+    if (op->dWork && !workspace_owns(op->workspace, op->dWork))
       free(op->dWork);
     op->dWork = NULL;
     if (op->callback)
@@ -257,6 +275,7 @@ void solver_options_delete(SolverOptions* op)
       op->callback = NULL;
     }
     solver_options_free_solver_specific_data(op);
+    solver_options_workspace_free(op);
   }
 }
 
@@ -268,6 +287,7 @@ void solver_options_nullify(SolverOptions* options)
   options->internalSolvers = NULL;
   options->solverData = NULL;
   options->solverParameters = NULL;
+  options->workspace = NULL;
 }
 
 void solver_options_fill(SolverOptions* options, int solverId, int iSize, int dSize, int iter_max, double tol)
@@ -311,8 +331,8 @@ void solver_options_copy(SolverOptions* options_ori, SolverOptions* options)
 
   if (options_ori->iWork)
   {
-    assert(options->iWorkSize > 0);
     options->iWorkSize = options_ori->iWorkSize;
+    assert(options->iWorkSize > 0);
     options->iWork = (int *)calloc(options->iWorkSize, sizeof(int));
     for (int i = 0  ; i < options->iWorkSize; i++ )
     {
@@ -322,8 +342,8 @@ void solver_options_copy(SolverOptions* options_ori, SolverOptions* options)
 
   if (options_ori->dWork)
   {
-    assert(options->dWorkSize > 0);
     options->dWorkSize = options_ori->dWorkSize;
+    assert(options->dWorkSize > 0);
     options->dWork = (double *)calloc(options->dWorkSize, sizeof(double));
     for (int i = 0  ; i < options->dWorkSize; i++ )
     {
@@ -350,6 +370,9 @@ void solver_options_copy(SolverOptions* options_ori, SolverOptions* options)
    if (options_ori->solverData)
     options->solverData =options_ori->solverData;
 
+  /* the work memory is never shared */
+  options->workspace = NULL;
+
 
 
 
@@ -565,3 +588,152 @@ SolverOptions * solver_options_get_internal_solver(SolverOptions * options, int
     return &options->internalSolvers[n];
 }
 
+
+/* Each block of the workspace starts with a header linking it to the
+ * previous block. The memory given is aligned on WORKSPACE_ALIGN
+ * bytes. */
+typedef struct
+{
+  char * previous;
+  size_t size;
+} WorkspaceBlockHeader;
+
+#define WORKSPACE_ALIGN 16
+#define WORKSPACE_ROUND(size) (((size) + WORKSPACE_ALIGN - 1) & ~((size_t)WORKSPACE_ALIGN - 1))
+#define WORKSPACE_HEADER WORKSPACE_ROUND(sizeof(WorkspaceBlockHeader))
+#define WORKSPACE_MIN_BLOCK_SIZE 4096
+
+static void workspace_free_blocks(SolverWorkspace * ws)
+{
+  char * block = ws->block;
+  while (block)
+  {
+    char * previous = ((WorkspaceBlockHeader *)block)->previous;
+    free(block);
+    block = previous;
+  }
+  ws->block = NULL;
+  ws->blockSize = 0;
+  ws->used = 0;
+  ws->size = 0;
+}
+
+static void workspace_add_block(SolverWorkspace * ws, size_t blockSize)
+{
+  char * block = (char *)malloc(blockSize);
+  if (!block)
+    numerics_error("solver_options_workspace_alloc", "out of memory");
+  ((WorkspaceBlockHeader *)block)->previous = ws->block;
+  ((WorkspaceBlockHeader *)block)->size = blockSize;
+  ws->block = block;
+  ws->blockSize = blockSize;
+  ws->used = WORKSPACE_HEADER;
+  ws->size += blockSize;
+  ws->allocations++;
+}
+
+static int workspace_owns(SolverWorkspace * ws, void * p)
+{
+  if (!ws)
+    return 0;
+  for (char * block = ws->block; block; block = ((WorkspaceBlockHeader *)block)->previous)
+  {
+    if ((char *)p >= block && (char *)p < block + ((WorkspaceBlockHeader *)block)->size)
+      return 1;
+  }
+  return 0;
+}
+
+void * solver_options_workspace_alloc(SolverOptions * options, size_t size)
+{
+  assert(options);
+  SolverWorkspace * ws = options->workspace;
+  if (!ws)
+  {
+    ws = (SolverWorkspace *)calloc(1, sizeof(SolverWorkspace));
+    options->workspace = ws;
+    ws->allocations = 1;
+  }
+  size = WORKSPACE_ROUND(size);
+
+  if (!ws->block || ws->used + size > ws->blockSize)
+  {
+    /* geometric growth: the new block is twice as large as all the
+     * previous ones */
+    size_t blockSize = 2 * ws->size;
+    if (blockSize < size + WORKSPACE_HEADER)
+      blockSize = size + WORKSPACE_HEADER;
+    if (blockSize < WORKSPACE_MIN_BLOCK_SIZE)
+      blockSize = WORKSPACE_MIN_BLOCK_SIZE;
+    DEBUG_PRINTF("solver_options_workspace_alloc: new block of %zu bytes\n", blockSize);
+    workspace_add_block(ws, blockSize);
+  }
+
+  void * p = ws->block + ws->used;
+  ws->used += size;
+  return p;
+}
+
+void solver_options_workspace_reset(SolverOptions * options)
+{
+  SolverWorkspace * ws = options->workspace;
+  if (!ws)
+    return;
+  ws->allocations = 0;
+  if (ws->block && ((WorkspaceBlockHeader *)ws->block)->previous)
+  {
+    /* several blocks: replace them by one block of the same total size */
+    size_t size = ws->size;
+    workspace_free_blocks(ws);
+    workspace_add_block(ws, size);
+  }
+  ws->used = WORKSPACE_HEADER;
+}
+
+/* positions count the bytes of all the blocks before the current one */
+size_t solver_options_workspace_mark(SolverOptions * options)
+{
+  SolverWorkspace * ws = options->workspace;
+  if (!ws || !ws->block)
+    return 0;
+  return ws->size - ws->blockSize + ws->used;
+}
+
+void solver_options_workspace_release(SolverOptions * options, size_t mark)
+{
+  SolverWorkspace * ws = options->workspace;
+  if (!ws || !ws->block)
+    return;
+  size_t start = ws->size - ws->blockSize;
+  /* a mark taken in a previous block is left alone, the memory comes
+   * back at the next reset */
+  if (mark >= start + WORKSPACE_HEADER && mark <= start + ws->used)
+    ws->used = mark - start;
+}
+
+double * solver_options_workspace_set_dWork(SolverOptions * options, int dWorkSize)
+{
+  if (options->dWork && !workspace_owns(options->workspace, options->dWork))
+    free(options->dWork);
+  options->dWork = (double *)solver_options_workspace_alloc(options, dWorkSize * sizeof(double));
+  options->dWorkSize = dWorkSize;
+  return options->dWork;
+}
+
+size_t solver_options_workspace_allocations(SolverOptions * options)
+{
+  size_t allocations = options->workspace ? options->workspace->allocations : 0;
+  for (int i = 0; i < options->numberOfInternalSolvers; i++)
+    allocations += solver_options_workspace_allocations(&options->internalSolvers[i]);
+  return allocations;
+}
+
+void solver_options_workspace_free(SolverOptions * options)
+{
+  if (options->workspace)
+  {
+    workspace_free_blocks(options->workspace);
+    free(options->workspace);
+    options->workspace = NULL;
+  }
+}
@@ -24,6 +24,7 @@
 /*!\file SolverOptions.h
   Structure used to send options (name, parameters and so on) to a specific solver-driver (mainly from Kernel to Numerics).
 */
+#include <stddef.h>
 #include "SiconosConfig.h"
 #include "NumericsFwd.h"
 
@@ -41,6 +42,23 @@ typedef struct
 } Callback;
 
 
+/** \struct SolverWorkspace SolverOptions.h
+    Work memory of a solver kept from one call to the next one (see
+    solver_options_workspace_alloc). The memory is taken from blocks
+    allocated on the heap; when the current block is full, a new one,
+    twice larger than all the previous ones together, is added. At the
+    next reset, the blocks are merged into one, so that after a few
+    calls a solver gets all its work memory without any allocation.
+*/
+typedef struct SolverWorkspace
+{
+  char * block;             /**< current block, its first bytes keep the address of the previous block */
+  size_t blockSize;         /**< size in bytes of the current block */
+  size_t used;              /**< number of bytes of the current block already given */
+  size_t size;              /**< total size in bytes of the blocks */
+  size_t allocations;       /**< number of heap allocations since the last reset */
+} SolverWorkspace;
+
 /** \struct SolverOptions_ SolverOptions.h
     Structure used to send options (name, parameters and so on) to a specific solver (mainly from Kernel to Numerics).
 */
@@ -66,6 +84,7 @@ struct SolverOptions
 
   void * solverData;                       /**< additional data specific to the solver */
 
+  SolverWorkspace * workspace;             /**< work memory kept between two calls of the solver (owned) */
 };
 
 enum SICONOS_NUMERICS_PROBLEM_TYPE
@@ -218,6 +237,60 @@ extern "C"
   void solver_options_copy(SolverOptions* options_ori, SolverOptions* options);
 
   SolverOptions * solver_options_get_internal_solver(SolverOptions * options, int n);
+
+  /** get some work memory from the workspace of the options. The
+   * memory is neither initialized nor freed by the caller: it remains
+   * valid until the next call to solver_options_workspace_reset or
+   * solver_options_delete. The workspace is created on first use.
+   * \param options the options owning the workspace
+   * \param size the number of bytes
+   * \return a pointer aligned for any type
+   */
+  void * solver_options_workspace_alloc(SolverOptions * options, size_t size);
+
+  /** give back all the memory of the workspace, to be called at the
+   * beginning of a solve. The blocks are merged into a single one, and
+   * the allocation counter is set to zero.
+   * \param options the options owning the workspace
+   */
+  void solver_options_workspace_reset(SolverOptions * options);
+
+  /** current position in the workspace, to give back with
+   * solver_options_workspace_release the memory taken by a function
+   * called many times during a solve.
+   * \param options the options owning the workspace
+   * \return the position
+   */
+  size_t solver_options_workspace_mark(SolverOptions * options);
+
+  /** give back the memory taken from the workspace since a mark.
+   * \param options the options owning the workspace
+   * \param mark the value returned by solver_options_workspace_mark
+   */
+  void solver_options_workspace_release(SolverOptions * options, size_t mark);
+
+  /** let options->dWork point to memory of the workspace; a dWork
+   * allocated on the heap is freed before. Such a dWork is not freed
+   * by solver_options_delete, and is valid until the next reset.
+   * \param options the options owning the workspace
+   * \param dWorkSize the number of doubles
+   * \return options->dWork
+   */
+  double * solver_options_workspace_set_dWork(SolverOptions * options, int dWorkSize);
+
+  /** number of heap allocations made by the workspaces of the options
+   * and of its internal solvers since their last reset, that is
+   * during the last solve. It is zero when the workspaces were large
+   * enough.
+   * \param options the options owning the workspace
+   * \return the number of allocations
+   */
+  size_t solver_options_workspace_allocations(SolverOptions * options);
+
+  /** free the workspace of the options
+   * \param options the options owning the workspace
+   */
+  void solver_options_workspace_free(SolverOptions * options);
   
   
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
@@ -0,0 +1,264 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "complementarity_enum.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "SolverOptions.h"
+#include "SiconosBlas.h"
+#include "SiconosLapack.h"
+#include "numerics_verbose.h"
+
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+/* number of configurations of a block, visited by one thread from one
+ * factorization */
+#define ENUM_BLOCK_SIZE 256
+
+/* number of Sherman-Morrison updates between two factorizations */
+#define ENUM_MAX_UPDATES 32
+
+/* an update with a smaller pivot gives a (nearly) singular matrix */
+#define ENUM_SINGULAR_PIVOT 1e-8
+
+/* work memory of a thread */
+typedef struct
+{
+  double * A;       /* matrix of a configuration, then its LU factors */
+  double * Ainv;    /* inverse of the matrix of the current configuration */
+  double * x;       /* solution of the current configuration */
+  double * y;       /* Ainv * (new column - old column) */
+  double * row;     /* a row of Ainv */
+  double * xcheck;  /* solution of a candidate, from a factorization */
+  lapack_int * ipiv;
+} EnumWork;
+
+/* rounded up to a cache line: the doubles of each thread are aligned
+ * and the threads do not share a line */
+static size_t enum_work_size(int size)
+{
+  size_t workSize = (2 * (size_t)size * size + 4 * (size_t)size) * sizeof(double)
+    + (size_t)size * sizeof(lapack_int);
+  return (workSize + 63) / 64 * 64;
+}
+
+static void enum_work_set(EnumWork * work, char * memory, int size)
+{
+  double * d = (double *) memory;
+  work->A = d;
+  work->Ainv = work->A + size * size;
+  work->x = work->Ainv + size * size;
+  work->y = work->x + size;
+  work->row = work->y + size;
+  work->xcheck = work->row + size;
+  work->ipiv = (lapack_int *)(work->xcheck + size);
+}
+
+unsigned long long complementarity_enum_rank(unsigned long long configuration)
+{
+  unsigned long long rank = configuration;
+  while (configuration >>= 1)
+    rank ^= configuration;
+  return rank;
+}
+
+void complementarity_enum_build_matrix(ComplementarityEnum * problem,
+                                       unsigned long long configuration,
+                                       double * A)
+{
+  int size = problem->size;
+  memcpy(A, problem->M, (size_t)size * size * sizeof(double));
+  for (int i = 0; i < problem->nbPairs; i++)
+  {
+    if ((configuration >> i) & 1)
+    {
+      int c = problem->offset + i;
+      double * col = A + (size_t)c * size;
+      memset(col, 0, size * sizeof(double));
+      col[c] = -1.0;
+    }
+  }
+}
+
+static int enum_in_cone(ComplementarityEnum * problem, double * x)
+{
+  for (int i = 0; i < problem->nbPairs; i++)
+  {
+    if (x[problem->offset + i] < - problem->tol)
+      return 0;
+  }
+  return 1;
+}
+
+/* factorize and invert the matrix of a configuration, and solve its system */
+static int enum_factorize(ComplementarityEnum * problem, unsigned long long configuration,
+                          EnumWork * work)
+{
+  int size = problem->size;
+  lapack_int info = 0;
+  complementarity_enum_build_matrix(problem, configuration, work->A);
+  DGETRF(size, size, work->A, size, work->ipiv, &info);
+  if (info)
+    return 0;
+  memcpy(work->x, problem->b, size * sizeof(double));
+  DGETRS(LA_NOTRANS, size, 1, work->A, size, work->ipiv, work->x, size, &info);
+  if (info)
+    return 0;
+  memcpy(work->Ainv, work->A, (size_t)size * size * sizeof(double));
+  DGETRI(size, work->Ainv, size, work->ipiv, &info);
+  return info ? 0 : 1;
+}
+
+/* switch the pair i, from z to w if toW, by a rank-one update */
+static int enum_update(ComplementarityEnum * problem, int i, int toW, EnumWork * work)
+{
+  int size = problem->size;
+  int c = problem->offset + i;
+  double * Ainv = work->Ainv;
+  double * y = work->y;
+
+  /* y = Ainv (M[:,c] + e_c), the change of column is -(M[:,c] + e_c) when
+   * going to w and M[:,c] + e_c when going to z */
+  cblas_dgemv(CblasColMajor, CblasNoTrans, size, size, 1.0, Ainv, size,
+              problem->M + (size_t)c * size, 1, 0.0, y, 1);
+  cblas_daxpy(size, 1.0, Ainv + (size_t)c * size, 1, y, 1);
+  if (toW)
+    cblas_dscal(size, -1.0, y, 1);
+
+  double pivot = 1.0 + y[c];
+  if (fabs(pivot) < ENUM_SINGULAR_PIVOT)
+    return 0;
+
+  cblas_dcopy(size, Ainv + c, size, work->row, 1);
+  cblas_dger(CblasColMajor, size, size, -1.0 / pivot, y, 1, work->row, 1, Ainv, size);
+  cblas_daxpy(size, - work->x[c] / pivot, y, 1, work->x, 1);
+  return 1;
+}
+
+/* check a candidate with a factorization of its matrix */
+static int enum_check(ComplementarityEnum * problem, unsigned long long configuration,
+                      EnumWork * work)
+{
+  int size = problem->size;
+  lapack_int info = 0;
+  complementarity_enum_build_matrix(problem, configuration, work->A);
+  memcpy(work->xcheck, problem->b, size * sizeof(double));
+  DGESV(size, 1, work->A, size, work->ipiv, work->xcheck, size, &info);
+  return !info && enum_in_cone(problem, work->xcheck);
+}
+
+unsigned long long complementarity_enum_solve(ComplementarityEnum * problem,
+                                              unsigned long long first,
+                                              unsigned long long count,
+                                              SolverOptions * options)
+{
+  int size = problem->size;
+  unsigned long long mask = problem->nbPairs ? (~0ULL >> (64 - problem->nbPairs)) : 0;
+  unsigned long long nbBlocks = (count + ENUM_BLOCK_SIZE - 1) / ENUM_BLOCK_SIZE;
+  volatile unsigned long long best = count;
+  unsigned long long examined = 0;
+
+  assert(problem->nbPairs < 64);
+  if (count == 0)
+    return 0;
+
+  int nbThreads = 1;
+#ifdef WITH_OPENMP
+  nbThreads = omp_get_max_threads();
+#endif
+  size_t workSize = enum_work_size(size);
+  size_t mark = solver_options_workspace_mark(options);
+  char * memory = (char *) solver_options_workspace_alloc(options, nbThreads * workSize);
+
+#ifdef WITH_OPENMP
+#pragma omp parallel if (nbBlocks > 1) reduction(+:examined)
+#endif
+  {
+    EnumWork work;
+    int thread = 0;
+#ifdef WITH_OPENMP
+    thread = omp_get_thread_num();
+#endif
+    enum_work_set(&work, memory + thread * workSize, size);
+
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (unsigned long long block = 0; block < nbBlocks; block++)
+    {
+      unsigned long long start = block * ENUM_BLOCK_SIZE;
+      unsigned long long end = start + ENUM_BLOCK_SIZE < count ? start + ENUM_BLOCK_SIZE : count;
+      unsigned long long configuration = 0;
+      int valid = 0;
+      int updates = 0;
+      for (unsigned long long pos = start; pos < end && pos < best; pos++)
+      {
+        unsigned long long next = complementarity_enum_configuration((first + pos) & mask);
+        unsigned long long change = next ^ configuration;
+        if (valid && updates < ENUM_MAX_UPDATES && change && !(change & (change - 1)))
+        {
+          int i = 0;
+          while (!((change >> i) & 1))
+            i++;
+          valid = enum_update(problem, i, (next >> i) & 1, &work);
+          updates++;
+        }
+        else
+          valid = 0;
+        configuration = next;
+        if (!valid)
+        {
+          valid = enum_factorize(problem, configuration, &work);
+          updates = 0;
+        }
+        examined++;
+        if (valid && enum_in_cone(problem, work.x))
+        {
+          if (enum_check(problem, configuration, &work))
+          {
+#ifdef WITH_OPENMP
+#pragma omp critical(complementarity_enum)
+#endif
+            {
+              if (pos < best)
+              {
+                best = pos;
+                problem->configuration = configuration;
+                memcpy(problem->x, work.xcheck, size * sizeof(double));
+              }
+            }
+            break;
+          }
+          /* the updates drifted: start again from a factorization */
+          valid = 0;
+        }
+      }
+    }
+  }
+
+  solver_options_workspace_release(options, mark);
+  problem->examined = examined;
+  if (verbose)
+    printf("complementarity_enum: %llu configurations examined, %s\n", examined,
+           best < count ? "solution found" : "no solution");
+  return best;
+}
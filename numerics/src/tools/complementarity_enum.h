@@ -0,0 +1,108 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+/*!\file complementarity_enum.h
+ * \brief enumeration of the complementarity configurations of a linear system,
+ * shared by the enum solvers of the LCP and of the MLCP */
+#ifndef COMPLEMENTARITY_ENUM_H
+#define COMPLEMENTARITY_ENUM_H
+
+#include "NumericsFwd.h"
+#include "SiconosConfig.h"
+
+/** \struct ComplementarityEnum complementarity_enum.h
+ * A square linear system M x = b, of which the unknowns offset, ...,
+ * offset + nbPairs - 1 belong to complementarity pairs.
+ *
+ * In a configuration, the bit i is 0 if the unknown offset + i is
+ * z_i, with the column offset + i of M, and 1 if it is w_i, with the
+ * column -e_{offset + i}. A configuration is a solution if the unknowns
+ * of the pairs of the solution of its linear system are nonnegative
+ * (up to tol).
+ *
+ * The configurations are visited in the order of the Gray code, so
+ * that two successive ones differ by one column: the inverse of the
+ * matrix is updated by the Sherman-Morrison formula in O(size^2)
+ * instead of being factorized again. It is factorized again at the
+ * beginning of each block of configurations, after a (nearly) singular
+ * configuration, and to check a solution. With OpenMP, the blocks are
+ * shared among the threads, which stop as soon as a solution with a
+ * smaller rank is known: the result does not depend on the number of
+ * threads. All the state is in the structure and in the workspace of
+ * the options, so that several problems can be solved at the same time.
+ */
+typedef struct
+{
+  int size;                         /**< size of the linear system */
+  int offset;                       /**< first unknown of a complementarity pair */
+  int nbPairs;                      /**< number of complementarity pairs, less than 64 */
+  double * M;                       /**< matrix of the system (column major) */
+  double * b;                       /**< right-hand side */
+  double tol;                       /**< tolerance on the sign of the unknowns of the pairs */
+  double * x;                       /**< (out) solution of the system of the configuration found, of size size */
+  unsigned long long configuration; /**< (out) configuration found */
+  unsigned long long examined;      /**< (out) number of configurations examined */
+} ComplementarityEnum;
+
+#if defined(__cplusplus) && !defined(BUILD_AS_CPP)
+extern "C"
+{
+#endif
+
+  /** configuration of a rank in the enumeration (Gray code)
+   * \param rank the rank
+   * \return the configuration
+   */
+  static inline unsigned long long complementarity_enum_configuration(unsigned long long rank)
+  {
+    return rank ^ (rank >> 1);
+  }
+
+  /** rank of a configuration in the enumeration
+   * \param configuration the configuration
+   * \return its rank
+   */
+  unsigned long long complementarity_enum_rank(unsigned long long configuration);
+
+  /** look for a solution among the configurations of ranks first,
+   * first + 1, ..., first + count - 1 (modulo 2^nbPairs). On success,
+   * problem->configuration and problem->x are those of the first one.
+   * \param problem the linear system and the tolerance
+   * \param first the rank of the first configuration
+   * \param count the number of configurations to examine
+   * \param options the options providing the work memory
+   * \return the position (from 0 to count-1) of the solution, or count if there is none
+   */
+  unsigned long long complementarity_enum_solve(ComplementarityEnum * problem,
+                                                unsigned long long first,
+                                                unsigned long long count,
+                                                SolverOptions * options);
+
+  /** build the matrix of the linear system of a configuration
+   * \param problem the linear system
+   * \param configuration the configuration
+   * \param[out] A the matrix, size x size
+   */
+  void complementarity_enum_build_matrix(ComplementarityEnum * problem,
+                                         unsigned long long configuration,
+                                         double * A);
+
+#if defined(__cplusplus) && !defined(BUILD_AS_CPP)
+}
+#endif
+
+#endif
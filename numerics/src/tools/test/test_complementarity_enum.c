@@ -0,0 +1,170 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Check the enumeration of complementarity_enum_solve against a
+ * factorization of the matrix of each configuration, on systems with
+ * free unknowns (as in a MLCP) and with several solutions: from any
+ * starting rank, the solution found must be the first one in the
+ * order of the Gray code. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "SiconosLapack.h"
+#include "SolverOptions.h"
+#include "complementarity_enum.h"
+
+#define NB_FREE 2
+#define NB_PAIRS 11
+#define SIZE (NB_FREE + NB_PAIRS)
+#define NB_CONFIGURATIONS (1ULL << NB_PAIRS)
+#define NB_PROBLEMS 6
+#define TOL 1e-10
+
+/* deterministic pseudo random numbers in [-1, 1] */
+static double next_random(unsigned int* seed)
+{
+  *seed = *seed * 1103515245u + 12345u;
+  return ((*seed >> 8) & 0xffff) / 32767.5 - 1.0;
+}
+
+/* solve the system of a configuration and check the signs of its unknowns */
+static int is_solution(ComplementarityEnum* problem, unsigned long long configuration, double* x)
+{
+  double A[SIZE * SIZE];
+  lapack_int ipiv[SIZE];
+  lapack_int info = 0;
+  complementarity_enum_build_matrix(problem, configuration, A);
+  memcpy(x, problem->b, SIZE * sizeof(double));
+  DGESV(SIZE, 1, A, SIZE, ipiv, x, SIZE, &info);
+  if (info)
+    return 0;
+  for (int i = 0; i < NB_PAIRS; i++)
+    if (x[NB_FREE + i] < -TOL)
+      return 0;
+  return 1;
+}
+
+static int test_problem(unsigned int* seed, SolverOptions* options, int* nbSolutionsFound)
+{
+  double M[SIZE * SIZE];
+  double b[SIZE];
+  double x[SIZE];
+  double xref[SIZE];
+  static double solutions[NB_CONFIGURATIONS][SIZE];
+  static char isSolution[NB_CONFIGURATIONS];
+  unsigned long long starts[] = { 0, 1, 100, 777, NB_CONFIGURATIONS - 1 };
+  unsigned long long counts[] = { NB_CONFIGURATIONS, 300 };
+  int info = 0;
+
+  for (int i = 0; i < SIZE * SIZE; i++)
+    M[i] = next_random(seed);
+  /* a negative diagonal and a positive b give several solutions */
+  for (int i = NB_FREE; i < SIZE; i++)
+    M[i + i * SIZE] -= 2.0;
+  for (int i = 0; i < SIZE; i++)
+    b[i] = next_random(seed) + (i < NB_FREE ? 0.0 : 1.0);
+
+  ComplementarityEnum problem;
+  problem.size = SIZE;
+  problem.offset = NB_FREE;
+  problem.nbPairs = NB_PAIRS;
+  problem.M = M;
+  problem.b = b;
+  problem.tol = TOL;
+  problem.x = x;
+
+  /* reference: indexed by rank */
+  int nbSolutions = 0;
+  for (unsigned long long rank = 0; rank < NB_CONFIGURATIONS; rank++)
+  {
+    isSolution[rank] = is_solution(&problem, complementarity_enum_configuration(rank), solutions[rank]);
+    nbSolutions += isSolution[rank];
+  }
+  *nbSolutionsFound += nbSolutions;
+
+  for (unsigned int s = 0; s < sizeof(starts) / sizeof(starts[0]); s++)
+  {
+    for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++)
+    {
+      unsigned long long expected = counts[c];
+      for (unsigned long long pos = 0; pos < counts[c]; pos++)
+      {
+        if (isSolution[(starts[s] + pos) % NB_CONFIGURATIONS])
+        {
+          expected = pos;
+          break;
+        }
+      }
+      unsigned long long pos = complementarity_enum_solve(&problem, starts[s], counts[c], options);
+      if (pos != expected)
+      {
+        printf("start %llu, count %llu: solution at %llu instead of %llu\n",
+               starts[s], counts[c], pos, expected);
+        info = 1;
+        continue;
+      }
+      if (pos == counts[c])
+        continue;
+      unsigned long long rank = (starts[s] + pos) % NB_CONFIGURATIONS;
+      memcpy(xref, solutions[rank], SIZE * sizeof(double));
+      if (problem.configuration != complementarity_enum_configuration(rank))
+      {
+        printf("start %llu: wrong configuration\n", starts[s]);
+        info = 1;
+      }
+      for (int i = 0; i < SIZE; i++)
+      {
+        if (fabs(x[i] - xref[i]) > 1e-10 * (1.0 + fabs(xref[i])))
+        {
+          printf("start %llu: x[%i] = %g instead of %g\n", starts[s], i, x[i], xref[i]);
+          info = 1;
+        }
+      }
+      if (complementarity_enum_rank(problem.configuration) != rank)
+      {
+        printf("start %llu: wrong rank of the configuration\n", starts[s]);
+        info = 1;
+      }
+    }
+  }
+  return info;
+}
+
+int main(void)
+{
+  int info = 0;
+  int nbSolutions = 0;
+  unsigned int seed = 5;
+  SolverOptions options;
+  memset(&options, 0, sizeof(SolverOptions));
+
+  for (int k = 0; k < NB_PROBLEMS; k++)
+    info |= test_problem(&seed, &options, &nbSolutions);
+
+  if (nbSolutions < 2 * NB_PROBLEMS)
+  {
+    printf("too few solutions to test the enumeration: %i\n", nbSolutions);
+    info = 1;
+  }
+  solver_options_workspace_free(&options);
+  printf("End of test on the enumeration of the configurations: %i solutions, info = %i\n",
+         nbSolutions, info);
+  return info;
+}
@@ -0,0 +1,214 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Solve many independent problems, first one after the other, then
+ * concurrently (when built with OpenMP), and check that the drivers
+ * give exactly the same results. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SiconosConfig.h"
+#include "NonSmoothDrivers.h"
+#include "SolverOptions.h"
+#include "NumericsMatrix.h"
+#include "FrictionContactProblem.h"
+#include "LinearComplementarityProblem.h"
+#include "fc3d_Solvers.h"
+#include "LCP_Solvers.h"
+#include "lcp_cst.h"
+#include "Friction_cst.h"
+#include "fc3d_onecontact_nonsmooth_Newton_solvers.h"
+#include "GenericMechanicalProblem.h"
+#include "GenericMechanical_Solvers.h"
+
+#define NB_PROBLEMS 400
+#define NB_ROUNDS 4
+#define NB_CONTACTS 6
+#define LCP_SIZE 8
+#define GMP_SIZE 9
+#define MAX_SIZE (3 * NB_CONTACTS)
+
+enum { FC3D_NSGS, FC3D_NSGS_NSN_GP, LCP_ENUM, LCP_LEMKE, GMP_NSGS, NB_KINDS };
+
+typedef struct
+{
+  int info;
+  double x[MAX_SIZE];
+  double y[MAX_SIZE];
+} Result;
+
+/* deterministic pseudo random numbers in [-1, 1] */
+static double next_random(unsigned int* seed)
+{
+  *seed = *seed * 1103515245u + 12345u;
+  return ((*seed >> 8) & 0xffff) / 32767.5 - 1.0;
+}
+
+/* M = B B^T + n I */
+static void fill_spd_matrix(double* M, int n, unsigned int* seed)
+{
+  double B[MAX_SIZE * MAX_SIZE];
+  for (int i = 0; i < n * n; i++)
+    B[i] = next_random(seed);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+    {
+      double s = (i == j) ? n : 0.;
+      for (int k = 0; k < n; k++)
+        s += B[i + k * n] * B[j + k * n];
+      M[i + j * n] = s;
+    }
+}
+
+static void solve(int p, Result* result)
+{
+  unsigned int seed = 17 + 31 * p;
+  int kind = p % NB_KINDS;
+  double Mdata[MAX_SIZE * MAX_SIZE];
+  double q[MAX_SIZE];
+  memset(result, 0, sizeof(Result));
+
+  if (kind == FC3D_NSGS || kind == FC3D_NSGS_NSN_GP)
+  {
+    int n = 3 * NB_CONTACTS;
+    double mu[NB_CONTACTS];
+    fill_spd_matrix(Mdata, n, &seed);
+    for (int i = 0; i < n; i++)
+      q[i] = next_random(&seed) - ((i % 3) ? 0. : 0.5);
+    for (int i = 0; i < NB_CONTACTS; i++)
+      mu[i] = 0.45 + 0.4 * next_random(&seed);
+
+    NumericsMatrix* M = NM_create_from_data(NM_DENSE, n, n, Mdata);
+    FrictionContactProblem* problem = frictionContactProblem_new_with_data(3, NB_CONTACTS, M, q, mu);
+    SolverOptions options;
+    fc3d_setDefaultSolverOptions(&options, SICONOS_FRICTION_3D_NSGS);
+    options.dparam[SICONOS_DPARAM_TOL] = 1e-10;
+    if (kind == FC3D_NSGS_NSN_GP)
+    {
+      solver_options_delete(options.internalSolvers);
+      fc3d_onecontact_nonsmooth_Newton_gp_setDefaultSolverOptions(options.internalSolvers);
+    }
+    result->info = fc3d_driver(problem, result->x, result->y, &options);
+    solver_options_delete(&options);
+
+    M->matrix0 = NULL;
+    problem->q = NULL;
+    problem->mu = NULL;
+    frictionContactProblem_free(problem);
+  }
+  else if (kind == GMP_NSGS)
+  {
+    /* an equality of size 1, an LCP of size 2 and two contacts */
+    int n = GMP_SIZE;
+    fill_spd_matrix(Mdata, n, &seed);
+    for (int i = 0; i < n; i++)
+      q[i] = next_random(&seed) - ((i >= 3 && i % 3 == 0) ? 0.5 : 0.);
+
+    GenericMechanicalProblem* problem = genericMechanicalProblem_new();
+    problem->M = NM_create_from_data(NM_DENSE, n, n, Mdata);
+    problem->q = q;
+    gmp_add(problem, SICONOS_NUMERICS_PROBLEM_EQUALITY, 1);
+    gmp_add(problem, SICONOS_NUMERICS_PROBLEM_LCP, 2);
+    for (int c = 0; c < 2; c++)
+    {
+      FrictionContactProblem* contact = (FrictionContactProblem*)gmp_add(problem, SICONOS_NUMERICS_PROBLEM_FC3D, 3);
+      contact->mu[0] = 0.45 + 0.4 * next_random(&seed);
+    }
+    SolverOptions options;
+    gmp_setDefaultSolverOptions(&options, SICONOS_FRICTION_3D_ONECONTACT_QUARTIC);
+    options.dparam[0] = 1e-10;
+    result->info = gmp_driver(problem, result->x, result->y, &options);
+    solver_options_delete(&options);
+
+    problem->M->matrix0 = NULL;
+    NM_free(problem->M);
+    free(problem->M);
+    genericMechanicalProblem_free(problem, NUMERICS_GMP_FREE_GMP);
+  }
+  else
+  {
+    int n = LCP_SIZE;
+    fill_spd_matrix(Mdata, n, &seed);
+    for (int i = 0; i < n; i++)
+      q[i] = next_random(&seed);
+
+    LinearComplementarityProblem problem;
+    problem.size = n;
+    problem.M = NM_create_from_data(NM_DENSE, n, n, Mdata);
+    problem.q = q;
+    SolverOptions options;
+    linearComplementarity_setDefaultSolverOptions(&problem, &options,
+                                                  kind == LCP_ENUM ? SICONOS_LCP_ENUM : SICONOS_LCP_LEMKE);
+    result->info = linearComplementarity_driver(&problem, result->x, result->y, &options);
+    if (kind == LCP_ENUM)
+      lcp_enum_reset(&problem, &options, 1);
+    solver_options_delete(&options);
+
+    problem.M->matrix0 = NULL;
+    NM_free(problem.M);
+    free(problem.M);
+  }
+}
+
+int main(void)
+{
+  Result* reference = (Result*)malloc(NB_PROBLEMS * sizeof(Result));
+  Result* results = (Result*)malloc(NB_PROBLEMS * sizeof(Result));
+  int info = 0;
+
+  for (int p = 0; p < NB_PROBLEMS; p++)
+    solve(p, &reference[p]);
+
+  for (int round = 0; round < NB_ROUNDS; round++)
+  {
+    memset(results, 0, NB_PROBLEMS * sizeof(Result));
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < NB_PROBLEMS; i++)
+    {
+      /* visit the problems in a different order at each round */
+      int p = (i * 7 + round) % NB_PROBLEMS;
+      solve(p, &results[p]);
+    }
+
+    for (int p = 0; p < NB_PROBLEMS; p++)
+    {
+      if (memcmp(&results[p], &reference[p], sizeof(Result)))
+      {
+        printf("round %i: problem %i (kind %i) gives a different result\n",
+               round, p, p % NB_KINDS);
+        info = 1;
+      }
+    }
+  }
+
+  for (int p = 0; p < NB_PROBLEMS; p++)
+  {
+    if (reference[p].info)
+    {
+      printf("problem %i (kind %i) not solved, info = %i\n", p, p % NB_KINDS, reference[p].info);
+      info = 1;
+    }
+  }
+
+  free(reference);
+  free(results);
+  return info;
+}
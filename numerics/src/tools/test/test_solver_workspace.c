@@ -0,0 +1,226 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2018 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Check the workspace of SolverOptions: once a solver has been called
+ * (and its workspace blocks merged at the next call), solving the
+ * same problem again with the same options must not allocate any
+ * work memory, and must give the same result. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "NonSmoothDrivers.h"
+#include "SolverOptions.h"
+#include "NumericsMatrix.h"
+#include "FrictionContactProblem.h"
+#include "LinearComplementarityProblem.h"
+#include "fc3d_Solvers.h"
+#include "LCP_Solvers.h"
+#include "lcp_cst.h"
+#include "Friction_cst.h"
+#include "fc3d_onecontact_nonsmooth_Newton_solvers.h"
+
+#define NB_CONTACTS 10
+#define N (3 * NB_CONTACTS)
+#define NB_CALLS 3
+
+/* deterministic pseudo random numbers in [-1, 1] */
+static double next_random(unsigned int* seed)
+{
+  *seed = *seed * 1103515245u + 12345u;
+  return ((*seed >> 8) & 0xffff) / 32767.5 - 1.0;
+}
+
+/* M = B B^T + n I */
+static void fill_spd_matrix(double* M, int n, unsigned int* seed)
+{
+  double B[N * N];
+  for (int i = 0; i < n * n; i++)
+    B[i] = next_random(seed);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+    {
+      double s = (i == j) ? n : 0.;
+      for (int k = 0; k < n; k++)
+        s += B[i + k * n] * B[j + k * n];
+      M[i + j * n] = s;
+    }
+}
+
+static int test_arena(void)
+{
+  int info = 0;
+  SolverOptions options;
+  memset(&options, 0, sizeof(SolverOptions));
+
+  /* several blocks are needed */
+  for (int k = 1; k < 200; k++)
+  {
+    char* p = (char*)solver_options_workspace_alloc(&options, 13 * k);
+    if ((uintptr_t)p % 16)
+    {
+      printf("workspace memory is not aligned\n");
+      info = 1;
+    }
+    memset(p, k, 13 * k);
+  }
+  if (solver_options_workspace_allocations(&options) < 3)
+  {
+    printf("the workspace should have grown\n");
+    info = 1;
+  }
+
+  /* after a reset the same requests fit in the merged block */
+  solver_options_workspace_reset(&options);
+  solver_options_workspace_reset(&options);
+  for (int k = 1; k < 200; k++)
+    solver_options_workspace_alloc(&options, 13 * k);
+  if (solver_options_workspace_allocations(&options))
+  {
+    printf("%zu allocations after a reset\n", solver_options_workspace_allocations(&options));
+    info = 1;
+  }
+
+  /* mark and release */
+  solver_options_workspace_reset(&options);
+  void* first = solver_options_workspace_alloc(&options, 100);
+  size_t mark = solver_options_workspace_mark(&options);
+  void* second = solver_options_workspace_alloc(&options, 100);
+  solver_options_workspace_release(&options, mark);
+  if (solver_options_workspace_alloc(&options, 100) != second || first == second)
+  {
+    printf("release does not give back the memory\n");
+    info = 1;
+  }
+
+  solver_options_workspace_free(&options);
+  return info;
+}
+
+/* solve the problem NB_CALLS times with the same options */
+static int test_fc3d(int localSolver)
+{
+  int info = 0;
+  unsigned int seed = 7 + localSolver;
+  double Mdata[N * N];
+  double q[N];
+  double mu[NB_CONTACTS];
+  double reaction[N], velocity[N], reaction0[N], velocity0[N];
+
+  fill_spd_matrix(Mdata, N, &seed);
+  for (int i = 0; i < N; i++)
+    q[i] = next_random(&seed) - ((i % 3) ? 0. : 0.5);
+  for (int i = 0; i < NB_CONTACTS; i++)
+    mu[i] = 0.45 + 0.4 * next_random(&seed);
+
+  NumericsMatrix* M = NM_create_from_data(NM_DENSE, N, N, Mdata);
+  FrictionContactProblem* problem = frictionContactProblem_new_with_data(3, NB_CONTACTS, M, q, mu);
+  SolverOptions options;
+  fc3d_setDefaultSolverOptions(&options, SICONOS_FRICTION_3D_NSGS);
+  options.dparam[SICONOS_DPARAM_TOL] = 1e-10;
+  if (localSolver != SICONOS_FRICTION_3D_ONECONTACT_NSN)
+  {
+    solver_options_delete(options.internalSolvers);
+    if (localSolver == SICONOS_FRICTION_3D_ONECONTACT_NSN_GP)
+      fc3d_onecontact_nonsmooth_Newton_gp_setDefaultSolverOptions(options.internalSolvers);
+    else
+      fc3d_projectionOnConeWithLocalIteration_setDefaultSolverOptions(options.internalSolvers);
+  }
+
+  for (int call = 0; call < NB_CALLS; call++)
+  {
+    memset(reaction, 0, sizeof(reaction));
+    memset(velocity, 0, sizeof(velocity));
+    int infoSolver = fc3d_driver(problem, reaction, velocity, &options);
+    size_t allocations = solver_options_workspace_allocations(&options);
+    printf("fc3d NSGS, local solver %s, call %i: info = %i, %zu allocations\n",
+           solver_options_id_to_name(localSolver), call, infoSolver, allocations);
+    if (infoSolver)
+      info = 1;
+    if (call == 0)
+    {
+      memcpy(reaction0, reaction, sizeof(reaction));
+      memcpy(velocity0, velocity, sizeof(velocity));
+    }
+    else
+    {
+      if (call == NB_CALLS - 1 && allocations)
+        info = 1;
+      if (memcmp(reaction, reaction0, sizeof(reaction)) ||
+          memcmp(velocity, velocity0, sizeof(velocity)))
+      {
+        printf("the result changes from one call to the next\n");
+        info = 1;
+      }
+    }
+  }
+
+  solver_options_delete(&options);
+  M->matrix0 = NULL;
+  problem->q = NULL;
+  problem->mu = NULL;
+  frictionContactProblem_free(problem);
+  return info;
+}
+
+static int test_lcp_lemke(void)
+{
+  int info = 0;
+  unsigned int seed = 3;
+  int n = N;
+  double Mdata[N * N];
+  double q[N];
+  double z[N], w[N];
+
+  fill_spd_matrix(Mdata, n, &seed);
+  for (int i = 0; i < n; i++)
+    q[i] = next_random(&seed);
+
+  LinearComplementarityProblem problem;
+  problem.size = n;
+  problem.M = NM_create_from_data(NM_DENSE, n, n, Mdata);
+  problem.q = q;
+  SolverOptions options;
+  linearComplementarity_setDefaultSolverOptions(&problem, &options, SICONOS_LCP_LEMKE);
+
+  for (int call = 0; call < NB_CALLS; call++)
+  {
+    int infoSolver = linearComplementarity_driver(&problem, z, w, &options);
+    size_t allocations = solver_options_workspace_allocations(&options);
+    printf("LCP Lemke, call %i: info = %i, %zu allocations\n", call, infoSolver, allocations);
+    if (infoSolver || (call == NB_CALLS - 1 && allocations))
+      info = 1;
+  }
+
+  solver_options_delete(&options);
+  problem.M->matrix0 = NULL;
+  NM_free(problem.M);
+  free(problem.M);
+  return info;
+}
+
+int main(void)
+{
+  int info = test_arena();
+  info += test_fc3d(SICONOS_FRICTION_3D_ONECONTACT_NSN);
+  info += test_fc3d(SICONOS_FRICTION_3D_ONECONTACT_NSN_GP);
+  info += test_fc3d(SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration);
+  info += test_lcp_lemke();
+  return info;
+}
@@ -15,7 +15,7 @@
   SolverOptions(enum FRICTION_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
 
     /* cf Friction_cst.h */
     if(id >= 400 && id < 500)
@@ -44,7 +44,7 @@
   SolverOptions(SecondOrderConeLinearComplementarityProblem* soclcp, enum SOCLCP_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
 
     if (id >= 1100 && id < 1200)
     {
@@ -64,14 +64,14 @@
   SolverOptions()
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     return SO;
   }
 
   SolverOptions(LinearComplementarityProblem* lcp, enum LCP_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     solver_options_set(SO, id);
     return SO;
   }
@@ -79,7 +79,7 @@
   SolverOptions(MixedLinearComplementarityProblem* mlcp, enum MLCP_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     SO->solverId=id;
     mixedLinearComplementarity_setDefaultSolverOptions(mlcp, SO);
     return SO;
@@ -88,7 +88,7 @@
   SolverOptions(MixedComplementarityProblem* mlcp, enum MCP_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     SO->solverId=id;
     mixedComplementarity_setDefaultSolverOptions(mlcp, SO);
     return SO;
@@ -97,7 +97,7 @@
   SolverOptions(MixedComplementarityProblem2* mcp, enum MCP_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     solver_options_set(SO, id);
     return SO;
   }
@@ -105,7 +105,7 @@
   SolverOptions(NonlinearComplementarityProblem* ncp, enum NCP_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     solver_options_set(SO, id);
     return SO;
   }
@@ -113,7 +113,7 @@
   SolverOptions(VariationalInequality* vi, enum VI_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     solver_options_set(SO, id);
     return SO;
   }
@@ -121,7 +121,7 @@
   SolverOptions(AffineVariationalInequalities* avi, enum AVI_SOLVER id)
   {
     SolverOptions *SO;
-    SO = (SolverOptions *) malloc(sizeof(SolverOptions));
+    SO = (SolverOptions *) calloc(1, sizeof(SolverOptions));
     SO->solverId=id;
     solver_options_set(SO, id);
     return SO;
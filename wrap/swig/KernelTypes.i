@@ -208,6 +208,30 @@ static inline void fillBasePyarray(PyObject* pyarray, SharedPointerKeeper* saved
   PyArray_SetBaseObject((PyArrayObject*) pyarray,cap);
 #endif
 }
+
+// deleter for SiconosVector or SimpleMatrix objects built on the data
+// of a numpy array: the array is released with the object.
+struct PyArrayKeeper
+{
+  PyObject* array;
+
+  PyArrayKeeper(PyObject* a) : array(a) {};
+
+  template <typename T>
+  void operator()(T* p)
+  {
+    delete p;
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    Py_DECREF(array);
+    PyGILState_Release(gstate);
+  }
+};
+
+// the numpy data may be used as storage if it can be written to
+static inline bool canBorrowPyarray(PyArrayObject* array)
+{
+  return PyArray_ISWRITEABLE(array) && PyArray_ISALIGNED(array);
+}
 %}
 
 // copy shared ptr reference in a base PyCObject || PyCapsule
@@ -446,10 +470,19 @@ struct IsDense : public Question<bool>
     }
 
     SP::SiconosVector tmp;
-    tmp.reset(new SiconosVector(array_size(array,0)));
-    // copy : with SiconosVector based on resizable std::vector there is
-    // no other way
-    memcpy(tmp->getArray(),array_data(array),array_size(array,0)*sizeof(double));
+    if (canBorrowPyarray(array))
+    {
+      // no copy : the vector is a view on the numpy data and holds a
+      // reference on the array
+      Py_INCREF(array);
+      tmp.reset(new SiconosVector((double*)array_data(array), array_size(array,0)),
+                PyArrayKeeper((PyObject*)array));
+    }
+    else
+    {
+      tmp.reset(new SiconosVector(array_size(array,0)));
+      memcpy(tmp->getArray(),array_data(array),array_size(array,0)*sizeof(double));
+    }
 
     // for cleanup
     *array_p = array;
@@ -736,9 +769,20 @@ struct IsDense : public Question<bool>
       return std11::shared_ptr<SimpleMatrix>();
     }
 
-    SP::SimpleMatrix result = SP::SimpleMatrix(new SimpleMatrix(array_size(array,0), array_size(array,1)));
-    // copy this is due to SimpleMatrix based on resizable std::vector
-    memcpy(result->getArray(), array_data(array), array_size(array,0)*array_size(array,1)*sizeof(double));
+    SP::SimpleMatrix result;
+    if (canBorrowPyarray(array))
+    {
+      // no copy : the matrix is a view on the (fortran ordered) numpy
+      // data and holds a reference on the array
+      Py_INCREF(array);
+      result.reset(new SimpleMatrix((double*)array_data(array), array_size(array,0), array_size(array,1)),
+                   PyArrayKeeper((PyObject*)array));
+    }
+    else
+    {
+      result.reset(new SimpleMatrix(array_size(array,0), array_size(array,1)));
+      memcpy(result->getArray(), array_data(array), array_size(array,0)*array_size(array,1)*sizeof(double));
+    }
     // for cleanup
     *array_p = array;
     return result;